@@ -1,7 +1,9 @@
 #pragma once
 
 #include <iostream>
+#include <string>
 #include <tuple>
+#include <utility>
 
 class DataType
 {
@@ -24,22 +26,31 @@ public:
 
 	DataType(std::tuple<std::string, std::string, std::string> value, bool isFunctionType)
 	{
-		this->value = value;
+		this->value = std::move(value);
 		this->isFunctionType = isFunctionType;
 	}
 
-	std::string GetValue()
+	std::string GetValue() const
 	{
 		if (isFunctionType)
 		{
-			std::string callingConvention = get<1>(value);
+			const std::string& callingConvention = get<1>(value);
+			std::string result;
+
+			result.reserve(get<0>(value).length() + callingConvention.length() + get<2>(value).length() + 3);
+			result += get<0>(value);
+			result += ' ';
 
 			if (callingConvention.length())
 			{
-				callingConvention = "(" + callingConvention + ")";
+				result += '(';
+				result += callingConvention;
+				result += ')';
 			}
 
-			return get<0>(value) + " " + callingConvention + get<2>(value);
+			result += get<2>(value);
+
+			return result;
 		}
 
 		return get<0>(value);
@@ -47,10 +58,10 @@ public:
 
 	void SetValue(std::tuple<std::string, std::string, std::string> value)
 	{
-		this->value = value;
+		this->value = std::move(value);
 	}
 
-	void Append(std::string value)
+	void Append(const std::string& value)
 	{
 		if (isFunctionType)
 		{
@@ -62,12 +73,12 @@ public:
 		}
 	}
 
-	void Prepend(std::string value)
+	void Prepend(const std::string& value)
 	{
 		get<0>(this->value).insert(0, value);
 	}
 
-	void Add(std::string value)
+	void Add(const std::string& value)
 	{
 		if (isFunctionType)
 		{
@@ -1,44 +1,62 @@
 #pragma once
 
+#include <cstdio>
 #include <iostream>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
-#include <map>
 
 class DemangleData
 {
 private:
-	std::vector<std::string> arguments;
-	std::vector<std::string> fragments;
-	std::vector<std::map<std::vector<std::string>, std::vector<std::string>>> history;
-	std::string value;
+	/*
+	* Fragments and arguments which are computed while symbol is demangled are stored in arena
+	* which lives as long as this object, fragments which are part of input only point into it.
+	*/
+	struct Frame
+	{
+		std::vector<std::string_view> arguments;
+		std::vector<std::string_view> fragments;
+	};
+
+	std::string_view input;
+	std::string_view value;
+	std::deque<std::string> arena;
+	std::vector<std::string_view> arguments;
+	std::vector<std::string_view> fragments;
+	std::vector<Frame> history;
 	bool verbose;
 
 public:
-	DemangleData(std::string value, bool verbose);
-	std::string GetValue();
-	void SetValue(std::string value);
-	int GetArgumentsSize();
-	std::string GetArgument(int index);
-	std::string GetFragment(int index);
+	DemangleData(std::string_view value, bool verbose);
+	std::string_view GetValue() const;
+	char Peek(size_t index = 0) const;
+	bool StartsWith(std::string_view prefix) const;
+	int GetArgumentsSize() const;
+	std::string_view GetArgument(int index) const;
+	std::string_view GetFragment(int index) const;
 	void Advance(int count);
-	int Index(char pos);
-	void AddFragment(std::string fragment);
-	void AddArgument(std::string argument);
+	int Index(char pos) const;
+	void AddFragment(std::string_view fragment);
+	void AddArgument(std::string_view argument);
+	std::string_view Store(std::string_view text);
 	void EnterTemplate();
 	void ExitTemplate();
-	bool IsInTemplate();
-	std::string Join(const std::vector<std::string>& vector, std::string delimiter);
+	bool IsInTemplate() const;
+	std::string Join(const std::vector<std::string_view>& vector, std::string_view delimiter) const;
 
 	template <typename... Args>
 	void Log(char const* const format, Args const&... args) noexcept
 	{
 		if (verbose)
 		{
-			printf_s(format, args...);
+			printf(format, args...);
 
-			printf_s(" REST=%s", value.c_str());
-			printf_s(" ARG=%s", Join(arguments, ",").c_str());
-			printf_s(" FRAG=%s\n", Join(fragments, ",").c_str());
+			printf(" REST=%.*s", static_cast<int>(value.length()), value.data());
+			printf(" ARG=%s", Join(arguments, ",").c_str());
+			printf(" FRAG=%s\n", Join(fragments, ",").c_str());
 		}
 	}
 };
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class DemangledSymbolKind
+{
+	none,
+	name,
+	variable,
+	function,
+	localStaticGuard
+};
+
+enum class DemangleStyle
+{
+	//Qualified name with parameter list
+	ida,
+	//Qualified name which can be used as label
+	ghidra
+};
+
+//Part of text of symbol
+struct DemangledText
+{
+	std::uint32_t offset = 0;
+	std::uint32_t length = 0;
+};
+
+struct DemangledScope
+{
+	//Scope with template arguments
+	DemangledText text;
+	//Scope without template arguments
+	DemangledText name;
+	std::uint32_t firstTemplateArgument = 0;
+	std::uint32_t templateArgumentCount = 0;
+};
+
+/*
+* Structure of demangled symbol: scopes of its name from outermost to innermost with their template arguments,
+* access, calling convention, return type, parameters and qualifiers. All parts are stored one after another
+* in single text buffer and nodes only keep their offsets so symbol is compact and can be copied.
+* Name in IDA or Ghidra style is built only when it's requested, name in undname.exe style is
+* output of demangler which is kept as it is.
+*/
+class DemangledSymbol
+{
+public:
+	DemangledSymbolKind GetKind() const;
+	std::string_view GetPrefix() const;
+	std::string_view GetAccess() const;
+	std::string_view GetCallingConvention() const;
+	std::string_view GetReturnType() const;
+	std::string_view GetQualifiers() const;
+	std::size_t GetScopeCount() const;
+	std::string_view GetScope(std::size_t index) const;
+	std::string_view GetScopeName(std::size_t index) const;
+	std::size_t GetTemplateArgumentCount(std::size_t scopeIndex) const;
+	std::string_view GetTemplateArgument(std::size_t scopeIndex, std::size_t index) const;
+	std::string_view GetName() const;
+	std::string GetParentName() const;
+	std::string GetQualifiedName() const;
+	std::size_t GetParameterCount() const;
+	std::string_view GetParameter(std::size_t index) const;
+	std::string_view GetUndecoratedName() const;
+	std::string Render(DemangleStyle style) const;
+
+	void Clear();
+	void SetKind(DemangledSymbolKind kind);
+	void AddPrefix(std::string_view prefix);
+	void SetAccess(std::string_view access);
+	void SetCallingConvention(std::string_view callingConvention);
+	void SetReturnType(std::string_view returnType);
+	void SetQualifiers(std::string_view qualifiers);
+	void SetScopes(const std::vector<std::string>& names);
+	void SetParameters(const std::vector<std::string>& parameters);
+	void SetUndecoratedName(std::string_view undecoratedName);
+
+private:
+	std::string text;
+	DemangledSymbolKind kind = DemangledSymbolKind::none;
+	DemangledText prefix;
+	DemangledText access;
+	DemangledText callingConvention;
+	DemangledText returnType;
+	DemangledText qualifiers;
+	DemangledText undecoratedName;
+	std::vector<DemangledScope> scopes;
+	std::vector<DemangledText> templateArguments;
+	std::vector<DemangledText> parameters;
+
+	DemangledText Store(std::string_view value);
+	std::string_view GetText(const DemangledText& value) const;
+	std::string GetLabel() const;
+	void AddScope(std::string_view scope);
+	std::size_t FindTemplateArgumentsBegin(std::string_view scope) const;
+	void AddTemplateArguments(std::string_view arguments, DemangledScope& scope);
+};
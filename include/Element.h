@@ -8,7 +8,14 @@
 #include "Data.h"
 #include "Enum.h"
 #include "BaseClass.h"
+#include "ElementPayload.h"
 
+/*
+* Element usually uses only one payload so payloads are allocated when they are written.
+* Children are kept in typed lists while element is resolved because they are added, changed and reordered
+* separately in each list. JoinLists copies them to children when they are ordered by access specifiers,
+* copies share payloads so every copy costs only size of Element.
+*/
 struct Element
 {
     DWORD size;
@@ -16,12 +23,12 @@ struct Element
     DWORD bitOffset;
     DWORD numberOfBits;
     ElementType elementType;
-    UDT udt;
-    Function function;
-    TypeDef typeDef;
-    Data data;
-    Enum enum1;
-    BaseClass baseClass;
+    ElementPayload<UDT> udt;
+    ElementPayload<Function> function;
+    ElementPayload<TypeDef> typeDef;
+    ElementPayload<Data> data;
+    ElementPayload<Enum> enum1;
+    ElementPayload<BaseClass> baseClass;
     QList<QString> baseClassNames;
     QList<Element> children;
     QList<Element> baseClassChildren;
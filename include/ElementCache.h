@@ -0,0 +1,64 @@
+#pragma once
+
+#include <list>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include "Element.h"
+
+struct ElementCacheStatistics
+{
+	quint64 hits;
+	quint64 misses;
+	quint64 evictions;
+	qint64 memoryUsage;
+	qint64 memoryBudget;
+	int count;
+};
+
+/*
+* Cache of elements with memory budget. Size of every element is estimated when it's inserted
+* and least recently used elements are evicted when total size exceeds budget. Elements are shared
+* so element which is evicted while it's still used is released when last reference to it is dropped.
+*/
+class ElementCache
+{
+public:
+	ElementCache();
+
+	QSharedPointer<Element> Find(quint64 key, bool countMisses = true);
+	QSharedPointer<Element> Insert(quint64 key, const Element& element);
+	void Clear();
+
+	void SetMemoryBudget(qint64 memoryBudget);
+	ElementCacheStatistics GetStatistics();
+
+	static qint64 EstimateSize(const Element& element);
+
+private:
+	struct Entry
+	{
+		QSharedPointer<Element> element;
+		qint64 size;
+		std::list<quint64>::iterator position;
+	};
+
+	QHash<quint64, Entry> entries;
+	//Front of list contains most recently used element
+	std::list<quint64> recentlyUsed;
+	qint64 memoryUsage;
+	qint64 memoryBudget;
+	quint64 hits;
+	quint64 misses;
+	quint64 evictions;
+	QMutex mutex;
+
+	void EvictElements();
+
+	static qint64 EstimateSize(const QString& string);
+	static qint64 EstimateSize(const QList<QString>& strings);
+	static qint64 EstimateSize(const QList<Element>& elements);
+	static qint64 EstimateSize(const Data& data);
+	static qint64 EstimateSize(const UDT& udt);
+	static qint64 EstimateSize(const Function& function);
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QSharedData>
+#include <QSharedDataPointer>
+
+/*
+* Payload of element (UDT, function, data...) which is allocated only when it is written.
+* Reading payload which wasn't allocated returns empty value, copies of element share payloads
+* and payload is copied only when one of elements which share it is changed.
+* Payload is read through operator-> even if element isn't const, so cached elements aren't copied
+* when they are only read. Edit has to be used to change it.
+*/
+template <typename T>
+class ElementPayload
+{
+public:
+	ElementPayload()
+	{
+
+	}
+
+	ElementPayload(const T& value) : node(new Node(value))
+	{
+
+	}
+
+	ElementPayload& operator=(const T& value)
+	{
+		node = new Node(value);
+
+		return *this;
+	}
+
+	const T* operator->() const
+	{
+		return Get();
+	}
+
+	const T& operator*() const
+	{
+		return *Get();
+	}
+
+	const T* Get() const
+	{
+		const Node* constNode = node.constData();
+
+		return constNode ? &constNode->value : GetEmptyValue();
+	}
+
+	//Allocates payload if it's empty and detaches it from other elements which share it
+	T* Edit()
+	{
+		if (!node.constData())
+		{
+			node = new Node();
+		}
+
+		return &node->value;
+	}
+
+	bool IsNull() const
+	{
+		return !node.constData();
+	}
+
+	void Clear()
+	{
+		node = QSharedDataPointer<Node>();
+	}
+
+private:
+	struct Node : public QSharedData
+	{
+		T value;
+
+		Node() : value()
+		{
+
+		}
+
+		Node(const T& value) : value(value)
+		{
+
+		}
+	};
+
+	QSharedDataPointer<Node> node;
+
+	static const T* GetEmptyValue()
+	{
+		static const T emptyValue = {};
+
+		return &emptyValue;
+	}
+};
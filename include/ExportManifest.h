@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+/*
+* Signatures of files which were exported to some directory. Manifest is stored in text file next to include and src
+* directories, every line contains signature of type (together with options which were used to generate it)
+* and name of its files.
+*/
+class ExportManifest
+{
+public:
+	bool Load(const QString& filePath);
+	bool Save(const QString& filePath) const;
+
+	quint64 GetSignature(const QString& name) const;
+	void SetSignature(const QString& name, quint64 signature);
+	void RemoveSignature(const QString& name);
+
+	static const char* fileName;
+
+private:
+	QHash<QString, quint64> signatures;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <QString>
+#include "TextBuilder.h"
+
+//Code which is generated for one exported symbol before it is written to files
+struct ExportedSymbol
+{
+	QString name;
+	TextBuilder headerCode;
+	TextBuilder cppCode;
+	bool hasSourceCode;
+};
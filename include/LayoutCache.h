@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include "Element.h"
+
+enum class LayoutField
+{
+	defaultAlignment = 1,
+	correctAlignment = 2,
+	greatestPadding = 4,
+	flattenedSize = 8,
+	naturalAlignment = 16
+};
+
+/*
+* Layout of type which doesn't change once type is resolved. Flattened children have offsets which are
+* relative to start of type so they can be appended to flattened list of any type which contains it.
+*/
+struct TypeLayout
+{
+	quint32 fields;
+	quint32 defaultAlignment;
+	quint32 correctAlignment;
+	quint32 greatestPadding;
+	quint64 flattenedSize;
+	//Alignment which is calculated only from base classes and data members
+	quint32 naturalAlignment;
+	QList<Element> flattenedChildren;
+};
+
+/*
+* Alignment, padding and flattened layout of types which were already calculated.
+* Keys are same as keys of element cache so layouts which depend on different options are kept separately.
+*/
+class LayoutCache
+{
+public:
+	bool GetValue(quint64 key, LayoutField field, quint64& value);
+	void SetValue(quint64 key, LayoutField field, quint64 value);
+	bool GetFlattenedChildren(quint64 key, QList<Element>& flattenedChildren, quint64& flattenedSize);
+	void SetFlattenedChildren(quint64 key, const QList<Element>& flattenedChildren, quint64 flattenedSize);
+	void Clear();
+
+private:
+	QHash<quint64, TypeLayout> layouts;
+	QMutex mutex;
+};
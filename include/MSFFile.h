@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QtGlobal>
+#include <QFile>
+#include <QByteArray>
+#include <QVector>
+#include <QUuid>
+#include <QtEndian>
+
+/*
+* Multi-Stream Format (MSF) is the container format of PDB files.
+* File is split into blocks of equal size, first block contains super block
+* which points to the stream directory. Stream directory contains sizes of all streams
+* and indices of blocks which belong to each stream.
+*/
+struct MSFSuperBlock
+{
+	char fileMagic[32];
+	quint32 blockSize;
+	quint32 freeBlockMapBlock;
+	quint32 numBlocks;
+	quint32 numDirectoryBytes;
+	quint32 unknown;
+	quint32 blockMapAddress;
+};
+
+struct MSFBlockSpan
+{
+	const char* data;
+	quint32 length;
+};
+
+enum class MSFStreamIndex
+{
+	oldDirectory,
+	pdbInfo,
+	tpi,
+	dbi,
+	ipi
+};
+
+struct PDBInfoHeader
+{
+	quint32 version;
+	quint32 signature;
+	quint32 age;
+	QUuid guid;
+};
+
+class MSFStream
+{
+public:
+	MSFStream();
+	MSFStream(const uchar* fileData, quint32 blockSize, const QVector<quint32>& blocks, quint32 size);
+
+	bool IsValid() const;
+	quint32 GetSize() const;
+	int GetBlockCount() const;
+	MSFBlockSpan GetBlockSpan(int index) const;
+	bool IsContiguous() const;
+	bool Read(quint32 offset, quint32 length, void* buffer) const;
+	const char* GetData(quint32 offset, quint32 length, QByteArray& buffer) const;
+	QByteArray GetData() const;
+
+	template <typename T>
+	bool ReadValue(quint32 offset, T* value) const
+	{
+		if (!Read(offset, sizeof(T), value))
+		{
+			return false;
+		}
+
+		*value = qFromLittleEndian(*value);
+
+		return true;
+	}
+
+private:
+	const uchar* fileData;
+	quint32 blockSize;
+	QVector<quint32> blocks;
+	quint32 size;
+	bool isContiguous;
+};
+
+class MSFFile
+{
+public:
+	MSFFile();
+	~MSFFile();
+
+	bool Open(const QString& filePath);
+	void Close();
+	bool IsOpen() const;
+	const QString& GetErrorMessage() const;
+
+	quint32 GetBlockSize() const;
+	quint32 GetNumberOfBlocks() const;
+	bool IsBlockFree(quint32 blockIndex) const;
+	int GetNumberOfStreams() const;
+	quint32 GetStreamSize(int streamIndex) const;
+	MSFStream GetStream(int streamIndex) const;
+	MSFStream GetStream(MSFStreamIndex streamIndex) const;
+	bool GetPDBInfo(PDBInfoHeader* pdbInfoHeader) const;
+
+private:
+	QFile file;
+	const uchar* fileData;
+	qint64 fileSize;
+	MSFSuperBlock superBlock;
+	QVector<quint32> streamSizes;
+	QVector<QVector<quint32>> streamBlocks;
+	QString errorMessage;
+
+	bool ReadSuperBlock();
+	bool ReadStreamDirectory();
+	bool IsBlockIndexValid(quint32 blockIndex) const;
+	const uchar* GetBlockData(quint32 blockIndex) const;
+};
@@ -1,136 +1,94 @@
 #pragma once
 
 #include <iostream>
-#include <map>
 #include "DemangleData.h"
 #include "DataType.h"
+#include "MangledCodeTable.h"
+#include "DemangledSymbol.h"
+
+enum class DataTypeCategory
+{
+	simple,
+	modifier,
+	complex
+};
+
+struct DataTypeCode
+{
+	DataTypeCategory category;
+	std::string_view name;
+	//Qualifier of pointer or reference modifier
+	std::string_view qualifier = {};
+};
+
+struct ThunkAccess
+{
+	std::string_view thunk;
+	std::string_view access;
+};
+
+struct CLIArgument
+{
+	std::string_view postfix;
+	std::string_view prefix;
+};
 
 class MSVCDemangler
 {
 public:
-	MSVCDemangler();
-	std::string DemangleSymbol(std::string symbol, std::string& rest, bool verbose = false);
+	std::string DemangleSymbol(const std::string& symbol, std::string& rest, bool verbose = false);
+	std::string DemangleSymbol(const std::string& symbol, std::string& rest, DemangledSymbol& demangledSymbol, bool verbose = false);
+	bool HasError() const;
+	const std::string& GetErrorMessage() const;
 
 private:
 	std::string quoteB = "`";
 	std::string quoteE = "'";
+	std::string errorMessage;
 
-	std::map<std::string, std::string> callingConventions;
-	std::map<std::string, std::multimap<std::string, std::vector<std::string>>> dataTypes;
-	std::map<std::string, std::string> enumTypes;
-	std::map<std::string, std::string> specialFragments;
-	std::map<std::string, std::multimap<std::string, std::string>> thunkAccesses;
-
-	std::string DemangleReentrantSymbol(DemangleData* data);
-	std::tuple<DataType, std::string, std::string> DemangleFunctionPrototypeSymbol(DemangleData* data);
-	std::string DemangleLocalStaticGuardSymbol(std::vector<std::string> names, DemangleData* data);
-	std::string DemangleVariableSymbol(std::vector<std::string> names, DemangleData* data);
-	std::string DemangleFunctionSymbol(std::vector<std::string> names, DemangleData* data);
+	std::string DemangleReentrantSymbol(DemangleData* data, DemangledSymbol* demangledSymbol = nullptr);
+	std::tuple<DataType, std::string, std::string> DemangleFunctionPrototypeSymbol(DemangleData* data, std::vector<std::string>* arguments = nullptr);
+	std::string DemangleLocalStaticGuardSymbol(std::vector<std::string>& names, DemangleData* data, DemangledSymbol* demangledSymbol);
+	std::string DemangleVariableSymbol(std::vector<std::string>& names, DemangleData* data, DemangledSymbol* demangledSymbol);
+	std::string DemangleFunctionSymbol(std::vector<std::string>& names, DemangleData* data, DemangledSymbol* demangledSymbol);
 	std::string ExtractTemplate(DemangleData* data);
 	std::string ExtractNameString(DemangleData* data);
 	std::string ExtractSpecialName(DemangleData* data);
 	std::vector<std::string> ExtractNamesList(DemangleData* data);
 	std::string ExtractNameFragment(DemangleData* data);
-	std::vector<std::string> ArgList(DemangleData* data, std::string stop = "");
+	std::vector<std::string> ArgList(DemangleData* data, std::string_view stop = "");
 	DataType GetDataType(DemangleData* data, int depth = 0);
 	void FinalizeName(std::vector<std::string>& names, DataType& returnType);
 
-	template <typename T>
-	T ParseValue(DemangleData* data, std::map<std::string, T> table, std::string logMessage = "");
-
-	template <>
-	std::string ParseValue<std::string>(DemangleData* data, std::map<std::string, std::string> table, std::string logMessage)
-	{
-		//Function for accessing the tables below
-
-		for (auto it = table.begin(); it != table.end(); it++)
-		{
-			std::string name = data->GetValue();
-
-			if (name.substr(0, it->first.length()) == it->first)
-			{
-				data->Advance(static_cast<int>(it->first.length()));
-
-				if (logMessage.length())
-				{
-					data->Log("%s%s", logMessage, it->first);
-				}
-
-				return it->second;
-			}
-		}
-
-		if (logMessage.length())
-		{
-			data->Log("%NONE", logMessage);
-		}
-
-		return {};
-	}
-
-	template <>
-	std::multimap<std::string, std::vector<std::string>> ParseValue<std::multimap<std::string, std::vector<std::string>>>(DemangleData* data, std::map<std::string, std::multimap<std::string, std::vector<std::string>>> table, std::string logMessage)
+	//Returns value of code which rest of input starts with and skips code or returns empty value if there is no such code
+	template <typename T, std::size_t count>
+	T ParseValue(DemangleData* data, const MangledCodeTable<T, count>& table, const char* logMessage = nullptr)
 	{
-		//Function for accessing the tables below
+		const MangledCode<T>* code = table.Find(data->GetValue());
 
-		for (auto it = table.begin(); it != table.end(); it++)
+		if (!code)
 		{
-			std::string name = data->GetValue();
-
-			if (name.substr(0, it->first.length()) == it->first)
+			if (logMessage)
 			{
-				data->Advance(static_cast<int>(it->first.length()));
-
-				if (logMessage.length())
-				{
-					data->Log("%s%s", logMessage, it->first);
-				}
-
-				return it->second;
+				data->Log("%sNONE", logMessage);
 			}
-		}
 
-		if (logMessage.length())
-		{
-			data->Log("%NONE", logMessage);
+			return {};
 		}
 
-		return {};
-	}
-
-	template <>
-	std::multimap<std::string, std::string> ParseValue<std::multimap<std::string, std::string>>(DemangleData* data, std::map<std::string, std::multimap<std::string, std::string>> table, std::string logMessage)
-	{
-		//Function for accessing the tables below
-
-		for (auto it = table.begin(); it != table.end(); it++)
-		{
-			std::string name = data->GetValue();
-
-			if (name.substr(0, it->first.length()) == it->first)
-			{
-				data->Advance(static_cast<int>(it->first.length()));
-
-				if (logMessage.length())
-				{
-					data->Log("%s%s", logMessage, it->first);
-				}
-
-				return it->second;
-			}
-		}
+		data->Advance(static_cast<int>(code->code.length()));
 
-		if (logMessage.length())
+		if (logMessage)
 		{
-			data->Log("%NONE", logMessage);
+			data->Log("%s%.*s", logMessage, static_cast<int>(code->code.length()), code->code.data());
 		}
 
-		return {};
+		return code->value;
 	}
 
 	int DecodeNumber(DemangleData* data);
 	std::vector<std::string> GetClassModifiers(DemangleData* data);
-	std::string Join(const std::vector<std::string>& vector, std::string delimiter);
+	std::string Join(const std::vector<std::string>& vector, std::string_view delimiter);
 
 	template <typename T, typename... Args>
 	std::vector<T> GetVector(const Args&... args)
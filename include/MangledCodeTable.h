@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+template <typename T>
+struct MangledCode
+{
+	std::string_view code;
+	T value;
+};
+
+constexpr std::size_t GetMangledCodeSlotCount(std::size_t count)
+{
+	std::size_t slotCount = 4;
+
+	while (slotCount < count * 2)
+	{
+		slotCount *= 2;
+	}
+
+	return slotCount;
+}
+
+/*
+* Table of mangling codes which is built at compile time. Codes have at most three characters and
+* no code is prefix of other code, so only code which input can start with is found by looking up
+* first one, two and three characters of input in open addressing hash table which is part of table.
+* Invalid, duplicate or ambiguous codes stop compilation.
+*/
+template <typename T, std::size_t count>
+class MangledCodeTable
+{
+public:
+	constexpr MangledCodeTable(const MangledCode<T>(&codes)[count]) : codes(), slots(), maxLength(0)
+	{
+		for (std::size_t i = 0; i < slotCount; i++)
+		{
+			slots[i] = -1;
+		}
+
+		for (std::size_t i = 0; i < count; i++)
+		{
+			std::string_view code = codes[i].code;
+
+			if (code.length() == 0 || code.length() > maxCodeLength)
+			{
+				throw "Mangling code has to have from one to three characters";
+			}
+
+			for (std::size_t j = 0; j < count; j++)
+			{
+				if (i != j && codes[j].code.starts_with(code))
+				{
+					throw "Mangling code is prefix of other code";
+				}
+			}
+
+			if (code.length() > maxLength)
+			{
+				maxLength = code.length();
+			}
+
+			std::size_t slot = Hash(code);
+
+			while (slots[slot] != -1)
+			{
+				slot = (slot + 1) & (slotCount - 1);
+			}
+
+			this->codes[i] = codes[i];
+			slots[slot] = static_cast<int>(i);
+		}
+	}
+
+	constexpr const MangledCode<T>* Find(std::string_view input) const
+	{
+		for (std::size_t length = 1; length <= maxLength && length <= input.length(); length++)
+		{
+			std::string_view code = input.substr(0, length);
+
+			for (std::size_t slot = Hash(code); slots[slot] != -1; slot = (slot + 1) & (slotCount - 1))
+			{
+				if (codes[slots[slot]].code == code)
+				{
+					return &codes[slots[slot]];
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+private:
+	static constexpr std::size_t maxCodeLength = 3;
+	static constexpr std::size_t slotCount = GetMangledCodeSlotCount(count);
+
+	std::array<MangledCode<T>, count> codes;
+	std::array<int, slotCount> slots;
+	std::size_t maxLength;
+
+	static constexpr std::size_t Hash(std::string_view code)
+	{
+		std::uint32_t key = static_cast<std::uint32_t>(code.length());
+
+		for (char character : code)
+		{
+			key = key << 8 | static_cast<unsigned char>(character);
+		}
+
+		return ((key * 2654435761u) >> 16) & (slotCount - 1);
+	}
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+
+struct NameArenaStatistics
+{
+	quint64 requests;
+	quint32 count;
+	qint64 requestedSize;
+	qint64 storedSize;
+	double dedupRatio;
+};
+
+/*
+* Process wide pool of type and symbol names. Every distinct name is stored once and gets 32-bit ID
+* which never changes, ID 0 is empty name. Names are stored in blocks which are never moved
+* so reference returned by GetName stays valid and names can be read without lock.
+*/
+class NameArena
+{
+public:
+	static quint32 Intern(const QString& name);
+	static QString InternString(const QString& name);
+	static const QString& GetName(quint32 id);
+	static NameArenaStatistics GetStatistics();
+
+private:
+	static const int blockBits = 14;
+	static const int blockSize = 1 << blockBits;
+	static const int blockCount = 1 << 14;
+
+	QHash<QString, quint32> ids;
+	std::atomic<QString*> blocks[blockCount];
+	std::atomic<quint32> count;
+	std::atomic<quint64> requests;
+	std::atomic<qint64> requestedSize;
+	qint64 storedSize;
+	QReadWriteLock lock;
+
+	NameArena();
+	~NameArena();
+
+	static NameArena& GetInstance();
+	quint32 InternName(const QString& name);
+};
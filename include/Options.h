@@ -37,6 +37,7 @@ struct Options
 	bool generateOnlySource = false;
 	bool generateBoth = false;
 	bool exportDependencies = false;
+	bool exportToSingleHeader = false;
 
 	bool displayWithTrailingReturnType = false;
 	bool displayWithTypedef = false;
@@ -70,4 +71,8 @@ struct Options
 	bool variablePascalCase = false;
 	bool variableSnakeCase = false;
 	bool removeHungaryNotationFromVariable = false;
+
+	int elementCacheSize = 256;
+	//Threads which derive elements and generate code during export, DIA is used by one of them at a time, 0 uses all cores
+	int exportThreadCount = 0;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <unordered_map>
 #include <vector>
 #include "DIA SDK/dia2.h"
@@ -15,6 +16,11 @@
 #include <QStringBuilder>
 #include <QMessageBox>
 #include <QProcess>
+#include <QThreadPool>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+#include <QAtomicInt>
 #include "PEHeaderParser.h"
 #include "SymbolRecord.h"
 #include "Element.h"
@@ -27,16 +33,49 @@
 #include "DataOptions.h"
 #include "FunctionOptions.h"
 #include "PublicSymbol.h"
-#include "MSVCDemangler.h"
+#include "SymbolDemangler.h"
+#include "MSFFile.h"
+#include "TPIStream.h"
+#include "SymbolIndex.h"
+#include "SymbolLocator.h"
+#include "ElementCache.h"
+#include "NameArena.h"
+#include "TypeName.h"
+#include "LayoutCache.h"
+#include "ResolutionContext.h"
+#include "TextBuilder.h"
+#include "ExportedSymbol.h"
+#include "TypeGraph.h"
+#include "TypeSignature.h"
+#include "ExportManifest.h"
 
 class PDB : public QObject
 {
     Q_OBJECT
 
+public:
+    //Symbols imported from TPI stream use type index with this flag as ID until DIA symbol is requested
+    static const DWORD typeIndexFlag = 0x80000000;
+    //Variables, functions and public symbols use index of their locator with this flag as ID
+    static const DWORD symbolLocatorFlag = 0x40000000;
+    static const int tpiChunkSize = 4096;
+    //Size of buffer in which code is collected before it's written to single header
+    static const int exportBufferSize = 16 * 1024 * 1024;
+
 private:
 	IDiaDataSource* diaDataSource;
 	IDiaSession* diaSession;
 	IDiaSymbol* global;
+    //DIA session isn't thread safe, export workers resolve symbols only while they hold this mutex
+    QRecursiveMutex diaMutex;
+    MSFFile msfFile;
+    PDBInfoHeader pdbInfoHeader;
+    TPIStream tpiStream;
+    QHash<DWORD, DWORD> typeIndexIDs;
+    QMutex typeIndexIDsMutex;
+    QVector<SymbolLocator> symbolLocators;
+    QMutex symbolLocatorsMutex;
+    bool importedTables[static_cast<int>(SymbolIndexTable::count)];
     QHash<QString, DWORD>* diaSymbols;
     std::vector<SymbolRecord>* symbolRecords;
     int classesCount;
@@ -48,40 +87,25 @@ private:
     Options* options;
     PEHeaderParser* peHeaderParser;
     CV_CPU_TYPE_e type;
-    QList<QString> functionParameterNames;
-    QSet<QString> includes;
-    QHash<int, SymbolRecord> dependencies;
-    QHash<QString, int> vTableIndices;
     QMap<int, QString> vTableIndices2;
-    QHash<QString, QString> virtualFunctionPrototypes;
-    QHash<QString, QHash<QString, QString>> virtualFunctionPrototypes2;
-    QMap<int, QString> vTableNames;
-    QMap<QString, int> vTableNames2;
-    QHash<QString, QHash<QString, int>> vTables;
-    QHash<QString, int> vTableOffsets;
-    int vTableIndex;
-    bool destructorAdded;
     QString fileNameWithoutExtension;
     QString filePath;
-    QMap<int, Element> virtualFunctions;
     std::unordered_map<std::string, std::string> imports;
     ProcessType processType;
     QHash<QString, DWORD>* variables;
     QHash<QString, DWORD>* functions;
     QHash<QString, DWORD>* publicSymbols;
-    bool hasVirtualDestructor;
-    QHash<quint32, Element> elements;
+    ElementCache elements;
+    //Index of every distinct options fingerprint which is used in keys of cached elements
+    QHash<quint64, quint32> optionSets;
+    QMutex optionSetsMutex;
+    TypeGraph typeGraph;
+    LayoutCache layoutCache;
+    ResolutionContext mainContext;
     QString windowTitle;
     bool isTypeImported;
     QHash<QString, quint32> baseTypes;
     QHash<QString, QString> baseTypes2;
-    QString parentClassName;
-    QString parentClassName2;
-    bool isMainUDT;
-    bool belongsToMainUDT;
-    QList<Element> typedefChildren;
-    bool displayIncludes;
-    MSVCDemangler msvcDemangler;
 
 signals:
     void Completed();
@@ -98,11 +122,22 @@ public:
     ~PDB();
 
     bool ReadFromFile(const QString& filePath);
-    void LoadPDBData();
-	void GetVariables();
-	void GetFunctions();
-	void GetPublicSymbols();
-    void GetSymbolsFromTable(IDiaEnumSymbols* enumSymbols, int* currentIndex, int* currentProcent, int* procent);
+    bool OpenMSFFile(const QString& filePath);
+    void CloseSession();
+    const MSFFile* GetMSFFile() const;
+    const PDBInfoHeader& GetPDBInfoHeader() const;
+    const TPIStream* GetTPIStream() const;
+    void ImportSymbols();
+    void LoadTypesFromTPI(int* currentIndex);
+    void AddSymbolRecord(const SymbolRecord& symbolRecord);
+    void AddSymbolLocator(QHash<QString, DWORD>* table, IDiaSymbol* symbol, DWORD symTag, const QString& name, quint32 attributes = 0);
+    SymbolLocator GetSymbolLocator(IDiaSymbol* symbol, DWORD symTag, quint32 attributes = 0);
+    void AddSymbolLocator(QHash<QString, DWORD>* table, const SymbolLocator& symbolLocator);
+    quint32 GetSymbolAttributes(DWORD id);
+    quint32 GetImportOptions();
+    bool LoadSymbolIndex();
+    bool SaveSymbolIndex();
+    void GetSymbolsFromTable(IDiaEnumSymbols* enumSymbols, int* currentIndex, int* currentProcent, int* procent, bool importTypes = true);
     int GetCountOfClasses();
     int GetCountOfStructs();
     int GetCountOfInterfaces();
@@ -123,6 +158,12 @@ public:
     Value GetValue(IDiaSymbol* symbol);
     Data GetData(IDiaSymbol* symbol);
     BaseClass GetBaseClass(IDiaSymbol* symbol);
+    void InternNames(UDT* udt);
+    void InternNames(Function* function);
+    void InternNames(Enum* enum1);
+    void InternNames(Data* data);
+    void InternNames(BaseClass* baseClass);
+    void InternNames(QList<QString>* names);
     PublicSymbol GetPublicSymbol(IDiaSymbol* symbol);
     QString GetSourceFilePath(IDiaSymbol* symbol);
     QString GetSourceFileInfo(IDiaSourceFile* source);
@@ -136,7 +177,11 @@ public:
     QString GetExportName(IDiaSymbol* symbol);
 
 	bool GetSymbolByID(DWORD id, IDiaSymbol** symbol);
+    bool GetSymbolByTypeIndex(quint32 typeIndex, IDiaSymbol** symbol);
+    bool GetSymbolByLocator(int index, IDiaSymbol** symbol);
 	bool GetSymbolByTypeName(enum SymTagEnum symTag, QString typeName, IDiaSymbol** symbol);
+    bool GetSymbolRecordByTypeName(const QString& typeName, SymbolRecord* symbolRecord);
+    SymbolType GetSymbolTypeFromLeaf(quint16 kind);
     Element GetElement(SymbolRecord* symbolRecord, bool addToPrototypesList = false);
     Element GetElement(IDiaSymbol* symbol);
     void InsertElement(Element* element, const Element* childElement);
@@ -164,19 +209,20 @@ public:
     QString GetTab(int level);
     QString GetBaseClassesInfo(const Element* element, bool addKeywords = true);
     QString GetEnumInfo(const Element* element, int level);
-    QString GetUDTInfo(Element* element, int level);
+    void GetUDTInfo(Element* element, TextBuilder& text, int level);
     QString GetElementInfo(Element* element, int level = 0);
+    void GetElementInfo(Element* element, TextBuilder& text, int level = 0);
     QString GetDataInfo(const Data* data, int level);
     QString GetFunctionInfo(const Element* element, int level);
     Data ConvertRecordTypeToData(const RecordType* recordType);
     QString DataTypeToString(const Data* data, const DataOptions* dataOptions);
     QString FunctionTypeToString(const Element* element, const FunctionOptions* functionOptions);
     QString GenerateCustomParameterName(QString parameterType, int i);
-    void GetTemplateIncludes(QString templateTypeName, const QString& parentClassName);
+    void GetTemplateIncludes(const QString& templateTypeName, const QString& parentClassName);
     bool CheckIfNameOfMainOrInnerUDT(const QString& typeName, const QString& parentClassName);
     void AddTypeNameToIncludesList(const QString& typeName, const QString& parentClassName);
-    void AddComments(const Element* element, QString& text, int i);
-    void AddAdditionalNewLine(const Element* element, QString& text, int i);
+    void AddComments(const Element* element, TextBuilder& text, int i);
+    void AddAdditionalNewLine(const Element* element, TextBuilder& text, int i);
     bool AddAdditionalNewLineBeforeFunc(const Element* element, int i);
     void RemoveScopeResolutionOperators(QString& text, const QString& parentClassName);
     bool CheckIfInnerUDTBelongsToMainUDT(Element* element, Element* innerUDT);
@@ -209,6 +255,7 @@ public:
     void AddCopyAssignmentOperator(Element* element);
     void ApplyReturnValueOptimization(Element* element);
     void FlattenUDT(Element* element, Element* newElement, quint64* offset, quint32* alignmentNum);
+    void AppendFlattenedChildren(const QList<Element>& flattenedChildren, Element* newElement, quint64 offset, quint32* alignmentNum);
 
     Element OrderUDTElementChildren(Element element);
     Element OrderUDTChildrenByAccessSpecifiers(Element element);
@@ -220,7 +267,8 @@ public:
     bool ShouldIncludeElement(Element element);
     void CheckIfUnionsAreMissing(Element* element);
 
-    quint32 CalculateDefaultAlignment(const Element* element, QHash<QString, int> checkedTypes);
+    quint32 CalculateDefaultAlignment(const Element* element, QSet<QString>& checkedTypes);
+    quint32 GetDefaultAlignment(const QString& typeName, bool isEnum, QSet<QString>& checkedTypes);
     quint32 GetCorrectAlignment(quint32 defaultAlignment, quint32 typeSize);
     unsigned int GetGreatestPaddingInUDT(const Element* element);
     unsigned int NextPowerOf2(unsigned int value);
@@ -230,6 +278,7 @@ public:
     QString TrimEnd(const QString& input);
 
     QString GenerateCPPCode(const Element* element, int level = 0);
+    void GenerateCPPCode(const Element* element, TextBuilder& code, int level = 0);
     QString ImplementVariadicTemplateFunction(const Element* element, int level = 0);
     QString GetBaseAddressVariableName();
 
@@ -240,7 +289,27 @@ public:
 
     void SetProcessType(ProcessType processType);
     void ExportSymbol(SymbolRecord symbolRecord);
-    void GetDependencies(const Element* element);
+    ExportedSymbol GenerateExportedSymbol(SymbolRecord symbolRecord);
+    void WriteExportedSymbol(const ExportedSymbol& exportedSymbol);
+    QString GetExportedSymbolName(const QString& typeName);
+    int GetExportThreadCount();
+    quint32 GetTypeIndex(const SymbolRecord& symbolRecord);
+    quint64 GetAddressSignature(IDiaSymbol* symbol, quint64 signature);
+    quint64 GetTypeSignature(TypeSignature& typeSignature, const SymbolRecord& symbolRecord);
+    quint64 GetExportOptionsSignature();
+    QString GetExportManifestPath();
+    void ExportChangedSymbols(const SymbolRecord* records, int count);
+    void ExportSymbols(const SymbolRecord* records, int count, const std::function<void(const ExportedSymbol&)>& writeExportedSymbol);
+    void ExportSymbolsToSingleHeader(const SymbolRecord* records, int count);
+    void BuildTypeGraph(const SymbolRecord* records, int count);
+    void AddTypeToTypeGraph(SymbolRecord symbolRecord);
+    void SortSymbolRecordsByDependencies(const SymbolRecord* records, int count, QVector<SymbolRecord>* sortedRecords,
+        QVector<SymbolRecord>* forwardDeclarations);
+    bool GetForwardDeclaration(const SymbolRecord& symbolRecord, QString* forwardDeclaration);
+    QString RemoveIncludeDirectives(const QString& code);
+    QVector<SymbolRecord> GetDependencies(const SymbolRecord& symbolRecord);
+    void GetTypeReferences(const Element* element, QVector<SymbolRecord>* references, QSet<DWORD>* referencedTypes);
+    void AddTypeReference(const SymbolRecord& symbolRecord, QVector<SymbolRecord>* references, QSet<DWORD>* referencedTypes);
     void ExportSymbolWithDependencies(SymbolRecord* symbolRecord);
     void ExportAllSymbols();
 
@@ -259,10 +328,15 @@ public:
     QString RemoveHungarianNotationFromUDTAndEnums(const QString& name, bool isEnum = false);
     QString RemoveHungarianNotationFromVariable(const QString& name);
 
+    ResolutionContext* GetResolutionContext();
     void ClearVTables();
     void ClearVirtualFunctionPrototypes();
     void ClearVTableNames();
     void ClearElements();
+    void SetElementCacheMemoryBudget(qint64 memoryBudget);
+    ElementCacheStatistics GetElementCacheStatistics();
+    quint64 GetOptionsFingerprint(bool isDerived = true);
+    quint64 GetElementKey(DWORD id, bool isDerived);
 
     void GetVTablesLayout(Element* element, QString& layout, quint64* offset, int level = 0);
     QString GetVirtualFunctionsInfo(const Element* element);
@@ -22,6 +22,7 @@
 #include <QStackedWidget>
 #include <QStackedLayout>
 #include <QLibrary>
+#include <QCache>
 #include "lexilla/Lexilla.h"
 #include "lexilla/SciLexer.h"
 #include "scintilla/ScintillaEdit.h"
@@ -29,6 +30,7 @@
 #include "PDB.h"
 #include "PDBProcessDialog.h"
 #include "OptionsDialog.h"
+#include "SymbolTableModel.h"
 #include "Options.h"
 #include "ui_PDBExplorer.h"
 
@@ -45,7 +47,7 @@ protected:
 
 private:
     Ui::PDBExplorerClass ui;
-    QSortFilterProxyModel* symbolsViewProxyModel;
+    SymbolTableModel* symbolTableModel;
     QSortFilterProxyModel* proxyModel;
     QSortFilterProxyModel* proxyModel2;
     QStringListModel* model;
@@ -64,6 +66,8 @@ private:
     ScintillaEdit* pseudoCodeEditor2;
     QMenu* menu;
     QAction* action;
+    QLabel* lblCacheStatistics;
+    QCache<quint64, QString> headerCodeCache;
     QHash<QString, DWORD> variables;
     QHash<QString, DWORD> functions;
     QHash<QString, DWORD> publicSymbols;
@@ -86,20 +90,15 @@ private:
     QStackedLayout* stackedLayout;
     bool isFileOpened;
     QString filePath;
-    MSVCDemangler msvcDemangler;
 
     void OpenFile(const QString& filePath);
-    ProcessType GetProcessType();
     void DisplayFileInfo(const QString& filePath);
     void AddSymbolsToList();
-    void AddSymbolsToList(SymbolType symbolType);
     void AddDataSymbolsToList(QHash<QString, DWORD>* variables);
-    void AddDataSymbolsToList(QHash<QString, DWORD>* variables, bool isGlobal);
     void AddFunctionSymbolsToList(QHash<QString, DWORD>* functions);
-    void AddFunctionSymbolsToList(QHash<QString, DWORD>* functions, bool isGlobal, bool isStatic, bool isMember);
     void AddPublicSymbolsToList();
-    void RemoveSymbolsFromList(SymbolType symbolType);
-    void RemoveSymbolsFromList(const int type);
+    void UpdateSymbolFilter();
+    void ClassifySymbols();
     void HandleTableViewEvent();
     SymbolRecord GetSelectedSymbolRecord();
     void HandleUDTAndEnumType();
@@ -146,6 +145,7 @@ private slots:
     void TxtSearchSymbolTextChanged(const QString& text);
     void BtnSearchSymbolClicked();
     void TVSymbolsClicked(const QModelIndex& index);
+    void SymbolTableModelReset();
     void TxtFindItemTextChanged(const QString& text);
     void LVVTablesClicked(const QModelIndex& index);
     void TxtMangledNameTextChanged(const QString& text);
@@ -166,6 +166,8 @@ private slots:
     void CbDisplayOptionsCurrentIndexChanged(int index);
 
     void DisplayStatusMessage(const QString& message);
+    void SetCacheMemoryBudget();
+    void DisplayCacheStatistics();
     void ExportSymbol();
     void CustomMenuRequested(QPoint position);
 };
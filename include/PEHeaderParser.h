@@ -9,6 +9,8 @@
 #include <QObject>
 #include <QHash>
 #include <QMultiHash>
+#include <QMutex>
+#include "SymbolDemangler.h"
 
 #pragma comment(lib, "dbghelp.lib")
 
@@ -33,7 +35,7 @@ public:
 	bool ReadImportTable(std::unordered_map<std::string, std::string>& imports);
 	bool ReadImportTable(QMultiHash<QString, QString>& imports);
 	bool ReadExportTable(QHash<QString, QString>& exports);
-	std::string UndecorateName(const char* decoratedName);
+	std::string UndecorateName(const char* decoratedName, bool useCache = true);
 	CV_CPU_TYPE_e GetMachineType();
 	DWORD ConvertVAToRVA(DWORD va);
 	DWORD ConvertVAToFileOffset(DWORD va);
@@ -2,10 +2,7 @@
 
 enum class ProcessType
 {
-	importUDTsAndEnums,
-	importVariables,
-	importFunctions,
-	importPublicSymbols,
+	importSymbols,
 	exportUDTsAndEnums,
 	exportUDTsAndEnumsWithDependencies,
 	exportAllUDTsAndEnums
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include "Element.h"
+#include "Options.h"
+
+/*
+* State which GetElement and functions which it calls share while type is resolved and its code is generated.
+* PDB uses its own context unless other context is set for current thread with ResolutionContextScope,
+* so worker threads can resolve types at same time if each of them uses its own context.
+*/
+struct ResolutionContext
+{
+	const Options* options;
+	bool isMainUDT;
+	bool belongsToMainUDT;
+	QString parentClassName;
+	QString parentClassName2;
+	int vTableIndex;
+	QHash<QString, QHash<QString, int>> vTables;
+	QMap<int, QString> vTableNames;
+	QMap<QString, int> vTableNames2;
+	QHash<QString, int> vTableOffsets;
+	QHash<QString, int> vTableIndices;
+	QHash<QString, QString> virtualFunctionPrototypes;
+	QHash<QString, QHash<QString, QString>> virtualFunctionPrototypes2;
+	QMap<int, Element> virtualFunctions;
+	QSet<QString> includes;
+	QList<Element> typedefChildren;
+	QList<QString> functionParameterNames;
+	bool destructorAdded;
+	bool hasVirtualDestructor;
+	//Includes are hidden while members of base class are resolved
+	bool includesHidden;
+	bool includesWereHidden;
+	//Original type names are generated with scope resolution operators even if option is enabled
+	bool keepScopeResolutionOperator;
+	//Depth of nested GetElement calls, 0 is type which was requested
+	int resolutionDepth;
+
+	ResolutionContext(const Options* options);
+
+	bool DisplayIncludes() const;
+	bool RemoveScopeResolutionOperator() const;
+
+	static ResolutionContext* GetCurrent();
+	static ResolutionContext* SetCurrent(ResolutionContext* context);
+};
+
+//Sets context for current thread while scope exists
+class ResolutionContextScope
+{
+public:
+	ResolutionContextScope(ResolutionContext* context);
+	~ResolutionContextScope();
+
+private:
+	ResolutionContext* previousContext;
+};
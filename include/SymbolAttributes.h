@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QtGlobal>
+
+enum SymbolCategory : quint32
+{
+    globalSymbol = 0x1,
+    staticSymbol = 0x2,
+    memberSymbol = 0x4
+};
+
+/*
+* Attributes of variables and functions are captured once during import and packed into 32 bits,
+* first byte contains categories, second byte data kind and third byte location type (storage class)
+*/
+inline quint32 MakeSymbolAttributes(quint32 categories, quint32 dataKind, quint32 locationType)
+{
+    return (categories & 0xFF) | (dataKind & 0xFF) << 8 | (locationType & 0xFF) << 16;
+}
+
+inline quint32 GetSymbolCategories(quint32 attributes)
+{
+    return attributes & 0xFF;
+}
+
+inline quint32 GetSymbolDataKind(quint32 attributes)
+{
+    return attributes >> 8 & 0xFF;
+}
+
+inline quint32 GetSymbolLocationType(quint32 attributes)
+{
+    return attributes >> 16 & 0xFF;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <QReadWriteLock>
+#include "MSVCDemangler.h"
+
+/*
+* Process wide cache of demangled symbol names which is shared by importer, PE header parser and UI.
+* Cache is split to shards by hash of mangled name so threads which demangle different names rarely
+* wait for the same lock. Names which are demangled by MSVCDemangler and names which are undecorated
+* with __unDName are kept separately because their results differ.
+* Cache has to be cleared when PDB is closed because names are only reused while the same PDB is open.
+*/
+class SymbolDemangler
+{
+public:
+	//Names are demangled on calling thread if batch is smaller than this
+	static const int batchChunkSize = 1024;
+
+	static std::string Demangle(const std::string& mangledName, bool useCache = true);
+	static std::vector<quint32> DemangleToNameIDs(std::span<const std::string> mangledNames);
+	static std::string DemangleQualifiedName(const std::string& mangledName);
+	static bool FindUndecoratedName(const std::string& decoratedName, std::string& undecoratedName);
+	static void AddUndecoratedName(const std::string& decoratedName, const std::string& undecoratedName);
+	static void Clear();
+
+private:
+	static const int shardBits = 6;
+	static const int shardCount = 1 << shardBits;
+
+	struct Shard
+	{
+		std::unordered_map<std::string, std::string> names;
+		QReadWriteLock lock;
+	};
+
+	Shard demangledNames[shardCount];
+	Shard undecoratedNames[shardCount];
+
+	static SymbolDemangler& GetInstance();
+	static Shard& GetShard(Shard* shards, const std::string& mangledName);
+	static bool FindName(Shard& shard, const std::string& mangledName, std::string& name);
+	static void AddName(Shard& shard, const std::string& mangledName, const std::string& name);
+	static std::string Demangle(MSVCDemangler& msvcDemangler, const std::string& mangledName);
+	static std::string DemangleName(MSVCDemangler& msvcDemangler, const std::string& mangledName);
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QtGlobal>
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include "MSFFile.h"
+
+enum class SymbolIndexTable
+{
+	symbolRecords,
+	variables,
+	functions,
+	publicSymbols,
+	count
+};
+
+/*
+* Index file consists of header, table directory, records of all tables and string pool.
+* All offsets are relative to start of file and names are stored as UTF-16
+* so file can be mapped into memory and used without parsing.
+*/
+struct SymbolIndexHeader
+{
+	char magic[8];
+	quint32 version;
+	quint32 headerSize;
+	quint8 guid[16];
+	quint32 age;
+	quint32 signature;
+	quint32 importOptions;
+	quint32 tableCount;
+	quint64 stringPoolOffset;
+	quint64 stringPoolSize;
+};
+
+struct SymbolIndexTableEntry
+{
+	quint32 table;
+	quint32 recordCount;
+	quint64 offset;
+};
+
+/*
+* For symbol records value1 is ID and value2 is symbol type,
+* for other tables value1 is symbol tag, value2 is relative virtual address and value3 is attributes
+*/
+struct SymbolIndexRecord
+{
+	quint32 value1;
+	quint32 value2;
+	quint64 nameOffset;
+	quint32 nameLength;
+	quint32 value3;
+};
+
+struct SymbolIndexEntry
+{
+	QString name;
+	quint32 value1;
+	quint32 value2;
+	quint32 value3;
+};
+
+class SymbolIndex
+{
+public:
+	static const quint32 version = 2;
+
+	SymbolIndex();
+	~SymbolIndex();
+
+	bool Open(const QString& filePath, const PDBInfoHeader& pdbInfoHeader, quint32 importOptions);
+	void Close();
+	bool IsOpen() const;
+	const QString& GetErrorMessage() const;
+
+	bool HasTable(SymbolIndexTable table) const;
+	int GetRecordCount(SymbolIndexTable table) const;
+	const SymbolIndexRecord* GetRecords(SymbolIndexTable table) const;
+	QString GetName(const SymbolIndexRecord& record) const;
+
+	static bool Write(const QString& filePath, const PDBInfoHeader& pdbInfoHeader, quint32 importOptions,
+		const QVector<SymbolIndexEntry>* tables, const bool* hasTables);
+	static QString GetFilePath(const PDBInfoHeader& pdbInfoHeader);
+
+private:
+	QFile file;
+	const uchar* fileData;
+	qint64 fileSize;
+	const SymbolIndexHeader* header;
+	const SymbolIndexTableEntry* tableEntries[static_cast<int>(SymbolIndexTable::count)];
+	QString errorMessage;
+
+	bool ReadTableDirectory();
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <Windows.h>
+#include <QString>
+#include "SymbolAttributes.h"
+
+struct SymbolLocator
+{
+    DWORD symTag;
+    DWORD relativeVirtualAddress;
+    quint32 nameID;
+    DWORD id;
+    quint32 attributes;
+};
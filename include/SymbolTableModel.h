@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <QAbstractTableModel>
+#include <QBitArray>
+#include <QHash>
+#include "SymbolRecord.h"
+#include "SymbolAttributes.h"
+#include "TrigramIndex.h"
+
+/*
+* Table of symbols which is shown in symbols view. IDs, types and names are stored in separate arrays
+* and rows are created only when view requests them. Filtering and sorting don't copy symbols,
+* they only change order of symbol indices and list of indices which are visible.
+*/
+class SymbolTableModel : public QAbstractTableModel
+{
+	Q_OBJECT
+
+public:
+	SymbolTableModel(QObject* parent = nullptr);
+
+	int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+	int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+	QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+	void SetSymbols(const std::vector<SymbolRecord>* symbolRecords);
+	void SetSymbols(const QHash<QString, DWORD>* symbols);
+	void Clear();
+	int GetSymbolCount() const;
+	DWORD GetSymbolID(int symbolIndex) const;
+
+	bool HasCategories() const;
+	void SetCategories(const QVector<quint32>& categories);
+	void SetCategoryFilter(quint32 categoryFilter);
+	void SetSearchText(const QString& text);
+	const QString& GetSearchText() const;
+
+	static quint32 GetCategory(SymbolType symbolType);
+
+private:
+	QVector<quint32> ids;
+	QVector<quint32> types;
+	QVector<QString> names;
+	QVector<quint32> categories;
+	QVector<int> symbolOrder;
+	QVector<int> visibleRows;
+	QBitArray matchingSymbols;
+	TrigramIndex trigramIndex;
+	QString searchText;
+	quint32 categoryFilter;
+	int sortColumn;
+	Qt::SortOrder sortOrder;
+
+	void LoadSymbols();
+	void SortSymbols();
+	void UpdateMatchingSymbols();
+	void UpdateVisibleRows();
+	bool IsSymbolVisible(int symbolIndex) const;
+};
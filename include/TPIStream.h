@@ -0,0 +1,162 @@
+#pragma once
+
+#include <QtGlobal>
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QMutex>
+#include <QAtomicInt>
+#include "MSFFile.h"
+
+enum LeafType : quint16
+{
+	LF_MODIFIER = 0x1001,
+	LF_POINTER = 0x1002,
+	LF_PROCEDURE = 0x1008,
+	LF_MFUNCTION = 0x1009,
+	LF_VTSHAPE = 0x000a,
+	LF_ARGLIST = 0x1201,
+	LF_FIELDLIST = 0x1203,
+	LF_BITFIELD = 0x1205,
+	LF_METHODLIST = 0x1206,
+	LF_BCLASS = 0x1400,
+	LF_VBCLASS = 0x1401,
+	LF_IVBCLASS = 0x1402,
+	LF_INDEX = 0x1404,
+	LF_VFUNCTAB = 0x1409,
+	LF_ENUMERATE = 0x1502,
+	LF_ARRAY = 0x1503,
+	LF_CLASS = 0x1504,
+	LF_STRUCTURE = 0x1505,
+	LF_UNION = 0x1506,
+	LF_ENUM = 0x1507,
+	LF_MEMBER = 0x150d,
+	LF_STMEMBER = 0x150e,
+	LF_METHOD = 0x150f,
+	LF_NESTTYPE = 0x1510,
+	LF_ONEMETHOD = 0x1511,
+	LF_INTERFACE = 0x1519
+};
+
+enum NumericLeafType : quint16
+{
+	LF_NUMERIC = 0x8000,
+	LF_CHAR = 0x8000,
+	LF_SHORT = 0x8001,
+	LF_USHORT = 0x8002,
+	LF_LONG = 0x8003,
+	LF_ULONG = 0x8004,
+	LF_QUADWORD = 0x8009,
+	LF_UQUADWORD = 0x800a
+};
+
+enum TypeProperty : quint16
+{
+	propertyPacked = 0x0001,
+	propertyIsNested = 0x0008,
+	propertyForwardReference = 0x0080,
+	propertyScoped = 0x0100,
+	propertyHasUniqueName = 0x0200
+};
+
+struct TPIStreamHeader
+{
+	quint32 version;
+	quint32 headerSize;
+	quint32 typeIndexBegin;
+	quint32 typeIndexEnd;
+	quint32 typeRecordBytes;
+	quint16 hashStreamIndex;
+	quint16 hashAuxStreamIndex;
+	quint32 hashKeySize;
+	quint32 numHashBuckets;
+	qint32 hashValueBufferOffset;
+	quint32 hashValueBufferLength;
+	qint32 indexOffsetBufferOffset;
+	quint32 indexOffsetBufferLength;
+	qint32 hashAdjBufferOffset;
+	quint32 hashAdjBufferLength;
+};
+
+struct TPIIndexOffset
+{
+	quint32 typeIndex;
+	quint32 offset;
+};
+
+struct TPIRecord
+{
+	quint32 typeIndex;
+	quint16 kind;
+	const uchar* data;
+	quint16 length;
+};
+
+struct TPIUDTRecord
+{
+	quint32 typeIndex;
+	quint16 kind;
+	quint16 memberCount;
+	quint16 property;
+	quint32 fieldList;
+	quint32 derivedFrom;
+	quint32 vTableShape;
+	quint32 underlyingType;
+	quint64 size;
+	QString name;
+	QString uniqueName;
+};
+
+/*
+* Type records are addressed by type index (first index is usually 0x1000).
+* Record of type index is found by binary search in index offset buffer of TPI hash stream and walking forward
+* from nearest offset, record data isn't copied from mapped file. Names are resolved through hash chains which are
+* built from hash value buffer when name is looked up first time.
+*/
+class TPIStream
+{
+public:
+	TPIStream();
+
+	bool Load(const MSFFile* msfFile, MSFStreamIndex streamIndex = MSFStreamIndex::tpi);
+	void Clear();
+	bool IsLoaded() const;
+	const QString& GetErrorMessage() const;
+
+	const TPIStreamHeader& GetHeader() const;
+	quint32 GetTypeIndexBegin() const;
+	quint32 GetTypeIndexEnd() const;
+	int GetRecordCount() const;
+
+	bool GetRecord(quint32 typeIndex, TPIRecord* record) const;
+	bool GetNextRecord(const TPIRecord& record, TPIRecord* nextRecord) const;
+	bool GetUDTRecord(quint32 typeIndex, TPIUDTRecord* udtRecord) const;
+	quint32 FindTypeIndex(const QString& typeName, bool findForwardReference = false) const;
+	quint32 FindTypeIndex(const QByteArray& typeName, bool findForwardReference = false) const;
+
+	static bool IsUDTLeaf(quint16 kind);
+	static bool DecodeUDTRecord(const TPIRecord& record, TPIUDTRecord* udtRecord, bool readNames = true);
+	static bool GetUDTRecordName(const TPIRecord& record, const char** name, int* length, quint16* property = nullptr);
+	static bool ReadNumericLeaf(const uchar*& data, const uchar* end, quint64* value);
+	static quint32 HashStringV1(const char* string, int length);
+
+private:
+	TPIStreamHeader header;
+	QByteArray streamData;
+	QByteArray recordData;
+	QByteArray hashValueBuffer;
+	const uchar* hashValues;
+	QVector<TPIIndexOffset> indexOffsets;
+	mutable QVector<quint32> bucketHeads;
+	mutable QVector<quint32> bucketNext;
+	mutable QMutex hashBucketsMutex;
+	mutable QAtomicInt hasHashBuckets;
+	QString errorMessage;
+	bool isLoaded;
+
+	bool ReadHeader(const MSFStream& stream);
+	bool ReadHashStream(const MSFFile* msfFile);
+	bool ReadRecord(quint32 typeIndex, quint32 offset, TPIRecord* record) const;
+	void BuildIndexOffsets();
+	void BuildHashBuckets() const;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QIODevice>
+#include <QString>
+#include <QVector>
+
+/*
+* Append only text which is stored in chunks, so adding text never copies text which was added before
+* and generated code of large types is built in linear time. Text is converted to QString or written
+* to file only once when it's complete.
+*/
+class TextBuilder
+{
+public:
+	TextBuilder();
+
+	TextBuilder& operator+=(const QString& text);
+	TextBuilder& operator+=(const char* text);
+	TextBuilder& operator+=(const TextBuilder& text);
+
+	void AppendIndentation(int level);
+	void RemoveLast(int count);
+	int Length() const;
+	bool IsEmpty() const;
+	QString ToString() const;
+	bool WriteLatin1(QIODevice* device) const;
+
+	static QString GetIndentation(int level);
+
+private:
+	static const int chunkSize = 16 * 1024;
+
+	QVector<QString> chunks;
+	int length;
+
+	QString& GetChunk(int size);
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QtGlobal>
+#include <QString>
+#include <QVector>
+
+/*
+* Case insensitive substring index. Every name is split into trigrams of case folded characters,
+* trigrams are hashed into buckets and each bucket contains sorted list of names which contain it.
+* Query intersects lists of its trigrams and only remaining candidates are compared with query.
+*/
+class TrigramIndex
+{
+public:
+	TrigramIndex();
+
+	void Build(const QVector<QString>& names);
+	void Clear();
+	bool IsEmpty() const;
+	int GetNameCount() const;
+	QVector<int> Find(const QString& text) const;
+
+private:
+	static const int bucketBits = 20;
+
+	QVector<QString> names;
+	QVector<quint32> bucketOffsets;
+	QVector<quint32> postings;
+
+	static quint32 GetBucket(const QChar* text);
+	static void GetBuckets(const QString& foldedText, QVector<quint32>& buckets);
+};
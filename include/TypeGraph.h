@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+#include "SymbolRecord.h"
+
+/*
+* Graph of references between types (base classes, types of members, parameters and return types).
+* References of all types are stored in one array and every type keeps only position of its references,
+* so graph stays small even if it contains most of types from PDB. References of type are added
+* when type is visited for the first time and they are reused by every export after that.
+*/
+class TypeGraph
+{
+public:
+	TypeGraph();
+
+	bool Contains(DWORD id);
+	void AddType(DWORD id, const QVector<SymbolRecord>& references);
+	QVector<SymbolRecord> GetReferences(DWORD id);
+	void SetOptionsFingerprint(quint64 optionsFingerprint);
+	void Clear();
+
+private:
+	struct Node
+	{
+		int begin;
+		int count;
+	};
+
+	QHash<DWORD, Node> nodes;
+	QVector<DWORD> references;
+	//Symbol records of types which are referenced, type name is name under which type was referenced first time
+	QHash<DWORD, SymbolRecord> symbolRecords;
+	//References depend on options which are used when elements are generated
+	quint64 optionsFingerprint;
+	QMutex mutex;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class TypeName;
+
+struct TypeNameScope
+{
+	//Identifier without template arguments
+	QString name;
+	//Position of scope in name of type
+	int index;
+	QVector<QSharedPointer<const TypeName>> templateArguments;
+};
+
+/*
+* Parsed type name which consists of scopes which are separated with :: at top level,
+* template arguments of every scope, leading and trailing cv qualifiers, pointers and reference.
+* Names of function types keep their return type and parameters instead of scopes.
+* Every distinct name is parsed once, parsed names are shared and kept for lifetime of process.
+*/
+class TypeName
+{
+public:
+	static QSharedPointer<const TypeName> Parse(const QString& name);
+
+	const QString& GetName() const;
+	const QString& GetFormattedName() const;
+	const QString& GetKeyword() const;
+	const QVector<TypeNameScope>& GetScopes() const;
+	int GetScopeSeparatorIndex(int scopeIndex) const;
+	int GetLastScopeSeparatorIndex() const;
+	QString GetParentName() const;
+	QString GetOuterName() const;
+	bool HasTemplateArguments() const;
+	bool IsConst() const;
+	bool IsVolatile() const;
+	int GetPointerLevel() const;
+	bool IsReference() const;
+	bool IsFunction() const;
+	void GetReferencedTypeNames(QStringList& typeNames) const;
+
+private:
+	QString name;
+	QString formattedName;
+	QString keyword;
+	QVector<TypeNameScope> scopes;
+	bool isConst;
+	bool isVolatile;
+	int pointerLevel;
+	bool isReference;
+	bool hasTemplateArguments;
+	QSharedPointer<const TypeName> returnType;
+	QVector<QSharedPointer<const TypeName>> parameters;
+
+	TypeName(const QString& name);
+
+	void ParseName();
+	void ParseScopes(int begin, int end);
+	void AddScope(int begin, int end);
+	static QVector<QSharedPointer<const TypeName>> ParseList(const QString& name, int begin, int end);
+	bool StartsWithWord(int index, int end, const QString& word) const;
+	bool EndsWithWord(int begin, int end, const QString& word) const;
+	static bool IsIdentifierCharacter(QChar character);
+	static QString Format(const QString& name);
+
+	struct Cache
+	{
+		QHash<quint32, QSharedPointer<const TypeName>> typeNames;
+		QReadWriteLock lock;
+	};
+
+	static Cache& GetCache();
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include "TPIStream.h"
+
+/*
+* Structural signature of type which is computed from its TPI records. Types which generated code refers to
+* by name are hashed only by their name, so signature doesn't change when type indices change between builds,
+* it changes only when layout, members or names of referenced types change. Base classes, nested and unnamed
+* types are part of generated code so they are hashed with all of their members.
+*/
+class TypeSignature
+{
+public:
+	TypeSignature(const TPIStream* tpiStream);
+
+	quint64 Compute(quint32 typeIndex);
+
+	static quint64 Hash(quint64 hash, const void* data, int size);
+	static quint64 Hash(quint64 hash, quint64 value);
+
+	static const quint64 initialHash = 14695981039346656037ULL;
+
+private:
+	const TPIStream* tpiStream;
+	//Signatures of records which were already hashed with all of their members
+	QHash<quint32, quint64> signatures;
+	QSet<quint32> visitingTypes;
+
+	quint64 HashTypeIndex(quint32 typeIndex, bool hashMembers = false);
+	quint64 HashUDTName(const TPIRecord& record);
+	quint64 HashUDT(const TPIRecord& record);
+	quint64 HashRecord(const TPIRecord& record);
+	quint64 HashFieldList(const TPIRecord& record);
+	quint64 HashMethodList(const TPIRecord& record);
+
+	static bool IsUnnamedType(const char* name, int length);
+	static bool ReadTypeIndex(const uchar*& data, const uchar* end, quint32* typeIndex);
+	static bool ReadName(const uchar*& data, const uchar* end, quint64* hash);
+};
@@ -1,77 +1,111 @@
 #include "DemangleData.h"
 
-DemangleData::DemangleData(std::string value, bool verbose)
+DemangleData::DemangleData(std::string_view value, bool verbose)
 {
 	/*
 	* The main data is the input string.
 	* But we also store, for backreferences, the list of name fragments
 	* and the list of arguments (non-primitive types only).
+	* Input isn't copied so it has to outlive this object.
 	*/
 
+	input = value;
 	this->value = value;
 	this->verbose = verbose;
 }
 
-std::string DemangleData::GetValue()
+std::string_view DemangleData::GetValue() const
 {
 	return value;
 }
 
-void DemangleData::SetValue(std::string value)
+//Returns character at index of rest of input or '\0' if input ends before it
+char DemangleData::Peek(size_t index) const
 {
-	this->value = value;
+	return index < value.length() ? value[index] : '\0';
+}
+
+bool DemangleData::StartsWith(std::string_view prefix) const
+{
+	return value.starts_with(prefix);
 }
 
-int DemangleData::GetArgumentsSize()
+int DemangleData::GetArgumentsSize() const
 {
 	return static_cast<int>(arguments.size());
 }
 
-std::string DemangleData::GetArgument(int index)
+std::string_view DemangleData::GetArgument(int index) const
 {
+	if (index < 0 || index >= static_cast<int>(arguments.size()))
+	{
+		return {};
+	}
+
 	return arguments[index];
 }
 
-std::string DemangleData::GetFragment(int index)
+std::string_view DemangleData::GetFragment(int index) const
 {
+	if (index < 0 || index >= static_cast<int>(fragments.size()))
+	{
+		return {};
+	}
+
 	return fragments[index];
 }
 
 void DemangleData::Advance(int count)
 {
 	/*
-	* This is linear in the size of self.value, therefore the complexity
-	* of symbol_demangle_reentrant is quadratic, which makes it vulnerable
-	* to DoS attacks. That's why DemangleData's interface can support an
-	* implementation such that self.value is constant and the current
-	* position in self.value is stored in e.g. self.pos; I chose to
-	* modify self.value, it seems more understandable.
+	* Only start of view is moved so demangling is linear in size of input.
+	* Count is clamped so malformed input can't move past end of it.
 	*/
 
-	value = value.substr(count, value.length() - count);
+	if (count < 0)
+	{
+		return;
+	}
+
+	value.remove_prefix(count < static_cast<int>(value.length()) ? count : value.length());
 }
 
-int DemangleData::Index(char pos)
+int DemangleData::Index(char pos) const
 {
 	return static_cast<int>(value.find(pos));
 }
 
-void DemangleData::AddFragment(std::string fragment)
+void DemangleData::AddFragment(std::string_view fragment)
 {
-	fragments.push_back(fragment);
+	fragments.push_back(Store(fragment));
 }
 
-void DemangleData::AddArgument(std::string argument)
+void DemangleData::AddArgument(std::string_view argument)
 {
-	arguments.push_back(argument);
+	arguments.push_back(Store(argument));
+}
+
+//Text which is part of input is referenced directly, other text is copied to arena
+std::string_view DemangleData::Store(std::string_view text)
+{
+	if (text.data() >= input.data() && text.data() + text.length() <= input.data() + input.length())
+	{
+		return text;
+	}
+
+	arena.emplace_back(text);
+
+	return arena.back();
 }
 
 void DemangleData::EnterTemplate()
 {
-	std::map<std::vector<std::string>, std::vector<std::string>> map;
+	Frame frame;
+
+	frame.arguments = std::move(arguments);
+	frame.fragments = std::move(fragments);
 
-	map.insert(make_pair(fragments, arguments));
-	history.push_back(map);
+	history.push_back(std::move(frame));
 
 	fragments.clear();
 	arguments.clear();
@@ -79,24 +113,32 @@ void DemangleData::EnterTemplate()
 
 void DemangleData::ExitTemplate()
 {
-	std::map<std::vector<std::string>, std::vector<std::string>> map = history.back();
+	Frame& frame = history.back();
 
-	fragments = map.begin()->first;
-	arguments = map.begin()->second;
+	fragments = std::move(frame.fragments);
+	arguments = std::move(frame.arguments);
 
 	history.pop_back();
 }
 
-bool DemangleData::IsInTemplate()
+bool DemangleData::IsInTemplate() const
 {
 	//'?' data type depends on whether we are in a template
 
 	return history.size() > 0;
 }
 
-std::string DemangleData::Join(const std::vector<std::string>& vector, std::string delimiter)
+std::string DemangleData::Join(const std::vector<std::string_view>& vector, std::string_view delimiter) const
 {
 	std::string result;
+	size_t length = 0;
+
+	for (const std::string_view& item : vector)
+	{
+		length += item.length() + delimiter.length();
+	}
+
+	result.reserve(length);
 
 	for (auto it = vector.begin(); it != vector.end(); it++)
 	{
@@ -0,0 +1,390 @@
+#include "DemangledSymbol.h"
+
+static std::string_view Trim(std::string_view value)
+{
+	std::size_t begin = value.find_first_not_of(' ');
+
+	if (begin == std::string_view::npos)
+	{
+		return {};
+	}
+
+	return value.substr(begin, value.find_last_not_of(' ') - begin + 1);
+}
+
+DemangledSymbolKind DemangledSymbol::GetKind() const
+{
+	return kind;
+}
+
+//Prefixes which undname.exe doesn't output, for example [MEP] or [managed]
+std::string_view DemangledSymbol::GetPrefix() const
+{
+	return GetText(prefix);
+}
+
+std::string_view DemangledSymbol::GetAccess() const
+{
+	return GetText(access);
+}
+
+std::string_view DemangledSymbol::GetCallingConvention() const
+{
+	return GetText(callingConvention);
+}
+
+//Type of variable or return type of function, constructors and destructors don't have it
+std::string_view DemangledSymbol::GetReturnType() const
+{
+	return GetText(returnType);
+}
+
+//Qualifiers of member function or storage qualifiers of variable
+std::string_view DemangledSymbol::GetQualifiers() const
+{
+	return GetText(qualifiers);
+}
+
+std::size_t DemangledSymbol::GetScopeCount() const
+{
+	return scopes.size();
+}
+
+std::string_view DemangledSymbol::GetScope(std::size_t index) const
+{
+	return GetText(scopes[index].text);
+}
+
+std::string_view DemangledSymbol::GetScopeName(std::size_t index) const
+{
+	return GetText(scopes[index].name);
+}
+
+std::size_t DemangledSymbol::GetTemplateArgumentCount(std::size_t scopeIndex) const
+{
+	return scopes[scopeIndex].templateArgumentCount;
+}
+
+std::string_view DemangledSymbol::GetTemplateArgument(std::size_t scopeIndex, std::size_t index) const
+{
+	return GetText(templateArguments[scopes[scopeIndex].firstTemplateArgument + index]);
+}
+
+//Returns innermost scope, that is name of function or variable with its template arguments
+std::string_view DemangledSymbol::GetName() const
+{
+	if (scopes.empty())
+	{
+		return {};
+	}
+
+	return GetText(scopes.back().text);
+}
+
+//Returns all scopes except innermost one, for member functions and static members it's name of class
+std::string DemangledSymbol::GetParentName() const
+{
+	std::string result;
+
+	for (std::size_t i = 0; i + 1 < scopes.size(); i++)
+	{
+		if (i > 0)
+		{
+			result += "::";
+		}
+
+		result += GetText(scopes[i].text);
+	}
+
+	return result;
+}
+
+std::string DemangledSymbol::GetQualifiedName() const
+{
+	std::string result = GetParentName();
+
+	if (result.length())
+	{
+		result += "::";
+	}
+
+	result += GetName();
+
+	return result;
+}
+
+//Functions which take void don't have parameters
+std::size_t DemangledSymbol::GetParameterCount() const
+{
+	return parameters.size();
+}
+
+std::string_view DemangledSymbol::GetParameter(std::size_t index) const
+{
+	return GetText(parameters[index]);
+}
+
+std::string_view DemangledSymbol::GetUndecoratedName() const
+{
+	return GetText(undecoratedName);
+}
+
+/*
+* IDA style is qualified name with parameters of function without return type, access and calling convention.
+* Ghidra style is qualified name without parameters in which every character of scope that can't be part of
+* label is replaced with _, scopes stay separated with ::.
+* Symbols which don't have scopes like string literals are rendered as undecorated name.
+*/
+std::string DemangledSymbol::Render(DemangleStyle style) const
+{
+	if (scopes.empty())
+	{
+		return std::string(GetUndecoratedName());
+	}
+
+	if (style == DemangleStyle::ghidra)
+	{
+		return GetLabel();
+	}
+
+	std::string result = GetQualifiedName();
+
+	if (kind == DemangledSymbolKind::function)
+	{
+		result += '(';
+
+		for (std::size_t i = 0; i < parameters.size(); i++)
+		{
+			if (i > 0)
+			{
+				result += ", ";
+			}
+
+			result += GetText(parameters[i]);
+		}
+
+		if (parameters.empty())
+		{
+			result += "void";
+		}
+
+		result += ')';
+	}
+
+	return result;
+}
+
+void DemangledSymbol::Clear()
+{
+	*this = DemangledSymbol();
+}
+
+void DemangledSymbol::SetKind(DemangledSymbolKind kind)
+{
+	this->kind = kind;
+}
+
+void DemangledSymbol::AddPrefix(std::string_view prefix)
+{
+	std::string value(GetPrefix());
+
+	value += prefix;
+
+	this->prefix = Store(value);
+}
+
+void DemangledSymbol::SetAccess(std::string_view access)
+{
+	this->access = Store(Trim(access));
+}
+
+void DemangledSymbol::SetCallingConvention(std::string_view callingConvention)
+{
+	this->callingConvention = Store(Trim(callingConvention));
+}
+
+void DemangledSymbol::SetReturnType(std::string_view returnType)
+{
+	this->returnType = Store(Trim(returnType));
+}
+
+void DemangledSymbol::SetQualifiers(std::string_view qualifiers)
+{
+	this->qualifiers = Store(Trim(qualifiers));
+}
+
+//Names have to be ordered from outermost to innermost scope
+void DemangledSymbol::SetScopes(const std::vector<std::string>& names)
+{
+	scopes.clear();
+	templateArguments.clear();
+
+	for (const std::string& name : names)
+	{
+		AddScope(name);
+	}
+}
+
+void DemangledSymbol::SetParameters(const std::vector<std::string>& parameters)
+{
+	this->parameters.clear();
+
+	if (parameters.size() == 1 && parameters[0] == "void")
+	{
+		return;
+	}
+
+	for (const std::string& parameter : parameters)
+	{
+		this->parameters.push_back(Store(parameter));
+	}
+}
+
+void DemangledSymbol::SetUndecoratedName(std::string_view undecoratedName)
+{
+	this->undecoratedName = Store(undecoratedName);
+}
+
+DemangledText DemangledSymbol::Store(std::string_view value)
+{
+	DemangledText result;
+
+	result.offset = static_cast<std::uint32_t>(text.length());
+	result.length = static_cast<std::uint32_t>(value.length());
+
+	text += value;
+
+	return result;
+}
+
+std::string_view DemangledSymbol::GetText(const DemangledText& value) const
+{
+	return std::string_view(text).substr(value.offset, value.length);
+}
+
+std::string DemangledSymbol::GetLabel() const
+{
+	std::string result;
+
+	for (std::size_t i = 0; i < scopes.size(); i++)
+	{
+		if (i > 0)
+		{
+			result += "::";
+		}
+
+		for (char character : GetText(scopes[i].text))
+		{
+			bool isLabelCharacter = (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') ||
+				(character >= '0' && character <= '9') || character == '_';
+
+			result += isLabelCharacter ? character : '_';
+		}
+	}
+
+	return result;
+}
+
+void DemangledSymbol::AddScope(std::string_view scope)
+{
+	DemangledScope demangledScope;
+	std::size_t templateArgumentsBegin = FindTemplateArgumentsBegin(scope);
+
+	demangledScope.text = Store(scope);
+	demangledScope.firstTemplateArgument = static_cast<std::uint32_t>(templateArguments.size());
+
+	if (templateArgumentsBegin == std::string_view::npos)
+	{
+		demangledScope.name = demangledScope.text;
+	}
+	else
+	{
+		demangledScope.name.offset = demangledScope.text.offset;
+		demangledScope.name.length = static_cast<std::uint32_t>(templateArgumentsBegin);
+
+		AddTemplateArguments(scope.substr(templateArgumentsBegin + 1, scope.length() - templateArgumentsBegin - 2), demangledScope);
+	}
+
+	scopes.push_back(demangledScope);
+}
+
+/*
+* Returns position of < which matches > at the end of scope, names of operators like operator> and
+* unnamed types like <lambda_1> don't have template arguments
+*/
+std::size_t DemangledSymbol::FindTemplateArgumentsBegin(std::string_view scope) const
+{
+	if (scope.empty() || scope.back() != '>')
+	{
+		return std::string_view::npos;
+	}
+
+	int depth = 0;
+
+	for (std::size_t i = scope.length(); i > 0; i--)
+	{
+		char character = scope[i - 1];
+
+		if (character == '>')
+		{
+			depth++;
+		}
+		else if (character == '<')
+		{
+			depth--;
+
+			if (depth == 0)
+			{
+				return i - 1 > 0 ? i - 1 : std::string_view::npos;
+			}
+		}
+	}
+
+	return std::string_view::npos;
+}
+
+//Arguments are separated with ',' which isn't inside of other template arguments, parameters, arrays or quotes
+void DemangledSymbol::AddTemplateArguments(std::string_view arguments, DemangledScope& scope)
+{
+	int depth = 0;
+	int quoteDepth = 0;
+	std::size_t argumentBegin = 0;
+
+	for (std::size_t i = 0; i <= arguments.length(); i++)
+	{
+		char character = i < arguments.length() ? arguments[i] : ',';
+
+		if (character == '`')
+		{
+			quoteDepth++;
+		}
+		else if (character == '\'' && quoteDepth > 0)
+		{
+			quoteDepth--;
+		}
+		else if (quoteDepth > 0)
+		{
+			continue;
+		}
+		else if (character == '<' || character == '(' || character == '[')
+		{
+			depth++;
+		}
+		else if (character == '>' || character == ')' || character == ']')
+		{
+			depth--;
+		}
+		else if (character == ',' && depth == 0)
+		{
+			std::string_view argument = Trim(arguments.substr(argumentBegin, i - argumentBegin));
+
+			if (argument.length())
+			{
+				templateArguments.push_back(Store(argument));
+				scope.templateArgumentCount++;
+			}
+
+			argumentBegin = i + 1;
+		}
+	}
+}
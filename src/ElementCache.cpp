@@ -0,0 +1,268 @@
+#include "ElementCache.h"
+
+ElementCache::ElementCache()
+{
+	memoryUsage = 0;
+	memoryBudget = 256 * 1024 * 1024;
+	hits = 0;
+	misses = 0;
+	evictions = 0;
+}
+
+//Lookups which are followed by another lookup of the same element don't count misses so they aren't counted twice
+QSharedPointer<Element> ElementCache::Find(quint64 key, bool countMisses)
+{
+	QMutexLocker locker(&mutex);
+	auto it = entries.find(key);
+
+	if (it == entries.end())
+	{
+		if (countMisses)
+		{
+			misses++;
+		}
+
+		return QSharedPointer<Element>();
+	}
+
+	hits++;
+
+	recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, it->position);
+
+	return it->element;
+}
+
+QSharedPointer<Element> ElementCache::Insert(quint64 key, const Element& element)
+{
+	QMutexLocker locker(&mutex);
+	auto it = entries.find(key);
+
+	if (it != entries.end())
+	{
+		recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, it->position);
+
+		return it->element;
+	}
+
+	Entry entry;
+
+	entry.element = QSharedPointer<Element>::create(element);
+	entry.size = EstimateSize(element);
+
+	recentlyUsed.push_front(key);
+	entry.position = recentlyUsed.begin();
+
+	entries.insert(key, entry);
+	memoryUsage += entry.size;
+
+	EvictElements();
+
+	return entry.element;
+}
+
+void ElementCache::Clear()
+{
+	QMutexLocker locker(&mutex);
+
+	entries.clear();
+	recentlyUsed.clear();
+	memoryUsage = 0;
+	hits = 0;
+	misses = 0;
+	evictions = 0;
+}
+
+void ElementCache::SetMemoryBudget(qint64 memoryBudget)
+{
+	QMutexLocker locker(&mutex);
+
+	this->memoryBudget = memoryBudget;
+
+	EvictElements();
+}
+
+ElementCacheStatistics ElementCache::GetStatistics()
+{
+	QMutexLocker locker(&mutex);
+	ElementCacheStatistics statistics;
+
+	statistics.hits = hits;
+	statistics.misses = misses;
+	statistics.evictions = evictions;
+	statistics.memoryUsage = memoryUsage;
+	statistics.memoryBudget = memoryBudget;
+	statistics.count = entries.count();
+
+	return statistics;
+}
+
+/*
+* Estimate includes memory of all strings and nested elements, strings and payloads which are shared
+* between elements are counted for each of them so estimate is upper bound
+*/
+qint64 ElementCache::EstimateSize(const Element& element)
+{
+	qint64 size = sizeof(Element);
+
+	if (!element.udt.IsNull())
+	{
+		size += sizeof(UDT) + EstimateSize(*element.udt);
+	}
+
+	if (!element.function.IsNull())
+	{
+		size += sizeof(Function) + EstimateSize(*element.function);
+	}
+
+	if (!element.data.IsNull())
+	{
+		size += sizeof(Data) + EstimateSize(*element.data);
+	}
+
+	if (!element.typeDef.IsNull())
+	{
+		size += sizeof(TypeDef);
+		size += EstimateSize(element.typeDef->oldTypeName);
+		size += EstimateSize(element.typeDef->newTypeName);
+		size += EstimateSize(element.typeDef->declaration);
+	}
+
+	if (!element.enum1.IsNull())
+	{
+		size += sizeof(Enum);
+		size += EstimateSize(element.enum1->originalTypeName);
+		size += EstimateSize(element.enum1->name);
+		size += EstimateSize(element.enum1->parentClassName);
+	}
+
+	if (!element.baseClass.IsNull())
+	{
+		size += sizeof(BaseClass);
+		size += EstimateSize(element.baseClass->name);
+		size += EstimateSize(element.baseClass->parentClassName);
+
+		for (auto it = element.baseClass->vTableNames.constBegin(); it != element.baseClass->vTableNames.constEnd(); it++)
+		{
+			size += sizeof(void*) * 4 + EstimateSize(it.value());
+		}
+	}
+
+	size += EstimateSize(element.baseClassNames);
+	size += EstimateSize(element.children);
+	size += EstimateSize(element.baseClassChildren);
+	size += EstimateSize(element.enumChildren);
+	size += EstimateSize(element.udtChildren);
+	size += EstimateSize(element.typedefChildren);
+	size += EstimateSize(element.dataChildren);
+	size += EstimateSize(element.staticDataChildren);
+	size += EstimateSize(element.virtualFunctionChildren);
+	size += EstimateSize(element.nonVirtualFunctionChildren);
+	size += EstimateSize(element.localVariables);
+
+	return size;
+}
+
+//Element which was used last is never evicted since it was just requested
+void ElementCache::EvictElements()
+{
+	while (memoryUsage > memoryBudget && recentlyUsed.size() > 1)
+	{
+		quint64 key = recentlyUsed.back();
+
+		recentlyUsed.pop_back();
+
+		memoryUsage -= entries.value(key).size;
+		entries.remove(key);
+
+		evictions++;
+	}
+}
+
+qint64 ElementCache::EstimateSize(const QString& string)
+{
+	return string.isEmpty() ? 0 : static_cast<qint64>(string.capacity() + 1) * sizeof(QChar) + sizeof(void*) * 3;
+}
+
+qint64 ElementCache::EstimateSize(const QList<QString>& strings)
+{
+	qint64 size = static_cast<qint64>(strings.count()) * sizeof(void*);
+
+	for (int i = 0; i < strings.count(); i++)
+	{
+		size += EstimateSize(strings.at(i));
+	}
+
+	return size;
+}
+
+//Element is large type so QList stores pointer to every element
+qint64 ElementCache::EstimateSize(const QList<Element>& elements)
+{
+	qint64 size = static_cast<qint64>(elements.count()) * sizeof(void*);
+
+	for (int i = 0; i < elements.count(); i++)
+	{
+		size += EstimateSize(elements.at(i));
+	}
+
+	return size;
+}
+
+qint64 ElementCache::EstimateSize(const Data& data)
+{
+	qint64 size = 0;
+
+	size += EstimateSize(data.originalTypeName);
+	size += EstimateSize(data.typeName);
+	size += EstimateSize(data.name);
+	size += EstimateSize(data.parentClassName);
+	size += EstimateSize(data.parentType);
+	size += EstimateSize(data.location);
+	size += EstimateSize(data.functionReturnType);
+	size += EstimateSize(data.functionParameters);
+	size += EstimateSize(data.declaration);
+	size += static_cast<qint64>(data.arrayCount.count()) * sizeof(void*);
+
+	return size;
+}
+
+qint64 ElementCache::EstimateSize(const UDT& udt)
+{
+	qint64 size = 0;
+
+	size += EstimateSize(udt.originalTypeName);
+	size += EstimateSize(udt.name);
+	size += EstimateSize(udt.parentClassName);
+	size += EstimateSize(udt.type);
+
+	for (auto it = udt.vTableNames.constBegin(); it != udt.vTableNames.constEnd(); it++)
+	{
+		size += sizeof(void*) * 4 + EstimateSize(it.value());
+	}
+
+	for (auto it = udt.includes.constBegin(); it != udt.includes.constEnd(); it++)
+	{
+		size += sizeof(void*) * 3 + EstimateSize(*it);
+	}
+
+	return size;
+}
+
+qint64 ElementCache::EstimateSize(const Function& function)
+{
+	qint64 size = 0;
+
+	size += EstimateSize(function.name);
+	size += EstimateSize(function.parentClassName);
+	size += EstimateSize(function.originalParentClassName);
+	size += EstimateSize(function.parentType);
+	size += EstimateSize(function.prototype);
+	size += EstimateSize(function.vTableName);
+	size += EstimateSize(function.returnType1);
+	size += EstimateSize(function.returnType2);
+	size += EstimateSize(function.originalReturnType);
+	size += EstimateSize(function.parameters);
+	size += EstimateSize(function.originalParameters);
+
+	return size;
+}
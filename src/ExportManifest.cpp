@@ -0,0 +1,84 @@
+#include <QFile>
+#include <QSaveFile>
+#include <QStringList>
+#include <QTextStream>
+#include "ExportManifest.h"
+
+const char* ExportManifest::fileName = "ExportManifest.txt";
+
+bool ExportManifest::Load(const QString& filePath)
+{
+	QFile file(filePath);
+
+	signatures.clear();
+
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		return false;
+	}
+
+	QTextStream stream(&file);
+	QString line;
+
+	while (stream.readLineInto(&line))
+	{
+		int index = line.indexOf(' ');
+		bool isValid = false;
+
+		if (index <= 0)
+		{
+			continue;
+		}
+
+		quint64 signature = line.left(index).toULongLong(&isValid, 16);
+
+		if (isValid)
+		{
+			signatures.insert(line.mid(index + 1), signature);
+		}
+	}
+
+	return true;
+}
+
+//Manifest is replaced only when it's completely written so it isn't lost if export is interrupted
+bool ExportManifest::Save(const QString& filePath) const
+{
+	QSaveFile file(filePath);
+
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+	{
+		return false;
+	}
+
+	QTextStream stream(&file);
+	//Names are sorted so manifests of two exports can be compared
+	QStringList names = signatures.keys();
+	int count = names.count();
+
+	names.sort();
+
+	for (int i = 0; i < count; i++)
+	{
+		stream << QString::number(signatures.value(names.at(i)), 16).rightJustified(16, '0') << ' ' << names.at(i) << '\n';
+	}
+
+	stream.flush();
+
+	return file.commit();
+}
+
+quint64 ExportManifest::GetSignature(const QString& name) const
+{
+	return signatures.value(name, 0);
+}
+
+void ExportManifest::SetSignature(const QString& name, quint64 signature)
+{
+	signatures.insert(name, signature);
+}
+
+void ExportManifest::RemoveSignature(const QString& name)
+{
+	signatures.remove(name);
+}
@@ -0,0 +1,113 @@
+#include "LayoutCache.h"
+
+bool LayoutCache::GetValue(quint64 key, LayoutField field, quint64& value)
+{
+	QMutexLocker locker(&mutex);
+	auto it = layouts.constFind(key);
+
+	if (it == layouts.constEnd() || !(it->fields & static_cast<quint32>(field)))
+	{
+		return false;
+	}
+
+	switch (field)
+	{
+	case LayoutField::defaultAlignment:
+		value = it->defaultAlignment;
+
+		break;
+	case LayoutField::correctAlignment:
+		value = it->correctAlignment;
+
+		break;
+	case LayoutField::greatestPadding:
+		value = it->greatestPadding;
+
+		break;
+	case LayoutField::flattenedSize:
+		value = it->flattenedSize;
+
+		break;
+	case LayoutField::naturalAlignment:
+		value = it->naturalAlignment;
+
+		break;
+	}
+
+	return true;
+}
+
+void LayoutCache::SetValue(quint64 key, LayoutField field, quint64 value)
+{
+	QMutexLocker locker(&mutex);
+	auto it = layouts.find(key);
+
+	if (it == layouts.end())
+	{
+		it = layouts.insert(key, TypeLayout());
+	}
+
+	switch (field)
+	{
+	case LayoutField::defaultAlignment:
+		it->defaultAlignment = static_cast<quint32>(value);
+
+		break;
+	case LayoutField::correctAlignment:
+		it->correctAlignment = static_cast<quint32>(value);
+
+		break;
+	case LayoutField::greatestPadding:
+		it->greatestPadding = static_cast<quint32>(value);
+
+		break;
+	case LayoutField::flattenedSize:
+		it->flattenedSize = value;
+
+		break;
+	case LayoutField::naturalAlignment:
+		it->naturalAlignment = static_cast<quint32>(value);
+
+		break;
+	}
+
+	it->fields |= static_cast<quint32>(field);
+}
+
+bool LayoutCache::GetFlattenedChildren(quint64 key, QList<Element>& flattenedChildren, quint64& flattenedSize)
+{
+	QMutexLocker locker(&mutex);
+	auto it = layouts.constFind(key);
+
+	if (it == layouts.constEnd() || !(it->fields & static_cast<quint32>(LayoutField::flattenedSize)))
+	{
+		return false;
+	}
+
+	flattenedChildren = it->flattenedChildren;
+	flattenedSize = it->flattenedSize;
+
+	return true;
+}
+
+void LayoutCache::SetFlattenedChildren(quint64 key, const QList<Element>& flattenedChildren, quint64 flattenedSize)
+{
+	QMutexLocker locker(&mutex);
+	auto it = layouts.find(key);
+
+	if (it == layouts.end())
+	{
+		it = layouts.insert(key, TypeLayout());
+	}
+
+	it->flattenedChildren = flattenedChildren;
+	it->flattenedSize = flattenedSize;
+	it->fields |= static_cast<quint32>(LayoutField::flattenedSize);
+}
+
+void LayoutCache::Clear()
+{
+	QMutexLocker locker(&mutex);
+
+	layouts.clear();
+}
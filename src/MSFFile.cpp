@@ -0,0 +1,481 @@
+#include "MSFFile.h"
+
+static const char msfMagic[] = "Microsoft C/C++ MSF 7.00\r\n\x1a" "DS\0\0";
+static const quint32 nilStreamSize = 0xFFFFFFFF;
+
+MSFStream::MSFStream()
+{
+	fileData = nullptr;
+	blockSize = 0;
+	size = 0;
+	isContiguous = false;
+}
+
+MSFStream::MSFStream(const uchar* fileData, quint32 blockSize, const QVector<quint32>& blocks, quint32 size)
+{
+	this->fileData = fileData;
+	this->blockSize = blockSize;
+	this->blocks = blocks;
+	this->size = size;
+
+	isContiguous = true;
+
+	for (int i = 1; i < blocks.count(); i++)
+	{
+		if (blocks.at(i) != blocks.at(i - 1) + 1)
+		{
+			isContiguous = false;
+
+			break;
+		}
+	}
+}
+
+bool MSFStream::IsValid() const
+{
+	return fileData != nullptr;
+}
+
+quint32 MSFStream::GetSize() const
+{
+	return size;
+}
+
+int MSFStream::GetBlockCount() const
+{
+	return blocks.count();
+}
+
+MSFBlockSpan MSFStream::GetBlockSpan(int index) const
+{
+	MSFBlockSpan blockSpan = {};
+
+	if (index < 0 || index >= blocks.count())
+	{
+		return blockSpan;
+	}
+
+	quint32 offset = static_cast<quint32>(index) * blockSize;
+
+	blockSpan.data = reinterpret_cast<const char*>(fileData + static_cast<qint64>(blocks.at(index)) * blockSize);
+	blockSpan.length = qMin(blockSize, size - offset);
+
+	return blockSpan;
+}
+
+bool MSFStream::IsContiguous() const
+{
+	return isContiguous;
+}
+
+bool MSFStream::Read(quint32 offset, quint32 length, void* buffer) const
+{
+	if (!fileData || offset > size || length > size - offset)
+	{
+		return false;
+	}
+
+	char* destination = static_cast<char*>(buffer);
+
+	while (length > 0)
+	{
+		int blockIndex = offset / blockSize;
+		quint32 offsetInBlock = offset % blockSize;
+		quint32 bytesToCopy = qMin(length, blockSize - offsetInBlock);
+		const uchar* source = fileData + static_cast<qint64>(blocks.at(blockIndex)) * blockSize + offsetInBlock;
+
+		memcpy(destination, source, bytesToCopy);
+
+		destination += bytesToCopy;
+		offset += bytesToCopy;
+		length -= bytesToCopy;
+	}
+
+	return true;
+}
+
+/*
+* Returns pointer directly into mapped file if requested range doesn't cross block boundary
+* (or if all blocks of stream are contiguous), otherwise range is copied into buffer
+*/
+const char* MSFStream::GetData(quint32 offset, quint32 length, QByteArray& buffer) const
+{
+	if (!fileData || offset > size || length > size - offset)
+	{
+		return nullptr;
+	}
+
+	if (length == 0)
+	{
+		return buffer.constData();
+	}
+
+	int blockIndex = offset / blockSize;
+	quint32 offsetInBlock = offset % blockSize;
+
+	if (isContiguous || offsetInBlock + length <= blockSize)
+	{
+		return reinterpret_cast<const char*>(fileData + static_cast<qint64>(blocks.at(blockIndex)) * blockSize + offsetInBlock);
+	}
+
+	buffer.resize(length);
+
+	if (!Read(offset, length, buffer.data()))
+	{
+		return nullptr;
+	}
+
+	return buffer.constData();
+}
+
+QByteArray MSFStream::GetData() const
+{
+	if (!fileData || size == 0)
+	{
+		return QByteArray();
+	}
+
+	if (isContiguous)
+	{
+		return QByteArray::fromRawData(reinterpret_cast<const char*>(fileData + static_cast<qint64>(blocks.at(0)) * blockSize), size);
+	}
+
+	QByteArray data;
+
+	data.resize(size);
+	Read(0, size, data.data());
+
+	return data;
+}
+
+MSFFile::MSFFile()
+{
+	fileData = nullptr;
+	fileSize = 0;
+	superBlock = {};
+}
+
+MSFFile::~MSFFile()
+{
+	Close();
+}
+
+/*
+* Only super block and stream directory are parsed here, content of streams is accessed
+* directly from memory mapped file so time needed to open file doesn't depend on it's size
+*/
+bool MSFFile::Open(const QString& filePath)
+{
+	Close();
+
+	file.setFileName(filePath);
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		errorMessage = QString("Can't open file: %1").arg(file.errorString());
+
+		return false;
+	}
+
+	fileSize = file.size();
+	fileData = file.map(0, fileSize);
+
+	if (!fileData)
+	{
+		errorMessage = QString("Can't map file into memory: %1").arg(file.errorString());
+
+		Close();
+
+		return false;
+	}
+
+	if (!ReadSuperBlock() || !ReadStreamDirectory())
+	{
+		QString errorMessage = this->errorMessage;
+
+		Close();
+
+		this->errorMessage = errorMessage;
+
+		return false;
+	}
+
+	return true;
+}
+
+void MSFFile::Close()
+{
+	if (fileData)
+	{
+		file.unmap(const_cast<uchar*>(fileData));
+	}
+
+	if (file.isOpen())
+	{
+		file.close();
+	}
+
+	fileData = nullptr;
+	fileSize = 0;
+	superBlock = {};
+
+	streamSizes.clear();
+	streamBlocks.clear();
+	errorMessage.clear();
+}
+
+bool MSFFile::IsOpen() const
+{
+	return fileData != nullptr;
+}
+
+const QString& MSFFile::GetErrorMessage() const
+{
+	return errorMessage;
+}
+
+quint32 MSFFile::GetBlockSize() const
+{
+	return superBlock.blockSize;
+}
+
+quint32 MSFFile::GetNumberOfBlocks() const
+{
+	return superBlock.numBlocks;
+}
+
+/*
+* Free block map is stored in blocks at freeBlockMapBlock, freeBlockMapBlock + blockSize,
+* freeBlockMapBlock + 2 * blockSize... and each of them describes blockSize * 8 blocks
+*/
+bool MSFFile::IsBlockFree(quint32 blockIndex) const
+{
+	if (!fileData || blockIndex >= superBlock.numBlocks)
+	{
+		return false;
+	}
+
+	quint32 bitsPerBlock = superBlock.blockSize * 8;
+	quint32 freeBlockMapBlock = superBlock.freeBlockMapBlock + (blockIndex / bitsPerBlock) * superBlock.blockSize;
+	quint32 bitIndex = blockIndex % bitsPerBlock;
+
+	if (!IsBlockIndexValid(freeBlockMapBlock))
+	{
+		return false;
+	}
+
+	const uchar* freeBlockMap = GetBlockData(freeBlockMapBlock);
+
+	return (freeBlockMap[bitIndex / 8] & (1 << (bitIndex % 8))) != 0;
+}
+
+int MSFFile::GetNumberOfStreams() const
+{
+	return streamSizes.count();
+}
+
+quint32 MSFFile::GetStreamSize(int streamIndex) const
+{
+	if (streamIndex < 0 || streamIndex >= streamSizes.count())
+	{
+		return 0;
+	}
+
+	return streamSizes.at(streamIndex);
+}
+
+MSFStream MSFFile::GetStream(int streamIndex) const
+{
+	if (!fileData || streamIndex < 0 || streamIndex >= streamSizes.count())
+	{
+		return MSFStream();
+	}
+
+	return MSFStream(fileData, superBlock.blockSize, streamBlocks.at(streamIndex), streamSizes.at(streamIndex));
+}
+
+MSFStream MSFFile::GetStream(MSFStreamIndex streamIndex) const
+{
+	return GetStream(static_cast<int>(streamIndex));
+}
+
+bool MSFFile::GetPDBInfo(PDBInfoHeader* pdbInfoHeader) const
+{
+	MSFStream stream = GetStream(MSFStreamIndex::pdbInfo);
+	uchar guid[16];
+
+	if (!stream.ReadValue(0, &pdbInfoHeader->version) ||
+		!stream.ReadValue(4, &pdbInfoHeader->signature) ||
+		!stream.ReadValue(8, &pdbInfoHeader->age) ||
+		!stream.Read(12, sizeof(guid), guid))
+	{
+		return false;
+	}
+
+	pdbInfoHeader->guid = QUuid(qFromLittleEndian<quint32>(guid), qFromLittleEndian<quint16>(guid + 4),
+		qFromLittleEndian<quint16>(guid + 6), guid[8], guid[9], guid[10], guid[11], guid[12], guid[13], guid[14], guid[15]);
+
+	return true;
+}
+
+bool MSFFile::ReadSuperBlock()
+{
+	if (fileSize < static_cast<qint64>(sizeof(MSFSuperBlock)))
+	{
+		errorMessage = "File is too small to be PDB file.";
+
+		return false;
+	}
+
+	memcpy(superBlock.fileMagic, fileData, sizeof(superBlock.fileMagic));
+
+	if (memcmp(superBlock.fileMagic, msfMagic, sizeof(superBlock.fileMagic)) != 0)
+	{
+		errorMessage = "File is not MSF 7.00 file.";
+
+		return false;
+	}
+
+	const uchar* fields = fileData + sizeof(superBlock.fileMagic);
+
+	superBlock.blockSize = qFromLittleEndian<quint32>(fields);
+	superBlock.freeBlockMapBlock = qFromLittleEndian<quint32>(fields + 4);
+	superBlock.numBlocks = qFromLittleEndian<quint32>(fields + 8);
+	superBlock.numDirectoryBytes = qFromLittleEndian<quint32>(fields + 12);
+	superBlock.unknown = qFromLittleEndian<quint32>(fields + 16);
+	superBlock.blockMapAddress = qFromLittleEndian<quint32>(fields + 20);
+
+	switch (superBlock.blockSize)
+	{
+	case 512:
+	case 1024:
+	case 2048:
+	case 4096:
+		break;
+	default:
+		errorMessage = QString("Unsupported block size: %1.").arg(superBlock.blockSize);
+
+		return false;
+	}
+
+	if (static_cast<qint64>(superBlock.numBlocks) * superBlock.blockSize > fileSize)
+	{
+		errorMessage = "File is truncated.";
+
+		return false;
+	}
+
+	if (superBlock.freeBlockMapBlock != 1 && superBlock.freeBlockMapBlock != 2)
+	{
+		errorMessage = "Invalid free block map block.";
+
+		return false;
+	}
+
+	return true;
+}
+
+bool MSFFile::ReadStreamDirectory()
+{
+	quint32 blockSize = superBlock.blockSize;
+	quint32 numDirectoryBlocks = (superBlock.numDirectoryBytes + blockSize - 1) / blockSize;
+
+	if (!IsBlockIndexValid(superBlock.blockMapAddress) || numDirectoryBlocks * sizeof(quint32) > blockSize)
+	{
+		errorMessage = "Invalid stream directory.";
+
+		return false;
+	}
+
+	//Directory is small compared to streams so it's gathered into one buffer
+	const uchar* blockMap = GetBlockData(superBlock.blockMapAddress);
+	QByteArray directory;
+
+	directory.resize(superBlock.numDirectoryBytes);
+
+	for (quint32 i = 0, offset = 0; i < numDirectoryBlocks; i++, offset += blockSize)
+	{
+		quint32 blockIndex = qFromLittleEndian<quint32>(blockMap + i * sizeof(quint32));
+
+		if (!IsBlockIndexValid(blockIndex))
+		{
+			errorMessage = "Invalid stream directory block.";
+
+			return false;
+		}
+
+		memcpy(directory.data() + offset, GetBlockData(blockIndex), qMin(blockSize, superBlock.numDirectoryBytes - offset));
+	}
+
+	const uchar* data = reinterpret_cast<const uchar*>(directory.constData());
+	const uchar* end = data + directory.size();
+
+	if (end - data < 4)
+	{
+		errorMessage = "Stream directory is empty.";
+
+		return false;
+	}
+
+	quint32 numStreams = qFromLittleEndian<quint32>(data);
+	data += 4;
+
+	if (static_cast<quint64>(end - data) < static_cast<quint64>(numStreams) * sizeof(quint32))
+	{
+		errorMessage = "Stream directory is truncated.";
+
+		return false;
+	}
+
+	streamSizes.resize(numStreams);
+	streamBlocks.resize(numStreams);
+
+	for (quint32 i = 0; i < numStreams; i++)
+	{
+		quint32 streamSize = qFromLittleEndian<quint32>(data);
+
+		streamSizes[i] = streamSize == nilStreamSize ? 0 : streamSize;
+		data += 4;
+	}
+
+	for (quint32 i = 0; i < numStreams; i++)
+	{
+		quint32 numStreamBlocks = (streamSizes.at(i) + blockSize - 1) / blockSize;
+
+		if (static_cast<quint64>(end - data) < static_cast<quint64>(numStreamBlocks) * sizeof(quint32))
+		{
+			errorMessage = "Stream directory is truncated.";
+
+			return false;
+		}
+
+		QVector<quint32>& blocks = streamBlocks[i];
+
+		blocks.resize(numStreamBlocks);
+
+		for (quint32 j = 0; j < numStreamBlocks; j++)
+		{
+			blocks[j] = qFromLittleEndian<quint32>(data);
+			data += 4;
+
+			if (!IsBlockIndexValid(blocks.at(j)))
+			{
+				errorMessage = QString("Stream %1 contains invalid block index.").arg(i);
+
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool MSFFile::IsBlockIndexValid(quint32 blockIndex) const
+{
+	return blockIndex < superBlock.numBlocks;
+}
+
+const uchar* MSFFile::GetBlockData(quint32 blockIndex) const
+{
+	return fileData + static_cast<qint64>(blockIndex) * superBlock.blockSize;
+}
@@ -1,244 +1,378 @@
 #include <assert.h>
+#include <algorithm>
 #include <string>
 #include <format>
 #include <sstream>
+#include <stdexcept>
 #include "MSVCDemangler.h"
 #include "DataType.h"
 
-MSVCDemangler::MSVCDemangler()
+//Malformed and truncated symbols aren't demangled, DemangleSymbol catches exception and returns symbol unchanged
+static void CheckSymbol(bool condition, const char* errorMessage)
 {
-	callingConventions.insert(std::make_pair("A", "__cdecl "));
-	callingConventions.insert(std::make_pair("B", "__cdecl __dll_export "));
-	callingConventions.insert(std::make_pair("C", "__pascal "));
-	callingConventions.insert(std::make_pair("D", "__pascal __dll_export "));
-	callingConventions.insert(std::make_pair("E", "__thiscall "));
-	callingConventions.insert(std::make_pair("F", "__thiscall __dll_export "));
-	callingConventions.insert(std::make_pair("G", "__stdcall "));
-	callingConventions.insert(std::make_pair("H", "__stdcall __dll_export "));
-	callingConventions.insert(std::make_pair("I", "__fastcall "));
-	callingConventions.insert(std::make_pair("J", "__fastcall __dll_export "));
-	callingConventions.insert(std::make_pair("K", ""));
-	callingConventions.insert(std::make_pair("L", "__dll_export "));
-	callingConventions.insert(std::make_pair("M", "__clrcall "));
-	callingConventions.insert(std::make_pair("N", "__clrcall __dll_export "));
-	callingConventions.insert(std::make_pair("O", "__eabi "));
-	callingConventions.insert(std::make_pair("P", "__eabi __dll_export "));
-	callingConventions.insert(std::make_pair("Q", "__vectorcall "));
+	if (!condition)
+	{
+		throw std::invalid_argument(errorMessage);
+	}
+}
 
+static constexpr MangledCode<std::string_view> callingConventionCodes[] =
+{
+	{ "A", "__cdecl " },
+	{ "B", "__cdecl __dll_export " },
+	{ "C", "__pascal " },
+	{ "D", "__pascal __dll_export " },
+	{ "E", "__thiscall " },
+	{ "F", "__thiscall __dll_export " },
+	{ "G", "__stdcall " },
+	{ "H", "__stdcall __dll_export " },
+	{ "I", "__fastcall " },
+	{ "J", "__fastcall __dll_export " },
+	{ "K", "" },
+	{ "L", "__dll_export " },
+	{ "M", "__clrcall " },
+	{ "N", "__clrcall __dll_export " },
+	{ "O", "__eabi " },
+	{ "P", "__eabi __dll_export " },
+	{ "Q", "__vectorcall " }
+};
+
+static constexpr MangledCode<DataTypeCode> dataTypeCodes[] =
+{
 	//We should set '@' to 'void' if we want the same output as wine's undname
-	dataTypes["@"].insert(std::make_pair("SIMPLE", GetVector<std::string>("")));
-	dataTypes["?"].insert(std::make_pair("MODIFIER", GetVector<std::string>("")));
-	dataTypes["A"].insert(std::make_pair("MODIFIER", GetVector<std::string>("&")));
-	dataTypes["B"].insert(std::make_pair("MODIFIER", GetVector<std::string>("& volatile")));
-	dataTypes["C"].insert(std::make_pair("SIMPLE", GetVector<std::string>("signed char")));
-	dataTypes["D"].insert(std::make_pair("SIMPLE", GetVector<std::string>("char")));
-	dataTypes["E"].insert(std::make_pair("SIMPLE", GetVector<std::string>("unsigned char")));
-	dataTypes["F"].insert(std::make_pair("SIMPLE", GetVector<std::string>("short")));
-	dataTypes["G"].insert(std::make_pair("SIMPLE", GetVector<std::string>("unsigned short")));
-	dataTypes["H"].insert(std::make_pair("SIMPLE", GetVector<std::string>("int")));
-	dataTypes["I"].insert(std::make_pair("SIMPLE", GetVector<std::string>("unsigned int")));
-	dataTypes["J"].insert(std::make_pair("SIMPLE", GetVector<std::string>("long")));
-	dataTypes["K"].insert(std::make_pair("SIMPLE", GetVector<std::string>("unsigned long")));
-	dataTypes["M"].insert(std::make_pair("SIMPLE", GetVector<std::string>("float")));
-	dataTypes["N"].insert(std::make_pair("SIMPLE", GetVector<std::string>("double")));
-	dataTypes["O"].insert(std::make_pair("SIMPLE", GetVector<std::string>("long double")));
-	dataTypes["P"].insert(std::make_pair("MODIFIER", GetVector<std::string>("*")));
-	dataTypes["Q"].insert(std::make_pair("MODIFIER", GetVector<std::string>("*", "const")));
-	dataTypes["R"].insert(std::make_pair("MODIFIER", GetVector<std::string>("*", "volatile")));
-	dataTypes["S"].insert(std::make_pair("MODIFIER", GetVector<std::string>("*", "const volatile")));
-	dataTypes["T"].insert(std::make_pair("COMPLEX", GetVector<std::string>("union")));
-	dataTypes["U"].insert(std::make_pair("COMPLEX", GetVector<std::string>("struct")));
-	dataTypes["V"].insert(std::make_pair("COMPLEX", GetVector<std::string>("class")));
-	dataTypes["W"].insert(std::make_pair("COMPLEX", GetVector<std::string>("enum")));
-	dataTypes["X"].insert(std::make_pair("SIMPLE", GetVector<std::string>("void")));
-	dataTypes["Y"].insert(std::make_pair("COMPLEX", GetVector<std::string>("cointerface")));
-	dataTypes["_D"].insert(std::make_pair("SIMPLE", GetVector<std::string>("__int8")));
-	dataTypes["_E"].insert(std::make_pair("SIMPLE", GetVector<std::string>("unsigned __int8")));
-	dataTypes["_F"].insert(std::make_pair("SIMPLE", GetVector<std::string>("__int16")));
-	dataTypes["_G"].insert(std::make_pair("SIMPLE", GetVector<std::string>("unsigned __int16")));
-	dataTypes["_H"].insert(std::make_pair("SIMPLE", GetVector<std::string>("__int32")));
-	dataTypes["_I"].insert(std::make_pair("SIMPLE", GetVector<std::string>("unsigned __int32")));
-	dataTypes["_J"].insert(std::make_pair("SIMPLE", GetVector<std::string>("__int64")));
-	dataTypes["_K"].insert(std::make_pair("SIMPLE", GetVector<std::string>("unsigned __int64")));
-	dataTypes["_L"].insert(std::make_pair("SIMPLE", GetVector<std::string>("__int128")));
-	dataTypes["_M"].insert(std::make_pair("SIMPLE", GetVector<std::string>("unsigned __int128")));
-	dataTypes["_N"].insert(std::make_pair("SIMPLE", GetVector<std::string>("bool")));
+	{ "@", { DataTypeCategory::simple, "" } },
+	{ "?", { DataTypeCategory::modifier, "" } },
+	{ "A", { DataTypeCategory::modifier, "&" } },
+	{ "B", { DataTypeCategory::modifier, "& volatile" } },
+	{ "C", { DataTypeCategory::simple, "signed char" } },
+	{ "D", { DataTypeCategory::simple, "char" } },
+	{ "E", { DataTypeCategory::simple, "unsigned char" } },
+	{ "F", { DataTypeCategory::simple, "short" } },
+	{ "G", { DataTypeCategory::simple, "unsigned short" } },
+	{ "H", { DataTypeCategory::simple, "int" } },
+	{ "I", { DataTypeCategory::simple, "unsigned int" } },
+	{ "J", { DataTypeCategory::simple, "long" } },
+	{ "K", { DataTypeCategory::simple, "unsigned long" } },
+	{ "M", { DataTypeCategory::simple, "float" } },
+	{ "N", { DataTypeCategory::simple, "double" } },
+	{ "O", { DataTypeCategory::simple, "long double" } },
+	{ "P", { DataTypeCategory::modifier, "*" } },
+	{ "Q", { DataTypeCategory::modifier, "*", "const" } },
+	{ "R", { DataTypeCategory::modifier, "*", "volatile" } },
+	{ "S", { DataTypeCategory::modifier, "*", "const volatile" } },
+	{ "T", { DataTypeCategory::complex, "union" } },
+	{ "U", { DataTypeCategory::complex, "struct" } },
+	{ "V", { DataTypeCategory::complex, "class" } },
+	{ "W", { DataTypeCategory::complex, "enum" } },
+	{ "X", { DataTypeCategory::simple, "void" } },
+	{ "Y", { DataTypeCategory::complex, "cointerface" } },
+	{ "_D", { DataTypeCategory::simple, "__int8" } },
+	{ "_E", { DataTypeCategory::simple, "unsigned __int8" } },
+	{ "_F", { DataTypeCategory::simple, "__int16" } },
+	{ "_G", { DataTypeCategory::simple, "unsigned __int16" } },
+	{ "_H", { DataTypeCategory::simple, "__int32" } },
+	{ "_I", { DataTypeCategory::simple, "unsigned __int32" } },
+	{ "_J", { DataTypeCategory::simple, "__int64" } },
+	{ "_K", { DataTypeCategory::simple, "unsigned __int64" } },
+	{ "_L", { DataTypeCategory::simple, "__int128" } },
+	{ "_M", { DataTypeCategory::simple, "unsigned __int128" } },
+	{ "_N", { DataTypeCategory::simple, "bool" } },
 	//_O   =SPECIAL CASE= Array
-	dataTypes["_S"].insert(std::make_pair("SIMPLE", GetVector<std::string>("char16_t")));
-	dataTypes["_U"].insert(std::make_pair("SIMPLE", GetVector<std::string>("char32_t")));
-	dataTypes["_W"].insert(std::make_pair("SIMPLE", GetVector<std::string>("wchar_t")));
-	dataTypes["_X"].insert(std::make_pair("COMPLEX", GetVector<std::string>("coclass")));
-	dataTypes["_Y"].insert(std::make_pair("COMPLEX", GetVector<std::string>("cointerface")));
+	{ "_S", { DataTypeCategory::simple, "char16_t" } },
+	{ "_U", { DataTypeCategory::simple, "char32_t" } },
+	{ "_W", { DataTypeCategory::simple, "wchar_t" } },
+	{ "_X", { DataTypeCategory::complex, "coclass" } },
+	{ "_Y", { DataTypeCategory::complex, "cointerface" } },
 	//_$'  =SPECIAL CASE= __w64 type
 	//$$A  =TODO= (found by reversing vcruntime140.dll, more reverse is needed)
 	//$$B  =SPECIAL CASE= Apparently no effect
-	dataTypes["$$C"].insert(std::make_pair("MODIFIER", GetVector<std::string>("")));
-	dataTypes["$$Q"].insert(std::make_pair("MODIFIER", GetVector<std::string>("&&")));
-	dataTypes["$$R"].insert(std::make_pair("MODIFIER", GetVector<std::string>("&&", "volatile")));
+	{ "$$C", { DataTypeCategory::modifier, "" } },
+	{ "$$Q", { DataTypeCategory::modifier, "&&" } },
+	{ "$$R", { DataTypeCategory::modifier, "&&", "volatile" } },
 	//$$S  =TODO= (found by reversing vcruntime140.dll, more reverse is needed)
-	dataTypes["$$T"].insert(std::make_pair("SIMPLE", GetVector<std::string>("std::nullptr_t")));
+	{ "$$T", { DataTypeCategory::simple, "std::nullptr_t" } }
 	//$$Y  =TODO= (found by reversing vcruntime140.dll, more reverse is needed)
-
-	/*
-	* Here are the enum types mentioned at
-	* https://en.wikiversity.org/wiki/Visual_C%2B%2B_name_mangling
-	* Note that only type 4 aka 'int' is used by "modern versions"
-	* of Visual Studio.
-	*/
-	enumTypes.insert(std::make_pair("0", "char"));
-	enumTypes.insert(std::make_pair("1", "unsigned char"));
-	enumTypes.insert(std::make_pair("2", "short"));
-	enumTypes.insert(std::make_pair("3", "unsigned short"));
-	enumTypes.insert(std::make_pair("4", "int"));
-	enumTypes.insert(std::make_pair("5", "unsigned int"));
-	enumTypes.insert(std::make_pair("6", "long"));
-	enumTypes.insert(std::make_pair("7", "unsigned long"));
-
-	specialFragments.insert(std::make_pair("0", "?0")); //to be done by name_finalize()
-	specialFragments.insert(std::make_pair("1", "?1")); //to be done by name_finalize()
-	specialFragments.insert(std::make_pair("2", "operator new"));
-	specialFragments.insert(std::make_pair("3", "operator delete"));
-	specialFragments.insert(std::make_pair("4", "operator="));
-	specialFragments.insert(std::make_pair("5", "operator>>"));
-	specialFragments.insert(std::make_pair("6", "operator<<"));
-	specialFragments.insert(std::make_pair("7", "operator!"));
-	specialFragments.insert(std::make_pair("8", "operator=="));
-	specialFragments.insert(std::make_pair("9", "operator!="));
-	specialFragments.insert(std::make_pair("A", "operator[]"));
-	specialFragments.insert(std::make_pair("B", "?B")); //to be done by name_finalize()
-	specialFragments.insert(std::make_pair("C", "operator->"));
-	specialFragments.insert(std::make_pair("D", "operator*"));
-	specialFragments.insert(std::make_pair("E", "operator++"));
-	specialFragments.insert(std::make_pair("F", "operator--"));
-	specialFragments.insert(std::make_pair("G", "operator-"));
-	specialFragments.insert(std::make_pair("H", "operator+"));
-	specialFragments.insert(std::make_pair("I", "operator&"));
-	specialFragments.insert(std::make_pair("J", "operator->*"));
-	specialFragments.insert(std::make_pair("K", "operator/"));
-	specialFragments.insert(std::make_pair("L", "operator%"));
-	specialFragments.insert(std::make_pair("M", "operator<"));
-	specialFragments.insert(std::make_pair("N", "operator<="));
-	specialFragments.insert(std::make_pair("O", "operator>"));
-	specialFragments.insert(std::make_pair("P", "operator>="));
-	specialFragments.insert(std::make_pair("Q", "operator,"));
-	specialFragments.insert(std::make_pair("R", "operator()"));
-	specialFragments.insert(std::make_pair("S", "operator~"));
-	specialFragments.insert(std::make_pair("T", "operator^"));
-	specialFragments.insert(std::make_pair("U", "operator|"));
-	specialFragments.insert(std::make_pair("V", "operator&&"));
-	specialFragments.insert(std::make_pair("W", "operator||"));
-	specialFragments.insert(std::make_pair("X", "operator*="));
-	specialFragments.insert(std::make_pair("Y", "operator+="));
-	specialFragments.insert(std::make_pair("Z", "operator-="));
-	specialFragments.insert(std::make_pair("_0", "operator/="));
-	specialFragments.insert(std::make_pair("_1", "operator%="));
-	specialFragments.insert(std::make_pair("_2", "operator>>="));
-	specialFragments.insert(std::make_pair("_3", "operator<<="));
-	specialFragments.insert(std::make_pair("_4", "operator&="));
-	specialFragments.insert(std::make_pair("_5", "operator|="));
-	specialFragments.insert(std::make_pair("_6", "operator^="));
-	specialFragments.insert(std::make_pair("_7", quoteB + "vftable" + quoteE));
-	specialFragments.insert(std::make_pair("_8", quoteB + "vbtable" + quoteE));
-	specialFragments.insert(std::make_pair("_9", quoteB + "vcall" + quoteE));
-	specialFragments.insert(std::make_pair("_A", quoteB + "typeof" + quoteE));
-	specialFragments.insert(std::make_pair("_B", quoteB + "local static guard" + quoteE));
-	//_C just returns 'std::string' and forgets the rest of the input
-	specialFragments.insert(std::make_pair("_D", quoteB + "vbase destructor" + quoteE));
-	specialFragments.insert(std::make_pair("_E", quoteB + "std::vector deleting destructor" + quoteE));
-	specialFragments.insert(std::make_pair("_F", quoteB + "default constructor closure" + quoteE));
-	specialFragments.insert(std::make_pair("_G", quoteB + "scalar deleting destructor" + quoteE));
-	specialFragments.insert(std::make_pair("_H", quoteB + "std::vector constructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("_I", quoteB + "std::vector destructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("_J", quoteB + "std::vector vbase constructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("_K", quoteB + "virtual displacement std::map" + quoteE));
-	specialFragments.insert(std::make_pair("_L", quoteB + "eh std::vector constructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("_M", quoteB + "eh std::vector destructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("_N", quoteB + "eh std::vector vbase constructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("_O", quoteB + "copy constructor closure" + quoteE));
+};
+
+/*
+* Here are the enum types mentioned at
+* https://en.wikiversity.org/wiki/Visual_C%2B%2B_name_mangling
+* Note that only type 4 aka 'int' is used by "modern versions"
+* of Visual Studio.
+*/
+static constexpr MangledCode<std::string_view> enumTypeCodes[] =
+{
+	{ "0", "char" },
+	{ "1", "unsigned char" },
+	{ "2", "short" },
+	{ "3", "unsigned short" },
+	{ "4", "int" },
+	{ "5", "unsigned int" },
+	{ "6", "long" },
+	{ "7", "unsigned long" }
+};
+
+static constexpr MangledCode<std::string_view> specialFragmentCodes[] =
+{
+	{ "0", "?0" }, //to be done by name_finalize()
+	{ "1", "?1" }, //to be done by name_finalize()
+	{ "2", "operator new" },
+	{ "3", "operator delete" },
+	{ "4", "operator=" },
+	{ "5", "operator>>" },
+	{ "6", "operator<<" },
+	{ "7", "operator!" },
+	{ "8", "operator==" },
+	{ "9", "operator!=" },
+	{ "A", "operator[]" },
+	{ "B", "?B" }, //to be done by name_finalize()
+	{ "C", "operator->" },
+	{ "D", "operator*" },
+	{ "E", "operator++" },
+	{ "F", "operator--" },
+	{ "G", "operator-" },
+	{ "H", "operator+" },
+	{ "I", "operator&" },
+	{ "J", "operator->*" },
+	{ "K", "operator/" },
+	{ "L", "operator%" },
+	{ "M", "operator<" },
+	{ "N", "operator<=" },
+	{ "O", "operator>" },
+	{ "P", "operator>=" },
+	{ "Q", "operator," },
+	{ "R", "operator()" },
+	{ "S", "operator~" },
+	{ "T", "operator^" },
+	{ "U", "operator|" },
+	{ "V", "operator&&" },
+	{ "W", "operator||" },
+	{ "X", "operator*=" },
+	{ "Y", "operator+=" },
+	{ "Z", "operator-=" },
+	{ "_0", "operator/=" },
+	{ "_1", "operator%=" },
+	{ "_2", "operator>>=" },
+	{ "_3", "operator<<=" },
+	{ "_4", "operator&=" },
+	{ "_5", "operator|=" },
+	{ "_6", "operator^=" },
+	{ "_7", "`vftable'" },
+	{ "_8", "`vbtable'" },
+	{ "_9", "`vcall'" },
+	{ "_A", "`typeof'" },
+	{ "_B", "`local static guard'" },
+	//_C just returns 'string' and forgets the rest of the input
+	{ "_D", "`vbase destructor'" },
+	{ "_E", "`vector deleting destructor'" },
+	{ "_F", "`default constructor closure'" },
+	{ "_G", "`scalar deleting destructor'" },
+	{ "_H", "`vector constructor iterator'" },
+	{ "_I", "`vector destructor iterator'" },
+	{ "_J", "`vector vbase constructor iterator'" },
+	{ "_K", "`virtual displacement map'" },
+	{ "_L", "`eh vector constructor iterator'" },
+	{ "_M", "`eh vector destructor iterator'" },
+	{ "_N", "`eh vector vbase constructor iterator'" },
+	{ "_O", "`copy constructor closure'" },
 	//_P "udt returning" followed by a special fragment
 	//_R0 "RTTI Type Descriptor" followed by a data type
 	//_R1 "RTTI Base Class Descriptor" followed by four numbers
-	specialFragments.insert(std::make_pair("_R2", quoteB + "RTTI Base Class Array" + quoteE));
-	specialFragments.insert(std::make_pair("_R3", quoteB + "RTTI Class Hierarchy Descriptor" + quoteE));
-	specialFragments.insert(std::make_pair("_R4", quoteB + "RTTI Complete Object Locator" + quoteE));
-	specialFragments.insert(std::make_pair("_S", quoteB + "local vftable" + quoteE));
-	specialFragments.insert(std::make_pair("_T", quoteB + "local vftable constructor closure" + quoteE));
-	specialFragments.insert(std::make_pair("_U", "operator new[]"));
-	specialFragments.insert(std::make_pair("_V", "operator delete[]"));
-	specialFragments.insert(std::make_pair("_X", quoteB + "placement delete closure" + quoteE));
-	specialFragments.insert(std::make_pair("_Y", quoteB + "placement delete[] closure" + quoteE));
-	specialFragments.insert(std::make_pair("__A", quoteB + "managed std::vector constructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("__B", quoteB + "managed std::vector destructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("__C", quoteB + "eh std::vector copy constructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("__D", quoteB + "eh std::vector vbase copy constructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("__E", "?__E")); //to be done by name_finalize()
-	specialFragments.insert(std::make_pair("__F", "?__F")); //to be done by name_finalize()
-	specialFragments.insert(std::make_pair("__G", quoteB + "std::vector copy constructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("__H", quoteB + "std::vector vbase copy constructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("__I", quoteB + "managed std::vector copy constructor iterator" + quoteE));
-	specialFragments.insert(std::make_pair("__J", quoteB + "local static thread guard" + quoteE));
-	specialFragments.insert(std::make_pair("__K", "?__K")); //to be done by name_finalize()
-
-	thunkAccesses["A"].insert(std::make_pair("", "private:"));
-	thunkAccesses["B"].insert(std::make_pair("", "private:"));
-	thunkAccesses["C"].insert(std::make_pair("", "private: static"));
-	thunkAccesses["D"].insert(std::make_pair("", "private: static"));
-	thunkAccesses["E"].insert(std::make_pair("", "private: virtual"));
-	thunkAccesses["F"].insert(std::make_pair("", "private: virtual"));
-	thunkAccesses["G"].insert(std::make_pair("", "private: thunk"));
-	thunkAccesses["H"].insert(std::make_pair("", "private: thunk"));
-	thunkAccesses["I"].insert(std::make_pair("", "protected:"));
-	thunkAccesses["J"].insert(std::make_pair("", "protected:"));
-	thunkAccesses["K"].insert(std::make_pair("", "protected: static"));
-	thunkAccesses["K"].insert(std::make_pair("", "protected: static"));
-	thunkAccesses["M"].insert(std::make_pair("", "protected: virtual"));
-	thunkAccesses["N"].insert(std::make_pair("", "protected: virtual"));
-	thunkAccesses["O"].insert(std::make_pair("", "protected: thunk"));
-	thunkAccesses["P"].insert(std::make_pair("", "protected: thunk"));
-	thunkAccesses["Q"].insert(std::make_pair("", "public:"));
-	thunkAccesses["R"].insert(std::make_pair("", "public:"));
-	thunkAccesses["S"].insert(std::make_pair("", "public: static"));
-	thunkAccesses["T"].insert(std::make_pair("", "public: static"));
-	thunkAccesses["U"].insert(std::make_pair("", "public: virtual"));
-	thunkAccesses["V"].insert(std::make_pair("", "public: virtual"));
-	thunkAccesses["W"].insert(std::make_pair("", "public: thunk"));
-	thunkAccesses["X"].insert(std::make_pair("", "public: thunk"));
-	thunkAccesses["Y"].insert(std::make_pair("", ""));
-	thunkAccesses["Z"].insert(std::make_pair("", ""));
-	thunkAccesses["0"].insert(std::make_pair("VAR", "private: static"));
-	thunkAccesses["1"].insert(std::make_pair("VAR", "protected: static"));
-	thunkAccesses["2"].insert(std::make_pair("VAR", "public: static"));
-	thunkAccesses["3"].insert(std::make_pair("VAR", "")); //private non-static
-	thunkAccesses["4"].insert(std::make_pair("VAR", "")); //protected non-static
-	thunkAccesses["5"].insert(std::make_pair("VAR", "")); //public non-static
-	thunkAccesses["6"].insert(std::make_pair("OPT", ""));
-	thunkAccesses["7"].insert(std::make_pair("OPT", ""));
-	thunkAccesses["$0"].insert(std::make_pair("vtordisp", "[thunk]:private: virtual"));
-	thunkAccesses["$1"].insert(std::make_pair("vtordisp", "[thunk]:private: virtual"));
-	thunkAccesses["$2"].insert(std::make_pair("vtordisp", "[thunk]:protected: virtual"));
-	thunkAccesses["$3"].insert(std::make_pair("vtordisp", "[thunk]:protected: virtual"));
-	thunkAccesses["$4"].insert(std::make_pair("vtordisp", "[thunk]:public: virtual"));
-	thunkAccesses["$5"].insert(std::make_pair("vtordisp", "[thunk]:public: virtual"));
-	thunkAccesses["$B"].insert(std::make_pair("vcall", "[thunk]:"));
-	thunkAccesses["$R"].insert(std::make_pair("vtordispex", "[thunk]:public: virtual"));
+	{ "_R2", "`RTTI Base Class Array'" },
+	{ "_R3", "`RTTI Class Hierarchy Descriptor'" },
+	{ "_R4", "`RTTI Complete Object Locator'" },
+	{ "_S", "`local vftable'" },
+	{ "_T", "`local vftable constructor closure'" },
+	{ "_U", "operator new[]" },
+	{ "_V", "operator delete[]" },
+	{ "_X", "`placement delete closure'" },
+	{ "_Y", "`placement delete[] closure'" },
+	{ "__A", "`managed vector constructor iterator'" },
+	{ "__B", "`managed vector destructor iterator'" },
+	{ "__C", "`eh vector copy constructor iterator'" },
+	{ "__D", "`eh vector vbase copy constructor iterator'" },
+	{ "__E", "?__E" }, //to be done by name_finalize()
+	{ "__F", "?__F" }, //to be done by name_finalize()
+	{ "__G", "`vector copy constructor iterator'" },
+	{ "__H", "`vector vbase copy constructor iterator'" },
+	{ "__I", "`managed vector copy constructor iterator'" },
+	{ "__J", "`local static thread guard'" },
+	{ "__K", "?__K" } //to be done by name_finalize()
+};
+
+static constexpr MangledCode<ThunkAccess> thunkAccessCodes[] =
+{
+	{ "A", { "", "private:" } },
+	{ "B", { "", "private:" } },
+	{ "C", { "", "private: static" } },
+	{ "D", { "", "private: static" } },
+	{ "E", { "", "private: virtual" } },
+	{ "F", { "", "private: virtual" } },
+	{ "G", { "", "private: thunk" } },
+	{ "H", { "", "private: thunk" } },
+	{ "I", { "", "protected:" } },
+	{ "J", { "", "protected:" } },
+	{ "K", { "", "protected: static" } },
+	{ "L", { "", "protected: static" } },
+	{ "M", { "", "protected: virtual" } },
+	{ "N", { "", "protected: virtual" } },
+	{ "O", { "", "protected: thunk" } },
+	{ "P", { "", "protected: thunk" } },
+	{ "Q", { "", "public:" } },
+	{ "R", { "", "public:" } },
+	{ "S", { "", "public: static" } },
+	{ "T", { "", "public: static" } },
+	{ "U", { "", "public: virtual" } },
+	{ "V", { "", "public: virtual" } },
+	{ "W", { "", "public: thunk" } },
+	{ "X", { "", "public: thunk" } },
+	{ "Y", { "", "" } },
+	{ "Z", { "", "" } },
+	{ "0", { "VAR", "private: static" } },
+	{ "1", { "VAR", "protected: static" } },
+	{ "2", { "VAR", "public: static" } },
+	{ "3", { "VAR", "" } }, //private non-static
+	{ "4", { "VAR", "" } }, //protected non-static
+	{ "5", { "VAR", "" } }, //public non-static
+	{ "6", { "OPT", "" } },
+	{ "7", { "OPT", "" } },
+	{ "$0", { "vtordisp", "[thunk]:private: virtual" } },
+	{ "$1", { "vtordisp", "[thunk]:private: virtual" } },
+	{ "$2", { "vtordisp", "[thunk]:protected: virtual" } },
+	{ "$3", { "vtordisp", "[thunk]:protected: virtual" } },
+	{ "$4", { "vtordisp", "[thunk]:public: virtual" } },
+	{ "$5", { "vtordisp", "[thunk]:public: virtual" } },
+	{ "$B", { "vcall", "[thunk]:" } },
+	{ "$R", { "vtordispex", "[thunk]:public: virtual" } }
+};
+
+static constexpr MangledCode<std::string_view> managedPrefixCodes[] =
+{
+	{ "$$F", "[managed] " },
+	{ "$$H", "[MANAGED] " }
+};
+
+static constexpr MangledCode<std::string_view> cliReturnValueCodes[] =
+{
+	{ "$A", "" },
+	{ "$C", "%" }
+};
+
+static constexpr MangledCode<CLIArgument> cliArgumentCodes[] =
+{
+	{ "PA", { " ^", "" } },
+	{ "AA", { " %", "" } },
+	//Not sure whether these next two are generated by the compiler
+	{ "PC", { " %", "" } },
+	{ "AC", { " %", "" } },
+	/*
+	* pin_ptr decoding seems invalid, the < is not closed,
+	* but that's what undname.exe outputs.
+	*/
+	{ "PB", { " *", "cli::pin_ptr<" } },
+	{ "AB", { " &", "cli::pin_ptr<" } }
+};
+
+static constexpr MangledCode<std::string_view> pointerModifierCodes[] =
+{
+	{ "E", "__ptr64" },
+	{ "F", "__unaligned" },
+	{ "I", "__restrict" }
+};
+
+static constexpr MangledCode<std::string_view> cvModifierCodes[] =
+{
+	{ "A", "" },
+	{ "B", "const" },
+	{ "C", "volatile" },
+	{ "D", "const volatile" },
+	{ "M2", "__based({})" }
+};
+
+static constexpr MangledCodeTable callingConventions(callingConventionCodes);
+static constexpr MangledCodeTable dataTypes(dataTypeCodes);
+static constexpr MangledCodeTable enumTypes(enumTypeCodes);
+static constexpr MangledCodeTable specialFragments(specialFragmentCodes);
+static constexpr MangledCodeTable thunkAccesses(thunkAccessCodes);
+static constexpr MangledCodeTable managedPrefixes(managedPrefixCodes);
+static constexpr MangledCodeTable cliReturnValues(cliReturnValueCodes);
+static constexpr MangledCodeTable cliArguments(cliArgumentCodes);
+static constexpr MangledCodeTable pointerModifiers(pointerModifierCodes);
+static constexpr MangledCodeTable cvModifiers(cvModifierCodes);
+
+std::string MSVCDemangler::DemangleSymbol(const std::string& symbol, std::string& rest, bool verbose)
+{
+	std::string result;
+	DemangleData data = DemangleData(symbol, verbose);
+
+	errorMessage.clear();
+
+	try
+	{
+		result = DemangleReentrantSymbol(&data);
+		rest = data.GetValue();
+	}
+	catch (const std::logic_error& exception)
+	{
+		errorMessage = exception.what();
+		rest = symbol;
+
+		return symbol;
+	}
+
+	return result;
 }
 
-std::string MSVCDemangler::DemangleSymbol(std::string symbol, std::string& rest, bool verbose)
+/*
+* Also fills structure of symbol so its scopes, parameters and other parts
+* can be used without parsing of demangled name
+*/
+std::string MSVCDemangler::DemangleSymbol(const std::string& symbol, std::string& rest, DemangledSymbol& demangledSymbol, bool verbose)
 {
 	std::string result;
 	DemangleData data = DemangleData(symbol, verbose);
 
-	result = DemangleReentrantSymbol(&data);
-	rest = data.GetValue();
+	demangledSymbol.Clear();
+	errorMessage.clear();
+
+	try
+	{
+		result = DemangleReentrantSymbol(&data, &demangledSymbol);
+		rest = data.GetValue();
+	}
+	catch (const std::logic_error& exception)
+	{
+		errorMessage = exception.what();
+		rest = symbol;
+		result = symbol;
+
+		demangledSymbol.Clear();
+	}
+
+	demangledSymbol.SetUndecoratedName(result);
 
 	return result;
 }
 
-std::string MSVCDemangler::DemangleReentrantSymbol(DemangleData* data)
+bool MSVCDemangler::HasError() const
 {
-	//Reentrant: can be called for nested symbols.
+	return errorMessage.length() > 0;
+}
+
+//Reason why last symbol couldn't be demangled
+const std::string& MSVCDemangler::GetErrorMessage() const
+{
+	return errorMessage;
+}
+
+std::string MSVCDemangler::DemangleReentrantSymbol(DemangleData* data, DemangledSymbol* demangledSymbol)
+{
+	/*
+	* Reentrant: can be called for nested symbols.
+	* Structure is filled only for outermost symbol.
+	*/
 
-	if (data->GetValue().substr(0, 5) == "__mep@")
+	if (data->StartsWith("__mep@"))
 	{
 		/*
 		* undname.exe does not expand symbols beginning with __mep@,
@@ -248,20 +382,28 @@ std::string MSVCDemangler::DemangleReentrantSymbol(DemangleData* data)
 
 		data->Advance(6);
 
-		return "[MEP] " + DemangleReentrantSymbol(data);
+		if (demangledSymbol)
+		{
+			demangledSymbol->AddPrefix("[MEP] ");
+		}
+
+		return "[MEP] " + DemangleReentrantSymbol(data, demangledSymbol);
 	}
-	else if (data->GetValue()[0] != '?')
+	else if (data->Peek() != '?')
 	{
+		//Name is returned as it is like undname.exe does
 		data->Log("Not mangled.");
 
-		data->Advance(static_cast<int>(data->GetValue().length()));
+		std::string name(data->GetValue());
 
-		return data->GetValue();
+		data->Advance(static_cast<int>(name.length()));
+
+		return name;
 	}
 
 	data->Advance(1);
 
-	if (data->GetValue()[0] == '$')
+	if (data->Peek() == '$')
 	{
 		/*
 		* Neither a variable nor a function: just a name with a template
@@ -272,11 +414,17 @@ std::string MSVCDemangler::DemangleReentrantSymbol(DemangleData* data)
 
 		std::string name = ExtractTemplate(data);
 
-		assert(data->GetValue().length() == 0);
+		CheckSymbol(data->GetValue().empty(), "Unexpected data after template");
+
+		if (demangledSymbol)
+		{
+			demangledSymbol->SetKind(DemangledSymbolKind::name);
+			demangledSymbol->SetScopes({ name });
+		}
 
 		return name;
 	}
-	else if (data->GetValue()[0] == '@')
+	else if (data->Peek() == '@')
 	{
 		/*
 		* Found by reversing vcruntime140.dll
@@ -286,19 +434,30 @@ std::string MSVCDemangler::DemangleReentrantSymbol(DemangleData* data)
 		data->Advance(1);
 		data->Log("CV: prefix");
 
-		return "CV: " + DemangleReentrantSymbol(data);
+		if (demangledSymbol)
+		{
+			demangledSymbol->AddPrefix("CV: ");
+		}
+
+		return "CV: " + DemangleReentrantSymbol(data, demangledSymbol);
 	}
-	else if (data->GetValue().substr(0, 3) == "?_C")
+	else if (data->StartsWith("?_C"))
 	{
 		/*
-		* Neither a variable nor a function: just `std::string'
+		* Neither a variable nor a function: just `string'
 		* The rest is ignored
 		*/
 
-		std::string name = quoteB + "std::string" + quoteE;
+		std::string name = quoteB + "string" + quoteE;
 
 		data->Advance(static_cast<int>(data->GetValue().length()));
 
+		if (demangledSymbol)
+		{
+			demangledSymbol->SetKind(DemangledSymbolKind::name);
+			demangledSymbol->SetScopes({ name });
+		}
+
 		return name;
 	}
 
@@ -309,7 +468,7 @@ std::string MSVCDemangler::DemangleReentrantSymbol(DemangleData* data)
 
 	std::vector<std::string> names;
 
-	if (data->GetValue()[0] == '?')
+	if (data->Peek() == '?')
 	{
 		data->Advance(1);
 
@@ -326,23 +485,23 @@ std::string MSVCDemangler::DemangleReentrantSymbol(DemangleData* data)
 
 	if (names[0] == quoteB + "local static guard" + quoteE)
 	{
-		return DemangleLocalStaticGuardSymbol(names, data);
+		return DemangleLocalStaticGuardSymbol(names, data, demangledSymbol);
 	}
 
-	if ('0' <= data->GetValue()[0] && data->GetValue()[0] <= '9' || data->GetValue().substr(0, 2) == "$B")
+	if (('0' <= data->Peek() && data->Peek() <= '9') || data->StartsWith("$B"))
 	{
-		return DemangleVariableSymbol(names, data);
+		return DemangleVariableSymbol(names, data, demangledSymbol);
 	}
 
-	if ('A' <= data->GetValue()[0] && data->GetValue()[0] <= 'Z' || data->GetValue()[0] == '$')
+	if (('A' <= data->Peek() && data->Peek() <= 'Z') || data->Peek() == '$')
 	{
-		return DemangleFunctionSymbol(names, data);
+		return DemangleFunctionSymbol(names, data, demangledSymbol);
 	}
 
 	return "";
 }
 
-std::tuple<DataType, std::string, std::string> MSVCDemangler::DemangleFunctionPrototypeSymbol(DemangleData* data)
+std::tuple<DataType, std::string, std::string> MSVCDemangler::DemangleFunctionPrototypeSymbol(DemangleData* data, std::vector<std::string>* arguments)
 {
 	/*
 	* Used when demangling a function, but also for function pointers
@@ -352,7 +511,7 @@ std::tuple<DataType, std::string, std::string> MSVCDemangler::DemangleFunctionPr
 
 	result = std::make_tuple(DataType(), "", "");
 
-	get<1>(result) = ParseValue(data, callingConventions, "CALL");
+	get<1>(result) = ParseValue(data, callingConventions, "CALL=");
 	get<0>(result) = GetDataType(data);
 
 	data->Log("RET=%s", get<0>(result).GetValue().c_str());
@@ -361,7 +520,12 @@ std::tuple<DataType, std::string, std::string> MSVCDemangler::DemangleFunctionPr
 
 	get<2>(result) = "(" + Join(args2, ",") + ")";
 
-	if (data->GetValue()[0] == 'Z')
+	if (arguments)
+	{
+		*arguments = std::move(args2);
+	}
+
+	if (data->Peek() == 'Z')
 	{
 		//No throw
 
@@ -380,41 +544,62 @@ std::tuple<DataType, std::string, std::string> MSVCDemangler::DemangleFunctionPr
 	return result;
 }
 
-std::string MSVCDemangler::DemangleLocalStaticGuardSymbol(std::vector<std::string> names, DemangleData* data)
+std::string MSVCDemangler::DemangleLocalStaticGuardSymbol(std::vector<std::string>& names, DemangleData* data, DemangledSymbol* demangledSymbol)
 {
 	//We don't know if other value than 5 can appear, and what they mean.
 
-	assert(data->GetValue()[0] == '5');
+	CheckSymbol(data->Peek() == '5', "Unknown local static guard");
 	data->Advance(1);
-	assert('0' <= data->GetValue()[0] && data->GetValue()[0] <= '9');
+	CheckSymbol('0' <= data->Peek() && data->Peek() <= '9', "Unknown local static guard");
 
-	std::string param = std::to_string(1 + static_cast<int>(data->GetValue()[0]) - static_cast<int>('0'));
+	std::string param = std::to_string(1 + static_cast<int>(data->Peek()) - static_cast<int>('0'));
 
 	data->Advance(1);
 	reverse(names.begin(), names.end());
 
 	std::string name = Join(names, "::");
 
+	if (demangledSymbol)
+	{
+		demangledSymbol->SetKind(DemangledSymbolKind::localStaticGuard);
+		demangledSymbol->SetScopes(names);
+	}
+
 	return name + format("{{}}'", param);
 }
 
-std::string MSVCDemangler::DemangleVariableSymbol(std::vector<std::string> names, DemangleData* data)
+std::string MSVCDemangler::DemangleVariableSymbol(std::vector<std::string>& names, DemangleData* data, DemangledSymbol* demangledSymbol)
 {
 	//Access level and storage class
-	std::multimap<std::string, std::string> result = ParseValue(data, thunkAccesses, "TYPE=%s ACCESS=%s");
-	std::string thunk = result.begin()->first;
-	std::string access = result.begin()->second;
+	ThunkAccess thunkAccess = ParseValue(data, thunkAccesses, "THUNK=");
+	std::string thunk(thunkAccess.thunk);
+	std::string access(thunkAccess.access);
 	std::string addName;
 	DataType returnType;
+	std::string variableType;
+	std::string cv;
 
 	if (thunk == "VAR")
 	{
 		//NB: ret is of type DataType, because it may be a function pointer
 		returnType = GetDataType(data);
+		variableType = returnType.GetValue();
 
-		data->Log("TYPE=%s", returnType.GetValue().c_str());
+		data->Log("TYPE=%s", variableType.c_str());
+		CheckSymbol(!variableType.empty(), "Unknown data type");
+		CheckSymbol(!data->GetValue().empty(), "Missing storage class");
 
-		std::string cv = Join(GetClassModifiers(data), " ");
+		std::vector<std::string> classModifiers = GetClassModifiers(data);
+
+		//Storage class of const pointer repeats const qualifier of pointer which is already part of type
+		if (classModifiers[0].length() && variableType.ends_with(" " + classModifiers[0]))
+		{
+			classModifiers[0].clear();
+		}
+
+		classModifiers.erase(std::remove(classModifiers.begin(), classModifiers.end(), ""), classModifiers.end());
+
+		cv = Join(classModifiers, " ");
 
 		if (cv.length())
 		{
@@ -432,18 +617,18 @@ std::string MSVCDemangler::DemangleVariableSymbol(std::vector<std::string> names
 			returnType.Add(" ");
 		}
 
-		if (data->GetValue()[0] != '@')
+		if (data->Peek() != '@')
 		{
 			std::vector<std::string> addNames = ExtractNamesList(data);
 
 			reverse(addNames.begin(), addNames.end());
 
 			addName = Join(addNames, "::");
-			addName = format("{for %s%s%s}", quoteB, addName, quoteE);
+			addName = "{for " + quoteB + addName + quoteE + "}";
 		}
 
 		data->Log("OPT_NAME=%s", addName.c_str());
-		assert(data->GetValue()[0] == '@');
+		CheckSymbol(data->Peek() == '@', "Expected end of name");
 		data->Advance(1);
 	}
 	else if (thunk == "vcall")
@@ -454,10 +639,10 @@ std::string MSVCDemangler::DemangleVariableSymbol(std::vector<std::string> names
 
 		addName = "{" + std::to_string(n1) + ",{flat}}" + quoteE + " }" + quoteE;
 
-		assert(data->GetValue()[0] == 'A');
+		CheckSymbol(data->Peek() == 'A', "Unexpected code");
 		data->Advance(1);
 
-		returnType = DataType(std::make_tuple(ParseValue(data, callingConventions, "CALL=%s"), "", ""), false);
+		returnType = DataType(std::make_tuple(std::string(ParseValue(data, callingConventions, "CALL=")), "", ""), false);
 	}
 
 	reverse(names.begin(), names.end());
@@ -466,6 +651,15 @@ std::string MSVCDemangler::DemangleVariableSymbol(std::vector<std::string> names
 
 	returnType.Add(name);
 
+	if (demangledSymbol)
+	{
+		demangledSymbol->SetKind(DemangledSymbolKind::variable);
+		demangledSymbol->SetAccess(access);
+		demangledSymbol->SetReturnType(variableType);
+		demangledSymbol->SetQualifiers(cv);
+		demangledSymbol->SetScopes(names);
+	}
+
 	if (access.length())
 	{
 		access += " ";
@@ -474,13 +668,12 @@ std::string MSVCDemangler::DemangleVariableSymbol(std::vector<std::string> names
 	return access + returnType.GetValue() + addName;
 }
 
-std::string MSVCDemangler::DemangleFunctionSymbol(std::vector<std::string> names, DemangleData* data)
+std::string MSVCDemangler::DemangleFunctionSymbol(std::vector<std::string>& names, DemangleData* data, DemangledSymbol* demangledSymbol)
 {
 	std::string prefix;
 	std::vector<std::string> vtor;
 
-	if (std::string("$$F").find(data->GetValue().substr(0, 3)) != std::string::npos ||
-		std::string("$$H").find(data->GetValue().substr(0, 3)) != std::string::npos)
+	if (data->StartsWith("$$F") || data->StartsWith("$$H"))
 	{
 		/*
 		* C++/CLI
@@ -500,43 +693,46 @@ std::string MSVCDemangler::DemangleFunctionSymbol(std::vector<std::string> names
 		* it seems more informative.
 		*/
 
-		std::map<std::string, std::string> prefixes;
-
-		prefixes.insert(std::make_pair("$$F", "[managed] "));
-		prefixes.insert(std::make_pair("$$H", "[MANAGED] "));
+		prefix = ParseValue(data, managedPrefixes);
 
-		prefix = prefixes[data->GetValue().substr(0, 3)];
-
-		data->Advance(3);
+		if (demangledSymbol)
+		{
+			demangledSymbol->AddPrefix(prefix);
+		}
 
-		return prefix + DemangleFunctionSymbol(names, data);
+		return prefix + DemangleFunctionSymbol(names, data, demangledSymbol);
 	}
 
-	if (data->GetValue().substr(0, 3) == "$$J")
+	if (data->StartsWith("$$J"))
 	{
 		data->Advance(3);
-		assert(data->GetValue().length());
+		CheckSymbol(!data->GetValue().empty(), "Unexpected end of symbol");
 
-		if (std::string("0123456789").find(data->GetValue()[0]) != std::string::npos)
+		if (std::string("0123456789").find(data->Peek()) != std::string::npos)
 		{
 			/*
 			* To be analyzed later... does not change the output of undname.exe
 			* Visual Studio generates various values ('0', '18', ...)
 			*/
 
-			data->Advance(1 + static_cast<int>(data->GetValue()[0]) - static_cast<int>('0'));
+			data->Advance(1 + static_cast<int>(data->Peek()) - static_cast<int>('0'));
 		}
 
 		prefix = "extern \"C\" ";
+
+		if (demangledSymbol)
+		{
+			demangledSymbol->AddPrefix(prefix);
+		}
 	}
 	else
 	{
 		prefix = "";
 	}
 
-	std::multimap<std::string, std::string> result = ParseValue(data, thunkAccesses, "TYPE=%s ACCESS=%s");
-	std::string thunk = result.begin()->first;
-	std::string access = result.begin()->second;
+	ThunkAccess thunkAccess = ParseValue(data, thunkAccesses, "THUNK=");
+	std::string thunk(thunkAccess.thunk);
+	std::string access(thunkAccess.access);
 
 	if (thunk == "vtordisp")
 	{
@@ -547,7 +743,7 @@ std::string MSVCDemangler::DemangleFunctionSymbol(std::vector<std::string> names
 	}
 	else if (thunk == "vtordispex")
 	{
-		assert(data->GetValue()[0] == '4');
+		CheckSymbol(data->Peek() == '4', "Unexpected code");
 		data->Advance(1);
 
 		for (int i = 0; i < 4; i++)
@@ -560,12 +756,7 @@ std::string MSVCDemangler::DemangleFunctionSymbol(std::vector<std::string> names
 
 	if (access.length() && std::string(access).find("static") == std::string::npos)
 	{
-		std::map<std::string, std::string> cliReturnValues;
-
-		cliReturnValues.insert(std::make_pair("$A", ""));
-		cliReturnValues.insert(std::make_pair("$C", "%"));
-
-		std::string cli = ParseValue(data, cliReturnValues);
+		std::string cli(ParseValue(data, cliReturnValues));
 
 		if (cli.length())
 		{
@@ -577,12 +768,24 @@ std::string MSVCDemangler::DemangleFunctionSymbol(std::vector<std::string> names
 		cv = Join(GetClassModifiers(data), " ") + cv;
 	}
 
-	std::tuple<DataType, std::string, std::string> result2 = DemangleFunctionPrototypeSymbol(data);
+	std::vector<std::string> arguments;
+	std::tuple<DataType, std::string, std::string> result2 = DemangleFunctionPrototypeSymbol(data, &arguments);
 	FinalizeName(names, get<0>(result2));
 	reverse(names.begin(), names.end());
 
 	std::string name = Join(names, "::");
 
+	if (demangledSymbol)
+	{
+		demangledSymbol->SetKind(DemangledSymbolKind::function);
+		demangledSymbol->SetAccess(access);
+		demangledSymbol->SetCallingConvention(get<1>(result2));
+		demangledSymbol->SetReturnType(get<0>(result2).GetValue());
+		demangledSymbol->SetQualifiers(cv);
+		demangledSymbol->SetScopes(names);
+		demangledSymbol->SetParameters(arguments);
+	}
+
 	if (thunk.length() && thunk.starts_with("vtordisp"))
 	{
 		name += quoteB + thunk + '{' + Join(vtor, ",") + '}' + quoteE + ' ';
@@ -617,45 +820,48 @@ std::string MSVCDemangler::ExtractTemplate(DemangleData* data)
 
 std::string MSVCDemangler::ExtractNameString(DemangleData* data)
 {
-	std::string name = data->GetValue();
+	std::string_view name = data->GetValue();
 
-	assert(name.length());
-	assert(name[0] != '?');
+	CheckSymbol(!name.empty(), "Unexpected end of symbol");
+	CheckSymbol(name[0] != '?', "Unexpected nested symbol");
 
 	int idx = data->Index('@');
-	std::string fragment = name.substr(0, idx);
+
+	CheckSymbol(idx >= 0, "Unterminated name");
+
+	std::string_view fragment = name.substr(0, idx);
 
 	data->Advance(idx + 1);
 	data->AddFragment(fragment);
-	data->Log("NAME=%s", fragment.c_str());
+	data->Log("NAME=%.*s", static_cast<int>(fragment.length()), fragment.data());
 
-	return fragment;
+	return std::string(fragment);
 }
 
 std::string MSVCDemangler::ExtractSpecialName(DemangleData* data)
 {
 	//The symbol's name optionally starts with a special fragment
-	std::string fragment = ParseValue(data, specialFragments);
+	std::string fragment(ParseValue(data, specialFragments));
 
 	if (fragment.length() > 0)
 	{
 		data->Log("SPEC=%s", fragment.c_str());
 	}
-	else if (data->GetValue().substr(0, 2) == "_P")
+	else if (data->StartsWith("_P"))
 	{
 		data->Advance(2);
 
 		fragment = quoteB + "udt returning" + quoteE;
 		fragment += ExtractSpecialName(data)[0];
 	}
-	else if (data->GetValue().substr(0, 3) == "_R0")
+	else if (data->StartsWith("_R0"))
 	{
 		data->Advance(3);
 
 		fragment = GetDataType(data).GetValue();
 		fragment += ' ' + quoteB + "RTTI Type Descriptor" + quoteE;
 	}
-	else if (data->GetValue().substr(0, 3) == "_R1")
+	else if (data->StartsWith("_R1"))
 	{
 		data->Advance(3);
 
@@ -668,20 +874,21 @@ std::string MSVCDemangler::ExtractSpecialName(DemangleData* data)
 
 		fragment += ")" + quoteE;
 	}
-	else if (data->GetValue().substr(0, 2) == "$?")
+	else if (data->StartsWith("$?"))
 	{
-		//operator template
+		//operator template, its arguments have their own back references like arguments of normal template
 		data->Advance(2);
+		data->EnterTemplate();
 
 		fragment = ParseValue(data, specialFragments);
 
-		fragment += format("<{}>", GetDataType(data).GetValue());
+		std::vector<std::string> args = ArgList(data, "Z@");
 
-		assert(data->GetValue()[0] == '@');
+		data->ExitTemplate();
 
-		data->Advance(1);
+		fragment += format("<{}>", Join(args, ","));
 	}
-	else if (data->GetValue()[0] == '$')
+	else if (data->Peek() == '$')
 	{
 		//normal template
 		data->Advance(1);
@@ -702,14 +909,16 @@ std::vector<std::string> MSVCDemangler::ExtractNamesList(DemangleData* data)
 
 	std::vector<std::string> names;
 
-	while (data->GetValue()[0] != '@')
+	while (data->Peek() != '@')
 	{
+		CheckSymbol(!data->GetValue().empty(), "Unexpected end of symbol");
+
 		std::string fragment = ExtractNameFragment(data);
 
 		names.push_back(fragment);
 	}
 
-	assert(data->GetValue()[0] == '@');
+	CheckSymbol(data->Peek() == '@', "Expected end of names");
 	data->Advance(1);
 	data->Log("NAME=%s", Join(names, ",").c_str());
 
@@ -720,23 +929,23 @@ std::string MSVCDemangler::ExtractNameFragment(DemangleData* data)
 {
 	std::string fragment;
 
-	if (data->GetValue().length() && std::string("0123456789").find(data->GetValue()[0]) != std::string::npos)
+	if (data->GetValue().length() && std::string("0123456789").find(data->Peek()) != std::string::npos)
 	{
 		//fragment backreference
-		data->Log("BACKREF_FRG=%c", data->GetValue()[0]);
+		data->Log("BACKREF_FRG=%c", data->Peek());
 
-		fragment = data->GetFragment(static_cast<int>(data->GetValue()[0]) - '0');
+		fragment = data->GetFragment(static_cast<int>(data->Peek()) - '0');
 
 		data->Advance(1);
 	}
-	else if (data->GetValue().substr(0, 2) == "??")
+	else if (data->StartsWith("??"))
 	{
 		//nested name
 		data->Advance(1);
 
 		fragment = quoteB + DemangleReentrantSymbol(data) + quoteE;
 	}
-	else if (data->GetValue().substr(0, 2) == "?$")
+	else if (data->StartsWith("?$"))
 	{
 		//template
 		data->Advance(2);
@@ -744,16 +953,18 @@ std::string MSVCDemangler::ExtractNameFragment(DemangleData* data)
 		fragment = ExtractTemplate(data);
 		data->AddFragment(fragment);
 	}
-	else if (data->GetValue().substr(0, 2) == "?A")
+	else if (data->StartsWith("?A"))
 	{
 		//anonymous namespace
 		int idx = data->Index('@');
 
+		CheckSymbol(idx >= 0, "Unterminated name");
+
 		data->Advance(idx + 1);
 
 		fragment = quoteB + "anonymous namespace" + quoteE;
 	}
-	else if (data->GetValue()[0] == '?')
+	else if (data->Peek() == '?')
 	{
 		//numbered namespace
 		data->Advance(1);
@@ -772,7 +983,7 @@ std::string MSVCDemangler::ExtractNameFragment(DemangleData* data)
 	return fragment;
 }
 
-std::vector<std::string> MSVCDemangler::ArgList(DemangleData* data, std::string stop)
+std::vector<std::string> MSVCDemangler::ArgList(DemangleData* data, std::string_view stop)
 {
 	/*
 	* For function arguments, 'X' is terminating     => stop = 'XZ@'
@@ -785,13 +996,13 @@ std::vector<std::string> MSVCDemangler::ArgList(DemangleData* data, std::string
 
 	while (data->GetValue().length())
 	{
-		if (stop.find(data->GetValue()[0]) != std::string::npos)
+		if (stop.find(data->Peek()) != std::string::npos)
 		{
 			break;
 		}
 
 		std::string str = "CDEFGHIJKMNO";
-		bool isPrimitiveType = str.find(data->GetValue()[0]) != std::string::npos;
+		bool isPrimitiveType = str.find(data->Peek()) != std::string::npos;
 		std::string a = GetDataType(data).GetValue();
 
 		if (a.empty())
@@ -816,13 +1027,13 @@ std::vector<std::string> MSVCDemangler::ArgList(DemangleData* data, std::string
 		return args;
 	}
 
-	if (data->GetValue()[0] == 'X')
+	if (data->Peek() == 'X')
 	{
 		//void as the only argument
 
 		args.push_back("void");
 	}
-	else if (data->GetValue().substr(0, 2) == "ZZ")
+	else if (data->StartsWith("ZZ"))
 	{
 		//ellipsis only when at the end of the argument list
 
@@ -830,7 +1041,7 @@ std::vector<std::string> MSVCDemangler::ArgList(DemangleData* data, std::string
 	}
 	else
 	{
-		assert(data->GetValue()[0] == '@');
+		CheckSymbol(data->Peek() == '@', "Expected end of arguments");
 	}
 
 	data->Advance(1);
@@ -844,19 +1055,20 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 
 	data->Log("TYPE depth %d", depth);
 
-	if (data->GetValue().length() && std::string("0123456789").find(data->GetValue()[0]) != std::string::npos)
+	CheckSymbol(!data->GetValue().empty(), "Unexpected end of symbol");
+
+	if (data->GetValue().length() && std::string("0123456789").find(data->Peek()) != std::string::npos)
 	{
 		//argument backreference
-		int pos = static_cast<int>(data->GetValue()[0]) - '0';
+		int pos = static_cast<int>(data->Peek()) - '0';
 
 		data->Log("BACKREF_ARG=%d", pos);
 		data->Advance(1);
-		assert(pos < data->GetArgumentsSize());
+		CheckSymbol(pos < data->GetArgumentsSize(), "Invalid back reference");
 
-		result = DataType(std::make_tuple(data->GetArgument(pos), "", ""), false);
+		result = DataType(std::make_tuple(std::string(data->GetArgument(pos)), "", ""), false);
 	}
-	else if (std::string("P6").find(data->GetValue().substr(0, 2)) != std::string::npos ||
-		std::string("Q6").find(data->GetValue().substr(0, 2)) != std::string::npos)
+	else if (data->StartsWith("P6") || data->StartsWith("Q6"))
 	{
 		/*
 		* Function pointer
@@ -867,7 +1079,7 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 		* 'Q6' is probably 'const', but undname.exe does not show it.
 		*/
 
-		std::multimap<std::string, std::vector<std::string>> result2 = ParseValue(data, dataTypes);
+		DataTypeCode dataTypeCode = ParseValue(data, dataTypes);
 
 		data->Advance(1);
 
@@ -875,13 +1087,21 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 
 		result = DataType(std::make_tuple(get<0>(result3).GetValue(), get<1>(result3), get<2>(result3)), true);
 
-		result.Add(Join(result2.begin()->second, " "));
+		std::string modifier(dataTypeCode.name);
+
+		if (dataTypeCode.qualifier.length())
+		{
+			modifier += ' ';
+			modifier += dataTypeCode.qualifier;
+		}
+
+		result.Add(modifier);
 	}
-	else if (std::string("P8").find(data->GetValue().substr(0, 2)) != std::string::npos)
+	else if (data->StartsWith("P8"))
 	{
 		//Member function pointer
 		data->Advance(2);
-		assert(data->GetValue().length());
+		CheckSymbol(!data->GetValue().empty(), "Unexpected end of symbol");
 
 		std::vector<std::string> names = ExtractNamesList(data);
 
@@ -897,20 +1117,19 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 		result.Add(name + "::*");
 		result.Append(cv);
 	}
-	else if (data->GetValue().substr(0, 3) == "__Z")
+	else if (data->StartsWith("__Z"))
 	{
 		//HACK. do nothing
 		data->Advance(3);
 
 		result = GetDataType(data);
 	}
-	else if (std::string("A$").find(data->GetValue().substr(0, 2)) != std::string::npos ||
-		std::string("P$").find(data->GetValue().substr(0, 2)) != std::string::npos)
+	else if (data->StartsWith("A$") || data->StartsWith("P$"))
 	{
-		char cli0 = data->GetValue()[0];
+		char cli0 = data->Peek();
 
 		data->Advance(2);
-		assert(data->GetValue().length());
+		CheckSymbol(!data->GetValue().empty(), "Unexpected end of symbol");
 
 		/*
 		* Managed C++ properties
@@ -926,28 +1145,16 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 
 		data->Log("C++/CLI Arguments");
 
-		char cli1 = data->GetValue()[0];
+		char cli1 = data->Peek();
 
 		if (std::string("ABC").find(cli1) != std::string::npos)
 		{
 			data->Advance(1);
 
-			std::map<std::string, std::map<std::string, std::string>> cliArguments;
-
-			cliArguments["PA"].insert(std::make_pair(" ^", ""));
-			cliArguments["AA"].insert(std::make_pair(" %", ""));
-			//Not sure whether these next two are generated by the compiler
-			cliArguments["PC"].insert(std::make_pair(" %", ""));
-			cliArguments["AC"].insert(std::make_pair(" %", ""));
-			/*
-			* pin_ptr decoding seems invalid, the < is not closed,
-			* but that's what undname.exe outputs.
-			*/
-			cliArguments["PB"].insert(std::make_pair(" *", "cli::pin_ptr<"));
-			cliArguments["AB"].insert(std::make_pair(" &", "cli::pin_ptr<"));
-
-			std::string postfix = cliArguments[std::string(1, cli0) + std::string(1, cli1)].begin()->first;
-			std::string prefix = cliArguments[std::string(1, cli0) + std::string(1, cli1)].begin()->second;
+			const char code[] = { cli0, cli1 };
+			const MangledCode<CLIArgument>* cliArgument = cliArguments.Find(std::string_view(code, 2));
+			std::string postfix(cliArgument ? cliArgument->value.postfix : "");
+			std::string prefix(cliArgument ? cliArgument->value.prefix : "");
 			std::vector<std::string> classModifiers = GetClassModifiers(data);
 
 			result = GetDataType(data, depth + 1);
@@ -1010,10 +1217,10 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 			* but this is clearly a bug of undname.exe
 			*/
 
-			assert(false);
+			CheckSymbol(false, "Unknown C++/CLI array");
 		}
 	}
-	else if (data->GetValue()[0] == '?' && data->IsInTemplate())
+	else if (data->Peek() == '?' && data->IsInTemplate())
 	{
 		//Template parameters
 		data->Advance(1);
@@ -1022,10 +1229,10 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 
 		result = DataType(std::make_tuple(quoteB + std::format("template-parameter-{}", i) + quoteE, "", ""), false);
 	}
-	else if (data->GetValue()[0] == '$' && data->GetValue().substr(0, 2) != "$$" && data->IsInTemplate())
+	else if (data->Peek() == '$' && data->GetValue().substr(0, 2) != "$$" && data->IsInTemplate())
 	{
 		//Various types of template parameters
-		char templateType = data->GetValue()[1];
+		char templateType = data->Peek(1);
 		int i;
 
 		data->Advance(2);
@@ -1059,7 +1266,7 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 			* but the result seems meaningless.
 			*/
 
-			std::string h = std::to_string(static_cast<int>(data->GetValue()[0]) - static_cast<int>('/'));
+			std::string h = std::to_string(static_cast<int>(data->Peek()) - static_cast<int>('/'));
 
 			data->Advance(1);
 
@@ -1071,13 +1278,13 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 			}
 			else if (templateType == 'F')
 			{
-				result = DataType(std::make_tuple(format("{%s,%d}", h, i), "", ""), false);
+				result = DataType(std::make_tuple("{" + h + "," + std::to_string(i) + "}", "", ""), false);
 			}
 			else if (templateType == 'G')
 			{
 				int j = DecodeNumber(data);
 
-				result = DataType(std::make_tuple(format("{%s,%d,%d}", h, i, j), "", ""), false);
+				result = DataType(std::make_tuple("{" + h + "," + std::to_string(i) + "," + std::to_string(j) + "}", "", ""), false);
 			}
 		}
 		else if (templateType == 'D')
@@ -1096,7 +1303,7 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 			throw std::invalid_argument(std::format("TemplateParameter<{}>", templateType));
 		}
 	}
-	else if (data->GetValue().substr(0, 3) == "$$B")
+	else if (data->StartsWith("$$B"))
 	{
 		/*
 		* $$B seems useless because it calls data_type with no changes,
@@ -1107,7 +1314,7 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 
 		result = GetDataType(data);
 	}
-	else if (data->GetValue()[0] == 'Y')
+	else if (data->Peek() == 'Y')
 	{
 		//Pointer to multidimensional array
 		data->Advance(1);
@@ -1115,6 +1322,9 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 		int dim = DecodeNumber(data);
 		std::vector<std::string> val;
 
+		//Every dimension takes at least one character
+		CheckSymbol(dim >= 0 && dim <= static_cast<int>(data->GetValue().length()), "Invalid array dimension");
+
 		for (int i = 0; i < dim; i++)
 		{
 			val.push_back(std::format("[{}]", DecodeNumber(data)));
@@ -1123,7 +1333,7 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 		result = GetDataType(data);
 		result = DataType(std::make_tuple(result.GetValue(), "", Join(val, "")), true);
 	}
-	else if (data->GetValue().substr(0, 2) == "_$")
+	else if (data->StartsWith("_$"))
 	{
 		//__w64 type
 		data->Advance(2);
@@ -1132,7 +1342,7 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 
 		result.Prepend("__w64 ");
 	}
-	else if (data->GetValue().substr(0, 2) == "_O")
+	else if (data->StartsWith("_O"))
 	{
 		//Array
 		int dimension = 1;
@@ -1146,7 +1356,7 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 			cv = " " + cv;
 		}
 
-		while (data->GetValue().substr(0, 2) == "_O")
+		while (data->StartsWith("_O"))
 		{
 			dimension += 1;
 
@@ -1166,17 +1376,26 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 	}
 	else
 	{
-		std::multimap<std::string, std::vector<std::string>> result2 = ParseValue(data, dataTypes);
-		std::string category = result2.begin()->first;
-		std::vector<std::string> result3 = result2.begin()->second;
+		DataTypeCode dataTypeCode = ParseValue(data, dataTypes);
+		std::vector<std::string> result3;
+
+		result3.emplace_back(dataTypeCode.name);
+
+		if (dataTypeCode.qualifier.length())
+		{
+			result3.emplace_back(dataTypeCode.qualifier);
+		}
 
-		if (category == "COMPLEX")
+		if (dataTypeCode.category == DataTypeCategory::complex)
 		{
 			data->Log("COMPLEX_TYPE");
 
 			if (result3[0] == "enum")
 			{
-				assert("int" == ParseValue(data, enumTypes));
+				//Only type 4 (int) is used by modern versions of Visual Studio but others are valid too
+				std::string_view enumType = ParseValue(data, enumTypes);
+
+				CheckSymbol(!enumType.empty(), "Unknown enum type");
 			}
 
 			result = DataType(std::make_tuple(result3[0], "", ""), false);
@@ -1189,7 +1408,7 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 
 			result.Add(" " + name);
 		}
-		else if (category == "MODIFIER")
+		else if (dataTypeCode.category == DataTypeCategory::modifier)
 		{
 			/*
 			* The type modifier is output in two parts, because the qualifier
@@ -1257,7 +1476,7 @@ DataType MSVCDemangler::GetDataType(DemangleData* data, int depth)
 		}
 		else
 		{
-			assert(category == "SIMPLE");
+			assert(dataTypeCode.category == DataTypeCategory::simple);
 
 			result = DataType(std::make_tuple(result3[0], "", ""), false);
 		}
@@ -1278,7 +1497,7 @@ void MSVCDemangler::FinalizeName(std::vector<std::string>& names, DataType& retu
 	if (names[0] == "?0")
 	{
 		//constructor
-		assert(names.size() >= 2);
+		CheckSymbol(names.size() >= 2, "Missing class name");
 
 		names[0] = names[1];
 		returnType.SetValue(std::make_tuple("", "", ""));
@@ -1286,7 +1505,7 @@ void MSVCDemangler::FinalizeName(std::vector<std::string>& names, DataType& retu
 	else if (names[0] == "?1")
 	{
 		//destructor
-		assert(names.size() >= 2);
+		CheckSymbol(names.size() >= 2, "Missing class name");
 
 		names[0] = '~' + names[1];
 		returnType.SetValue(std::make_tuple("", "", ""));
@@ -1297,19 +1516,22 @@ void MSVCDemangler::FinalizeName(std::vector<std::string>& names, DataType& retu
 		names[0] = "operator " + returnType.GetValue();
 		returnType.SetValue(std::make_tuple("", "", ""));
 	}
-	else if (std::string("?__E").find(names[0]) != std::string::npos ||
-		std::string("?__F").find(names[0]) != std::string::npos ||
-		std::string("?__K").find(names[0]) != std::string::npos)
+	else if (names[0] == "?__E" || names[0] == "?__F")
 	{
-		assert(names.size() >= 2);
+		CheckSymbol(names.size() >= 2, "Missing class name");
+
+		std::string_view description = names[0] == "?__E" ? "dynamic initializer for '" : "dynamic atexit destructor for '";
 
-		std::map<std::string, std::string> names2;
+		names[1] = quoteB + std::string(description) + names[1] + "'" + quoteE;
 
-		names2.insert(std::make_pair("?__E", quoteB + "dynamic initializer for '%s'" + quoteE));
-		names2.insert(std::make_pair("?__K", quoteB + "dynamic atexit destructor for '%s'" + quoteE));
-		names2.insert(std::make_pair("?__E", "operator "" %s"));
+		names.erase(names.begin());
+	}
+	else if (names[0] == "?__K")
+	{
+		//User defined literal
+		CheckSymbol(names.size() >= 2, "Missing class name");
 
-		names[1] = format(names2[names[0]], names[1]);
+		names[1] = "operator \"\" " + names[1];
 
 		names.erase(names.begin());
 	}
@@ -1319,7 +1541,7 @@ int MSVCDemangler::DecodeNumber(DemangleData* data)
 {
 	int sign;
 
-	if (data->GetValue()[0] == '?')
+	if (data->Peek() == '?')
 	{
 		sign = -1;
 
@@ -1330,65 +1552,55 @@ int MSVCDemangler::DecodeNumber(DemangleData* data)
 		sign = 1;
 	}
 
-	if (data->GetValue()[0] == '@')
+	if (data->Peek() == '@')
 	{
 		data->Advance(1);
 
 		return 0;
 	}
-	else if (std::string("0123456789").find(data->GetValue()[0]) != std::string::npos)
+	else if (std::string("0123456789").find(data->Peek()) != std::string::npos)
 	{
-		int val = 1 + static_cast<int>(data->GetValue()[0]) - '0';
+		int val = 1 + static_cast<int>(data->Peek()) - '0';
 
 		data->Advance(1);
 
 		return sign * val;
 	}
-	else if (data->GetValue().length() && std::string("ABCDEFGHIJKLMNOP").find(data->GetValue()[0]) != std::string::npos)
+	else if (data->GetValue().length() && std::string("ABCDEFGHIJKLMNOP").find(data->Peek()) != std::string::npos)
 	{
 		int i = 0;
 
-		while (data->GetValue().length() && data->GetValue()[0] != '@')
+		while (data->GetValue().length() && data->Peek() != '@')
 		{
+			CheckSymbol(data->Peek() >= 'A' && data->Peek() <= 'P' && i < 0x8000000, "Invalid number");
+
 			i *= 16;
-			i += static_cast<int>(data->GetValue()[0]) - static_cast<int>('A');
+			i += static_cast<int>(data->Peek()) - static_cast<int>('A');
 
 			data->Advance(1);
 		}
 
+		CheckSymbol(data->Peek() == '@', "Unexpected end of symbol");
 		data->Advance(1);
 
 		return sign * i;
 	}
 
-	return false;
+	CheckSymbol(false, "Invalid number");
+
+	return 0;
 }
 
 std::vector<std::string> MSVCDemangler::GetClassModifiers(DemangleData* data)
 {
 	std::vector<std::string> modifiers;
-	std::map<char, std::string> letters;
-
-	letters.insert(std::make_pair('E', "__ptr64"));
-	letters.insert(std::make_pair('F', "__unaligned"));
-	letters.insert(std::make_pair('I', "__restrict"));
 
-	while (data->GetValue().length() && std::string("EFI").find(data->GetValue()[0]) != std::string::npos)
+	while (pointerModifiers.Find(data->GetValue()))
 	{
-		modifiers.push_back(letters[data->GetValue()[0]]);
-
-		data->Advance(1);
+		modifiers.emplace_back(ParseValue(data, pointerModifiers));
 	}
 
-	std::map<std::string, std::string> cvTable;
-
-	cvTable.insert(std::make_pair("A", ""));
-	cvTable.insert(std::make_pair("B", "const"));
-	cvTable.insert(std::make_pair("C", "volatile"));
-	cvTable.insert(std::make_pair("D", "const volatile"));
-	cvTable.insert(std::make_pair("M2", "__based({})"));
-
-	std::string cv = ParseValue(data, cvTable);
+	std::string cv(ParseValue(data, cvModifiers));
 
 	if (cv == "__based({})")
 	{
@@ -1404,19 +1616,27 @@ std::vector<std::string> MSVCDemangler::GetClassModifiers(DemangleData* data)
 		reverse(names.begin(), names.end());
 
 		std::string name = Join(names, "::");
-		cv = format(cv, name);
+		cv = "__based(" + name + ")";
 	}
 
-	data->Log("CVC_MOD=%s %s", cv.c_str(), Join(modifiers, ","));
+	data->Log("CVC_MOD=%s %s", cv.c_str(), Join(modifiers, ",").c_str());
 
 	modifiers.insert(modifiers.begin(), cv);
 
 	return modifiers;
 }
 
-std::string MSVCDemangler::Join(const std::vector<std::string>& vector, std::string delimiter)
+std::string MSVCDemangler::Join(const std::vector<std::string>& vector, std::string_view delimiter)
 {
 	std::string result;
+	size_t length = 0;
+
+	for (const std::string& item : vector)
+	{
+		length += item.length() + delimiter.length();
+	}
+
+	result.reserve(length);
 
 	for (auto it = vector.begin(); it != vector.end(); it++)
 	{
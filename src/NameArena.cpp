@@ -0,0 +1,133 @@
+#include "NameArena.h"
+
+NameArena::NameArena()
+{
+	for (int i = 0; i < blockCount; i++)
+	{
+		blocks[i] = nullptr;
+	}
+
+	blocks[0] = new QString[blockSize];
+	count = 1;
+	requests = 0;
+	requestedSize = 0;
+	storedSize = 0;
+}
+
+NameArena::~NameArena()
+{
+	for (int i = 0; i < blockCount; i++)
+	{
+		delete[] blocks[i].load();
+	}
+}
+
+quint32 NameArena::Intern(const QString& name)
+{
+	if (name.isEmpty())
+	{
+		return 0;
+	}
+
+	return GetInstance().InternName(name);
+}
+
+/*
+* Returns copy of stored name which shares its data so strings which are kept in elements
+* and tables don't own separate copies of same name
+*/
+QString NameArena::InternString(const QString& name)
+{
+	if (name.isEmpty())
+	{
+		return name;
+	}
+
+	return GetName(GetInstance().InternName(name));
+}
+
+const QString& NameArena::GetName(quint32 id)
+{
+	NameArena& nameArena = GetInstance();
+
+	Q_ASSERT(id < nameArena.count.load(std::memory_order_acquire));
+
+	return nameArena.blocks[id >> blockBits].load(std::memory_order_acquire)[id & (blockSize - 1)];
+}
+
+NameArenaStatistics NameArena::GetStatistics()
+{
+	NameArena& nameArena = GetInstance();
+	QReadLocker locker(&nameArena.lock);
+	NameArenaStatistics statistics;
+
+	statistics.requests = nameArena.requests;
+	statistics.count = nameArena.count - 1;
+	statistics.requestedSize = nameArena.requestedSize;
+	statistics.storedSize = nameArena.storedSize;
+	statistics.dedupRatio = statistics.storedSize > 0 ? static_cast<double>(statistics.requestedSize) / statistics.storedSize : 1.0;
+
+	return statistics;
+}
+
+NameArena& NameArena::GetInstance()
+{
+	static NameArena nameArena;
+
+	return nameArena;
+}
+
+/*
+* Most names were already interned so lookup is done under read lock first,
+* write lock is taken only to add new name
+*/
+quint32 NameArena::InternName(const QString& name)
+{
+	qint64 size = static_cast<qint64>(name.length()) * sizeof(QChar);
+
+	{
+		QReadLocker locker(&lock);
+		auto it = ids.constFind(name);
+
+		if (it != ids.constEnd())
+		{
+			requests.fetch_add(1, std::memory_order_relaxed);
+			requestedSize.fetch_add(size, std::memory_order_relaxed);
+
+			return it.value();
+		}
+	}
+
+	QWriteLocker locker(&lock);
+	auto it = ids.constFind(name);
+
+	requests.fetch_add(1, std::memory_order_relaxed);
+	requestedSize.fetch_add(size, std::memory_order_relaxed);
+
+	if (it != ids.constEnd())
+	{
+		return it.value();
+	}
+
+	quint32 id = count.load(std::memory_order_relaxed);
+	int blockIndex = id >> blockBits;
+
+	Q_ASSERT(blockIndex < blockCount);
+
+	QString* block = blocks[blockIndex].load(std::memory_order_relaxed);
+
+	if (!block)
+	{
+		block = new QString[blockSize];
+
+		blocks[blockIndex].store(block, std::memory_order_release);
+	}
+
+	block[id & (blockSize - 1)] = name;
+	ids.insert(name, id);
+	storedSize += size;
+
+	count.store(id + 1, std::memory_order_release);
+
+	return id;
+}
@@ -39,6 +39,7 @@ OptionsDialog::OptionsDialog(QWidget* parent, Options* options, bool* optionsCha
     ui.rbGenerateOnlySource->setChecked(options->generateOnlySource);
     ui.rbGenerateBoth->setChecked(options->generateBoth);
     ui.chkExportDependencies->setChecked(options->exportDependencies);
+    ui.chkExportToSingleHeader->setChecked(options->exportToSingleHeader);
 
     ui.rbTrailingReturnType->setChecked(options->displayWithTrailingReturnType);
     ui.rbTypedef->setChecked(options->displayWithTypedef);
@@ -90,6 +91,9 @@ OptionsDialog::OptionsDialog(QWidget* parent, Options* options, bool* optionsCha
     ui.rbVariableSnakeCase->setChecked(options->variableSnakeCase);
     ui.chkRemoveHunNotFromVariable->setChecked(options->removeHungaryNotationFromVariable);
 
+    ui.spnElementCacheSize->setValue(options->elementCacheSize);
+    ui.spnExportThreadCount->setValue(options->exportThreadCount);
+
     connect(ui.btnOk, &QPushButton::clicked, this, &OptionsDialog::BtnOkClicked);
     connect(ui.btnCancel, &QPushButton::clicked, this, &OptionsDialog::BtnCancelClicked);
     connect(ui.chkModifyFunctionNames, &QCheckBox::clicked, this, &OptionsDialog::ChkModifyFunctionNamesClicked);
@@ -136,6 +140,7 @@ void OptionsDialog::BtnOkClicked()
     options->generateOnlySource = ui.rbGenerateOnlySource->isChecked();
     options->generateBoth = ui.rbGenerateBoth->isChecked();
     options->exportDependencies = ui.chkExportDependencies->isChecked();
+    options->exportToSingleHeader = ui.chkExportToSingleHeader->isChecked();
 
     options->displayWithTrailingReturnType = ui.rbTrailingReturnType->isChecked();
     options->displayWithTypedef = ui.rbTypedef->isChecked();
@@ -170,6 +175,9 @@ void OptionsDialog::BtnOkClicked()
     options->variableSnakeCase = ui.rbVariableSnakeCase->isChecked();
     options->removeHungaryNotationFromVariable = ui.chkRemoveHunNotFromVariable->isChecked();
 
+    options->elementCacheSize = ui.spnElementCacheSize->value();
+    options->exportThreadCount = ui.spnExportThreadCount->value();
+
     close();
 
     SaveOptions();
@@ -233,6 +241,7 @@ void OptionsDialog::LoadOptions(Options* options)
     options->generateOnlySource = settings.value("GenerateOnlySource").toBool();
     options->generateBoth = settings.value("GenerateBoth").toBool();
     options->exportDependencies = settings.value("ExportDependencies").toBool();
+    options->exportToSingleHeader = settings.value("ExportToSingleHeader").toBool();
 
     options->displayWithTrailingReturnType = settings.value("DisplayWithTrailingReturnType").toBool();
     options->displayWithTypedef = settings.value("DisplayWithTypedef").toBool();
@@ -266,6 +275,9 @@ void OptionsDialog::LoadOptions(Options* options)
     options->variablePascalCase = settings.value("VariablePascalCase").toBool();
     options->variableSnakeCase = settings.value("VariableSnakeCase").toBool();
     options->removeHungaryNotationFromVariable = settings.value("RemoveHungaryNotationFromVariable").toBool();
+
+    options->elementCacheSize = settings.value("ElementCacheSize", 256).toInt();
+    options->exportThreadCount = settings.value("ExportThreadCount", 0).toInt();
 }
 
 void OptionsDialog::SaveOptions()
@@ -304,6 +316,7 @@ void OptionsDialog::SaveOptions()
     settings.setValue("GenerateOnlySource", options->generateOnlySource);
     settings.setValue("GenerateBoth", options->generateBoth);
     settings.setValue("ExportDependencies", options->exportDependencies);
+    settings.setValue("ExportToSingleHeader", options->exportToSingleHeader);
 
     settings.setValue("DisplayWithTrailingReturnType", options->displayWithTrailingReturnType);
     settings.setValue("DisplayWithTypedef", options->displayWithTypedef);
@@ -337,6 +350,9 @@ void OptionsDialog::SaveOptions()
     settings.setValue("VariablePascalCase", options->variablePascalCase);
     settings.setValue("VariableSnakeCase", options->variableSnakeCase);
     settings.setValue("RemoveHungaryNotationFromVariable", options->removeHungaryNotationFromVariable);
+
+    settings.setValue("ElementCacheSize", options->elementCacheSize);
+    settings.setValue("ExportThreadCount", options->exportThreadCount);
 }
 
 void OptionsDialog::CheckIfOptionsChanged()
@@ -495,6 +511,11 @@ void OptionsDialog::CheckIfOptionsChanged()
         *optionsChanged = true;
     }
 
+    if (options->exportToSingleHeader != ui.chkExportToSingleHeader->isChecked() && !*optionsChanged)
+    {
+        *optionsChanged = true;
+    }
+
     if (options->displayWithTrailingReturnType != ui.rbTrailingReturnType->isChecked() && !*optionsChanged)
     {
         *optionsChanged = true;
@@ -3,12 +3,18 @@
 
 PDB::PDB(QObject* parent, Options* options, PEHeaderParser* peHeaderParser, QHash<QString, DWORD>* diaSymbols,
     std::vector<SymbolRecord>* symbolRecords, QHash<QString, DWORD>* variables, QHash<QString, DWORD>* functions,
-    QHash<QString, DWORD>* publicSymbols) : QObject(parent)
+    QHash<QString, DWORD>* publicSymbols) : QObject(parent), mainContext(options)
 {
     diaDataSource = nullptr;
     global = nullptr;
     diaSession = nullptr;
     processEnabled = false;
+    pdbInfoHeader = {};
+
+    for (int i = 0; i < static_cast<int>(SymbolIndexTable::count); i++)
+    {
+        importedTables[i] = false;
+    }
 
     this->options = options;
     this->peHeaderParser = peHeaderParser;
@@ -23,12 +29,7 @@ PDB::PDB(QObject* parent, Options* options, PEHeaderParser* peHeaderParser, QHas
     interfacesCount = 0;
     unionsCount = 0;
     enumsCount = 0;
-    vTableIndex = 0;
-    destructorAdded = false;
-    hasVirtualDestructor = false;
     isTypeImported = false;
-    isMainUDT = false;
-    belongsToMainUDT = false;
 
     baseTypes.insert("void", 0);
     baseTypes.insert("char", 0);
@@ -77,33 +78,69 @@ PDB::PDB(QObject* parent, Options* options, PEHeaderParser* peHeaderParser, QHas
     baseTypes2.insert("unsigned __int32", "unsigned int");
     baseTypes2.insert("unsigned __int64", "unsigned long long");
 
-    msvcDemangler = MSVCDemangler();
-
     setParent(parent);
 }
 
 PDB::~PDB()
 {
-    if (diaDataSource)
-    {
-        diaDataSource->Release();
-    }
+    CloseSession();
 
+    CoUninitialize();
+}
+
+void PDB::CloseSession()
+{
     if (global)
     {
         global->Release();
+        global = nullptr;
     }
 
     if (diaSession)
     {
         diaSession->Release();
+        diaSession = nullptr;
     }
 
-    CoUninitialize();
+    if (diaDataSource)
+    {
+        diaDataSource->Release();
+        diaDataSource = nullptr;
+    }
+
+    typeIndexIDsMutex.lock();
+    typeIndexIDs.clear();
+    typeIndexIDsMutex.unlock();
+
+    symbolLocatorsMutex.lock();
+    symbolLocators.clear();
+    symbolLocatorsMutex.unlock();
+
+    for (int i = 0; i < static_cast<int>(SymbolIndexTable::count); i++)
+    {
+        importedTables[i] = false;
+    }
+
+    tpiStream.Clear();
+    msfFile.Close();
+    pdbInfoHeader = {};
+
+    SymbolDemangler::Clear();
 }
 
 bool PDB::ReadFromFile(const QString& filePath)
 {
+    CloseSession();
+
+    /*
+    * Native reader is opened first, it only maps the file and parses MSF directory
+    * so it doesn't depend on size of PDB. Old PDB files (MSF 2.00) are still handled by DIA.
+    */
+    if (!OpenMSFFile(filePath))
+    {
+        emit SendStatusMessage(QString("Native PDB reader: %1").arg(msfFile.GetErrorMessage()));
+    }
+
     HRESULT hr = CoInitialize(nullptr);
 
     hr = CoCreateInstance(__uuidof(DiaSource), nullptr, CLSCTX_INPROC_SERVER, __uuidof(IDiaDataSource),
@@ -153,889 +190,937 @@ bool PDB::ReadFromFile(const QString& filePath)
     return true;
 }
 
+bool PDB::OpenMSFFile(const QString& filePath)
+{
+    if (!msfFile.Open(filePath))
+    {
+        return false;
+    }
+
+    if (!msfFile.GetPDBInfo(&pdbInfoHeader))
+    {
+        pdbInfoHeader = {};
+    }
+
+    //Type names are resolved through TPI hash table, DIA is used only if TPI stream is missing
+    if (!tpiStream.Load(&msfFile))
+    {
+        emit SendStatusMessage(QString("Native PDB reader: %1").arg(tpiStream.GetErrorMessage()));
+    }
+
+    return true;
+}
+
+const MSFFile* PDB::GetMSFFile() const
+{
+    return &msfFile;
+}
+
+const PDBInfoHeader& PDB::GetPDBInfoHeader() const
+{
+    return pdbInfoHeader;
+}
+
+const TPIStream* PDB::GetTPIStream() const
+{
+    return &tpiStream;
+}
+
 void PDB::SetMachineType(CV_CPU_TYPE_e type)
 {
     this->type = type;
 }
 
-void PDB::LoadPDBData()
+/*
+* All tables are filled in one sweep over global scope, types are decoded from TPI stream
+* before the sweep if it's available and then UDTs and enums are skipped during the sweep
+*/
+void PDB::ImportSymbols()
 {
     processEnabled = true;
 
     diaSymbols->clear();
     symbolRecords->clear();
+    variables->clear();
+    functions->clear();
+    publicSymbols->clear();
+
+    classesCount = 0;
+    structsCount = 0;
+    interfacesCount = 0;
+    unionsCount = 0;
+    enumsCount = 0;
 
-    IDiaEnumSymbols* udtSymbols;
     IDiaEnumSymbols* enumSymbols;
-    LONG udtCount;
-    LONG enumCount;
-    LONG count;
+    LONG count = 0;
 
-    if (global->findChildren(SymTagUDT, nullptr, nsNone, &udtSymbols) != S_OK ||
-        global->findChildren(SymTagEnum, nullptr, nsNone, &enumSymbols) != S_OK)
+    if (!global || global->findChildren(SymTagNull, nullptr, nsNone, &enumSymbols) != S_OK)
     {
-        return;
-    }
+        emit Completed();
 
-    if (udtSymbols->get_Count(&udtCount) != S_OK || !udtCount ||
-        enumSymbols->get_Count(&enumCount) != S_OK || !enumCount)
-    {
         return;
     }
 
-    count = udtCount + enumCount;
+    enumSymbols->get_Count(&count);
+
+    bool importTypesFromTPI = tpiStream.IsLoaded();
+    int chunkCount = importTypesFromTPI ? (tpiStream.GetRecordCount() + tpiChunkSize - 1) / tpiChunkSize : 0;
+    int total = chunkCount + count;
 
     emit SetProgressMinimum(0);
-    emit SetProgressMaximum(count);
+    emit SetProgressMaximum(total);
 
     int currentIndex = 0;
     int currentProcent = 0;
-    int procent = count / 100;
+    int procent = total / 100;
+
+    if (importTypesFromTPI)
+    {
+        LoadTypesFromTPI(&currentIndex);
+    }
 
-    GetSymbolsFromTable(udtSymbols, &currentIndex, &currentProcent, &procent);
-    GetSymbolsFromTable(enumSymbols, &currentIndex, &currentProcent, &procent);
+    if (processEnabled)
+    {
+        GetSymbolsFromTable(enumSymbols, &currentIndex, &currentProcent, &procent, !importTypesFromTPI);
+    }
 
-    udtSymbols->Release();
     enumSymbols->Release();
 
+    //Names of data and functions are compared with names of types when all types are known
+    for (auto it = variables->begin(); it != variables->end();)
+    {
+        it = diaSymbols->contains(it.key()) ? variables->erase(it) : it + 1;
+    }
+
+    for (auto it = functions->begin(); it != functions->end();)
+    {
+        it = diaSymbols->contains(it.key()) ? functions->erase(it) : it + 1;
+    }
+
+    if (processEnabled)
+    {
+        for (int i = 0; i < static_cast<int>(SymbolIndexTable::count); i++)
+        {
+            importedTables[i] = true;
+        }
+
+        SaveSymbolIndex();
+    }
+
     emit Completed();
 }
 
-/*
-* If object of class / struct is not created anywhere in code but they were created for inner types
-* then only members will be displayed - type_name::member_name (type_name won't be displayed)
-* If Multi-processor Compilation is enabled then classes/structs which are not used will also appear
-* If namespaces are used they also won't be displayed
-*/
-void PDB::GetSymbolsFromTable(IDiaEnumSymbols* enumSymbols, int* currentIndex, int* currentProcent, int* procent)
+struct TPIImportChunk
 {
-    IDiaSymbol* symbol;
-    ULONG celt = 0;
+    int begin;
+    int end;
+    QVector<TPIUDTRecord> udtRecords;
+};
 
-    while (SUCCEEDED(enumSymbols->Next(1, &symbol, &celt)) && (celt == 1) && processEnabled)
+static void DecodeTPIChunk(const TPIStream* tpiStream, bool displayEmptyUDTAndEnums, const bool* processEnabled, TPIImportChunk* chunk)
+{
+    quint32 typeIndexBegin = tpiStream->GetTypeIndexBegin();
+    TPIRecord record;
+
+    //Only first record of chunk is looked up, other records follow it
+    if (!tpiStream->GetRecord(typeIndexBegin + chunk->begin, &record))
     {
-        SymbolRecord symbolRecord = {};
-        BSTR bstring;
-        DWORD symTag = 0;
+        return;
+    }
 
-        symbol->get_symTag(&symTag);
+    for (int i = chunk->begin; i < chunk->end && *processEnabled; i++)
+    {
+        TPIUDTRecord udtRecord;
+        const char* name;
+        int length;
 
-        if (symTag == SymTagUDT)
+        if (i > chunk->begin && !tpiStream->GetNextRecord(record, &record))
         {
-            DWORD parentClass = 0;
+            break;
+        }
 
-            symbol->get_classParentId(&parentClass);
+        if (!TPIStream::IsUDTLeaf(record.kind) ||
+            !TPIStream::DecodeUDTRecord(record, &udtRecord, false) ||
+            !TPIStream::GetUDTRecordName(record, &name, &length))
+        {
+            continue;
+        }
 
-            if (parentClass == 0)
+        if (udtRecord.property & propertyIsNested)
+        {
+            continue;
+        }
+
+        QByteArray typeName = QByteArray::fromRawData(name, length);
+
+        /*
+        * Forward reference is imported only if there is no definition of that type. Name comes from TPI record
+        * and every UDT record is in hash table, including scoped and nested ones, so definition is always found.
+        */
+        if (udtRecord.property & propertyForwardReference)
+        {
+            if (!displayEmptyUDTAndEnums || tpiStream->FindTypeIndex(typeName))
             {
-                if (symbol->get_name(&bstring) == S_OK)
-                {
-                    symbolRecord.typeName = QString::fromWCharArray(bstring);
+                continue;
+            }
 
-                    SysFreeString(bstring);
-                }
+            udtRecord.size = 0;
+        }
+        else if (udtRecord.kind == LF_ENUM)
+        {
+            udtRecord.size = 1;
+        }
 
-                ULONGLONG length;
+        if (udtRecord.size == 0 && !displayEmptyUDTAndEnums || typeName.contains("::__cta"))
+        {
+            continue;
+        }
 
-                symbol->get_length(&length);
+        udtRecord.name = QString::fromUtf8(name, length);
+        chunk->udtRecords.append(udtRecord);
+    }
+}
 
-                if ((length == 0 && options->displayEmptyUDTAndEnums || length > 0) &&
-                    !diaSymbols->contains(symbolRecord.typeName) &&
-                    !symbolRecord.typeName.contains("::__cta"))
-                {
-                    DWORD kind = 0;
-                    symbol->get_udtKind(&kind);
+/*
+* Type records are decoded directly from TPI stream on all cores, every chunk is decoded independently
+* and results are merged in order of type indices so result doesn't depend on number of threads.
+* DIA symbol of each type is looked up only when it's needed (see GetSymbolByTypeIndex)
+*/
+void PDB::LoadTypesFromTPI(int* currentIndex)
+{
+    int recordCount = tpiStream.GetRecordCount();
+    int chunkCount = (recordCount + tpiChunkSize - 1) / tpiChunkSize;
+    QVector<TPIImportChunk> chunks(chunkCount);
+    QThreadPool threadPool;
+    QAtomicInt completedChunks = 0;
+    bool displayEmptyUDTAndEnums = options->displayEmptyUDTAndEnums;
 
-                    UdtKind udtKind = (UdtKind)kind;
+    for (int i = 0; i < chunkCount; i++)
+    {
+        TPIImportChunk* chunk = &chunks[i];
 
-                    symbol->get_symIndexId(&symbolRecord.id);
+        chunk->begin = i * tpiChunkSize;
+        chunk->end = qMin(chunk->begin + tpiChunkSize, recordCount);
 
-                    if (udtKind == UdtStruct)
-                    {
-                        symbolRecord.type = SymbolType::structType;
+        threadPool.start([this, chunk, displayEmptyUDTAndEnums, &completedChunks]()
+        {
+            DecodeTPIChunk(&tpiStream, displayEmptyUDTAndEnums, &processEnabled, chunk);
+            completedChunks.fetchAndAddRelaxed(1);
+        });
+    }
 
-                        structsCount++;
-                    }
-                    else if (udtKind == UdtClass)
-                    {
-                        symbolRecord.type = SymbolType::classType;
+    while (!threadPool.waitForDone(50))
+    {
+        emit SetProgressValue(*currentIndex + completedChunks.loadRelaxed());
+    }
 
-                        classesCount++;
-                    }
-                    else if (udtKind == UdtUnion)
-                    {
-                        symbolRecord.type = SymbolType::unionType;
+    *currentIndex += chunkCount;
 
-                        unionsCount++;
-                    }
-                    else if (udtKind == UdtInterface)
-                    {
-                        symbolRecord.type = SymbolType::interfaceType;
+    emit SetProgressValue(*currentIndex);
 
-                        interfacesCount++;
-                    }
+    if (!processEnabled)
+    {
+        return;
+    }
 
-                    symbolRecords->push_back(symbolRecord);
-                    diaSymbols->insert(symbolRecord.typeName, symbolRecord.id);
-                }
-            }
-        }
-        else if (symTag == SymTagEnum)
+    //Enums are merged after UDTs, the same as when symbols are enumerated through DIA
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; i < chunkCount; i++)
         {
-            DWORD dwParentClass = 0;
+            const QVector<TPIUDTRecord>& udtRecords = chunks.at(i).udtRecords;
+            int count = udtRecords.count();
 
-            symbol->get_classParentId(&dwParentClass);
-
-            if (dwParentClass == 0)
+            for (int j = 0; j < count; j++)
             {
-                if (symbol->get_name(&bstring) == S_OK)
-                {
-                    symbolRecord.typeName = QString::fromWCharArray(bstring);
+                const TPIUDTRecord& udtRecord = udtRecords.at(j);
 
-                    SysFreeString(bstring);
+                if ((udtRecord.kind == LF_ENUM) != (pass == 1) || diaSymbols->contains(udtRecord.name))
+                {
+                    continue;
                 }
 
-                ULONGLONG length;
-
-                symbol->get_length(&length);
-
-                if ((length == 0 && options->displayEmptyUDTAndEnums || length > 0) &&
-                    !diaSymbols->contains(symbolRecord.typeName))
-                {
-                    symbol->get_symIndexId(&symbolRecord.id);
-                    symbolRecord.type = SymbolType::enumType;
+                SymbolRecord symbolRecord;
 
-                    symbolRecords->push_back(symbolRecord);
-                    diaSymbols->insert(symbolRecord.typeName, symbolRecord.id);
+                symbolRecord.id = udtRecord.typeIndex | typeIndexFlag;
+                symbolRecord.typeName = udtRecord.name;
+                symbolRecord.type = GetSymbolTypeFromLeaf(udtRecord.kind);
 
-                    enumsCount++;
-                }
+                AddSymbolRecord(symbolRecord);
             }
         }
-        else if (symTag == SymTagData)
-        {
-            if (symbol->get_name(&bstring) == S_OK)
-            {
-                QString name = QString::fromWCharArray(bstring);
+    }
+}
 
-                SysFreeString(bstring);
+void PDB::AddSymbolRecord(const SymbolRecord& symbolRecord)
+{
+    switch (symbolRecord.type)
+    {
+    case SymbolType::structType:
+        structsCount++;
+        break;
+    case SymbolType::classType:
+        classesCount++;
+        break;
+    case SymbolType::unionType:
+        unionsCount++;
+        break;
+    case SymbolType::interfaceType:
+        interfacesCount++;
+        break;
+    case SymbolType::enumType:
+        enumsCount++;
+        break;
+    }
 
-                DWORD kind;
-                DataKind dataKind;
+    //Name is interned so symbol record, key and elements of this type share same string
+    symbolRecords->push_back(symbolRecord);
+    symbolRecords->back().typeName = NameArena::InternString(symbolRecord.typeName);
+    diaSymbols->insert(symbolRecords->back().typeName, symbolRecord.id);
+}
 
-                symbol->get_dataKind(&kind);
-                dataKind = static_cast<DataKind>(kind);
+/*
+* DIA assigns symbol IDs when symbols are loaded so they are different in every session,
+* locator (symbol tag, RVA and name) is stored instead and it's used to find symbol again
+*/
+void PDB::AddSymbolLocator(QHash<QString, DWORD>* table, IDiaSymbol* symbol, DWORD symTag, const QString& name, quint32 attributes)
+{
+    SymbolLocator symbolLocator = GetSymbolLocator(symbol, symTag, attributes);
 
-                if (!name.startsWith("$") &&
-                    !diaSymbols->contains(name) &&
-                    (dataKind == DataIsFileStatic ||
-                        dataKind == DataIsGlobal ||
-                        dataKind == DataIsMember ||
-                        dataKind == DataIsStaticMember ||
-                        dataKind == DataIsConstant))
-                {
-                    DWORD id;
+    symbolLocator.nameID = NameArena::Intern(name);
 
-                    symbol->get_symIndexId(&id);
+    AddSymbolLocator(table, symbolLocator);
+}
 
-                    variables->insert(name, id);
-                }
-            }
-        }
-        else if (symTag == SymTagFunction)
-        {
-            if (symbol->get_name(&bstring) == S_OK)
-            {
-                QString name = QString::fromWCharArray(bstring);
+SymbolLocator PDB::GetSymbolLocator(IDiaSymbol* symbol, DWORD symTag, quint32 attributes)
+{
+    SymbolLocator symbolLocator;
 
-                SysFreeString(bstring);
+    symbolLocator.symTag = symTag;
+    symbolLocator.relativeVirtualAddress = 0;
+    symbolLocator.nameID = 0;
+    symbolLocator.id = 0;
+    symbolLocator.attributes = attributes;
 
-                if (!diaSymbols->contains(name))
-                {
-                    DWORD id;
+    symbol->get_relativeVirtualAddress(&symbolLocator.relativeVirtualAddress);
+    symbol->get_symIndexId(&symbolLocator.id);
 
-                    symbol->get_symIndexId(&id);
-                    functions->insert(name, id);
-                }
-            }
-        }
-        else if (symTag == SymTagPublicSymbol)
-        {
-            DWORD id;
+    return symbolLocator;
+}
 
-            symbol->get_symIndexId(&id);
+void PDB::AddSymbolLocator(QHash<QString, DWORD>* table, const SymbolLocator& symbolLocator)
+{
+    symbolLocatorsMutex.lock();
 
-			/*if (symbol->get_name(&bstring) == S_OK)
-			{
-				QString mangledName = QString::fromWCharArray(bstring);
-
-				SysFreeString(bstring);
-
-				publicSymbols2->insert(id, mangledName);
-			}*/
-
-            QString demangledName;
-
-            if (options->useUndname)
-            {
-				if (symbol->get_undecoratedName(&bstring) == S_OK)
-				{
-					demangledName = QString::fromWCharArray(bstring);
-
-					SysFreeString(bstring);
-				}
-            }
-            else
-            {
-				if (symbol->get_name(&bstring) == S_OK)
-				{
-                    std::string mangledName = QString::fromWCharArray(bstring).toStdString();
-                    std::string rest;
-
-                    demangledName = QString::fromStdString(msvcDemangler.DemangleSymbol(mangledName, rest));
-
-                    SysFreeString(bstring);
-				}
-            }
-
-            publicSymbols->insert(demangledName, id);
-        }
+    DWORD index = symbolLocators.count();
 
-        symbol->Release();
+    symbolLocators.append(symbolLocator);
 
-        if (*currentIndex > *currentProcent * *procent)
-        {
-            ++*currentProcent;
-            emit SetProgressValue(*currentIndex);
-        }
+    symbolLocatorsMutex.unlock();
 
-        ++*currentIndex;
-    }
+    //Key shares its data with name in arena
+    table->insert(NameArena::GetName(symbolLocator.nameID), index | symbolLocatorFlag);
 }
 
-int PDB::GetCountOfClasses()
+quint32 PDB::GetSymbolAttributes(DWORD id)
 {
-    return classesCount;
-}
+    if (!(id & symbolLocatorFlag))
+    {
+        return 0;
+    }
 
-int PDB::GetCountOfStructs()
-{
-    return structsCount;
-}
+    int index = id & ~symbolLocatorFlag;
+    quint32 attributes = 0;
 
-int PDB::GetCountOfInterfaces()
-{
-    return interfacesCount;
-}
+    symbolLocatorsMutex.lock();
 
-int PDB::GetCountOfUnions()
-{
-    return unionsCount;
-}
+    if (index < symbolLocators.count())
+    {
+        attributes = symbolLocators.at(index).attributes;
+    }
 
-int PDB::GetCountOfEnums()
-{
-    return enumsCount;
-}
+    symbolLocatorsMutex.unlock();
 
-void PDB::Stop()
-{
-    processEnabled = false;
+    return attributes;
 }
 
-UDT PDB::GetUDT(IDiaSymbol* symbol)
+quint32 PDB::GetImportOptions()
 {
-    UDT udt = {};
-    BSTR bString = nullptr;
-    DWORD udtKind = 0, access = 0, symIndexID = 0, parentClassID = 0;
-    ULONGLONG length = 0;
-    BOOL isNested = 0, isConst = 0, isVolatile = 0, hasCastOperator = 0;
-    IDiaSymbol* parentClass;
+    quint32 importOptions = 0;
 
-    if (symbol->get_name(&bString) == S_OK)
+    if (options->displayEmptyUDTAndEnums)
     {
-        udt.name = QString::fromWCharArray(bString);
-        udt.originalTypeName = udt.name;
-
-        SysFreeString(bString);
+        importOptions |= 1;
     }
 
-    if (symbol->get_udtKind(&udtKind) == S_OK)
+    if (options->useUndname)
     {
-        udt.udtKind = static_cast<UdtKind>(udtKind);
-
-        switch (udt.udtKind)
-        {
-        case UdtStruct:
-            udt.type = "struct";
-            break;
-        case UdtClass:
-            udt.type = "class";
-            break;
-        case UdtUnion:
-            udt.type = "union";
-            break;
-        case UdtInterface:
-            udt.type = "interface";
-            break;
-        }
+        importOptions |= 2;
     }
 
-    if (symbol->get_length(&length) == S_OK)
-    {
-        udt.length = length;
-    }
+    return importOptions;
+}
 
-    if (symbol->get_constType(&isConst) == S_OK)
+/*
+* Tables which were imported earlier are loaded from index file if GUID and age of PDB file
+* are the same, symbol records can be loaded only if types are imported from TPI stream
+* since IDs of types which are imported through DIA are valid only in current session
+*/
+bool PDB::LoadSymbolIndex()
+{
+    diaSymbols->clear();
+    symbolRecords->clear();
+    variables->clear();
+    functions->clear();
+    publicSymbols->clear();
+
+    if (pdbInfoHeader.guid.isNull())
     {
-        udt.isConst = isConst;
+        return false;
     }
 
-    if (symbol->get_volatileType(&isVolatile) == S_OK)
+    SymbolIndex symbolIndex;
+
+    if (!symbolIndex.Open(SymbolIndex::GetFilePath(pdbInfoHeader), pdbInfoHeader, GetImportOptions()))
     {
-        udt.isVolatile = isVolatile;
+        return false;
     }
 
-    if (symbol->get_classParent(&parentClass) == S_OK)
+    if (symbolIndex.HasTable(SymbolIndexTable::symbolRecords))
     {
-        if (parentClass->get_name(&bString) == S_OK)
-        {
-            udt.parentClassName = QString::fromWCharArray(bString);
+        const SymbolIndexRecord* records = symbolIndex.GetRecords(SymbolIndexTable::symbolRecords);
+        int count = symbolIndex.GetRecordCount(SymbolIndexTable::symbolRecords);
+        bool hasTypeIndices = false;
 
-            SysFreeString(bString);
-        }
+        classesCount = 0;
+        structsCount = 0;
+        interfacesCount = 0;
+        unionsCount = 0;
+        enumsCount = 0;
 
-        parentClass->Release();
-    }
+        symbolRecords->reserve(count);
+        diaSymbols->reserve(count);
 
-    if (symbol->get_nested(&isNested) == S_OK)
-    {
-        udt.isNested = isNested;
-    }
+        for (int i = 0; i < count; i++)
+        {
+            SymbolRecord symbolRecord;
 
-    IDiaSymbol* unmodifiedType;
+            symbolRecord.id = records[i].value1;
+            symbolRecord.typeName = symbolIndex.GetName(records[i]);
+            symbolRecord.type = static_cast<SymbolType>(records[i].value2);
 
-    if (symbol->get_unmodifiedType(&unmodifiedType) == S_OK)
-    {
-        IDiaSymbol* vTableShape;
+            //Types which were imported from DIA SDK don't have type index, they are found by name when they are used
+            if (!symbolRecord.id)
+            {
+                SymbolLocator symbolLocator = {};
 
-        if (unmodifiedType->get_virtualTableShape(&vTableShape) == S_OK)
-        {
-            DWORD count;
+                symbolLocator.symTag = symbolRecord.type == SymbolType::enumType ? SymTagEnum : SymTagUDT;
+                symbolLocator.nameID = NameArena::Intern(symbolRecord.typeName);
 
-            if (vTableShape->get_count(&count) == S_OK)
+                symbolLocatorsMutex.lock();
+                symbolRecord.id = symbolLocators.count() | symbolLocatorFlag;
+                symbolLocators.append(symbolLocator);
+                symbolLocatorsMutex.unlock();
+            }
+            else
             {
-                udt.countOfVirtualFunctions = count;
+                hasTypeIndices = true;
             }
 
-            vTableShape->Release();
+            AddSymbolRecord(symbolRecord);
         }
 
-        unmodifiedType->Release();
+        //Type indices can be resolved only through TPI stream
+        importedTables[static_cast<int>(SymbolIndexTable::symbolRecords)] = !hasTypeIndices || tpiStream.IsLoaded();
     }
 
-    if (symbol->get_hasCastOperator(&hasCastOperator) == S_OK)
-    {
-        udt.hasCastOperator = hasCastOperator;
-    }
+    QHash<QString, DWORD>* tables[] = { variables, functions, publicSymbols };
+    SymbolIndexTable tableTypes[] = { SymbolIndexTable::variables, SymbolIndexTable::functions, SymbolIndexTable::publicSymbols };
 
-    if (udt.name.contains("<unnamed"))
-    {
-        udt.isUnnamed = true;
-    }
+    symbolLocatorsMutex.lock();
 
-    //Sometimes DIA SDK won't undecorate name
-    if (udt.name.at(0) == '?')
+    for (int i = 0; i < 3; i++)
     {
-        if (options->useUndname)
+        if (!tables[i] || !symbolIndex.HasTable(tableTypes[i]))
         {
-            std::string undecoratedName = peHeaderParser->UndecorateName(udt.name.toStdString().c_str());
-
-            udt.name = QString::fromStdString(undecoratedName);
+            continue;
         }
-        else
+
+        const SymbolIndexRecord* records = symbolIndex.GetRecords(tableTypes[i]);
+        int count = symbolIndex.GetRecordCount(tableTypes[i]);
+
+        tables[i]->reserve(count);
+
+        for (int j = 0; j < count; j++)
         {
-            std::string mangledName = udt.name.toStdString().c_str();
-            std::string rest;
+            SymbolLocator symbolLocator;
+
+            symbolLocator.symTag = records[j].value1;
+            symbolLocator.relativeVirtualAddress = records[j].value2;
+            symbolLocator.nameID = NameArena::Intern(symbolIndex.GetName(records[j]));
+            symbolLocator.id = 0;
+            symbolLocator.attributes = records[j].value3;
 
-            udt.name = QString::fromStdString(msvcDemangler.DemangleSymbol(mangledName, rest));
+            tables[i]->insert(NameArena::GetName(symbolLocator.nameID), symbolLocators.count() | symbolLocatorFlag);
+            symbolLocators.append(symbolLocator);
         }
+
+        importedTables[static_cast<int>(tableTypes[i])] = true;
     }
 
-    FormatString(udt.name);
-    FormatString(udt.parentClassName);
+    symbolLocatorsMutex.unlock();
 
-    //Type of access specifier is not available for udts
-    udt.access = CV_access_e::CV_public;
+    //All tables are imported together so index is used only if it contains all of them
+    for (int i = 0; i < static_cast<int>(SymbolIndexTable::count); i++)
+    {
+        if (!importedTables[i])
+        {
+            diaSymbols->clear();
+            symbolRecords->clear();
+            variables->clear();
+            functions->clear();
+            publicSymbols->clear();
 
-    return udt;
+            return false;
+        }
+    }
+
+    return true;
 }
 
-Function PDB::GetFunction(IDiaSymbol* symbol)
+bool PDB::SaveSymbolIndex()
 {
-    Function function = {};
-    BSTR bString = nullptr;
-    DWORD access = 0, addressSection = 0, relativeVirtualAddress = 0, virtualBaseOffset = 0, callingConvention = 0;
-    ULONGLONG length = 0, virtualAddress = 0;
-    BOOL isCompilerGenerated = 0, isNaked = 0, isStatic = 0, isNoInline = 0, isNotReached = 0;
-    BOOL isNoReturn = 0, isPure = 0, isConst = 0, isVolatile = 0, isVirtual = 0, isIntroVirtual = 0, hasCustomCallingConvention = 0;
-    BOOL hasAlloca = 0, hasEH = 0, hasEHa = 0, hasInlAsm = 0, hasLongJump = 0, hasSecurityChecks = 0, hasSEH = 0, hasSetJump = 0;
-    BOOL hasInlSpec = 0, hasOptimizedCodeDebugInfo = 0, farReturn = 0, interruptReturn = 0, noStackOrdering = 0;
-    IDiaSymbol* parentClass;
-
-    if (symbol->get_access(&access) == S_OK)
+    if (pdbInfoHeader.guid.isNull())
     {
-        function.access = static_cast<CV_access_e>(access);
+        return false;
     }
 
-    if (symbol->get_addressSection(&addressSection) == S_OK)
-    {
-        function.addressSection = addressSection;
-    }
+    const int tableCount = static_cast<int>(SymbolIndexTable::count);
+    QVector<SymbolIndexEntry> tables[tableCount];
+    bool hasTables[tableCount];
 
-    if (symbol->get_compilerGenerated(&isCompilerGenerated) == S_OK)
+    for (int i = 0; i < tableCount; i++)
     {
-        function.isCompilerGenerated = isCompilerGenerated;
+        hasTables[i] = importedTables[i];
     }
 
-    if (symbol->get_isNaked(&isNaked) == S_OK)
+    if (hasTables[static_cast<int>(SymbolIndexTable::symbolRecords)])
     {
-        function.isNaked = isNaked;
-    }
+        QVector<SymbolIndexEntry>& entries = tables[static_cast<int>(SymbolIndexTable::symbolRecords)];
+        size_t count = symbolRecords->size();
 
-    if (symbol->get_isStatic(&isStatic) == S_OK)
-    {
-        function.isStatic = isStatic;
-    }
+        entries.reserve(static_cast<int>(count));
 
-    if (symbol->get_noInline(&isNoInline) == S_OK)
-    {
-        function.isNoInline = isNoInline;
-    }
+        /*
+        * IDs of DIA SDK aren't stable between sessions so types which were imported from DIA SDK are stored
+        * without ID and they are found by name after index is loaded, type indices from TPI stream are kept
+        */
+        for (size_t i = 0; i < count; i++)
+        {
+            const SymbolRecord& symbolRecord = symbolRecords->at(i);
+            DWORD id = symbolRecord.id & typeIndexFlag ? symbolRecord.id : 0;
 
-    if (symbol->get_notReached(&isNotReached) == S_OK)
-    {
-        function.isNotReached = isNotReached;
+            entries.append({ symbolRecord.typeName, id, static_cast<quint32>(symbolRecord.type), 0 });
+        }
     }
 
-    if (symbol->get_noReturn(&isNoReturn) == S_OK)
-    {
-        function.isNoReturn = isNoReturn;
-    }
+    QHash<QString, DWORD>* tables2[] = { variables, functions, publicSymbols };
+    SymbolIndexTable tableTypes[] = { SymbolIndexTable::variables, SymbolIndexTable::functions, SymbolIndexTable::publicSymbols };
 
-    if (symbol->get_length(&length) == S_OK)
-    {
-        function.length = length;
-    }
+    symbolLocatorsMutex.lock();
 
-    if (symbol->get_name(&bString) == S_OK)
+    for (int i = 0; i < 3; i++)
     {
-        function.name = QString::fromWCharArray(bString);
-        SysFreeString(bString);
-    }
+        int tableIndex = static_cast<int>(tableTypes[i]);
 
-    if (symbol->get_pure(&isPure) == S_OK)
-    {
-        function.isPure = isPure;
-    }
+        if (!tables2[i] || !hasTables[tableIndex])
+        {
+            hasTables[tableIndex] = false;
 
-    if (symbol->get_virtualAddress(&virtualAddress) == S_OK)
-    {
-        function.virtualAddress = virtualAddress;
-    }
+            continue;
+        }
 
-    if (symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
-    {
-        function.relativeVirtualAddress = relativeVirtualAddress;
-    }
+        QVector<SymbolIndexEntry>& entries = tables[tableIndex];
 
-    if (symbol->get_virtual(&isVirtual) == S_OK)
-    {
-        function.isVirtual = isVirtual;
-    }
+        entries.reserve(tables2[i]->count());
 
-    if (symbol->get_virtualBaseOffset(&virtualBaseOffset) == S_OK)
-    {
-        function.virtualBaseOffset = virtualBaseOffset;
+        for (auto it = tables2[i]->constBegin(); it != tables2[i]->constEnd(); it++)
+        {
+            const SymbolLocator& symbolLocator = symbolLocators.at(it.value() & ~symbolLocatorFlag);
+
+            entries.append({ it.key(), symbolLocator.symTag, symbolLocator.relativeVirtualAddress, symbolLocator.attributes });
+        }
     }
 
-    if (symbol->get_intro(&isIntroVirtual) == S_OK)
+    symbolLocatorsMutex.unlock();
+
+    if (!SymbolIndex::Write(SymbolIndex::GetFilePath(pdbInfoHeader), pdbInfoHeader, GetImportOptions(), tables, hasTables))
     {
-        function.isIntroVirtual = isIntroVirtual;
+        emit SendStatusMessageToProcessDialog("Can't save symbol index.");
+
+        return false;
     }
 
-    if (symbol->get_customCallingConvention(&hasCustomCallingConvention) == S_OK)
-    {
-        function.hasCustomCallingConvention = hasCustomCallingConvention;
-    }
+    return true;
+}
 
-    if (symbol->get_hasAlloca(&hasAlloca) == S_OK)
-    {
-        function.hasAlloca = hasAlloca;
-    }
+/*
+* If object of class / struct is not created anywhere in code but they were created for inner types
+* then only members will be displayed - type_name::member_name (type_name won't be displayed)
+* If Multi-processor Compilation is enabled then classes/structs which are not used will also appear
+* If namespaces are used they also won't be displayed
+*/
+/*
+* Public symbols are demangled in one batch after table is enumerated because import of large PDBs
+* is dominated by demangling, their locators are kept until then
+*/
+void PDB::GetSymbolsFromTable(IDiaEnumSymbols* enumSymbols, int* currentIndex, int* currentProcent, int* procent, bool importTypes)
+{
+    IDiaSymbol* symbol;
+    ULONG celt = 0;
+    QVector<SymbolLocator> publicSymbolLocators;
+    std::vector<std::string> mangledNames;
 
-    if (symbol->get_hasEH(&hasEH) == S_OK)
+    while (SUCCEEDED(enumSymbols->Next(1, &symbol, &celt)) && (celt == 1) && processEnabled)
     {
-        function.hasEH = hasEH;
-    }
+        SymbolRecord symbolRecord = {};
+        BSTR bstring;
+        DWORD symTag = 0;
 
-    if (symbol->get_hasEHa(&hasEHa) == S_OK)
-    {
-        function.hasEHa = hasEHa;
-    }
+        symbol->get_symTag(&symTag);
 
-    if (symbol->get_hasInlAsm(&hasInlAsm) == S_OK)
-    {
-        function.hasInlAsm = hasInlAsm;
-    }
+        if (symTag == SymTagUDT && importTypes)
+        {
+            DWORD parentClass = 0;
 
-    if (symbol->get_hasLongJump(&hasLongJump) == S_OK)
-    {
-        function.hasLongJump = hasLongJump;
-    }
+            symbol->get_classParentId(&parentClass);
 
-    if (symbol->get_hasSecurityChecks(&hasSecurityChecks) == S_OK)
-    {
-        function.hasSecurityChecks = hasSecurityChecks;
-    }
+            if (parentClass == 0)
+            {
+                if (symbol->get_name(&bstring) == S_OK)
+                {
+                    symbolRecord.typeName = QString::fromWCharArray(bstring);
 
-    if (symbol->get_hasSEH(&hasSEH) == S_OK)
-    {
-        function.hasSEH = hasSEH;
-    }
+                    SysFreeString(bstring);
+                }
 
-    if (symbol->get_hasSetJump(&hasSetJump) == S_OK)
-    {
-        function.hasSetJump = hasSetJump;
-    }
+                ULONGLONG length;
 
-    if (symbol->get_hasSecurityChecks(&hasSecurityChecks) == S_OK)
-    {
-        function.hasSecurityChecks = hasSecurityChecks;
-    }
+                symbol->get_length(&length);
 
-    if (symbol->get_inlSpec(&hasInlSpec) == S_OK)
-    {
-        function.hasInlSpec = hasInlSpec;
-    }
+                if ((length == 0 && options->displayEmptyUDTAndEnums || length > 0) &&
+                    !diaSymbols->contains(symbolRecord.typeName) &&
+                    !symbolRecord.typeName.contains("::__cta"))
+                {
+                    DWORD kind = 0;
+                    symbol->get_udtKind(&kind);
 
-    if (symbol->get_optimizedCodeDebugInfo(&hasOptimizedCodeDebugInfo) == S_OK)
-    {
-        function.hasOptimizedCodeDebugInfo = hasOptimizedCodeDebugInfo;
-    }
+                    UdtKind udtKind = (UdtKind)kind;
 
-    if (symbol->get_farReturn(&farReturn) == S_OK)
-    {
-        function.farReturn = farReturn;
-    }
+                    symbol->get_symIndexId(&symbolRecord.id);
 
-    if (symbol->get_interruptReturn(&interruptReturn) == S_OK)
-    {
-        function.interruptReturn = interruptReturn;
-    }
+                    if (udtKind == UdtStruct)
+                    {
+                        symbolRecord.type = SymbolType::structType;
 
-    if (symbol->get_noStackOrdering(&noStackOrdering) == S_OK)
-    {
-        function.noStackOrdering = noStackOrdering;
-    }
+                        structsCount++;
+                    }
+                    else if (udtKind == UdtClass)
+                    {
+                        symbolRecord.type = SymbolType::classType;
 
-    if (symbol->get_classParent(&parentClass) == S_OK)
-    {
-        if (parentClass->get_name(&bString) == S_OK)
-        {
-            function.parentClassName = QString::fromWCharArray(bString);
-            function.originalParentClassName = function.parentClassName;
+                        classesCount++;
+                    }
+                    else if (udtKind == UdtUnion)
+                    {
+                        symbolRecord.type = SymbolType::unionType;
 
-            FormatString(function.parentClassName);
-            SysFreeString(bString);
-        }
+                        unionsCount++;
+                    }
+                    else if (udtKind == UdtInterface)
+                    {
+                        symbolRecord.type = SymbolType::interfaceType;
 
-        DWORD udtKind = 0;
+                        interfacesCount++;
+                    }
 
-        if (parentClass->get_udtKind(&udtKind) == S_OK)
+                    symbolRecords->push_back(symbolRecord);
+                    diaSymbols->insert(symbolRecord.typeName, symbolRecord.id);
+                }
+            }
+        }
+        else if (symTag == SymTagEnum && importTypes)
         {
-            UdtKind udtKind2 = static_cast<UdtKind>(udtKind);
+            DWORD dwParentClass = 0;
 
-            switch (udtKind2)
+            symbol->get_classParentId(&dwParentClass);
+
+            if (dwParentClass == 0)
             {
-            case UdtStruct:
-                function.parentType = "struct";
-                break;
-            case UdtClass:
-                function.parentType = "class";
-                break;
-            case UdtUnion:
-                function.parentType = "union";
-                break;
-            case UdtInterface:
-                function.parentType = "interface";
-                break;
-            }
-        }
+                if (symbol->get_name(&bstring) == S_OK)
+                {
+                    symbolRecord.typeName = QString::fromWCharArray(bstring);
 
-        parentClass->Release();
-    }
+                    SysFreeString(bstring);
+                }
 
-    if (access == 0)
-    {
-        function.parentType = "namespace";
-    }
+                ULONGLONG length;
 
-    QSet<QString> includes2;
+                symbol->get_length(&length);
 
-    if (options->displayIncludes)
-    {
-        includes2 = includes;
-    }
+                if ((length == 0 && options->displayEmptyUDTAndEnums || length > 0) &&
+                    !diaSymbols->contains(symbolRecord.typeName))
+                {
+                    symbol->get_symIndexId(&symbolRecord.id);
+                    symbolRecord.type = SymbolType::enumType;
 
-    QString parentClassName2 = parentClassName;
+                    symbolRecords->push_back(symbolRecord);
+                    diaSymbols->insert(symbolRecord.typeName, symbolRecord.id);
 
-    parentClassName = function.parentClassName;
+                    enumsCount++;
+                }
+            }
+        }
+        else if (symTag == SymTagData)
+        {
+            if (symbol->get_name(&bstring) == S_OK)
+            {
+                QString name = QString::fromWCharArray(bstring);
 
-    RecordType recordType = GetRecordType(symbol);
+                SysFreeString(bstring);
 
-    parentClassName = parentClassName2;
+                DWORD kind;
+                DataKind dataKind;
 
-    function.isConst = recordType.isFunctionConst;
-    function.isVolatile = recordType.isFunctionVolatile;
-    function.isVariadic = recordType.isVariadicFunction;
-    function.returnType1 = recordType.functionReturnType1;
-    function.returnType2 = recordType.functionReturnType2;
-    function.originalReturnType = recordType.originalFunctionReturnType;
-    function.parametersCount = recordType.parametersCount;
-    function.parameters = recordType.functionParameters;
-    function.originalParameters = recordType.originalFunctionParameters;
-    function.callingConvention = recordType.callingConvention;
-    function.returnsFunctionPointer = recordType.functionReturnsFunctionPointer;
+                symbol->get_dataKind(&kind);
+                dataKind = static_cast<DataKind>(kind);
 
-    //Sometimes DIA SDK won't undecorate name
-    if (function.name.at(0) == '?')
-    {
-        if (options->useUndname)
-        {
-            std::string undecoratedName = peHeaderParser->UndecorateName(function.name.toStdString().c_str());
+                if (!name.startsWith("$") &&
+                    (dataKind == DataIsFileStatic ||
+                        dataKind == DataIsGlobal ||
+                        dataKind == DataIsMember ||
+                        dataKind == DataIsStaticMember ||
+                        dataKind == DataIsConstant))
+                {
+                    DWORD locationType = LocIsNull;
+                    quint32 categories = 0;
 
-            function.name = QString::fromStdString(undecoratedName);
+                    symbol->get_locationType(&locationType);
+
+                    if (dataKind == DataIsGlobal || dataKind == DataIsConstant)
+                    {
+                        categories |= SymbolCategory::globalSymbol;
+                    }
+                    else if (dataKind == DataIsStaticMember || dataKind == DataIsFileStatic)
+                    {
+                        categories |= SymbolCategory::staticSymbol;
+                    }
+
+                    if (dataKind == DataIsMember || dataKind == DataIsStaticMember)
+                    {
+                        categories |= SymbolCategory::memberSymbol;
+                    }
+
+                    AddSymbolLocator(variables, symbol, SymTagData, name, MakeSymbolAttributes(categories, dataKind, locationType));
+                }
+            }
         }
-        else
+        else if (symTag == SymTagFunction)
         {
-            std::string mangledName = function.name.toStdString().c_str();
-            std::string rest;
+            if (symbol->get_name(&bstring) == S_OK)
+            {
+                QString name = QString::fromWCharArray(bstring);
 
-            function.name = QString::fromStdString(msvcDemangler.DemangleSymbol(mangledName, rest));
-        }
-    }
+                SysFreeString(bstring);
 
-    FormatString(function.name);
+                IDiaSymbol* parentClass;
+                DWORD locationType = LocIsNull;
+                BOOL isStatic = FALSE;
+                quint32 categories = 0;
 
-    QString parentClassName = function.parentClassName;
+                symbol->get_locationType(&locationType);
 
-    //Don't check options->removeScopeResolutionOperator here because scope operators always need to removed from parentClassName
-    if (parentClassName.contains("::"))
-    {
-        RemoveScopeResolutionOperators(parentClassName, "");
-    }
+                if (symbol->get_classParent(&parentClass) == S_OK)
+                {
+                    parentClass->Release();
 
-    if (function.name == parentClassName)
-    {
-        //Use contains instead of == because of const
-        if (function.parameters.count() == 1 &&
-            function.parameters.at(0).contains(QString("%1&").arg(parentClassName)))
-        {
-            function.isCopyConstructor = true;
-        }
-        else if (function.parameters.count() == 0)
-        {
-            function.isDefaultConstructor = true;
-        }
-        else
-        {
-            function.isConstructor = true;
+                    categories |= SymbolCategory::memberSymbol;
+                }
+                else
+                {
+                    categories |= SymbolCategory::globalSymbol;
+                }
+
+                if (symbol->get_isStatic(&isStatic) == S_OK && isStatic)
+                {
+                    categories |= SymbolCategory::staticSymbol;
+                }
+
+                AddSymbolLocator(functions, symbol, SymTagFunction, name, MakeSymbolAttributes(categories, 0, locationType));
+            }
         }
-    }
-    else if (function.name.at(0) == '~')
-    {
-        function.isDestructor = true;
-    }
-    else if (function.name == "operator=")
-    {
-        function.isCopyAssignmentOperator = true;
-    }
+        else if (symTag == SymTagPublicSymbol)
+        {
+			/*if (symbol->get_name(&bstring) == S_OK)
+			{
+				QString mangledName = QString::fromWCharArray(bstring);
 
-    DWORD functionOffset = function.relativeVirtualAddress;
+				SysFreeString(bstring);
 
-    if (functionOffset == 0 &&
-        !options->displayNonImplementedFunctions &&
-        !(function.isVirtual && function.isPure) &&
-        !function.isGeneratedByApp &&
-        !function.isDefaultConstructor &&
-        !function.isDestructor &&
-        !(function.isCopyConstructor &&
-            options->applyRuleOfThree) &&
-        !(function.isCopyAssignmentOperator &&
-            options->applyRuleOfThree))
-    {
-        function.isNonImplemented = true;
-    }
+				publicSymbols2->insert(id, mangledName);
+			}*/
 
-    if (function.isNonImplemented && options->displayIncludes && !options->displayNonImplementedFunctions)
-    {
-        if (includes.count() > includes2.count())
-        {
-            includes = includes2;
-        }
-    }
+            if (options->useUndname)
+            {
+                QString demangledName;
 
-    return function;
-}
+				if (symbol->get_undecoratedName(&bstring) == S_OK)
+				{
+					demangledName = QString::fromWCharArray(bstring);
 
-RecordType PDB::GetRecordType(IDiaSymbol* symbol)
-{
-    RecordType recordType = {};
-    IDiaSymbol* type = nullptr;
+					SysFreeString(bstring);
+				}
 
-    if (symbol->get_type(&type) == S_OK)
-    {
-        recordType = GetType(type);
-        type->Release();
+                AddSymbolLocator(publicSymbols, symbol, SymTagPublicSymbol, demangledName);
+            }
+            else
+            {
+                std::string mangledName;
 
-        return recordType;
-    }
+				if (symbol->get_name(&bstring) == S_OK)
+				{
+                    mangledName = QString::fromWCharArray(bstring).toStdString();
 
-    return recordType;
-}
+                    SysFreeString(bstring);
+				}
 
-BaseType PDB::GetBaseType(IDiaSymbol* symbol)
-{
-    BaseType baseType = {};
-    DWORD type = 0;
-    ULONGLONG length = 0;
-    BOOL isConst = 0, isVolatile = 0;
+                publicSymbolLocators.append(GetSymbolLocator(symbol, SymTagPublicSymbol));
+                mangledNames.push_back(std::move(mangledName));
+            }
+        }
 
-    if (symbol->get_baseType(&type) == S_OK)
-    {
-        baseType.type = type;
-    }
+        symbol->Release();
 
-    if (symbol->get_length(&length) == S_OK)
-    {
-        baseType.length = length;
-    }
+        if (*currentIndex > *currentProcent * *procent)
+        {
+            ++*currentProcent;
+            emit SetProgressValue(*currentIndex);
+        }
 
-    if (symbol->get_constType(&isConst) == S_OK)
-    {
-        baseType.isConst = isConst;
+        ++*currentIndex;
     }
 
-    if (symbol->get_volatileType(&isVolatile) == S_OK)
+    if (!processEnabled || mangledNames.empty())
     {
-        baseType.isVolatile = isVolatile;
+        return;
     }
 
-    return baseType;
-}
+    emit SendStatusMessageToProcessDialog("Demangling public symbols...");
 
-PointerType PDB::GetPointerType(IDiaSymbol* symbol)
-{
-    PointerType pointerType = {};
-    ULONGLONG length = 0;
-    BOOL isReference = 0, isConst = 0, isVolatile = 0;
+    std::vector<quint32> nameIDs = SymbolDemangler::DemangleToNameIDs(mangledNames);
+    int count = publicSymbolLocators.count();
 
-    if (symbol->get_length(&length) == S_OK)
-    {
-        pointerType.length = length;
-    }
+    mangledNames.clear();
+    mangledNames.shrink_to_fit();
 
-    if (symbol->get_reference(&isReference) == S_OK)
+    for (int i = 0; i < count; i++)
     {
-        pointerType.isReference = isReference;
-    }
+        SymbolLocator& symbolLocator = publicSymbolLocators[i];
 
-    if (symbol->get_constType(&isConst) == S_OK)
-    {
-        pointerType.isConst = isConst;
-    }
+        symbolLocator.nameID = nameIDs[i];
 
-    if (symbol->get_volatileType(&isVolatile) == S_OK)
-    {
-        pointerType.isVolatile = isVolatile;
+        AddSymbolLocator(publicSymbols, symbolLocator);
     }
-
-    return pointerType;
 }
 
-ArrayType PDB::GetArrayType(IDiaSymbol* symbol)
+int PDB::GetCountOfClasses()
 {
-    ArrayType arrayType = {};
-    DWORD count = 0;
-    ULONGLONG length = 0;
-    BOOL isReference = 0, isConst = 0, isVolatile = 0;
+    return classesCount;
+}
 
-    if (symbol->get_count(&count) == S_OK)
-    {
-        arrayType.count = count;
-    }
+int PDB::GetCountOfStructs()
+{
+    return structsCount;
+}
 
-    if (symbol->get_length(&length) == S_OK)
-    {
-        arrayType.length = length;
-    }
+int PDB::GetCountOfInterfaces()
+{
+    return interfacesCount;
+}
 
-    if (symbol->get_constType(&isConst) == S_OK)
-    {
-        arrayType.isConst = isConst;
-    }
+int PDB::GetCountOfUnions()
+{
+    return unionsCount;
+}
 
-    if (symbol->get_volatileType(&isVolatile) == S_OK)
-    {
-        arrayType.isVolatile = isVolatile;
-    }
+int PDB::GetCountOfEnums()
+{
+    return enumsCount;
+}
 
-    return arrayType;
+void PDB::Stop()
+{
+    processEnabled = false;
 }
 
-Enum PDB::GetEnum(IDiaSymbol* symbol)
+UDT PDB::GetUDT(IDiaSymbol* symbol)
 {
-    Enum enum1 = {};
+    UDT udt = {};
     BSTR bString = nullptr;
-    DWORD baseType = 0, udtKind = 0, access = 0;
+    DWORD udtKind = 0, access = 0, symIndexID = 0, parentClassID = 0;
     ULONGLONG length = 0;
-    BOOL isConst = 0, isVolatile = 0, isNested = 0;
+    BOOL isNested = 0, isConst = 0, isVolatile = 0, hasCastOperator = 0;
     IDiaSymbol* parentClass;
 
     if (symbol->get_name(&bString) == S_OK)
     {
-        enum1.name = QString::fromWCharArray(bString);
-        enum1.originalTypeName = enum1.name;
+        udt.name = QString::fromWCharArray(bString);
+        udt.originalTypeName = udt.name;
 
         SysFreeString(bString);
     }
 
-    if (symbol->get_baseType(&baseType) == S_OK)
+    if (symbol->get_udtKind(&udtKind) == S_OK)
     {
-        enum1.baseType = baseType;
+        udt.udtKind = static_cast<UdtKind>(udtKind);
+
+        switch (udt.udtKind)
+        {
+        case UdtStruct:
+            udt.type = "struct";
+            break;
+        case UdtClass:
+            udt.type = "class";
+            break;
+        case UdtUnion:
+            udt.type = "union";
+            break;
+        case UdtInterface:
+            udt.type = "interface";
+            break;
+        }
     }
 
     if (symbol->get_length(&length) == S_OK)
     {
-        enum1.length = length;
+        udt.length = length;
     }
 
     if (symbol->get_constType(&isConst) == S_OK)
     {
-        enum1.isConst = isConst;
+        udt.isConst = isConst;
     }
 
     if (symbol->get_volatileType(&isVolatile) == S_OK)
     {
-        enum1.isVolatile = isVolatile;
+        udt.isVolatile = isVolatile;
     }
 
     if (symbol->get_classParent(&parentClass) == S_OK)
     {
         if (parentClass->get_name(&bString) == S_OK)
         {
-            enum1.parentClassName = QString::fromWCharArray(bString);
+            udt.parentClassName = QString::fromWCharArray(bString);
 
             SysFreeString(bString);
         }
@@ -1045,237 +1130,245 @@ Enum PDB::GetEnum(IDiaSymbol* symbol)
 
     if (symbol->get_nested(&isNested) == S_OK)
     {
-        enum1.isNested = isNested;
+        udt.isNested = isNested;
     }
 
-    //Sometimes DIA SDK won't undecorate name
-    if (enum1.name.at(0) == '?')
+    IDiaSymbol* unmodifiedType;
+
+    if (symbol->get_unmodifiedType(&unmodifiedType) == S_OK)
     {
-        if (options->useUndname)
-        {
-            std::string undecoratedName = peHeaderParser->UndecorateName(enum1.name.toStdString().c_str());
+        IDiaSymbol* vTableShape;
 
-            enum1.name = QString::fromStdString(undecoratedName);
-        }
-        else
+        if (unmodifiedType->get_virtualTableShape(&vTableShape) == S_OK)
         {
-            std::string mangledName = enum1.name.toStdString().c_str();
-            std::string rest;
+            DWORD count;
+
+            if (vTableShape->get_count(&count) == S_OK)
+            {
+                udt.countOfVirtualFunctions = count;
+            }
 
-            enum1.name = QString::fromStdString(msvcDemangler.DemangleSymbol(mangledName, rest));
+            vTableShape->Release();
         }
+
+        unmodifiedType->Release();
     }
 
-    if (enum1.name.endsWith("-tag>"))
+    if (symbol->get_hasCastOperator(&hasCastOperator) == S_OK)
     {
-        enum1.isAnonymous = true;
+        udt.hasCastOperator = hasCastOperator;
     }
-    else if (enum1.name.contains("<unnamed"))
+
+    if (udt.name.contains("<unnamed"))
     {
-        enum1.isUnnamed = true;
+        udt.isUnnamed = true;
     }
 
-    //Type of access specifier is not available for enums
-    enum1.access = CV_access_e::CV_public;
-
-    FormatString(enum1.parentClassName);
+    //Sometimes DIA SDK won't undecorate name
+    if (udt.name.at(0) == '?')
+    {
+        if (options->useUndname)
+        {
+            std::string undecoratedName = peHeaderParser->UndecorateName(udt.name.toStdString().c_str());
 
-    return enum1;
+            udt.name = QString::fromStdString(undecoratedName);
+        }
+        else
+        {
+            std::string mangledName = udt.name.toStdString().c_str();
+
+            udt.name = QString::fromStdString(SymbolDemangler::DemangleQualifiedName(mangledName));
+        }
+    }
+
+    FormatString(udt.name);
+    FormatString(udt.parentClassName);
+
+    //Type of access specifier is not available for udts
+    udt.access = CV_access_e::CV_public;
+
+    InternNames(&udt);
+
+    return udt;
 }
 
-FunctionType PDB::GetFunctionType(IDiaSymbol* symbol)
+Function PDB::GetFunction(IDiaSymbol* symbol)
 {
-    FunctionType functionType = {};
-    DWORD callingConvention = 0, parametersCount = 0;
-    BOOL isConst = 0, isVolatile = 0;
+    ResolutionContext* context = GetResolutionContext();
+    Function function = {};
+    BSTR bString = nullptr;
+    DWORD access = 0, addressSection = 0, relativeVirtualAddress = 0, virtualBaseOffset = 0, callingConvention = 0;
+    ULONGLONG length = 0, virtualAddress = 0;
+    BOOL isCompilerGenerated = 0, isNaked = 0, isStatic = 0, isNoInline = 0, isNotReached = 0;
+    BOOL isNoReturn = 0, isPure = 0, isConst = 0, isVolatile = 0, isVirtual = 0, isIntroVirtual = 0, hasCustomCallingConvention = 0;
+    BOOL hasAlloca = 0, hasEH = 0, hasEHa = 0, hasInlAsm = 0, hasLongJump = 0, hasSecurityChecks = 0, hasSEH = 0, hasSetJump = 0;
+    BOOL hasInlSpec = 0, hasOptimizedCodeDebugInfo = 0, farReturn = 0, interruptReturn = 0, noStackOrdering = 0;
+    IDiaSymbol* parentClass;
 
-    if (symbol->get_callingConvention(&callingConvention) == S_OK)
+    if (symbol->get_access(&access) == S_OK)
     {
-        functionType.callingConvention = static_cast<CV_call_e>(callingConvention);
+        function.access = static_cast<CV_access_e>(access);
     }
 
-    if (symbol->get_count(&parametersCount) == S_OK)
+    if (symbol->get_addressSection(&addressSection) == S_OK)
     {
-        functionType.parametersCount = parametersCount;
+        function.addressSection = addressSection;
     }
 
-    IDiaSymbol* objectPointer;
+    if (symbol->get_compilerGenerated(&isCompilerGenerated) == S_OK)
+    {
+        function.isCompilerGenerated = isCompilerGenerated;
+    }
 
-    if (symbol->get_objectPointerType(&objectPointer) == S_OK)
+    if (symbol->get_isNaked(&isNaked) == S_OK)
     {
-        DWORD symTag;
+        function.isNaked = isNaked;
+    }
 
-        if (objectPointer->get_symTag(&symTag) == S_OK)
-        {
-            if (symTag == SymTagPointerType)
-            {
-                IDiaSymbol* pointee;
+    if (symbol->get_isStatic(&isStatic) == S_OK)
+    {
+        function.isStatic = isStatic;
+    }
 
-                if (objectPointer->get_type(&pointee) == S_OK)
-                {
-                    if (pointee->get_constType(&isConst) == S_OK)
-                    {
-                        functionType.isConst = isConst;
-                    }
+    if (symbol->get_noInline(&isNoInline) == S_OK)
+    {
+        function.isNoInline = isNoInline;
+    }
 
-                    if (pointee->get_volatileType(&isVolatile) == S_OK)
-                    {
-                        functionType.isVolatile = isVolatile;
-                    }
-                }
-            }
-        }
+    if (symbol->get_notReached(&isNotReached) == S_OK)
+    {
+        function.isNotReached = isNotReached;
     }
 
-    return functionType;
-}
+    if (symbol->get_noReturn(&isNoReturn) == S_OK)
+    {
+        function.isNoReturn = isNoReturn;
+    }
 
-TypeDef PDB::GetTypeDef(IDiaSymbol* symbol)
-{
-    TypeDef typeDef = {};
-    BSTR bString = nullptr;
+    if (symbol->get_length(&length) == S_OK)
+    {
+        function.length = length;
+    }
 
     if (symbol->get_name(&bString) == S_OK)
     {
-        typeDef.newTypeName = QString::fromWCharArray(bString);
-
+        function.name = QString::fromWCharArray(bString);
         SysFreeString(bString);
     }
 
-    RecordType recordType = GetRecordType(symbol);
-
-    typeDef.oldTypeName = recordType.typeName;
-
-    //Type of access specifier is not available for udts
-    typeDef.access = CV_access_e::CV_private;
+    if (symbol->get_pure(&isPure) == S_OK)
+    {
+        function.isPure = isPure;
+    }
 
-    if (options->removeScopeResolutionOperator && typeDef.oldTypeName.contains("::"))
+    if (symbol->get_virtualAddress(&virtualAddress) == S_OK)
     {
-        RemoveScopeResolutionOperators(typeDef.oldTypeName, parentClassName);
+        function.virtualAddress = virtualAddress;
     }
 
-    return typeDef;
-}
+    if (symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
+    {
+        function.relativeVirtualAddress = relativeVirtualAddress;
+    }
 
-Value PDB::GetValue(IDiaSymbol* symbol)
-{
-    Value result = {};
-    VARIANT value = {};
+    if (symbol->get_virtual(&isVirtual) == S_OK)
+    {
+        function.isVirtual = isVirtual;
+    }
 
-    value.vt = VT_EMPTY;
+    if (symbol->get_virtualBaseOffset(&virtualBaseOffset) == S_OK)
+    {
+        function.virtualBaseOffset = virtualBaseOffset;
+    }
 
-    if (symbol->get_value(&value) == S_OK)
+    if (symbol->get_intro(&isIntroVirtual) == S_OK)
     {
-        result.isValid = true;
+        function.isIntroVirtual = isIntroVirtual;
+    }
 
-        switch (value.vt)
-        {
-        case VT_UI1:        
-            result.value = value.bVal;
-            break;
-        case VT_UI2:        
-            result.value = value.uiVal;  
-            break;
-        case VT_UI4:        
-            result.value = (quint32)value.ulVal;
-            break;
-        case VT_UINT:       
-            result.value = value.uintVal;          
-            break;
-        case VT_INT:        
-            result.value = value.intVal;
-            break;
-        case VT_I1:         
-            result.value = value.cVal;
-            break;
-        case VT_I2:         
-            result.value = value.iVal;   
-            break;
-        case VT_I4:         
-            result.value = (quint32)value.lVal;
-            break;
-        default:            
-            emit SendStatusMessage("Unknown VARIANT.");
+    if (symbol->get_customCallingConvention(&hasCustomCallingConvention) == S_OK)
+    {
+        function.hasCustomCallingConvention = hasCustomCallingConvention;
+    }
 
-            break;
-        }
+    if (symbol->get_hasAlloca(&hasAlloca) == S_OK)
+    {
+        function.hasAlloca = hasAlloca;
     }
 
-    return result;
-}
+    if (symbol->get_hasEH(&hasEH) == S_OK)
+    {
+        function.hasEH = hasEH;
+    }
 
-Data PDB::GetData(IDiaSymbol* symbol)
-{
-    Data data = {};
-    BSTR bString = nullptr;
-    DWORD access = 0, bitOffset = 0, dataKind = 0, relativeVirtualAddress = 0, locationType = 0;
-    ULONGLONG length = 0, virtualAddress = 0;
-    LONG offset = 0;
-    BOOL isCompilerGenerated = 0, isConst = 0, isVolatile = 0;
-    IDiaSymbol* parentClass;
+    if (symbol->get_hasEHa(&hasEHa) == S_OK)
+    {
+        function.hasEHa = hasEHa;
+    }
 
-    if (symbol->get_access(&access) == S_OK)
+    if (symbol->get_hasInlAsm(&hasInlAsm) == S_OK)
     {
-        data.access = static_cast<CV_access_e>(access);
+        function.hasInlAsm = hasInlAsm;
     }
 
-    if (symbol->get_bitPosition(&bitOffset) == S_OK)
+    if (symbol->get_hasLongJump(&hasLongJump) == S_OK)
     {
-        data.bitOffset = bitOffset;
+        function.hasLongJump = hasLongJump;
     }
 
-    if (symbol->get_compilerGenerated(&isCompilerGenerated) == S_OK)
+    if (symbol->get_hasSecurityChecks(&hasSecurityChecks) == S_OK)
     {
-        data.isCompilerGenerated = isCompilerGenerated;
+        function.hasSecurityChecks = hasSecurityChecks;
     }
 
-    if (symbol->get_dataKind(&dataKind) == S_OK)
+    if (symbol->get_hasSEH(&hasSEH) == S_OK)
     {
-        data.dataKind = static_cast<DataKind>(dataKind);
+        function.hasSEH = hasSEH;
     }
 
-    if (symbol->get_length(&length) == S_OK)
+    if (symbol->get_hasSetJump(&hasSetJump) == S_OK)
     {
-        data.length = length;
+        function.hasSetJump = hasSetJump;
     }
 
-    if (symbol->get_name(&bString) == S_OK)
+    if (symbol->get_hasSecurityChecks(&hasSecurityChecks) == S_OK)
     {
-        data.name = QString::fromWCharArray(bString);
-        SysFreeString(bString);
+        function.hasSecurityChecks = hasSecurityChecks;
     }
 
-    if (symbol->get_offset(&offset) == S_OK)
+    if (symbol->get_inlSpec(&hasInlSpec) == S_OK)
     {
-        data.offset = offset;
+        function.hasInlSpec = hasInlSpec;
     }
 
-    if (symbol->get_virtualAddress(&virtualAddress) == S_OK)
+    if (symbol->get_optimizedCodeDebugInfo(&hasOptimizedCodeDebugInfo) == S_OK)
     {
-        data.virtualAddress = virtualAddress;
+        function.hasOptimizedCodeDebugInfo = hasOptimizedCodeDebugInfo;
     }
 
-    if (symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
+    if (symbol->get_farReturn(&farReturn) == S_OK)
     {
-        data.relativeVirtualAddress = relativeVirtualAddress;
+        function.farReturn = farReturn;
     }
 
-    if (symbol->get_constType(&isConst) == S_OK)
+    if (symbol->get_interruptReturn(&interruptReturn) == S_OK)
     {
-        data.isTypeConst = isConst;
+        function.interruptReturn = interruptReturn;
     }
 
-    if (symbol->get_volatileType(&isVolatile) == S_OK)
+    if (symbol->get_noStackOrdering(&noStackOrdering) == S_OK)
     {
-        data.isTypeVolatile = isVolatile;
+        function.noStackOrdering = noStackOrdering;
     }
 
     if (symbol->get_classParent(&parentClass) == S_OK)
     {
         if (parentClass->get_name(&bString) == S_OK)
         {
-            data.parentClassName = QString::fromWCharArray(bString);
+            function.parentClassName = QString::fromWCharArray(bString);
+            function.originalParentClassName = function.parentClassName;
 
+            FormatString(function.parentClassName);
             SysFreeString(bString);
         }
 
@@ -1288,20 +1381,16 @@ Data PDB::GetData(IDiaSymbol* symbol)
             switch (udtKind2)
             {
             case UdtStruct:
-                data.parentType = "struct";
-
+                function.parentType = "struct";
                 break;
             case UdtClass:
-                data.parentType = "class";
-
+                function.parentType = "class";
                 break;
             case UdtUnion:
-                data.parentType = "union";
-
+                function.parentType = "union";
                 break;
             case UdtInterface:
-                data.parentType = "interface";
-
+                function.parentType = "interface";
                 break;
             }
         }
@@ -1309,147 +1398,267 @@ Data PDB::GetData(IDiaSymbol* symbol)
         parentClass->Release();
     }
 
-    if (access == 0 &&
-        !(data.dataKind == DataIsGlobal ||
-            data.dataKind == DataIsFileStatic ||
-            data.dataKind == DataIsConstant))
+    if (access == 0)
     {
-        data.parentType = "namespace";
+        function.parentType = "namespace";
     }
 
-    if (symbol->get_locationType(&locationType) == S_OK)
+    QSet<QString> includes2;
+
+    if (context->DisplayIncludes())
     {
-        data.locationType = static_cast<LocationType>(locationType);
+        includes2 = context->includes;
     }
 
-    data.location = GetLocation(symbol);
-    data.value = GetValue(symbol);
+    QString parentClassName2 = context->parentClassName;
 
-    RecordType recordType = GetRecordType(symbol);
+    context->parentClassName = function.parentClassName;
 
-    data.baseType = recordType.baseType;
+    RecordType recordType = GetRecordType(symbol);
 
-    data.isTypeConst = recordType.isTypeConst;
-    data.isTypeVolatile = recordType.isTypeVolatile;
-    data.isPointerConst = recordType.isPointerConst;
-    data.isPointerVolatile = recordType.isPointerVolatile;
-    data.originalTypeName = recordType.originalTypeName;
-    data.typeName = recordType.typeName;
-    data.size = recordType.size;
-    data.isPointer = recordType.isPointer;
-    data.isReference = recordType.isReference;
-    data.pointerLevel = recordType.pointerLevel;
-    data.referenceLevel = recordType.referenceLevel;
-    data.isArray = recordType.isArray;
-    data.arrayCount = recordType.arrayCount;
-    data.functionReturnType = recordType.functionReturnType2;
-    data.functionParameters = recordType.functionParameters;
-    data.noType = recordType.noType;
-    data.isTypeNameOfEnum = recordType.isTypeNameOfEnum;
-    data.numberOfBits = data.length;
-    //data.isFunctionPointer = recordType.isFunctionPointer;
+    context->parentClassName = parentClassName2;
 
-    if (recordType.size > 0 && recordType.functionType)
-    {
-        data.isFunctionPointer = true;
-    }
+    function.isConst = recordType.isFunctionConst;
+    function.isVolatile = recordType.isFunctionVolatile;
+    function.isVariadic = recordType.isVariadicFunction;
+    function.returnType1 = recordType.functionReturnType1;
+    function.returnType2 = recordType.functionReturnType2;
+    function.originalReturnType = recordType.originalFunctionReturnType;
+    function.parametersCount = recordType.parametersCount;
+    function.parameters = recordType.functionParameters;
+    function.originalParameters = recordType.originalFunctionParameters;
+    function.callingConvention = recordType.callingConvention;
+    function.returnsFunctionPointer = recordType.functionReturnsFunctionPointer;
 
     //Sometimes DIA SDK won't undecorate name
-    if (data.name.length() > 0 && data.name.at(0) == '?')
+    if (function.name.at(0) == '?')
     {
         if (options->useUndname)
         {
-            std::string undecoratedName = peHeaderParser->UndecorateName(data.name.toStdString().c_str());
+            std::string undecoratedName = peHeaderParser->UndecorateName(function.name.toStdString().c_str());
 
-            data.name = QString::fromStdString(undecoratedName);
+            function.name = QString::fromStdString(undecoratedName);
         }
         else
         {
-            std::string mangledName = data.name.toStdString().c_str();
-            std::string rest;
+            std::string mangledName = function.name.toStdString().c_str();
 
-            data.name = QString::fromStdString(msvcDemangler.DemangleSymbol(mangledName, rest));
+            function.name = QString::fromStdString(SymbolDemangler::DemangleQualifiedName(mangledName));
         }
     }
 
-    FormatString(data.typeName);
-    FormatString(data.parentClassName);
+    FormatString(function.name);
 
-    return data;
+    QString parentClassName = function.parentClassName;
+
+    //Don't check options->removeScopeResolutionOperator here because scope operators always need to removed from parentClassName
+    if (parentClassName.contains("::"))
+    {
+        RemoveScopeResolutionOperators(parentClassName, "");
+    }
+
+    if (function.name == parentClassName)
+    {
+        //Use contains instead of == because of const
+        if (function.parameters.count() == 1 &&
+            function.parameters.at(0).contains(QString("%1&").arg(parentClassName)))
+        {
+            function.isCopyConstructor = true;
+        }
+        else if (function.parameters.count() == 0)
+        {
+            function.isDefaultConstructor = true;
+        }
+        else
+        {
+            function.isConstructor = true;
+        }
+    }
+    else if (function.name.at(0) == '~')
+    {
+        function.isDestructor = true;
+    }
+    else if (function.name == "operator=")
+    {
+        function.isCopyAssignmentOperator = true;
+    }
+
+    DWORD functionOffset = function.relativeVirtualAddress;
+
+    if (functionOffset == 0 &&
+        !options->displayNonImplementedFunctions &&
+        !(function.isVirtual && function.isPure) &&
+        !function.isGeneratedByApp &&
+        !function.isDefaultConstructor &&
+        !function.isDestructor &&
+        !(function.isCopyConstructor &&
+            options->applyRuleOfThree) &&
+        !(function.isCopyAssignmentOperator &&
+            options->applyRuleOfThree))
+    {
+        function.isNonImplemented = true;
+    }
+
+    if (function.isNonImplemented && context->DisplayIncludes() && !options->displayNonImplementedFunctions)
+    {
+        if (context->includes.count() > includes2.count())
+        {
+            context->includes = includes2;
+        }
+    }
+
+    InternNames(&function);
+
+    return function;
 }
 
-BaseClass PDB::GetBaseClass(IDiaSymbol* symbol)
+RecordType PDB::GetRecordType(IDiaSymbol* symbol)
 {
-    BaseClass baseClass = {};
-    BSTR bString = nullptr;
-    DWORD access = 0, udtKind = 0, virtualBaseDispIndex = 0;
-    LONG offset = 0, virtualBasePointerOffset = 0;
+    RecordType recordType = {};
+    IDiaSymbol* type = nullptr;
+
+    if (symbol->get_type(&type) == S_OK)
+    {
+        recordType = GetType(type);
+        type->Release();
+
+        return recordType;
+    }
+
+    return recordType;
+}
+
+BaseType PDB::GetBaseType(IDiaSymbol* symbol)
+{
+    BaseType baseType = {};
+    DWORD type = 0;
     ULONGLONG length = 0;
-    BOOL isVirtualBaseClass = 0, isIndirectVirtualBaseClass = 0, isConst = 0, isVolatile = 0;
-    IDiaSymbol* parentClass;
+    BOOL isConst = 0, isVolatile = 0;
 
-    if (symbol->get_access(&access) == S_OK)
+    if (symbol->get_baseType(&type) == S_OK)
     {
-        baseClass.access = static_cast<CV_access_e>(access);
+        baseType.type = type;
     }
 
-    if (symbol->get_name(&bString) == S_OK)
+    if (symbol->get_length(&length) == S_OK)
     {
-        baseClass.name = QString::fromWCharArray(bString);
+        baseType.length = length;
+    }
 
-        SysFreeString(bString);
+    if (symbol->get_constType(&isConst) == S_OK)
+    {
+        baseType.isConst = isConst;
     }
 
-    if (symbol->get_udtKind(&udtKind) == S_OK)
+    if (symbol->get_volatileType(&isVolatile) == S_OK)
     {
-        baseClass.udtKind = static_cast<UdtKind>(udtKind);
+        baseType.isVolatile = isVolatile;
     }
 
-    if (symbol->get_offset(&offset) == S_OK)
+    return baseType;
+}
+
+PointerType PDB::GetPointerType(IDiaSymbol* symbol)
+{
+    PointerType pointerType = {};
+    ULONGLONG length = 0;
+    BOOL isReference = 0, isConst = 0, isVolatile = 0;
+
+    if (symbol->get_length(&length) == S_OK)
     {
-        baseClass.offset = offset;
+        pointerType.length = length;
+    }
+
+    if (symbol->get_reference(&isReference) == S_OK)
+    {
+        pointerType.isReference = isReference;
+    }
+
+    if (symbol->get_constType(&isConst) == S_OK)
+    {
+        pointerType.isConst = isConst;
+    }
+
+    if (symbol->get_volatileType(&isVolatile) == S_OK)
+    {
+        pointerType.isVolatile = isVolatile;
+    }
+
+    return pointerType;
+}
+
+ArrayType PDB::GetArrayType(IDiaSymbol* symbol)
+{
+    ArrayType arrayType = {};
+    DWORD count = 0;
+    ULONGLONG length = 0;
+    BOOL isReference = 0, isConst = 0, isVolatile = 0;
+
+    if (symbol->get_count(&count) == S_OK)
+    {
+        arrayType.count = count;
     }
 
     if (symbol->get_length(&length) == S_OK)
     {
-        baseClass.length = length;
+        arrayType.length = length;
     }
 
-    if (symbol->get_virtualBaseClass(&isVirtualBaseClass) == S_OK)
+    if (symbol->get_constType(&isConst) == S_OK)
     {
-        baseClass.isVirtualBaseClass = isVirtualBaseClass;
+        arrayType.isConst = isConst;
     }
 
-    if (symbol->get_indirectVirtualBaseClass(&isIndirectVirtualBaseClass) == S_OK)
+    if (symbol->get_volatileType(&isVolatile) == S_OK)
     {
-        baseClass.isIndirectVirtualBaseClass = isIndirectVirtualBaseClass;
+        arrayType.isVolatile = isVolatile;
     }
 
-    if (symbol->get_virtualBaseDispIndex(&virtualBaseDispIndex) == S_OK)
+    return arrayType;
+}
+
+Enum PDB::GetEnum(IDiaSymbol* symbol)
+{
+    Enum enum1 = {};
+    BSTR bString = nullptr;
+    DWORD baseType = 0, udtKind = 0, access = 0;
+    ULONGLONG length = 0;
+    BOOL isConst = 0, isVolatile = 0, isNested = 0;
+    IDiaSymbol* parentClass;
+
+    if (symbol->get_name(&bString) == S_OK)
     {
-        baseClass.virtualBaseDispIndex = virtualBaseDispIndex;
+        enum1.name = QString::fromWCharArray(bString);
+        enum1.originalTypeName = enum1.name;
+
+        SysFreeString(bString);
     }
 
-    if (symbol->get_virtualBasePointerOffset(&virtualBasePointerOffset) == S_OK)
+    if (symbol->get_baseType(&baseType) == S_OK)
     {
-        baseClass.virtualBasePointerOffset = virtualBasePointerOffset;
+        enum1.baseType = baseType;
     }
 
-    if (symbol->get_unalignedType(&isConst) == S_OK)
+    if (symbol->get_length(&length) == S_OK)
     {
-        baseClass.isConst = isConst;
+        enum1.length = length;
+    }
+
+    if (symbol->get_constType(&isConst) == S_OK)
+    {
+        enum1.isConst = isConst;
     }
 
     if (symbol->get_volatileType(&isVolatile) == S_OK)
     {
-        baseClass.isVolatile = isVolatile;
+        enum1.isVolatile = isVolatile;
     }
 
     if (symbol->get_classParent(&parentClass) == S_OK)
     {
         if (parentClass->get_name(&bString) == S_OK)
         {
-            baseClass.parentClassName = QString::fromWCharArray(bString);
+            enum1.parentClassName = QString::fromWCharArray(bString);
 
             SysFreeString(bString);
         }
@@ -1457,1700 +1666,1664 @@ BaseClass PDB::GetBaseClass(IDiaSymbol* symbol)
         parentClass->Release();
     }
 
+    if (symbol->get_nested(&isNested) == S_OK)
+    {
+        enum1.isNested = isNested;
+    }
+
     //Sometimes DIA SDK won't undecorate name
-    if (baseClass.name.at(0) == '?')
+    if (enum1.name.at(0) == '?')
     {
         if (options->useUndname)
         {
-            std::string undecoratedName = peHeaderParser->UndecorateName(baseClass.name.toStdString().c_str());
+            std::string undecoratedName = peHeaderParser->UndecorateName(enum1.name.toStdString().c_str());
 
-            baseClass.name = QString::fromStdString(undecoratedName);
+            enum1.name = QString::fromStdString(undecoratedName);
         }
         else
         {
-            std::string mangledName = baseClass.name.toStdString().c_str();
-            std::string rest;
+            std::string mangledName = enum1.name.toStdString().c_str();
 
-            baseClass.name = QString::fromStdString(msvcDemangler.DemangleSymbol(mangledName, rest));
+            enum1.name = QString::fromStdString(SymbolDemangler::DemangleQualifiedName(mangledName));
         }
     }
 
-    FormatString(baseClass.name);
-    FormatString(baseClass.parentClassName);
-
-    if (options->displayIncludes)
+    if (enum1.name.endsWith("-tag>"))
     {
-        if (baseClass.parentClassName.length() == 0)
-        {
-            AddTypeNameToIncludesList(baseClass.name, parentClassName);
-        }
-        else
-        {
-            AddTypeNameToIncludesList(baseClass.name, baseClass.parentClassName);
-        }
+        enum1.isAnonymous = true;
+    }
+    else if (enum1.name.contains("<unnamed"))
+    {
+        enum1.isUnnamed = true;
     }
 
-    return baseClass;
-}
+    //Type of access specifier is not available for enums
+    enum1.access = CV_access_e::CV_public;
 
-PublicSymbol PDB::GetPublicSymbol(IDiaSymbol* symbol)
-{
-    PublicSymbol publicSymbol = {};
-    BSTR bString = nullptr;
-    DWORD addressOffset = 0, addressSection = 0, locationType = 0, relativeVirtualAddress = 0;
-    BOOL isInCode = 0, isFunction = 0, isInManagedCode = 0, isInMSILCode = 0;
-    ULONGLONG length = 0;
+    FormatString(enum1.parentClassName);
 
-	if (symbol->get_name(&bString) == S_OK)
-	{
-        publicSymbol.decoratedName = QString::fromWCharArray(bString);
+    InternNames(&enum1);
 
-		SysFreeString(bString);
-	}
+    return enum1;
+}
 
-    if (options->useUndname)
-    {
-        if (symbol->get_undecoratedName(&bString) == S_OK)
-        {
-            publicSymbol.undecoratedName = QString::fromWCharArray(bString);
+FunctionType PDB::GetFunctionType(IDiaSymbol* symbol)
+{
+    FunctionType functionType = {};
+    DWORD callingConvention = 0, parametersCount = 0;
+    BOOL isConst = 0, isVolatile = 0;
 
-            SysFreeString(bString);
-        }
-    }
-    else
+    if (symbol->get_callingConvention(&callingConvention) == S_OK)
     {
-		if (symbol->get_name(&bString) == S_OK)
-		{
-			std::string mangledName = QString::fromWCharArray(bString).toStdString();
-			std::string rest;
-
-			publicSymbol.undecoratedName = QString::fromStdString(msvcDemangler.DemangleSymbol(mangledName, rest));
-
-            SysFreeString(bString);
-		}
+        functionType.callingConvention = static_cast<CV_call_e>(callingConvention);
     }
 
-	if (symbol->get_addressOffset(&addressOffset) == S_OK)
-	{
-        publicSymbol.addressOffset = addressOffset;
-	}
-
-	if (symbol->get_addressSection(&addressSection) == S_OK)
-	{
-        publicSymbol.addressSection = addressSection;
-	}
-
-	if (symbol->get_code(&isInCode) == S_OK)
-	{
-        publicSymbol.isInCode = isInCode;
-	}
-
-	if (symbol->get_function(&isFunction) == S_OK)
-	{
-        publicSymbol.isFunction = isFunction;
-	}
+    if (symbol->get_count(&parametersCount) == S_OK)
+    {
+        functionType.parametersCount = parametersCount;
+    }
 
-	if (symbol->get_managed(&isInManagedCode) == S_OK)
-	{
-        publicSymbol.isInManagedCode = isInManagedCode;
-	}
+    IDiaSymbol* objectPointer;
 
-	if (symbol->get_msil(&isInMSILCode) == S_OK)
-	{
-        publicSymbol.isInMSILCode = isInMSILCode;
-	}
+    if (symbol->get_objectPointerType(&objectPointer) == S_OK)
+    {
+        DWORD symTag;
 
-	if (symbol->get_length(&length) == S_OK)
-	{
-        publicSymbol.length = length;
-	}
+        if (objectPointer->get_symTag(&symTag) == S_OK)
+        {
+            if (symTag == SymTagPointerType)
+            {
+                IDiaSymbol* pointee;
 
-	if (symbol->get_locationType(&locationType) == S_OK)
-	{
-        publicSymbol.locationType = static_cast<LocationType>(locationType);
-	}
+                if (objectPointer->get_type(&pointee) == S_OK)
+                {
+                    if (pointee->get_constType(&isConst) == S_OK)
+                    {
+                        functionType.isConst = isConst;
+                    }
 
-	if (symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
-	{
-        publicSymbol.relativeVirtualAddress = relativeVirtualAddress;
-	}
+                    if (pointee->get_volatileType(&isVolatile) == S_OK)
+                    {
+                        functionType.isVolatile = isVolatile;
+                    }
+                }
+            }
+        }
+    }
 
-    return publicSymbol;
+    return functionType;
 }
 
-QString PDB::GetSourceFilePath(IDiaSymbol* symbol)
+TypeDef PDB::GetTypeDef(IDiaSymbol* symbol)
 {
-    QString sourceFilePath;
-	ULONGLONG length = 0;
+    ResolutionContext* context = GetResolutionContext();
+    TypeDef typeDef = {};
+    BSTR bString = nullptr;
 
-	if (symbol->get_length(&length) != S_OK)
-	{
-        return sourceFilePath;
-	}
+    if (symbol->get_name(&bString) == S_OK)
+    {
+        typeDef.newTypeName = QString::fromWCharArray(bString);
 
-    DWORD relativeVirtualAddress = 0;
-    IDiaEnumLineNumbers* lines = nullptr;
-    bool succeeded = false;
+        SysFreeString(bString);
+    }
 
-	if (symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
-	{
-		if (SUCCEEDED(diaSession->findLinesByRVA(relativeVirtualAddress, static_cast<DWORD>(length), &lines)))
-		{
-            succeeded = true;
-		}
-	}
-	else
-	{
-		DWORD addressSection = 0;
-		DWORD addressOffset = 0;
+    RecordType recordType = GetRecordType(symbol);
 
-		if ((symbol->get_addressSection(&addressSection) == S_OK) &&
-			(symbol->get_addressOffset(&addressOffset) == S_OK))
-		{
-			if (SUCCEEDED(diaSession->findLinesByAddr(addressSection, addressOffset, static_cast<DWORD>(length), &lines)))
-			{
-                succeeded = true;
-			}
-		}
-	}
+    typeDef.oldTypeName = recordType.typeName;
 
-    if (succeeded)
-    {
-        IDiaLineNumber* line = nullptr;
-        DWORD sourceFileID = 0;
-        DWORD lastSourceFileID = (DWORD)(-1);
+    //Type of access specifier is not available for udts
+    typeDef.access = CV_access_e::CV_private;
 
-        if (lines->Item(0, &line) == S_OK &&
-            line->get_sourceFileId(&sourceFileID) == S_OK)
-		{
-			if (sourceFileID != lastSourceFileID)
-			{
-				IDiaSourceFile* sourceFile;
+    if (context->RemoveScopeResolutionOperator() && typeDef.oldTypeName.contains("::"))
+    {
+        RemoveScopeResolutionOperators(typeDef.oldTypeName, context->parentClassName);
+    }
 
-				if (line->get_sourceFile(&sourceFile) == S_OK)
-				{
-					BSTR fileName;
+    return typeDef;
+}
 
-					if (sourceFile->get_fileName(&fileName) == S_OK)
-					{
-						sourceFilePath = QString::fromWCharArray(fileName);
+Value PDB::GetValue(IDiaSymbol* symbol)
+{
+    Value result = {};
+    VARIANT value = {};
 
-						SysFreeString(fileName);
-					}
+    value.vt = VT_EMPTY;
 
-					sourceFile->Release();
-				}
-			}
+    if (symbol->get_value(&value) == S_OK)
+    {
+        result.isValid = true;
 
-            line->Release();
-		}
+        switch (value.vt)
+        {
+        case VT_UI1:        
+            result.value = value.bVal;
+            break;
+        case VT_UI2:        
+            result.value = value.uiVal;  
+            break;
+        case VT_UI4:        
+            result.value = (quint32)value.ulVal;
+            break;
+        case VT_UINT:       
+            result.value = value.uintVal;          
+            break;
+        case VT_INT:        
+            result.value = value.intVal;
+            break;
+        case VT_I1:         
+            result.value = value.cVal;
+            break;
+        case VT_I2:         
+            result.value = value.iVal;   
+            break;
+        case VT_I4:         
+            result.value = (quint32)value.lVal;
+            break;
+        default:            
+            emit SendStatusMessage("Unknown VARIANT.");
 
-        lines->Release();
+            break;
+        }
     }
 
-    return sourceFilePath;
+    return result;
 }
 
-QString PDB::GetSourceFileInfo(IDiaSourceFile* source)
+Data PDB::GetData(IDiaSymbol* symbol)
 {
-    QString result;
-    BSTR bstrSourceName;
+    Data data = {};
+    BSTR bString = nullptr;
+    DWORD access = 0, bitOffset = 0, dataKind = 0, relativeVirtualAddress = 0, locationType = 0;
+    ULONGLONG length = 0, virtualAddress = 0;
+    LONG offset = 0;
+    BOOL isCompilerGenerated = 0, isConst = 0, isVolatile = 0;
+    IDiaSymbol* parentClass;
 
-    if (source->get_fileName(&bstrSourceName) == S_OK)
+    if (symbol->get_access(&access) == S_OK)
     {
-        result += QString("\t%1").arg(QString::fromWCharArray(bstrSourceName));
-
-        SysFreeString(bstrSourceName);
+        data.access = static_cast<CV_access_e>(access);
     }
 
-    else
+    if (symbol->get_bitPosition(&bitOffset) == S_OK)
     {
-        SendStatusMessage("ERROR - PrintSourceFile() get_fileName");
+        data.bitOffset = bitOffset;
+    }
 
-        return result;
+    if (symbol->get_compilerGenerated(&isCompilerGenerated) == S_OK)
+    {
+        data.isCompilerGenerated = isCompilerGenerated;
     }
 
-    BYTE checksum[256] = {};
-    DWORD cbChecksum = sizeof(checksum);
+    if (symbol->get_dataKind(&dataKind) == S_OK)
+    {
+        data.dataKind = static_cast<DataKind>(dataKind);
+    }
 
-    if (source->get_checksum(cbChecksum, &cbChecksum, checksum) == S_OK)
+    if (symbol->get_length(&length) == S_OK)
     {
-        result += " (";
+        data.length = length;
+    }
 
-        DWORD checksumType;
+    if (symbol->get_name(&bString) == S_OK)
+    {
+        data.name = QString::fromWCharArray(bString);
+        SysFreeString(bString);
+    }
 
-        if (source->get_checksumType(&checksumType) == S_OK)
+    if (symbol->get_offset(&offset) == S_OK)
+    {
+        data.offset = offset;
+    }
+
+    if (symbol->get_virtualAddress(&virtualAddress) == S_OK)
+    {
+        data.virtualAddress = virtualAddress;
+    }
+
+    if (symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
+    {
+        data.relativeVirtualAddress = relativeVirtualAddress;
+    }
+
+    if (symbol->get_constType(&isConst) == S_OK)
+    {
+        data.isTypeConst = isConst;
+    }
+
+    if (symbol->get_volatileType(&isVolatile) == S_OK)
+    {
+        data.isTypeVolatile = isVolatile;
+    }
+
+    if (symbol->get_classParent(&parentClass) == S_OK)
+    {
+        if (parentClass->get_name(&bString) == S_OK)
         {
-            switch (checksumType)
-            {
-            case CHKSUM_TYPE_NONE:
-                result += "None";
+            data.parentClassName = QString::fromWCharArray(bString);
 
-                break;
+            SysFreeString(bString);
+        }
 
-            case CHKSUM_TYPE_MD5:
-                result += "MD5";
+        DWORD udtKind = 0;
 
-                break;
+        if (parentClass->get_udtKind(&udtKind) == S_OK)
+        {
+            UdtKind udtKind2 = static_cast<UdtKind>(udtKind);
 
-            case CHKSUM_TYPE_SHA1:
-                result += "SHA1";
+            switch (udtKind2)
+            {
+            case UdtStruct:
+                data.parentType = "struct";
 
                 break;
+            case UdtClass:
+                data.parentType = "class";
 
-            default:
-                result += QString("0x%1").arg(checksumType);
+                break;
+            case UdtUnion:
+                data.parentType = "union";
 
                 break;
-            }
+            case UdtInterface:
+                data.parentType = "interface";
 
-            if (cbChecksum != 0)
-            {
-                result += ": ";
+                break;
             }
         }
 
-        for (DWORD ib = 0; ib < cbChecksum; ib++)
-        {
-            result += QString("%1").arg(checksum[ib]);
-        }
-
-        result += ")";
+        parentClass->Release();
     }
 
-    return result;
-}
-
-QString PDB::GetLines()
-{
-    QString result;
-    IDiaEnumSymbols* enumSymbols;
-
-    if (FAILED(global->findChildren(SymTagCompiland, NULL, nsNone, &enumSymbols)))
+    if (access == 0 &&
+        !(data.dataKind == DataIsGlobal ||
+            data.dataKind == DataIsFileStatic ||
+            data.dataKind == DataIsConstant))
     {
-        return result;
+        data.parentType = "namespace";
     }
 
-    IDiaSymbol* compiland = nullptr;
-    ULONG celt = 0;
-
-    while (SUCCEEDED(enumSymbols->Next(1, &compiland, &celt)) && (celt == 1))
+    if (symbol->get_locationType(&locationType) == S_OK)
     {
-        IDiaEnumSymbols* enumFunction = nullptr;
+        data.locationType = static_cast<LocationType>(locationType);
+    }
 
-        if (SUCCEEDED(compiland->findChildren(SymTagFunction, NULL, nsNone, &enumFunction)))
-        {
-            IDiaSymbol* function;
+    data.location = GetLocation(symbol);
+    data.value = GetValue(symbol);
 
-            while (SUCCEEDED(enumFunction->Next(1, &function, &celt)) && (celt == 1))
-            {
-                DWORD symTag = 0, relativeVirtualAddress = 0;
-                BSTR bstrName = nullptr;
-                ULONGLONG length = 0;
-                IDiaEnumLineNumbers* lines = nullptr;
+    RecordType recordType = GetRecordType(symbol);
 
-                if ((function->get_symTag(&symTag) != S_OK) || (symTag != SymTagFunction))
-                {
-                    SendStatusMessage("ERROR - PrintLines() dwSymTag != SymTagFunction");
+    data.baseType = recordType.baseType;
 
-                    return result;
-                }
+    data.isTypeConst = recordType.isTypeConst;
+    data.isTypeVolatile = recordType.isTypeVolatile;
+    data.isPointerConst = recordType.isPointerConst;
+    data.isPointerVolatile = recordType.isPointerVolatile;
+    data.originalTypeName = recordType.originalTypeName;
+    data.typeName = recordType.typeName;
+    data.size = recordType.size;
+    data.isPointer = recordType.isPointer;
+    data.isReference = recordType.isReference;
+    data.pointerLevel = recordType.pointerLevel;
+    data.referenceLevel = recordType.referenceLevel;
+    data.isArray = recordType.isArray;
+    data.arrayCount = recordType.arrayCount;
+    data.functionReturnType = recordType.functionReturnType2;
+    data.functionParameters = recordType.functionParameters;
+    data.noType = recordType.noType;
+    data.isTypeNameOfEnum = recordType.isTypeNameOfEnum;
+    data.numberOfBits = data.length;
+    //data.isFunctionPointer = recordType.isFunctionPointer;
 
-                if (function->get_name(&bstrName) == S_OK)
-                {
-                    result += QString("%1\n\n").arg(QString::fromWCharArray(bstrName));
+    if (recordType.size > 0 && recordType.functionType)
+    {
+        data.isFunctionPointer = true;
+    }
 
-                    SysFreeString(bstrName);
-                }
+    //Sometimes DIA SDK won't undecorate name
+    if (data.name.length() > 0 && data.name.at(0) == '?')
+    {
+        if (options->useUndname)
+        {
+            std::string undecoratedName = peHeaderParser->UndecorateName(data.name.toStdString().c_str());
 
-                if (function->get_length(&length) != S_OK)
-                {
-                    SendStatusMessage("ERROR - PrintLines() get_length");
+            data.name = QString::fromStdString(undecoratedName);
+        }
+        else
+        {
+            std::string mangledName = data.name.toStdString().c_str();
 
-                    return result;
-                }
+            data.name = QString::fromStdString(SymbolDemangler::DemangleQualifiedName(mangledName));
+        }
+    }
 
-                if (function->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
-                {
-                    if (SUCCEEDED(diaSession->findLinesByRVA(relativeVirtualAddress, static_cast<DWORD>(length), &lines)))
-                    {
-                        result += GetLineInfo(lines);
+    FormatString(data.typeName);
+    FormatString(data.parentClassName);
 
-                        lines->Release();
-                    }
-                }
+    InternNames(&data);
 
-                else
-                {
-                    DWORD addressSection = 0, addressOffset = 0;
+    return data;
+}
 
-                    if ((function->get_addressSection(&addressSection) == S_OK) &&
-                        (function->get_addressOffset(&addressOffset) == S_OK))
-                    {
-                        if (SUCCEEDED(diaSession->findLinesByAddr(addressSection, addressOffset, static_cast<DWORD>(length), &lines)))
-                        {
-                            result += GetLineInfo(lines);
+BaseClass PDB::GetBaseClass(IDiaSymbol* symbol)
+{
+    ResolutionContext* context = GetResolutionContext();
+    BaseClass baseClass = {};
+    BSTR bString = nullptr;
+    DWORD access = 0, udtKind = 0, virtualBaseDispIndex = 0;
+    LONG offset = 0, virtualBasePointerOffset = 0;
+    ULONGLONG length = 0;
+    BOOL isVirtualBaseClass = 0, isIndirectVirtualBaseClass = 0, isConst = 0, isVolatile = 0;
+    IDiaSymbol* parentClass;
 
-                            lines->Release();
-                        }
-                    }
-                }
+    if (symbol->get_access(&access) == S_OK)
+    {
+        baseClass.access = static_cast<CV_access_e>(access);
+    }
 
-                function->Release();
+    if (symbol->get_name(&bString) == S_OK)
+    {
+        baseClass.name = QString::fromWCharArray(bString);
 
-                result += "\n";
-            }
+        SysFreeString(bString);
+    }
 
-            enumFunction->Release();
-        }
+    if (symbol->get_udtKind(&udtKind) == S_OK)
+    {
+        baseClass.udtKind = static_cast<UdtKind>(udtKind);
+    }
 
-        compiland->Release();
+    if (symbol->get_offset(&offset) == S_OK)
+    {
+        baseClass.offset = offset;
     }
 
-    enumSymbols->Release();
+    if (symbol->get_length(&length) == S_OK)
+    {
+        baseClass.length = length;
+    }
 
-    return result;
-}
+    if (symbol->get_virtualBaseClass(&isVirtualBaseClass) == S_OK)
+    {
+        baseClass.isVirtualBaseClass = isVirtualBaseClass;
+    }
 
-QString PDB::GetLineInfo(IDiaEnumLineNumbers* lines)
-{
-    QString result;
-    IDiaLineNumber* line = nullptr;
-    DWORD celt = 0;
-    DWORD relativeVirtualAddress = 0;
-    DWORD addressSection = 0;
-    DWORD addressOffset = 0;
-    DWORD lineNumber = 0;
-    DWORD srcID = 0;
-    DWORD length = 0;
-
-    DWORD lastSrcID = static_cast<DWORD>(-1);
-
-    while (SUCCEEDED(lines->Next(1, &line, &celt)) && (celt == 1))
+    if (symbol->get_indirectVirtualBaseClass(&isIndirectVirtualBaseClass) == S_OK)
     {
-        if ((line->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK) &&
-            (line->get_addressSection(&addressSection) == S_OK) &&
-            (line->get_addressOffset(&addressOffset) == S_OK) &&
-            (line->get_lineNumber(&lineNumber) == S_OK) &&
-            (line->get_sourceFileId(&srcID) == S_OK) &&
-            (line->get_length(&length) == S_OK))
-        {
-            QString line2;
-
-            line2.sprintf("\tline %u at [%08X][%04X:%08X], len = 0x%X", lineNumber, relativeVirtualAddress, addressSection,
-                addressOffset, length);
-
-            result += line2;
-
-            if (srcID != lastSrcID)
-            {
-                IDiaSourceFile* source = nullptr;
-
-                if (line->get_sourceFile(&source) == S_OK)
-                {
-                    result += GetSourceFileInfo(source);
-
-                    lastSrcID = srcID;
-
-                    source->Release();
-                }
-            }
-
-            line->Release();
-
-            result += "\n";
-        }
+        baseClass.isIndirectVirtualBaseClass = isIndirectVirtualBaseClass;
     }
 
-    return result;
-}
-
-QString PDB::GetLocation(IDiaSymbol* symbol)
-{
-    QString result;
-    DWORD locationType = 0;
-    DWORD relativeVirtualAddress = 0, addressSection = 0, addressOffset = 0, registerID = 0, bitPosition = 0, slot = 0;
-    LONG offset = 0;
-    ULONGLONG length = 0;
-    VARIANT variant = { VT_EMPTY };
-
-    if (symbol->get_locationType(&locationType) != S_OK)
+    if (symbol->get_virtualBaseDispIndex(&virtualBaseDispIndex) == S_OK)
     {
-        // It must be a symbol in optimized code
-
-        result = "Symbol is in optmized code.";
-
-        return result;
+        baseClass.virtualBaseDispIndex = virtualBaseDispIndex;
     }
 
-    LocationType locationType2 = static_cast<LocationType>(locationType);
-    QString relativeVirtualAddress2, addressSection2, addressOffset2, bitPosition2, slot2, offset2, length2;
-
-    switch (locationType2)
-    {
-    case LocIsStatic:
+    if (symbol->get_virtualBasePointerOffset(&virtualBasePointerOffset) == S_OK)
     {
-        if ((symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK) &&
-            (symbol->get_addressSection(&addressSection) == S_OK) &&
-            (symbol->get_addressOffset(&addressOffset) == S_OK))
-        {
-			relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
-			addressSection2 = QString::number(addressSection, 16).toUpper();
-			addressOffset2 = QString::number(addressOffset, 16).toUpper();
+        baseClass.virtualBasePointerOffset = virtualBasePointerOffset;
+    }
 
-            result = QString("%1, [0x%2][0x%3:0x%4]").arg(convertLocationTypeToString(locationType2)).arg(relativeVirtualAddress2)
-                .arg(addressSection2).arg(addressOffset2);
-        }
+    if (symbol->get_unalignedType(&isConst) == S_OK)
+    {
+        baseClass.isConst = isConst;
+    }
 
-        break;
+    if (symbol->get_volatileType(&isVolatile) == S_OK)
+    {
+        baseClass.isVolatile = isVolatile;
     }
-    case LocIsTLS:
-    case LocInMetaData:
-    case LocIsIlRel:
+
+    if (symbol->get_classParent(&parentClass) == S_OK)
     {
-        if ((symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK) &&
-            (symbol->get_addressSection(&addressSection) == S_OK) &&
-            (symbol->get_addressOffset(&addressOffset) == S_OK))
+        if (parentClass->get_name(&bString) == S_OK)
         {
-			relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
-			addressSection2 = QString::number(addressSection, 16).toUpper();
-			addressOffset2 = QString::number(addressOffset, 16).toUpper();
+            baseClass.parentClassName = QString::fromWCharArray(bString);
 
-            result = QString("%1, [0x%2][0x%3:0x%4]").arg(convertLocationTypeToString(locationType2)).arg(relativeVirtualAddress2)
-                .arg(addressSection2).arg(addressOffset2);
+            SysFreeString(bString);
         }
 
-        break;
+        parentClass->Release();
     }
-    case LocIsRegRel:
+
+    //Sometimes DIA SDK won't undecorate name
+    if (baseClass.name.at(0) == '?')
     {
-        if ((symbol->get_registerId(&registerID) == S_OK) &&
-            (symbol->get_offset(&offset) == S_OK))
+        if (options->useUndname)
         {
-            offset2 = QString::number(offset, 16).toUpper();
+            std::string undecoratedName = peHeaderParser->UndecorateName(baseClass.name.toStdString().c_str());
 
-            result = QString("%1 relative, [0x%2]").arg(QString::fromWCharArray(SzNameC7Reg(static_cast<USHORT>(registerID)))).arg(offset2);
+            baseClass.name = QString::fromStdString(undecoratedName);
         }
-
-        break;
-    }
-    case LocIsThisRel:
-    {
-        if (symbol->get_offset(&offset) == S_OK)
+        else
         {
-            offset2 = QString::number(offset, 16).toUpper();
+            std::string mangledName = baseClass.name.toStdString().c_str();
 
-            result = QString("this + 0x%1").arg(offset2);
+            baseClass.name = QString::fromStdString(SymbolDemangler::DemangleQualifiedName(mangledName));
         }
-
-        break;
     }
-    case LocIsBitField:
-    {
-        if ((symbol->get_offset(&offset) == S_OK) &&
-            (symbol->get_bitPosition(&bitPosition) == S_OK) &&
-            (symbol->get_length(&length) == S_OK))
-        {
-            offset2 = QString::number(offset, 16).toUpper();
-            bitPosition2 = QString::number(bitPosition, 16).toUpper();
-            length2 = QString::number(static_cast<ULONG>(length), 16).toUpper();
 
-            result = QString("this(bf) + 0x%1:0x%2 len(0x%3)").arg(offset2).arg(bitPosition2).arg(length2);
-        }
+    FormatString(baseClass.name);
+    FormatString(baseClass.parentClassName);
 
-        break;
-    }
-    case LocIsEnregistered:
+    if (context->DisplayIncludes())
     {
-        if (symbol->get_registerId(&registerID) == S_OK)
+        if (baseClass.parentClassName.length() == 0)
         {
-            result = QString("Enregistered %1").arg(SzNameC7Reg(static_cast<USHORT>(registerID)));
+            AddTypeNameToIncludesList(baseClass.name, context->parentClassName);
         }
-
-        break;
-    }
-    case LocIsSlot:
-    {
-        if (symbol->get_slot(&slot) == S_OK)
+        else
         {
-            slot2 = QString::number(slot, 16).toUpper();
-
-            result = QString("%1, [%2]").arg(convertLocationTypeToString(locationType2)).arg(slot2);
+            AddTypeNameToIncludesList(baseClass.name, baseClass.parentClassName);
         }
-
-        break;
     }
-    case LocIsConstant:
-    {
-        result = "Constant";
 
-        if (symbol->get_value(&variant) == S_OK)
-        {
-            result += convertVariantToString(variant);
+    InternNames(&baseClass);
 
-            VariantClear(static_cast<VARIANTARG*>(&variant));
-        }
+    return baseClass;
+}
 
-        break;
-    }
-    case LocIsNull:
-        break;
-    default:
-        result = QString("Error - invalid location type: 0x%1").arg(QString::number(locationType, 16).toUpper());
+/*
+* Type, class and member names repeat in many elements so they are replaced with strings from name arena,
+* declarations and prototypes are unique so they are kept as they are
+*/
+void PDB::InternNames(UDT* udt)
+{
+    udt->originalTypeName = NameArena::InternString(udt->originalTypeName);
+    udt->name = NameArena::InternString(udt->name);
+    udt->parentClassName = NameArena::InternString(udt->parentClassName);
+}
 
-        break;
-    }
+void PDB::InternNames(Function* function)
+{
+    function->name = NameArena::InternString(function->name);
+    function->parentClassName = NameArena::InternString(function->parentClassName);
+    function->originalParentClassName = NameArena::InternString(function->originalParentClassName);
+    function->originalReturnType = NameArena::InternString(function->originalReturnType);
+    function->returnType2 = NameArena::InternString(function->returnType2);
 
-    return result;
+    InternNames(&function->returnType1);
+    InternNames(&function->parameters);
+    InternNames(&function->originalParameters);
 }
 
-QString PDB::GetModules()
+void PDB::InternNames(Enum* enum1)
 {
-    QString modules;
-    IDiaEnumSymbols* enumSymbols = nullptr;
+    enum1->originalTypeName = NameArena::InternString(enum1->originalTypeName);
+    enum1->name = NameArena::InternString(enum1->name);
+    enum1->parentClassName = NameArena::InternString(enum1->parentClassName);
+}
 
-    modules += GetModuleNames().join("");
-    modules += "\n";
+void PDB::InternNames(Data* data)
+{
+    data->originalTypeName = NameArena::InternString(data->originalTypeName);
+    data->typeName = NameArena::InternString(data->typeName);
+    data->name = NameArena::InternString(data->name);
+    data->parentClassName = NameArena::InternString(data->parentClassName);
+    data->functionReturnType = NameArena::InternString(data->functionReturnType);
 
-    if (FAILED(global->findChildren(SymTagCompiland, NULL, nsNone, &enumSymbols)))
-    {
-        return modules;
-    }
+    InternNames(&data->functionParameters);
+}
 
-    IDiaSymbol* compiland = nullptr;
-    ULONG celt = 0;
+void PDB::InternNames(BaseClass* baseClass)
+{
+    baseClass->name = NameArena::InternString(baseClass->name);
+    baseClass->parentClassName = NameArena::InternString(baseClass->parentClassName);
+}
 
-    while (SUCCEEDED(enumSymbols->Next(1, &compiland, &celt)) && (celt == 1))
+void PDB::InternNames(QList<QString>* names)
+{
+    for (int i = 0; i < names->count(); i++)
     {
-        modules += "\nModule: ";
+        (*names)[i] = NameArena::InternString(names->at(i));
+    }
+}
 
-        BSTR bstrName;
+PublicSymbol PDB::GetPublicSymbol(IDiaSymbol* symbol)
+{
+    PublicSymbol publicSymbol = {};
+    BSTR bString = nullptr;
+    DWORD addressOffset = 0, addressSection = 0, locationType = 0, relativeVirtualAddress = 0;
+    BOOL isInCode = 0, isFunction = 0, isInManagedCode = 0, isInMSILCode = 0;
+    ULONGLONG length = 0;
 
-        if (compiland->get_name(&bstrName) != S_OK)
-        {
-            modules += "(???)";
-        }
+	if (symbol->get_name(&bString) == S_OK)
+	{
+        publicSymbol.decoratedName = QString::fromWCharArray(bString);
 
-        else
+		SysFreeString(bString);
+	}
+
+    if (options->useUndname)
+    {
+        if (symbol->get_undecoratedName(&bString) == S_OK)
         {
-            modules += QString::fromWCharArray(bstrName);
+            publicSymbol.undecoratedName = QString::fromWCharArray(bString);
 
-            SysFreeString(bstrName);
+            SysFreeString(bString);
         }
+    }
+    else
+    {
+		if (symbol->get_name(&bString) == S_OK)
+		{
+			std::string mangledName = QString::fromWCharArray(bString).toStdString();
 
-        modules += "\n\n";
+			publicSymbol.undecoratedName = QString::fromStdString(SymbolDemangler::Demangle(mangledName));
 
-        IDiaEnumSymbols* enumChildren = nullptr;
+            SysFreeString(bString);
+		}
+    }
 
-        if (SUCCEEDED(compiland->findChildren(SymTagNull, NULL, nsNone, &enumChildren)))
-        {
-            IDiaSymbol* symbol = nullptr;
-            ULONG celtChildren = 0;
+	if (symbol->get_addressOffset(&addressOffset) == S_OK)
+	{
+        publicSymbol.addressOffset = addressOffset;
+	}
 
-            while (SUCCEEDED(enumChildren->Next(1, &symbol, &celtChildren)) && (celtChildren == 1))
-            {
-				DWORD symTag;
+	if (symbol->get_addressSection(&addressSection) == S_OK)
+	{
+        publicSymbol.addressSection = addressSection;
+	}
 
-				if (symbol->get_symTag(&symTag) == S_OK)
-				{
-                    if (symTag == SymTagCompilandDetails)
-                    {
-                        modules += QString("Compiland details:\n%1\n").arg(GetCompilandDetails(symbol));
-                    }
-                    else if (symTag == SymTagCompilandEnv)
-                    {
-                        modules += QString("Compiland environment: %1\n").arg(GetCompilandEnvironment(symbol));
-                    }
-                    else if (symTag == SymTagExport)
-                    {
-                        modules += QString("Export: %1\n").arg(GetExportName(symbol));
-                    }
-				}
+	if (symbol->get_code(&isInCode) == S_OK)
+	{
+        publicSymbol.isInCode = isInCode;
+	}
 
-                symbol->Release();
-            }
+	if (symbol->get_function(&isFunction) == S_OK)
+	{
+        publicSymbol.isFunction = isFunction;
+	}
 
-            enumChildren->Release();
-        }
+	if (symbol->get_managed(&isInManagedCode) == S_OK)
+	{
+        publicSymbol.isInManagedCode = isInManagedCode;
+	}
 
-        compiland->Release();
+	if (symbol->get_msil(&isInMSILCode) == S_OK)
+	{
+        publicSymbol.isInMSILCode = isInMSILCode;
+	}
 
-        modules += "\n-------------------------------------------------";
-        modules += "-------------------------------------------------\n";
-    }
+	if (symbol->get_length(&length) == S_OK)
+	{
+        publicSymbol.length = length;
+	}
 
-    enumSymbols->Release();
+	if (symbol->get_locationType(&locationType) == S_OK)
+	{
+        publicSymbol.locationType = static_cast<LocationType>(locationType);
+	}
 
-    return modules;
+	if (symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
+	{
+        publicSymbol.relativeVirtualAddress = relativeVirtualAddress;
+	}
+
+    return publicSymbol;
 }
 
-QStringList PDB::GetModuleNames()
+QString PDB::GetSourceFilePath(IDiaSymbol* symbol)
 {
-    QStringList moduleNames;
-    IDiaEnumSymbols* enumSymbols = nullptr;
+    QString sourceFilePath;
+	ULONGLONG length = 0;
 
-    if (FAILED(global->findChildren(SymTagCompiland, NULL, nsNone, &enumSymbols)))
-    {
-        return moduleNames;
-    }
+	if (symbol->get_length(&length) != S_OK)
+	{
+        return sourceFilePath;
+	}
 
-    IDiaSymbol* compiland = nullptr;
-    ULONG celt = 0, moduleNumber = 1;
+    DWORD relativeVirtualAddress = 0;
+    IDiaEnumLineNumbers* lines = nullptr;
+    bool succeeded = false;
 
-    while (SUCCEEDED(enumSymbols->Next(1, &compiland, &celt)) && (celt == 1))
+	if (symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
+	{
+		if (SUCCEEDED(diaSession->findLinesByRVA(relativeVirtualAddress, static_cast<DWORD>(length), &lines)))
+		{
+            succeeded = true;
+		}
+	}
+	else
+	{
+		DWORD addressSection = 0;
+		DWORD addressOffset = 0;
+
+		if ((symbol->get_addressSection(&addressSection) == S_OK) &&
+			(symbol->get_addressOffset(&addressOffset) == S_OK))
+		{
+			if (SUCCEEDED(diaSession->findLinesByAddr(addressSection, addressOffset, static_cast<DWORD>(length), &lines)))
+			{
+                succeeded = true;
+			}
+		}
+	}
+
+    if (succeeded)
     {
-        BSTR bstrName;
+        IDiaLineNumber* line = nullptr;
+        DWORD sourceFileID = 0;
+        DWORD lastSourceFileID = (DWORD)(-1);
 
-        if (compiland->get_name(&bstrName) != S_OK)
-        {
-            SendStatusMessage("ERROR - Failed to get the compiland's name.");
+        if (lines->Item(0, &line) == S_OK &&
+            line->get_sourceFileId(&sourceFileID) == S_OK)
+		{
+			if (sourceFileID != lastSourceFileID)
+			{
+				IDiaSourceFile* sourceFile;
 
-            compiland->Release();
-            enumSymbols->Release();
+				if (line->get_sourceFile(&sourceFile) == S_OK)
+				{
+					BSTR fileName;
 
-            return moduleNames;
-        }
+					if (sourceFile->get_fileName(&fileName) == S_OK)
+					{
+						sourceFilePath = QString::fromWCharArray(fileName);
 
-        QString moduleNumber2 = QString("%1").arg(moduleNumber++, 4, 16).toUpper();
+						SysFreeString(fileName);
+					}
 
-        moduleNames.append(QString("%1 %2\n").arg(moduleNumber2).arg(QString::fromWCharArray(bstrName)));
+					sourceFile->Release();
+				}
+			}
 
-        SysFreeString(bstrName);
+            line->Release();
+		}
 
-        compiland->Release();
+        lines->Release();
     }
 
-    enumSymbols->Release();
-
-    return moduleNames;
+    return sourceFilePath;
 }
 
-QString PDB::GetCompilandDetails(IDiaSymbol* symbol)
+QString PDB::GetSourceFileInfo(IDiaSourceFile* source)
 {
-    QString compilandDetails;
-    DWORD language = 0, platform = 0;
-    BOOL editAndContinueEnabled = 0, hasDebugInfo = 0, isLTCG = 0, isDataAligned = 0, hasManagedCode = 0, hasSecurityChecks = 0;
-    BOOL isSdl, isHotpatchable = 0, isCVTCIL = 0, isMSILNetmodule = 0;
-    DWORD majorVersion = 0, minorVersion = 0, buildVersion = 0, qfeVersion = 0;
-    BSTR bstrCompilerName;
+    QString result;
+    BSTR bstrSourceName;
 
-    if (symbol->get_language(&language) == S_OK)
+    if (source->get_fileName(&bstrSourceName) == S_OK)
     {
-        compilandDetails += QString("\tLanguage: %1\n").arg(convertLanguageToString(static_cast<CV_CFL_LANG>(language)));
-    }
+        result += QString("\t%1").arg(QString::fromWCharArray(bstrSourceName));
 
-    if (symbol->get_platform(&platform) == S_OK)
-    {
-        compilandDetails += QString("\tTarget processor: %1\n").arg(convertPlatformToString(static_cast<CV_CPU_TYPE_e>(platform)));
+        SysFreeString(bstrSourceName);
     }
 
-    if (symbol->get_editAndContinueEnabled(&editAndContinueEnabled) == S_OK)
+    else
     {
-        if (editAndContinueEnabled)
-        {
-            compilandDetails += "\tCompiled for edit and continue: Yes\n";
-        }
-        else
-        {
-            compilandDetails += "\tCompiled for edit and continue: No\n";
-        }
+        SendStatusMessage("ERROR - PrintSourceFile() get_fileName");
+
+        return result;
     }
 
-    if (symbol->get_hasDebugInfo(&hasDebugInfo) == S_OK)
+    BYTE checksum[256] = {};
+    DWORD cbChecksum = sizeof(checksum);
+
+    if (source->get_checksum(cbChecksum, &cbChecksum, checksum) == S_OK)
     {
-        if (hasDebugInfo)
+        result += " (";
+
+        DWORD checksumType;
+
+        if (source->get_checksumType(&checksumType) == S_OK)
         {
-            compilandDetails += "\tCompiled without debugging info: No\n";
+            switch (checksumType)
+            {
+            case CHKSUM_TYPE_NONE:
+                result += "None";
+
+                break;
+
+            case CHKSUM_TYPE_MD5:
+                result += "MD5";
+
+                break;
+
+            case CHKSUM_TYPE_SHA1:
+                result += "SHA1";
+
+                break;
+
+            default:
+                result += QString("0x%1").arg(checksumType);
+
+                break;
+            }
+
+            if (cbChecksum != 0)
+            {
+                result += ": ";
+            }
         }
-        else
+
+        for (DWORD ib = 0; ib < cbChecksum; ib++)
         {
-            compilandDetails += "\tCompiled without debugging info: Yes\n";
+            result += QString("%1").arg(checksum[ib]);
         }
+
+        result += ")";
     }
 
-    if (symbol->get_isLTCG(&isLTCG) == S_OK)
+    return result;
+}
+
+QString PDB::GetLines()
+{
+    QString result;
+    IDiaEnumSymbols* enumSymbols;
+
+    if (FAILED(global->findChildren(SymTagCompiland, NULL, nsNone, &enumSymbols)))
     {
-        if (isLTCG)
-        {
-            compilandDetails += "\tCompiled with LTCG: Tes\n";
-        }
-        else
-        {
-            compilandDetails += "\tCompiled with LTCG: No\n";
-        }
+        return result;
     }
 
-    if (symbol->get_isDataAligned(&isDataAligned) == S_OK)
+    IDiaSymbol* compiland = nullptr;
+    ULONG celt = 0;
+
+    while (SUCCEEDED(enumSymbols->Next(1, &compiland, &celt)) && (celt == 1))
     {
-        if (isDataAligned)
-        {
-            compilandDetails += "\tCompiled with /bzalign: No\n";
-        }
-        else
+        IDiaEnumSymbols* enumFunction = nullptr;
+
+        if (SUCCEEDED(compiland->findChildren(SymTagFunction, NULL, nsNone, &enumFunction)))
         {
-            compilandDetails += "\tCompiled with /bzalign: Yes\n";
-        }
-    }
+            IDiaSymbol* function;
 
-    if (symbol->get_hasManagedCode(&hasManagedCode) == S_OK)
-    {
-        if (hasManagedCode)
-        {
-            compilandDetails += "\tManaged code present: Yes\n";
-        }
+            while (SUCCEEDED(enumFunction->Next(1, &function, &celt)) && (celt == 1))
+            {
+                DWORD symTag = 0, relativeVirtualAddress = 0;
+                BSTR bstrName = nullptr;
+                ULONGLONG length = 0;
+                IDiaEnumLineNumbers* lines = nullptr;
 
-        else
-        {
-            compilandDetails += "\tManaged code present: No\n";
-        }
-    }
+                if ((function->get_symTag(&symTag) != S_OK) || (symTag != SymTagFunction))
+                {
+                    SendStatusMessage("ERROR - PrintLines() dwSymTag != SymTagFunction");
 
-    if (symbol->get_hasSecurityChecks(&hasSecurityChecks) == S_OK)
-    {
-        if (hasSecurityChecks)
-        {
-            compilandDetails += "\tCompiled with /GS: Yes\n";
-        }
+                    return result;
+                }
 
-        else
-        {
-            compilandDetails += "\tCompiled with /GS: No\n";
-        }
-    }
+                if (function->get_name(&bstrName) == S_OK)
+                {
+                    result += QString("%1\n\n").arg(QString::fromWCharArray(bstrName));
 
-    if (symbol->get_isSdl(&isSdl) == S_OK)
-    {
-        if (isSdl)
-        {
-            compilandDetails += "\tCompiled with /sdl: Yes\n";
-        }
+                    SysFreeString(bstrName);
+                }
 
-        else
-        {
-            compilandDetails += "\tCompiled with /sdl: No\n";
-        }
-    }
+                if (function->get_length(&length) != S_OK)
+                {
+                    SendStatusMessage("ERROR - PrintLines() get_length");
 
-    if (symbol->get_isHotpatchable(&isHotpatchable) == S_OK)
-    {
-        if (isHotpatchable)
-        {
-            compilandDetails += "\tCompiled with /hotpatch: Yes\n";
-        }
+                    return result;
+                }
 
-        else
-        {
-            compilandDetails += "\tCompiled with /hotpatch: No\n";
-        }
-    }
+                if (function->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
+                {
+                    if (SUCCEEDED(diaSession->findLinesByRVA(relativeVirtualAddress, static_cast<DWORD>(length), &lines)))
+                    {
+                        result += GetLineInfo(lines);
 
-    if (symbol->get_isCVTCIL(&isCVTCIL) == S_OK)
-    {
-        if (isCVTCIL)
-        {
-            compilandDetails += "\tConverted by CVTCIL: Yes\n";
-        }
+                        lines->Release();
+                    }
+                }
 
-        else
-        {
-            compilandDetails += "\tConverted by CVTCIL: No\n";
-        }
-    }
+                else
+                {
+                    DWORD addressSection = 0, addressOffset = 0;
 
-    if (symbol->get_isMSILNetmodule(&isMSILNetmodule) == S_OK)
-    {
-        if (isMSILNetmodule)
-        {
-            compilandDetails += "\tMSIL module: Yes\n";
-        }
+                    if ((function->get_addressSection(&addressSection) == S_OK) &&
+                        (function->get_addressOffset(&addressOffset) == S_OK))
+                    {
+                        if (SUCCEEDED(diaSession->findLinesByAddr(addressSection, addressOffset, static_cast<DWORD>(length), &lines)))
+                        {
+                            result += GetLineInfo(lines);
 
-        else
-        {
-            compilandDetails += "\tMSIL module: No\n";
-        }
-    }
+                            lines->Release();
+                        }
+                    }
+                }
 
-    if ((symbol->get_frontEndMajor(&majorVersion) == S_OK) &&
-        (symbol->get_frontEndMinor(&minorVersion) == S_OK) &&
-        (symbol->get_frontEndBuild(&buildVersion) == S_OK))
-    {
-        compilandDetails += QString("\tFrontend Version: Major = %1, Minor = %2, Build = %3").arg(majorVersion)
-            .arg(minorVersion).arg(buildVersion);
+                function->Release();
 
-        if (symbol->get_frontEndQFE(&qfeVersion) == S_OK)
-        {
-            compilandDetails += QString(", QFE = %1").arg(qfeVersion);
+                result += "\n";
+            }
+
+            enumFunction->Release();
         }
 
-        compilandDetails += "\n";
+        compiland->Release();
     }
 
-    if ((symbol->get_backEndMajor(&majorVersion) == S_OK) &&
-        (symbol->get_backEndMinor(&minorVersion) == S_OK) &&
-        (symbol->get_backEndBuild(&buildVersion) == S_OK))
-    {
-        compilandDetails += QString("\tBackend Version: Major = %1, Minor = %2, Build = %3").arg(majorVersion)
-            .arg(minorVersion).arg(buildVersion);
+    enumSymbols->Release();
 
-        if (symbol->get_backEndQFE(&qfeVersion) == S_OK)
-        {
-            compilandDetails += QString(", QFE = %1").arg(qfeVersion);
-        }
+    return result;
+}
 
-        compilandDetails += "\n";
-    }
+QString PDB::GetLineInfo(IDiaEnumLineNumbers* lines)
+{
+    QString result;
+    IDiaLineNumber* line = nullptr;
+    DWORD celt = 0;
+    DWORD relativeVirtualAddress = 0;
+    DWORD addressSection = 0;
+    DWORD addressOffset = 0;
+    DWORD lineNumber = 0;
+    DWORD srcID = 0;
+    DWORD length = 0;
 
-    if (symbol->get_compilerName(&bstrCompilerName) == S_OK)
+    DWORD lastSrcID = static_cast<DWORD>(-1);
+
+    while (SUCCEEDED(lines->Next(1, &line, &celt)) && (celt == 1))
     {
-        if (bstrCompilerName)
+        if ((line->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK) &&
+            (line->get_addressSection(&addressSection) == S_OK) &&
+            (line->get_addressOffset(&addressOffset) == S_OK) &&
+            (line->get_lineNumber(&lineNumber) == S_OK) &&
+            (line->get_sourceFileId(&srcID) == S_OK) &&
+            (line->get_length(&length) == S_OK))
         {
-            compilandDetails += QString("\tVersion std::string: %1").arg(QString::fromWCharArray(bstrCompilerName));
-
-            SysFreeString(bstrCompilerName);
-        }
-    }
-
-    compilandDetails += "\n";
+            QString line2;
 
-    return compilandDetails;
-}
+            line2.sprintf("\tline %u at [%08X][%04X:%08X], len = 0x%X", lineNumber, relativeVirtualAddress, addressSection,
+                addressOffset, length);
 
-QString PDB::GetCompilandEnvironment(IDiaSymbol* symbol)
-{
-    QString compilandEnvironment;
-    BSTR bstrName;
+            result += line2;
 
-    if (symbol->get_name(&bstrName) == S_OK)
-    {
-        compilandEnvironment += QString::fromWCharArray(bstrName);
+            if (srcID != lastSrcID)
+            {
+                IDiaSourceFile* source = nullptr;
 
-        SysFreeString(bstrName);
-    }
-    else
-    {
-        compilandEnvironment += "(none)";
-    }
+                if (line->get_sourceFile(&source) == S_OK)
+                {
+                    result += GetSourceFileInfo(source);
 
-    compilandEnvironment += " =";
+                    lastSrcID = srcID;
 
-    VARIANT variant = { VT_EMPTY };
+                    source->Release();
+                }
+            }
 
-	if (symbol->get_value(&variant) == S_OK)
-	{
-        compilandEnvironment += convertVariantToString(variant);
+            line->Release();
 
-        VariantClear(static_cast<VARIANTARG*>(&variant));
-	}
+            result += "\n";
+        }
+    }
 
-    return compilandEnvironment;
+    return result;
 }
 
-QString PDB::GetExportName(IDiaSymbol* symbol)
+QString PDB::GetLocation(IDiaSymbol* symbol)
 {
     QString result;
-    BSTR bstrName;
-    BSTR bstrUndName;
+    DWORD locationType = 0;
+    DWORD relativeVirtualAddress = 0, addressSection = 0, addressOffset = 0, registerID = 0, bitPosition = 0, slot = 0;
+    LONG offset = 0;
+    ULONGLONG length = 0;
+    VARIANT variant = { VT_EMPTY };
 
-    if (symbol->get_name(&bstrName) != S_OK)
+    if (symbol->get_locationType(&locationType) != S_OK)
     {
-        result += "(none)";
+        // It must be a symbol in optimized code
+
+        result = "Symbol is in optmized code.";
 
         return result;
     }
 
-    if (options->useUndname)
+    LocationType locationType2 = static_cast<LocationType>(locationType);
+    QString relativeVirtualAddress2, addressSection2, addressOffset2, bitPosition2, slot2, offset2, length2;
+
+    switch (locationType2)
     {
-        if (symbol->get_undecoratedName(&bstrUndName) == S_OK)
+    case LocIsStatic:
+    {
+        if ((symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK) &&
+            (symbol->get_addressSection(&addressSection) == S_OK) &&
+            (symbol->get_addressOffset(&addressOffset) == S_OK))
         {
-            if (wcscmp(bstrName, bstrUndName) == 0)
-            {
-                result += QString("%1").arg(QString::fromWCharArray(bstrName));
-            }
-            else
-            {
-                result += QString("%1(%2)").arg(QString::fromWCharArray(bstrUndName)).arg(QString::fromWCharArray(bstrName));
-            }
+			relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
+			addressSection2 = QString::number(addressSection, 16).toUpper();
+			addressOffset2 = QString::number(addressOffset, 16).toUpper();
 
-            SysFreeString(bstrUndName);
+            result = QString("%1, [0x%2][0x%3:0x%4]").arg(convertLocationTypeToString(locationType2)).arg(relativeVirtualAddress2)
+                .arg(addressSection2).arg(addressOffset2);
         }
-		else
-		{
-			result += QString("%1").arg(QString::fromWCharArray(bstrName));
-		}
+
+        break;
     }
-    else
+    case LocIsTLS:
+    case LocInMetaData:
+    case LocIsIlRel:
     {
-		std::string mangledName = QString::fromWCharArray(bstrName).toStdString();
-		std::string rest;
-
-        std::string demangledName = msvcDemangler.DemangleSymbol(mangledName, rest);
-
-        if (mangledName == demangledName)
-		{
-			result += QString("%1").arg(QString::fromStdString(mangledName));
-		}
-        else
+        if ((symbol->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK) &&
+            (symbol->get_addressSection(&addressSection) == S_OK) &&
+            (symbol->get_addressOffset(&addressOffset) == S_OK))
         {
-            result += QString("%1(%2)").arg(QString::fromStdString(demangledName)).arg(QString::fromStdString(mangledName));
-        }
-    }
-
-    SysFreeString(bstrName);
-
-    return result;
-}
+			relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
+			addressSection2 = QString::number(addressSection, 16).toUpper();
+			addressOffset2 = QString::number(addressOffset, 16).toUpper();
 
-RecordType PDB::GetType(IDiaSymbol* symbol)
-{
-    RecordType recordType = {};
-    DWORD symTag;
+            result = QString("%1, [0x%2][0x%3:0x%4]").arg(convertLocationTypeToString(locationType2)).arg(relativeVirtualAddress2)
+                .arg(addressSection2).arg(addressOffset2);
+        }
 
-    if (!symbol || symbol->get_symTag(&symTag) != S_OK)
-    {
-        return recordType;
+        break;
     }
-
-    switch (symTag)
-    {
-    case SymTagBaseType:
+    case LocIsRegRel:
     {
-        BaseType baseType = GetBaseType(symbol);
-
-        recordType.size = baseType.length;
-        recordType.isTypeConst = baseType.isConst;
-        recordType.isTypeVolatile = baseType.isVolatile;
-        recordType.baseType = baseType.type;
-
-        switch (recordType.baseType)
+        if ((symbol->get_registerId(&registerID) == S_OK) &&
+            (symbol->get_offset(&offset) == S_OK))
         {
-        case 0: 
-            recordType.typeName = "<btNoType>";
-            recordType.noType = true;
+            offset2 = QString::number(offset, 16).toUpper();
 
-            break;
-        case 1: recordType.typeName = "void"; break;
-        case 2: recordType.typeName = "char"; break;
-        case 3: recordType.typeName = "wchar_t"; break;
-        case 4: recordType.typeName = "signed char"; break;
-        case 5: recordType.typeName = "unsigned char"; break;
-        case 6: recordType.typeName = "int"; break;
-        case 7: recordType.typeName = "unsigned int"; break;
-        case 8: recordType.typeName = "float"; break;
-        case 9: recordType.typeName = "BCD"; break;
-        case 10: recordType.typeName = "bool"; break;
-        case 11: recordType.typeName = "short"; break;
-        case 12: recordType.typeName = "unsigned short"; break;
-        case 13: recordType.typeName = "long"; break;
-        case 14: recordType.typeName = "unsigned long"; break;
-        case 15: recordType.typeName = "__int8"; break;
-        case 16: recordType.typeName = "__int16"; break;
-        case 17: recordType.typeName = "__int32"; break;
-        case 18: recordType.typeName = "__int64"; break;
-        case 19: recordType.typeName = "__int128"; break;
-        case 20: recordType.typeName = "unsigned __int8"; break;
-        case 21: recordType.typeName = "unsigned __int16"; break;
-        case 22: recordType.typeName = "unsigned __int32"; break;
-        case 23: recordType.typeName = "unsigned __int64"; break;
-        case 24: recordType.typeName = "unsigned __int128"; break;
-        case 25: recordType.typeName = "CURRENCY"; break;
-        case 26: recordType.typeName = "DATE"; break;
-        case 27: recordType.typeName = "VARIANT"; break;
-        case 28: recordType.typeName = "COMPLEX"; break;
-        case 29: recordType.typeName = "BIT"; break;
-        case 30: recordType.typeName = "BSTR"; break;
-        case 31: recordType.typeName = "HRESULT"; break;
-        case 32: recordType.typeName = "char16_t"; break;
-        case 33: recordType.typeName = "char32_t"; break;
+            result = QString("%1 relative, [0x%2]").arg(QString::fromWCharArray(SzNameC7Reg(static_cast<USHORT>(registerID)))).arg(offset2);
         }
 
-        if ((recordType.baseType == 8) && (recordType.size != 4))
+        break;
+    }
+    case LocIsThisRel:
+    {
+        if (symbol->get_offset(&offset) == S_OK)
         {
-            switch (recordType.size)
-            {
-            case 8: recordType.typeName = "double"; break;
-            case 12: recordType.typeName = "long double"; break;
-            }
-        }
+            offset2 = QString::number(offset, 16).toUpper();
 
-        if (((recordType.baseType == 7) || (recordType.baseType == 14)) && (recordType.size != 4)) // "unsigned int"
-        {
-            switch (recordType.size)
-            {
-            case 1: recordType.typeName = "unsigned char"; break;
-            case 2: recordType.typeName = "unsigned short"; break;
-            case 4: recordType.typeName = "unsigned int"; break;
-            case 8: recordType.typeName = "unsigned long long"; break;
-            }
+            result = QString("this + 0x%1").arg(offset2);
         }
 
-        if (((recordType.baseType == 6) || (recordType.baseType == 13)) && (recordType.size != 4)) // "int"
+        break;
+    }
+    case LocIsBitField:
+    {
+        if ((symbol->get_offset(&offset) == S_OK) &&
+            (symbol->get_bitPosition(&bitPosition) == S_OK) &&
+            (symbol->get_length(&length) == S_OK))
         {
-            switch (recordType.size)
-            {
-            case 1: recordType.typeName = "char"; break;
-            case 2: recordType.typeName = "short"; break;
-            case 4: recordType.typeName = "int"; break;
-            case 8: recordType.typeName = "long long"; break;
-            }
+            offset2 = QString::number(offset, 16).toUpper();
+            bitPosition2 = QString::number(bitPosition, 16).toUpper();
+            length2 = QString::number(static_cast<ULONG>(length), 16).toUpper();
+
+            result = QString("this(bf) + 0x%1:0x%2 len(0x%3)").arg(offset2).arg(bitPosition2).arg(length2);
         }
 
         break;
     }
-    case SymTagUDT:
+    case LocIsEnregistered:
     {
-        UDT udt = GetUDT(symbol);
-
-        recordType.size = udt.length;
-        recordType.isTypeConst = udt.isConst;
-        recordType.isTypeVolatile = udt.isVolatile;
-        recordType.originalTypeName = udt.originalTypeName;
-        recordType.typeName = udt.name;
-        recordType.noType = false;
-
-        IDiaSymbol* parentClass;
-        BSTR bString;
-
-		if (symbol->get_classParent(&parentClass) == S_OK)
-		{
-			if (parentClass->get_name(&bString) == S_OK)
-			{
-				udt.parentClassName = QString::fromWCharArray(bString);
-
-				SysFreeString(bString);
-			}
-
-			parentClass->Release();
-		}
+        if (symbol->get_registerId(&registerID) == S_OK)
+        {
+            result = QString("Enregistered %1").arg(SzNameC7Reg(static_cast<USHORT>(registerID)));
+        }
 
         break;
     }
-    case SymTagPointerType:
+    case LocIsSlot:
     {
-        PointerType pointerType = GetPointerType(symbol);
-        IDiaSymbol* type;
-
-        if (symbol->get_type(&type) == S_OK)
+        if (symbol->get_slot(&slot) == S_OK)
         {
-            recordType = GetType(type);
-
-            /*
-            * Don't check if data type is const or volatile in case of reference
-            * because value of reference can't be changed so references are already treated as const
-            */
-            if (pointerType.isReference)
-            {
-                recordType.isReference = true;
-                recordType.referenceLevel++;
-            }
-            else
-            {
-                recordType.isPointer = true;
-                recordType.isPointerConst = pointerType.isConst;
-                recordType.isPointerVolatile = pointerType.isVolatile;
-                recordType.pointerLevel++;
-            }
-
-            recordType.size = pointerType.length;
+            slot2 = QString::number(slot, 16).toUpper();
 
-            type->Release();
+            result = QString("%1, [%2]").arg(convertLocationTypeToString(locationType2)).arg(slot2);
         }
 
         break;
     }
-    case SymTagArrayType:
+    case LocIsConstant:
     {
-        ArrayType arrayType = GetArrayType(symbol);
-        IDiaSymbol* type;
+        result = "Constant";
 
-        if (symbol->get_type(&type) == S_OK)
+        if (symbol->get_value(&variant) == S_OK)
         {
-            recordType = GetType(type);
-            recordType.isArray = true;
-            recordType.arrayCount.append(arrayType.count);
-            recordType.size *= arrayType.count;
-
-            recordType.isTypeConst = arrayType.isConst;
-            recordType.isTypeVolatile = arrayType.isVolatile;
+            result += convertVariantToString(variant);
 
-            type->Release();
+            VariantClear(static_cast<VARIANTARG*>(&variant));
         }
 
         break;
     }
-    case SymTagEnum:
-    {
-        Enum enumType = GetEnum(symbol);
-
-        recordType.size = enumType.length;
-        recordType.isTypeConst = enumType.isConst;
-        recordType.isTypeVolatile = enumType.isVolatile;
-        recordType.originalTypeName = enumType.originalTypeName;
-        recordType.typeName = enumType.name;
-        recordType.noType = false;
-        recordType.isTypeNameOfEnum = true;
+    case LocIsNull:
+        break;
+    default:
+        result = QString("Error - invalid location type: 0x%1").arg(QString::number(locationType, 16).toUpper());
 
         break;
     }
-    case SymTagFunctionType:
-    {
-        RecordType returnType = GetRecordType(symbol);
-        FunctionType functionType = GetFunctionType(symbol);
 
-        returnType.callingConvention = functionType.callingConvention;
-
-        if (returnType.size > 0 && returnType.functionType)
-        {
-            returnType.isFunctionPointer = true;
-        }
+    return result;
+}
 
-        Data data = ConvertRecordTypeToData(const_cast<RecordType*>(&returnType));
-        static const DataOptions dataOptions = { false, true };
+QString PDB::GetModules()
+{
+    QString modules;
+    IDiaEnumSymbols* enumSymbols = nullptr;
 
-        recordType.functionReturnType1 = data;
-        recordType.functionReturnType2 = DataTypeToString(const_cast<Data*>(&data), &dataOptions);
+    modules += GetModuleNames().join("");
+    modules += "\n";
 
-        if (returnType.originalTypeName.length() > 0)
-        {
-            bool removeScopeOperator = options->removeScopeResolutionOperator;
+    if (FAILED(global->findChildren(SymTagCompiland, NULL, nsNone, &enumSymbols)))
+    {
+        return modules;
+    }
 
-            options->removeScopeResolutionOperator = false;
-            data.typeName = returnType.originalTypeName;
+    IDiaSymbol* compiland = nullptr;
+    ULONG celt = 0;
 
-            recordType.originalFunctionReturnType = DataTypeToString(const_cast<Data*>(&data), &dataOptions);
-
-            options->removeScopeResolutionOperator = removeScopeOperator;
-        }
-        else
-        {
-            recordType.originalFunctionReturnType = recordType.functionReturnType2;
-        }
+    while (SUCCEEDED(enumSymbols->Next(1, &compiland, &celt)) && (celt == 1))
+    {
+        modules += "\nModule: ";
 
-        recordType.isFunctionConst = functionType.isConst;
-        recordType.isFunctionVolatile = functionType.isVolatile;
-        recordType.functionType = true;
-        recordType.callingConvention = functionType.callingConvention;
-        recordType.parametersCount = functionType.parametersCount;
+        BSTR bstrName;
 
-        if (recordType.size > 0)
+        if (compiland->get_name(&bstrName) != S_OK)
         {
-            recordType.isFunctionPointer = true;
+            modules += "(???)";
         }
 
-        if (returnType.isFunctionPointer)
+        else
         {
-            recordType.functionReturnsFunctionPointer = true;
+            modules += QString::fromWCharArray(bstrName);
+
+            SysFreeString(bstrName);
         }
 
-        IDiaEnumSymbols* enumSymbols;
+        modules += "\n\n";
 
-        if (symbol->findChildren(SymTagNull, nullptr, nsNone, &enumSymbols) == S_OK)
+        IDiaEnumSymbols* enumChildren = nullptr;
+
+        if (SUCCEEDED(compiland->findChildren(SymTagNull, NULL, nsNone, &enumChildren)))
         {
-            LONG count;
+            IDiaSymbol* symbol = nullptr;
+            ULONG celtChildren = 0;
 
-            if (enumSymbols->get_Count(&count) == S_OK)
+            while (SUCCEEDED(enumChildren->Next(1, &symbol, &celtChildren)) && (celtChildren == 1))
             {
-                if (count)
-                {
-                    IDiaSymbol* symbol;
-                    ULONG celt = 0;
+				DWORD symTag;
 
-                    while (SUCCEEDED(enumSymbols->Next(1, &symbol, &celt)) && (celt == 1))
+				if (symbol->get_symTag(&symTag) == S_OK)
+				{
+                    if (symTag == SymTagCompilandDetails)
                     {
-                        RecordType recordType2 = GetRecordType(symbol);
+                        modules += QString("Compiland details:\n%1\n").arg(GetCompilandDetails(symbol));
+                    }
+                    else if (symTag == SymTagCompilandEnv)
+                    {
+                        modules += QString("Compiland environment: %1\n").arg(GetCompilandEnvironment(symbol));
+                    }
+                    else if (symTag == SymTagExport)
+                    {
+                        modules += QString("Export: %1\n").arg(GetExportName(symbol));
+                    }
+				}
 
-                        symbol->Release();
+                symbol->Release();
+            }
 
-                        if (recordType2.size > 0 && recordType2.functionType)
-                        {
-                            recordType2.isFunctionPointer = true;
-                        }
+            enumChildren->Release();
+        }
 
-                        if (recordType2.noType)
-                        {
-                            recordType.isVariadicFunction = true;
-                        }
+        compiland->Release();
 
-                        Data data2 = ConvertRecordTypeToData(const_cast<RecordType*>(&recordType2));
-                        static const DataOptions dataOptions = { true, false };
-                        QString parameter = DataTypeToString(const_cast<Data*>(&data2), &dataOptions);
+        modules += "\n-------------------------------------------------";
+        modules += "-------------------------------------------------\n";
+    }
 
-                        recordType.functionParameters.append(parameter);
+    enumSymbols->Release();
 
-                        if (recordType2.originalTypeName.length() > 0)
-                        {
-                            bool removeScopeOperator = options->removeScopeResolutionOperator;
+    return modules;
+}
 
-                            options->removeScopeResolutionOperator = false;
-                            data2.typeName = recordType2.originalTypeName;
+QStringList PDB::GetModuleNames()
+{
+    QStringList moduleNames;
+    IDiaEnumSymbols* enumSymbols = nullptr;
 
-                            recordType.originalFunctionParameters.append(DataTypeToString(const_cast<Data*>(&data2), &dataOptions));
+    if (FAILED(global->findChildren(SymTagCompiland, NULL, nsNone, &enumSymbols)))
+    {
+        return moduleNames;
+    }
 
-                            options->removeScopeResolutionOperator = removeScopeOperator;
-                        }
-                        else
-                        {
-                            recordType.originalFunctionParameters.append(parameter);
-                        }
-                    }
-                }
-            }
+    IDiaSymbol* compiland = nullptr;
+    ULONG celt = 0, moduleNumber = 1;
+
+    while (SUCCEEDED(enumSymbols->Next(1, &compiland, &celt)) && (celt == 1))
+    {
+        BSTR bstrName;
+
+        if (compiland->get_name(&bstrName) != S_OK)
+        {
+            SendStatusMessage("ERROR - Failed to get the compiland's name.");
 
+            compiland->Release();
             enumSymbols->Release();
+
+            return moduleNames;
         }
 
-        break;
-    }
-    default:
-        emit SendStatusMessage("Unknown Type.");
+        QString moduleNumber2 = QString("%1").arg(moduleNumber++, 4, 16).toUpper();
 
-        break;
+        moduleNames.append(QString("%1 %2\n").arg(moduleNumber2).arg(QString::fromWCharArray(bstrName)));
+
+        SysFreeString(bstrName);
+
+        compiland->Release();
     }
 
-    return recordType;
+    enumSymbols->Release();
+
+    return moduleNames;
 }
 
-QString PDB::DataTypeToString(const Data* data, const DataOptions* dataOptions)
+QString PDB::GetCompilandDetails(IDiaSymbol* symbol)
 {
-    QString result = "";
+    QString compilandDetails;
+    DWORD language = 0, platform = 0;
+    BOOL editAndContinueEnabled = 0, hasDebugInfo = 0, isLTCG = 0, isDataAligned = 0, hasManagedCode = 0, hasSecurityChecks = 0;
+    BOOL isSdl, isHotpatchable = 0, isCVTCIL = 0, isMSILNetmodule = 0;
+    DWORD majorVersion = 0, minorVersion = 0, buildVersion = 0, qfeVersion = 0;
+    BSTR bstrCompilerName;
 
-    if (data->dataKind == DataIsStaticMember)
+    if (symbol->get_language(&language) == S_OK)
     {
-        if (options->declareStaticVariablesWithInlineKeyword)
-        {
-            result += "inline ";
-        }
-
-        result += "static ";
+        compilandDetails += QString("\tLanguage: %1\n").arg(convertLanguageToString(static_cast<CV_CFL_LANG>(language)));
     }
 
-    if (data->isTypeConst && options->includeConstKeyword)
+    if (symbol->get_platform(&platform) == S_OK)
     {
-        result += "const ";
+        compilandDetails += QString("\tTarget processor: %1\n").arg(convertPlatformToString(static_cast<CV_CPU_TYPE_e>(platform)));
     }
 
-    if (data->isTypeVolatile && options->includeVolatileKeyword)
+    if (symbol->get_editAndContinueEnabled(&editAndContinueEnabled) == S_OK)
     {
-        result += "volatile ";
+        if (editAndContinueEnabled)
+        {
+            compilandDetails += "\tCompiled for edit and continue: Yes\n";
+        }
+        else
+        {
+            compilandDetails += "\tCompiled for edit and continue: No\n";
+        }
     }
 
-    if (!data->unnamedType)
+    if (symbol->get_hasDebugInfo(&hasDebugInfo) == S_OK)
     {
-        QString typeName = data->typeName;
-
-        if (options->displayIncludes && !data->isVTablePointer && !data->noType)
+        if (hasDebugInfo)
         {
-            AddTypeNameToIncludesList(typeName, parentClassName);
+            compilandDetails += "\tCompiled without debugging info: No\n";
         }
-
-        if (options->removeScopeResolutionOperator && typeName.contains("::"))
+        else
         {
-            if (data->parentClassName.length() == 0)
-            {
-                RemoveScopeResolutionOperators(typeName, parentClassName);
-            }
-            else
-            {
-                RemoveScopeResolutionOperators(typeName, data->parentClassName);
-            }
+            compilandDetails += "\tCompiled without debugging info: Yes\n";
         }
-
-        result += typeName;
     }
 
-    if (data->isFunctionPointer)
+    if (symbol->get_isLTCG(&isLTCG) == S_OK)
     {
-        result += QString("%1 (").arg(data->functionReturnType);
-
-        if (options->displayCallingConventionForFunctionPointers)
+        if (isLTCG)
         {
-            result += convertCallingConventionToString(data->callingConvention);
+            compilandDetails += "\tCompiled with LTCG: Tes\n";
+        }
+        else
+        {
+            compilandDetails += "\tCompiled with LTCG: No\n";
         }
     }
 
-    if (data->isPointer)
+    if (symbol->get_isDataAligned(&isDataAligned) == S_OK)
     {
-        for (int i = 0; i < data->pointerLevel; i++)
+        if (isDataAligned)
         {
-            result += "*";
+            compilandDetails += "\tCompiled with /bzalign: No\n";
+        }
+        else
+        {
+            compilandDetails += "\tCompiled with /bzalign: Yes\n";
         }
     }
 
-    if (data->isReference)
+    if (symbol->get_hasManagedCode(&hasManagedCode) == S_OK)
     {
-        for (int i = 0; i < data->referenceLevel; i++)
+        if (hasManagedCode)
         {
-            result += "&";
+            compilandDetails += "\tManaged code present: Yes\n";
         }
-    }
 
-    if (data->isPointerConst && options->includeConstKeyword)
-    {
-        result += " const";
+        else
+        {
+            compilandDetails += "\tManaged code present: No\n";
+        }
     }
 
-    if (data->isPointerVolatile && options->includeVolatileKeyword)
+    if (symbol->get_hasSecurityChecks(&hasSecurityChecks) == S_OK)
     {
-        result += " volatile";
-    }
+        if (hasSecurityChecks)
+        {
+            compilandDetails += "\tCompiled with /GS: Yes\n";
+        }
 
-    if (!data->isFunctionPointer &&
-        !dataOptions->isParameter &&
-        !dataOptions->isReturnType &&
-        result.length() > 0)
-    {
-        result += " ";
+        else
+        {
+            compilandDetails += "\tCompiled with /GS: No\n";
+        }
     }
 
-    QString name = data->name;
-
-    if (options->modifyVariableNames)
+    if (symbol->get_isSdl(&isSdl) == S_OK)
     {
-        name = ModifyNamingCovention(name, false, false, true);
-    }
+        if (isSdl)
+        {
+            compilandDetails += "\tCompiled with /sdl: Yes\n";
+        }
 
-    if (data->isFunctionPointer)
-    {
-        result += QString("%1)").arg(name);
+        else
+        {
+            compilandDetails += "\tCompiled with /sdl: No\n";
+        }
     }
-    else
+
+    if (symbol->get_isHotpatchable(&isHotpatchable) == S_OK)
     {
-        if (!dataOptions->isParameter && !dataOptions->isReturnType)
+        if (isHotpatchable)
         {
-            if (result.length() == 0 && name.length() > 0)
-            {
-                result += " ";
-            }
+            compilandDetails += "\tCompiled with /hotpatch: Yes\n";
+        }
 
-            result += name;
+        else
+        {
+            compilandDetails += "\tCompiled with /hotpatch: No\n";
         }
     }
 
-    if (data->isArray)
+    if (symbol->get_isCVTCIL(&isCVTCIL) == S_OK)
     {
-        int arrayCount = data->arrayCount.count();
+        if (isCVTCIL)
+        {
+            compilandDetails += "\tConverted by CVTCIL: Yes\n";
+        }
 
-        for (int i = arrayCount - 1; i >= 0; i--)
+        else
         {
-            result += QString("[%1]").arg(QString::number(data->arrayCount.at(i)));
+            compilandDetails += "\tConverted by CVTCIL: No\n";
         }
     }
-    else if (data->isFunctionPointer)
-    {
-        result += "(";
 
-        int count = data->functionParameters.count();
-
-        if (data->isVariadicFunction)
+    if (symbol->get_isMSILNetmodule(&isMSILNetmodule) == S_OK)
+    {
+        if (isMSILNetmodule)
         {
-            count--;
+            compilandDetails += "\tMSIL module: Yes\n";
         }
 
-        for (int i = 0; i < count; i++)
+        else
         {
-            QString parameterType = data->functionParameters.at(i);
-            bool isParameterFunctionPointer = false;
-
-            if (!options->includeConstKeyword)
-            {
-                if (parameterType.contains("<") && parameterType.contains(" const"))
-                {
-                    parameterType.replace(" const", "");
-                }
-
-                if (parameterType.startsWith("const "))
-                {
-                    parameterType.remove(0, 6);
-                }
-            }
-
-            if (parameterType.contains("(*)"))
-            {
-                isParameterFunctionPointer = true;
-            }
-            else
-            {
-                result += parameterType;
-            }
-
-            QString parameterName = GenerateCustomParameterName(parameterType, i);
+            compilandDetails += "\tMSIL module: No\n";
+        }
+    }
 
-            functionParameterNames.append(parameterName);
+    if ((symbol->get_frontEndMajor(&majorVersion) == S_OK) &&
+        (symbol->get_frontEndMinor(&minorVersion) == S_OK) &&
+        (symbol->get_frontEndBuild(&buildVersion) == S_OK))
+    {
+        compilandDetails += QString("\tFrontend Version: Major = %1, Minor = %2, Build = %3").arg(majorVersion)
+            .arg(minorVersion).arg(buildVersion);
 
-            if (isParameterFunctionPointer)
-            {
-                parameterType.insert(parameterType.indexOf("(*)") + 2, parameterName);
+        if (symbol->get_frontEndQFE(&qfeVersion) == S_OK)
+        {
+            compilandDetails += QString(", QFE = %1").arg(qfeVersion);
+        }
 
-                result += parameterType;
-            }
-            else
-            {
-                result += QString(" %1").arg(parameterName);
-            }
+        compilandDetails += "\n";
+    }
 
-            if (i != count - 1)
-            {
-                result += ", ";
-            }
-        }
+    if ((symbol->get_backEndMajor(&majorVersion) == S_OK) &&
+        (symbol->get_backEndMinor(&minorVersion) == S_OK) &&
+        (symbol->get_backEndBuild(&buildVersion) == S_OK))
+    {
+        compilandDetails += QString("\tBackend Version: Major = %1, Minor = %2, Build = %3").arg(majorVersion)
+            .arg(minorVersion).arg(buildVersion);
 
-        if (data->isVariadicFunction)
+        if (symbol->get_backEndQFE(&qfeVersion) == S_OK)
         {
-            if (count > 0)
-            {
-                result += ", ";
-            }
-
-            result += "...";
-            //result += "va_list argumentsList";
+            compilandDetails += QString(", QFE = %1").arg(qfeVersion);
         }
 
-        result += ")";
-
-        functionParameterNames.clear();
+        compilandDetails += "\n";
     }
 
-    if (data->numberOfBits > 0)
+    if (symbol->get_compilerName(&bstrCompilerName) == S_OK)
     {
-        result += QString(" : %1").arg(data->numberOfBits);
+        if (bstrCompilerName)
+        {
+            compilandDetails += QString("\tVersion std::string: %1").arg(QString::fromWCharArray(bstrCompilerName));
+
+            SysFreeString(bstrCompilerName);
+        }
     }
 
-    return result;
+    compilandDetails += "\n";
+
+    return compilandDetails;
 }
 
-Element PDB::GetElement(SymbolRecord* symbolRecord, bool addToPrototypesList)
+QString PDB::GetCompilandEnvironment(IDiaSymbol* symbol)
 {
-    Element element = {};
-    Element* element2 = nullptr;
-    IDiaSymbol* symbol = nullptr;
-    bool isInCache = elements.contains(symbolRecord->id);
+    QString compilandEnvironment;
+    BSTR bstrName;
 
-    if (isInCache)
+    if (symbol->get_name(&bstrName) == S_OK)
     {
-        element2 = &elements[symbolRecord->id];
-
-        if (addToPrototypesList && element2->udt.hasBaseClass)
-        {
-            vTables.clear();
-            vTableNames.clear();
+        compilandEnvironment += QString::fromWCharArray(bstrName);
 
-            //Always call GetVTables if addToPrototypesList is true because sometimes element can be saved when addToPrototypesList is false
-            GetVTables(element2, addToPrototypesList);
-        }
+        SysFreeString(bstrName);
     }
     else
     {
-        GetSymbolByID(symbolRecord->id, &symbol);
-
-        if (symbol)
-        {
-            GetElement(symbol);
-            symbol->Release();
-
-            element2 = &elements[symbolRecord->id];
-        }
+        compilandEnvironment += "(none)";
     }
 
-    if (element2)
-    {
-        if (!isInCache)
-        {
-            isMainUDT = false;
-
-            CheckIfDefaultCtorAndDtorAdded(element2);
-
-            if (options->applyRuleOfThree)
-            {
-                CheckIfCopyCtorAndCopyAssignmentOpAdded(element2);
-            }
-
-            if (element2->udt.hasBaseClass)
-            {
-                vTables.clear();
-                vTableNames.clear();
+    compilandEnvironment += " =";
 
-                GetVTables(element2, addToPrototypesList);
-            }
+    VARIANT variant = { VT_EMPTY };
 
-            int udtChildrenCount = element2->udtChildren.count();
+	if (symbol->get_value(&variant) == S_OK)
+	{
+        compilandEnvironment += convertVariantToString(variant);
 
-            for (int i = 0; i < udtChildrenCount; i++)
-            {
-                if (element2->udtChildren.at(i).udt.hasBaseClass)
-                {
-                    QHash<QString, QHash<QString, int>> vTables2;
+        VariantClear(static_cast<VARIANTARG*>(&variant));
+	}
 
-                    if (vTables.count() > 0)
-                    {
-                        vTables2 = vTables;
+    return compilandEnvironment;
+}
 
-                        vTables.clear();
-                    }
+QString PDB::GetExportName(IDiaSymbol* symbol)
+{
+    QString result;
+    BSTR bstrName;
+    BSTR bstrUndName;
 
-                    GetVTables(&element2->udtChildren[i]);
+    if (symbol->get_name(&bstrName) != S_OK)
+    {
+        result += "(none)";
 
-                    if (vTables.count() > 0)
-                    {
-                        vTables = vTables2;
-                    }
-                }
-            }
+        return result;
+    }
 
-            if (element2->elementType == ElementType::udtType)
+    if (options->useUndname)
+    {
+        if (symbol->get_undecoratedName(&bstrUndName) == S_OK)
+        {
+            if (wcscmp(bstrName, bstrUndName) == 0)
             {
-                CheckIfUnionsAreMissing(element2);
+                result += QString("%1").arg(QString::fromWCharArray(bstrName));
             }
-
-            if (options->declareFunctionsForStaticVariables)
+            else
             {
-                DeclareFunctionsForStaticVariables(element2);
+                result += QString("%1(%2)").arg(QString::fromWCharArray(bstrUndName)).arg(QString::fromWCharArray(bstrName));
             }
+
+            SysFreeString(bstrUndName);
         }
+		else
+		{
+			result += QString("%1").arg(QString::fromWCharArray(bstrName));
+		}
+    }
+    else
+    {
+		std::string mangledName = QString::fromWCharArray(bstrName).toStdString();
 
-        if (!options->includeOnlyPublicAccessSpecifier)
-        {
-            JoinLists(element2);
+        std::string demangledName = SymbolDemangler::Demangle(mangledName);
 
-            *element2 = OrderUDTChildrenByAccessSpecifiers(*element2);
+        if (mangledName == demangledName)
+		{
+			result += QString("%1").arg(QString::fromStdString(mangledName));
+		}
+        else
+        {
+            result += QString("%1(%2)").arg(QString::fromStdString(demangledName)).arg(QString::fromStdString(mangledName));
         }
     }
 
-    return *element2;
+    SysFreeString(bstrName);
+
+    return result;
 }
 
-Element PDB::GetElement(IDiaSymbol* symbol)
+RecordType PDB::GetType(IDiaSymbol* symbol)
 {
-    Element parentElement = {};
-    bool children = true;
-    qint64 currentOffset = 0;
-    DWORD id = 0, symTag = 0;
-    bool hasValidType = true;
+    ResolutionContext* context = GetResolutionContext();
+    RecordType recordType = {};
+    DWORD symTag;
 
-    if (symbol->get_symIndexId(&id) != S_OK ||
-        symbol->get_symTag(&symTag) != S_OK)
+    if (!symbol || symbol->get_symTag(&symTag) != S_OK)
     {
-        return parentElement;
+        return recordType;
     }
 
     switch (symTag)
     {
-    case SymTagUDT:
+    case SymTagBaseType:
     {
-        parentElement.elementType = ElementType::udtType;
-        parentElement.udt = GetUDT(symbol);
-        parentElement.udt.id = id;
-        parentElement.size = parentElement.udt.length;
-
-        if (options->removeScopeResolutionOperator)
-        {
-            parentClassName2 = parentClassName;
+        BaseType baseType = GetBaseType(symbol);
 
-            if (parentElement.udt.parentClassName.length() > 0)
-            {
-                parentClassName = parentElement.udt.parentClassName;
-            }
-            else
-            {
-                parentClassName = parentElement.udt.name;
-            }
-        }
+        recordType.size = baseType.length;
+        recordType.isTypeConst = baseType.isConst;
+        recordType.isTypeVolatile = baseType.isVolatile;
+        recordType.baseType = baseType.type;
 
-        if (!isMainUDT)
-        {
-            parentElement.udt.isMainUDT = true;
-            isMainUDT = true;
-        }
-        else if (belongsToMainUDT)
+        switch (recordType.baseType)
         {
-            parentElement.udt.belongsToMainUDT = true;
-            belongsToMainUDT = false;
-        }
-
-        break;
-    }
-    case SymTagFunction:
-    {
-        parentElement.elementType = ElementType::functionType;
-        parentElement.function = GetFunction(symbol);
-        parentElement.size = parentElement.function.length;
-
-        break;
-    }
-    case SymTagTypedef:
-    {
-        parentElement.elementType = ElementType::typedefType;
+        case 0: 
+            recordType.typeName = "<btNoType>";
+            recordType.noType = true;
 
-        if (options->displayTypedefs)
-        {
-            parentElement.typeDef = GetTypeDef(symbol);
+            break;
+        case 1: recordType.typeName = "void"; break;
+        case 2: recordType.typeName = "char"; break;
+        case 3: recordType.typeName = "wchar_t"; break;
+        case 4: recordType.typeName = "signed char"; break;
+        case 5: recordType.typeName = "unsigned char"; break;
+        case 6: recordType.typeName = "int"; break;
+        case 7: recordType.typeName = "unsigned int"; break;
+        case 8: recordType.typeName = "float"; break;
+        case 9: recordType.typeName = "BCD"; break;
+        case 10: recordType.typeName = "bool"; break;
+        case 11: recordType.typeName = "short"; break;
+        case 12: recordType.typeName = "unsigned short"; break;
+        case 13: recordType.typeName = "long"; break;
+        case 14: recordType.typeName = "unsigned long"; break;
+        case 15: recordType.typeName = "__int8"; break;
+        case 16: recordType.typeName = "__int16"; break;
+        case 17: recordType.typeName = "__int32"; break;
+        case 18: recordType.typeName = "__int64"; break;
+        case 19: recordType.typeName = "__int128"; break;
+        case 20: recordType.typeName = "unsigned __int8"; break;
+        case 21: recordType.typeName = "unsigned __int16"; break;
+        case 22: recordType.typeName = "unsigned __int32"; break;
+        case 23: recordType.typeName = "unsigned __int64"; break;
+        case 24: recordType.typeName = "unsigned __int128"; break;
+        case 25: recordType.typeName = "CURRENCY"; break;
+        case 26: recordType.typeName = "DATE"; break;
+        case 27: recordType.typeName = "VARIANT"; break;
+        case 28: recordType.typeName = "COMPLEX"; break;
+        case 29: recordType.typeName = "BIT"; break;
+        case 30: recordType.typeName = "BSTR"; break;
+        case 31: recordType.typeName = "HRESULT"; break;
+        case 32: recordType.typeName = "char16_t"; break;
+        case 33: recordType.typeName = "char32_t"; break;
         }
 
-        children = false;
+        if ((recordType.baseType == 8) && (recordType.size != 4))
+        {
+            switch (recordType.size)
+            {
+            case 8: recordType.typeName = "double"; break;
+            case 12: recordType.typeName = "long double"; break;
+            }
+        }
 
-        break;
-    }
-    case SymTagData:
-    {
-        parentElement.elementType = ElementType::dataType;
-        parentElement.data = GetData(symbol);
-        parentElement.size = parentElement.data.size;
-        parentElement.offset = parentElement.data.offset;
-        parentElement.bitOffset = parentElement.data.bitOffset;
-        parentElement.numberOfBits = parentElement.data.length;
+        if (((recordType.baseType == 7) || (recordType.baseType == 14)) && (recordType.size != 4)) // "unsigned int"
+        {
+            switch (recordType.size)
+            {
+            case 1: recordType.typeName = "unsigned char"; break;
+            case 2: recordType.typeName = "unsigned short"; break;
+            case 4: recordType.typeName = "unsigned int"; break;
+            case 8: recordType.typeName = "unsigned long long"; break;
+            }
+        }
 
-        if (parentElement.data.isPointer || parentElement.data.isReference)
+        if (((recordType.baseType == 6) || (recordType.baseType == 13)) && (recordType.size != 4)) // "int"
         {
-            children = false;
+            switch (recordType.size)
+            {
+            case 1: recordType.typeName = "char"; break;
+            case 2: recordType.typeName = "short"; break;
+            case 4: recordType.typeName = "int"; break;
+            case 8: recordType.typeName = "long long"; break;
+            }
         }
 
         break;
     }
-    case SymTagEnum:
+    case SymTagUDT:
     {
-        parentElement.elementType = ElementType::enumType;
-        parentElement.enum1 = GetEnum(symbol);
-        parentElement.enum1.id = id;
+        UDT udt = GetUDT(symbol);
+
+        recordType.size = udt.length;
+        recordType.isTypeConst = udt.isConst;
+        recordType.isTypeVolatile = udt.isVolatile;
+        recordType.originalTypeName = udt.originalTypeName;
+        recordType.typeName = udt.name;
+        recordType.noType = false;
+
+        IDiaSymbol* parentClass;
+        BSTR bString;
+
+		if (symbol->get_classParent(&parentClass) == S_OK)
+		{
+			if (parentClass->get_name(&bString) == S_OK)
+			{
+				udt.parentClassName = QString::fromWCharArray(bString);
+
+				SysFreeString(bString);
+			}
+
+			parentClass->Release();
+		}
 
         break;
     }
-    case SymTagBaseClass:
+    case SymTagPointerType:
     {
-        //Members of base class aren't display so it's includes are not needed
-        displayIncludes = options->displayIncludes;
-        options->displayIncludes = false;
+        PointerType pointerType = GetPointerType(symbol);
+        IDiaSymbol* type;
 
-        parentElement.elementType = ElementType::baseClassType;
-        parentElement.baseClass = GetBaseClass(symbol);
-        parentElement.size = parentElement.baseClass.length;
-        parentElement.offset = parentElement.baseClass.offset;
+        if (symbol->get_type(&type) == S_OK)
+        {
+            recordType = GetType(type);
+
+            /*
+            * Don't check if data type is const or volatile in case of reference
+            * because value of reference can't be changed so references are already treated as const
+            */
+            if (pointerType.isReference)
+            {
+                recordType.isReference = true;
+                recordType.referenceLevel++;
+            }
+            else
+            {
+                recordType.isPointer = true;
+                recordType.isPointerConst = pointerType.isConst;
+                recordType.isPointerVolatile = pointerType.isVolatile;
+                recordType.pointerLevel++;
+            }
+
+            recordType.size = pointerType.length;
+
+            type->Release();
+        }
 
         break;
     }
-    case SymTagVTable:
+    case SymTagArrayType:
     {
-        parentElement.elementType = ElementType::vTableType;
+        ArrayType arrayType = GetArrayType(symbol);
+        IDiaSymbol* type;
 
-        children = false;
+        if (symbol->get_type(&type) == S_OK)
+        {
+            recordType = GetType(type);
+            recordType.isArray = true;
+            recordType.arrayCount.append(arrayType.count);
+            recordType.size *= arrayType.count;
+
+            recordType.isTypeConst = arrayType.isConst;
+            recordType.isTypeVolatile = arrayType.isVolatile;
+
+            type->Release();
+        }
 
         break;
     }
-    case SymTagFriend:
-        children = false;
+    case SymTagEnum:
+    {
+        Enum enumType = GetEnum(symbol);
 
-        break;
-    default:
-        children = false;
-        hasValidType = false;
+        recordType.size = enumType.length;
+        recordType.isTypeConst = enumType.isConst;
+        recordType.isTypeVolatile = enumType.isVolatile;
+        recordType.originalTypeName = enumType.originalTypeName;
+        recordType.typeName = enumType.name;
+        recordType.noType = false;
+        recordType.isTypeNameOfEnum = true;
 
         break;
     }
-
-    if (!isTypeImported && hasValidType && elements.contains(id))
+    case SymTagFunctionType:
     {
-        return elements[id];
-    }
+        RecordType returnType = GetRecordType(symbol);
+        FunctionType functionType = GetFunctionType(symbol);
+
+        returnType.callingConvention = functionType.callingConvention;
+
+        if (returnType.size > 0 && returnType.functionType)
+        {
+            returnType.isFunctionPointer = true;
+        }
+
+        Data data = ConvertRecordTypeToData(const_cast<RecordType*>(&returnType));
+        static const DataOptions dataOptions = { false, true };
+
+        recordType.functionReturnType1 = data;
+        recordType.functionReturnType2 = DataTypeToString(const_cast<Data*>(&data), &dataOptions);
+
+        if (returnType.originalTypeName.length() > 0)
+        {
+            bool keepScopeResolutionOperator = context->keepScopeResolutionOperator;
+
+            context->keepScopeResolutionOperator = true;
+            data.typeName = returnType.originalTypeName;
+
+            recordType.originalFunctionReturnType = DataTypeToString(const_cast<Data*>(&data), &dataOptions);
+
+            context->keepScopeResolutionOperator = keepScopeResolutionOperator;
+        }
+        else
+        {
+            recordType.originalFunctionReturnType = recordType.functionReturnType2;
+        }
+
+        recordType.isFunctionConst = functionType.isConst;
+        recordType.isFunctionVolatile = functionType.isVolatile;
+        recordType.functionType = true;
+        recordType.callingConvention = functionType.callingConvention;
+        recordType.parametersCount = functionType.parametersCount;
+
+        if (recordType.size > 0)
+        {
+            recordType.isFunctionPointer = true;
+        }
+
+        if (returnType.isFunctionPointer)
+        {
+            recordType.functionReturnsFunctionPointer = true;
+        }
 
-    if (children)
-    {
         IDiaEnumSymbols* enumSymbols;
 
         if (symbol->findChildren(SymTagNull, nullptr, nsNone, &enumSymbols) == S_OK)
@@ -3161,6029 +3334,7532 @@ Element PDB::GetElement(IDiaSymbol* symbol)
             {
                 if (count)
                 {
-                    IDiaSymbol* symbol2;
+                    IDiaSymbol* symbol;
                     ULONG celt = 0;
 
-                    int alignCount = 0;
-                    DWORD childSize = 0;
-
-                    while (SUCCEEDED(enumSymbols->Next(1, &symbol2, &celt)) && (celt == 1))
+                    while (SUCCEEDED(enumSymbols->Next(1, &symbol, &celt)) && (celt == 1))
                     {
-                        if (symbol2->get_symTag(&symTag) == S_OK &&
-                            symTag == SymTagUDT &&
-                            parentElement.udt.isMainUDT)
+                        RecordType recordType2 = GetRecordType(symbol);
+
+                        symbol->Release();
+
+                        if (recordType2.size > 0 && recordType2.functionType)
                         {
-                            belongsToMainUDT = true;
+                            recordType2.isFunctionPointer = true;
                         }
 
-                        Element childElement = GetElement(symbol2);
-                        bool add = true;
+                        if (recordType2.noType)
+                        {
+                            recordType.isVariadicFunction = true;
+                        }
 
-                        HandleChildElement(&parentElement, &childElement, add, currentOffset, childSize);
+                        Data data2 = ConvertRecordTypeToData(const_cast<RecordType*>(&recordType2));
+                        static const DataOptions dataOptions = { true, false };
+                        QString parameter = DataTypeToString(const_cast<Data*>(&data2), &dataOptions);
 
-                        if (add)
+                        recordType.functionParameters.append(parameter);
+
+                        if (recordType2.originalTypeName.length() > 0)
                         {
-                            bool addPadding = false;
+                            bool keepScopeResolutionOperator = context->keepScopeResolutionOperator;
 
-                            if ((childElement.offset) && (childElement.offset > currentOffset))
-                            {
-                                addPadding = true;
-                            }
+                            context->keepScopeResolutionOperator = true;
+                            data2.typeName = recordType2.originalTypeName;
 
-                            if (parentElement.elementType == ElementType::functionType)
-                            {
-                                addPadding = false;
-                            }
+                            recordType.originalFunctionParameters.append(DataTypeToString(const_cast<Data*>(&data2), &dataOptions));
 
-                            if (childElement.elementType == ElementType::dataType &&
-                                childElement.data.dataKind == DataIsStaticMember)
-                            {
-                                addPadding = false;
-                            }
-
-                            if (addPadding)
-                            {
-                                AddPaddingToUDT(&parentElement, &childElement, currentOffset, alignCount);
-                            }
-
-                            InsertElement(&parentElement, &childElement);
-
-                            if (childElement.size > 0 &&
-                                (childElement.elementType == ElementType::dataType &&
-                                    childElement.data.dataKind != DataIsStaticMember ||
-                                    childElement.elementType == ElementType::baseClassType))
-                            {
-                                bool modifyOffset = true;
-
-                                if (childElement.elementType == ElementType::baseClassType)
-                                {
-                                    if (childElement.dataChildren.count() == 1)
-                                    {
-                                        //Empty base class optimization (EBCO) sets size of empty base class to be 0
-                                        if (childElement.dataChildren.at(0).data.isEndPadding)
-                                        {
-                                            modifyOffset = false;
-                                        }
-                                    }
-                                }
-
-                                if (modifyOffset)
-                                {
-                                    currentOffset = childElement.offset + childElement.size;
-                                    childSize = qMax(childSize, childElement.offset + childElement.size);
-                                }
-                            }
+                            context->keepScopeResolutionOperator = keepScopeResolutionOperator;
                         }
-
-                        symbol2->Release();
-                    }
-
-                    // If UDT or Base Class parent size is greater then child size add ending aligment
-                    if (parentElement.elementType == ElementType::udtType ||
-                        parentElement.elementType == ElementType::baseClassType)
-                    {
-                        long sizeDifference = parentElement.size - childSize;
-
-                        if (sizeDifference > 0)
+                        else
                         {
-                            AddEndPaddingToUDT(&parentElement, childSize, sizeDifference);
+                            recordType.originalFunctionParameters.append(parameter);
                         }
                     }
-
-                    if (parentElement.elementType == ElementType::udtType &&
-                        !parentElement.udt.hasBaseClass &&
-                        parentElement.udt.hasVTable)
-                    {
-                        parentElement.udt.numOfVTables++;
-                    }
-
-                    if (parentElement.elementType == ElementType::udtType &&
-                        parentElement.udt.isMainUDT)
-                    {
-                        /*if (options->generateBoth)
-                        {
-                            includes.insert(QString("#include \"BaseAddresses.h\""));
-                            includes.insert(QString("#include \"Function.h\""));
-                        }*/
-
-                        parentElement.udt.includes = includes;
-                        parentElement.typedefChildren.append(typedefChildren);
-
-                        includes.clear();
-                        typedefChildren.clear();
-                    }
-
-                    /*if (!isTypeImported && hasValidType && !elements.contains(id))
-                    {
-                        elements.insert(id, element);
-                    }*/
                 }
             }
 
-            if (!isTypeImported && hasValidType && !elements.contains(id))
-            {
-                elements.insert(id, parentElement);
-            }
-
             enumSymbols->Release();
         }
+
+        break;
     }
+    default:
+        emit SendStatusMessage("Unknown Type.");
 
-    return parentElement;
+        break;
+    }
+
+    return recordType;
 }
 
-void PDB::InsertElement(Element* element, const Element* childElement)
+QString PDB::DataTypeToString(const Data* data, const DataOptions* dataOptions)
 {
-    switch (childElement->elementType)
+    ResolutionContext* context = GetResolutionContext();
+    QString result = "";
+
+    if (data->dataKind == DataIsStaticMember)
     {
-    case ElementType::baseClassType:
-        element->baseClassChildren.append(*childElement);
+        if (options->declareStaticVariablesWithInlineKeyword)
+        {
+            result += "inline ";
+        }
 
-        break;
-    case ElementType::enumType:
-        element->enumChildren.append(*childElement);
+        result += "static ";
+    }
 
-        break;
-    case ElementType::udtType:
-        element->udtChildren.append(*childElement);
+    if (data->isTypeConst && options->includeConstKeyword)
+    {
+        result += "const ";
+    }
 
-        break;
-    case ElementType::typedefType:
-        element->typedefChildren.append(*childElement);
+    if (data->isTypeVolatile && options->includeVolatileKeyword)
+    {
+        result += "volatile ";
+    }
 
-        break;
-    case ElementType::dataType:
+    if (!data->unnamedType)
     {
-        if (childElement->data.dataKind == DataIsStaticMember)
+        QString typeName = data->typeName;
+
+        if (context->DisplayIncludes() && !data->isVTablePointer && !data->noType)
         {
-            element->staticDataChildren.append(*childElement);
+            AddTypeNameToIncludesList(typeName, context->parentClassName);
         }
-        else
+
+        if (context->RemoveScopeResolutionOperator() && typeName.contains("::"))
         {
-            element->dataChildren.append(*childElement);
+            if (data->parentClassName.length() == 0)
+            {
+                RemoveScopeResolutionOperators(typeName, context->parentClassName);
+            }
+            else
+            {
+                RemoveScopeResolutionOperators(typeName, data->parentClassName);
+            }
         }
 
-        break;
+        result += typeName;
     }
-    case ElementType::functionType:
+
+    if (data->isFunctionPointer)
     {
-        if (childElement->function.isVirtual)
+        result += QString("%1 (").arg(data->functionReturnType);
+
+        if (options->displayCallingConventionForFunctionPointers)
         {
-            element->virtualFunctionChildren.append(*childElement);
+            result += convertCallingConventionToString(data->callingConvention);
         }
-        else
+    }
+
+    if (data->isPointer)
+    {
+        for (int i = 0; i < data->pointerLevel; i++)
         {
-            element->nonVirtualFunctionChildren.append(*childElement);
+            result += "*";
         }
-
-        break;
-    }
     }
-}
-
-void PDB::JoinLists(Element* element)
-{
-    element->children.append(element->baseClassChildren);
-    element->children.append(element->enumChildren);
-    element->children.append(element->udtChildren);
-    element->children.append(element->typedefChildren);
-    element->children.append(element->dataChildren);
-    element->children.append(element->staticDataChildren);
-    element->children.append(element->virtualFunctionChildren);
-    element->children.append(element->nonVirtualFunctionChildren);
-}
 
-void PDB::HandleChildElement(Element* parentElement, Element* childElement, bool& add, qint64& currentOffset, DWORD& childSize)
-{
-    switch (childElement->elementType)
-    {
-    case ElementType::baseClassType:
+    if (data->isReference)
     {
-        HandleBaseClassChild(parentElement, childElement);
+        for (int i = 0; i < data->referenceLevel; i++)
+        {
+            result += "&";
+        }
+    }
 
-        break;
+    if (data->isPointerConst && options->includeConstKeyword)
+    {
+        result += " const";
     }
-    case ElementType::udtType:
+
+    if (data->isPointerVolatile && options->includeVolatileKeyword)
     {
-        HandleUDTChild(parentElement, childElement, add);
+        result += " volatile";
+    }
 
-        break;
+    if (!data->isFunctionPointer &&
+        !dataOptions->isParameter &&
+        !dataOptions->isReturnType &&
+        result.length() > 0)
+    {
+        result += " ";
     }
-    case ElementType::enumType:
+
+    QString name = data->name;
+
+    if (options->modifyVariableNames)
     {
-        HandleEnumChild(childElement, add);
+        name = ModifyNamingCovention(name, false, false, true);
+    }
 
-        break;
+    if (data->isFunctionPointer)
+    {
+        result += QString("%1)").arg(name);
     }
-    case ElementType::vTableType:
+    else
     {
-        HandleVTableChild(parentElement, add, currentOffset, childSize);
+        if (!dataOptions->isParameter && !dataOptions->isReturnType)
+        {
+            if (result.length() == 0 && name.length() > 0)
+            {
+                result += " ";
+            }
 
-        break;
+            result += name;
+        }
     }
-    case ElementType::typedefType:
+
+    if (data->isArray)
     {
-        HandleTypeDefChild(childElement, add);
+        int arrayCount = data->arrayCount.count();
 
-        break;
+        for (int i = arrayCount - 1; i >= 0; i--)
+        {
+            result += QString("[%1]").arg(QString::number(data->arrayCount.at(i)));
+        }
     }
-	case ElementType::dataType:
-	{
-		HandleDataChild(parentElement, childElement, add);
+    else if (data->isFunctionPointer)
+    {
+        result += "(";
 
-		break;
-	}
-	case ElementType::functionType:
-	{
-		HandleFunctionChild(parentElement, childElement, add);
+        int count = data->functionParameters.count();
 
-		break;
-	}
-    case ElementType::funcDebugStartType:
-    case ElementType::funcDebugEndType:
-    case ElementType::blockType:
-    case ElementType::callSiteType:
-    case ElementType::labelType:
-    case ElementType::unknownType:
-        add = false;
+        if (data->isVariadicFunction)
+        {
+            count--;
+        }
 
-        break;
-    }
-}
+        for (int i = 0; i < count; i++)
+        {
+            QString parameterType = data->functionParameters.at(i);
+            bool isParameterFunctionPointer = false;
 
-void PDB::HandleBaseClassChild(Element* parentElement, Element* childElement)
-{
-	if (parentElement->elementType == ElementType::udtType)
-	{
-		if (!parentElement->udt.hasBaseClass)
-		{
-            parentElement->udt.hasBaseClass = true;
-		}
-	}
+            if (!options->includeConstKeyword)
+            {
+                if (parameterType.contains("<") && parameterType.contains(" const"))
+                {
+                    parameterType.replace(" const", "");
+                }
 
-	if (childElement->baseClass.hasVTable)
-	{
-		if (parentElement->elementType == ElementType::udtType)
-		{
-			if (childElement->baseClass.numOfVTables > 1)
-			{
-                parentElement->udt.numOfVTables += childElement->baseClass.numOfVTables;
-			}
-			else
-			{
-                parentElement->udt.numOfVTables++;
-			}
-		}
-		else if (parentElement->elementType == ElementType::baseClassType)
-		{
-			if (childElement->baseClass.numOfVTables > 1)
-			{
-                parentElement->baseClass.numOfVTables += childElement->baseClass.numOfVTables;
-			}
-			else
-			{
-                parentElement->baseClass.numOfVTables++;
-			}
-		}
-	}
+                if (parameterType.startsWith("const "))
+                {
+                    parameterType.remove(0, 6);
+                }
+            }
 
-	if (childElement->size > 1 &&
-		GetChildrenSize(const_cast<Element*>(childElement)) > childElement->size)
-	{
-		FixOffsets(childElement);
-	}
+            if (parameterType.contains("(*)"))
+            {
+                isParameterFunctionPointer = true;
+            }
+            else
+            {
+                result += parameterType;
+            }
 
-    if (parentElement->udt.isMainUDT || parentElement->udt.belongsToMainUDT)
-	{
-		//Don't set displayIncludes to true if it wasn't set to true by checkbox
-		if (displayIncludes)
-		{
-			options->displayIncludes = true;
-		}
-	}
+            QString parameterName = GenerateCustomParameterName(parameterType, i);
 
-    parentElement->baseClassNames.append(childElement->baseClass.name);
-    parentElement->baseClassNames.append(childElement->baseClassNames);
-}
+            context->functionParameterNames.append(parameterName);
 
-void PDB::HandleUDTChild(Element* parentElement, Element* childElement, bool& add)
-{
-	if (childElement->udt.name.startsWith("__cta"))
-	{
-		add = false;
-	}
+            if (isParameterFunctionPointer)
+            {
+                parameterType.insert(parameterType.indexOf("(*)") + 2, parameterName);
 
-	if (childElement->udt.isUnnamed)
-	{
-		add = false;
-	}
+                result += parameterType;
+            }
+            else
+            {
+                result += QString(" %1").arg(parameterName);
+            }
 
-	//Sometimes inner udt that doesn't belong to main udt is added
-	if (!CheckIfInnerUDTBelongsToMainUDT(parentElement, childElement))
-	{
-		add = false;
-	}
+            if (i != count - 1)
+            {
+                result += ", ";
+            }
+        }
 
-	if (options->removeScopeResolutionOperator)
-	{
-		parentClassName = parentClassName2;
-	}
-}
+        if (data->isVariadicFunction)
+        {
+            if (count > 0)
+            {
+                result += ", ";
+            }
 
-void PDB::HandleEnumChild(Element* childElement, bool& add)
-{
-    if (childElement->enum1.isUnnamed)
+            result += "...";
+            //result += "va_list argumentsList";
+        }
+
+        result += ")";
+
+        context->functionParameterNames.clear();
+    }
+
+    if (data->numberOfBits > 0)
     {
-        add = false;
+        result += QString(" : %1").arg(data->numberOfBits);
     }
+
+    return result;
 }
 
-void PDB::HandleVTableChild(Element* parentElement, bool& add, qint64& currentOffset, DWORD& childSize)
+/*
+* Element which is returned by GetElement(symbol) is raw element and it's cached under fingerprint of options
+* which are used while element is created. Element which is returned from this function is derived from raw element
+* and it's cached under fingerprint of all options, so when options are changed and changed back both are found in cache.
+*/
+Element PDB::GetElement(SymbolRecord* symbolRecord, bool addToPrototypesList)
 {
-	add = false;
+    /*
+    * DIA calls are serialized, so only symbol lookup and creation of raw element hold diaMutex and workers
+    * which have their own resolution context derive elements concurrently. Threads which use main context
+    * share it so they still resolve whole element while they hold diaMutex.
+    */
+    QMutexLocker mainContextLocker(ResolutionContext::GetCurrent() ? nullptr : &diaMutex);
+    ResolutionContext* context = GetResolutionContext();
+    Element element = {};
+    IDiaSymbol* symbol = nullptr;
+    DWORD id = symbolRecord->id;
 
-    AddVTablePointerToUDT(parentElement, currentOffset, childSize);
-}
+    //Elements are cached by DIA IDs so IDs of symbols which are imported from TPI stream or index have to be resolved first
+    if (id & (typeIndexFlag | symbolLocatorFlag))
+    {
+        QMutexLocker diaLocker(&diaMutex);
 
-void PDB::HandleTypeDefChild(Element* childElement, bool& add)
-{
-	if (options->displayTypedefs)
-	{
-		QString oldTypeName = childElement->typeDef.oldTypeName;
-		QString newTypeName = childElement->typeDef.newTypeName;
+        if (!GetSymbolByID(id, &symbol))
+        {
+            return element;
+        }
 
-		if (options->useTypedefKeyword)
-		{
-			childElement->typeDef.declaration = QString("typedef %1 %2").arg(oldTypeName).arg(newTypeName);
-		}
-		else
-		{
-			childElement->typeDef.declaration = QString("using %1 = %2").arg(newTypeName).arg(oldTypeName);
-		}
-	}
-	else
-	{
-		add = false;
-	}
-}
+        symbol->get_symIndexId(&id);
+        symbol->Release();
+    }
 
-void PDB::HandleDataChild(Element* parentElement, Element* childElement, bool& add)
-{
-    if (childElement->data.dataKind == DataIsLocal ||
-        childElement->data.dataKind == DataIsStaticLocal)
+    quint64 key = GetElementKey(id, true);
+
+    /*
+    * Misses are counted when raw element is requested by GetElement(symbol). Element can be evicted by other thread
+    * at any time so cache is searched only once and element is created again if it isn't found.
+    */
+    QSharedPointer<Element> cachedElement = elements.Find(key, false);
+
+    if (cachedElement)
     {
-        add = false;
+        element = *cachedElement;
 
-        parentElement->localVariables.append(*childElement);
+        if (addToPrototypesList && element.udt->hasBaseClass)
+        {
+            context->vTables.clear();
+            context->vTableNames.clear();
+
+            //Always call GetVTables if addToPrototypesList is true because sometimes element can be saved when addToPrototypesList is false
+            GetVTables(&element, addToPrototypesList);
+        }
+
+        return element;
     }
 
-    if (childElement->data.typeName.contains("<unnamed"))
+    QMutexLocker diaLocker(&diaMutex);
+
+    if (!GetSymbolByID(id, &symbol))
     {
-        CreateUnnamedType(childElement);
+        return element;
     }
 
-    //Declaration is not needed for base class since it's members are not displayed
-    if (add &&
-        (parentElement->elementType == ElementType::udtType ||
-            parentElement->elementType == ElementType::enumType))
-    {
-        static const DataOptions dataOptions;
+    element = GetElement(symbol);
 
-        childElement->data.declaration = DataTypeToString(const_cast<Data*>(&childElement->data), &dataOptions);
+    symbol->Release();
+    diaLocker.unlock();
+
+    //Element is derived from copy of raw element and it's inserted into cache only when it's complete
+    //so other threads never see it while it's changed
+    context->isMainUDT = false;
+
+    CheckIfDefaultCtorAndDtorAdded(&element);
+
+    if (options->applyRuleOfThree)
+    {
+        CheckIfCopyCtorAndCopyAssignmentOpAdded(&element);
     }
-}
 
-void PDB::HandleFunctionChild(Element* parentElement, Element* childElement, bool& add)
-{
-    if (childElement->function.name == "__vecDelDtor")
+    if (element.udt->hasBaseClass)
     {
-        add = false;
+        context->vTables.clear();
+        context->vTableNames.clear();
+
+        GetVTables(&element, addToPrototypesList);
     }
 
-    if (childElement->function.isVirtual)
+    int udtChildrenCount = element.udtChildren.count();
+
+    for (int i = 0; i < udtChildrenCount; i++)
     {
-        if (parentElement->elementType == ElementType::udtType && !parentElement->udt.hasVTable)
-        {
-            parentElement->udt.hasVTable = true;
-        }
-        else if (parentElement->elementType == ElementType::baseClassType && !parentElement->baseClass.hasVTable)
+        if (element.udtChildren.at(i).udt->hasBaseClass)
         {
-            parentElement->baseClass.hasVTable = true;
+            QHash<QString, QHash<QString, int>> vTables2;
+
+            if (context->vTables.count() > 0)
+            {
+                vTables2 = context->vTables;
+
+                context->vTables.clear();
+            }
+
+            GetVTables(&element.udtChildren[i]);
+
+            if (context->vTables.count() > 0)
+            {
+                context->vTables = vTables2;
+            }
         }
     }
 
-    if (!childElement->function.returnType1.isPointer &&
-        !childElement->function.returnType1.isReference)
+    if (element.elementType == ElementType::udtType)
     {
-        IDiaSymbol* symbol2;
-        DWORD id = diaSymbols->value(childElement->function.returnType1.originalTypeName);
+        CheckIfUnionsAreMissing(&element);
+    }
 
-        if (GetSymbolByID(id, &symbol2))
-        {
-            childElement->function.isRVOApplied = CheckIfRVOIsAppliedToFunction(symbol2);
-        }
+    if (options->declareFunctionsForStaticVariables)
+    {
+        DeclareFunctionsForStaticVariables(&element);
     }
 
-    if (parentElement->elementType == ElementType::udtType)
+    //Lists are joined only once since derived element is cached after they are joined
+    if (!options->includeOnlyPublicAccessSpecifier)
     {
-        if (parentElement->udt.hasCastOperator)
-        {
-            if (childElement->function.name.startsWith("operator"))
-            {
-                QString name = childElement->function.name.mid(9);
+        JoinLists(&element);
 
-                if (baseTypes2.contains(name))
-                {
-                    name = baseTypes2[name];
-                }
+        element = OrderUDTChildrenByAccessSpecifiers(element);
+    }
 
-                if (name == childElement->function.returnType2)
-                {
-                    childElement->function.name = QString("operator %1").arg(name);
-                    childElement->function.isCastOperator = true;
-                }
-            }
-        }
+    elements.Insert(key, element);
 
-        if (childElement->function.isDefaultConstructor)
-        {
-            parentElement->udt.hasDefaultConstructor = true;
-        }
+    return element;
+}
 
-        if (childElement->function.isCopyConstructor)
-        {
-            parentElement->udt.hasCopyConstructor = true;
-        }
+Element PDB::GetElement(IDiaSymbol* symbol)
+{
+    ResolutionContext* context = GetResolutionContext();
+    Element parentElement = {};
+    bool children = true;
+    qint64 currentOffset = 0;
+    DWORD id = 0, symTag = 0;
+    bool hasValidType = true;
 
-        if (childElement->function.isCopyAssignmentOperator)
-        {
-            parentElement->udt.hasCopyAssignmentOperator = true;
-        }
+    if (symbol->get_symIndexId(&id) != S_OK ||
+        symbol->get_symTag(&symTag) != S_OK)
+    {
+        return parentElement;
+    }
+
+    /*
+    * Only types which are resolved at top level are cached because members of nested types depend on state of outer type
+    * (parent class name, main UDT), so cached element would depend on order in which types were resolved
+    */
+    bool isTopLevel = context->resolutionDepth == 0;
+
+    context->resolutionDepth++;
+
+    switch (symTag)
+    {
+    case SymTagUDT:
+    {
+        parentElement.elementType = ElementType::udtType;
+        parentElement.udt = GetUDT(symbol);
+        parentElement.udt.Edit()->id = id;
+        parentElement.size = parentElement.udt->length;
 
-        if (childElement->function.isDestructor)
+        if (context->RemoveScopeResolutionOperator())
         {
-            if (childElement->function.isVirtual)
+            context->parentClassName2 = context->parentClassName;
+
+            if (parentElement.udt->parentClassName.length() > 0)
             {
-                parentElement->udt.hasVirtualDestructor = true;
+                context->parentClassName = parentElement.udt->parentClassName;
             }
             else
             {
-                parentElement->udt.hasDestructor = true;
+                context->parentClassName = parentElement.udt->name;
             }
         }
 
-        if (childElement->function.isVirtual &&
-            childElement->function.isPure &&
-            parentElement->elementType == ElementType::udtType &&
-            !parentElement->udt.isAbstract)
+        if (!context->isMainUDT)
         {
-            parentElement->udt.isAbstract = true;
+            parentElement.udt.Edit()->isMainUDT = true;
+            context->isMainUDT = true;
         }
-
-        if (options->applyReturnValueOptimization && childElement->function.isRVOApplied)
+        else if (context->belongsToMainUDT)
         {
-            ApplyReturnValueOptimization(childElement);
+            parentElement.udt.Edit()->belongsToMainUDT = true;
+            context->belongsToMainUDT = false;
         }
+
+        break;
     }
+    case SymTagFunction:
+    {
+        parentElement.elementType = ElementType::functionType;
+        parentElement.function = GetFunction(symbol);
+        parentElement.size = parentElement.function->length;
 
-    /*
-    * Prototypes for virtual functions shouldn't be created here because it's not known which
-    * virtual function is overriden.
-    * If udt doesn't have base class then prototypes can be created here because there are no
-    * overriden functions in that case
-    */
-    if (add)
+        break;
+    }
+    case SymTagTypedef:
     {
-        if (childElement->function.isVirtual)
-        {
-            if (parentElement->elementType == ElementType::udtType && !parentElement->udt.hasBaseClass)
-            {
-                static const FunctionOptions functionOptions;
+        parentElement.elementType = ElementType::typedefType;
 
-                childElement->function.prototype = FunctionTypeToString(const_cast<Element*>(childElement),
-                    &functionOptions);
-            }
-        }
-        else
+        if (options->displayTypedefs)
         {
-            if (parentElement->elementType == ElementType::udtType)
-            {
-                static const FunctionOptions functionOptions;
+            parentElement.typeDef = GetTypeDef(symbol);
+        }
 
-                childElement->function.prototype = FunctionTypeToString(const_cast<Element*>(childElement),
-                    &functionOptions);
-            }
+        children = false;
+
+        break;
+    }
+    case SymTagData:
+    {
+        parentElement.elementType = ElementType::dataType;
+        parentElement.data = GetData(symbol);
+        parentElement.size = parentElement.data->size;
+        parentElement.offset = parentElement.data->offset;
+        parentElement.bitOffset = parentElement.data->bitOffset;
+        parentElement.numberOfBits = parentElement.data->length;
+
+        if (parentElement.data->isPointer || parentElement.data->isReference)
+        {
+            children = false;
         }
+
+        break;
     }
-}
+    case SymTagEnum:
+    {
+        parentElement.elementType = ElementType::enumType;
+        parentElement.enum1 = GetEnum(symbol);
+        parentElement.enum1.Edit()->id = id;
 
-void PDB::AddVTablePointerToUDT(Element* element, qint64& currentOffset, DWORD& childSize)
-{
-	Element ptrElement = {};
+        break;
+    }
+    case SymTagBaseClass:
+    {
+        //Members of base class aren't display so it's includes are not needed
+        context->includesWereHidden = context->includesHidden;
+        context->includesHidden = true;
 
-	ptrElement.elementType = ElementType::dataType;
-	ptrElement.data.name = "__vfptr";
+        parentElement.elementType = ElementType::baseClassType;
+        parentElement.baseClass = GetBaseClass(symbol);
+        parentElement.size = parentElement.baseClass->length;
+        parentElement.offset = parentElement.baseClass->offset;
 
-	if (element->elementType == ElementType::udtType)
-	{
-		ptrElement.data.typeName = QString("%1Vtbl").arg(element->udt.name);
+        break;
+    }
+    case SymTagVTable:
+    {
+        parentElement.elementType = ElementType::vTableType;
 
-		if (element->udt.udtKind == UdtClass)
-		{
-			ptrElement.data.access = CV_private;
-		}
-		else
-		{
-			ptrElement.data.access = CV_public;
-		}
+        children = false;
 
-		element->udt.hasVTablePointer = true;
-	}
-	else
-	{
-		ptrElement.data.typeName = QString("%1Vtbl").arg(element->baseClass.name);
+        break;
+    }
+    case SymTagFriend:
+        children = false;
 
-		if (element->baseClass.udtKind == UdtClass)
-		{
-			ptrElement.data.access = CV_private;
-		}
-		else
-		{
-			ptrElement.data.access = CV_public;
-		}
+        break;
+    default:
+        children = false;
+        hasValidType = false;
 
-		element->baseClass.hasVTablePointer = true;
-	}
+        break;
+    }
 
-	ptrElement.data.isPointer = true;
-	ptrElement.data.pointerLevel = 1;
-	ptrElement.data.dataKind = DataIsMember;
-	ptrElement.data.isVTablePointer = true;
-	ptrElement.data.isCompilerGenerated = true;
-	ptrElement.offset = 0;
+    if (!isTypeImported && hasValidType && isTopLevel)
+    {
+        QSharedPointer<Element> cachedElement = elements.Find(GetElementKey(id, false));
 
-	if (type == CV_CFL_80386)
-	{
-		ptrElement.size = 4;
-		currentOffset += 4;
-		childSize += 4;
-	}
-	else
-	{
-		ptrElement.size = 8;
-		currentOffset += 8;
-		childSize += 8;
-	}
+        if (cachedElement)
+        {
+            context->resolutionDepth--;
 
-	static const DataOptions dataOptions;
+            return *cachedElement;
+        }
+    }
 
-	ptrElement.data.declaration = DataTypeToString(const_cast<Data*>(&ptrElement.data), &dataOptions);
+    if (children)
+    {
+        IDiaEnumSymbols* enumSymbols;
 
-	if (element->dataChildren.count() > 0 && element->dataChildren.at(0).data.isPadding)
-	{
-		element->dataChildren.replace(0, ptrElement);
-	}
-	else
-	{
-        InsertElement(element, &ptrElement);
-	}
-}
+        if (symbol->findChildren(SymTagNull, nullptr, nsNone, &enumSymbols) == S_OK)
+        {
+            LONG count;
 
-void PDB::CreateUnnamedType(Element* childElement)
-{
-	childElement->data.unnamedType = true;
+            if (enumSymbols->get_Count(&count) == S_OK)
+            {
+                if (count)
+                {
+                    IDiaSymbol* symbol2;
+                    ULONG celt = 0;
 
-	QString typeName = childElement->data.originalTypeName;
-	QHash<QString, DWORD>::const_iterator it = diaSymbols->find(typeName);
+                    int alignCount = 0;
+                    DWORD childSize = 0;
 
-	DWORD id = it.value();
-	IDiaSymbol* symbol;
+                    while (SUCCEEDED(enumSymbols->Next(1, &symbol2, &celt)) && (celt == 1))
+                    {
+                        if (symbol2->get_symTag(&symTag) == S_OK &&
+                            symTag == SymTagUDT &&
+                            parentElement.udt->isMainUDT)
+                        {
+                            context->belongsToMainUDT = true;
+                        }
 
-	if (GetSymbolByID(id, &symbol))
-	{
-		Element childElement2 = GetElement(symbol);
-		symbol->Release();
+                        Element childElement = GetElement(symbol2);
+                        bool add = true;
 
-		childElement->baseClassChildren.append(childElement2.baseClassChildren);
-		childElement->enumChildren.append(childElement2.enumChildren);
-		childElement->udtChildren.append(childElement2.udtChildren);
-		childElement->dataChildren.append(childElement2.dataChildren);
-		childElement->staticDataChildren.append(childElement2.staticDataChildren);
-		childElement->virtualFunctionChildren.append(childElement2.virtualFunctionChildren);
-		childElement->nonVirtualFunctionChildren.append(childElement2.nonVirtualFunctionChildren);
+                        HandleChildElement(&parentElement, &childElement, add, currentOffset, childSize);
 
-		childElement->data.hasChildren = true;
+                        if (add)
+                        {
+                            bool addPadding = false;
 
-		if (childElement2.elementType == ElementType::udtType)
-		{
-			childElement->udt = childElement2.udt;
-		}
-		else
-		{
-			childElement->enum1 = childElement2.enum1;
-		}
-	}
-}
+                            if ((childElement.offset) && (childElement.offset > currentOffset))
+                            {
+                                addPadding = true;
+                            }
 
-void PDB::AddPaddingToUDT(Element* parentElement, Element* childElement, qint64& currentOffset, int& alignCount)
-{
-	Element paddingElement = {};
+                            if (parentElement.elementType == ElementType::functionType)
+                            {
+                                addPadding = false;
+                            }
 
-	paddingElement.elementType = ElementType::dataType;
-	paddingElement.offset = currentOffset;
-	paddingElement.size = childElement->offset - currentOffset;
-	paddingElement.data.isArray = true;
-	paddingElement.data.isEndPadding = false;
-	paddingElement.data.name = QString("__padding%1").arg(alignCount);
-	paddingElement.data.arrayCount.append(paddingElement.size);
-	paddingElement.data.typeName = "unsigned char";
-	paddingElement.data.baseType = 5;
-	paddingElement.data.isCompilerGenerated = true;
-	paddingElement.data.isPadding = true;
+                            if (childElement.elementType == ElementType::dataType &&
+                                childElement.data->dataKind == DataIsStaticMember)
+                            {
+                                addPadding = false;
+                            }
 
-	if (parentElement->elementType == ElementType::udtType)
-	{
-		if (parentElement->udt.udtKind == UdtClass)
-		{
-			paddingElement.data.access = CV_private;
-		}
-		else
-		{
-			paddingElement.data.access = CV_public;
-		}
-	}
-	else
-	{
-		if (parentElement->baseClass.udtKind == UdtClass)
-		{
-			paddingElement.data.access = CV_private;
-		}
-		else
-		{
-			paddingElement.data.access = CV_public;
-		}
-	}
+                            if (addPadding)
+                            {
+                                AddPaddingToUDT(&parentElement, &childElement, currentOffset, alignCount);
+                            }
 
-	static const DataOptions dataOptions;
+                            InsertElement(&parentElement, &childElement);
 
-	paddingElement.data.declaration = DataTypeToString(const_cast<Data*>(&paddingElement.data), &dataOptions);
+                            if (childElement.size > 0 &&
+                                (childElement.elementType == ElementType::dataType &&
+                                    childElement.data->dataKind != DataIsStaticMember ||
+                                    childElement.elementType == ElementType::baseClassType))
+                            {
+                                bool modifyOffset = true;
 
-    InsertElement(parentElement, &paddingElement);
+                                if (childElement.elementType == ElementType::baseClassType)
+                                {
+                                    if (childElement.dataChildren.count() == 1)
+                                    {
+                                        //Empty base class optimization (EBCO) sets size of empty base class to be 0
+                                        if (childElement.dataChildren.at(0).data->isEndPadding)
+                                        {
+                                            modifyOffset = false;
+                                        }
+                                    }
+                                }
 
-	alignCount++;
-}
+                                if (modifyOffset)
+                                {
+                                    currentOffset = childElement.offset + childElement.size;
+                                    childSize = qMax(childSize, childElement.offset + childElement.size);
+                                }
+                            }
+                        }
 
-void PDB::AddEndPaddingToUDT(Element* parentElement, DWORD& childSize, long& sizeDifference)
-{
-	Element paddingElement = {};
+                        symbol2->Release();
+                    }
 
-	paddingElement.elementType = ElementType::dataType;
-	paddingElement.offset = childSize;
-	paddingElement.size = sizeDifference;
+                    // If UDT or Base Class parent size is greater then child size add ending aligment
+                    if (parentElement.elementType == ElementType::udtType ||
+                        parentElement.elementType == ElementType::baseClassType)
+                    {
+                        long sizeDifference = parentElement.size - childSize;
 
-	paddingElement.data.isArray = true;
-	paddingElement.data.isPadding = true;
-	paddingElement.data.isEndPadding = true;
-	paddingElement.data.name = "__endPadding";
-	paddingElement.data.arrayCount.append(paddingElement.size);
-	paddingElement.data.typeName = "unsigned char";
-	paddingElement.data.baseType = 5;
-	paddingElement.data.isCompilerGenerated = true;
+                        if (sizeDifference > 0)
+                        {
+                            AddEndPaddingToUDT(&parentElement, childSize, sizeDifference);
+                        }
+                    }
 
-	if (parentElement->elementType == ElementType::udtType)
-	{
-		if (parentElement->udt.udtKind == UdtClass)
-		{
-			paddingElement.data.access = CV_private;
-		}
-		else
-		{
-			paddingElement.data.access = CV_public;
-		}
-	}
-	else
-	{
-		if (parentElement->baseClass.udtKind == UdtClass)
-		{
-			paddingElement.data.access = CV_private;
-		}
-		else
-		{
-			paddingElement.data.access = CV_public;
-		}
-	}
+                    if (parentElement.elementType == ElementType::udtType &&
+                        !parentElement.udt->hasBaseClass &&
+                        parentElement.udt->hasVTable)
+                    {
+                        parentElement.udt.Edit()->numOfVTables++;
+                    }
 
-	static const DataOptions dataOptions;
+                    if (parentElement.elementType == ElementType::udtType &&
+                        parentElement.udt->isMainUDT)
+                    {
+                        /*if (options->generateBoth)
+                        {
+                            context->includes.insert(QString("#include \"BaseAddresses.h\""));
+                            context->includes.insert(QString("#include \"Function.h\""));
+                        }*/
 
-	paddingElement.data.declaration = DataTypeToString(const_cast<Data*>(&paddingElement.data), &dataOptions);
+                        parentElement.udt.Edit()->includes = context->includes;
+                        parentElement.typedefChildren.append(context->typedefChildren);
 
-    InsertElement(parentElement, &paddingElement);
-}
+                        context->includes.clear();
+                        context->typedefChildren.clear();
+                    }
 
-QString PDB::GetNameOfFirstVTable(const Element* element)
-{
-    int baseClassChildrenCount = element->baseClassChildren.count();
-    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
+                    /*if (!isTypeImported && hasValidType && !elements.contains(id))
+                    {
+                        elements.insert(id, element);
+                    }*/
+                }
+            }
 
-    for (int i = 0; i < baseClassChildrenCount; i++)
-    {
-        if (element->elementType == ElementType::baseClassType)
-        {
-            if (element->baseClass.numOfVTables > 1)
+            if (!isTypeImported && hasValidType && isTopLevel)
             {
-                destructorAdded = false;
-
-                vTableIndices.clear();
-                virtualFunctionPrototypes.clear();
+                elements.Insert(GetElementKey(id, false), parentElement);
             }
-        }
-
-        QString vTableName = GetNameOfFirstVTable(&element->baseClassChildren[i]);
 
-        if (i == 0 && vTableName.length() > 0)
-        {
-            return vTableName;
+            enumSymbols->Release();
         }
     }
 
-    for (int i = 0; i < virtualFunctionChildrenCount; i++)
+    context->resolutionDepth--;
+
+    return parentElement;
+}
+
+void PDB::InsertElement(Element* element, const Element* childElement)
+{
+    switch (childElement->elementType)
     {
-        //getVTableIndices is only for updating virtual base offsets of base classes
-        if (element->elementType != ElementType::baseClassType ||
-            element->elementType == ElementType::baseClassType &&
-            (element->baseClass.numOfVTables > 1))
-        {
-            continue;
-        }
+    case ElementType::baseClassType:
+        element->baseClassChildren.append(*childElement);
 
-        int vTableIndex = element->virtualFunctionChildren.at(i).function.virtualBaseOffset >> 2;
-        static const FunctionOptions functionOptions = { false, false, false, false };
-        QString functionPrototype = FunctionTypeToString(const_cast<Element*>(&element->virtualFunctionChildren.at(i)),
-            &functionOptions);
+        break;
+    case ElementType::enumType:
+        element->enumChildren.append(*childElement);
+
+        break;
+    case ElementType::udtType:
+        element->udtChildren.append(*childElement);
 
-        QHash<QString, int>::const_iterator it = vTableIndices.find(functionPrototype);
+        break;
+    case ElementType::typedefType:
+        element->typedefChildren.append(*childElement);
 
-        if (it != vTableIndices.end())
+        break;
+    case ElementType::dataType:
+    {
+        if (childElement->data->dataKind == DataIsStaticMember)
         {
-            return element->baseClass.name;
+            element->staticDataChildren.append(*childElement);
         }
         else
         {
-            if (element->virtualFunctionChildren.at(i).function.isDestructor)
-            {
-                if (destructorAdded)
-                {
-                    QHash<QString, int>::const_iterator it2;
-
-                    for (it2 = vTableIndices.begin(); it2 != vTableIndices.end(); it2++)
-                    {
-                        if (it2.key().at(0) == '~')
-                        {
-                            break;
-                        }
-                    }
-
-                    continue;
-                }
-
-                vTableIndices.insert(functionPrototype, vTableIndex);
-                destructorAdded = true;
-
-                continue;
-            }
+            element->dataChildren.append(*childElement);
+        }
 
-            vTableIndices.insert(functionPrototype, vTableIndex);
+        break;
+    }
+    case ElementType::functionType:
+    {
+        if (childElement->function->isVirtual)
+        {
+            element->virtualFunctionChildren.append(*childElement);
+        }
+        else
+        {
+            element->nonVirtualFunctionChildren.append(*childElement);
         }
+
+        break;
+    }
     }
+}
 
-    return "";
+void PDB::JoinLists(Element* element)
+{
+    element->children.append(element->baseClassChildren);
+    element->children.append(element->enumChildren);
+    element->children.append(element->udtChildren);
+    element->children.append(element->typedefChildren);
+    element->children.append(element->dataChildren);
+    element->children.append(element->staticDataChildren);
+    element->children.append(element->virtualFunctionChildren);
+    element->children.append(element->nonVirtualFunctionChildren);
 }
 
-void PDB::GetVTables(Element* element, bool addToPrototypesList)
+void PDB::HandleChildElement(Element* parentElement, Element* childElement, bool& add, qint64& currentOffset, DWORD& childSize)
 {
-    if (element->elementType == ElementType::udtType)
+    switch (childElement->elementType)
     {
-        QString firstVTableName = GetNameOfFirstVTable(const_cast<Element*>(element));
-
-        if (firstVTableName.length() == 0)
-        {
-            firstVTableName = element->udt.name;
-        }
-
-        element->udt.vTableNames.insert(0, firstVTableName);
-
-        vTableIndices.clear();
-        virtualFunctionPrototypes.clear();
+    case ElementType::baseClassType:
+    {
+        HandleBaseClassChild(parentElement, childElement);
 
-        destructorAdded = false;
+        break;
+    }
+    case ElementType::udtType:
+    {
+        HandleUDTChild(parentElement, childElement, add);
 
-        vTableNames.insert(0, firstVTableName);
+        break;
     }
+    case ElementType::enumType:
+    {
+        HandleEnumChild(childElement, add);
 
-    int baseClassChildrenCount = element->baseClassChildren.count();
-    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
+        break;
+    }
+    case ElementType::vTableType:
+    {
+        HandleVTableChild(parentElement, add, currentOffset, childSize);
 
-    for (int i = 0; i < baseClassChildrenCount; i++)
+        break;
+    }
+    case ElementType::typedefType:
     {
-        if (element->elementType == ElementType::baseClassType &&
-            element->baseClass.numOfVTables > 1 &&
-            i == 0)
-        {
-            element->baseClass.vTableNames.insert(0, vTableNames[0]);
-        }
+        HandleTypeDefChild(childElement, add);
 
-        GetVTables(&element->baseClassChildren[i], addToPrototypesList);
+        break;
+    }
+	case ElementType::dataType:
+	{
+		HandleDataChild(parentElement, childElement, add);
 
-        if (element->elementType == ElementType::baseClassType)
-        {
-            element->baseClass.vTableNames.insert(element->baseClassChildren.at(i).baseClass.vTableNames);
-        }
+		break;
+	}
+	case ElementType::functionType:
+	{
+		HandleFunctionChild(parentElement, childElement, add);
 
-        if (i == 0)
-        {
-            QHash<QString, int>::const_iterator it;
-            QString functionPrototype;
-            int vTableIndex = -1;
+		break;
+	}
+    case ElementType::funcDebugStartType:
+    case ElementType::funcDebugEndType:
+    case ElementType::blockType:
+    case ElementType::callSiteType:
+    case ElementType::labelType:
+    case ElementType::unknownType:
+        add = false;
 
-            for (it = vTables[vTableNames[0]].begin(); it != vTables[vTableNames[0]].end(); it++)
-            {
-                if (it.key().at(0) == '~')
-                {
-                    vTables[vTableNames[0]].remove(it.key());
+        break;
+    }
+}
 
-                    break;
-                }
-            }
+void PDB::HandleBaseClassChild(Element* parentElement, Element* childElement)
+{
+    ResolutionContext* context = GetResolutionContext();
 
-            vTables[vTableNames[0]].insert(vTableIndices);
+	if (parentElement->elementType == ElementType::udtType)
+	{
+		if (!parentElement->udt->hasBaseClass)
+		{
+            parentElement->udt.Edit()->hasBaseClass = true;
+		}
+	}
 
-            if (addToPrototypesList)
-            {
-                virtualFunctionPrototypes2[vTableNames[0]].insert(virtualFunctionPrototypes);
-            }
-        }
-        else
-        {
-            if (element->baseClassChildren.at(i).baseClass.hasVTable &&
-                vTableNames2.find(element->baseClassChildren.at(i).baseClass.name) == vTableNames2.end())
-            {
-                vTables.insert(element->baseClassChildren.at(i).baseClass.name, vTableIndices);
-                vTableNames.insert(vTableNames.count(), element->baseClassChildren.at(i).baseClass.name);
+	if (childElement->baseClass->hasVTable)
+	{
+		if (parentElement->elementType == ElementType::udtType)
+		{
+			if (childElement->baseClass->numOfVTables > 1)
+			{
+                parentElement->udt.Edit()->numOfVTables += childElement->baseClass->numOfVTables;
+			}
+			else
+			{
+                parentElement->udt.Edit()->numOfVTables++;
+			}
+		}
+		else if (parentElement->elementType == ElementType::baseClassType)
+		{
+			if (childElement->baseClass->numOfVTables > 1)
+			{
+                parentElement->baseClass.Edit()->numOfVTables += childElement->baseClass->numOfVTables;
+			}
+			else
+			{
+                parentElement->baseClass.Edit()->numOfVTables++;
+			}
+		}
+	}
 
-                if (element->elementType == ElementType::baseClassType)
-                {
-                    if (element->baseClass.numOfVTables > 1)
-                    {
-                        int index = element->baseClass.vTableNames.count();
+	if (childElement->size > 1 &&
+		GetChildrenSize(const_cast<Element*>(childElement)) > childElement->size)
+	{
+		FixOffsets(childElement);
+	}
 
-                        element->baseClass.vTableNames.insert(index, element->baseClassChildren.at(i).baseClass.name);
-                    }
-                    else
-                    {
-                        element->baseClass.vTableNames.insert(element->baseClass.vTableNames.count(),
-                            element->baseClassChildren.at(i).baseClass.name);
-                    }
-                }
+    if (parentElement->udt->isMainUDT || parentElement->udt->belongsToMainUDT)
+	{
+		//Don't show includes if they were already hidden before this base class
+		if (!context->includesWereHidden)
+		{
+			context->includesHidden = false;
+		}
+	}
 
-                if (addToPrototypesList)
-                {
-                    virtualFunctionPrototypes2.insert(element->baseClassChildren.at(i).baseClass.name, virtualFunctionPrototypes);
-                }
-            }
-        }
+    parentElement->baseClassNames.append(childElement->baseClass->name);
+    parentElement->baseClassNames.append(childElement->baseClassNames);
+}
 
-        if (element->elementType == ElementType::baseClassType)
-        {
-            if (element->baseClass.numOfVTables > 1)
-            {
-                destructorAdded = false;
+void PDB::HandleUDTChild(Element* parentElement, Element* childElement, bool& add)
+{
+    ResolutionContext* context = GetResolutionContext();
 
-                vTableIndices.clear();
-                virtualFunctionPrototypes.clear();
-            }
-        }
-        else if (element->elementType == ElementType::udtType)
-        {
-            destructorAdded = false;
+	if (childElement->udt->name.startsWith("__cta"))
+	{
+		add = false;
+	}
 
-            vTableIndices.clear();
-            virtualFunctionPrototypes.clear();
-        }
-    }
+	if (childElement->udt->isUnnamed)
+	{
+		add = false;
+	}
 
-    if (element->elementType == ElementType::baseClassType &&
-        element->baseClass.numOfVTables > 1)
-    {
-        UpdateVTables(element, &element->baseClass.vTableNames, addToPrototypesList);
-    }
+	//Sometimes inner udt that doesn't belong to main udt is added
+	if (!CheckIfInnerUDTBelongsToMainUDT(parentElement, childElement))
+	{
+		add = false;
+	}
 
-    for (int i = 0; i < virtualFunctionChildrenCount; i++)
-    {
-        //getVTableIndices is only for updating virtual base offsets of base classes
-        if (element->elementType != ElementType::baseClassType ||
-            element->elementType == ElementType::baseClassType &&
-            (element->baseClass.numOfVTables > 1))
-        {
-            continue;
-        }
-
-        int vTableIndex = element->virtualFunctionChildren.at(i).function.virtualBaseOffset >> 2;
-        static const FunctionOptions functionOptions = { false, false, false, false };
-        QString functionPrototype = FunctionTypeToString(const_cast<Element*>(&element->virtualFunctionChildren.at(i)), &functionOptions);
+	if (context->RemoveScopeResolutionOperator())
+	{
+		context->parentClassName = context->parentClassName2;
+	}
+}
 
-        QString functionName;
-        QString value;
+void PDB::HandleEnumChild(Element* childElement, bool& add)
+{
+    if (childElement->enum1->isUnnamed)
+    {
+        add = false;
+    }
+}
 
-        if (addToPrototypesList)
-        {
-            functionName = element->virtualFunctionChildren.at(i).function.name;
-            value = QString("%1::%2").arg(element->baseClass.name).arg(functionName);
-        }
+void PDB::HandleVTableChild(Element* parentElement, bool& add, qint64& currentOffset, DWORD& childSize)
+{
+	add = false;
 
-        QHash<QString, int>::const_iterator it = vTableIndices.find(functionPrototype);
+    AddVTablePointerToUDT(parentElement, currentOffset, childSize);
+}
 
-        if (it != vTableIndices.end())
-        {
-            /*
-            * There are two ways to handle case with same pure virtual function in both parent and child class
-            * (that case happens when pure virtual function from base class is not implemented in child class).
-            * First way is to assign isOverridden to true only if virtual function is not pure.
-            * Second way is to assign for example isPureVirtualFunctionFromBaseClass to true instead of assigning isOverridden
-            * to true and then just don't display virtual function if isPureVirtualFunctionFromBaseClass is true
-            */
+void PDB::HandleTypeDefChild(Element* childElement, bool& add)
+{
+	if (options->displayTypedefs)
+	{
+		QString oldTypeName = childElement->typeDef->oldTypeName;
+		QString newTypeName = childElement->typeDef->newTypeName;
 
-            element->virtualFunctionChildren[i].function.virtualBaseOffset = it.value() << 2;
+		if (options->useTypedefKeyword)
+		{
+			childElement->typeDef.Edit()->declaration = QString("typedef %1 %2").arg(oldTypeName).arg(newTypeName);
+		}
+		else
+		{
+			childElement->typeDef.Edit()->declaration = QString("using %1 = %2").arg(newTypeName).arg(oldTypeName);
+		}
+	}
+	else
+	{
+		add = false;
+	}
+}
 
-            if (!element->virtualFunctionChildren[i].function.isPure)
-            {
-                element->virtualFunctionChildren[i].function.isOverridden = true;
-            }
-        }
-        else
-        {
-            if (element->virtualFunctionChildren.at(i).function.isDestructor)
-            {
-                if (destructorAdded)
-                {
-                    element->virtualFunctionChildren[i].function.isOverridden = true;
+void PDB::HandleDataChild(Element* parentElement, Element* childElement, bool& add)
+{
+    if (childElement->data->dataKind == DataIsLocal ||
+        childElement->data->dataKind == DataIsStaticLocal)
+    {
+        add = false;
 
-                    QHash<QString, int>::const_iterator it2;
+        parentElement->localVariables.append(*childElement);
+    }
 
-                    for (it2 = vTableIndices.begin(); it2 != vTableIndices.end(); it2++)
-                    {
-                        if (it2.key().at(0) == '~')
-                        {
-                            element->virtualFunctionChildren[i].function.virtualBaseOffset = it2.value() << 2;
+    if (childElement->data->typeName.contains("<unnamed"))
+    {
+        CreateUnnamedType(childElement);
+    }
 
-                            vTableIndex = it2.value();
-                            vTableIndices.remove(it2.key());
+    //Declaration is not needed for base class since it's members are not displayed
+    if (add &&
+        (parentElement->elementType == ElementType::udtType ||
+            parentElement->elementType == ElementType::enumType))
+    {
+        static const DataOptions dataOptions;
 
-                            break;
-                        }
-                    }
+        childElement->data.Edit()->declaration = DataTypeToString(&*childElement->data, &dataOptions);
+    }
+}
 
-                    vTableIndices.insert(functionPrototype, vTableIndex);
+void PDB::HandleFunctionChild(Element* parentElement, Element* childElement, bool& add)
+{
+    if (childElement->function->name == "__vecDelDtor")
+    {
+        add = false;
+    }
 
-                    if (addToPrototypesList)
-                    {
-                        QHash<QString, QString>::const_iterator it2;
+    if (childElement->function->isVirtual)
+    {
+        if (parentElement->elementType == ElementType::udtType && !parentElement->udt->hasVTable)
+        {
+            parentElement->udt.Edit()->hasVTable = true;
+        }
+        else if (parentElement->elementType == ElementType::baseClassType && !parentElement->baseClass->hasVTable)
+        {
+            parentElement->baseClass.Edit()->hasVTable = true;
+        }
+    }
 
-                        for (it2 = virtualFunctionPrototypes.begin(); it2 != virtualFunctionPrototypes.end(); it2++)
-                        {
-                            if (it2.key().at(0) == '~')
-                            {
-                                virtualFunctionPrototypes.remove(it2.key());
+    if (!childElement->function->returnType1.isPointer &&
+        !childElement->function->returnType1.isReference)
+    {
+        IDiaSymbol* symbol2;
+        DWORD id = diaSymbols->value(childElement->function->returnType1.originalTypeName);
 
-                                break;
-                            }
-                        }
+        if (GetSymbolByID(id, &symbol2))
+        {
+            childElement->function.Edit()->isRVOApplied = CheckIfRVOIsAppliedToFunction(symbol2);
+        }
+    }
 
-                        virtualFunctionPrototypes.insert(functionPrototype, value);
-                    }
+    if (parentElement->elementType == ElementType::udtType)
+    {
+        if (parentElement->udt->hasCastOperator)
+        {
+            if (childElement->function->name.startsWith("operator"))
+            {
+                QString name = childElement->function->name.mid(9);
 
-                    continue;
+                if (baseTypes2.contains(name))
+                {
+                    name = baseTypes2[name];
                 }
 
-                vTableIndices.insert(functionPrototype, vTableIndex);
-                destructorAdded = true;
-
-                if (addToPrototypesList)
+                if (name == childElement->function->returnType2)
                 {
-                    virtualFunctionPrototypes.insert(functionPrototype, value);
+                    childElement->function.Edit()->name = QString("operator %1").arg(name);
+                    childElement->function.Edit()->isCastOperator = true;
                 }
-
-                continue;
             }
-            else
-            {
-                //Check for covariant return type
-                if (element->virtualFunctionChildren.at(i).function.returnType1.typeName == element->baseClass.name)
-                {
-                    Element element2 = element->virtualFunctionChildren.at(i);
-                    Data data = element->virtualFunctionChildren.at(i).function.returnType1;
-                    int baseClassNamesCount = element->baseClassNames.count();
-                    static const DataOptions dataOptions = { false, true };
-                    QString returnType, functionPrototype2;
-                    bool found = false;
-
-                    for (int j = 0; j < baseClassNamesCount; j++)
-                    {
-						bool removeScopeOperator = options->removeScopeResolutionOperator;
-
-						options->removeScopeResolutionOperator = false;
-                        data.typeName = element->baseClassNames.at(j);
-
-                        returnType = DataTypeToString(&data, &dataOptions);
-
-                        options->removeScopeResolutionOperator = removeScopeOperator;
-                        element2.function.originalReturnType = returnType;
-
-                        functionPrototype2 = FunctionTypeToString(const_cast<Element*>(&element2), &functionOptions);
-
-                        it = vTableIndices.find(functionPrototype2);
-
-                        if (it != vTableIndices.end())
-                        {
-                            if (!element->virtualFunctionChildren[i].function.isPure)
-                            {
-                                element->virtualFunctionChildren[i].function.isOverridden = true;
-                            }
-
-                            element->virtualFunctionChildren[i].function.virtualBaseOffset = it.value() << 2;
-
-                            vTableIndex = it.value();
-                            vTableIndices.remove(it.key());
-
-                            vTableIndices.insert(functionPrototype, vTableIndex);
-
-                            if (addToPrototypesList)
-                            {
-                                QHash<QString, QString>::const_iterator it2;
-
-                                for (it2 = virtualFunctionPrototypes.begin(); it2 != virtualFunctionPrototypes.end(); it2++)
-                                {
-                                    if (it2.key() == functionPrototype2)
-                                    {
-                                        virtualFunctionPrototypes.remove(it2.key());
-
-                                        break;
-                                    }
-                                }
+        }
 
-                                virtualFunctionPrototypes.insert(functionPrototype, value);
-                            }
+        if (childElement->function->isDefaultConstructor)
+        {
+            parentElement->udt.Edit()->hasDefaultConstructor = true;
+        }
 
-                            found = true;
+        if (childElement->function->isCopyConstructor)
+        {
+            parentElement->udt.Edit()->hasCopyConstructor = true;
+        }
 
-                            break;
-                        }
-                    }
+        if (childElement->function->isCopyAssignmentOperator)
+        {
+            parentElement->udt.Edit()->hasCopyAssignmentOperator = true;
+        }
 
-                    if (found)
-                    {
-                        continue;
-                    }
-                }
+        if (childElement->function->isDestructor)
+        {
+            if (childElement->function->isVirtual)
+            {
+                parentElement->udt.Edit()->hasVirtualDestructor = true;
+            }
+            else
+            {
+                parentElement->udt.Edit()->hasDestructor = true;
             }
+        }
 
-            vTableIndices.insert(functionPrototype, vTableIndex);
+        if (childElement->function->isVirtual &&
+            childElement->function->isPure &&
+            parentElement->elementType == ElementType::udtType &&
+            !parentElement->udt->isAbstract)
+        {
+            parentElement->udt.Edit()->isAbstract = true;
         }
 
-        if (addToPrototypesList)
+        if (options->applyReturnValueOptimization && childElement->function->isRVOApplied)
         {
-            virtualFunctionPrototypes.insert(functionPrototype, value);
+            ApplyReturnValueOptimization(childElement);
         }
     }
 
-    if (element->elementType == ElementType::udtType)
+    /*
+    * Prototypes for virtual functions shouldn't be created here because it's not known which
+    * virtual function is overriden.
+    * If udt doesn't have base class then prototypes can be created here because there are no
+    * overriden functions in that case
+    */
+    if (add)
     {
-        element->udt.vTableNames.insert(vTableNames);
-        UpdateVTables(element, &element->udt.vTableNames, addToPrototypesList);
-
-        QList<Element> virtualFunctionChildren;
-
-        for (int i = 0; i < element->udt.numOfVTables; i++)
+        if (childElement->function->isVirtual)
         {
-            QMap<int, Element> virtualFunctions;
-
-            for (int j = 0; j < virtualFunctionChildrenCount; j++)
+            if (parentElement->elementType == ElementType::udtType && !parentElement->udt->hasBaseClass)
             {
                 static const FunctionOptions functionOptions;
-                QString prototype = FunctionTypeToString(const_cast<Element*>(&element->virtualFunctionChildren.at(j)),
-                    &functionOptions);
-
-                element->virtualFunctionChildren[j].function.prototype = prototype;
 
-                if (element->virtualFunctionChildren.at(j).function.indexOfVTable == i)
-                {
-                    int offset = element->virtualFunctionChildren.at(j).function.virtualBaseOffset;
-
-                    virtualFunctions.insert(offset, element->virtualFunctionChildren.at(j));
-                }
+                childElement->function.Edit()->prototype = FunctionTypeToString(const_cast<Element*>(childElement),
+                    &functionOptions);
             }
-
-            virtualFunctionChildren.append(virtualFunctions.values());
-        }
-
-        if (virtualFunctionChildren.count() > 0)
-        {
-            element->virtualFunctionChildren = virtualFunctionChildren;
         }
         else
         {
-            static const FunctionOptions functionOptions;
-            QString prototype;
-
-            for (int i = 0; i < virtualFunctionChildrenCount; i++)
+            if (parentElement->elementType == ElementType::udtType)
             {
-                prototype = FunctionTypeToString(const_cast<Element*>(&element->virtualFunctionChildren.at(i)), &functionOptions);
+                static const FunctionOptions functionOptions;
 
-                element->virtualFunctionChildren[i].function.prototype = prototype;
+                childElement->function.Edit()->prototype = FunctionTypeToString(const_cast<Element*>(childElement),
+                    &functionOptions);
             }
         }
     }
 }
 
-QHash<QString, int> PDB::GetVTable(QString vTableName)
+void PDB::AddVTablePointerToUDT(Element* element, qint64& currentOffset, DWORD& childSize)
 {
-    QHash<QString, int> vTable;
-    QHash<QString, QHash<QString, int>>::const_iterator it;
-
-    for (it = vTables.begin(); it != vTables.end(); it++)
-    {
-        if (it.key() == vTableName)
-        {
-            vTable = it.value();
+	Element ptrElement = {};
 
-            break;
-        }
-    }
+	ptrElement.elementType = ElementType::dataType;
+	ptrElement.data.Edit()->name = "__vfptr";
 
-    return vTable;
-}
+	if (element->elementType == ElementType::udtType)
+	{
+		ptrElement.data.Edit()->typeName = QString("%1Vtbl").arg(element->udt->name);
 
-void PDB::UpdateVTable(Element* element, int indexOfVTable, QString vTableName, QMap<int, QString>* vTableNames,
-    QHash<QString, int>* vTableIndices, bool addToPrototypesList,
-    QHash<QString, QString>* virtualFunctionPrototypes)
-{
-    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
+		if (element->udt->udtKind == UdtClass)
+		{
+			ptrElement.data.Edit()->access = CV_private;
+		}
+		else
+		{
+			ptrElement.data.Edit()->access = CV_public;
+		}
 
-    for (int i = 0; i < virtualFunctionChildrenCount; i++)
-    {
-        int vTableIndex = element->virtualFunctionChildren.at(i).function.virtualBaseOffset >> 2;
-        static const FunctionOptions functionOptions = { false, false, false, false };
-        QString functionPrototype = FunctionTypeToString(const_cast<Element*>(&element->virtualFunctionChildren.at(i)),
-            &functionOptions);
-
-        QString functionName;
-        QString value;
+		element->udt.Edit()->hasVTablePointer = true;
+	}
+	else
+	{
+		ptrElement.data.Edit()->typeName = QString("%1Vtbl").arg(element->baseClass->name);
 
-        if (addToPrototypesList)
-        {
-            functionName = element->virtualFunctionChildren.at(i).function.name;
+		if (element->baseClass->udtKind == UdtClass)
+		{
+			ptrElement.data.Edit()->access = CV_private;
+		}
+		else
+		{
+			ptrElement.data.Edit()->access = CV_public;
+		}
 
-            if (element->elementType == ElementType::udtType)
-            {
-                value = QString("%1::%2").arg(element->udt.name).arg(functionName);
-            }
-            else
-            {
-                value = QString("%1::%2").arg(element->baseClass.name).arg(functionName);
-            }
-        }
+		element->baseClass.Edit()->hasVTablePointer = true;
+	}
 
-        if (element->virtualFunctionChildren.at(i).function.isDestructor)
-        {
-            QHash<QString, int>::const_iterator it2;
+	ptrElement.data.Edit()->isPointer = true;
+	ptrElement.data.Edit()->pointerLevel = 1;
+	ptrElement.data.Edit()->dataKind = DataIsMember;
+	ptrElement.data.Edit()->isVTablePointer = true;
+	ptrElement.data.Edit()->isCompilerGenerated = true;
+	ptrElement.offset = 0;
 
-            for (it2 = vTableIndices->begin(); it2 != vTableIndices->end(); it2++)
-            {
-                if (it2.key().at(0) == '~')
-                {
-                    element->virtualFunctionChildren[i].function.isOverridden = true;
-                    element->virtualFunctionChildren[i].function.virtualBaseOffset = it2.value() << 2;
+	if (type == CV_CFL_80386)
+	{
+		ptrElement.size = 4;
+		currentOffset += 4;
+		childSize += 4;
+	}
+	else
+	{
+		ptrElement.size = 8;
+		currentOffset += 8;
+		childSize += 8;
+	}
 
-                    vTableIndex = it2.value();
-                    vTableIndices->remove(it2.key());
+	static const DataOptions dataOptions;
 
-                    break;
-                }
-            }
+	ptrElement.data.Edit()->declaration = DataTypeToString(&*ptrElement.data, &dataOptions);
 
-            vTableIndices->insert(functionPrototype, vTableIndex);
+	if (element->dataChildren.count() > 0 && element->dataChildren.at(0).data->isPadding)
+	{
+		element->dataChildren.replace(0, ptrElement);
+	}
+	else
+	{
+        InsertElement(element, &ptrElement);
+	}
+}
 
-            if (addToPrototypesList)
-            {
-                QHash<QString, QString>::const_iterator it3;
+void PDB::CreateUnnamedType(Element* childElement)
+{
+	childElement->data.Edit()->unnamedType = true;
 
-                for (it3 = virtualFunctionPrototypes->begin(); it3 != virtualFunctionPrototypes->end(); it3++)
-                {
-                    if (it3.key().at(0) == '~')
-                    {
-                        virtualFunctionPrototypes->remove(it3.key());
+	QString typeName = childElement->data->originalTypeName;
+	QHash<QString, DWORD>::const_iterator it = diaSymbols->find(typeName);
 
-                        break;
-                    }
-                }
+	DWORD id = it.value();
+	IDiaSymbol* symbol;
 
-                virtualFunctionPrototypes->insert(functionPrototype, value);
-            }
-        }
-        else
-        {
-            QHash<QString, int>::const_iterator it = vTableIndices->find(functionPrototype);
+	if (GetSymbolByID(id, &symbol))
+	{
+		Element childElement2 = GetElement(symbol);
+		symbol->Release();
 
-            if (it != vTableIndices->end())
-            {
-                element->virtualFunctionChildren[i].function.virtualBaseOffset = it.value() << 2;
+		childElement->baseClassChildren.append(childElement2.baseClassChildren);
+		childElement->enumChildren.append(childElement2.enumChildren);
+		childElement->udtChildren.append(childElement2.udtChildren);
+		childElement->dataChildren.append(childElement2.dataChildren);
+		childElement->staticDataChildren.append(childElement2.staticDataChildren);
+		childElement->virtualFunctionChildren.append(childElement2.virtualFunctionChildren);
+		childElement->nonVirtualFunctionChildren.append(childElement2.nonVirtualFunctionChildren);
 
-                if (!element->virtualFunctionChildren[i].function.isPure)
-                {
-                    element->virtualFunctionChildren[i].function.isOverridden = true;
-                }
+		childElement->data.Edit()->hasChildren = true;
 
-                /*
-                * Update indexOfVTable also in case of main table because value of indexOfVTable of funtion can change if function
-                * is declared in multiple vtables
-                */
+		if (childElement2.elementType == ElementType::udtType)
+		{
+			childElement->udt = childElement2.udt;
+		}
+		else
+		{
+			childElement->enum1 = childElement2.enum1;
+		}
+	}
+}
 
-                QMap<int, QString>::const_iterator it2;
+void PDB::AddPaddingToUDT(Element* parentElement, Element* childElement, qint64& currentOffset, int& alignCount)
+{
+	Element paddingElement = {};
 
-                for (it2 = vTableNames->begin(); it2 != vTableNames->end(); it2++)
-                {
-                    if (vTableName == it2.value())
-                    {
-                        element->virtualFunctionChildren[i].function.indexOfVTable = it2.key();
-                        element->virtualFunctionChildren[i].function.vTableName = it2.value();
+	paddingElement.elementType = ElementType::dataType;
+	paddingElement.offset = currentOffset;
+	paddingElement.size = childElement->offset - currentOffset;
+	paddingElement.data.Edit()->isArray = true;
+	paddingElement.data.Edit()->isEndPadding = false;
+	paddingElement.data.Edit()->name = QString("__padding%1").arg(alignCount);
+	paddingElement.data.Edit()->arrayCount.append(paddingElement.size);
+	paddingElement.data.Edit()->typeName = "unsigned char";
+	paddingElement.data.Edit()->baseType = 5;
+	paddingElement.data.Edit()->isCompilerGenerated = true;
+	paddingElement.data.Edit()->isPadding = true;
 
-                        break;
-                    }
-                }
+	if (parentElement->elementType == ElementType::udtType)
+	{
+		if (parentElement->udt->udtKind == UdtClass)
+		{
+			paddingElement.data.Edit()->access = CV_private;
+		}
+		else
+		{
+			paddingElement.data.Edit()->access = CV_public;
+		}
+	}
+	else
+	{
+		if (parentElement->baseClass->udtKind == UdtClass)
+		{
+			paddingElement.data.Edit()->access = CV_private;
+		}
+		else
+		{
+			paddingElement.data.Edit()->access = CV_public;
+		}
+	}
 
-                if (addToPrototypesList)
-                {
-                    virtualFunctionPrototypes->insert(functionPrototype, value);
-                }
-            }
-            else
-            {
-                if (indexOfVTable == 0 && element->virtualFunctionChildren.at(i).function.indexOfVTable == 0)
-                {
-                    QString name;
+	static const DataOptions dataOptions;
 
-                    if (element->elementType == ElementType::udtType)
-                    {
-                        name = element->udt.name;
-                    }
-                    else
-                    {
-                        name = element->baseClass.name;
-                    }
+	paddingElement.data.Edit()->declaration = DataTypeToString(&*paddingElement.data, &dataOptions);
 
-                    //Check for covariant return type
-                    if (element->virtualFunctionChildren.at(i).function.returnType1.typeName == name)
-                    {
-                        Element element2 = element->virtualFunctionChildren.at(i);
-                        Data data = element->virtualFunctionChildren.at(i).function.returnType1;
-                        int baseClassNamesCount = element->baseClassNames.count();
-                        static const DataOptions dataOptions = { false, true };
-                        QString returnType, functionPrototype2;
-                        bool found = false;
+    InsertElement(parentElement, &paddingElement);
 
-                        for (int j = 0; j < baseClassNamesCount; j++)
-                        {
-							bool removeScopeOperator = options->removeScopeResolutionOperator;
+	alignCount++;
+}
 
-							options->removeScopeResolutionOperator = false;
-                            data.typeName = element->baseClassNames.at(j);
+void PDB::AddEndPaddingToUDT(Element* parentElement, DWORD& childSize, long& sizeDifference)
+{
+	Element paddingElement = {};
 
-                            returnType = DataTypeToString(&data, &dataOptions);
+	paddingElement.elementType = ElementType::dataType;
+	paddingElement.offset = childSize;
+	paddingElement.size = sizeDifference;
 
-                            options->removeScopeResolutionOperator = removeScopeOperator;
-                            element2.function.originalReturnType = returnType;
+	paddingElement.data.Edit()->isArray = true;
+	paddingElement.data.Edit()->isPadding = true;
+	paddingElement.data.Edit()->isEndPadding = true;
+	paddingElement.data.Edit()->name = "__endPadding";
+	paddingElement.data.Edit()->arrayCount.append(paddingElement.size);
+	paddingElement.data.Edit()->typeName = "unsigned char";
+	paddingElement.data.Edit()->baseType = 5;
+	paddingElement.data.Edit()->isCompilerGenerated = true;
 
-                            functionPrototype2 = FunctionTypeToString(const_cast<Element*>(&element2), &functionOptions);
+	if (parentElement->elementType == ElementType::udtType)
+	{
+		if (parentElement->udt->udtKind == UdtClass)
+		{
+			paddingElement.data.Edit()->access = CV_private;
+		}
+		else
+		{
+			paddingElement.data.Edit()->access = CV_public;
+		}
+	}
+	else
+	{
+		if (parentElement->baseClass->udtKind == UdtClass)
+		{
+			paddingElement.data.Edit()->access = CV_private;
+		}
+		else
+		{
+			paddingElement.data.Edit()->access = CV_public;
+		}
+	}
 
-                            it = vTableIndices->find(functionPrototype2);
+	static const DataOptions dataOptions;
 
-                            if (it != vTableIndices->end())
-                            {
-                                if (!element->virtualFunctionChildren[i].function.isPure)
-                                {
-                                    element->virtualFunctionChildren[i].function.isOverridden = true;
-                                }
+	paddingElement.data.Edit()->declaration = DataTypeToString(&*paddingElement.data, &dataOptions);
 
-                                element->virtualFunctionChildren[i].function.virtualBaseOffset = it.value() << 2;
+    InsertElement(parentElement, &paddingElement);
+}
 
-                                vTableIndex = it.value();
-                                vTableIndices->remove(it.key());
+QString PDB::GetNameOfFirstVTable(const Element* element)
+{
+    ResolutionContext* context = GetResolutionContext();
 
-                                vTableIndices->insert(functionPrototype, vTableIndex);
+    int baseClassChildrenCount = element->baseClassChildren.count();
+    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
 
-                                if (addToPrototypesList)
-                                {
-                                    QHash<QString, QString>::const_iterator it2;
+    for (int i = 0; i < baseClassChildrenCount; i++)
+    {
+        if (element->elementType == ElementType::baseClassType)
+        {
+            if (element->baseClass->numOfVTables > 1)
+            {
+                context->destructorAdded = false;
 
-                                    for (it2 = virtualFunctionPrototypes->begin(); it2 != virtualFunctionPrototypes->end(); it2++)
-                                    {
-                                        if (it2.key() == functionPrototype2)
-                                        {
-                                            virtualFunctionPrototypes->remove(it2.key());
+                context->vTableIndices.clear();
+                context->virtualFunctionPrototypes.clear();
+            }
+        }
 
-                                            break;
-                                        }
-                                    }
+        QString vTableName = GetNameOfFirstVTable(&element->baseClassChildren[i]);
 
-                                    virtualFunctionPrototypes->insert(functionPrototype, value);
-                                }
+        if (i == 0 && vTableName.length() > 0)
+        {
+            return vTableName;
+        }
+    }
 
-                                found = true;
+    for (int i = 0; i < virtualFunctionChildrenCount; i++)
+    {
+        //getVTableIndices is only for updating virtual base offsets of base classes
+        if (element->elementType != ElementType::baseClassType ||
+            element->elementType == ElementType::baseClassType &&
+            (element->baseClass->numOfVTables > 1))
+        {
+            continue;
+        }
 
-                                break;
-                            }
-                        }
+        int vTableIndex = element->virtualFunctionChildren.at(i).function->virtualBaseOffset >> 2;
+        static const FunctionOptions functionOptions = { false, false, false, false };
+        QString functionPrototype = FunctionTypeToString(const_cast<Element*>(&element->virtualFunctionChildren.at(i)),
+            &functionOptions);
 
-                        if (found)
-                        {
-                            continue;
-                        }
-                    }
+        QHash<QString, int>::const_iterator it = context->vTableIndices.find(functionPrototype);
 
-                    vTableIndices->insert(functionPrototype, vTableIndex);
-
-                    QMap<int, QString>::const_iterator it2;
+        if (it != context->vTableIndices.end())
+        {
+            return element->baseClass->name;
+        }
+        else
+        {
+            if (element->virtualFunctionChildren.at(i).function->isDestructor)
+            {
+                if (context->destructorAdded)
+                {
+                    QHash<QString, int>::const_iterator it2;
 
-                    for (it2 = vTableNames->begin(); it2 != vTableNames->end(); it2++)
+                    for (it2 = context->vTableIndices.begin(); it2 != context->vTableIndices.end(); it2++)
                     {
-                        if (vTableName == it2.value())
+                        if (it2.key().at(0) == '~')
                         {
-                            element->virtualFunctionChildren[i].function.indexOfVTable = it2.key();
-                            element->virtualFunctionChildren[i].function.vTableName = it2.value();
-
                             break;
                         }
                     }
 
-                    if (addToPrototypesList)
-                    {
-                        virtualFunctionPrototypes->insert(functionPrototype, value);
-                    }
+                    continue;
                 }
+
+                context->vTableIndices.insert(functionPrototype, vTableIndex);
+                context->destructorAdded = true;
+
+                continue;
             }
+
+            context->vTableIndices.insert(functionPrototype, vTableIndex);
         }
     }
 
-    vTables[vTableName] = *vTableIndices;
-    virtualFunctionPrototypes2[vTableName] = *virtualFunctionPrototypes;
+    return "";
 }
 
-void PDB::UpdateVTables(Element* element, QMap<int, QString>* vTableNames, bool addToPrototypesList,
-    QHash<QString, QString>* virtualFunctionPrototypes)
+void PDB::GetVTables(Element* element, bool addToPrototypesList)
 {
-    /*
-    * If vTables are looped using QHash then they wouldn't be always visited in same order so if multiple base classes
-    * with exactly same virtual functions are inherited it can happen that sometimes function will be declared as part of
-    * third vTable for example and sometimes as part of first vTable. Because of that it's better to iterate QMap instead
-    * in ascending or descending order
-    */
+    ResolutionContext* context = GetResolutionContext();
 
-    auto it = vTableNames->end(), end = vTableNames->begin();
-
-    while (it != end)
+    if (element->elementType == ElementType::udtType)
     {
-        --it;
-
-        int indexOfVTable = it.key();
-        QString vTableName = it.value();
-
-        QHash<QString, QHash<QString, QString>>::const_iterator it2;
-        QHash<QString, QString> virtualFunctionPrototypes;
+        QString firstVTableName = GetNameOfFirstVTable(const_cast<Element*>(element));
 
-        for (it2 = virtualFunctionPrototypes2.begin(); it2 != virtualFunctionPrototypes2.end(); it2++)
+        if (firstVTableName.length() == 0)
         {
-            if (it.value() == it2.key())
-            {
-                virtualFunctionPrototypes = it2.value();
-
-                break;
-            }
+            firstVTableName = element->udt->name;
         }
 
-        QHash<QString, int> vTableIndices = vTables.value(it.value());
+        element->udt.Edit()->vTableNames.insert(0, firstVTableName);
 
-        UpdateVTable(element, indexOfVTable, vTableName, vTableNames, &vTableIndices, addToPrototypesList,
-            &virtualFunctionPrototypes);
+        context->vTableIndices.clear();
+        context->virtualFunctionPrototypes.clear();
+
+        context->destructorAdded = false;
+
+        context->vTableNames.insert(0, firstVTableName);
     }
-}
 
-QHash<QString, QString> PDB::getFunctionPrototypes(QString vTableName)
-{
-    QHash<QString, QString> virtualFunctionPrototypes;
-    QHash<QString, QHash<QString, QString>>::const_iterator it;
+    int baseClassChildrenCount = element->baseClassChildren.count();
+    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
 
-    for (it = virtualFunctionPrototypes2.begin(); it != virtualFunctionPrototypes2.end(); it++)
+    for (int i = 0; i < baseClassChildrenCount; i++)
     {
-        if (it.key() == vTableName)
+        if (element->elementType == ElementType::baseClassType &&
+            element->baseClass->numOfVTables > 1 &&
+            i == 0)
         {
-            virtualFunctionPrototypes = it.value();
-
-            break;
+            element->baseClass.Edit()->vTableNames.insert(0, context->vTableNames[0]);
         }
-    }
-
-    return virtualFunctionPrototypes;
-}
-
-Element PDB::OrderUDTElementChildren(Element element)
-{
-    Element newElement = element;
-    newElement.children.clear();
 
-    int count = element.children.count();
-    int lastVariableIndex = -1;
+        GetVTables(&element->baseClassChildren[i], addToPrototypesList);
 
-    /*
-    * Order:
-    * 1. Base Classes
-    * 2. Enums
-    * 3. Inner Types
-    * 4. Typedefs
-    * 5. Variables
-    * 6. Static Variables
-    * 7. Virtual Functions
-    * 8. Non Virtual Functions
-    */
+        if (element->elementType == ElementType::baseClassType)
+        {
+            element->baseClass.Edit()->vTableNames.insert(element->baseClassChildren.at(i).baseClass->vTableNames);
+        }
 
-    for (int i = 0; i < 8; i++)
-    {
-        for (int j = 0; j < count; j++)
+        if (i == 0)
         {
-            switch (i)
-            {
-            case 0:
+            QHash<QString, int>::const_iterator it;
+            QString functionPrototype;
+            int vTableIndex = -1;
+
+            for (it = context->vTables[context->vTableNames[0]].begin(); it != context->vTables[context->vTableNames[0]].end(); it++)
             {
-                if (element.children.at(j).elementType == ElementType::baseClassType)
+                if (it.key().at(0) == '~')
                 {
-                    Element newElement2 = OrderUDTElementChildren(element.children.at(j));
-                    newElement.children.append(newElement2);
+                    context->vTables[context->vTableNames[0]].remove(it.key());
+
+                    break;
                 }
+            }
 
-                break;
+            context->vTables[context->vTableNames[0]].insert(context->vTableIndices);
+
+            if (addToPrototypesList)
+            {
+                context->virtualFunctionPrototypes2[context->vTableNames[0]].insert(context->virtualFunctionPrototypes);
             }
-            case 1:
+        }
+        else
+        {
+            if (element->baseClassChildren.at(i).baseClass->hasVTable &&
+                context->vTableNames2.find(element->baseClassChildren.at(i).baseClass->name) == context->vTableNames2.end())
             {
-                if (element.children.at(j).elementType == ElementType::enumType)
+                context->vTables.insert(element->baseClassChildren.at(i).baseClass->name, context->vTableIndices);
+                context->vTableNames.insert(context->vTableNames.count(), element->baseClassChildren.at(i).baseClass->name);
+
+                if (element->elementType == ElementType::baseClassType)
                 {
-                    newElement.children.append(element.children.at(j));
+                    if (element->baseClass->numOfVTables > 1)
+                    {
+                        int index = element->baseClass->vTableNames.count();
+
+                        element->baseClass.Edit()->vTableNames.insert(index, element->baseClassChildren.at(i).baseClass->name);
+                    }
+                    else
+                    {
+                        element->baseClass.Edit()->vTableNames.insert(element->baseClass->vTableNames.count(),
+                            element->baseClassChildren.at(i).baseClass->name);
+                    }
                 }
 
-                break;
+                if (addToPrototypesList)
+                {
+                    context->virtualFunctionPrototypes2.insert(element->baseClassChildren.at(i).baseClass->name, context->virtualFunctionPrototypes);
+                }
             }
-            case 2:
+        }
+
+        if (element->elementType == ElementType::baseClassType)
+        {
+            if (element->baseClass->numOfVTables > 1)
             {
-                if (element.children.at(j).elementType == ElementType::udtType)
-                {
-                    if (element.children.at(j).udt.hasBaseClass)
-                    {
-                        QHash<QString, QHash<QString, int>> vTables2;
+                context->destructorAdded = false;
 
-                        if (vTables.count() > 0)
-                        {
-                            vTables2 = vTables;
+                context->vTableIndices.clear();
+                context->virtualFunctionPrototypes.clear();
+            }
+        }
+        else if (element->elementType == ElementType::udtType)
+        {
+            context->destructorAdded = false;
 
-                            vTables.clear();
-                        }
+            context->vTableIndices.clear();
+            context->virtualFunctionPrototypes.clear();
+        }
+    }
 
-                        GetVTables(&element.children[j]);
+    if (element->elementType == ElementType::baseClassType &&
+        element->baseClass->numOfVTables > 1)
+    {
+        UpdateVTables(element, &element->baseClass.Edit()->vTableNames, addToPrototypesList);
+    }
 
-                        if (vTables.count() > 0)
-                        {
-                            vTables = vTables2;
-                        }
-                    }
+    for (int i = 0; i < virtualFunctionChildrenCount; i++)
+    {
+        //getVTableIndices is only for updating virtual base offsets of base classes
+        if (element->elementType != ElementType::baseClassType ||
+            element->elementType == ElementType::baseClassType &&
+            (element->baseClass->numOfVTables > 1))
+        {
+            continue;
+        }
 
-                    Element newElement2 = OrderUDTElementChildren(element.children.at(j));
-                    newElement.children.append(newElement2);
-                }
+        int vTableIndex = element->virtualFunctionChildren.at(i).function->virtualBaseOffset >> 2;
+        static const FunctionOptions functionOptions = { false, false, false, false };
+        QString functionPrototype = FunctionTypeToString(const_cast<Element*>(&element->virtualFunctionChildren.at(i)), &functionOptions);
 
-                break;
-            }
-            case 3:
-            {
-                if (element.children.at(j).elementType == ElementType::typedefType)
-                {
-                    newElement.children.append(element.children.at(j));
-                }
+        QString functionName;
+        QString value;
 
-                break;
-            }
-            case 4:
-            {
-                if (element.children.at(j).elementType == ElementType::dataType &&
-                    element.children.at(j).data.dataKind != DataIsStaticMember)
-                {
-                    if (element.children.at(j).data.hasChildren)
-                    {
-                        if (element.children.at(j).data.isTypeNameOfEnum)
-                        {
-                            newElement.children.append(element.children.at(j));
-                        }
-                        else
-                        {
-                            element.children[j].elementType = ElementType::udtType;
+        if (addToPrototypesList)
+        {
+            functionName = element->virtualFunctionChildren.at(i).function->name;
+            value = QString("%1::%2").arg(element->baseClass->name).arg(functionName);
+        }
 
-                            Element newElement2 = OrderUDTElementChildren(element.children.at(j));
+        QHash<QString, int>::const_iterator it = context->vTableIndices.find(functionPrototype);
 
-                            newElement2.elementType = ElementType::dataType;
-                            newElement.children.append(newElement2);
-                        }
-                    }
-                    else
-                    {
-                        newElement.children.append(element.children.at(j));
+        if (it != context->vTableIndices.end())
+        {
+            /*
+            * There are two ways to handle case with same pure virtual function in both parent and child class
+            * (that case happens when pure virtual function from base class is not implemented in child class).
+            * First way is to assign isOverridden to true only if virtual function is not pure.
+            * Second way is to assign for example isPureVirtualFunctionFromBaseClass to true instead of assigning isOverridden
+            * to true and then just don't display virtual function if isPureVirtualFunctionFromBaseClass is true
+            */
 
-                        if (element.udt.numOfVTables > 1)
-                        {
-                            lastVariableIndex = newElement.children.count() - 1;
-                        }
-                    }
-                }
+            element->virtualFunctionChildren[i].function.Edit()->virtualBaseOffset = it.value() << 2;
 
-                break;
+            if (!element->virtualFunctionChildren[i].function->isPure)
+            {
+                element->virtualFunctionChildren[i].function.Edit()->isOverridden = true;
             }
-            case 5:
+        }
+        else
+        {
+            if (element->virtualFunctionChildren.at(i).function->isDestructor)
             {
-                if (element.children.at(j).elementType == ElementType::dataType &&
-                    element.children.at(j).data.dataKind == DataIsStaticMember)
+                if (context->destructorAdded)
                 {
-                    if (element.children.at(j).data.hasChildren)
+                    element->virtualFunctionChildren[i].function.Edit()->isOverridden = true;
+
+                    QHash<QString, int>::const_iterator it2;
+
+                    for (it2 = context->vTableIndices.begin(); it2 != context->vTableIndices.end(); it2++)
                     {
-                        if (element.children.at(j).data.isTypeNameOfEnum)
-                        {
-                            newElement.children.append(element.children.at(j));
-                        }
-                        else
+                        if (it2.key().at(0) == '~')
                         {
-                            element.children[j].elementType = ElementType::udtType;
+                            element->virtualFunctionChildren[i].function.Edit()->virtualBaseOffset = it2.value() << 2;
 
-                            Element newElement2 = OrderUDTElementChildren(element.children.at(j));
+                            vTableIndex = it2.value();
+                            context->vTableIndices.remove(it2.key());
 
-                            newElement2.elementType = ElementType::dataType;
-                            newElement.children.append(newElement2);
+                            break;
                         }
                     }
-                    else
+
+                    context->vTableIndices.insert(functionPrototype, vTableIndex);
+
+                    if (addToPrototypesList)
                     {
-                        newElement.children.append(element.children.at(j));
+                        QHash<QString, QString>::const_iterator it2;
 
-                        if (element.udt.numOfVTables > 1)
+                        for (it2 = context->virtualFunctionPrototypes.begin(); it2 != context->virtualFunctionPrototypes.end(); it2++)
                         {
-                            lastVariableIndex = newElement.children.count() - 1;
+                            if (it2.key().at(0) == '~')
+                            {
+                                context->virtualFunctionPrototypes.remove(it2.key());
+
+                                break;
+                            }
                         }
+
+                        context->virtualFunctionPrototypes.insert(functionPrototype, value);
                     }
+
+                    continue;
                 }
 
-                break;
-            }
-            case 6:
-            {
-                if (element.udt.numOfVTables == 1 &&
-                    element.children.at(j).elementType == ElementType::functionType &&
-                    element.children.at(j).function.isVirtual)
-                {
-                    int offset = element.children.at(j).function.virtualBaseOffset;
+                context->vTableIndices.insert(functionPrototype, vTableIndex);
+                context->destructorAdded = true;
 
-                    virtualFunctions.insert(offset, element.children.at(j));
+                if (addToPrototypesList)
+                {
+                    context->virtualFunctionPrototypes.insert(functionPrototype, value);
                 }
 
-                break;
+                continue;
             }
-            case 7:
+            else
             {
-                if (element.children.at(j).elementType == ElementType::functionType &&
-                    !element.children.at(j).function.isVirtual)
+                //Check for covariant return type
+                if (element->virtualFunctionChildren.at(i).function->returnType1.typeName == element->baseClass->name)
                 {
-                    newElement.children.append(element.children.at(j));
-                }
+                    Element element2 = element->virtualFunctionChildren.at(i);
+                    Data data = element->virtualFunctionChildren.at(i).function->returnType1;
+                    int baseClassNamesCount = element->baseClassNames.count();
+                    static const DataOptions dataOptions = { false, true };
+                    QString returnType, functionPrototype2;
+                    bool found = false;
 
-                break;
-            }
+                    for (int j = 0; j < baseClassNamesCount; j++)
+                    {
+						bool keepScopeResolutionOperator = context->keepScopeResolutionOperator;
+
+						context->keepScopeResolutionOperator = true;
+                        data.typeName = element->baseClassNames.at(j);
+
+                        returnType = DataTypeToString(&data, &dataOptions);
+
+                        context->keepScopeResolutionOperator = keepScopeResolutionOperator;
+                        element2.function.Edit()->originalReturnType = returnType;
+
+                        functionPrototype2 = FunctionTypeToString(const_cast<Element*>(&element2), &functionOptions);
+
+                        it = context->vTableIndices.find(functionPrototype2);
+
+                        if (it != context->vTableIndices.end())
+                        {
+                            if (!element->virtualFunctionChildren[i].function->isPure)
+                            {
+                                element->virtualFunctionChildren[i].function.Edit()->isOverridden = true;
+                            }
+
+                            element->virtualFunctionChildren[i].function.Edit()->virtualBaseOffset = it.value() << 2;
+
+                            vTableIndex = it.value();
+                            context->vTableIndices.remove(it.key());
+
+                            context->vTableIndices.insert(functionPrototype, vTableIndex);
+
+                            if (addToPrototypesList)
+                            {
+                                QHash<QString, QString>::const_iterator it2;
+
+                                for (it2 = context->virtualFunctionPrototypes.begin(); it2 != context->virtualFunctionPrototypes.end(); it2++)
+                                {
+                                    if (it2.key() == functionPrototype2)
+                                    {
+                                        context->virtualFunctionPrototypes.remove(it2.key());
+
+                                        break;
+                                    }
+                                }
+
+                                context->virtualFunctionPrototypes.insert(functionPrototype, value);
+                            }
+
+                            found = true;
+
+                            break;
+                        }
+                    }
+
+                    if (found)
+                    {
+                        continue;
+                    }
+                }
             }
+
+            context->vTableIndices.insert(functionPrototype, vTableIndex);
         }
 
-        if (element.udt.numOfVTables == 1 && i == 5)
+        if (addToPrototypesList)
         {
-            newElement.children.append(virtualFunctions.values());
-            virtualFunctions.clear();
+            context->virtualFunctionPrototypes.insert(functionPrototype, value);
         }
     }
 
-    if (element.udt.numOfVTables > 1)
+    if (element->elementType == ElementType::udtType)
     {
-        int k = lastVariableIndex + 1;
+        element->udt.Edit()->vTableNames.insert(context->vTableNames);
+        UpdateVTables(element, &element->udt.Edit()->vTableNames, addToPrototypesList);
+
+        QList<Element> virtualFunctionChildren;
 
-        for (int i = 0; i < element.udt.numOfVTables; i++)
+        for (int i = 0; i < element->udt->numOfVTables; i++)
         {
-            for (int j = 0; j < count; j++)
+            QMap<int, Element> virtualFunctions;
+
+            for (int j = 0; j < virtualFunctionChildrenCount; j++)
             {
-                if (element.children.at(j).elementType == ElementType::functionType &&
-                    element.children.at(j).function.isVirtual &&
-                    element.children.at(j).function.indexOfVTable == i)
+                static const FunctionOptions functionOptions;
+                QString prototype = FunctionTypeToString(const_cast<Element*>(&element->virtualFunctionChildren.at(j)),
+                    &functionOptions);
+
+                element->virtualFunctionChildren[j].function.Edit()->prototype = prototype;
+
+                if (element->virtualFunctionChildren.at(j).function->indexOfVTable == i)
                 {
-                    int offset = element.children.at(j).function.virtualBaseOffset;
+                    int offset = element->virtualFunctionChildren.at(j).function->virtualBaseOffset;
 
-                    virtualFunctions.insert(offset, element.children.at(j));
+                    virtualFunctions.insert(offset, element->virtualFunctionChildren.at(j));
                 }
             }
 
-            if (lastVariableIndex == -1)
-            {
-                newElement.children.append(virtualFunctions.values());
-            }
-            else
+            virtualFunctionChildren.append(virtualFunctions.values());
+        }
+
+        if (virtualFunctionChildren.count() > 0)
+        {
+            element->virtualFunctionChildren = virtualFunctionChildren;
+        }
+        else
+        {
+            static const FunctionOptions functionOptions;
+            QString prototype;
+
+            for (int i = 0; i < virtualFunctionChildrenCount; i++)
             {
-                QMultiMap<int, Element>::const_iterator it;
+                prototype = FunctionTypeToString(const_cast<Element*>(&element->virtualFunctionChildren.at(i)), &functionOptions);
 
-                for (it = virtualFunctions.begin(); it != virtualFunctions.end(); it++)
-                {
-                    newElement.children.insert(k++, it.value());
-                }
+                element->virtualFunctionChildren[i].function.Edit()->prototype = prototype;
             }
+        }
+    }
+}
+
+QHash<QString, int> PDB::GetVTable(QString vTableName)
+{
+    ResolutionContext* context = GetResolutionContext();
+    QHash<QString, int> vTable;
+    QHash<QString, QHash<QString, int>>::const_iterator it;
+
+    for (it = context->vTables.begin(); it != context->vTables.end(); it++)
+    {
+        if (it.key() == vTableName)
+        {
+            vTable = it.value();
 
-            virtualFunctions.clear();
+            break;
         }
     }
 
-    return newElement;
+    return vTable;
 }
 
-Element PDB::OrderUDTChildrenByAccessSpecifiers(Element element)
+void PDB::UpdateVTable(Element* element, int indexOfVTable, QString vTableName, QMap<int, QString>* vTableNames,
+    QHash<QString, int>* vTableIndices, bool addToPrototypesList,
+    QHash<QString, QString>* virtualFunctionPrototypes)
 {
-    Element newElement = element;
-    newElement.children.clear();
+    ResolutionContext* context = GetResolutionContext();
 
-    int count = element.children.count();
+    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
 
-    /*
-    * Order:
-    * 1. Base Classes
-    * 2. Enums
-    * 3. Inner Types
-    * 4. Typedefs
-    * 5. Variables
-    * 6. Static Variables
-    * 7. Virtual Functions
-    * 8. Non Virtual Functions
-    */
+    for (int i = 0; i < virtualFunctionChildrenCount; i++)
+    {
+        int vTableIndex = element->virtualFunctionChildren.at(i).function->virtualBaseOffset >> 2;
+        static const FunctionOptions functionOptions = { false, false, false, false };
+        QString functionPrototype = FunctionTypeToString(const_cast<Element*>(&element->virtualFunctionChildren.at(i)),
+            &functionOptions);
 
-    /*
-    * Order members by access specfiers in this order: public, protected, private
-    * Public should be first because inner udts and enums are public
-    */
+        QString functionName;
+        QString value;
 
-    for (int i = 3; i >= 1; i--)
-    {
-        for (int j = 0; j < 8; j++)
+        if (addToPrototypesList)
         {
-            for (int k = 0; k < count; k++)
+            functionName = element->virtualFunctionChildren.at(i).function->name;
+
+            if (element->elementType == ElementType::udtType)
             {
-                switch (j)
-                {
-                case 0:
+                value = QString("%1::%2").arg(element->udt->name).arg(functionName);
+            }
+            else
+            {
+                value = QString("%1::%2").arg(element->baseClass->name).arg(functionName);
+            }
+        }
+
+        if (element->virtualFunctionChildren.at(i).function->isDestructor)
+        {
+            QHash<QString, int>::const_iterator it2;
+
+            for (it2 = vTableIndices->begin(); it2 != vTableIndices->end(); it2++)
+            {
+                if (it2.key().at(0) == '~')
                 {
-                    if (element.children.at(k).elementType == ElementType::baseClassType &&
-                        element.children.at(k).baseClass.access == (CV_access_e)i)
-                    {
-                        JoinLists(&element.children[k]);
+                    element->virtualFunctionChildren[i].function.Edit()->isOverridden = true;
+                    element->virtualFunctionChildren[i].function.Edit()->virtualBaseOffset = it2.value() << 2;
 
-                        Element newElement2 = OrderUDTElementChildren(element.children.at(k));
-                        newElement.children.append(newElement2);
-                    }
+                    vTableIndex = it2.value();
+                    vTableIndices->remove(it2.key());
 
                     break;
                 }
-                case 1:
+            }
+
+            vTableIndices->insert(functionPrototype, vTableIndex);
+
+            if (addToPrototypesList)
+            {
+                QHash<QString, QString>::const_iterator it3;
+
+                for (it3 = virtualFunctionPrototypes->begin(); it3 != virtualFunctionPrototypes->end(); it3++)
                 {
-                    if (element.children.at(k).elementType == ElementType::enumType &&
-                        element.children.at(k).enum1.access == (CV_access_e)i)
+                    if (it3.key().at(0) == '~')
                     {
-                        JoinLists(&element.children[k]);
+                        virtualFunctionPrototypes->remove(it3.key());
 
-                        newElement.children.append(element.children.at(k));
+                        break;
                     }
+                }
 
-                    break;
+                virtualFunctionPrototypes->insert(functionPrototype, value);
+            }
+        }
+        else
+        {
+            QHash<QString, int>::const_iterator it = vTableIndices->find(functionPrototype);
+
+            if (it != vTableIndices->end())
+            {
+                element->virtualFunctionChildren[i].function.Edit()->virtualBaseOffset = it.value() << 2;
+
+                if (!element->virtualFunctionChildren[i].function->isPure)
+                {
+                    element->virtualFunctionChildren[i].function.Edit()->isOverridden = true;
                 }
-                case 2:
+
+                /*
+                * Update indexOfVTable also in case of main table because value of indexOfVTable of funtion can change if function
+                * is declared in multiple vtables
+                */
+
+                QMap<int, QString>::const_iterator it2;
+
+                for (it2 = vTableNames->begin(); it2 != vTableNames->end(); it2++)
                 {
-                    if (element.children.at(k).elementType == ElementType::udtType &&
-                        element.children.at(k).udt.access == (CV_access_e)i)
+                    if (vTableName == it2.value())
                     {
-                        JoinLists(&element.children[k]);
+                        element->virtualFunctionChildren[i].function.Edit()->indexOfVTable = it2.key();
+                        element->virtualFunctionChildren[i].function.Edit()->vTableName = it2.value();
 
-                        Element newElement2 = OrderUDTChildrenByAccessSpecifiers(element.children.at(k));
-                        newElement.children.append(newElement2);
+                        break;
                     }
+                }
 
-                    break;
+                if (addToPrototypesList)
+                {
+                    virtualFunctionPrototypes->insert(functionPrototype, value);
                 }
-                case 3:
+            }
+            else
+            {
+                if (indexOfVTable == 0 && element->virtualFunctionChildren.at(i).function->indexOfVTable == 0)
                 {
-                    if (element.children.at(k).elementType == ElementType::typedefType &&
-                        element.children.at(k).udt.access == (CV_access_e)i)
+                    QString name;
+
+                    if (element->elementType == ElementType::udtType)
                     {
-                        newElement.children.append(element.children.at(k));
+                        name = element->udt->name;
+                    }
+                    else
+                    {
+                        name = element->baseClass->name;
                     }
 
-                    break;
-                }
-                case 4:
-                {
-                    if (element.children.at(k).elementType == ElementType::dataType &&
-                        element.children.at(k).data.dataKind != DataIsStaticMember &&
-                        element.children.at(k).data.access == (CV_access_e)i)
+                    //Check for covariant return type
+                    if (element->virtualFunctionChildren.at(i).function->returnType1.typeName == name)
                     {
-                        if (element.children.at(k).data.hasChildren)
-                        {
-                            JoinLists(&element.children[k]);
+                        Element element2 = element->virtualFunctionChildren.at(i);
+                        Data data = element->virtualFunctionChildren.at(i).function->returnType1;
+                        int baseClassNamesCount = element->baseClassNames.count();
+                        static const DataOptions dataOptions = { false, true };
+                        QString returnType, functionPrototype2;
+                        bool found = false;
 
-                            if (element.children.at(k).data.isTypeNameOfEnum)
-                            {
-                                newElement.children.append(element.children.at(k));
-                            }
-                            else
-                            {
-                                element.children[k].elementType = ElementType::udtType;
+                        for (int j = 0; j < baseClassNamesCount; j++)
+                        {
+							bool keepScopeResolutionOperator = context->keepScopeResolutionOperator;
 
-                                Element newElement2 = OrderUDTChildrenByAccessSpecifiers(element.children.at(k));
+							context->keepScopeResolutionOperator = true;
+                            data.typeName = element->baseClassNames.at(j);
 
-                                newElement2.elementType = ElementType::dataType;
-                                newElement.children.append(newElement2);
-                            }
-                        }
-                        else
-                        {
-                            newElement.children.append(element.children.at(k));
-                        }
-                    }
+                            returnType = DataTypeToString(&data, &dataOptions);
 
-                    break;
-                }
-                case 5:
-                {
-                    if (element.children.at(k).elementType == ElementType::dataType &&
-                        element.children.at(k).data.dataKind == DataIsStaticMember &&
-                        element.children.at(k).data.access == (CV_access_e)i)
-                    {
-                        if (element.children.at(k).data.hasChildren)
-                        {
-                            JoinLists(&element.children[k]);
+                            context->keepScopeResolutionOperator = keepScopeResolutionOperator;
+                            element2.function.Edit()->originalReturnType = returnType;
 
-                            if (element.children.at(k).data.isTypeNameOfEnum)
-                            {
-                                newElement.children.append(element.children.at(k));
-                            }
-                            else
+                            functionPrototype2 = FunctionTypeToString(const_cast<Element*>(&element2), &functionOptions);
+
+                            it = vTableIndices->find(functionPrototype2);
+
+                            if (it != vTableIndices->end())
                             {
-                                element.children[k].elementType = ElementType::udtType;
+                                if (!element->virtualFunctionChildren[i].function->isPure)
+                                {
+                                    element->virtualFunctionChildren[i].function.Edit()->isOverridden = true;
+                                }
 
-                                Element newElement2 = OrderUDTChildrenByAccessSpecifiers(element.children.at(k));
+                                element->virtualFunctionChildren[i].function.Edit()->virtualBaseOffset = it.value() << 2;
 
-                                newElement2.elementType = ElementType::dataType;
-                                newElement.children.append(newElement2);
+                                vTableIndex = it.value();
+                                vTableIndices->remove(it.key());
+
+                                vTableIndices->insert(functionPrototype, vTableIndex);
+
+                                if (addToPrototypesList)
+                                {
+                                    QHash<QString, QString>::const_iterator it2;
+
+                                    for (it2 = virtualFunctionPrototypes->begin(); it2 != virtualFunctionPrototypes->end(); it2++)
+                                    {
+                                        if (it2.key() == functionPrototype2)
+                                        {
+                                            virtualFunctionPrototypes->remove(it2.key());
+
+                                            break;
+                                        }
+                                    }
+
+                                    virtualFunctionPrototypes->insert(functionPrototype, value);
+                                }
+
+                                found = true;
+
+                                break;
                             }
                         }
-                        else
+
+                        if (found)
                         {
-                            newElement.children.append(element.children.at(k));
+                            continue;
                         }
                     }
 
-                    break;
-                }
-                case 6:
-                {
-                    if (element.children.at(k).elementType == ElementType::functionType &&
-                        element.children.at(k).function.access == (CV_access_e)i)
+                    vTableIndices->insert(functionPrototype, vTableIndex);
+
+                    QMap<int, QString>::const_iterator it2;
+
+                    for (it2 = vTableNames->begin(); it2 != vTableNames->end(); it2++)
                     {
-                        if (element.children.at(k).function.isVirtual)
+                        if (vTableName == it2.value())
                         {
-                            newElement.children.append(element.children.at(k));
+                            element->virtualFunctionChildren[i].function.Edit()->indexOfVTable = it2.key();
+                            element->virtualFunctionChildren[i].function.Edit()->vTableName = it2.value();
+
+                            break;
                         }
                     }
 
-                    break;
-                }
-                case 7:
-                {
-                    if (element.children.at(k).elementType == ElementType::functionType &&
-                        element.children.at(k).function.access == (CV_access_e)i)
+                    if (addToPrototypesList)
                     {
-                        if (!element.children.at(k).function.isVirtual)
-                        {
-                            newElement.children.append(element.children.at(k));
-                        }
+                        virtualFunctionPrototypes->insert(functionPrototype, value);
                     }
-
-                    break;
-                }
                 }
             }
         }
     }
 
-    return newElement;
+    context->vTables[vTableName] = *vTableIndices;
+    context->virtualFunctionPrototypes2[vTableName] = *virtualFunctionPrototypes;
 }
 
-bool PDB::GetSymbolByID(DWORD id, IDiaSymbol** symbol)
+void PDB::UpdateVTables(Element* element, QMap<int, QString>* vTableNames, bool addToPrototypesList,
+    QHash<QString, QString>* virtualFunctionPrototypes)
 {
-    if (diaSession->symbolById(id, symbol) == S_OK)
-    {
-        return true;
-    }
+    ResolutionContext* context = GetResolutionContext();
 
-    return false;
-}
+    /*
+    * If vTables are looped using QHash then they wouldn't be always visited in same order so if multiple base classes
+    * with exactly same virtual functions are inherited it can happen that sometimes function will be declared as part of
+    * third vTable for example and sometimes as part of first vTable. Because of that it's better to iterate QMap instead
+    * in ascending or descending order
+    */
 
-bool PDB::GetSymbolByTypeName(enum SymTagEnum symTag, QString typeName, IDiaSymbol** symbol)
-{
-    IDiaEnumSymbols* enumSymbols;
+    auto it = vTableNames->end(), end = vTableNames->begin();
 
-    if (global->findChildren(symTag, typeName.toStdWString().c_str(), nsNone, &enumSymbols) == S_OK)
+    while (it != end)
     {
-        if (enumSymbols->Item(0, symbol) != S_OK)
-        {
-            return false;
-        }
-
-        enumSymbols->Release();
-
-        return true;
-    }
-
-    return false;
-}
+        --it;
 
-quint32 PDB::GetChildrenSize(const Element* element)
-{
-    quint32 size = 0;
-    int count = element->baseClassChildren.count() + element->dataChildren.count();
-    int bitSum = 0;
-    QList<Element> children;
+        int indexOfVTable = it.key();
+        QString vTableName = it.value();
 
-    children.append(element->baseClassChildren);
-    children.append(element->dataChildren);
+        QHash<QString, QHash<QString, QString>>::const_iterator it2;
+        QHash<QString, QString> virtualFunctionPrototypes;
 
-    for (int i = 0; i < count; i++)
-    {
-        if (children.at(i).elementType == ElementType::baseClassType)
-        {
-            size += children.at(i).baseClass.length;
-        }
-        else if (children.at(i).elementType == ElementType::dataType)
+        for (it2 = context->virtualFunctionPrototypes2.begin(); it2 != context->virtualFunctionPrototypes2.end(); it2++)
         {
-            if (children.at(i).numberOfBits > 0)
+            if (it.value() == it2.key())
             {
-                unsigned long numberOfBits = children.at(i).size << 3;
-                unsigned long bitsSize = 0;
-                int countOfNewVariables = 1;
-
-                while (i < count &&
-                    children.at(i).elementType == ElementType::dataType &&
-                    children.at(i).numberOfBits != 0)
-                {
-                    bitsSize += children.at(i).numberOfBits;
-
-                    if (i < count - 1 &&
-                        children.at(i + 1).elementType == ElementType::dataType &&
-                        children.at(i + 1).numberOfBits + bitsSize > numberOfBits)
-                    {
-                        countOfNewVariables++;
-                        bitsSize = 0;
-                    }
-
-                    i++;
-                }
+                virtualFunctionPrototypes = it2.value();
 
-                i--; //i++ in while loop and i++ in main for loop will skip one member
-                size += countOfNewVariables * children.at(i).size;
-            }
-            else
-            {
-                size += children.at(i).size;
+                break;
             }
         }
-    }
 
-    return size;
+        QHash<QString, int> vTableIndices = context->vTables.value(it.value());
+
+        UpdateVTable(element, indexOfVTable, vTableName, vTableNames, &vTableIndices, addToPrototypesList,
+            &virtualFunctionPrototypes);
+    }
 }
 
-bool PDB::CheckIfChildrenSizesAreCorrect(const Element* element, QString& message)
+QHash<QString, QString> PDB::getFunctionPrototypes(QString vTableName)
 {
-    int dataChildrenCount = element->dataChildren.count();
+    ResolutionContext* context = GetResolutionContext();
+    QHash<QString, QString> virtualFunctionPrototypes;
+    QHash<QString, QHash<QString, QString>>::const_iterator it;
 
-    for (int i = 0; i < dataChildrenCount; i++)
+    for (it = context->virtualFunctionPrototypes2.begin(); it != context->virtualFunctionPrototypes2.end(); it++)
     {
-        if (element->dataChildren.at(i).size == 0)
+        if (it.key() == vTableName)
         {
-            message = QString("<font size = 5>Output is not correct because size of %1 is 0 and that causes padding to be created!!!</font>")
-                .arg(element->dataChildren.at(i).data.name);
+            virtualFunctionPrototypes = it.value();
 
-            return false;
+            break;
         }
     }
 
-    return true;
+    return virtualFunctionPrototypes;
 }
 
-void PDB::FixOffsets(Element* element)
+Element PDB::OrderUDTElementChildren(Element element)
 {
-    Element newElement = *element;
-
-    newElement.dataChildren.clear();
-
-    int count = element->dataChildren.count();
+    ResolutionContext* context = GetResolutionContext();
+    Element newElement = element;
+    newElement.children.clear();
 
-    AppendElement(&newElement, &element->dataChildren, 0, count);
+    int count = element.children.count();
+    int lastVariableIndex = -1;
 
-    *element = newElement;
-}
+    /*
+    * Order:
+    * 1. Base Classes
+    * 2. Enums
+    * 3. Inner Types
+    * 4. Typedefs
+    * 5. Variables
+    * 6. Static Variables
+    * 7. Virtual Functions
+    * 8. Non Virtual Functions
+    */
 
-void PDB::AppendElement(Element* element, QList<Element>* children, int startPosition, int endPosition)
-{
-    for (int i = startPosition; i < endPosition; i++)
+    for (int i = 0; i < 8; i++)
     {
-        if (children->at(i).size)
+        for (int j = 0; j < count; j++)
         {
-            quint32 offset = children->at(i).offset;
-            quint32 bitOffset = children->at(i).bitOffset;
-            quint32 size = children->at(i).size;
-            quint32 size2 = size;
-            quint32 count = 1;
-            quint32 position = i;
-            quint32 startOffset = offset;
-
-            QList<quint32> sizes;
-            QList<quint32> counts;
-            QList<quint32> positions;
-
-            for (int j = i + 1; j < endPosition; j++)
+            switch (i)
             {
-                const Element& element2 = children->at(j);
-                quint32 elementRange = 0;
-
-                if (!ShouldIncludeElement(element2))
+            case 0:
+            {
+                if (element.children.at(j).elementType == ElementType::baseClassType)
                 {
-                    elementRange = element2.offset + element2.size;
-                }
-
-                if ((element2.offset == offset) &&
-                    (element2.bitOffset == bitOffset) &&
-                    (element2.size) && !ShouldIncludeElement(element2))
-                {
-                    sizes.append(size2);
-                    counts.append(count);
-                    positions.append(position);
-
-                    size2 = 0;
-                    count = 0;
-                    position = j;
-                    startOffset = element2.offset;
-                }
-
-                const quint32 prevRange = startOffset + size2;
-
-                if (elementRange <= prevRange)
-                {
-                    size2 += 0;
-                }
-                else
-                {
-                    size2 += elementRange - prevRange; //element2.size;
+                    Element newElement2 = OrderUDTElementChildren(element.children.at(j));
+                    newElement.children.append(newElement2);
                 }
 
-                count++;
+                break;
             }
-
-            int count2 = sizes.count();
-
-            if (count2)
+            case 1:
             {
-                // The last position
-                quint32 maxSize = 0;
-
-                for (int j = 0; j < count2; j++)
+                if (element.children.at(j).elementType == ElementType::enumType)
                 {
-                    maxSize = qMax(maxSize, sizes.at(j));
+                    newElement.children.append(element.children.at(j));
                 }
 
-                size2 = 0;
-                count = 0;
-                quint32 totalrange = offset;
-
-                for (int j = position; j < endPosition; j++)
+                break;
+            }
+            case 2:
+            {
+                if (element.children.at(j).elementType == ElementType::udtType)
                 {
-                    const Element& element2 = children->at(j);
-                    quint32 elementRange = 0;
-
-                    if (!ShouldIncludeElement(element2))
-                    {
-                        elementRange = element2.offset + element2.size;
-                    }
-
-                    if ((size2 >= maxSize) && (elementRange > totalrange))
+                    if (element.children.at(j).udt->hasBaseClass)
                     {
-                        break;
-                    }
+                        QHash<QString, QHash<QString, int>> vTables2;
 
-                    if (ShouldIncludeElement(element2))
-                    {
-                        break;
-                    }
+                        if (context->vTables.count() > 0)
+                        {
+                            vTables2 = context->vTables;
 
-                    if (element2.elementType == ElementType::dataType &&
-                        element2.data.isPadding)
-                    {
-                        break;
-                    }
+                            context->vTables.clear();
+                        }
 
-                    /*if (element2.data.type.isEndAlign)
-                    {
-                        break;
-                    }*/
+                        GetVTables(&element.children[j]);
 
-                    if (elementRange <= totalrange)
-                    {
-                        size2 += 0;
-                    }
-                    else
-                    {
-                        size2 += elementRange - totalrange; // element2.size;
-                        totalrange = elementRange;
+                        if (context->vTables.count() > 0)
+                        {
+                            context->vTables = vTables2;
+                        }
                     }
 
-                    count++;
+                    Element newElement2 = OrderUDTElementChildren(element.children.at(j));
+                    newElement.children.append(newElement2);
                 }
 
-                sizes.append(size2);
-                counts.append(count);
-                positions.append(position);
-
-                count2++;
-
-                bool newUnion = true;
-
-                if ((element->udt.udtKind == UdtUnion) && (element->size == size2))
+                break;
+            }
+            case 3:
+            {
+                if (element.children.at(j).elementType == ElementType::typedefType)
                 {
-                    newUnion = false;
+                    newElement.children.append(element.children.at(j));
                 }
 
-                Element unionElem = {};
-                Element* unionElement;
-
-                if (newUnion)
+                break;
+            }
+            case 4:
+            {
+                if (element.children.at(j).elementType == ElementType::dataType &&
+                    element.children.at(j).data->dataKind != DataIsStaticMember)
                 {
-                    unionElement = &unionElem;
-                    unionElement->elementType = ElementType::dataType;
-                    unionElement->size = qMax(size2, maxSize);
-                    unionElement->udt.type = "union";
-                    unionElement->udt.isAnonymousUnion = true;
-                    unionElement->udt.udtKind = UdtUnion;
-                    unionElement->data.hasChildren = true;
-
-                    if (element->elementType == ElementType::udtType)
+                    if (element.children.at(j).data->hasChildren)
                     {
-                        if (element->udt.udtKind == UdtClass)
+                        if (element.children.at(j).data->isTypeNameOfEnum)
                         {
-                            unionElement->data.access = CV_private;
+                            newElement.children.append(element.children.at(j));
                         }
                         else
                         {
-                            unionElement->data.access = CV_public;
+                            element.children[j].elementType = ElementType::udtType;
+
+                            Element newElement2 = OrderUDTElementChildren(element.children.at(j));
+
+                            newElement2.elementType = ElementType::dataType;
+                            newElement.children.append(newElement2);
                         }
                     }
                     else
                     {
-                        if (element->baseClass.udtKind == UdtClass)
-                        {
-                            unionElement->data.access = CV_private;
-                        }
-                        else
+                        newElement.children.append(element.children.at(j));
+
+                        if (element.udt->numOfVTables > 1)
                         {
-                            unionElement->data.access = CV_public;
+                            lastVariableIndex = newElement.children.count() - 1;
                         }
                     }
                 }
-                else
-                {
-                    unionElement = element;
-                }
 
-                for (int j = 0; j < count2; j++)
+                break;
+            }
+            case 5:
+            {
+                if (element.children.at(j).elementType == ElementType::dataType &&
+                    element.children.at(j).data->dataKind == DataIsStaticMember)
                 {
-                    if (counts.at(j) > 1)
+                    if (element.children.at(j).data->hasChildren)
                     {
-                        Element structElem = {};
-                        Element* structElement = &structElem;
-                        structElement->elementType = ElementType::dataType;
-                        structElement->size = sizes.at(j);
-                        structElement->udt.type = "struct";
-                        structElement->udt.isAnonymousStruct = true;
-                        structElement->data.hasChildren = true;
-
-                        if (element->elementType == ElementType::udtType)
+                        if (element.children.at(j).data->isTypeNameOfEnum)
                         {
-                            if (element->udt.udtKind == UdtClass)
-                            {
-                                structElement->data.access = CV_private;
-                            }
-                            else
-                            {
-                                structElement->data.access = CV_public;
-                            }
+                            newElement.children.append(element.children.at(j));
                         }
                         else
                         {
-                            if (element->baseClass.udtKind == UdtClass)
-                            {
-                                structElement->data.access = CV_private;
-                            }
-                            else
-                            {
-                                structElement->data.access = CV_public;
-                            }
-                        }
+                            element.children[j].elementType = ElementType::udtType;
 
-                        AppendElement(structElement, children, positions.at(j), positions.at(j) + counts.at(j));
+                            Element newElement2 = OrderUDTElementChildren(element.children.at(j));
 
-                        unionElement->dataChildren.append(*structElement);
+                            newElement2.elementType = ElementType::dataType;
+                            newElement.children.append(newElement2);
+                        }
                     }
                     else
                     {
-                        AppendElement(unionElement, children, positions.at(j), positions.at(j) + counts.at(j));
-                    }
+                        newElement.children.append(element.children.at(j));
 
-                    i += counts.at(j);
+                        if (element.udt->numOfVTables > 1)
+                        {
+                            lastVariableIndex = newElement.children.count() - 1;
+                        }
+                    }
                 }
 
-                i--;
-
-                if (newUnion)
+                break;
+            }
+            case 6:
+            {
+                if (element.udt->numOfVTables == 1 &&
+                    element.children.at(j).elementType == ElementType::functionType &&
+                    element.children.at(j).function->isVirtual)
                 {
-                    element->dataChildren.append(*unionElement);
+                    int offset = element.children.at(j).function->virtualBaseOffset;
+
+                    context->virtualFunctions.insert(offset, element.children.at(j));
                 }
+
+                break;
             }
-            else
+            case 7:
             {
-                element->dataChildren.append(children->at(i));
+                if (element.children.at(j).elementType == ElementType::functionType &&
+                    !element.children.at(j).function->isVirtual)
+                {
+                    newElement.children.append(element.children.at(j));
+                }
+
+                break;
+            }
             }
         }
-        else
+
+        if (element.udt->numOfVTables == 1 && i == 5)
         {
-            element->dataChildren.append(children->at(i));
+            newElement.children.append(context->virtualFunctions.values());
+            context->virtualFunctions.clear();
         }
     }
-}
-
-bool PDB::ShouldIncludeElement(Element element)
-{
-    return element.elementType == ElementType::functionType ||
-        element.elementType == ElementType::baseClassType ||
-        element.elementType == ElementType::udtType ||
-        element.elementType == ElementType::enumType ||
-        (element.elementType == ElementType::dataType &&
-            (element.data.dataKind == DataIsStaticMember));
-}
 
-void PDB::CheckIfUnionsAreMissing(Element* element)
-{
-    if (!element->udt.isAnonymousUnion &&
-        !element->udt.isAnonymousStruct &&
-        element->size > 1 &&
-        GetChildrenSize(const_cast<Element*>(element)) > element->size)
+    if (element.udt->numOfVTables > 1)
     {
-        FixOffsets(element);
-    }
+        int k = lastVariableIndex + 1;
 
-    int udtChildrenCount = element->udtChildren.count();
-    int dataChildrenCount = element->dataChildren.count();
-    int staticDataChildrenCount = element->staticDataChildren.count();
+        for (int i = 0; i < element.udt->numOfVTables; i++)
+        {
+            for (int j = 0; j < count; j++)
+            {
+                if (element.children.at(j).elementType == ElementType::functionType &&
+                    element.children.at(j).function->isVirtual &&
+                    element.children.at(j).function->indexOfVTable == i)
+                {
+                    int offset = element.children.at(j).function->virtualBaseOffset;
 
-    for (int i = 0; i < udtChildrenCount; i++)
-    {
-        CheckIfUnionsAreMissing(&element->udtChildren[i]);
-    }
+                    context->virtualFunctions.insert(offset, element.children.at(j));
+                }
+            }
 
-    for (int i = 0; i < dataChildrenCount; i++)
-    {
-        if (element->dataChildren.at(i).data.hasChildren && !element->dataChildren.at(i).data.isTypeNameOfEnum)
-        {
-            CheckIfUnionsAreMissing(&element->dataChildren[i]);
-        }
-    }
+            if (lastVariableIndex == -1)
+            {
+                newElement.children.append(context->virtualFunctions.values());
+            }
+            else
+            {
+                QMultiMap<int, Element>::const_iterator it;
 
-    for (int i = 0; i < staticDataChildrenCount; i++)
-    {
-        if (element->staticDataChildren.at(i).data.hasChildren && !element->dataChildren.at(i).data.isTypeNameOfEnum)
-        {
-            CheckIfUnionsAreMissing(&element->staticDataChildren[i]);
+                for (it = context->virtualFunctions.begin(); it != context->virtualFunctions.end(); it++)
+                {
+                    newElement.children.insert(k++, it.value());
+                }
+            }
+
+            context->virtualFunctions.clear();
         }
     }
+
+    return newElement;
 }
 
-QString PDB::convertAccessSpecifierToString(CV_access_e accessSpecifier)
+Element PDB::OrderUDTChildrenByAccessSpecifiers(Element element)
 {
-    QString result;
+    Element newElement = element;
+    newElement.children.clear();
 
-    switch (accessSpecifier)
-    {
-    case CV_private:
-        result = "private"; 
+    int count = element.children.count();
 
-        break;
-    case CV_protected:
-        result = "protected"; 
+    /*
+    * Order:
+    * 1. Base Classes
+    * 2. Enums
+    * 3. Inner Types
+    * 4. Typedefs
+    * 5. Variables
+    * 6. Static Variables
+    * 7. Virtual Functions
+    * 8. Non Virtual Functions
+    */
 
-        break;
-    case CV_public:
-        result = "public"; 
+    /*
+    * Order members by access specfiers in this order: public, protected, private
+    * Public should be first because inner udts and enums are public
+    */
 
-        break;
-    }
+    for (int i = 3; i >= 1; i--)
+    {
+        for (int j = 0; j < 8; j++)
+        {
+            for (int k = 0; k < count; k++)
+            {
+                switch (j)
+                {
+                case 0:
+                {
+                    if (element.children.at(k).elementType == ElementType::baseClassType &&
+                        element.children.at(k).baseClass->access == (CV_access_e)i)
+                    {
+                        JoinLists(&element.children[k]);
 
-    return result;
-}
+                        Element newElement2 = OrderUDTElementChildren(element.children.at(k));
+                        newElement.children.append(newElement2);
+                    }
 
-QString PDB::convertCallingConventionToString(CV_call_e callingConvention)
-{
-    QString result;
+                    break;
+                }
+                case 1:
+                {
+                    if (element.children.at(k).elementType == ElementType::enumType &&
+                        element.children.at(k).enum1->access == (CV_access_e)i)
+                    {
+                        JoinLists(&element.children[k]);
 
-    switch (callingConvention)
-    {
-    case CV_CALL_THISCALL:
-		result = "__thiscall";
+                        newElement.children.append(element.children.at(k));
+                    }
 
-		break;
-    case CV_CALL_NEAR_FAST:
-    case CV_CALL_FAR_FAST:
-        result = "__fastcall";
+                    break;
+                }
+                case 2:
+                {
+                    if (element.children.at(k).elementType == ElementType::udtType &&
+                        element.children.at(k).udt->access == (CV_access_e)i)
+                    {
+                        JoinLists(&element.children[k]);
 
-        break;
-    case CV_CALL_NEAR_STD:
-    case CV_CALL_FAR_STD:
-        result = "__stdcall";
+                        Element newElement2 = OrderUDTChildrenByAccessSpecifiers(element.children.at(k));
+                        newElement.children.append(newElement2);
+                    }
 
-        break;
-    case CV_CALL_NEAR_C:
-    case CV_CALL_FAR_C:
-        result = "__cdecl";
+                    break;
+                }
+                case 3:
+                {
+                    if (element.children.at(k).elementType == ElementType::typedefType &&
+                        element.children.at(k).udt->access == (CV_access_e)i)
+                    {
+                        newElement.children.append(element.children.at(k));
+                    }
 
-        break;
-    case CV_CALL_NEAR_VECTOR:
-        result = "__vectorcall";
+                    break;
+                }
+                case 4:
+                {
+                    if (element.children.at(k).elementType == ElementType::dataType &&
+                        element.children.at(k).data->dataKind != DataIsStaticMember &&
+                        element.children.at(k).data->access == (CV_access_e)i)
+                    {
+                        if (element.children.at(k).data->hasChildren)
+                        {
+                            JoinLists(&element.children[k]);
 
-        break;
-    }
+                            if (element.children.at(k).data->isTypeNameOfEnum)
+                            {
+                                newElement.children.append(element.children.at(k));
+                            }
+                            else
+                            {
+                                element.children[k].elementType = ElementType::udtType;
 
-    return result;
-}
+                                Element newElement2 = OrderUDTChildrenByAccessSpecifiers(element.children.at(k));
 
-QString PDB::convertDataKindToString(DataKind dataKind)
-{
-    QString result;
+                                newElement2.elementType = ElementType::dataType;
+                                newElement.children.append(newElement2);
+                            }
+                        }
+                        else
+                        {
+                            newElement.children.append(element.children.at(k));
+                        }
+                    }
 
-    switch (dataKind)
-    {
-    case DataIsUnknown:
-        result = "Unknown";
+                    break;
+                }
+                case 5:
+                {
+                    if (element.children.at(k).elementType == ElementType::dataType &&
+                        element.children.at(k).data->dataKind == DataIsStaticMember &&
+                        element.children.at(k).data->access == (CV_access_e)i)
+                    {
+                        if (element.children.at(k).data->hasChildren)
+                        {
+                            JoinLists(&element.children[k]);
 
-        break;
-    case DataIsLocal:
-		result = "Local";
+                            if (element.children.at(k).data->isTypeNameOfEnum)
+                            {
+                                newElement.children.append(element.children.at(k));
+                            }
+                            else
+                            {
+                                element.children[k].elementType = ElementType::udtType;
 
-		break;
-    case DataIsStaticLocal:
-		result = "Static local";
+                                Element newElement2 = OrderUDTChildrenByAccessSpecifiers(element.children.at(k));
 
-		break;
-    case DataIsParam:
-		result = "Parameter";
+                                newElement2.elementType = ElementType::dataType;
+                                newElement.children.append(newElement2);
+                            }
+                        }
+                        else
+                        {
+                            newElement.children.append(element.children.at(k));
+                        }
+                    }
 
-		break;
-    case DataIsObjectPtr:
-		result = "Object pointer";
+                    break;
+                }
+                case 6:
+                {
+                    if (element.children.at(k).elementType == ElementType::functionType &&
+                        element.children.at(k).function->access == (CV_access_e)i)
+                    {
+                        if (element.children.at(k).function->isVirtual)
+                        {
+                            newElement.children.append(element.children.at(k));
+                        }
+                    }
 
-		break;
-    case DataIsFileStatic:
-		result = "File static";
+                    break;
+                }
+                case 7:
+                {
+                    if (element.children.at(k).elementType == ElementType::functionType &&
+                        element.children.at(k).function->access == (CV_access_e)i)
+                    {
+                        if (!element.children.at(k).function->isVirtual)
+                        {
+                            newElement.children.append(element.children.at(k));
+                        }
+                    }
 
-		break;
-    case DataIsGlobal:
-		result = "Global";
+                    break;
+                }
+                }
+            }
+        }
+    }
 
-		break;
-    case DataIsMember:
-		result = "Member";
+    return newElement;
+}
 
-		break;
-    case DataIsStaticMember:
-		result = "Static member";
+bool PDB::GetSymbolByID(DWORD id, IDiaSymbol** symbol)
+{
+    if (id & typeIndexFlag)
+    {
+        return GetSymbolByTypeIndex(id & ~typeIndexFlag, symbol);
+    }
 
-		break;
-    case DataIsConstant:
-		result = "Constant";
+    if (id & symbolLocatorFlag)
+    {
+        return GetSymbolByLocator(id & ~symbolLocatorFlag, symbol);
+    }
 
-		break;
+    if (diaSession->symbolById(id, symbol) == S_OK)
+    {
+        return true;
     }
 
-    return result;
+    return false;
 }
 
-QString PDB::convertLocationTypeToString(LocationType locationType)
+bool PDB::GetSymbolByTypeIndex(quint32 typeIndex, IDiaSymbol** symbol)
 {
-    QString type;
+    typeIndexIDsMutex.lock();
+    QHash<DWORD, DWORD>::const_iterator it = typeIndexIDs.find(typeIndex);
+    bool isResolved = it != typeIndexIDs.end();
+    DWORD id = isResolved ? it.value() : 0;
+    typeIndexIDsMutex.unlock();
 
-    switch (locationType)
+    if (isResolved)
     {
-    case LocIsNull:
-        type = "Null";
+        return diaSession->symbolById(id, symbol) == S_OK;
+    }
 
-        break;
-    case LocIsStatic:
-        type = "Static";
+    TPIUDTRecord udtRecord;
 
-        break;
-    case LocIsTLS:
-        type = "Thread local storage";
+    if (!tpiStream.GetUDTRecord(typeIndex, &udtRecord))
+    {
+        return false;
+    }
 
-        break;
-    case LocIsRegRel:
-        type = "Registry relative";
+    IDiaEnumSymbols* enumSymbols;
+    enum SymTagEnum symTag = udtRecord.kind == LF_ENUM ? SymTagEnum : SymTagUDT;
 
-        break;
-    case LocIsThisRel:
-        type = "This relative";
+    if (global->findChildren(symTag, udtRecord.name.toStdWString().c_str(), nsNone, &enumSymbols) != S_OK)
+    {
+        return false;
+    }
 
-        break;
-    case LocIsEnregistered:
-        type = "Enregistered";
+    //If there are multiple types with the same name then one with the same size as TPI record is used
+    IDiaSymbol* symbol2;
+    ULONG celt = 0;
 
-        break;
-    case LocIsBitField:
-        type = "Bit field";
+    *symbol = nullptr;
 
-        break;
-    case LocIsSlot:
-        type = "Microsoft Intermediate Language (MSIL) slot";
+    while (SUCCEEDED(enumSymbols->Next(1, &symbol2, &celt)) && (celt == 1))
+    {
+        ULONGLONG length = 0;
 
-        break;
-    case LocIsIlRel:
-        type = "MSIL relative";
+        symbol2->get_length(&length);
 
-        break;
-    case LocInMetaData:
-        type = "Metadata";
+        if (!*symbol)
+        {
+            *symbol = symbol2;
+        }
+        else if (udtRecord.kind != LF_ENUM && length == udtRecord.size)
+        {
+            (*symbol)->Release();
+            *symbol = symbol2;
 
-        break;
-    case LocIsConstant:
-        type = "Constant";
+            break;
+        }
+        else
+        {
+            symbol2->Release();
+        }
 
-        break;
+        if (udtRecord.kind == LF_ENUM || length == udtRecord.size)
+        {
+            break;
+        }
     }
 
-    return type;
-}
-
-QString PDB::convertVariantToString(VARIANT variant)
-{
-    QString result;
+    enumSymbols->Release();
 
-    switch (variant.vt)
+    if (!*symbol)
     {
-    case VT_UI1:
-    case VT_I1:
-        result = QString(" 0x%1").arg(variant.bVal);
-
-        break;
-    case VT_I2:
-    case VT_UI2:
-    case VT_BOOL:
-        result = QString(" 0x%1").arg(variant.iVal);
-
-        break;
-    case VT_I4:
-    case VT_UI4:
-    case VT_INT:
-    case VT_UINT:
-    case VT_ERROR:
-        result = QString(" 0x%1").arg(variant.lVal);
-
-        break;
-    case VT_R4:
-        result = QString(" %g").arg(variant.fltVal);
-
-        break;
-    case VT_R8:
-        result = QString(" %g").arg(variant.dblVal);
-
-        break;
-    case VT_BSTR:
-        result = QString(" \"%1\"").arg(variant.bstrVal);
+        return false;
+    }
 
-        break;
-    default:
-        result = QString(" ??");
+    (*symbol)->get_symIndexId(&id);
 
-        break;
-    }
+    typeIndexIDsMutex.lock();
+    typeIndexIDs.insert(typeIndex, id);
+    typeIndexIDsMutex.unlock();
 
-    return result;
+    return true;
 }
 
-QString PDB::convertLanguageToString(CV_CFL_LANG language)
+bool PDB::GetSymbolByLocator(int index, IDiaSymbol** symbol)
 {
-    QString result;
+    symbolLocatorsMutex.lock();
 
-    switch (language)
+    if (index < 0 || index >= symbolLocators.count())
     {
-    case CV_CFL_C:
-        result = "C";
+        symbolLocatorsMutex.unlock();
 
-        break;
-    case CV_CFL_CXX:
-        result = "C++";
+        return false;
+    }
 
-        break;
-    case CV_CFL_FORTRAN:
-        result = "Fortran";
+    SymbolLocator symbolLocator = symbolLocators.at(index);
 
-        break;
-    case CV_CFL_MASM:
-        result = "MASM";
+    symbolLocatorsMutex.unlock();
 
-        break;
-    case CV_CFL_PASCAL:
-        result = "Pascal";
+    if (symbolLocator.id)
+    {
+        return diaSession->symbolById(symbolLocator.id, symbol) == S_OK;
+    }
 
-        break;
-    case CV_CFL_BASIC:
-        result = "Basic";
+    *symbol = nullptr;
 
-        break;
-    case CV_CFL_COBOL:
-        result = "Cobol";
+    if (symbolLocator.relativeVirtualAddress &&
+        diaSession->findSymbolByRVA(symbolLocator.relativeVirtualAddress, static_cast<SymTagEnum>(symbolLocator.symTag), symbol) == S_OK)
+    {
+        //Name of public symbol is demangled so only data and functions are checked
+        BSTR bstring;
 
-        break;
-    case CV_CFL_LINK:
-        result = "Link";
+        if (symbolLocator.symTag != SymTagPublicSymbol && (*symbol)->get_name(&bstring) == S_OK)
+        {
+            if (QString::fromWCharArray(bstring) != NameArena::GetName(symbolLocator.nameID))
+            {
+                (*symbol)->Release();
+                *symbol = nullptr;
+            }
 
-        break;
-    case CV_CFL_CVTRES:
-        result = "CvtRes";
+            SysFreeString(bstring);
+        }
+    }
 
-        break;
-    case CV_CFL_CVTPGD:
-        result = "CvtPdg";
+    if (!*symbol && symbolLocator.symTag != SymTagPublicSymbol)
+    {
+        IDiaEnumSymbols* enumSymbols;
 
-        break;
-    case CV_CFL_CSHARP:
-        result = "C#";
+        if (global->findChildren(static_cast<SymTagEnum>(symbolLocator.symTag), NameArena::GetName(symbolLocator.nameID).toStdWString().c_str(),
+            nsNone, &enumSymbols) == S_OK)
+        {
+            //Forward references of types have the same name so first type which isn't empty is used like during import
+            IDiaSymbol* symbol2;
+            ULONG celt = 0;
 
-        break;
-    case CV_CFL_VB:
-        result = "Visual Basic";
+            while (SUCCEEDED(enumSymbols->Next(1, &symbol2, &celt)) && (celt == 1))
+            {
+                ULONGLONG length = 0;
 
-        break;
-    case CV_CFL_ILASM:
-        result = "ILASM";
+                if (symbolLocator.symTag != SymTagUDT && symbolLocator.symTag != SymTagEnum ||
+                    symbol2->get_length(&length) == S_OK && length > 0)
+                {
+                    if (*symbol)
+                    {
+                        (*symbol)->Release();
+                    }
 
-        break;
-    case CV_CFL_JAVA:
-        result = "Java";
+                    *symbol = symbol2;
 
-        break;
-    case CV_CFL_JSCRIPT:
-        result = "Javascript";
+                    break;
+                }
 
-        break;
-    case CV_CFL_MSIL:
-        result = "MSIL";
+                if (!*symbol)
+                {
+                    *symbol = symbol2;
+                }
+                else
+                {
+                    symbol2->Release();
+                }
+            }
 
-        break;
-    case CV_CFL_HLSL:
-        result = "HLSL";
+            enumSymbols->Release();
+        }
+    }
 
-        break;
-    case CV_CFL_OBJC:
-        result = "Objective C";
+    if (!*symbol)
+    {
+        return false;
+    }
 
-        break;
-    case CV_CFL_OBJCXX:
-        result = "Objective C++";
+    symbolLocatorsMutex.lock();
+    (*symbol)->get_symIndexId(&symbolLocators[index].id);
+    symbolLocatorsMutex.unlock();
 
-        break;
+    return true;
+}
+
+/*
+* TPI hash table has names exactly as they are stored in records. Names of templates are formatted by FormatString
+* and names of anonymous and demangled types are spelled differently so TPI can't tell that they don't exist.
+*/
+static bool IsTPITypeName(const QString& typeName)
+{
+    for (QChar character : typeName)
+    {
+        if (character == '<' || character == ',' || character == ' ' || character == '`' || character == '?')
+        {
+            return false;
+        }
     }
 
-    return result;
+    return typeName.length() > 0;
 }
 
-QString PDB::convertPlatformToString(CV_CPU_TYPE_e cpuType)
+bool PDB::GetSymbolByTypeName(enum SymTagEnum symTag, QString typeName, IDiaSymbol** symbol)
 {
-    QString result;
-
-    switch (cpuType)
+    /*
+    * TPI hash table answers whether type is defined without enumerating global scope so findChildren
+    * isn't called for names which don't exist, types which only have forward reference exist too
+    */
+    if (tpiStream.IsLoaded() && (symTag == SymTagUDT || symTag == SymTagEnum) && IsTPITypeName(typeName) &&
+        !tpiStream.FindTypeIndex(typeName, true))
     {
-    case 0:
-        result = "8080";
+        return false;
+    }
 
-        break;
-    case 1:
-        result = "8086";
+    IDiaEnumSymbols* enumSymbols;
 
-        break;
-    case 2:
-        result = "80286";
+    if (global->findChildren(symTag, typeName.toStdWString().c_str(), nsNone, &enumSymbols) == S_OK)
+    {
+        bool result = enumSymbols->Item(0, symbol) == S_OK;
 
-        break;
-    case 3:
-        result = "80386";
+        enumSymbols->Release();
 
-        break;
-    case 4:
-        result = "80486";
+        return result;
+    }
 
-        break;
-    case 5:
-        result = "Pentium";
+    return false;
+}
 
-        break;
-    case 6:
-        result = "Pentium II/Pentium Pro";
+bool PDB::GetSymbolRecordByTypeName(const QString& typeName, SymbolRecord* symbolRecord)
+{
+    QMutexLocker diaLocker(&diaMutex);
+    QHash<QString, DWORD>::const_iterator it = diaSymbols->find(typeName);
 
-        break;
-    case 7:
-        result = "Pentium III";
+    if (it == diaSymbols->end())
+    {
+        return false;
+    }
 
-        break;
-    case 16:
-        result = "MIPS (Generic)";
+    symbolRecord->id = it.value();
+    symbolRecord->typeName = typeName;
+    symbolRecord->type = SymbolType::unknownType;
 
-        break;
-    case 17:
-        result = "MIPS16";
+    if (tpiStream.IsLoaded())
+    {
+        TPIRecord record;
 
-        break;
-    case 18:
-        result = "MIPS32";
+        if (tpiStream.GetRecord(tpiStream.FindTypeIndex(typeName, true), &record))
+        {
+            symbolRecord->type = GetSymbolTypeFromLeaf(record.kind);
 
-        break;
-    case 19:
-        result = "MIPS64";
+            return true;
+        }
+    }
 
-        break;
-    case 20:
-        result = "MIPS I";
+    //Names of templates are formatted so TPI stream doesn't have them in same form as diaSymbols
+    IDiaSymbol* symbol;
 
-        break;
-    case 21:
-        result = "MIPS II";
+    if (GetSymbolByID(symbolRecord->id, &symbol))
+    {
+        DWORD symTag;
 
-        break;
-    case 22:
-        result = "MIPS III";
+        if (symbol->get_symTag(&symTag) == S_OK && symTag == SymTagEnum)
+        {
+            symbolRecord->type = SymbolType::enumType;
+        }
 
-        break;
-    case 23:
-        result = "MIPS IV";
+        symbol->Release();
+    }
 
-        break;
-	case 24:
-		result = "MIPS V";
+    return true;
+}
 
-		break;
-    case 32:
-        result = "M68000";
+SymbolType PDB::GetSymbolTypeFromLeaf(quint16 kind)
+{
+    switch (kind)
+    {
+    case LF_CLASS:
+        return SymbolType::classType;
+    case LF_STRUCTURE:
+        return SymbolType::structType;
+    case LF_INTERFACE:
+        return SymbolType::interfaceType;
+    case LF_UNION:
+        return SymbolType::unionType;
+    case LF_ENUM:
+        return SymbolType::enumType;
+    default:
+        return SymbolType::unknownType;
+    }
+}
 
-        break;
-	case 33:
-		result = "M68010";
+quint32 PDB::GetChildrenSize(const Element* element)
+{
+    quint32 size = 0;
+    int count = element->baseClassChildren.count() + element->dataChildren.count();
+    int bitSum = 0;
+    QList<Element> children;
 
-		break;
-    case 34:
-        result = "M68020";
+    children.append(element->baseClassChildren);
+    children.append(element->dataChildren);
 
-        break;
-    case 35:
-        result = "M68030";
+    for (int i = 0; i < count; i++)
+    {
+        if (children.at(i).elementType == ElementType::baseClassType)
+        {
+            size += children.at(i).baseClass->length;
+        }
+        else if (children.at(i).elementType == ElementType::dataType)
+        {
+            if (children.at(i).numberOfBits > 0)
+            {
+                unsigned long numberOfBits = children.at(i).size << 3;
+                unsigned long bitsSize = 0;
+                int countOfNewVariables = 1;
 
-        break;
-    case 36:
-        result = "M68040";
+                while (i < count &&
+                    children.at(i).elementType == ElementType::dataType &&
+                    children.at(i).numberOfBits != 0)
+                {
+                    bitsSize += children.at(i).numberOfBits;
 
-        break;
-    case 48:
-        result = "Alpha 21064";
+                    if (i < count - 1 &&
+                        children.at(i + 1).elementType == ElementType::dataType &&
+                        children.at(i + 1).numberOfBits + bitsSize > numberOfBits)
+                    {
+                        countOfNewVariables++;
+                        bitsSize = 0;
+                    }
 
-        break;
-    case 49:
-        result = "Alpha 21164";
+                    i++;
+                }
 
-        break;
-    case 50:
-        result = "Alpha 21164A";
+                i--; //i++ in while loop and i++ in main for loop will skip one member
+                size += countOfNewVariables * children.at(i).size;
+            }
+            else
+            {
+                size += children.at(i).size;
+            }
+        }
+    }
 
-        break;
-    case 51:
-        result = "Alpha 21264";
+    return size;
+}
 
-        break;
-    case 52:
-        result = "Alpha 21364";
+bool PDB::CheckIfChildrenSizesAreCorrect(const Element* element, QString& message)
+{
+    int dataChildrenCount = element->dataChildren.count();
 
-        break;
-    case 64:
-        result = "PPC 601";
+    for (int i = 0; i < dataChildrenCount; i++)
+    {
+        if (element->dataChildren.at(i).size == 0)
+        {
+            message = QString("<font size = 5>Output is not correct because size of %1 is 0 and that causes padding to be created!!!</font>")
+                .arg(element->dataChildren.at(i).data->name);
 
-        break;
-    case 65:
-        result = "PPC 603";
+            return false;
+        }
+    }
 
-        break;
-    case 66:
-        result = "PPC 604";
+    return true;
+}
 
-        break;
-    case 67:
-        result = "PPC 620";
+void PDB::FixOffsets(Element* element)
+{
+    Element newElement = *element;
 
-        break;
-    case 68:
-        result = "PPC w/FP";
+    newElement.dataChildren.clear();
 
-        break;
-    case 69:
-        result = "PPC (Big Endian)";
+    int count = element->dataChildren.count();
 
-        break;
-    case 80:
-        result = "SH3";
+    AppendElement(&newElement, &element->dataChildren, 0, count);
 
-        break;
-    case 81:
-        result = "SH3E";
+    *element = newElement;
+}
 
-        break;
-    case 82:
-        result = "SH3DSP";
+void PDB::AppendElement(Element* element, QList<Element>* children, int startPosition, int endPosition)
+{
+    for (int i = startPosition; i < endPosition; i++)
+    {
+        if (children->at(i).size)
+        {
+            quint32 offset = children->at(i).offset;
+            quint32 bitOffset = children->at(i).bitOffset;
+            quint32 size = children->at(i).size;
+            quint32 size2 = size;
+            quint32 count = 1;
+            quint32 position = i;
+            quint32 startOffset = offset;
 
-        break;
-    case 83:
-        result = "SH4";
+            QList<quint32> sizes;
+            QList<quint32> counts;
+            QList<quint32> positions;
 
-        break;
-    case 84:
-        result = "SHmedia";
+            for (int j = i + 1; j < endPosition; j++)
+            {
+                const Element& element2 = children->at(j);
+                quint32 elementRange = 0;
 
-        break;
-    case 96:
-        result = "ARM3";
+                if (!ShouldIncludeElement(element2))
+                {
+                    elementRange = element2.offset + element2.size;
+                }
 
-        break;
-    case 97:
-        result = "ARM4";
+                if ((element2.offset == offset) &&
+                    (element2.bitOffset == bitOffset) &&
+                    (element2.size) && !ShouldIncludeElement(element2))
+                {
+                    sizes.append(size2);
+                    counts.append(count);
+                    positions.append(position);
 
-        break;
-    case 98:
-        result = "ARM4T";
+                    size2 = 0;
+                    count = 0;
+                    position = j;
+                    startOffset = element2.offset;
+                }
 
-        break;
-    case 99:
-        result = "ARM5";
+                const quint32 prevRange = startOffset + size2;
 
-        break;
-    case 100:
-        result = "ARM5T";
+                if (elementRange <= prevRange)
+                {
+                    size2 += 0;
+                }
+                else
+                {
+                    size2 += elementRange - prevRange; //element2.size;
+                }
 
-        break;
-    case 101:
-        result = "ARM6";
+                count++;
+            }
 
-        break;
-    case 102:
-        result = "ARM (XMAC)";
+            int count2 = sizes.count();
 
-        break;
-    case 103:
-        result = "ARM (WMMX)";
+            if (count2)
+            {
+                // The last position
+                quint32 maxSize = 0;
 
-        break;
-    case 104:
-        result = "ARM 7";
+                for (int j = 0; j < count2; j++)
+                {
+                    maxSize = qMax(maxSize, sizes.at(j));
+                }
 
-        break;
-    case 112:
-        result = "Omni";
+                size2 = 0;
+                count = 0;
+                quint32 totalrange = offset;
 
-        break;
-    case 128:
-        result = "Itanium";
+                for (int j = position; j < endPosition; j++)
+                {
+                    const Element& element2 = children->at(j);
+                    quint32 elementRange = 0;
 
-        break;
-    case 129:
-        result = "Itanium (McKinley)";
+                    if (!ShouldIncludeElement(element2))
+                    {
+                        elementRange = element2.offset + element2.size;
+                    }
 
-        break;
-    case 144:
-        result = "CEE";
+                    if ((size2 >= maxSize) && (elementRange > totalrange))
+                    {
+                        break;
+                    }
 
-        break;
-    case 160:
-        result = "AM33";
+                    if (ShouldIncludeElement(element2))
+                    {
+                        break;
+                    }
 
-        break;
-    case 176:
-        result = "M32R";
-
-        break;
-    case 192:
-        result = "TriCore";
+                    if (element2.elementType == ElementType::dataType &&
+                        element2.data->isPadding)
+                    {
+                        break;
+                    }
 
-        break;
-    case 208:
-        result = "x64";
+                    /*if (element2.data->type.isEndAlign)
+                    {
+                        break;
+                    }*/
 
-        break;
-    case 224:
-        result = "EBC";
+                    if (elementRange <= totalrange)
+                    {
+                        size2 += 0;
+                    }
+                    else
+                    {
+                        size2 += elementRange - totalrange; // element2.size;
+                        totalrange = elementRange;
+                    }
 
-        break;
-    case 240:
-        result = "Thumb (CE)";
+                    count++;
+                }
 
-        break;
-    case 244:
-        result = "ARM NT";
+                sizes.append(size2);
+                counts.append(count);
+                positions.append(position);
 
-        break;
-	case 246:
-		result = "ARM 64";
+                count2++;
 
-		break;
-    case 256:
-        result = "D3D11_SHADER";
+                bool newUnion = true;
 
-        break;
-    }
+                if ((element->udt->udtKind == UdtUnion) && (element->size == size2))
+                {
+                    newUnion = false;
+                }
 
-    return result;
-}
+                Element unionElem = {};
+                Element* unionElement;
 
-QString PDB::GetTab(int level)
-{
-    QString result = "";
+                if (newUnion)
+                {
+                    unionElement = &unionElem;
+                    unionElement->elementType = ElementType::dataType;
+                    unionElement->size = qMax(size2, maxSize);
+                    unionElement->udt.Edit()->type = "union";
+                    unionElement->udt.Edit()->isAnonymousUnion = true;
+                    unionElement->udt.Edit()->udtKind = UdtUnion;
+                    unionElement->data.Edit()->hasChildren = true;
 
-    for (int i = 0; i < level; i++)
-    {
-        result += "\t";
-    }
+                    if (element->elementType == ElementType::udtType)
+                    {
+                        if (element->udt->udtKind == UdtClass)
+                        {
+                            unionElement->data.Edit()->access = CV_private;
+                        }
+                        else
+                        {
+                            unionElement->data.Edit()->access = CV_public;
+                        }
+                    }
+                    else
+                    {
+                        if (element->baseClass->udtKind == UdtClass)
+                        {
+                            unionElement->data.Edit()->access = CV_private;
+                        }
+                        else
+                        {
+                            unionElement->data.Edit()->access = CV_public;
+                        }
+                    }
+                }
+                else
+                {
+                    unionElement = element;
+                }
 
-    return result;
-}
+                for (int j = 0; j < count2; j++)
+                {
+                    if (counts.at(j) > 1)
+                    {
+                        Element structElem = {};
+                        Element* structElement = &structElem;
+                        structElement->elementType = ElementType::dataType;
+                        structElement->size = sizes.at(j);
+                        structElement->udt.Edit()->type = "struct";
+                        structElement->udt.Edit()->isAnonymousStruct = true;
+                        structElement->data.Edit()->hasChildren = true;
 
-QString PDB::GetBaseClassesInfo(const Element* element, bool addKeywords)
-{
-    QString elementInfo;
-    int childrenCount = element->baseClassChildren.count();
+                        if (element->elementType == ElementType::udtType)
+                        {
+                            if (element->udt->udtKind == UdtClass)
+                            {
+                                structElement->data.Edit()->access = CV_private;
+                            }
+                            else
+                            {
+                                structElement->data.Edit()->access = CV_public;
+                            }
+                        }
+                        else
+                        {
+                            if (element->baseClass->udtKind == UdtClass)
+                            {
+                                structElement->data.Edit()->access = CV_private;
+                            }
+                            else
+                            {
+                                structElement->data.Edit()->access = CV_public;
+                            }
+                        }
 
-    for (int i = 0; i < childrenCount; i++)
-    {
-        if (addKeywords)
-        {
-            if (i == 0)
-            {
-                elementInfo += " : ";
-            }
+                        AppendElement(structElement, children, positions.at(j), positions.at(j) + counts.at(j));
 
-            QString accessSpecifier;
-            bool accessSpecifierAdded = false;
+                        unionElement->dataChildren.append(*structElement);
+                    }
+                    else
+                    {
+                        AppendElement(unionElement, children, positions.at(j), positions.at(j) + counts.at(j));
+                    }
 
-            if (options->includeOnlyPublicAccessSpecifier)
-            {
-                if (element->elementType == ElementType::udtType && element->udt.udtKind == UdtClass)
-                {
-                    accessSpecifier += "public";
-                    accessSpecifierAdded = true;
-                }
-                else if (element->elementType == ElementType::baseClassType && element->baseClass.udtKind == UdtClass)
-                {
-                    accessSpecifier += "public";
-                    accessSpecifierAdded = true;
+                    i += counts.at(j);
                 }
-            }
-            else
-            {
-                accessSpecifier = convertAccessSpecifierToString(element->baseClassChildren.at(i).baseClass.access);
-                accessSpecifierAdded = true;
-            }
-
-            if (accessSpecifierAdded)
-            {
-                elementInfo += QString("%1 ").arg(accessSpecifier);
-            }
-
-            if (element->baseClassChildren.at(i).baseClass.isVirtualBaseClass ||
-                element->baseClassChildren.at(i).baseClass.isIndirectVirtualBaseClass)
-            {
-                elementInfo += "virtual ";
-            }
-        }
 
-        QString baseClassName = element->baseClassChildren.at(i).baseClass.name;
+                i--;
 
-        if (options->removeScopeResolutionOperator && baseClassName.contains("::"))
-        {
-            if (element->baseClassChildren.at(i).baseClass.parentClassName.length() == 0)
-            {
-                RemoveScopeResolutionOperators(baseClassName, parentClassName);
+                if (newUnion)
+                {
+                    element->dataChildren.append(*unionElement);
+                }
             }
             else
             {
-                RemoveScopeResolutionOperators(baseClassName, element->baseClassChildren.at(i).baseClass.parentClassName);
+                element->dataChildren.append(children->at(i));
             }
         }
-
-        elementInfo += baseClassName;
-
-        if (i != childrenCount - 1)
+        else
         {
-            elementInfo += ", ";
+            element->dataChildren.append(children->at(i));
         }
     }
-
-    return elementInfo;
 }
 
-QString PDB::GetEnumInfo(const Element* element, int level)
+bool PDB::ShouldIncludeElement(Element element)
 {
-    QString elementInfo = "";
+    return element.elementType == ElementType::functionType ||
+        element.elementType == ElementType::baseClassType ||
+        element.elementType == ElementType::udtType ||
+        element.elementType == ElementType::enumType ||
+        (element.elementType == ElementType::dataType &&
+            (element.data->dataKind == DataIsStaticMember));
+}
 
-    if (element->enum1.isAnonymous || element->enum1.isUnnamed)
+void PDB::CheckIfUnionsAreMissing(Element* element)
+{
+    if (!element->udt->isAnonymousUnion &&
+        !element->udt->isAnonymousStruct &&
+        element->size > 1 &&
+        GetChildrenSize(const_cast<Element*>(element)) > element->size)
     {
-        elementInfo += GetTab(level) + "enum\r\n";
+        FixOffsets(element);
     }
-    else
+
+    int udtChildrenCount = element->udtChildren.count();
+    int dataChildrenCount = element->dataChildren.count();
+    int staticDataChildrenCount = element->staticDataChildren.count();
+
+    for (int i = 0; i < udtChildrenCount; i++)
     {
-        QString enumName = element->enum1.name;
+        CheckIfUnionsAreMissing(&element->udtChildren[i]);
+    }
 
-        if (options->removeScopeResolutionOperator && enumName.contains("::"))
+    for (int i = 0; i < dataChildrenCount; i++)
+    {
+        if (element->dataChildren.at(i).data->hasChildren && !element->dataChildren.at(i).data->isTypeNameOfEnum)
         {
-            if (element->enum1.parentClassName.length() == 0)
-            {
-                RemoveScopeResolutionOperators(enumName, parentClassName);
-            }
-            else
-            {
-                RemoveScopeResolutionOperators(enumName, element->enum1.parentClassName);
-            }
+            CheckIfUnionsAreMissing(&element->dataChildren[i]);
         }
-
-        elementInfo += GetTab(level) + QString("enum %1\r\n").arg(enumName);
     }
 
-    elementInfo += GetTab(level) + "{\r\n";
-
-    int count = element->dataChildren.count();
-
-    for (int i = 0; i < count; i++)
+    for (int i = 0; i < staticDataChildrenCount; i++)
     {
-        elementInfo += GetTab(level + 1) + QString("%1 = %2").arg(element->dataChildren.at(i).data.name)
-            .arg(element->dataChildren.at(i).data.value.value.toString());
-
-        if (i != count - 1)
+        if (element->staticDataChildren.at(i).data->hasChildren && !element->dataChildren.at(i).data->isTypeNameOfEnum)
         {
-            elementInfo += ",";
+            CheckIfUnionsAreMissing(&element->staticDataChildren[i]);
         }
-
-        elementInfo += "\r\n";
     }
+}
 
-    elementInfo += GetTab(level) + "}";
+QString PDB::convertAccessSpecifierToString(CV_access_e accessSpecifier)
+{
+    QString result;
 
-    if (element->enum1.isUnnamed)
+    switch (accessSpecifier)
     {
-        elementInfo += GetDataInfo(&element->data, level);
+    case CV_private:
+        result = "private"; 
+
+        break;
+    case CV_protected:
+        result = "protected"; 
+
+        break;
+    case CV_public:
+        result = "public"; 
+
+        break;
     }
 
-    return elementInfo;
+    return result;
 }
 
-QString PDB::GetUDTInfo(Element* element, int level)
+QString PDB::convertCallingConventionToString(CV_call_e callingConvention)
 {
-    QString text;
-    quint32 alignment = 0;
-    quint32 correctAlignment = 0;
-    bool privateSpecifierAdded = false;
-    bool protectedSpecifierAdded = false;
-    bool publicSpecifierAdded = false;
+    QString result;
 
-    /*
-    * When option to add all access specifiers is used elements are already added to main children list
-    * so there JoinLists shoudn't be called again
-    */
-    if (options->includeOnlyPublicAccessSpecifier)
+    switch (callingConvention)
     {
-        JoinLists(element);
-    }
+    case CV_CALL_THISCALL:
+		result = "__thiscall";
 
-    if (element->udt.name.startsWith("m128") ||
-        element->udt.name.startsWith("_m128") ||
-        element->udt.name.startsWith("__m128"))
-	{
-        //__m128 is declared with 16 byte alignment __declspec(align(16))
-        alignment = 16;
-	}
-    else
-    {
-        unsigned int greatestPadding = GetGreatestPaddingInUDT(element);
+		break;
+    case CV_CALL_NEAR_FAST:
+    case CV_CALL_FAR_FAST:
+        result = "__fastcall";
 
-        if (greatestPadding > 1)
-        {
-            /*
-			* This method of calculating alignment is used first because it's faster and because there can be case
-			* where alignment is higher then default
-            * If padding is for example 8 that means that alignment is higher then 8 bytes
-            * so + 1 makes sure that returned number is greater then 8.
-            */
-            alignment = NextPowerOf2(greatestPadding + 1);
-        }
-        else
-        {
-            QHash<QString, int> checkedTypes;
-            QString parentClassName2 = parentClassName;
+        break;
+    case CV_CALL_NEAR_STD:
+    case CV_CALL_FAR_STD:
+        result = "__stdcall";
 
-            alignment = CalculateDefaultAlignment(element, checkedTypes);
+        break;
+    case CV_CALL_NEAR_C:
+    case CV_CALL_FAR_C:
+        result = "__cdecl";
 
-            parentClassName = parentClassName2;
-        }
-    }
+        break;
+    case CV_CALL_NEAR_VECTOR:
+        result = "__vectorcall";
 
-    correctAlignment = GetCorrectAlignment(alignment, element->size);
+        break;
+    }
 
-    element->udt.defaultAlignment = alignment;
-    element->udt.correctAlignment = correctAlignment;
+    return result;
+}
 
-    if (correctAlignment < alignment)
-    {
-        if (level > 0)
-        {
-            text += GetTab(level) + QString("#pragma pack(push, %1)\r\n\r\n").arg(correctAlignment);
-        }
-    }
+QString PDB::convertDataKindToString(DataKind dataKind)
+{
+    QString result;
 
-    if (options->specifyTypeAlignment)
+    switch (dataKind)
     {
-        if (correctAlignment < alignment)
-        {
-            if (element->udt.isUnnamed)
-            {
-                text += GetTab(level) + QString("%1").arg(element->udt.type);
-
-                /*
-                * Add __declspec(novtable) to save space
-                * https://docs.microsoft.com/en-us/archive/msdn-magazine/2000/march/c-q-a-atl-virtual-functions-and-vtables
-                */
-                if (element->udt.isAbstract && options->addNoVTableKeyword)
-                {
-                    text += "__declspec(novtable) ";
-                }
+    case DataIsUnknown:
+        result = "Unknown";
 
-                if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
-				{
-                    text += "__declspec(empty_bases) ";
-				}
-            }
-            else
-            {
-                QString name = element->udt.name;
+        break;
+    case DataIsLocal:
+		result = "Local";
 
-                if (options->removeScopeResolutionOperator && name.contains("::"))
-                {
-                    if (element->udt.parentClassName.length() == 0)
-                    {
-                        RemoveScopeResolutionOperators(name, parentClassName);
-                    }
-                    else
-                    {
-                        RemoveScopeResolutionOperators(name, element->udt.parentClassName);
-                    }
-                }
+		break;
+    case DataIsStaticLocal:
+		result = "Static local";
 
-                if (options->removeHungaryNotationFromUDTAndEnums)
-                {
-                    name = ModifyNamingCovention(name, false, false, false);
-                }
+		break;
+    case DataIsParam:
+		result = "Parameter";
 
-                text += GetTab(level) + QString("%1 ").arg(element->udt.type);
+		break;
+    case DataIsObjectPtr:
+		result = "Object pointer";
 
-                if (element->udt.isAbstract && options->addNoVTableKeyword)
-                {
-                    text += "__declspec(novtable) ";
-                }
+		break;
+    case DataIsFileStatic:
+		result = "File static";
 
-				if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
-				{
-					text += "__declspec(empty_bases) ";
-				}
+		break;
+    case DataIsGlobal:
+		result = "Global";
 
-                text += QString("%1").arg(name);
-            }
-        }
-        else
-        {
-            if (element->udt.isUnnamed)
-            {
-                text += GetTab(level) + QString("%1 ").arg(element->udt.type);
+		break;
+    case DataIsMember:
+		result = "Member";
 
-                if (element->udt.isAbstract && options->addNoVTableKeyword)
-                {
-                    text += "__declspec(novtable) ";
-                }
+		break;
+    case DataIsStaticMember:
+		result = "Static member";
 
-				if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
-				{
-					text += "__declspec(empty_bases) ";
-				}
+		break;
+    case DataIsConstant:
+		result = "Constant";
 
-                text += QString("alignas(%1)").arg(QString::number(alignment));
-            }
-            else
-            {
-                QString name = element->udt.name;
+		break;
+    }
 
-                if (options->removeScopeResolutionOperator && name.contains("::"))
-                {
-                    if (element->udt.parentClassName.length() == 0)
-                    {
-                        RemoveScopeResolutionOperators(name, parentClassName);
-                    }
-                    else
-                    {
-                        RemoveScopeResolutionOperators(name, element->udt.parentClassName);
-                    }
-                }
+    return result;
+}
 
-                if (options->removeHungaryNotationFromUDTAndEnums)
-                {
-                    name = ModifyNamingCovention(name, false, false, false);
-                }
+QString PDB::convertLocationTypeToString(LocationType locationType)
+{
+    QString type;
 
-                text += GetTab(level) + QString("%1 ").arg(element->udt.type);
+    switch (locationType)
+    {
+    case LocIsNull:
+        type = "Null";
 
-                if (element->udt.isAbstract && options->addNoVTableKeyword)
-                {
-                    text += "__declspec(novtable) ";
-                }
+        break;
+    case LocIsStatic:
+        type = "Static";
 
-				if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
-				{
-					text += "__declspec(empty_bases) ";
-				}
+        break;
+    case LocIsTLS:
+        type = "Thread local storage";
 
-                text += QString("alignas(%1) %2").arg(QString::number(alignment)).arg(name);
-            }
-        }
-    }
-    else
-    {
-        if (element->udt.isUnnamed)
-        {
-            text += GetTab(level) + QString("%1").arg(element->udt.type);
+        break;
+    case LocIsRegRel:
+        type = "Registry relative";
 
-            if (element->udt.isAbstract && options->addNoVTableKeyword)
-            {
-                text += " __declspec(novtable) ";
-            }
+        break;
+    case LocIsThisRel:
+        type = "This relative";
 
-			if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
-			{
-				text += "__declspec(empty_bases) ";
-			}
-        }
-        else
-        {
-            QString name = element->udt.name;
+        break;
+    case LocIsEnregistered:
+        type = "Enregistered";
 
-            if (options->removeScopeResolutionOperator && name.contains("::"))
-            {
-                if (element->udt.parentClassName.length() == 0)
-                {
-                    RemoveScopeResolutionOperators(name, parentClassName);
-                }
-                else
-                {
-                    RemoveScopeResolutionOperators(name, element->udt.parentClassName);
-                }
-            }
+        break;
+    case LocIsBitField:
+        type = "Bit field";
 
-            if (options->removeHungaryNotationFromUDTAndEnums)
-            {
-                name = ModifyNamingCovention(name, false, false, false);
-            }
+        break;
+    case LocIsSlot:
+        type = "Microsoft Intermediate Language (MSIL) slot";
 
-            text += GetTab(level) + QString("%1 ").arg(element->udt.type);
+        break;
+    case LocIsIlRel:
+        type = "MSIL relative";
 
-            if (element->udt.isAbstract && options->addNoVTableKeyword)
-            {
-                text += "__declspec(novtable) ";
-            }
+        break;
+    case LocInMetaData:
+        type = "Metadata";
 
-			if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
-			{
-				text += "__declspec(empty_bases) ";
-			}
+        break;
+    case LocIsConstant:
+        type = "Constant";
 
-            text += QString("%1").arg(name);
-        }
+        break;
     }
 
-    QString baseClassesInfo = GetBaseClassesInfo(element);
+    return type;
+}
 
-    text += baseClassesInfo;
+QString PDB::convertVariantToString(VARIANT variant)
+{
+    QString result;
 
-    if (options->displayComments)
+    switch (variant.vt)
     {
-        text += QString(" //Size = 0x%1").arg(element->size, 0, 16);
-    }
+    case VT_UI1:
+    case VT_I1:
+        result = QString(" 0x%1").arg(variant.bVal);
 
-    text += "\r\n";
-    text += GetTab(level) + "{\r\n";
+        break;
+    case VT_I2:
+    case VT_UI2:
+    case VT_BOOL:
+        result = QString(" 0x%1").arg(variant.iVal);
 
-    if (element->udt.udtKind == UdtClass &&
-        options->includeOnlyPublicAccessSpecifier &&
-        CheckIfPublicKeywordShouldBeAdded(element))
-    {
-        text += GetTab(level) + "public:\r\n";
-    }
+        break;
+    case VT_I4:
+    case VT_UI4:
+    case VT_INT:
+    case VT_UINT:
+    case VT_ERROR:
+        result = QString(" 0x%1").arg(variant.lVal);
 
-    int childrenCount = element->children.count();
+        break;
+    case VT_R4:
+        result = QString(" %g").arg(variant.fltVal);
 
-    for (int i = 0; i < childrenCount; i++)
-    {
-        if (element->children.at(i).elementType != ElementType::baseClassType)
-        {
-            if (element->children.at(i).elementType == ElementType::functionType &&
-                element->children.at(i).function.isNonImplemented &&
-                !options->displayNonImplementedFunctions)
-            {
-                AddAdditionalNewLine(element, text, i);
+        break;
+    case VT_R8:
+        result = QString(" %g").arg(variant.dblVal);
 
-                continue;
-            }
+        break;
+    case VT_BSTR:
+        result = QString(" \"%1\"").arg(variant.bstrVal);
 
-            if ((element->children.at(i).elementType == ElementType::dataType &&
-                element->children.at(i).data.isCompilerGenerated) &&
-                (!options->displayVTablePointerIfExists &&
-                    element->children.at(i).data.isVTablePointer ||
-                    !element->children.at(i).data.isVTablePointer &&
-                    !options->displayPaddingBytes))
-            {
-                AddAdditionalNewLine(element, text, i);
+        break;
+    default:
+        result = QString(" ??");
 
-                continue;
-            }
+        break;
+    }
 
-            if (!options->includeOnlyPublicAccessSpecifier)
-            {
-                CV_access_e access = CV_private;
-                ElementType elementType = element->children.at(i).elementType;
-                bool isAnonymousUDT = element->udt.isAnonymousUnion || element->udt.isAnonymousStruct;
+    return result;
+}
 
-                if (elementType == ElementType::udtType)
-                {
-                    access = element->children.at(i).udt.access;
-                }
-                else if (elementType == ElementType::dataType)
-                {
-                    access = element->children.at(i).data.access;
-                }
-                else if (elementType == ElementType::functionType)
-                {
-                    access = element->children.at(i).function.access;
-                }
-                else if (elementType == ElementType::enumType)
-                {
-                    access = element->children.at(i).enum1.access;
-                }
+QString PDB::convertLanguageToString(CV_CFL_LANG language)
+{
+    QString result;
 
-                switch (access)
-                {
-                case CV_private:
-                    if (!privateSpecifierAdded && !isAnonymousUDT)
-                    {
-                        privateSpecifierAdded = true;
+    switch (language)
+    {
+    case CV_CFL_C:
+        result = "C";
 
-                        if (protectedSpecifierAdded || publicSpecifierAdded)
-                        {
-                            text += "\r\n";
-                        }
+        break;
+    case CV_CFL_CXX:
+        result = "C++";
 
-                        text += GetTab(level) + "private:\r\n";
-                    }
+        break;
+    case CV_CFL_FORTRAN:
+        result = "Fortran";
 
-                    break;
-                case CV_protected:
-                    if (!protectedSpecifierAdded && !isAnonymousUDT)
-                    {
-                        protectedSpecifierAdded = true;
+        break;
+    case CV_CFL_MASM:
+        result = "MASM";
 
-                        if (privateSpecifierAdded || publicSpecifierAdded)
-                        {
-                            text += "\r\n";
-                        }
+        break;
+    case CV_CFL_PASCAL:
+        result = "Pascal";
 
-                        text += GetTab(level) + "protected:\r\n";
-                    }
+        break;
+    case CV_CFL_BASIC:
+        result = "Basic";
 
-                    break;
-                case CV_public:
-                    if (!publicSpecifierAdded && !isAnonymousUDT)
-                    {
-                        publicSpecifierAdded = true;
+        break;
+    case CV_CFL_COBOL:
+        result = "Cobol";
 
-                        if (privateSpecifierAdded || protectedSpecifierAdded)
-                        {
-                            text += "\r\n";
-                        }
+        break;
+    case CV_CFL_LINK:
+        result = "Link";
 
-                        if (element->udt.udtKind == UdtStruct || element->udt.udtKind == UdtUnion)
-                        {
-                            /*
-                            * Only add public access specifier to struct or union if there is already some other
-                            * access specifier because by default struct and union members are public
-                            */
-                            if (privateSpecifierAdded || protectedSpecifierAdded)
-                            {
-                                text += GetTab(level) + "public:\r\n";
-                            }
-                        }
-                        else
-                        {
-                            text += GetTab(level) + "public:\r\n";
-                        }
-                    }
+        break;
+    case CV_CFL_CVTRES:
+        result = "CvtRes";
 
-                    break;
-                }
-            }
+        break;
+    case CV_CFL_CVTPGD:
+        result = "CvtPdg";
 
-            text += GetElementInfo(&element->children[i], level + 1);
+        break;
+    case CV_CFL_CSHARP:
+        result = "C#";
 
-            if (!(element->children.at(i).elementType == ElementType::functionType &&
-                element->children.at(i).function.isVariadic &&
-                options->useTemplateFunction))
-            {
-                text += ";";
-            }
+        break;
+    case CV_CFL_VB:
+        result = "Visual Basic";
 
-            AddComments(element, text, i);
+        break;
+    case CV_CFL_ILASM:
+        result = "ILASM";
 
-            if (element->children[i].elementType == ElementType::udtType &&
-                element->children[i].udt.correctAlignment < element->children[i].udt.defaultAlignment)
-            {
-                text += QString("\r\n\r\n%1#pragma pack(pop)").arg(GetTab(level + 1));
-            }
+        break;
+    case CV_CFL_JAVA:
+        result = "Java";
 
-            AddAdditionalNewLine(element, text, i);
+        break;
+    case CV_CFL_JSCRIPT:
+        result = "Javascript";
 
-            text += "\r\n";
-        }
-    }
+        break;
+    case CV_CFL_MSIL:
+        result = "MSIL";
 
-    text += GetTab(level) + "}";
+        break;
+    case CV_CFL_HLSL:
+        result = "HLSL";
 
-    if (element->elementType == ElementType::dataType &&
-        element->data.hasChildren &&
-        element->data.name.length() > 0)
-    {
-        text += GetDataInfo(&element->data, level);
+        break;
+    case CV_CFL_OBJC:
+        result = "Objective C";
+
+        break;
+    case CV_CFL_OBJCXX:
+        result = "Objective C++";
+
+        break;
     }
 
-    return text;
+    return result;
 }
 
-QString PDB::GetElementInfo(Element* element, int level)
+QString PDB::convertPlatformToString(CV_CPU_TYPE_e cpuType)
 {
-    QString text;
-    ElementType elementType = element->elementType;
-    bool isParentClass = false, isParentNamespace = false;
+    QString result;
 
-    if (level == 0)
+    switch (cpuType)
     {
-        QString typeName;
-        bool isNested = false;
+    case 0:
+        result = "8080";
 
-        if (element->elementType == ElementType::udtType)
-        {
-            typeName = element->udt.name;
-            isNested = element->udt.isNested;
-        }
-        else
-        {
-            typeName = element->enum1.name;
-            isNested = element->enum1.isNested;
-        }
+        break;
+    case 1:
+        result = "8086";
 
-        if (typeName.contains("::"))
-        {
-            QString parentClassName = GetParentClassName(typeName);
+        break;
+    case 2:
+        result = "80286";
 
-            if (parentClassName.length() > 0)
-            {
-                auto it = diaSymbols->find(parentClassName);
+        break;
+    case 3:
+        result = "80386";
 
-                if (it == diaSymbols->end())
-                {
-                    if (isNested)
-                    {
-                        text += QString("class %1\r\n{\r\npublic:\r\n").arg(parentClassName);
+        break;
+    case 4:
+        result = "80486";
 
-                        isParentClass = true;
-                    }
-                    else
-                    {
-                        text += QString("namespace %1\r\n{\r\n").arg(parentClassName);
+        break;
+    case 5:
+        result = "Pentium";
 
-                        isParentNamespace = true;
-                    }
-                }
-            }
-        }
-    }
+        break;
+    case 6:
+        result = "Pentium II/Pentium Pro";
 
-    if (element->elementType == ElementType::dataType &&
-        element->data.hasChildren)
-    {
-        if (element->data.isTypeNameOfEnum)
-        {
-            elementType = ElementType::enumType;
-        }
-        else
-        {
-            elementType = ElementType::udtType;
-        }
-    }
+        break;
+    case 7:
+        result = "Pentium III";
 
-    switch (elementType)
-    {
-    case ElementType::enumType:
-    {
-        if (level == 0 && (isParentClass || isParentNamespace))
-        {
-            text += GetEnumInfo(const_cast<Element*>(element), level + 1);
-        }
-        else
-        {
-            text += GetEnumInfo(const_cast<Element*>(element), level);
-        }
+        break;
+    case 16:
+        result = "MIPS (Generic)";
 
         break;
-    }
-    case ElementType::udtType:
-    {
-		/*if (options->declareFunctionsForStaticVariables)
-		{
-			declareFunctionsForStaticVariables(element);
-		}*/
+    case 17:
+        result = "MIPS16";
 
-        if (level == 0 && (isParentClass || isParentNamespace))
-        {
-            text += GetUDTInfo(element, level + 1);
-        }
-        else
-        {
-            text += GetUDTInfo(element, level);
-        }
+        break;
+    case 18:
+        result = "MIPS32";
 
         break;
-    }
-    case ElementType::dataType:
-    {
-        text += GetDataInfo(&element->data, level);
+    case 19:
+        result = "MIPS64";
 
         break;
-    }
-    case ElementType::functionType:
-    {
-        text += GetFunctionInfo(const_cast<Element*>(element), level);
+    case 20:
+        result = "MIPS I";
 
         break;
-    }
-    case ElementType::typedefType:
-    {
-        text += GetTab(level) + element->typeDef.declaration;
+    case 21:
+        result = "MIPS II";
 
         break;
-    }
-    }
+    case 22:
+        result = "MIPS III";
 
-    if (level == 0)
-    {
-        text += ";\r\n";
+        break;
+    case 23:
+        result = "MIPS IV";
 
-        if (isParentClass)
-        {
-            text += "};\r\n";
-        }
-        else if (isParentNamespace)
-        {
-            text += "}\r\n";
-        }
+        break;
+	case 24:
+		result = "MIPS V";
 
-        bool isPragmaPackNeeded = element->udt.correctAlignment < element->udt.defaultAlignment;
+		break;
+    case 32:
+        result = "M68000";
 
-        if (isPragmaPackNeeded)
-        {
-            text += "\r\n#pragma pack(pop)\r\n";
-        }
+        break;
+	case 33:
+		result = "M68010";
 
-        if (element->elementType == ElementType::udtType && element->udt.includes.count() > 0)
-        {
-            text.insert(0, QString("%1\r\n\r\n").arg(element->udt.includes.values().join("\r\n")));
-        }
+		break;
+    case 34:
+        result = "M68020";
 
-        if (isPragmaPackNeeded)
-        {
-            text.insert(0, QString("#pragma once\r\n\r\n#pragma pack(push, %1)\r\n\r\n").arg(element->udt.correctAlignment));
-        }
-        else
-        {
-            text.insert(0, QString("#pragma once\r\n\r\n"));
-        }
+        break;
+    case 35:
+        result = "M68030";
 
-        vTableIndices.clear();
-        parentClassName.clear();
-    }
+        break;
+    case 36:
+        result = "M68040";
 
-    return text;
-}
+        break;
+    case 48:
+        result = "Alpha 21064";
 
-QString PDB::GetDataInfo(const Data* data, int level)
-{
-    QString text;
-    QString declaration = data->declaration;
+        break;
+    case 49:
+        result = "Alpha 21164";
 
-    if (!options->includeConstKeyword)
-    {
-        //This checks are needed in case of templates
+        break;
+    case 50:
+        result = "Alpha 21164A";
 
-        if (declaration.contains(", const"))
-        {
-            declaration.replace(" const", " ");
-        }
-        else if (declaration.contains(" const"))
-        {
-            declaration.replace(" const", "");
-        }
-        else if (declaration.contains("const "))
-        {
-            declaration.replace("const ", "");
-        }
-    }
+        break;
+    case 51:
+        result = "Alpha 21264";
 
-	if (!options->includeVolatileKeyword)
-	{
-        //This checks are needed in case of templates
+        break;
+    case 52:
+        result = "Alpha 21364";
 
-		if (declaration.contains(", volatile"))
-		{
-			declaration.replace(" volatile", " ");
-		}
-		else if (declaration.contains(" volatile"))
-		{
-			declaration.replace(" volatile", "");
-		}
-		else if (declaration.contains("volatile "))
-		{
-			declaration.replace("volatile ", "");
-		}
-	}
+        break;
+    case 64:
+        result = "PPC 601";
 
-    if (data->hasChildren)
-    {
-        text += declaration;
-    }
-    else
-    {
-        text += GetTab(level) + declaration;
-    }
+        break;
+    case 65:
+        result = "PPC 603";
 
-    if (data->value.isValid)
-    {
-        text += QString(" = %1").arg(data->value.value.toString());
-    }
+        break;
+    case 66:
+        result = "PPC 604";
 
-    return text;
-}
+        break;
+    case 67:
+        result = "PPC 620";
 
-QString PDB::GetFunctionInfo(const Element* element, int level)
-{
-    QString text;
+        break;
+    case 68:
+        result = "PPC w/FP";
 
-    if (element->function.isVariadic && options->useTemplateFunction)
-    {
-        text += ImplementVariadicTemplateFunction(element, level);
-    }
-    else
-    {
-        text += GetTab(level) + element->function.prototype;
-    }
+        break;
+    case 69:
+        result = "PPC (Big Endian)";
 
-    return text;
-}
+        break;
+    case 80:
+        result = "SH3";
 
-Data PDB::ConvertRecordTypeToData(const RecordType* recordType)
-{
-    Data data = {};
+        break;
+    case 81:
+        result = "SH3E";
 
-    data.baseType = recordType->baseType;
-    data.isTypeConst = recordType->isTypeConst;
-    data.isTypeVolatile = recordType->isTypeVolatile;
-    data.isPointerConst = recordType->isPointerConst;
-    data.isPointerVolatile = recordType->isPointerVolatile;
-    data.typeName = recordType->typeName;
-    data.originalTypeName = recordType->originalTypeName;
-    data.size = recordType->size;
-    data.isPointer = recordType->isPointer;
-    data.isReference = recordType->isReference;
-    data.pointerLevel = recordType->pointerLevel;
-    data.referenceLevel = recordType->referenceLevel;
-    data.isArray = recordType->isArray;
-    data.arrayCount = recordType->arrayCount;
-    data.functionReturnType = recordType->functionReturnType2;
-    data.functionParameters = recordType->functionParameters;
-    data.isVariadicFunction = recordType->isVariadicFunction;
-    data.callingConvention = recordType->callingConvention;
-    data.isFunctionPointer = recordType->isFunctionPointer;
-    data.noType = recordType->noType;
+        break;
+    case 82:
+        result = "SH3DSP";
 
-    return data;
-}
+        break;
+    case 83:
+        result = "SH4";
 
-void PDB::GetTemplateIncludes(QString templateTypeName, const QString& parentClassName)
-{
-    int length = templateTypeName.length();
-    int startIndex = 0;
-    int endIndex = length - 1;
-    QString include = "";
+        break;
+    case 84:
+        result = "SHmedia";
 
-    if (templateTypeName.contains(", const"))
-    {
-        templateTypeName.replace(" const", " ");
-    }
-    else if (templateTypeName.contains(" const"))
-    {
-        templateTypeName.replace(" const", "");
-    }
-    else if (templateTypeName.contains("const "))
-    {
-        templateTypeName.replace("const ", "");
-    }
+        break;
+    case 96:
+        result = "ARM3";
 
-    if (templateTypeName.contains("*"))
-    {
-        templateTypeName.replace("*", "");
-    }
+        break;
+    case 97:
+        result = "ARM4";
 
-    if (templateTypeName.contains("&"))
-    {
-        templateTypeName.replace("&", "");
-    }
+        break;
+    case 98:
+        result = "ARM4T";
 
-    templateTypeName.replace("class ", "");
-    templateTypeName.replace("struct ", "");
-    templateTypeName.replace("union ", "");
-    templateTypeName.replace("enum ", "");
-    templateTypeName.replace(">", "");
+        break;
+    case 99:
+        result = "ARM5";
 
-    QStringList names = templateTypeName.split("<");
-    int count = names.count();
+        break;
+    case 100:
+        result = "ARM5T";
 
-    for (int i = 0; i < count; i++)
-    {
-        if (names.at(i).contains("("))
-        {
-            if (!names.at(i).endsWith(")"))
-            {
-                names[i].append(")");
-            }
+        break;
+    case 101:
+        result = "ARM6";
 
-            int startIndex = names.at(i).indexOf("(");
-            int endIndex = names.at(i).indexOf(")");
-            QString functionPrototype;
-            bool isFirstName = true;
+        break;
+    case 102:
+        result = "ARM (XMAC)";
 
-            for (int j = endIndex; j >= 0; j--)
-            {
-                if (j < startIndex && names.at(i).at(j) == ',')
-                {
-                    isFirstName = false;
+        break;
+    case 103:
+        result = "ARM (WMMX)";
 
-                    break;
-                }
+        break;
+    case 104:
+        result = "ARM 7";
 
-                functionPrototype.insert(0, names.at(i).at(j));
-            }
+        break;
+    case 112:
+        result = "Omni";
 
-            startIndex = functionPrototype.indexOf("(");
-            endIndex = functionPrototype.indexOf(")");
+        break;
+    case 128:
+        result = "Itanium";
 
-            QStringList names2 = functionPrototype.mid(startIndex + 1, endIndex - startIndex - 1).split(", ");
-            int count2 = names2.count();
+        break;
+    case 129:
+        result = "Itanium (McKinley)";
 
-            for (int j = 0; j < count2; j++)
-            {
-                if (names2.at(j).length() == 1 && names2.at(j).at(0).isDigit())
-                {
-                    continue;
-                }
+        break;
+    case 144:
+        result = "CEE";
 
-                AddTypeNameToIncludesList(names2.at(j), parentClassName);
-            }
+        break;
+    case 160:
+        result = "AM33";
 
-            if (!isFirstName)
-            {
-                functionPrototype.insert(0, ",");
-            }
+        break;
+    case 176:
+        result = "M32R";
 
-            names[i].replace(functionPrototype, "");
+        break;
+    case 192:
+        result = "TriCore";
 
-            names2 = names.at(i).split(", ");
-            count2 = names2.count();
+        break;
+    case 208:
+        result = "x64";
 
-            for (int j = 0; j < count2; j++)
-            {
-                if (names2.at(j).length() == 1 && names2.at(j).at(0).isDigit())
-                {
-                    continue;
-                }
+        break;
+    case 224:
+        result = "EBC";
 
-                AddTypeNameToIncludesList(names2.at(j), parentClassName);
-            }
-        }
-        else
-        {
-            if (names.at(i).endsWith(")"))
-            {
-                names[i].remove(names[i].length() - 1, 1);
-            }
+        break;
+    case 240:
+        result = "Thumb (CE)";
 
-            QStringList names2 = names.at(i).split(", ");
-            int count2 = names2.count();
+        break;
+    case 244:
+        result = "ARM NT";
 
-            for (int j = 0; j < count2; j++)
-            {
-                if (names2.at(j).length() > 1 && !names2.at(j).at(0).isDigit())
-                {
-                    AddTypeNameToIncludesList(names2.at(j), parentClassName);
-                }
-            }
-        }
+        break;
+	case 246:
+		result = "ARM 64";
+
+		break;
+    case 256:
+        result = "D3D11_SHADER";
+
+        break;
     }
+
+    return result;
 }
 
-bool PDB::CheckIfNameOfMainOrInnerUDT(const QString& typeName, const QString& parentClassName)
+QString PDB::GetTab(int level)
 {
-    bool isNameOfMainOrInnerUDT = false;
+    return TextBuilder::GetIndentation(level);
+}
 
-    if (parentClassName.contains("::"))
+QString PDB::GetBaseClassesInfo(const Element* element, bool addKeywords)
+{
+    ResolutionContext* context = GetResolutionContext();
+    QString elementInfo;
+    int childrenCount = element->baseClassChildren.count();
+
+    for (int i = 0; i < childrenCount; i++)
     {
-        if (parentClassName.contains("<"))
+        if (addKeywords)
         {
-            int length = parentClassName.length();
-            int indexOfOperator = 0;
-            int temp = 0;
-
-            for (int i = 0; i < length; i++)
+            if (i == 0)
             {
-                temp = parentClassName.indexOf("::", temp + 1);
+                elementInfo += " : ";
+            }
 
-                if (temp == -1)
+            QString accessSpecifier;
+            bool accessSpecifierAdded = false;
+
+            if (options->includeOnlyPublicAccessSpecifier)
+            {
+                if (element->elementType == ElementType::udtType && element->udt->udtKind == UdtClass)
                 {
-                    break;
+                    accessSpecifier += "public";
+                    accessSpecifierAdded = true;
                 }
-
-                QString leftSide = parentClassName.mid(0, temp);
-                QString rightSide = parentClassName.mid(temp);
-
-                if (leftSide.count('<') == leftSide.count('>') && rightSide.count('<') == rightSide.count('>'))
+                else if (element->elementType == ElementType::baseClassType && element->baseClass->udtKind == UdtClass)
                 {
-                    indexOfOperator = temp;
-
-                    if (typeName.startsWith(parentClassName.mid(0, indexOfOperator)))
-                    {
-                        isNameOfMainOrInnerUDT = true;
-
-                        break;
-                    }
+                    accessSpecifier += "public";
+                    accessSpecifierAdded = true;
                 }
             }
-        }
-        else
-        {
-            QList<QString> names = parentClassName.split("::");
-            int count = names.count();
+            else
+            {
+                accessSpecifier = convertAccessSpecifierToString(element->baseClassChildren.at(i).baseClass->access);
+                accessSpecifierAdded = true;
+            }
 
-            for (int i = 0; i < count; i++)
+            if (accessSpecifierAdded)
             {
-                if (typeName.startsWith(names.at(i)))
-                {
-                    isNameOfMainOrInnerUDT = true;
+                elementInfo += QString("%1 ").arg(accessSpecifier);
+            }
 
-                    break;
-                }
+            if (element->baseClassChildren.at(i).baseClass->isVirtualBaseClass ||
+                element->baseClassChildren.at(i).baseClass->isIndirectVirtualBaseClass)
+            {
+                elementInfo += "virtual ";
             }
         }
-    }
-    else
-    {
-        if (typeName.contains("::") && typeName.startsWith(parentClassName))
+
+        QString baseClassName = element->baseClassChildren.at(i).baseClass->name;
+
+        if (context->RemoveScopeResolutionOperator() && baseClassName.contains("::"))
         {
-            isNameOfMainOrInnerUDT = true;
+            if (element->baseClassChildren.at(i).baseClass->parentClassName.length() == 0)
+            {
+                RemoveScopeResolutionOperators(baseClassName, context->parentClassName);
+            }
+            else
+            {
+                RemoveScopeResolutionOperators(baseClassName, element->baseClassChildren.at(i).baseClass->parentClassName);
+            }
         }
-        else if (typeName == parentClassName)
+
+        elementInfo += baseClassName;
+
+        if (i != childrenCount - 1)
         {
-            isNameOfMainOrInnerUDT = true;
+            elementInfo += ", ";
         }
     }
 
-    return isNameOfMainOrInnerUDT;
+    return elementInfo;
 }
 
-void PDB::AddTypeNameToIncludesList(const QString& typeName, const QString& parentClassName)
+QString PDB::GetEnumInfo(const Element* element, int level)
 {
-    QString name = typeName;
+    ResolutionContext* context = GetResolutionContext();
+    QString elementInfo = "";
 
-    if (name.contains("<"))
+    if (element->enum1->isAnonymous || element->enum1->isUnnamed)
     {
-        GetTemplateIncludes(name, parentClassName);
+        elementInfo += GetTab(level) + "enum\r\n";
     }
     else
     {
-        if (name.contains("::"))
+        QString enumName = element->enum1->name;
+
+        if (context->RemoveScopeResolutionOperator() && enumName.contains("::"))
         {
-            name = name.mid(0, name.indexOf("::"));
+            if (element->enum1->parentClassName.length() == 0)
+            {
+                RemoveScopeResolutionOperators(enumName, context->parentClassName);
+            }
+            else
+            {
+                RemoveScopeResolutionOperators(enumName, element->enum1->parentClassName);
+            }
         }
 
-        QHash<QString, quint32>::const_iterator it = baseTypes.find(name);
+        elementInfo += GetTab(level) + QString("enum %1\r\n").arg(enumName);
+    }
 
-        if (name.length() > 1 &&
-            it == baseTypes.end() &&
-            !CheckIfNameOfMainOrInnerUDT(name, parentClassName))
-        {
-            QString include = QString("#include \"%1.h\"").arg(name);
+    elementInfo += GetTab(level) + "{\r\n";
+
+    int count = element->dataChildren.count();
+
+    for (int i = 0; i < count; i++)
+    {
+        elementInfo += GetTab(level + 1) + QString("%1 = %2").arg(element->dataChildren.at(i).data->name)
+            .arg(element->dataChildren.at(i).data->value.value.toString());
 
-            includes.insert(include);
+        if (i != count - 1)
+        {
+            elementInfo += ",";
         }
+
+        elementInfo += "\r\n";
+    }
+
+    elementInfo += GetTab(level) + "}";
+
+    if (element->enum1->isUnnamed)
+    {
+        elementInfo += GetDataInfo(&*element->data, level);
     }
+
+    return elementInfo;
 }
 
-void PDB::AddComments(const Element* element, QString& text, int i)
+void PDB::GetUDTInfo(Element* element, TextBuilder& text, int level)
 {
-    if (!options->displayComments)
+    ResolutionContext* context = GetResolutionContext();
+    quint32 alignment = 0;
+    quint32 correctAlignment = 0;
+    bool privateSpecifierAdded = false;
+    bool protectedSpecifierAdded = false;
+    bool publicSpecifierAdded = false;
+
+    /*
+    * When option to add all access specifiers is used elements are already added to main children list
+    * so there JoinLists shoudn't be called again
+    */
+    if (options->includeOnlyPublicAccessSpecifier)
     {
-        return;
+        JoinLists(element);
     }
 
-    if (element->children.at(i).elementType == ElementType::dataType)
+    quint64 layoutKey = GetElementKey(element->udt->id, true);
+    quint64 cachedAlignment = 0;
+    quint64 cachedCorrectAlignment = 0;
+
+    if (element->udt->id != 0 &&
+        layoutCache.GetValue(layoutKey, LayoutField::defaultAlignment, cachedAlignment) &&
+        layoutCache.GetValue(layoutKey, LayoutField::correctAlignment, cachedCorrectAlignment))
     {
-		DWORD relativeVirtualAddress, fileOffset;
-		QString relativeVirtualAddress2, fileOffset2;
+        alignment = static_cast<quint32>(cachedAlignment);
+    }
+    else if (element->udt->name.startsWith("m128") ||
+        element->udt->name.startsWith("_m128") ||
+        element->udt->name.startsWith("__m128"))
+	{
+        //__m128 is declared with 16 byte alignment __declspec(align(16))
+        alignment = 16;
+	}
+    else
+    {
+        unsigned int greatestPadding = GetGreatestPaddingInUDT(element);
 
-        if (element->children.at(i).data.dataKind == DataIsStaticMember)
+        if (greatestPadding > 1)
         {
-            relativeVirtualAddress = element->children.at(i).data.relativeVirtualAddress;
-            fileOffset = peHeaderParser->ConvertRVAToFileOffset(relativeVirtualAddress);
-
-            relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
-            fileOffset2 = QString::number(fileOffset, 16).toUpper();
-
-            text += QString(" //Offset = 0x%1, File Offset = 0x%2").arg(relativeVirtualAddress2).arg(fileOffset2);
+            /*
+			* This method of calculating alignment is used first because it's faster and because there can be case
+			* where alignment is higher then default
+            * If padding is for example 8 that means that alignment is higher then 8 bytes
+            * so + 1 makes sure that returned number is greater then 8.
+            */
+            alignment = NextPowerOf2(greatestPadding + 1);
         }
         else
         {
-            relativeVirtualAddress = element->children.at(i).offset;
-            relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
+            QSet<QString> checkedTypes;
+            QString parentClassName2 = context->parentClassName;
 
-            text += QString(" //Offset = 0x%1").arg(relativeVirtualAddress2);
+            alignment = CalculateDefaultAlignment(element, checkedTypes);
+
+            context->parentClassName = parentClassName2;
         }
+    }
 
-        DWORD size = element->children.at(i).size;
-        QString size2 = QString::number(size, 16).toUpper();
-
-        text += QString(" Size = 0x%2").arg(size2);
-
-		if (element->children.at(i).numberOfBits > 0)
-		{
-            DWORD bitOffset = element->children.at(i).bitOffset;
-			QString bitOffset2 = QString::number(bitOffset, 16).toUpper();
-
-            DWORD numberOfBits = element->children.at(i).numberOfBits;
-			QString numberOfBits2 = QString::number(numberOfBits, 16).toUpper();
-
-            text += QString(" BitOffset = 0x%1, Number Of Bits = 0x%2").arg(bitOffset2).arg(numberOfBits2);
-		}
+    if (cachedCorrectAlignment > 0)
+    {
+        correctAlignment = static_cast<quint32>(cachedCorrectAlignment);
     }
-    else if (element->children.at(i).elementType == ElementType::functionType)
+    else
     {
-        DWORD relativeVirtualAddress = element->children.at(i).function.relativeVirtualAddress;
-        QString relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
-
-        DWORD fileOffset = peHeaderParser->ConvertRVAToFileOffset(relativeVirtualAddress);
-        QString fileOffset2 = QString::number(fileOffset, 16).toUpper();
+        correctAlignment = GetCorrectAlignment(alignment, element->size);
 
-        if (element->children.at(i).function.isVirtual)
+        if (element->udt->id != 0)
         {
-            int vTableIndex = element->children.at(i).function.virtualBaseOffset >> 2;
-            QString indexOfVTable = QString::number(element->children.at(i).function.indexOfVTable);
-
-            if (element->children.at(i).function.indexOfVTable == 0)
-            {
-                indexOfVTable.append(" (Main VTable)");
-            }
-            else
-            {
-                QString vTableName = element->udt.vTableNames[element->children.at(i).function.indexOfVTable];
+            layoutCache.SetValue(layoutKey, LayoutField::defaultAlignment, alignment);
+            layoutCache.SetValue(layoutKey, LayoutField::correctAlignment, correctAlignment);
+        }
+    }
 
-                indexOfVTable.append(QString(" (%1)").arg(vTableName));
-            }
+    element->udt.Edit()->defaultAlignment = alignment;
+    element->udt.Edit()->correctAlignment = correctAlignment;
 
-            text += QString(" //Index = %1, Index Of VTable = %2, Offset = 0x%3, File Offset = 0x%4").arg(vTableIndex)
-                .arg(indexOfVTable).arg(relativeVirtualAddress2).arg(fileOffset2);
-        }
-        else
+    if (correctAlignment < alignment)
+    {
+        if (level > 0)
         {
-            text += QString(" //Offset = 0x%1, File Offset = 0x%2").arg(relativeVirtualAddress2).arg(fileOffset2);
+            text += GetTab(level) + QString("#pragma pack(push, %1)\r\n\r\n").arg(correctAlignment);
         }
     }
-}
 
-void PDB::AddAdditionalNewLine(const Element* element, QString& text, int i)
-{
-    bool addNewLine = false;
-    int childrenCount = element->children.count();
-
-    if (element->children.at(i).elementType == ElementType::udtType ||
-        element->children.at(i).elementType == ElementType::enumType)
+    if (options->specifyTypeAlignment)
     {
-        if (i + 1 < childrenCount)
+        if (correctAlignment < alignment)
         {
-            if (element->children.at(i + 1).elementType == ElementType::udtType ||
-                element->children.at(i + 1).elementType == ElementType::enumType ||
-                element->children.at(i + 1).elementType == ElementType::typedefType &&
-                options->displayTypedefs)
+            if (element->udt->isUnnamed)
             {
-                addNewLine = true;
+                text += GetTab(level) + QString("%1").arg(element->udt->type);
+
+                /*
+                * Add __declspec(novtable) to save space
+                * https://docs.microsoft.com/en-us/archive/msdn-magazine/2000/march/c-q-a-atl-virtual-functions-and-vtables
+                */
+                if (element->udt->isAbstract && options->addNoVTableKeyword)
+                {
+                    text += "__declspec(novtable) ";
+                }
+
+                if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
+				{
+                    text += "__declspec(empty_bases) ";
+				}
             }
-            else if (element->children.at(i + 1).elementType == ElementType::dataType)
+            else
             {
-                for (int j = i + 1; j < childrenCount; j++)
+                QString name = element->udt->name;
+
+                if (context->RemoveScopeResolutionOperator() && name.contains("::"))
                 {
-                    if (element->children.at(j).elementType == ElementType::dataType)
+                    if (element->udt->parentClassName.length() == 0)
                     {
-                        if (element->children.at(j).data.isCompilerGenerated)
-                        {
-                            if (options->displayVTablePointerIfExists &&
-                                element->children.at(j).data.isVTablePointer ||
-                                element->children.at(j).data.isPadding &&
-                                options->displayPaddingBytes)
-                            {
-                                addNewLine = true;
-
-                                break;
-                            }
-                        }
-                        else
-                        {
-                            addNewLine = true;
-
-                            break;
-                        }
+                        RemoveScopeResolutionOperators(name, context->parentClassName);
                     }
                     else
                     {
-                        break;
+                        RemoveScopeResolutionOperators(name, element->udt->parentClassName);
                     }
                 }
 
-                //In case there is only padding between inner type and function which shouldn't be displayed
-                if (!addNewLine)
+                if (options->removeHungaryNotationFromUDTAndEnums)
                 {
-                    addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+                    name = ModifyNamingCovention(name, false, false, false);
                 }
-            }
-            else if (element->children.at(i + 1).elementType == ElementType::functionType)
-            {
-                addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+
+                text += GetTab(level) + QString("%1 ").arg(element->udt->type);
+
+                if (element->udt->isAbstract && options->addNoVTableKeyword)
+                {
+                    text += "__declspec(novtable) ";
+                }
+
+				if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
+				{
+					text += "__declspec(empty_bases) ";
+				}
+
+                text += QString("%1").arg(name);
             }
         }
-    }
-    else if (element->children.at(i).elementType == ElementType::typedefType)
-    {
-        if (options->displayTypedefs && i < childrenCount - 1)
+        else
         {
-            if (element->children.at(i + 1).elementType == ElementType::dataType)
+            if (element->udt->isUnnamed)
             {
-                for (int j = i + 1; j < childrenCount; j++)
+                text += GetTab(level) + QString("%1 ").arg(element->udt->type);
+
+                if (element->udt->isAbstract && options->addNoVTableKeyword)
                 {
-                    if (element->children.at(j).elementType == ElementType::dataType)
-                    {
-                        if (element->children.at(j).data.isCompilerGenerated)
-                        {
-                            if (options->displayVTablePointerIfExists &&
-                                element->children.at(j).data.isVTablePointer ||
-                                element->children.at(j).data.isPadding &&
-                                options->displayPaddingBytes)
-                            {
-                                addNewLine = true;
+                    text += "__declspec(novtable) ";
+                }
 
-                                break;
-                            }
-                        }
-                        else
-                        {
-                            addNewLine = true;
+				if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
+				{
+					text += "__declspec(empty_bases) ";
+				}
 
-                            break;
-                        }
+                text += QString("alignas(%1)").arg(QString::number(alignment));
+            }
+            else
+            {
+                QString name = element->udt->name;
+
+                if (context->RemoveScopeResolutionOperator() && name.contains("::"))
+                {
+                    if (element->udt->parentClassName.length() == 0)
+                    {
+                        RemoveScopeResolutionOperators(name, context->parentClassName);
                     }
                     else
                     {
-                        break;
+                        RemoveScopeResolutionOperators(name, element->udt->parentClassName);
                     }
                 }
 
-                if (!addNewLine)
+                if (options->removeHungaryNotationFromUDTAndEnums)
                 {
-                    addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+                    name = ModifyNamingCovention(name, false, false, false);
                 }
-            }
-            else if (element->children.at(i + 1).elementType == ElementType::functionType)
-            {
-                addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+
+                text += GetTab(level) + QString("%1 ").arg(element->udt->type);
+
+                if (element->udt->isAbstract && options->addNoVTableKeyword)
+                {
+                    text += "__declspec(novtable) ";
+                }
+
+				if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
+				{
+					text += "__declspec(empty_bases) ";
+				}
+
+                text += QString("alignas(%1) %2").arg(QString::number(alignment)).arg(name);
             }
         }
     }
-    else if (element->children.at(i).elementType == ElementType::dataType &&
-        element->children.at(i).data.dataKind != DataIsStaticMember)
+    else
     {
-        if (i == 0 && element->children.at(i).data.isCompilerGenerated)
-        {
-            if (options->displayVTablePointerIfExists &&
-                element->children.at(i).data.isVTablePointer ||
-                element->children.at(i).data.isPadding &&
-                options->displayPaddingBytes) //Only end align can appear as first data member
-            {
-                addNewLine = true;
-            }
-        }
-        else if (i > 0 &&
-            element->children.at(i - 1).elementType == ElementType::baseClassType &&
-            element->children.at(i).data.isCompilerGenerated)
+        if (element->udt->isUnnamed)
         {
-            if (options->displayVTablePointerIfExists &&
-                element->children.at(i).data.isVTablePointer ||
-                element->children.at(i).data.isPadding &&
-                options->displayPaddingBytes)
+            text += GetTab(level) + QString("%1").arg(element->udt->type);
+
+            if (element->udt->isAbstract && options->addNoVTableKeyword)
             {
-                addNewLine = true;
+                text += " __declspec(novtable) ";
             }
+
+			if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
+			{
+				text += "__declspec(empty_bases) ";
+			}
         }
-        else if (i < childrenCount - 1)
+        else
         {
-            if (element->children.at(i + 1).elementType == ElementType::dataType &&
-                element->children.at(i + 1).data.dataKind == DataIsStaticMember)
-            {
-                /*if (element->children.at(i).data.isCompilerGenerated)
-                {
-                    if (options->displayVTablePointerIfExists &&
-                        element->children.at(i).data.isVTablePointer ||
-                        element->children.at(i).data.isPadding &&
-                        options->displayPaddingBytes)
-                    {
-                        addNewLine = true;
-                    }
-                }
-                else
-                {
-                    addNewLine = true;
-                }*/
+            QString name = element->udt->name;
 
-                if (i > 0 &&
-                    (element->children.at(i - 1).elementType == ElementType::dataType &&
-                        element->children.at(i - 1).data.hasChildren ||
-                        element->children.at(i - 1).elementType != ElementType::dataType) &&
-                    element->children.at(i).data.isCompilerGenerated)
-                {
-                    if (options->displayVTablePointerIfExists &&
-                        element->children.at(i).data.isVTablePointer ||
-                        element->children.at(i).data.isPadding &&
-                        options->displayPaddingBytes)
-                    {
-                        addNewLine = true;
-                    }
-                }
-                else
-                {
-                    addNewLine = true;
-                }
-            }
-            else if (element->children.at(i + 1).elementType == ElementType::functionType)
+            if (context->RemoveScopeResolutionOperator() && name.contains("::"))
             {
-                /*
-                * In this case new line is already added after udt or enum type so another new line shouldn't be added
-                * if option for displaying padding isn't enabled
-                */
-                if (i > 0 &&
-                    (element->children.at(i - 1).elementType == ElementType::dataType &&
-                        element->children.at(i - 1).data.hasChildren ||
-                        element->children.at(i - 1).elementType != ElementType::dataType) &&
-                    element->children.at(i).data.isCompilerGenerated)
+                if (element->udt->parentClassName.length() == 0)
                 {
-                    if (options->displayVTablePointerIfExists &&
-                        element->children.at(i).data.isVTablePointer ||
-                        element->children.at(i).data.isPadding &&
-                        options->displayPaddingBytes)
-                    {
-                        addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
-                    }
+                    RemoveScopeResolutionOperators(name, context->parentClassName);
                 }
                 else
                 {
-                    addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+                    RemoveScopeResolutionOperators(name, element->udt->parentClassName);
                 }
-
-                //addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
             }
-            /*else if (element->children.at(i + 1).elementType == ElementType::udtType)
+
+            if (options->removeHungaryNotationFromUDTAndEnums)
             {
-                if (element->children.at(i).data.isCompilerGenerated)
-                {
-                    if (options->displayVTablePointerIfExists &&
-                        element->children.at(i).data.isVTablePointer ||
-                        element->children.at(i).data.isPadding &&
-                        options->displayPaddingBytes)
-                    {
-                        addNewLine = true;
-                    }
-                }
-                else
-                {
-                    addNewLine = true;
-                }
-            }*/
-            else if (element->children.at(i).data.hasChildren &&
-                element->children.at(i + 1).elementType == ElementType::dataType)
+                name = ModifyNamingCovention(name, false, false, false);
+            }
+
+            text += GetTab(level) + QString("%1 ").arg(element->udt->type);
+
+            if (element->udt->isAbstract && options->addNoVTableKeyword)
             {
-                for (int j = i + 1; j < childrenCount; j++)
-                {
-                    if (element->children.at(j).elementType == ElementType::dataType)
-                    {
-                        if (element->children.at(j).data.isCompilerGenerated)
-                        {
-                            if (options->displayVTablePointerIfExists &&
-                                element->children.at(j).data.isVTablePointer ||
-                                element->children.at(j).data.isPadding &&
-                                options->displayPaddingBytes)
-                            {
-                                addNewLine = true;
-
-                                break;
-                            }
-                        }
-                        else
-                        {
-                            addNewLine = true;
+                text += "__declspec(novtable) ";
+            }
 
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
+			if (options->applyEmptyBaseClassOptimization && CheckIfHasAnyEmptyBaseClass(element))
+			{
+				text += "__declspec(empty_bases) ";
+			}
 
-                if (!addNewLine)
-                {
-                    addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
-                }
-            }
-            else if (element->children.at(i + 1).elementType == ElementType::dataType &&
-                element->children.at(i + 1).data.hasChildren)
-            {
-                addNewLine = true;
-            }
-        }
-    }
-    else if (element->children.at(i).elementType == ElementType::dataType &&
-        element->children.at(i).data.dataKind == DataIsStaticMember)
-    {
-        if (i < childrenCount - 1)
-        {
-            if (element->children.at(i + 1).elementType == ElementType::functionType)
-            {
-                addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
-            }
-            else if (element->children.at(i + 1).elementType == ElementType::dataType &&
-                element->children.at(i + 1).data.hasChildren)
-            {
-                addNewLine = true;
-            }
-        }
-    }
-    else if (element->children.at(i).elementType == ElementType::functionType)
-    {
-        if (element->children.at(i).function.isVirtual)
-        {
-            if (i < childrenCount - 1)
-            {
-                if (element->children.at(i + 1).elementType == ElementType::functionType &&
-                    element->children.at(i + 1).function.isVirtual &&
-                    !element->children.at(i + 1).function.isNonImplemented &&
-                    element->children.at(i + 1).function.indexOfVTable >
-                    element->children.at(i).function.indexOfVTable)
-                {
-                    addNewLine = true;
-                }
-                else if (element->children.at(i + 1).elementType == ElementType::functionType &&
-                    !element->children.at(i + 1).function.isVirtual)
-                {
-                    addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
-                }
-            }
-        }
-        else if (i < childrenCount - 1 &&
-            element->children.at(i + 1).function.isStatic &&
-            element->children.at(i + 1).function.isGeneratedByApp &&
-            !(element->children.at(i).function.isStatic &&
-                element->children.at(i).function.isGeneratedByApp))
-        {
-            addNewLine = true;
+            text += QString("%1").arg(name);
         }
     }
 
-    if (addNewLine)
-    {
-        text += "\r\n";
-    }
-}
+    QString baseClassesInfo = GetBaseClassesInfo(element);
 
-bool PDB::AddAdditionalNewLineBeforeFunc(const Element* element, int i)
-{
-    bool addNewLine = true;
+    text += baseClassesInfo;
 
-    if (element->children.at(i + 1).function.isNonImplemented && !options->displayNonImplementedFunctions)
+    if (options->displayComments)
     {
-        addNewLine = false;
-
-        /*
-        * In case there is function that comes right after last variable but it's offset is 0 and it shouldn't be displayed
-        * then check if there is any other function below with offset different then 0 and
-        * if it there is any then add new line
-        */
-
-        int count = element->children.count();
+        text += QString(" //Size = 0x%1").arg(element->size, 0, 16);
+    }
 
-        for (int j = i + 2; j < count; j++)
-        {
-            if (element->children.at(j).elementType != ElementType::functionType)
-            {
-                break;
-            }
-            else
-            {
-                if (!element->children.at(j).function.isNonImplemented)
-                {
-                    addNewLine = true;
+    text += "\r\n";
+    text += GetTab(level) + "{\r\n";
 
-                    break;
-                }
-            }
-        }
+    if (element->udt->udtKind == UdtClass &&
+        options->includeOnlyPublicAccessSpecifier &&
+        CheckIfPublicKeywordShouldBeAdded(element))
+    {
+        text += GetTab(level) + "public:\r\n";
     }
 
-    return addNewLine;
-}
+    int childrenCount = element->children.count();
 
-void PDB::RemoveScopeResolutionOperators(QString& text, const QString& parentClassName)
-{
-    if (text.contains("<"))
+    for (int i = 0; i < childrenCount; i++)
     {
-        int length = text.length();
-        int indexOfOperator = 0;
-        int temp = 0;
-
-        for (int i = 0; i < length; i++)
+        if (element->children.at(i).elementType != ElementType::baseClassType)
         {
-            temp = text.indexOf("::", temp + 1);
-
-            if (temp == -1)
+            if (element->children.at(i).elementType == ElementType::functionType &&
+                element->children.at(i).function->isNonImplemented &&
+                !options->displayNonImplementedFunctions)
             {
-                break;
-            }
-
-            QString leftSide = text.mid(0, temp);
-            QString rightSide = text.mid(temp);
+                AddAdditionalNewLine(element, text, i);
 
-            if (leftSide.count('<') == leftSide.count('>') && rightSide.count('<') == rightSide.count('>'))
-            {
-                indexOfOperator = temp;
+                continue;
             }
-        }
 
-        bool removeScopeOperator = false;
-
-        if (parentClassName.length() > 0)
-        {
-            /*if (parentClassName.contains(text.mid(0, indexOfOperator)))
+            if ((element->children.at(i).elementType == ElementType::dataType &&
+                element->children.at(i).data->isCompilerGenerated) &&
+                (!options->displayVTablePointerIfExists &&
+                    element->children.at(i).data->isVTablePointer ||
+                    !element->children.at(i).data->isVTablePointer &&
+                    !options->displayPaddingBytes))
             {
-                removeScopeOperator = true;
-            }*/
+                AddAdditionalNewLine(element, text, i);
 
-            if (parentClassName.startsWith(text.mid(0, indexOfOperator)))
-            {
-                removeScopeOperator = true;
+                continue;
             }
-        }
-        else
-        {
-            removeScopeOperator = true;
-        }
 
-        if (removeScopeOperator)
-        {
-            if (indexOfOperator > 0)
+            if (!options->includeOnlyPublicAccessSpecifier)
             {
-                text.remove(0, indexOfOperator + 2);
-            }
+                CV_access_e access = CV_private;
+                ElementType elementType = element->children.at(i).elementType;
+                bool isAnonymousUDT = element->udt->isAnonymousUnion || element->udt->isAnonymousStruct;
 
-            if (text.contains("::"))
-            {
-                if (parentClassName.length() == 0)
+                if (elementType == ElementType::udtType)
                 {
-                    if (!text.contains("<"))
-                    {
-                        text = text.mid(text.lastIndexOf("::") + 2);
-                    }
+                    access = element->children.at(i).udt->access;
                 }
-                else
+                else if (elementType == ElementType::dataType)
                 {
-                    if (parentClassName.contains("<"))
+                    access = element->children.at(i).data->access;
+                }
+                else if (elementType == ElementType::functionType)
+                {
+                    access = element->children.at(i).function->access;
+                }
+                else if (elementType == ElementType::enumType)
+                {
+                    access = element->children.at(i).enum1->access;
+                }
+
+                switch (access)
+                {
+                case CV_private:
+                    if (!privateSpecifierAdded && !isAnonymousUDT)
                     {
-                        int length = parentClassName.length();
-                        int indexOfOperator = 0;
-                        int temp = 0;
+                        privateSpecifierAdded = true;
 
-                        for (int i = 0; i < length; i++)
+                        if (protectedSpecifierAdded || publicSpecifierAdded)
                         {
-                            temp = parentClassName.indexOf("::", temp + 1);
+                            text += "\r\n";
+                        }
 
-                            if (temp == -1)
-                            {
-                                break;
-                            }
+                        text += GetTab(level) + "private:\r\n";
+                    }
 
-                            QString leftSide = parentClassName.mid(0, temp);
-                            QString rightSide = parentClassName.mid(temp);
+                    break;
+                case CV_protected:
+                    if (!protectedSpecifierAdded && !isAnonymousUDT)
+                    {
+                        protectedSpecifierAdded = true;
 
-                            if (leftSide.count('<') == leftSide.count('>') && rightSide.count('<') == rightSide.count('>'))
-                            {
-                                indexOfOperator = temp;
-                            }
+                        if (privateSpecifierAdded || publicSpecifierAdded)
+                        {
+                            text += "\r\n";
                         }
 
-                        if (indexOfOperator > 0)
-                        {
-                            text.replace(parentClassName.mid(0, indexOfOperator + 2), "");
-                            text.replace(QString("%1::").arg(parentClassName.mid(indexOfOperator + 2)), "");
+                        text += GetTab(level) + "protected:\r\n";
+                    }
 
-                            QStringList list = text.split("::");
-                            int count = list.count();
+                    break;
+                case CV_public:
+                    if (!publicSpecifierAdded && !isAnonymousUDT)
+                    {
+                        publicSpecifierAdded = true;
 
-                            for (int i = 0; i < count; i++)
+                        if (privateSpecifierAdded || protectedSpecifierAdded)
+                        {
+                            text += "\r\n";
+                        }
+
+                        if (element->udt->udtKind == UdtStruct || element->udt->udtKind == UdtUnion)
+                        {
+                            /*
+                            * Only add public access specifier to struct or union if there is already some other
+                            * access specifier because by default struct and union members are public
+                            */
+                            if (privateSpecifierAdded || protectedSpecifierAdded)
                             {
-                                if (!list.at(i).contains("<"))
-                                {
-                                    text.replace(QString("%1::").arg(list.at(i)), "");
-                                }
+                                text += GetTab(level) + "public:\r\n";
                             }
                         }
-                    }
-                    else
-                    {
-                        QList<QString> names = parentClassName.split("::");
-                        int count = names.count();
-
-                        for (int i = 0; i < count; i++)
+                        else
                         {
-                            text.replace(QString("%1::").arg(names.at(i)), "");
+                            text += GetTab(level) + "public:\r\n";
                         }
                     }
+
+                    break;
                 }
             }
-        }
-    }
-    else
-    {
-        if (parentClassName.length() == 0)
-        {
-            text = text.mid(text.lastIndexOf("::") + 2);
-        }
-        else
-        {
-            if (parentClassName.contains("<"))
-            {
-                int length = parentClassName.length();
-                int indexOfOperator = 0;
-                int temp = 0;
 
-                for (int i = 0; i < length; i++)
-                {
-                    temp = parentClassName.indexOf("::", temp + 1);
+            GetElementInfo(&element->children[i], text, level + 1);
 
-                    if (temp == -1)
-                    {
-                        break;
-                    }
+            if (!(element->children.at(i).elementType == ElementType::functionType &&
+                element->children.at(i).function->isVariadic &&
+                options->useTemplateFunction))
+            {
+                text += ";";
+            }
 
-                    QString leftSide = parentClassName.mid(0, temp);
-                    QString rightSide = parentClassName.mid(temp);
+            AddComments(element, text, i);
 
-                    if (leftSide.count('<') == leftSide.count('>') && rightSide.count('<') == rightSide.count('>'))
-                    {
-                        indexOfOperator = temp;
-                    }
-                }
+            if (element->children[i].elementType == ElementType::udtType &&
+                element->children[i].udt->correctAlignment < element->children[i].udt->defaultAlignment)
+            {
+                text += QString("\r\n\r\n%1#pragma pack(pop)").arg(GetTab(level + 1));
+            }
 
-                if (indexOfOperator > 0)
-                {
-                    text.replace(parentClassName.mid(0, indexOfOperator + 2), "");
-                    text.replace(QString("%1::").arg(parentClassName.mid(indexOfOperator + 2)), "");
+            AddAdditionalNewLine(element, text, i);
 
-                    QStringList list = text.split("::");
-                    int count = list.count();
+            text += "\r\n";
+        }
+    }
 
-                    for (int i = 0; i < count; i++)
-                    {
-                        if (!list.at(i).contains("<"))
-                        {
-                            text.replace(QString("%1::").arg(list.at(i)), "");
-                        }
-                    }
-                }
-            }
-            else
-            {
-                QList<QString> names = parentClassName.split("::");
-                int count = names.count();
+    text += GetTab(level) + "}";
 
-                for (int i = 0; i < count; i++)
-                {
-                    text.replace(QString("%1::").arg(names.at(i)), "");
-                }
-            }
-        }
+    if (element->elementType == ElementType::dataType &&
+        element->data->hasChildren &&
+        element->data->name.length() > 0)
+    {
+        text += GetDataInfo(&*element->data, level);
     }
 }
 
-bool PDB::CheckIfInnerUDTBelongsToMainUDT(Element* element, Element* innerUDT)
+QString PDB::GetElementInfo(Element* element, int level)
 {
-    bool belongsToMainUDT = false;
-    int baseClassChildrenCount = innerUDT->baseClassChildren.count();
-    int enumChildrenCount = innerUDT->enumChildren.count();
-    int udtClassChildrenCount = innerUDT->udtChildren.count();
-    int dataClassChildrenCount = innerUDT->dataChildren.count();
-    int staticDataClassChildrenCount = innerUDT->staticDataChildren.count();
-    int virtualFunctionChildrenCount = innerUDT->virtualFunctionChildren.count();
-    int nonVirtualFunctionChildrenCount = innerUDT->nonVirtualFunctionChildren.count();
+    TextBuilder text;
 
-    /*
-    * Use contains instead of startsWith because when startsWith is used then
-    * checkIfInnerUDTBelongsToMainUDT function won't always return correct result
-    */
+    GetElementInfo(element, text, level);
 
-    for (int i = 0; i < baseClassChildrenCount; i++)
+    return text.ToString();
+}
+
+void PDB::GetElementInfo(Element* element, TextBuilder& text, int level)
+{
+    ResolutionContext* context = GetResolutionContext();
+    //Pragmas and includes which are placed before code of type are known only when code is generated
+    TextBuilder elementText;
+    TextBuilder& code = level == 0 ? elementText : text;
+    ElementType elementType = element->elementType;
+    bool isParentClass = false, isParentNamespace = false;
+
+    if (level == 0)
     {
-        if (innerUDT->baseClassChildren.at(i).baseClass.parentClassName.contains(element->udt.name))
-        {
-            belongsToMainUDT = true;
+        QString typeName;
+        bool isNested = false;
 
-            break;
+        if (element->elementType == ElementType::udtType)
+        {
+            typeName = element->udt->name;
+            isNested = element->udt->isNested;
+        }
+        else
+        {
+            typeName = element->enum1->name;
+            isNested = element->enum1->isNested;
         }
-    }
 
-    for (int i = 0; i < enumChildrenCount; i++)
-    {
-        if (innerUDT->enumChildren.at(i).enum1.parentClassName.contains(element->udt.name))
+        if (typeName.contains("::"))
         {
-            belongsToMainUDT = true;
+            QString parentClassName = GetParentClassName(typeName);
 
-            break;
+            if (parentClassName.length() > 0)
+            {
+                auto it = diaSymbols->find(parentClassName);
+
+                if (it == diaSymbols->end())
+                {
+                    if (isNested)
+                    {
+                        code += QString("class %1\r\n{\r\npublic:\r\n").arg(parentClassName);
+
+                        isParentClass = true;
+                    }
+                    else
+                    {
+                        code += QString("namespace %1\r\n{\r\n").arg(parentClassName);
+
+                        isParentNamespace = true;
+                    }
+                }
+            }
         }
     }
 
-    for (int i = 0; i < udtClassChildrenCount; i++)
+    if (element->elementType == ElementType::dataType &&
+        element->data->hasChildren)
     {
-        if (innerUDT->udtChildren.at(i).udt.parentClassName.contains(element->udt.name))
+        if (element->data->isTypeNameOfEnum)
         {
-            belongsToMainUDT = true;
-
-            break;
+            elementType = ElementType::enumType;
+        }
+        else
+        {
+            elementType = ElementType::udtType;
         }
     }
 
-    for (int i = 0; i < dataClassChildrenCount; i++)
+    switch (elementType)
+    {
+    case ElementType::enumType:
     {
-        if (innerUDT->dataChildren.at(i).data.parentClassName.contains(element->udt.name))
+        if (level == 0 && (isParentClass || isParentNamespace))
         {
-            belongsToMainUDT = true;
-
-            break;
+            code += GetEnumInfo(const_cast<Element*>(element), level + 1);
+        }
+        else
+        {
+            code += GetEnumInfo(const_cast<Element*>(element), level);
         }
-    }
 
-    for (int i = 0; i < staticDataClassChildrenCount; i++)
+        break;
+    }
+    case ElementType::udtType:
     {
-        if (innerUDT->staticDataChildren.at(i).data.parentClassName.contains(element->udt.name))
-        {
-            belongsToMainUDT = true;
+		/*if (options->declareFunctionsForStaticVariables)
+		{
+			declareFunctionsForStaticVariables(element);
+		}*/
 
-            break;
+        if (level == 0 && (isParentClass || isParentNamespace))
+        {
+            GetUDTInfo(element, code, level + 1);
+        }
+        else
+        {
+            GetUDTInfo(element, code, level);
         }
+
+        break;
     }
+    case ElementType::dataType:
+    {
+        code += GetDataInfo(&*element->data, level);
 
-    for (int i = 0; i < virtualFunctionChildrenCount; i++)
+        break;
+    }
+    case ElementType::functionType:
     {
-        if (innerUDT->virtualFunctionChildren.at(i).function.parentClassName.contains(element->udt.name))
-        {
-            belongsToMainUDT = true;
+        code += GetFunctionInfo(const_cast<Element*>(element), level);
 
-            break;
-        }
+        break;
     }
+    case ElementType::typedefType:
+    {
+        code += GetTab(level) + element->typeDef->declaration;
 
-    for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
+        break;
+    }
+    }
+
+    if (level == 0)
     {
-        if (innerUDT->nonVirtualFunctionChildren.at(i).function.parentClassName.contains(element->udt.name))
+        code += ";\r\n";
+
+        if (isParentClass)
         {
-            belongsToMainUDT = true;
+            code += "};\r\n";
+        }
+        else if (isParentNamespace)
+        {
+            code += "}\r\n";
+        }
 
-            break;
+        bool isPragmaPackNeeded = element->udt->correctAlignment < element->udt->defaultAlignment;
+
+        if (isPragmaPackNeeded)
+        {
+            code += "\r\n#pragma pack(pop)\r\n";
         }
-    }
 
-    if (baseClassChildrenCount == 0 &&
-        enumChildrenCount == 0 &&
-        udtClassChildrenCount == 0 &&
-        dataClassChildrenCount == 0 &&
-        staticDataClassChildrenCount == 0 &&
-        virtualFunctionChildrenCount == 0 &&
-        nonVirtualFunctionChildrenCount == 0)
-    {
-        if (innerUDT->udt.parentClassName.contains(element->udt.name))
+        if (isPragmaPackNeeded)
         {
-            belongsToMainUDT = true;
+            text += QString("#pragma once\r\n\r\n#pragma pack(push, %1)\r\n\r\n").arg(element->udt->correctAlignment);
+        }
+        else
+        {
+            text += "#pragma once\r\n\r\n";
         }
-    }
 
-    return belongsToMainUDT;
+        if (element->elementType == ElementType::udtType && element->udt->includes.count() > 0)
+        {
+            text += QString("%1\r\n\r\n").arg(element->udt->includes.values().join("\r\n"));
+        }
+
+        text += elementText;
+
+        context->vTableIndices.clear();
+        parentClassName.clear();
+    }
 }
 
-QString PDB::GetParentClassName(const QString& typeName)
+QString PDB::GetDataInfo(const Data* data, int level)
 {
-    QString parentClassName;
+    QString text;
+    QString declaration = data->declaration;
 
-    if (typeName.contains("<"))
+    if (!options->includeConstKeyword)
     {
-        int length = typeName.length();
-        int indexOfOperator = 0;
-        int temp = 0;
+        //This checks are needed in case of templates
 
-        for (int i = 0; i < length; i++)
+        if (declaration.contains(", const"))
         {
-            temp = typeName.indexOf("::", temp + 1);
-
-            if (temp == -1)
-            {
-                break;
-            }
-
-            QString leftSide = typeName.mid(0, temp);
-            QString rightSide = typeName.mid(temp);
-
-            if (leftSide.count('<') == leftSide.count('>') && rightSide.count('<') == rightSide.count('>'))
-            {
-                indexOfOperator = temp;
-            }
+            declaration.replace(" const", " ");
         }
-
-        if (indexOfOperator > 0)
+        else if (declaration.contains(" const"))
+        {
+            declaration.replace(" const", "");
+        }
+        else if (declaration.contains("const "))
         {
-            parentClassName = typeName.mid(0, indexOfOperator);
+            declaration.replace("const ", "");
         }
     }
+
+	if (!options->includeVolatileKeyword)
+	{
+        //This checks are needed in case of templates
+
+		if (declaration.contains(", volatile"))
+		{
+			declaration.replace(" volatile", " ");
+		}
+		else if (declaration.contains(" volatile"))
+		{
+			declaration.replace(" volatile", "");
+		}
+		else if (declaration.contains("volatile "))
+		{
+			declaration.replace("volatile ", "");
+		}
+	}
+
+    if (data->hasChildren)
+    {
+        text += declaration;
+    }
     else
     {
-        parentClassName = typeName.mid(0, typeName.lastIndexOf("::"));
+        text += GetTab(level) + declaration;
     }
 
-    return parentClassName;
+    if (data->value.isValid)
+    {
+        text += QString(" = %1").arg(data->value.value.toString());
+    }
+
+    return text;
 }
 
-QString PDB::GetParentClassName(Element* element)
+QString PDB::GetFunctionInfo(const Element* element, int level)
 {
-    QString parentClassName;
-    int baseClassChildrenCount = element->baseClassChildren.count();
-    int enumChildrenCount = element->enumChildren.count();
-    int udtClassChildrenCount = element->udtChildren.count();
-    int dataClassChildrenCount = element->dataChildren.count();
-    int staticDataClassChildrenCount = element->staticDataChildren.count();
-    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
-    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
+    QString text;
 
-    if (baseClassChildrenCount > 0)
+    if (element->function->isVariadic && options->useTemplateFunction)
     {
-        parentClassName = element->baseClassChildren.at(0).baseClass.parentClassName;
+        text += ImplementVariadicTemplateFunction(element, level);
     }
-
-    if (enumChildrenCount > 0)
+    else
     {
-        parentClassName = element->enumChildren.at(0).enum1.parentClassName;
+        text += GetTab(level) + element->function->prototype;
     }
 
-    if (udtClassChildrenCount > 0)
-    {
-        parentClassName = element->udtChildren.at(0).udt.parentClassName;
-    }
+    return text;
+}
 
-    if (dataClassChildrenCount > 0)
-    {
-        parentClassName = element->dataChildren.at(0).data.parentClassName;
-    }
+Data PDB::ConvertRecordTypeToData(const RecordType* recordType)
+{
+    Data data = {};
 
-    if (staticDataClassChildrenCount > 0)
-    {
-        parentClassName = element->staticDataChildren.at(0).data.parentClassName;
-    }
+    data.baseType = recordType->baseType;
+    data.isTypeConst = recordType->isTypeConst;
+    data.isTypeVolatile = recordType->isTypeVolatile;
+    data.isPointerConst = recordType->isPointerConst;
+    data.isPointerVolatile = recordType->isPointerVolatile;
+    data.typeName = recordType->typeName;
+    data.originalTypeName = recordType->originalTypeName;
+    data.size = recordType->size;
+    data.isPointer = recordType->isPointer;
+    data.isReference = recordType->isReference;
+    data.pointerLevel = recordType->pointerLevel;
+    data.referenceLevel = recordType->referenceLevel;
+    data.isArray = recordType->isArray;
+    data.arrayCount = recordType->arrayCount;
+    data.functionReturnType = recordType->functionReturnType2;
+    data.functionParameters = recordType->functionParameters;
+    data.isVariadicFunction = recordType->isVariadicFunction;
+    data.callingConvention = recordType->callingConvention;
+    data.isFunctionPointer = recordType->isFunctionPointer;
+    data.noType = recordType->noType;
 
-    if (virtualFunctionChildrenCount > 0)
-    {
-        parentClassName = element->virtualFunctionChildren.at(0).function.parentClassName;
-    }
+    return data;
+}
 
-    if (nonVirtualFunctionChildrenCount > 0)
+void PDB::GetTemplateIncludes(const QString& templateTypeName, const QString& parentClassName)
+{
+    QStringList typeNames;
+
+    TypeName::Parse(templateTypeName)->GetReferencedTypeNames(typeNames);
+
+    int count = typeNames.count();
+
+    for (int i = 0; i < count; i++)
     {
-        parentClassName = element->nonVirtualFunctionChildren.at(0).function.parentClassName;
+        if (typeNames.at(i).length() > 1)
+        {
+            AddTypeNameToIncludesList(typeNames.at(i), parentClassName);
+        }
     }
-
-    return parentClassName;
 }
 
-bool PDB::CheckIfPublicKeywordShouldBeAdded(const Element* element)
+bool PDB::CheckIfNameOfMainOrInnerUDT(const QString& typeName, const QString& parentClassName)
 {
-    bool addPublicKeyword = false;
-    int dataChildrenCount = element->dataChildren.count();
-    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
-    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
+    bool isNameOfMainOrInnerUDT = false;
 
-    if (element->enumChildren.count() > 0 ||
-        element->udtChildren.count() ||
-        element->typedefChildren.count() > 0 &&
-        options->displayTypedefs ||
-        element->staticDataChildren.count() > 0)
-    {
-        addPublicKeyword = true;
-    }
-    else
+    if (parentClassName.contains("::"))
     {
-        for (int i = 0; i < dataChildrenCount; i++)
+        QSharedPointer<const TypeName> parentTypeName = TypeName::Parse(parentClassName);
+        const QVector<TypeNameScope>& scopes = parentTypeName->GetScopes();
+        int count = scopes.count();
+
+        if (parentClassName.contains("<"))
         {
-            if (element->dataChildren.at(i).data.isCompilerGenerated)
+            for (int i = 0; i < count - 1; i++)
             {
-                if (!options->displayVTablePointerIfExists &&
-                    element->dataChildren.at(i).data.isVTablePointer ||
-                    !element->dataChildren.at(i).data.isPadding &&
-                    options->displayPaddingBytes)
+                if (typeName.startsWith(parentClassName.mid(0, parentTypeName->GetScopeSeparatorIndex(i))))
                 {
-                    addPublicKeyword = false;
-                }
-            }
-            else
-            {
-                addPublicKeyword = true;
+                    isNameOfMainOrInnerUDT = true;
 
-                break;
+                    break;
+                }
             }
         }
-
-        for (int i = 0; i < virtualFunctionChildrenCount; i++)
+        else
         {
-            if (element->virtualFunctionChildren.at(i).function.isNonImplemented)
+            for (int i = 0; i < count; i++)
             {
-                if (!options->displayNonImplementedFunctions)
+                if (typeName.startsWith(scopes.at(i).name))
                 {
-                    addPublicKeyword = false;
-                }
-            }
-            else
-            {
-                addPublicKeyword = true;
+                    isNameOfMainOrInnerUDT = true;
 
-                break;
+                    break;
+                }
             }
         }
-
-        for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
+    }
+    else
+    {
+        if (typeName.contains("::") && typeName.startsWith(parentClassName))
         {
-            if (element->nonVirtualFunctionChildren.at(i).function.isNonImplemented)
-            {
-                if (!options->displayNonImplementedFunctions)
-                {
-                    addPublicKeyword = false;
-                }
-            }
-            else
-            {
-                addPublicKeyword = true;
-
-                break;
-            }
+            isNameOfMainOrInnerUDT = true;
+        }
+        else if (typeName == parentClassName)
+        {
+            isNameOfMainOrInnerUDT = true;
         }
     }
 
-    return addPublicKeyword;
+    return isNameOfMainOrInnerUDT;
 }
 
-bool PDB::CheckIfHasAnyEmptyBaseClass(const Element* element)
+void PDB::AddTypeNameToIncludesList(const QString& typeName, const QString& parentClassName)
 {
-    int baseClassChildrenCount = element->baseClassChildren.count();
+    ResolutionContext* context = GetResolutionContext();
+    QString name = typeName;
 
-    for (int i = 0; i < baseClassChildrenCount; i++)
+    if (name.contains("<"))
     {
-        if (element->baseClassChildren.at(i).dataChildren.count() == 1)
-		{
-            if (element->baseClassChildren.at(i).dataChildren.at(0).data.isEndPadding)
-			{
-                return true;
-			}
-		}
+        GetTemplateIncludes(name, parentClassName);
     }
-
-    return false;
-}
-
-bool PDB::CheckIfRVOIsAppliedToFunction(IDiaSymbol* symbol)
-{
-    bool isRVOApplied = false;
-    DWORD symTag = 0;
-
-    if (symbol->get_symTag(&symTag) == S_OK && symTag == SymTagUDT)
+    else
     {
-		ULONGLONG size;
+        if (name.contains("::"))
+        {
+            name = name.mid(0, name.indexOf("::"));
+        }
 
-		if (symbol->get_length(&size) == S_OK)
-		{
-			isRVOApplied = size > 8;
-		}
+        QHash<QString, quint32>::const_iterator it = baseTypes.find(name);
 
-		if (!isRVOApplied)
-		{
-            /*
-            * This is case of small UDT which possibly fits into a register (or two)
-            * but it has to be a POD for that (it shouldn't have constructor or assignment operators)
-            */
-            BOOL hasConstructor = 0, hasAssignmentOperator = 0, hasCastOperator = 0;
+        if (name.length() > 1 &&
+            it == baseTypes.end() &&
+            !CheckIfNameOfMainOrInnerUDT(name, parentClassName))
+        {
+            QString include = QString("#include \"%1.h\"").arg(name);
 
-			if (symbol->get_constructor(&hasConstructor) == S_OK && hasConstructor ||
-				symbol->get_hasAssignmentOperator(&hasAssignmentOperator) == S_OK && hasAssignmentOperator ||
-				symbol->get_hasCastOperator(&hasCastOperator) == S_OK && hasCastOperator)
-			{
-				isRVOApplied = true;
-			}
-		}
+            context->includes.insert(include);
+        }
     }
-
-    return isRVOApplied;
 }
 
-void PDB::DeclareFunctionsForStaticVariables(Element* element)
+void PDB::AddComments(const Element* element, TextBuilder& text, int i)
 {
-    int staticDataChildrenCount = element->staticDataChildren.count();
-    Element newElement;
-
-    for (int i = 0; i < staticDataChildrenCount; i++)
+    if (!options->displayComments)
     {
-        newElement = CreateGetter(element, i);
-
-        element->nonVirtualFunctionChildren.append(newElement);
+        return;
     }
 
-	for (int i = 0; i < staticDataChildrenCount; i++)
-	{
-        newElement = CreateSetter(element, i);
-
-		element->nonVirtualFunctionChildren.append(newElement);
-	}
-}
-
-void PDB::ImplementFunctionsForStaticVariables(const Element* element, QString& cppCode)
-{
-    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
-    static const DataOptions dataOptions = { true, false };
-    static const FunctionOptions functionOptions = { true, false, false, true };
-    int n = 0;
-    Element element2;
-
-    for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
+    if (element->children.at(i).elementType == ElementType::dataType)
     {
-        if (element->nonVirtualFunctionChildren.at(i).function.isStatic &&
-            element->nonVirtualFunctionChildren.at(i).function.isGeneratedByApp)
+		DWORD relativeVirtualAddress, fileOffset;
+		QString relativeVirtualAddress2, fileOffset2;
+
+        if (element->children.at(i).data->dataKind == DataIsStaticMember)
         {
-            element2 = element->nonVirtualFunctionChildren.at(i);
+            relativeVirtualAddress = element->children.at(i).data->relativeVirtualAddress;
+            fileOffset = peHeaderParser->ConvertRVAToFileOffset(relativeVirtualAddress);
 
-            QString type;
-            QString offset;
-			QString functionPrototype = FunctionTypeToString(const_cast<Element*>(&element2), &functionOptions);
-			QString baseAddressVariableName = GetBaseAddressVariableName();
+            relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
+            fileOffset2 = QString::number(fileOffset, 16).toUpper();
 
-            //DWORD offset = element->staticDataChildren.at(n++).data.relativeVirtualAddress;
+            text += QString(" //Offset = 0x%1, File Offset = 0x%2").arg(relativeVirtualAddress2).arg(fileOffset2);
+        }
+        else
+        {
+            relativeVirtualAddress = element->children.at(i).offset;
+            relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
 
-            //CHANGE OFFSET NUMBERS TO BE UPPERCASE
+            text += QString(" //Offset = 0x%1").arg(relativeVirtualAddress2);
+        }
 
-            if (n == element->staticDataChildren.count())
-            {
-                n = 0;
-            }
+        DWORD size = element->children.at(i).size;
+        QString size2 = QString::number(size, 16).toUpper();
 
-            cppCode += QString("%1\r\n{\r\n\t").arg(functionPrototype);
+        text += QString(" Size = 0x%2").arg(size2);
 
-            if (element2.function.returnType1.baseType == 1)
-            {
-                Data dataType = element2.dataChildren.at(0).data;
+		if (element->children.at(i).numberOfBits > 0)
+		{
+            DWORD bitOffset = element->children.at(i).bitOffset;
+			QString bitOffset2 = QString::number(bitOffset, 16).toUpper();
 
-                if (!element->staticDataChildren.at(n++).data.isTypeConst)
-                {
-                    dataType.isTypeConst = false;
-                }
+            DWORD numberOfBits = element->children.at(i).numberOfBits;
+			QString numberOfBits2 = QString::number(numberOfBits, 16).toUpper();
 
-                type = DataTypeToString(&dataType, &dataOptions);
-                offset = QString::number(element2.dataChildren.at(0).data.relativeVirtualAddress, 16).toUpper();
-
-                cppCode += "*";
-
-				if (element2.dataChildren.at(0).data.isPointer)
-				{
-					cppCode += QString("reinterpret_cast<%1>").arg(type);
-				}
-				else
-				{
-					cppCode += QString("reinterpret_cast<%1*>").arg(type);
-				}
+            text += QString(" BitOffset = 0x%1, Number Of Bits = 0x%2").arg(bitOffset2).arg(numberOfBits2);
+		}
+    }
+    else if (element->children.at(i).elementType == ElementType::functionType)
+    {
+        DWORD relativeVirtualAddress = element->children.at(i).function->relativeVirtualAddress;
+        QString relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
 
-                cppCode += QString("(BaseAddresses::%2 + 0x%3) = ").arg(baseAddressVariableName).arg(offset);
+        DWORD fileOffset = peHeaderParser->ConvertRVAToFileOffset(relativeVirtualAddress);
+        QString fileOffset2 = QString::number(fileOffset, 16).toUpper();
 
-                if (element2.dataChildren.at(0).data.isPointer)
-                {
-                    cppCode += "*";
-                }
+        if (element->children.at(i).function->isVirtual)
+        {
+            int vTableIndex = element->children.at(i).function->virtualBaseOffset >> 2;
+            QString indexOfVTable = QString::number(element->children.at(i).function->indexOfVTable);
 
-                cppCode += QString("%1").arg(element2.dataChildren.at(0).data.name);
+            if (element->children.at(i).function->indexOfVTable == 0)
+            {
+                indexOfVTable.append(" (Main VTable)");
             }
             else
             {
-                type = element->nonVirtualFunctionChildren.at(i).function.returnType2;
-                offset = QString::number(element->nonVirtualFunctionChildren.at(i).function.returnType1.relativeVirtualAddress, 16)
-                    .toUpper();
-
-                cppCode += "return ";
-
-                if (element2.function.returnType1.isPointer)
-                {
-                    cppCode += QString("reinterpret_cast<%1>").arg(type);
-                }
-                else
-                {
-                    cppCode += QString("*reinterpret_cast<%1*>").arg(type);
-                }
+                QString vTableName = element->udt->vTableNames[element->children.at(i).function->indexOfVTable];
 
-                cppCode += QString("(BaseAddresses::%2 + 0x%3)").arg(baseAddressVariableName).arg(offset);
+                indexOfVTable.append(QString(" (%1)").arg(vTableName));
             }
 
-            cppCode += ";\r\n}\r\n\r\n";
+            text += QString(" //Index = %1, Index Of VTable = %2, Offset = 0x%3, File Offset = 0x%4").arg(vTableIndex)
+                .arg(indexOfVTable).arg(relativeVirtualAddress2).arg(fileOffset2);
+        }
+        else
+        {
+            text += QString(" //Offset = 0x%1, File Offset = 0x%2").arg(relativeVirtualAddress2).arg(fileOffset2);
         }
     }
 }
 
-Element PDB::CreateGetter(Element* element, const int i)
-{
-    static const DataOptions dataOptions = { true, false };
-    static const FunctionOptions functionOptions;
-
-    QString name = RemoveHungarianNotationFromVariable(element->staticDataChildren.at(i).data.name);
-	Element newElement = {};
-
-    newElement.elementType = ElementType::functionType;
-    newElement.function.returnType1 = element->staticDataChildren.at(i).data;
-    newElement.function.returnType1.dataKind = DataIsUnknown;
-
-	if (newElement.function.returnType1.isArray)
-	{
-		newElement.function.returnType1.isArray = false;
-		newElement.function.returnType1.isPointer = true;
-		newElement.function.returnType1.pointerLevel = 1;
-	}
-
-    QString type = DataTypeToString(&newElement.function.returnType1, &dataOptions);
-
-    newElement.function.returnType2 = type;
-
-	if (name.contains("_"))
-	{
-		newElement.function.name = QString("Get%1").arg(ConvertSnakeCaseToPascalCase(name));
-	}
-	else
-	{
-		newElement.function.name = QString("Get%1").arg(ConvertCamelCaseToPascalCase(name));
-	}
-
-	newElement.function.isStatic = true;
-	newElement.function.callingConvention = CV_CALL_THISCALL;
-	newElement.function.isGeneratedByApp = true;
-	newElement.function.access = CV_public;
-	newElement.function.parentClassName = GetParentClassName(element);
-	newElement.function.prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
-
-    return newElement;
-}
-
-Element PDB::CreateSetter(Element* element, const int i)
+void PDB::AddAdditionalNewLine(const Element* element, TextBuilder& text, int i)
 {
-    static const DataOptions dataOptions = { true, false };
-    static const FunctionOptions functionOptions;
-
-    QString name = RemoveHungarianNotationFromVariable(element->staticDataChildren.at(i).data.name);
-    Element newElement = {};
-
-    newElement.elementType = ElementType::functionType;
-    newElement.function.returnType1.baseType = 1;
-    newElement.function.returnType2 = "void";
+    bool addNewLine = false;
+    int childrenCount = element->children.count();
 
-    if (name.contains("_"))
-    {
-        newElement.function.name = QString("Set%1").arg(ConvertSnakeCaseToPascalCase(name));
-    }
-    else
+    if (element->children.at(i).elementType == ElementType::udtType ||
+        element->children.at(i).elementType == ElementType::enumType)
     {
-        newElement.function.name = QString("Set%1").arg(ConvertCamelCaseToPascalCase(name));
-    }
-
-    newElement.function.isStatic = true;
-    newElement.function.callingConvention = CV_CALL_THISCALL;
-    newElement.function.isGeneratedByApp = true;
-    newElement.function.access = CV_public;
-    newElement.function.parentClassName = GetParentClassName(element);
-
-    Element parameterElement = {};
+        if (i + 1 < childrenCount)
+        {
+            if (element->children.at(i + 1).elementType == ElementType::udtType ||
+                element->children.at(i + 1).elementType == ElementType::enumType ||
+                element->children.at(i + 1).elementType == ElementType::typedefType &&
+                options->displayTypedefs)
+            {
+                addNewLine = true;
+            }
+            else if (element->children.at(i + 1).elementType == ElementType::dataType)
+            {
+                for (int j = i + 1; j < childrenCount; j++)
+                {
+                    if (element->children.at(j).elementType == ElementType::dataType)
+                    {
+                        if (element->children.at(j).data->isCompilerGenerated)
+                        {
+                            if (options->displayVTablePointerIfExists &&
+                                element->children.at(j).data->isVTablePointer ||
+                                element->children.at(j).data->isPadding &&
+                                options->displayPaddingBytes)
+                            {
+                                addNewLine = true;
 
-    parameterElement.elementType = ElementType::dataType;
-    parameterElement.data = element->staticDataChildren.at(i).data;
-    //parameterElement.data.name = element->staticDataChildren.at(i).data.name;
-    //parameterElement.data.typeName = element->staticDataChildren.at(i).data.typeName;
-    //parameterElement.data.isPointer = true;
-    //parameterElement.data.pointerLevel = 1;
-    parameterElement.data.isTypeConst = true;
-    parameterElement.data.dataKind = DataIsParam;
+                                break;
+                            }
+                        }
+                        else
+                        {
+                            addNewLine = true;
 
-    if (name.contains("_"))
-    {
-        parameterElement.data.name = ConvertSnakeCaseToCamelCase(name);
-    }
-    else
-    {
-        parameterElement.data.name = ConvertPascalCaseToCamelCase(name);
-    }
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
 
-    if (element->staticDataChildren.at(i).data.isArray)
-    {
-        parameterElement.data.isArray = false;
-        parameterElement.data.isPointer = true;
-        parameterElement.data.pointerLevel = 1;
+                //In case there is only padding between inner type and function which shouldn't be displayed
+                if (!addNewLine)
+                {
+                    addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+                }
+            }
+            else if (element->children.at(i + 1).elementType == ElementType::functionType)
+            {
+                addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+            }
+        }
     }
-
-    QString type = DataTypeToString(&parameterElement.data, &dataOptions);
-
-    newElement.dataChildren.append(parameterElement);
-    newElement.function.parameters.append(type);
-
-    newElement.function.prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
-
-    return newElement;
-}
-
-ULONGLONG PDB::GetFunctionSize(DWORD relativeVirtualAddress)
-{
-    ULONGLONG size = 0;
-    IDiaEnumSymbolsByAddr* enumSymbolsByAddr = nullptr;
-    IDiaSymbol* symbol = nullptr;
-
-    if (SUCCEEDED(diaSession->getSymbolsByAddr(&enumSymbolsByAddr)))
+    else if (element->children.at(i).elementType == ElementType::typedefType)
     {
-		if (SUCCEEDED(enumSymbolsByAddr->symbolByRVA(relativeVirtualAddress, &symbol)))
-		{
-            symbol->get_length(&size);
-		}
-    }
+        if (options->displayTypedefs && i < childrenCount - 1)
+        {
+            if (element->children.at(i + 1).elementType == ElementType::dataType)
+            {
+                for (int j = i + 1; j < childrenCount; j++)
+                {
+                    if (element->children.at(j).elementType == ElementType::dataType)
+                    {
+                        if (element->children.at(j).data->isCompilerGenerated)
+                        {
+                            if (options->displayVTablePointerIfExists &&
+                                element->children.at(j).data->isVTablePointer ||
+                                element->children.at(j).data->isPadding &&
+                                options->displayPaddingBytes)
+                            {
+                                addNewLine = true;
 
-    return size;
-}
+                                break;
+                            }
+                        }
+                        else
+                        {
+                            addNewLine = true;
 
-void PDB::CheckIfDefaultCtorAndDtorAdded(Element* element)
-{
-    /*
-    * Compiler doesn't generate virtual destructor for base class.
-    * If base class has virtual destructor but child class doesn't have it then it will be generated.
-    * Compiler generated virtual destructor is always placed at the end of vTable.
-    * __vecDelDtor is not counted in countOfVirtualFunctions
-    */
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
 
-    if (element->elementType == ElementType::enumType ||
-        element->elementType == ElementType::udtType &&
-        element->udt.isUnnamed)
-    {
-        return;
+                if (!addNewLine)
+                {
+                    addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+                }
+            }
+            else if (element->children.at(i + 1).elementType == ElementType::functionType)
+            {
+                addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+            }
+        }
     }
-
-    if (options->addDefaultCtorAndDtorToUDT)
+    else if (element->children.at(i).elementType == ElementType::dataType &&
+        element->children.at(i).data->dataKind != DataIsStaticMember)
     {
-        if (!element->udt.hasDefaultConstructor)
-        {
-            AddDefaultConstructor(element);
-        }
-
-        if (element->udt.hasVTable)
+        if (i == 0 && element->children.at(i).data->isCompilerGenerated)
         {
-            if (!element->udt.hasVirtualDestructor)
+            if (options->displayVTablePointerIfExists &&
+                element->children.at(i).data->isVTablePointer ||
+                element->children.at(i).data->isPadding &&
+                options->displayPaddingBytes) //Only end align can appear as first data member
             {
-                AddVirtualDestructor(element);
+                addNewLine = true;
             }
         }
-        else
+        else if (i > 0 &&
+            element->children.at(i - 1).elementType == ElementType::baseClassType &&
+            element->children.at(i).data->isCompilerGenerated)
         {
-            if (!element->udt.hasDestructor)
+            if (options->displayVTablePointerIfExists &&
+                element->children.at(i).data->isVTablePointer ||
+                element->children.at(i).data->isPadding &&
+                options->displayPaddingBytes)
             {
-                AddDestructor(element);
+                addNewLine = true;
             }
         }
-    }
-}
-
-void PDB::AddDefaultConstructor(Element* element)
-{
-    Element newElement = {};
+        else if (i < childrenCount - 1)
+        {
+            if (element->children.at(i + 1).elementType == ElementType::dataType &&
+                element->children.at(i + 1).data->dataKind == DataIsStaticMember)
+            {
+                /*if (element->children.at(i).data->isCompilerGenerated)
+                {
+                    if (options->displayVTablePointerIfExists &&
+                        element->children.at(i).data->isVTablePointer ||
+                        element->children.at(i).data->isPadding &&
+                        options->displayPaddingBytes)
+                    {
+                        addNewLine = true;
+                    }
+                }
+                else
+                {
+                    addNewLine = true;
+                }*/
 
-    newElement.function.name = element->udt.name;
-    newElement.function.callingConvention = CV_CALL_THISCALL;
-    newElement.function.isGeneratedByApp = true;
-    newElement.function.isDefaultConstructor = true;
-    newElement.function.access = CV_public;
-    newElement.function.returnType1.baseType = 1;
-    newElement.function.parentClassName = GetParentClassName(element);
-    newElement.elementType = ElementType::functionType;
+                if (i > 0 &&
+                    (element->children.at(i - 1).elementType == ElementType::dataType &&
+                        element->children.at(i - 1).data->hasChildren ||
+                        element->children.at(i - 1).elementType != ElementType::dataType) &&
+                    element->children.at(i).data->isCompilerGenerated)
+                {
+                    if (options->displayVTablePointerIfExists &&
+                        element->children.at(i).data->isVTablePointer ||
+                        element->children.at(i).data->isPadding &&
+                        options->displayPaddingBytes)
+                    {
+                        addNewLine = true;
+                    }
+                }
+                else
+                {
+                    addNewLine = true;
+                }
+            }
+            else if (element->children.at(i + 1).elementType == ElementType::functionType)
+            {
+                /*
+                * In this case new line is already added after udt or enum type so another new line shouldn't be added
+                * if option for displaying padding isn't enabled
+                */
+                if (i > 0 &&
+                    (element->children.at(i - 1).elementType == ElementType::dataType &&
+                        element->children.at(i - 1).data->hasChildren ||
+                        element->children.at(i - 1).elementType != ElementType::dataType) &&
+                    element->children.at(i).data->isCompilerGenerated)
+                {
+                    if (options->displayVTablePointerIfExists &&
+                        element->children.at(i).data->isVTablePointer ||
+                        element->children.at(i).data->isPadding &&
+                        options->displayPaddingBytes)
+                    {
+                        addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+                    }
+                }
+                else
+                {
+                    addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+                }
 
-    static const FunctionOptions functionOptions;
+                //addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+            }
+            /*else if (element->children.at(i + 1).elementType == ElementType::udtType)
+            {
+                if (element->children.at(i).data->isCompilerGenerated)
+                {
+                    if (options->displayVTablePointerIfExists &&
+                        element->children.at(i).data->isVTablePointer ||
+                        element->children.at(i).data->isPadding &&
+                        options->displayPaddingBytes)
+                    {
+                        addNewLine = true;
+                    }
+                }
+                else
+                {
+                    addNewLine = true;
+                }
+            }*/
+            else if (element->children.at(i).data->hasChildren &&
+                element->children.at(i + 1).elementType == ElementType::dataType)
+            {
+                for (int j = i + 1; j < childrenCount; j++)
+                {
+                    if (element->children.at(j).elementType == ElementType::dataType)
+                    {
+                        if (element->children.at(j).data->isCompilerGenerated)
+                        {
+                            if (options->displayVTablePointerIfExists &&
+                                element->children.at(j).data->isVTablePointer ||
+                                element->children.at(j).data->isPadding &&
+                                options->displayPaddingBytes)
+                            {
+                                addNewLine = true;
+
+                                break;
+                            }
+                        }
+                        else
+                        {
+                            addNewLine = true;
 
-    newElement.function.prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
 
-    if (element->nonVirtualFunctionChildren.count() == 0)
-    {
-        element->nonVirtualFunctionChildren.append(newElement);
+                if (!addNewLine)
+                {
+                    addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+                }
+            }
+            else if (element->children.at(i + 1).elementType == ElementType::dataType &&
+                element->children.at(i + 1).data->hasChildren)
+            {
+                addNewLine = true;
+            }
+        }
     }
-    else
+    else if (element->children.at(i).elementType == ElementType::dataType &&
+        element->children.at(i).data->dataKind == DataIsStaticMember)
     {
-        element->nonVirtualFunctionChildren.insert(0, newElement);
+        if (i < childrenCount - 1)
+        {
+            if (element->children.at(i + 1).elementType == ElementType::functionType)
+            {
+                addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+            }
+            else if (element->children.at(i + 1).elementType == ElementType::dataType &&
+                element->children.at(i + 1).data->hasChildren)
+            {
+                addNewLine = true;
+            }
+        }
     }
-}
-
-void PDB::AddDestructor(Element* element)
-{
-    Element newElement = {};
-
-    newElement.function.name = QString("~%1").arg(element->udt.name);
-    newElement.function.callingConvention = CV_CALL_THISCALL;
-    newElement.function.isGeneratedByApp = true;
-    newElement.function.isDestructor = true;
-    newElement.function.access = CV_public;
-    newElement.function.returnType1.baseType = 1;
-    newElement.function.parentClassName = GetParentClassName(element);
-    newElement.elementType = ElementType::functionType;
-
-    int lastConstructorIndex = -1;
-    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
-
-    for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
+    else if (element->children.at(i).elementType == ElementType::functionType)
     {
-        if (element->nonVirtualFunctionChildren.at(i).function.isConstructor ||
-            element->nonVirtualFunctionChildren.at(i).function.isDefaultConstructor)
+        if (element->children.at(i).function->isVirtual)
         {
-            lastConstructorIndex = i;
+            if (i < childrenCount - 1)
+            {
+                if (element->children.at(i + 1).elementType == ElementType::functionType &&
+                    element->children.at(i + 1).function->isVirtual &&
+                    !element->children.at(i + 1).function->isNonImplemented &&
+                    element->children.at(i + 1).function->indexOfVTable >
+                    element->children.at(i).function->indexOfVTable)
+                {
+                    addNewLine = true;
+                }
+                else if (element->children.at(i + 1).elementType == ElementType::functionType &&
+                    !element->children.at(i + 1).function->isVirtual)
+                {
+                    addNewLine = AddAdditionalNewLineBeforeFunc(element, i);
+                }
+            }
         }
-        else if (lastConstructorIndex != -1)
+        else if (i < childrenCount - 1 &&
+            element->children.at(i + 1).function->isStatic &&
+            element->children.at(i + 1).function->isGeneratedByApp &&
+            !(element->children.at(i).function->isStatic &&
+                element->children.at(i).function->isGeneratedByApp))
         {
-            break;
+            addNewLine = true;
         }
     }
 
-    static const FunctionOptions functionOptions;
-
-    newElement.function.prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
-
-    if (lastConstructorIndex + 1 == nonVirtualFunctionChildrenCount)
-    {
-        element->nonVirtualFunctionChildren.append(newElement);
-    }
-    else
+    if (addNewLine)
     {
-        element->nonVirtualFunctionChildren.insert(lastConstructorIndex + 1, newElement);
+        text += "\r\n";
     }
 }
 
-void PDB::AddVirtualDestructor(Element* element)
+bool PDB::AddAdditionalNewLineBeforeFunc(const Element* element, int i)
 {
-    Element newElement = {};
-
-    newElement.function.name = QString("~%1").arg(element->udt.name);
-    newElement.function.callingConvention = CV_CALL_THISCALL;
-    newElement.function.isGeneratedByApp = true;
-    newElement.function.isVirtual = true;
-    newElement.function.isDestructor = true;
-    newElement.function.access = CV_public;
-    newElement.function.returnType1.baseType = 1;
-    newElement.function.parentClassName = GetParentClassName(element);
-    newElement.elementType = ElementType::functionType;
+    bool addNewLine = true;
 
-    static const FunctionOptions functionOptions;
+    if (element->children.at(i + 1).function->isNonImplemented && !options->displayNonImplementedFunctions)
+    {
+        addNewLine = false;
 
-    newElement.function.prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
+        /*
+        * In case there is function that comes right after last variable but it's offset is 0 and it shouldn't be displayed
+        * then check if there is any other function below with offset different then 0 and
+        * if it there is any then add new line
+        */
 
-    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
+        int count = element->children.count();
 
-    if (virtualFunctionChildrenCount == 0)
-    {
-        newElement.function.virtualBaseOffset = 0;
+        for (int j = i + 2; j < count; j++)
+        {
+            if (element->children.at(j).elementType != ElementType::functionType)
+            {
+                break;
+            }
+            else
+            {
+                if (!element->children.at(j).function->isNonImplemented)
+                {
+                    addNewLine = true;
 
-        element->virtualFunctionChildren.append(newElement);
+                    break;
+                }
+            }
+        }
     }
-    else
+
+    return addNewLine;
+}
+
+void PDB::RemoveScopeResolutionOperators(QString& text, const QString& parentClassName)
+{
+    if (text.contains("<"))
     {
-        //This is not safe because if last virtual function is overriden offset will be 0
-        /*DWORD lastVirtualFunctionBaseOffset = element->virtualFunctionChildren.last().function.virtualBaseOffset;
+        int indexOfOperator = TypeName::Parse(text)->GetLastScopeSeparatorIndex();
 
-        if (type == CV_CFL_80386)
-        {
-            newElement.function.virtualBaseOffset = lastVirtualFunctionBaseOffset + 4;
-        }
-        else
-        {
-            newElement.function.virtualBaseOffset = lastVirtualFunctionBaseOffset + 8;
-        }*/
+        bool removeScopeOperator = false;
 
-        if (type == CV_CFL_80386)
+        if (parentClassName.length() > 0)
         {
-            newElement.function.virtualBaseOffset = (virtualFunctionChildrenCount + 1) * 4;
+            /*if (parentClassName.contains(text.mid(0, indexOfOperator)))
+            {
+                removeScopeOperator = true;
+            }*/
+
+            if (parentClassName.startsWith(text.mid(0, indexOfOperator)))
+            {
+                removeScopeOperator = true;
+            }
         }
         else
         {
-            newElement.function.virtualBaseOffset = (virtualFunctionChildrenCount + 1) * 8;
+            removeScopeOperator = true;
         }
 
-        element->virtualFunctionChildren.append(newElement);
-    }
-}
-
-void PDB::AddCopyConstructor(Element* element)
-{
-    Element newElement = {};
+        if (removeScopeOperator)
+        {
+            if (indexOfOperator > 0)
+            {
+                text.remove(0, indexOfOperator + 2);
+            }
 
-    newElement.function.name = element->udt.name;
-    newElement.function.callingConvention = CV_CALL_THISCALL;
-    newElement.function.isGeneratedByApp = true;
-    newElement.function.isCopyConstructor = true;
-    newElement.function.access = CV_public;
-    newElement.function.returnType1.baseType = 0;
-    newElement.function.parentClassName = GetParentClassName(element);
-    newElement.function.parameters.append(QString("%1&").arg(element->udt.name));
-    newElement.elementType = ElementType::functionType;
+            if (text.contains("::"))
+            {
+                if (parentClassName.length() == 0)
+                {
+                    if (!text.contains("<"))
+                    {
+                        text = text.mid(text.lastIndexOf("::") + 2);
+                    }
+                }
+                else
+                {
+                    if (parentClassName.contains("<"))
+                    {
+                        int indexOfOperator = TypeName::Parse(parentClassName)->GetLastScopeSeparatorIndex();
 
-    Element parameterElement = {};
+                        if (indexOfOperator > 0)
+                        {
+                            text.replace(parentClassName.mid(0, indexOfOperator + 2), "");
+                            text.replace(QString("%1::").arg(parentClassName.mid(indexOfOperator + 2)), "");
 
-    parameterElement.elementType = ElementType::dataType;
-    parameterElement.data.name = "__that";
-    parameterElement.data.typeName = QString("%1&").arg(element->udt.name);
-    parameterElement.data.isReference = true;
-    parameterElement.data.isTypeConst = true;
-    parameterElement.data.dataKind = DataIsParam;
+                            QStringList list = text.split("::");
+                            int count = list.count();
 
-    newElement.dataChildren.append(parameterElement);
+                            for (int i = 0; i < count; i++)
+                            {
+                                if (!list.at(i).contains("<"))
+                                {
+                                    text.replace(QString("%1::").arg(list.at(i)), "");
+                                }
+                            }
+                        }
+                    }
+                    else
+                    {
+                        QList<QString> names = parentClassName.split("::");
+                        int count = names.count();
 
-    static const FunctionOptions functionOptions;
-
-    newElement.function.prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
-
-    int lastConstructorIndex = -1;
-    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
-
-    for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
+                        for (int i = 0; i < count; i++)
+                        {
+                            text.replace(QString("%1::").arg(names.at(i)), "");
+                        }
+                    }
+                }
+            }
+        }
+    }
+    else
     {
-        if (element->nonVirtualFunctionChildren.at(i).function.isConstructor ||
-            element->nonVirtualFunctionChildren.at(i).function.isDefaultConstructor)
+        if (parentClassName.length() == 0)
         {
-            lastConstructorIndex = i;
+            text = text.mid(text.lastIndexOf("::") + 2);
         }
-        else if (lastConstructorIndex != -1)
+        else
         {
-            break;
+            if (parentClassName.contains("<"))
+            {
+                int indexOfOperator = TypeName::Parse(parentClassName)->GetLastScopeSeparatorIndex();
+
+                if (indexOfOperator > 0)
+                {
+                    text.replace(parentClassName.mid(0, indexOfOperator + 2), "");
+                    text.replace(QString("%1::").arg(parentClassName.mid(indexOfOperator + 2)), "");
+
+                    QStringList list = text.split("::");
+                    int count = list.count();
+
+                    for (int i = 0; i < count; i++)
+                    {
+                        if (!list.at(i).contains("<"))
+                        {
+                            text.replace(QString("%1::").arg(list.at(i)), "");
+                        }
+                    }
+                }
+            }
+            else
+            {
+                QList<QString> names = parentClassName.split("::");
+                int count = names.count();
+
+                for (int i = 0; i < count; i++)
+                {
+                    text.replace(QString("%1::").arg(names.at(i)), "");
+                }
+            }
         }
     }
+}
 
-    if (lastConstructorIndex + 1 == nonVirtualFunctionChildrenCount)
+bool PDB::CheckIfInnerUDTBelongsToMainUDT(Element* element, Element* innerUDT)
+{
+    bool belongsToMainUDT = false;
+    int baseClassChildrenCount = innerUDT->baseClassChildren.count();
+    int enumChildrenCount = innerUDT->enumChildren.count();
+    int udtClassChildrenCount = innerUDT->udtChildren.count();
+    int dataClassChildrenCount = innerUDT->dataChildren.count();
+    int staticDataClassChildrenCount = innerUDT->staticDataChildren.count();
+    int virtualFunctionChildrenCount = innerUDT->virtualFunctionChildren.count();
+    int nonVirtualFunctionChildrenCount = innerUDT->nonVirtualFunctionChildren.count();
+
+    /*
+    * Use contains instead of startsWith because when startsWith is used then
+    * checkIfInnerUDTBelongsToMainUDT function won't always return correct result
+    */
+
+    for (int i = 0; i < baseClassChildrenCount; i++)
     {
-        element->nonVirtualFunctionChildren.append(newElement);
+        if (innerUDT->baseClassChildren.at(i).baseClass->parentClassName.contains(element->udt->name))
+        {
+            belongsToMainUDT = true;
+
+            break;
+        }
     }
-    else
+
+    for (int i = 0; i < enumChildrenCount; i++)
     {
-        element->nonVirtualFunctionChildren.insert(lastConstructorIndex + 1, newElement);
+        if (innerUDT->enumChildren.at(i).enum1->parentClassName.contains(element->udt->name))
+        {
+            belongsToMainUDT = true;
+
+            break;
+        }
     }
-}
 
-void PDB::AddCopyAssignmentOperator(Element* element)
-{
-    Element newElement = {};
+    for (int i = 0; i < udtClassChildrenCount; i++)
+    {
+        if (innerUDT->udtChildren.at(i).udt->parentClassName.contains(element->udt->name))
+        {
+            belongsToMainUDT = true;
 
-    newElement.function.name = "operator=";
-    newElement.function.callingConvention = CV_CALL_THISCALL;
-    newElement.function.isGeneratedByApp = true;
-    newElement.function.isCopyAssignmentOperator = true;
-    newElement.function.access = CV_public;
-    newElement.function.returnType1.baseType = 0;
-    newElement.function.returnType2 = QString("%1&").arg(element->udt.name);
-    newElement.function.parentClassName = GetParentClassName(element);
-    newElement.function.parameters.append(QString("%1&").arg(element->udt.name));
-    newElement.elementType = ElementType::functionType;
+            break;
+        }
+    }
 
-    Element parameterElement = {};
+    for (int i = 0; i < dataClassChildrenCount; i++)
+    {
+        if (innerUDT->dataChildren.at(i).data->parentClassName.contains(element->udt->name))
+        {
+            belongsToMainUDT = true;
 
-    parameterElement.elementType = ElementType::dataType;
-    parameterElement.data.name = "__that";
-    parameterElement.data.typeName = QString("%1&").arg(element->udt.name);
-    parameterElement.data.isReference = true;
-    parameterElement.data.isTypeConst = true;
-    parameterElement.data.dataKind = DataIsParam;
+            break;
+        }
+    }
 
-    newElement.dataChildren.append(parameterElement);
+    for (int i = 0; i < staticDataClassChildrenCount; i++)
+    {
+        if (innerUDT->staticDataChildren.at(i).data->parentClassName.contains(element->udt->name))
+        {
+            belongsToMainUDT = true;
 
-    static const FunctionOptions functionOptions;
+            break;
+        }
+    }
 
-    newElement.function.prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
+    for (int i = 0; i < virtualFunctionChildrenCount; i++)
+    {
+        if (innerUDT->virtualFunctionChildren.at(i).function->parentClassName.contains(element->udt->name))
+        {
+            belongsToMainUDT = true;
 
-    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
+            break;
+        }
+    }
 
     for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
     {
-        if (element->nonVirtualFunctionChildren.at(i).function.isCopyConstructor)
+        if (innerUDT->nonVirtualFunctionChildren.at(i).function->parentClassName.contains(element->udt->name))
         {
-            element->nonVirtualFunctionChildren.insert(i + 1, newElement);
-
-            if (i + 1 == nonVirtualFunctionChildrenCount)
-            {
-                element->nonVirtualFunctionChildren.append(newElement);
-            }
-            else
-            {
-                element->nonVirtualFunctionChildren.insert(i + 1, newElement);
-            }
+            belongsToMainUDT = true;
 
             break;
         }
     }
+
+    if (baseClassChildrenCount == 0 &&
+        enumChildrenCount == 0 &&
+        udtClassChildrenCount == 0 &&
+        dataClassChildrenCount == 0 &&
+        staticDataClassChildrenCount == 0 &&
+        virtualFunctionChildrenCount == 0 &&
+        nonVirtualFunctionChildrenCount == 0)
+    {
+        if (innerUDT->udt->parentClassName.contains(element->udt->name))
+        {
+            belongsToMainUDT = true;
+        }
+    }
+
+    return belongsToMainUDT;
 }
 
-void PDB::CheckIfCopyCtorAndCopyAssignmentOpAdded(Element* element)
+QString PDB::GetParentClassName(const QString& typeName)
 {
-    if (element->elementType == ElementType::enumType ||
-        element->elementType == ElementType::udtType &&
-        element->udt.isUnnamed)
+    return TypeName::Parse(typeName)->GetParentName();
+}
+
+QString PDB::GetParentClassName(Element* element)
+{
+    QString parentClassName;
+    int baseClassChildrenCount = element->baseClassChildren.count();
+    int enumChildrenCount = element->enumChildren.count();
+    int udtClassChildrenCount = element->udtChildren.count();
+    int dataClassChildrenCount = element->dataChildren.count();
+    int staticDataClassChildrenCount = element->staticDataChildren.count();
+    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
+    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
+
+    if (baseClassChildrenCount > 0)
     {
-        return;
+        parentClassName = element->baseClassChildren.at(0).baseClass->parentClassName;
     }
 
-    int indexOfLastConstructor = 0;
+    if (enumChildrenCount > 0)
+    {
+        parentClassName = element->enumChildren.at(0).enum1->parentClassName;
+    }
 
-    int udtChildrenCount = element->udtChildren.count();
+    if (udtClassChildrenCount > 0)
+    {
+        parentClassName = element->udtChildren.at(0).udt->parentClassName;
+    }
 
-    for (int i = 0; i < udtChildrenCount; i++)
+    if (dataClassChildrenCount > 0)
     {
-        CheckIfDefaultCtorAndDtorAdded(&element->udtChildren[i]);
+        parentClassName = element->dataChildren.at(0).data->parentClassName;
     }
 
-    if (!element->udt.hasCopyConstructor)
+    if (staticDataClassChildrenCount > 0)
     {
-        AddCopyConstructor(element);
+        parentClassName = element->staticDataChildren.at(0).data->parentClassName;
     }
 
-    if (!element->udt.hasCopyAssignmentOperator)
+    if (virtualFunctionChildrenCount > 0)
     {
-        AddCopyAssignmentOperator(element);
+        parentClassName = element->virtualFunctionChildren.at(0).function->parentClassName;
     }
+
+    if (nonVirtualFunctionChildrenCount > 0)
+    {
+        parentClassName = element->nonVirtualFunctionChildren.at(0).function->parentClassName;
+    }
+
+    return parentClassName;
 }
 
-void PDB::ApplyReturnValueOptimization(Element* element)
+bool PDB::CheckIfPublicKeywordShouldBeAdded(const Element* element)
 {
-    QString returnType = element->function.returnType2;
+    bool addPublicKeyword = false;
+    int dataChildrenCount = element->dataChildren.count();
+    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
+    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
 
-    if (element->function.returnType1.baseType == 0 &&
-        !element->function.returnType1.isPointer &&
-        !element->function.returnType1.isReference)
+    if (element->enumChildren.count() > 0 ||
+        element->udtChildren.count() ||
+        element->typedefChildren.count() > 0 &&
+        options->displayTypedefs ||
+        element->staticDataChildren.count() > 0)
     {
-        element->function.returnType2.append("*");
-
-        Element parameterElement = {};
+        addPublicKeyword = true;
+    }
+    else
+    {
+        for (int i = 0; i < dataChildrenCount; i++)
+        {
+            if (element->dataChildren.at(i).data->isCompilerGenerated)
+            {
+                if (!options->displayVTablePointerIfExists &&
+                    element->dataChildren.at(i).data->isVTablePointer ||
+                    !element->dataChildren.at(i).data->isPadding &&
+                    options->displayPaddingBytes)
+                {
+                    addPublicKeyword = false;
+                }
+            }
+            else
+            {
+                addPublicKeyword = true;
 
-        parameterElement.elementType = ElementType::dataType;
-        parameterElement.data.name = "result";
-        parameterElement.data.typeName = returnType;
-        parameterElement.data.isPointer = true;
-        parameterElement.data.pointerLevel = 1;
-        parameterElement.data.dataKind = DataIsParam;
+                break;
+            }
+        }
 
-        if (element->dataChildren.count() == 0)
+        for (int i = 0; i < virtualFunctionChildrenCount; i++)
         {
-            element->dataChildren.append(parameterElement);
+            if (element->virtualFunctionChildren.at(i).function->isNonImplemented)
+            {
+                if (!options->displayNonImplementedFunctions)
+                {
+                    addPublicKeyword = false;
+                }
+            }
+            else
+            {
+                addPublicKeyword = true;
+
+                break;
+            }
         }
-        else
+
+        for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
         {
-            if (element->dataChildren.at(0).data.dataKind == DataIsObjectPtr)
+            if (element->nonVirtualFunctionChildren.at(i).function->isNonImplemented)
             {
-                element->dataChildren.insert(1, parameterElement);
+                if (!options->displayNonImplementedFunctions)
+                {
+                    addPublicKeyword = false;
+                }
             }
             else
             {
-                element->dataChildren.insert(0, parameterElement);
+                addPublicKeyword = true;
+
+                break;
             }
         }
-
-        element->function.parameters.append(QString("%1*").arg(returnType));
     }
+
+    return addPublicKeyword;
 }
 
-void PDB::FlattenUDT(Element* element, Element* newElement, quint64* offset, quint32* alignmentNum)
+bool PDB::CheckIfHasAnyEmptyBaseClass(const Element* element)
 {
-    int count = element->children.count();
-    int numberOfBits = 0;
+    int baseClassChildrenCount = element->baseClassChildren.count();
 
-    for (int i = 0; i < count; i++)
+    for (int i = 0; i < baseClassChildrenCount; i++)
     {
-        if (element->children.at(i).elementType == ElementType::baseClassType)
-        {
-            JoinLists(&element->children[i]);
-            FlattenUDT(&element->children[i], newElement, offset, alignmentNum);
-        }
-        else if (element->children.at(i).elementType == ElementType::dataType &&
-            element->children.at(i).data.dataKind != DataIsStaticMember)
-        {
-            bool increaseOffset = false;
+        if (element->baseClassChildren.at(i).dataChildren.count() == 1)
+		{
+            if (element->baseClassChildren.at(i).dataChildren.at(0).data->isEndPadding)
+			{
+                return true;
+			}
+		}
+    }
 
-            element->children[i].offset = *offset;
+    return false;
+}
 
-            if (element->children.at(i).numberOfBits > 0)
-            {
-                while (i < count &&
-                    element->children.at(i).elementType == ElementType::dataType &&
-                    element->children.at(i).numberOfBits > 0)
-                {
-                    element->children[i].offset = *offset;
-                    newElement->children.append(element->children.at(i));
+bool PDB::CheckIfRVOIsAppliedToFunction(IDiaSymbol* symbol)
+{
+    bool isRVOApplied = false;
+    DWORD symTag = 0;
 
-                    numberOfBits += element->children.at(i).numberOfBits;
+    if (symbol->get_symTag(&symTag) == S_OK && symTag == SymTagUDT)
+    {
+		ULONGLONG size;
 
-                    if (numberOfBits >= element->children.at(i).size * 8)
-                    {
-                        numberOfBits = 0;
-                        *offset += element->children.at(i).size;
-                    }
+		if (symbol->get_length(&size) == S_OK)
+		{
+			isRVOApplied = size > 8;
+		}
 
-                    i++;
-                }
+		if (!isRVOApplied)
+		{
+            /*
+            * This is case of small UDT which possibly fits into a register (or two)
+            * but it has to be a POD for that (it shouldn't have constructor or assignment operators)
+            */
+            BOOL hasConstructor = 0, hasAssignmentOperator = 0, hasCastOperator = 0;
 
-                i--;
-                
-                if (numberOfBits == 0)
-                {
-                    if (element->children.at(i).elementType == ElementType::dataType &&
-                        element->children.at(i).numberOfBits > 0)
-                    {
-                        element->children[i].offset = *offset;
-                        newElement->children.append(element->children.at(i));
-                    }
-                }
-                else
-                {
-                    *offset += element->children.at(i).size;
-                    numberOfBits = 0;
-                }
+			if (symbol->get_constructor(&hasConstructor) == S_OK && hasConstructor ||
+				symbol->get_hasAssignmentOperator(&hasAssignmentOperator) == S_OK && hasAssignmentOperator ||
+				symbol->get_hasCastOperator(&hasCastOperator) == S_OK && hasCastOperator)
+			{
+				isRVOApplied = true;
+			}
+		}
+    }
 
-                continue;
-            }
+    return isRVOApplied;
+}
 
-            if (element->children.at(i).data.isTypeNameOfEnum)
-            {
-                newElement->children.append(element->children.at(i));
-                increaseOffset = true;
-            }
-            else if (element->children.at(i).data.hasChildren &&
-                element->children.at(i).udt.isAnonymousUnion)
-            {
-                JoinLists(&element->children[i]);
-                FlattenUDT(&element->children[i], newElement, offset, alignmentNum);
-            }
-            else if (element->children.at(i).data.hasChildren &&
-                element->children.at(i).udt.isAnonymousStruct)
-            {
-                JoinLists(&element->children[i]);
-                FlattenUDT(&element->children[i], newElement, offset, alignmentNum);
-            }
-            else if (element->children.at(i).data.isCompilerGenerated)
-            {
-                if (!element->children.at(i).data.isVTablePointer)
-                {
-                    if (element->elementType == ElementType::udtType &&
-                        element->children[i].data.isEndPadding)
-                    {
-                        element->children[i].data.name = QString("__endPadding%1").arg(*alignmentNum);
-                    }
-                    else
-                    {
-                        element->children[i].data.isEndPadding = false;
-                        element->children[i].data.name = QString("__padding%1").arg(*alignmentNum);
-                    }
+void PDB::DeclareFunctionsForStaticVariables(Element* element)
+{
+    int staticDataChildrenCount = element->staticDataChildren.count();
+    Element newElement;
 
-                    ++*alignmentNum;
-                }
-                
-                newElement->children.append(element->children.at(i));
-                increaseOffset = true;
-            }
-            else if (element->children.at(i).data.isArray)
-            {
-                //In this case don't split it to base types because list get very long long if type has many members
-                if (element->children.at(i).data.baseType == 0 &&
-                    !element->children.at(i).data.isPointer)
-                {
-                    newElement->children.append(element->children.at(i));
-                    increaseOffset = true;
-                }
-                else
-                {
-                    if (element->children.at(i).data.baseType != 0 ||
-                        element->children.at(i).data.isPointer &&
-                        element->children.at(i).data.baseType != 0)
-                    {
-                        int arrayCount = element->dataChildren.at(i).data.arrayCount.count();
-                        int count2 = 1;
+    for (int i = 0; i < staticDataChildrenCount; i++)
+    {
+        newElement = CreateGetter(element, i);
 
-                        for (int j = 0; j < arrayCount; j++)
-                        {
-                            count2 *= element->dataChildren.at(i).data.arrayCount.at(j);
-                        }
+        element->nonVirtualFunctionChildren.append(newElement);
+    }
 
-                        quint32 size = 0;
+	for (int i = 0; i < staticDataChildrenCount; i++)
+	{
+        newElement = CreateSetter(element, i);
 
-                        if (count2 > 0)
-                        {
-                            size = element->children.at(i).size / count2;
-                        }
+		element->nonVirtualFunctionChildren.append(newElement);
+	}
+}
 
-                        for (int j = 0; j < count2; j++)
-                        {
-                            Element newElement2 = {};
+void PDB::ImplementFunctionsForStaticVariables(const Element* element, QString& cppCode)
+{
+    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
+    static const DataOptions dataOptions = { true, false };
+    static const FunctionOptions functionOptions = { true, false, false, true };
+    int n = 0;
+    Element element2;
 
-                            newElement2.elementType = ElementType::dataType;
-                            newElement2.data.name = QString("%1_%2").arg(element->children.at(i).data.name).arg(j);
-                            newElement2.data.typeName = element->children.at(i).data.typeName;
-                            newElement2.data.name = QString("%1_%2").arg(element->children.at(i).data.name).arg(j);
-                            newElement2.data.dataKind = DataIsMember;
-                            newElement2.size = size;
-                            newElement2.offset = *offset;
+    for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
+    {
+        if (element->nonVirtualFunctionChildren.at(i).function->isStatic &&
+            element->nonVirtualFunctionChildren.at(i).function->isGeneratedByApp)
+        {
+            element2 = element->nonVirtualFunctionChildren.at(i);
 
-                            *offset += size;
+            QString type;
+            QString offset;
+			QString functionPrototype = FunctionTypeToString(const_cast<Element*>(&element2), &functionOptions);
+			QString baseAddressVariableName = GetBaseAddressVariableName();
 
-                            newElement->children.append(newElement2);
-                        }
-                    }
-                    else
-                    {
-                        int arrayCount = element->dataChildren.at(i).data.arrayCount.count();
-                        int count2 = 1;
+            //DWORD offset = element->staticDataChildren.at(n++).data->relativeVirtualAddress;
 
-                        for (int j = 0; j < arrayCount; j++)
-                        {
-                            count2 *= element->dataChildren.at(i).data.arrayCount.at(j);
-                        }
+            //CHANGE OFFSET NUMBERS TO BE UPPERCASE
 
-                        quint32 size = 0;
+            if (n == element->staticDataChildren.count())
+            {
+                n = 0;
+            }
 
-                        if (count2 > 0)
-                        {
-                            size = element->children.at(i).size / count2;
-                        }
+            cppCode += QString("%1\r\n{\r\n\t").arg(functionPrototype);
 
-                        for (int j = 0; j < count2; j++)
-                        {
-                            Element newElement2 = {};
+            if (element2.function->returnType1.baseType == 1)
+            {
+                Data dataType = *element2.dataChildren.at(0).data;
 
-                            newElement2.elementType = ElementType::dataType;
-                            newElement2.data.name = QString("%1_%2").arg(element->children.at(i).data.name).arg(j);
-                            newElement2.data.typeName = element->children.at(i).data.typeName;
-                            newElement2.data.name = QString("%1_%2").arg(element->children.at(i).data.name).arg(j);
-                            newElement2.data.dataKind = DataIsMember;
-                            newElement2.size = size;
-                            newElement2.offset = *offset;
+                if (!element->staticDataChildren.at(n++).data->isTypeConst)
+                {
+                    dataType.isTypeConst = false;
+                }
 
-                            *offset += size;
+                type = DataTypeToString(&dataType, &dataOptions);
+                offset = QString::number(element2.dataChildren.at(0).data->relativeVirtualAddress, 16).toUpper();
 
-                            newElement->children.append(newElement2);
-                        }
-                    }
+                cppCode += "*";
+
+				if (element2.dataChildren.at(0).data->isPointer)
+				{
+					cppCode += QString("reinterpret_cast<%1>").arg(type);
+				}
+				else
+				{
+					cppCode += QString("reinterpret_cast<%1*>").arg(type);
+				}
+
+                cppCode += QString("(BaseAddresses::%2 + 0x%3) = ").arg(baseAddressVariableName).arg(offset);
+
+                if (element2.dataChildren.at(0).data->isPointer)
+                {
+                    cppCode += "*";
                 }
+
+                cppCode += QString("%1").arg(element2.dataChildren.at(0).data->name);
             }
             else
             {
-                if (!element->children.at(i).data.isPointer &&
-                    element->children.at(i).data.baseType == 0)
-                {
-                    QString typeName = element->children.at(i).data.originalTypeName;
-                    QHash<QString, DWORD>::const_iterator it = diaSymbols->find(typeName);
-
-                    DWORD id = it.value();
-                    IDiaSymbol* symbol;
-
-                    if (GetSymbolByID(id, &symbol))
-                    {
-                        Element element2 = GetElement(symbol);
-                        symbol->Release();
+                type = element->nonVirtualFunctionChildren.at(i).function->returnType2;
+                offset = QString::number(element->nonVirtualFunctionChildren.at(i).function->returnType1.relativeVirtualAddress, 16)
+                    .toUpper();
 
-                        if (element2.elementType == ElementType::udtType)
-                        {
-                            CheckIfUnionsAreMissing(&element2);
-                        }
+                cppCode += "return ";
 
-                        JoinLists(&element2);
-                        FlattenUDT(&element2, newElement, offset, alignmentNum);
-                    }
+                if (element2.function->returnType1.isPointer)
+                {
+                    cppCode += QString("reinterpret_cast<%1>").arg(type);
                 }
                 else
                 {
-                    newElement->children.append(element->children.at(i));
-                    increaseOffset = true;
+                    cppCode += QString("*reinterpret_cast<%1*>").arg(type);
                 }
-            }
 
-            if (increaseOffset)
-            {
-                *offset += element->children.at(i).size;
+                cppCode += QString("(BaseAddresses::%2 + 0x%3)").arg(baseAddressVariableName).arg(offset);
             }
-        }
 
-        //__m128
-        if (element->elementType == ElementType::udtType &&
-            element->udt.udtKind == UdtUnion ||
-            element->elementType == ElementType::dataType &&
-            element->data.hasChildren &&
-            element->udt.isAnonymousUnion)
-        {
-            break;
+            cppCode += ";\r\n}\r\n\r\n";
         }
     }
 }
 
-quint32 PDB::CalculateDefaultAlignment(const Element* element, QHash<QString, int> checkedTypes)
+Element PDB::CreateGetter(Element* element, const int i)
 {
-    quint32 alignment = 1;
+    static const DataOptions dataOptions = { true, false };
+    static const FunctionOptions functionOptions;
 
-    if (element->elementType == ElementType::udtType &&
-        element->udt.hasVTable)
-    {
-        if (type == CV_CFL_80386)
-        {
-            alignment = 4;
-        }
-        else
-        {
-            alignment = 8;
-        }
-    }
-
-    quint32 size;
-    int baseClassChildrenCount = element->baseClassChildren.count();
-    int dataChildrenCount = element->dataChildren.count();
-
-    for (int i = 0; i < baseClassChildrenCount; i++)
-    {
-        if (checkedTypes.find(element->baseClassChildren.at(i).baseClass.name) != checkedTypes.end())
-        {
-            continue;
-        }
-
-        QString name = element->baseClassChildren.at(i).baseClass.name;
+    QString name = RemoveHungarianNotationFromVariable(element->staticDataChildren.at(i).data->name);
+	Element newElement = {};
 
-        checkedTypes.insert(name, element->baseClassChildren.at(i).baseClass.name.length());
+    newElement.elementType = ElementType::functionType;
+    newElement.function.Edit()->returnType1 = *element->staticDataChildren.at(i).data;
+    newElement.function.Edit()->returnType1.dataKind = DataIsUnknown;
 
-        quint32 alignment2 = CalculateDefaultAlignment(&element->baseClassChildren.at(i), checkedTypes);
+	if (newElement.function->returnType1.isArray)
+	{
+		newElement.function.Edit()->returnType1.isArray = false;
+		newElement.function.Edit()->returnType1.isPointer = true;
+		newElement.function.Edit()->returnType1.pointerLevel = 1;
+	}
 
-        if (alignment2 > alignment)
-        {
-            alignment = alignment2;
-        }
-    }
+    QString type = DataTypeToString(&newElement.function->returnType1, &dataOptions);
 
-    for (int i = 0; i < dataChildrenCount; i++)
-    {
-        if (element->dataChildren.at(i).data.isCompilerGenerated)
-        {
-            continue;
-        }
+    newElement.function.Edit()->returnType2 = type;
 
-        size = element->dataChildren.at(i).size;
+	if (name.contains("_"))
+	{
+		newElement.function.Edit()->name = QString("Get%1").arg(ConvertSnakeCaseToPascalCase(name));
+	}
+	else
+	{
+		newElement.function.Edit()->name = QString("Get%1").arg(ConvertCamelCaseToPascalCase(name));
+	}
 
-        if (element->dataChildren.at(i).data.hasChildren)
-        {
-            if (element->dataChildren.at(i).data.isTypeNameOfEnum)
-            {
-                size = 4;
+	newElement.function.Edit()->isStatic = true;
+	newElement.function.Edit()->callingConvention = CV_CALL_THISCALL;
+	newElement.function.Edit()->isGeneratedByApp = true;
+	newElement.function.Edit()->access = CV_public;
+	newElement.function.Edit()->parentClassName = GetParentClassName(element);
+	newElement.function.Edit()->prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
 
-                if (size > alignment)
-                {
-                    alignment = size;
-                }
-            }
-            else
-            {
-                Element element2 = element->dataChildren.at(i);
-                element2.elementType = ElementType::udtType;
+    return newElement;
+}
 
-                quint32 alignment2 = CalculateDefaultAlignment(&element2, checkedTypes);
+Element PDB::CreateSetter(Element* element, const int i)
+{
+    static const DataOptions dataOptions = { true, false };
+    static const FunctionOptions functionOptions;
 
-                if (alignment2 > alignment)
-                {
-                    alignment = alignment2;
-                }
-            }
+    QString name = RemoveHungarianNotationFromVariable(element->staticDataChildren.at(i).data->name);
+    Element newElement = {};
 
-            continue;
-        }
-        else
-        {
-            if (element->dataChildren.at(i).data.isTypeNameOfEnum)
-            {
-                size = 4;
+    newElement.elementType = ElementType::functionType;
+    newElement.function.Edit()->returnType1.baseType = 1;
+    newElement.function.Edit()->returnType2 = "void";
 
-                if (size > alignment)
-                {
-                    alignment = size;
-                }
+    if (name.contains("_"))
+    {
+        newElement.function.Edit()->name = QString("Set%1").arg(ConvertSnakeCaseToPascalCase(name));
+    }
+    else
+    {
+        newElement.function.Edit()->name = QString("Set%1").arg(ConvertCamelCaseToPascalCase(name));
+    }
 
-                continue;
-            }
+    newElement.function.Edit()->isStatic = true;
+    newElement.function.Edit()->callingConvention = CV_CALL_THISCALL;
+    newElement.function.Edit()->isGeneratedByApp = true;
+    newElement.function.Edit()->access = CV_public;
+    newElement.function.Edit()->parentClassName = GetParentClassName(element);
 
-            if (element->dataChildren.at(i).data.isArray)
-            {
-                if (element->dataChildren.at(i).data.isPointer ||
-                    element->dataChildren.at(i).data.baseType != 0)
-                {
-                    int arrayCount = element->dataChildren.at(i).data.arrayCount.count();
-                    int count = 1;
+    Element parameterElement = {};
 
-                    for (int j = 0; j < arrayCount; j++)
-                    {
-                        count *= element->dataChildren.at(i).data.arrayCount.at(j);
-                    }
+    parameterElement.elementType = ElementType::dataType;
+    parameterElement.data = element->staticDataChildren.at(i).data;
+    //parameterElement.data.Edit()->name = element->staticDataChildren.at(i).data->name;
+    //parameterElement.data.Edit()->typeName = element->staticDataChildren.at(i).data->typeName;
+    //parameterElement.data.Edit()->isPointer = true;
+    //parameterElement.data.Edit()->pointerLevel = 1;
+    parameterElement.data.Edit()->isTypeConst = true;
+    parameterElement.data.Edit()->dataKind = DataIsParam;
 
-                    if (count > 0)
-                    {
-                        size = element->dataChildren.at(i).size / count;
-                    }
-                }
-                else
-                {
-                    if (checkedTypes.find(element->dataChildren.at(i).data.typeName) != checkedTypes.end())
-                    {
-                        continue;
-                    }
+    if (name.contains("_"))
+    {
+        parameterElement.data.Edit()->name = ConvertSnakeCaseToCamelCase(name);
+    }
+    else
+    {
+        parameterElement.data.Edit()->name = ConvertPascalCaseToCamelCase(name);
+    }
 
-                    QString typeName = element->dataChildren.at(i).data.originalTypeName;
+    if (element->staticDataChildren.at(i).data->isArray)
+    {
+        parameterElement.data.Edit()->isArray = false;
+        parameterElement.data.Edit()->isPointer = true;
+        parameterElement.data.Edit()->pointerLevel = 1;
+    }
 
-                    checkedTypes.insert(typeName, typeName.length());
+    QString type = DataTypeToString(&*parameterElement.data, &dataOptions);
 
-                    quint32 alignment2 = 0;
+    newElement.dataChildren.append(parameterElement);
+    newElement.function.Edit()->parameters.append(type);
 
-                    if (typeName.startsWith("m128") || typeName.startsWith("_m128") || typeName.startsWith("__m128"))
-                    {
-                        alignment2 = 16;
-                    }
-                    else
-                    {
-                        QHash<QString, DWORD>::const_iterator it = diaSymbols->find(typeName);
-                        DWORD id = it.value();
+    newElement.function.Edit()->prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
 
-                        SymbolRecord symbolRecord;
+    return newElement;
+}
 
-                        symbolRecord.id = id;
-                        symbolRecord.typeName = typeName;
+ULONGLONG PDB::GetFunctionSize(DWORD relativeVirtualAddress)
+{
+    ULONGLONG size = 0;
+    IDiaEnumSymbolsByAddr* enumSymbolsByAddr = nullptr;
+    IDiaSymbol* symbol = nullptr;
 
-                        //It's only important to detect if type is enum because enums shouldn't be imported
-                        if (element->dataChildren.at(i).data.isTypeNameOfEnum)
-                        {
-                            symbolRecord.type = SymbolType::enumType;
-                        }
+    if (SUCCEEDED(diaSession->getSymbolsByAddr(&enumSymbolsByAddr)))
+    {
+		if (SUCCEEDED(enumSymbolsByAddr->symbolByRVA(relativeVirtualAddress, &symbol)))
+		{
+            symbol->get_length(&size);
+		}
+    }
 
-                        Element element2 = GetElement(&symbolRecord);
+    return size;
+}
 
-                        alignment2 = CalculateDefaultAlignment(&element2, checkedTypes);
-                    }
+void PDB::CheckIfDefaultCtorAndDtorAdded(Element* element)
+{
+    /*
+    * Compiler doesn't generate virtual destructor for base class.
+    * If base class has virtual destructor but child class doesn't have it then it will be generated.
+    * Compiler generated virtual destructor is always placed at the end of vTable.
+    * __vecDelDtor is not counted in countOfVirtualFunctions
+    */
 
-                    if (alignment2 > alignment)
-                    {
-                        alignment = alignment2;
-                    }
+    if (element->elementType == ElementType::enumType ||
+        element->elementType == ElementType::udtType &&
+        element->udt->isUnnamed)
+    {
+        return;
+    }
 
-                    continue;
-                }
-            }
+    if (options->addDefaultCtorAndDtorToUDT)
+    {
+        if (!element->udt->hasDefaultConstructor)
+        {
+            AddDefaultConstructor(element);
+        }
 
-            if (!element->dataChildren.at(i).data.isPointer)
+        if (element->udt->hasVTable)
+        {
+            if (!element->udt->hasVirtualDestructor)
             {
-                if ((element->dataChildren.at(i).data.typeName != element->udt.name) &&
-                    element->dataChildren.at(i).data.baseType == 0)
-                {
-                    if (checkedTypes.find(element->dataChildren.at(i).data.typeName) != checkedTypes.end())
-                    {
-                        continue;
-                    }
-
-                    QString typeName = element->dataChildren.at(i).data.originalTypeName;
-
-                    checkedTypes.insert(typeName, typeName.length());
-
-                    quint32 alignment2 = 0;
-                    QString lower = typeName.toLower();
-
-                    if (lower.startsWith("m128") || lower.startsWith("_m128") || lower.startsWith("__m128"))
-                    {
-                        alignment2 = 16;
-                    }
-                    else
-                    {
-                        QHash<QString, DWORD>::const_iterator it = diaSymbols->find(typeName);
-                        DWORD id = it.value();
-
-                        SymbolRecord symbolRecord;
-
-                        symbolRecord.id = id;
-                        symbolRecord.typeName = typeName;
-
-                        //It's only important to detect if type is enum because enums shouldn't be imported
-                        if (element->dataChildren.at(i).data.isTypeNameOfEnum)
-                        {
-                            symbolRecord.type = SymbolType::enumType;
-                        }
-
-                        Element element2 = GetElement(&symbolRecord);
-
-                        alignment2 = CalculateDefaultAlignment(&element2, checkedTypes);
-                    }
-
-                    if (alignment2 > alignment)
-                    {
-                        alignment = alignment2;
-                    }
-
-                    continue;
-                }
+                AddVirtualDestructor(element);
             }
         }
-
-        if (size > alignment)
+        else
         {
-            alignment = size;
+            if (!element->udt->hasDestructor)
+            {
+                AddDestructor(element);
+            }
         }
     }
-
-    return alignment;
 }
 
-quint32 PDB::GetCorrectAlignment(quint32 defaultAlignment, quint32 typeSize)
+void PDB::AddDefaultConstructor(Element* element)
 {
-    while ((typeSize & (defaultAlignment - 1)) > 0)
+    Element newElement = {};
+
+    newElement.function.Edit()->name = element->udt->name;
+    newElement.function.Edit()->callingConvention = CV_CALL_THISCALL;
+    newElement.function.Edit()->isGeneratedByApp = true;
+    newElement.function.Edit()->isDefaultConstructor = true;
+    newElement.function.Edit()->access = CV_public;
+    newElement.function.Edit()->returnType1.baseType = 1;
+    newElement.function.Edit()->parentClassName = GetParentClassName(element);
+    newElement.elementType = ElementType::functionType;
+
+    static const FunctionOptions functionOptions;
+
+    newElement.function.Edit()->prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
+
+    if (element->nonVirtualFunctionChildren.count() == 0)
     {
-        defaultAlignment >>= 1;
+        element->nonVirtualFunctionChildren.append(newElement);
+    }
+    else
+    {
+        element->nonVirtualFunctionChildren.insert(0, newElement);
     }
-
-    return defaultAlignment;
 }
 
-unsigned int PDB::GetGreatestPaddingInUDT(const Element* element)
+void PDB::AddDestructor(Element* element)
 {
-    unsigned int greatestPadding = 0;
-    int dataChildrenCount = element->dataChildren.count();
+    Element newElement = {};
 
-    for (int i = 0; i < dataChildrenCount; i++)
+    newElement.function.Edit()->name = QString("~%1").arg(element->udt->name);
+    newElement.function.Edit()->callingConvention = CV_CALL_THISCALL;
+    newElement.function.Edit()->isGeneratedByApp = true;
+    newElement.function.Edit()->isDestructor = true;
+    newElement.function.Edit()->access = CV_public;
+    newElement.function.Edit()->returnType1.baseType = 1;
+    newElement.function.Edit()->parentClassName = GetParentClassName(element);
+    newElement.elementType = ElementType::functionType;
+
+    int lastConstructorIndex = -1;
+    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
+
+    for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
     {
-        if (element->dataChildren.at(i).data.isPadding &&
-            element->dataChildren.at(i).size > greatestPadding)
+        if (element->nonVirtualFunctionChildren.at(i).function->isConstructor ||
+            element->nonVirtualFunctionChildren.at(i).function->isDefaultConstructor)
         {
-            greatestPadding = element->dataChildren.at(i).size;
+            lastConstructorIndex = i;
+        }
+        else if (lastConstructorIndex != -1)
+        {
+            break;
         }
     }
 
-    return greatestPadding;
-}
-
-unsigned int PDB::NextPowerOf2(unsigned int value)
-{
-	unsigned long index;
+    static const FunctionOptions functionOptions;
 
-	_BitScanReverse(&index, --value);
+    newElement.function.Edit()->prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
 
-    if (value == 0)
+    if (lastConstructorIndex + 1 == nonVirtualFunctionChildrenCount)
     {
-        index = static_cast<unsigned long>(-1);
+        element->nonVirtualFunctionChildren.append(newElement);
     }
-
-    return 1U << (index + 1);
-}
-
-QString PDB::TrimStart(const QString& input)
-{
-    QString result = input;
-
-    while (result.count() > 0 && result.at(0).isSpace())
+    else
     {
-        result = result.right(result.count() - 1);
+        element->nonVirtualFunctionChildren.insert(lastConstructorIndex + 1, newElement);
     }
-
-    return result;
 }
 
-QString PDB::TrimEnd(const QString& input)
+void PDB::AddVirtualDestructor(Element* element)
 {
-    QString result = input;
+    Element newElement = {};
 
-    while (result.count() > 0 && result.at(result.count() - 1).isSpace())
-    {
-        result = result.left(result.count() - 1);
-    }
+    newElement.function.Edit()->name = QString("~%1").arg(element->udt->name);
+    newElement.function.Edit()->callingConvention = CV_CALL_THISCALL;
+    newElement.function.Edit()->isGeneratedByApp = true;
+    newElement.function.Edit()->isVirtual = true;
+    newElement.function.Edit()->isDestructor = true;
+    newElement.function.Edit()->access = CV_public;
+    newElement.function.Edit()->returnType1.baseType = 1;
+    newElement.function.Edit()->parentClassName = GetParentClassName(element);
+    newElement.elementType = ElementType::functionType;
 
-    return result;
-}
+    static const FunctionOptions functionOptions;
 
-QString PDB::FunctionTypeToString(const Element* element, const FunctionOptions* functionOptions)
-{
-    Function function = element->function;
-    QString result;
+    newElement.function.Edit()->prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
 
-    //Don't add keywords to prototypes while comparing prototypes because they will be compared faster then
-    if (functionOptions->addKeywordsAndParameterNames)
-    {
-        if (function.hasInlSpec && options->addInlineKeywordToInlineFunctions)
-        {
-            result += "inline";
-        }
-        else if (function.isNaked && options->addDeclspecKeywords)
-        {
-            result += "__declspec(naked)";
-        }
-        else if (function.isNoInline && options->addDeclspecKeywords)
-        {
-            result += "__declspec(noinline)";
-        }
-        else if (function.isNoReturn && options->addDeclspecKeywords)
-        {
-            result += "__declspec(noreturn)";
-        }
+    int virtualFunctionChildrenCount = element->virtualFunctionChildren.count();
 
-        //Don't add virtual and static keywords while generating C++ code
-        if (functionOptions->addStaticAndVirtualKeywords)
-        {
-            if (function.isVirtual && !function.isOverridden)
-            {
-                result += "virtual";
-            }
-            else if (function.isStatic)
-            {
-                if (!(element->dataChildren.count() > 0 &&
-                    element->dataChildren.at(0).data.dataKind == DataIsObjectPtr))
-                {
-                    result += "static";
-                }
-            }
-        }
+    if (virtualFunctionChildrenCount == 0)
+    {
+        newElement.function.Edit()->virtualBaseOffset = 0;
 
-        if (function.isConstructor &&
-            function.parameters.count() == 1 &&
-            options->addExplicitKeyword)
-        {
-            result += "explicit";
-        }
+        element->virtualFunctionChildren.append(newElement);
     }
-
-    if (result.length() > 0)
+    else
     {
-        result += " ";
-    }
+        //This is not safe because if last virtual function is overriden offset will be 0
+        /*DWORD lastVirtualFunctionBaseOffset = element->virtualFunctionChildren.last().function->virtualBaseOffset;
 
-    if (!options->includeConstKeyword)
-    {
-        if (function.returnType2.contains(", const"))
+        if (type == CV_CFL_80386)
         {
-            function.returnType2.replace(" const", " ");
+            newElement.function.Edit()->virtualBaseOffset = lastVirtualFunctionBaseOffset + 4;
         }
-        else if (function.returnType2.contains(" const"))
+        else
         {
-            function.returnType2.replace(" const", "");
+            newElement.function.Edit()->virtualBaseOffset = lastVirtualFunctionBaseOffset + 8;
+        }*/
+
+        if (type == CV_CFL_80386)
+        {
+            newElement.function.Edit()->virtualBaseOffset = (virtualFunctionChildrenCount + 1) * 4;
         }
-        else if (function.returnType2.contains("const "))
+        else
         {
-            function.returnType2.replace("const ", "");
+            newElement.function.Edit()->virtualBaseOffset = (virtualFunctionChildrenCount + 1) * 8;
         }
+
+        element->virtualFunctionChildren.append(newElement);
     }
+}
 
-    QString functionReturnType = function.returnType2;
+void PDB::AddCopyConstructor(Element* element)
+{
+    Element newElement = {};
 
-    if (!function.isConstructor &&
-        !function.isDefaultConstructor &&
-        !function.isCopyConstructor &&
-        !function.isDestructor &&
-        !function.returnsFunctionPointer &&
-        !function.isCastOperator)
+    newElement.function.Edit()->name = element->udt->name;
+    newElement.function.Edit()->callingConvention = CV_CALL_THISCALL;
+    newElement.function.Edit()->isGeneratedByApp = true;
+    newElement.function.Edit()->isCopyConstructor = true;
+    newElement.function.Edit()->access = CV_public;
+    newElement.function.Edit()->returnType1.baseType = 0;
+    newElement.function.Edit()->parentClassName = GetParentClassName(element);
+    newElement.function.Edit()->parameters.append(QString("%1&").arg(element->udt->name));
+    newElement.elementType = ElementType::functionType;
+
+    Element parameterElement = {};
+
+    parameterElement.elementType = ElementType::dataType;
+    parameterElement.data.Edit()->name = "__that";
+    parameterElement.data.Edit()->typeName = QString("%1&").arg(element->udt->name);
+    parameterElement.data.Edit()->isReference = true;
+    parameterElement.data.Edit()->isTypeConst = true;
+    parameterElement.data.Edit()->dataKind = DataIsParam;
+
+    newElement.dataChildren.append(parameterElement);
+
+    static const FunctionOptions functionOptions;
+
+    newElement.function.Edit()->prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
+
+    int lastConstructorIndex = -1;
+    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
+
+    for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
     {
-        if (functionOptions->addKeywordsAndParameterNames)
+        if (element->nonVirtualFunctionChildren.at(i).function->isConstructor ||
+            element->nonVirtualFunctionChildren.at(i).function->isDefaultConstructor)
         {
-            result += QString("%1 ").arg(functionReturnType);
+            lastConstructorIndex = i;
         }
-        else
+        else if (lastConstructorIndex != -1)
         {
-            result += QString("%1 ").arg(function.originalReturnType);
+            break;
         }
     }
 
-    if (function.returnsFunctionPointer)
+    if (lastConstructorIndex + 1 == nonVirtualFunctionChildrenCount)
     {
-        if (options->displayWithTrailingReturnType || options->displayWithAuto)
-        {
-            result += "auto ";
-        }
-        else if (options->displayWithTypedef || options->displayWithUsing)
-        {
-            QString functionName = function.name;
+        element->nonVirtualFunctionChildren.append(newElement);
+    }
+    else
+    {
+        element->nonVirtualFunctionChildren.insert(lastConstructorIndex + 1, newElement);
+    }
+}
 
-            functionName[0] = functionName.at(0).toLower();
+void PDB::AddCopyAssignmentOperator(Element* element)
+{
+    Element newElement = {};
 
-            QString functionPointerName = QString("%1Ptr").arg(functionName);
-            QString declaration;
-            Element newElement = {};
+    newElement.function.Edit()->name = "operator=";
+    newElement.function.Edit()->callingConvention = CV_CALL_THISCALL;
+    newElement.function.Edit()->isGeneratedByApp = true;
+    newElement.function.Edit()->isCopyAssignmentOperator = true;
+    newElement.function.Edit()->access = CV_public;
+    newElement.function.Edit()->returnType1.baseType = 0;
+    newElement.function.Edit()->returnType2 = QString("%1&").arg(element->udt->name);
+    newElement.function.Edit()->parentClassName = GetParentClassName(element);
+    newElement.function.Edit()->parameters.append(QString("%1&").arg(element->udt->name));
+    newElement.elementType = ElementType::functionType;
 
-            result += QString("%1 ").arg(functionPointerName);
+    Element parameterElement = {};
 
-            newElement.elementType = ElementType::typedefType;
-            newElement.typeDef.oldTypeName = functionReturnType;
-            newElement.typeDef.newTypeName = functionPointerName;
+    parameterElement.elementType = ElementType::dataType;
+    parameterElement.data.Edit()->name = "__that";
+    parameterElement.data.Edit()->typeName = QString("%1&").arg(element->udt->name);
+    parameterElement.data.Edit()->isReference = true;
+    parameterElement.data.Edit()->isTypeConst = true;
+    parameterElement.data.Edit()->dataKind = DataIsParam;
 
-            if (options->displayWithTypedef)
-            {
-                if (options->displayCallingConventionForFunctionPointers)
-                {
-                    functionPointerName.prepend(" ");
-                }
+    newElement.dataChildren.append(parameterElement);
 
-                functionReturnType = functionReturnType.insert(functionReturnType.indexOf("*)(") + 1,
-                    functionPointerName);
+    static const FunctionOptions functionOptions;
 
-                declaration = QString("typedef %1").arg(functionReturnType);
+    newElement.function.Edit()->prototype = FunctionTypeToString(const_cast<Element*>(&newElement), &functionOptions);
+
+    int nonVirtualFunctionChildrenCount = element->nonVirtualFunctionChildren.count();
+
+    for (int i = 0; i < nonVirtualFunctionChildrenCount; i++)
+    {
+        if (element->nonVirtualFunctionChildren.at(i).function->isCopyConstructor)
+        {
+            element->nonVirtualFunctionChildren.insert(i + 1, newElement);
+
+            if (i + 1 == nonVirtualFunctionChildrenCount)
+            {
+                element->nonVirtualFunctionChildren.append(newElement);
             }
             else
             {
-                declaration = QString("using %1 = %2").arg(functionPointerName).arg(functionReturnType);
+                element->nonVirtualFunctionChildren.insert(i + 1, newElement);
             }
 
-            newElement.typeDef.declaration = declaration;
-
-            typedefChildren.append(newElement);
+            break;
         }
     }
+}
 
-    if (functionOptions->addKeywordsAndParameterNames && options->displayCallingConventions)
+void PDB::CheckIfCopyCtorAndCopyAssignmentOpAdded(Element* element)
+{
+    if (element->elementType == ElementType::enumType ||
+        element->elementType == ElementType::udtType &&
+        element->udt->isUnnamed)
     {
-        //If function is variadic calling convention is __cdecl so there is no need display __cdecl
-        if ((function.isStatic &&
-            (function.callingConvention != CV_CALL_NEAR_C &&
-                function.callingConvention != CV_CALL_FAR_C)) &&
-            !function.isVariadic && function.callingConvention != CV_CALL_THISCALL)
-        {
-            result += QString("%1 ").arg(convertCallingConventionToString(function.callingConvention));
-        }
+        return;
     }
 
-    if (options->modifyFunctionNames)
+    int indexOfLastConstructor = 0;
+
+    int udtChildrenCount = element->udtChildren.count();
+
+    for (int i = 0; i < udtChildrenCount; i++)
     {
-        function.name = ModifyNamingCovention(function.name, false, true, false);
+        CheckIfDefaultCtorAndDtorAdded(&element->udtChildren[i]);
     }
 
-    if (functionOptions->appendCurrentUDTName)
+    if (!element->udt->hasCopyConstructor)
     {
-        result += QString("%1::").arg(function.parentClassName);
+        AddCopyConstructor(element);
     }
-    else
+
+    if (!element->udt->hasCopyAssignmentOperator)
+    {
+        AddCopyAssignmentOperator(element);
+    }
+}
+
+void PDB::ApplyReturnValueOptimization(Element* element)
+{
+    QString returnType = element->function->returnType2;
+
+    if (element->function->returnType1.baseType == 0 &&
+        !element->function->returnType1.isPointer &&
+        !element->function->returnType1.isReference)
     {
-        if (options->removeScopeResolutionOperator && function.name.contains("::"))
+        element->function.Edit()->returnType2.append("*");
+
+        Element parameterElement = {};
+
+        parameterElement.elementType = ElementType::dataType;
+        parameterElement.data.Edit()->name = "result";
+        parameterElement.data.Edit()->typeName = returnType;
+        parameterElement.data.Edit()->isPointer = true;
+        parameterElement.data.Edit()->pointerLevel = 1;
+        parameterElement.data.Edit()->dataKind = DataIsParam;
+
+        if (element->dataChildren.count() == 0)
         {
-            if (function.parentClassName.length() == 0)
+            element->dataChildren.append(parameterElement);
+        }
+        else
+        {
+            if (element->dataChildren.at(0).data->dataKind == DataIsObjectPtr)
             {
-                RemoveScopeResolutionOperators(function.name, parentClassName);
+                element->dataChildren.insert(1, parameterElement);
             }
             else
             {
-                RemoveScopeResolutionOperators(function.name, function.parentClassName);
+                element->dataChildren.insert(0, parameterElement);
             }
         }
+
+        element->function.Edit()->parameters.append(QString("%1*").arg(returnType));
     }
+}
 
-    result += function.name;
-    result += "(";
+void PDB::FlattenUDT(Element* element, Element* newElement, quint64* offset, quint32* alignmentNum)
+{
+    int count = element->children.count();
+    int numberOfBits = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (element->children.at(i).elementType == ElementType::baseClassType)
+        {
+            JoinLists(&element->children[i]);
+            FlattenUDT(&element->children[i], newElement, offset, alignmentNum);
+        }
+        else if (element->children.at(i).elementType == ElementType::dataType &&
+            element->children.at(i).data->dataKind != DataIsStaticMember)
+        {
+            bool increaseOffset = false;
+
+            element->children[i].offset = *offset;
 
-    int parametersCount = element->function.parameters.count();
+            if (element->children.at(i).numberOfBits > 0)
+            {
+                while (i < count &&
+                    element->children.at(i).elementType == ElementType::dataType &&
+                    element->children.at(i).numberOfBits > 0)
+                {
+                    element->children[i].offset = *offset;
+                    newElement->children.append(element->children.at(i));
+
+                    numberOfBits += element->children.at(i).numberOfBits;
+
+                    if (numberOfBits >= element->children.at(i).size * 8)
+                    {
+                        numberOfBits = 0;
+                        *offset += element->children.at(i).size;
+                    }
+
+                    i++;
+                }
+
+                i--;
+                
+                if (numberOfBits == 0)
+                {
+                    if (element->children.at(i).elementType == ElementType::dataType &&
+                        element->children.at(i).numberOfBits > 0)
+                    {
+                        element->children[i].offset = *offset;
+                        newElement->children.append(element->children.at(i));
+                    }
+                }
+                else
+                {
+                    *offset += element->children.at(i).size;
+                    numberOfBits = 0;
+                }
+
+                continue;
+            }
+
+            if (element->children.at(i).data->isTypeNameOfEnum)
+            {
+                newElement->children.append(element->children.at(i));
+                increaseOffset = true;
+            }
+            else if (element->children.at(i).data->hasChildren &&
+                element->children.at(i).udt->isAnonymousUnion)
+            {
+                JoinLists(&element->children[i]);
+                FlattenUDT(&element->children[i], newElement, offset, alignmentNum);
+            }
+            else if (element->children.at(i).data->hasChildren &&
+                element->children.at(i).udt->isAnonymousStruct)
+            {
+                JoinLists(&element->children[i]);
+                FlattenUDT(&element->children[i], newElement, offset, alignmentNum);
+            }
+            else if (element->children.at(i).data->isCompilerGenerated)
+            {
+                if (!element->children.at(i).data->isVTablePointer)
+                {
+                    if (element->elementType == ElementType::udtType &&
+                        element->children[i].data->isEndPadding)
+                    {
+                        element->children[i].data.Edit()->name = QString("__endPadding%1").arg(*alignmentNum);
+                    }
+                    else
+                    {
+                        element->children[i].data.Edit()->isEndPadding = false;
+                        element->children[i].data.Edit()->name = QString("__padding%1").arg(*alignmentNum);
+                    }
+
+                    ++*alignmentNum;
+                }
+                
+                newElement->children.append(element->children.at(i));
+                increaseOffset = true;
+            }
+            else if (element->children.at(i).data->isArray)
+            {
+                //In this case don't split it to base types because list get very long long if type has many members
+                if (element->children.at(i).data->baseType == 0 &&
+                    !element->children.at(i).data->isPointer)
+                {
+                    newElement->children.append(element->children.at(i));
+                    increaseOffset = true;
+                }
+                else
+                {
+                    if (element->children.at(i).data->baseType != 0 ||
+                        element->children.at(i).data->isPointer &&
+                        element->children.at(i).data->baseType != 0)
+                    {
+                        int arrayCount = element->dataChildren.at(i).data->arrayCount.count();
+                        int count2 = 1;
+
+                        for (int j = 0; j < arrayCount; j++)
+                        {
+                            count2 *= element->dataChildren.at(i).data->arrayCount.at(j);
+                        }
+
+                        quint32 size = 0;
+
+                        if (count2 > 0)
+                        {
+                            size = element->children.at(i).size / count2;
+                        }
+
+                        for (int j = 0; j < count2; j++)
+                        {
+                            Element newElement2 = {};
+
+                            newElement2.elementType = ElementType::dataType;
+                            newElement2.data.Edit()->name = QString("%1_%2").arg(element->children.at(i).data->name).arg(j);
+                            newElement2.data.Edit()->typeName = element->children.at(i).data->typeName;
+                            newElement2.data.Edit()->name = QString("%1_%2").arg(element->children.at(i).data->name).arg(j);
+                            newElement2.data.Edit()->dataKind = DataIsMember;
+                            newElement2.size = size;
+                            newElement2.offset = *offset;
+
+                            *offset += size;
+
+                            newElement->children.append(newElement2);
+                        }
+                    }
+                    else
+                    {
+                        int arrayCount = element->dataChildren.at(i).data->arrayCount.count();
+                        int count2 = 1;
+
+                        for (int j = 0; j < arrayCount; j++)
+                        {
+                            count2 *= element->dataChildren.at(i).data->arrayCount.at(j);
+                        }
+
+                        quint32 size = 0;
+
+                        if (count2 > 0)
+                        {
+                            size = element->children.at(i).size / count2;
+                        }
+
+                        for (int j = 0; j < count2; j++)
+                        {
+                            Element newElement2 = {};
+
+                            newElement2.elementType = ElementType::dataType;
+                            newElement2.data.Edit()->name = QString("%1_%2").arg(element->children.at(i).data->name).arg(j);
+                            newElement2.data.Edit()->typeName = element->children.at(i).data->typeName;
+                            newElement2.data.Edit()->name = QString("%1_%2").arg(element->children.at(i).data->name).arg(j);
+                            newElement2.data.Edit()->dataKind = DataIsMember;
+                            newElement2.size = size;
+                            newElement2.offset = *offset;
+
+                            *offset += size;
+
+                            newElement->children.append(newElement2);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                if (!element->children.at(i).data->isPointer &&
+                    element->children.at(i).data->baseType == 0)
+                {
+                    QString typeName = element->children.at(i).data->originalTypeName;
+                    QHash<QString, DWORD>::const_iterator it = diaSymbols->find(typeName);
+
+                    DWORD id = it.value();
+                    quint64 layoutKey = GetElementKey(id, false);
+                    QList<Element> flattenedChildren;
+                    quint64 flattenedSize = 0;
+                    IDiaSymbol* symbol;
+
+                    if (layoutCache.GetFlattenedChildren(layoutKey, flattenedChildren, flattenedSize))
+                    {
+                        AppendFlattenedChildren(flattenedChildren, newElement, *offset, alignmentNum);
+
+                        *offset += flattenedSize;
+                    }
+                    else if (GetSymbolByID(id, &symbol))
+                    {
+                        Element element2 = GetElement(symbol);
+                        symbol->Release();
+
+                        if (element2.elementType == ElementType::udtType)
+                        {
+                            CheckIfUnionsAreMissing(&element2);
+                        }
+
+                        quint64 startOffset = *offset;
+                        int startIndex = newElement->children.count();
+
+                        JoinLists(&element2);
+                        FlattenUDT(&element2, newElement, offset, alignmentNum);
+
+                        flattenedChildren = newElement->children.mid(startIndex);
+
+                        int flattenedChildrenCount = flattenedChildren.count();
+
+                        for (int j = 0; j < flattenedChildrenCount; j++)
+                        {
+                            flattenedChildren[j].offset -= startOffset;
+                        }
+
+                        layoutCache.SetFlattenedChildren(layoutKey, flattenedChildren, *offset - startOffset);
+                    }
+                }
+                else
+                {
+                    newElement->children.append(element->children.at(i));
+                    increaseOffset = true;
+                }
+            }
+
+            if (increaseOffset)
+            {
+                *offset += element->children.at(i).size;
+            }
+        }
+
+        //__m128
+        if (element->elementType == ElementType::udtType &&
+            element->udt->udtKind == UdtUnion ||
+            element->elementType == ElementType::dataType &&
+            element->data->hasChildren &&
+            element->udt->isAnonymousUnion)
+        {
+            break;
+        }
+    }
+}
+
+/*
+* Flattened children of type are cached with offsets which are relative to start of type,
+* paddings are renamed so their numbers continue from numbers of paddings which were already added
+*/
+void PDB::AppendFlattenedChildren(const QList<Element>& flattenedChildren, Element* newElement, quint64 offset, quint32* alignmentNum)
+{
+    int count = flattenedChildren.count();
+
+    for (int i = 0; i < count; i++)
+    {
+        Element child = flattenedChildren.at(i);
+
+        child.offset += offset;
+
+        if (child.elementType == ElementType::dataType &&
+            child.data->isCompilerGenerated &&
+            !child.data->isVTablePointer)
+        {
+            if (child.data->isEndPadding)
+            {
+                child.data.Edit()->name = QString("__endPadding%1").arg(*alignmentNum);
+            }
+            else
+            {
+                child.data.Edit()->name = QString("__padding%1").arg(*alignmentNum);
+            }
+
+            ++*alignmentNum;
+        }
+
+        newElement->children.append(child);
+    }
+}
+
+/*
+* Types which are currently checked are kept in checkedTypes so types which contain themselves don't cause
+* infinite recursion, alignment of types of data members is read from layout cache if it was already calculated
+*/
+quint32 PDB::CalculateDefaultAlignment(const Element* element, QSet<QString>& checkedTypes)
+{
+    quint32 alignment = 1;
+
+    if (element->elementType == ElementType::udtType &&
+        element->udt->hasVTable)
+    {
+        if (type == CV_CFL_80386)
+        {
+            alignment = 4;
+        }
+        else
+        {
+            alignment = 8;
+        }
+    }
+
+    quint32 size;
+    int baseClassChildrenCount = element->baseClassChildren.count();
+    int dataChildrenCount = element->dataChildren.count();
+
+    for (int i = 0; i < baseClassChildrenCount; i++)
+    {
+        QString name = element->baseClassChildren.at(i).baseClass->name;
+
+        if (checkedTypes.contains(name))
+        {
+            continue;
+        }
+
+        checkedTypes.insert(name);
+
+        quint32 alignment2 = CalculateDefaultAlignment(&element->baseClassChildren.at(i), checkedTypes);
+
+        checkedTypes.remove(name);
+
+        if (alignment2 > alignment)
+        {
+            alignment = alignment2;
+        }
+    }
+
+    for (int i = 0; i < dataChildrenCount; i++)
+    {
+        if (element->dataChildren.at(i).data->isCompilerGenerated)
+        {
+            continue;
+        }
+
+        size = element->dataChildren.at(i).size;
+
+        if (element->dataChildren.at(i).data->hasChildren)
+        {
+            if (element->dataChildren.at(i).data->isTypeNameOfEnum)
+            {
+                size = 4;
+
+                if (size > alignment)
+                {
+                    alignment = size;
+                }
+            }
+            else
+            {
+                Element element2 = element->dataChildren.at(i);
+                element2.elementType = ElementType::udtType;
+
+                quint32 alignment2 = CalculateDefaultAlignment(&element2, checkedTypes);
+
+                if (alignment2 > alignment)
+                {
+                    alignment = alignment2;
+                }
+            }
+
+            continue;
+        }
+        else
+        {
+            if (element->dataChildren.at(i).data->isTypeNameOfEnum)
+            {
+                size = 4;
+
+                if (size > alignment)
+                {
+                    alignment = size;
+                }
+
+                continue;
+            }
+
+            if (element->dataChildren.at(i).data->isArray)
+            {
+                if (element->dataChildren.at(i).data->isPointer ||
+                    element->dataChildren.at(i).data->baseType != 0)
+                {
+                    int arrayCount = element->dataChildren.at(i).data->arrayCount.count();
+                    int count = 1;
+
+                    for (int j = 0; j < arrayCount; j++)
+                    {
+                        count *= element->dataChildren.at(i).data->arrayCount.at(j);
+                    }
+
+                    if (count > 0)
+                    {
+                        size = element->dataChildren.at(i).size / count;
+                    }
+                }
+                else
+                {
+                    QString typeName = element->dataChildren.at(i).data->originalTypeName;
+
+                    if (checkedTypes.contains(typeName))
+                    {
+                        continue;
+                    }
+
+                    quint32 alignment2 = 0;
+
+                    if (typeName.startsWith("m128") || typeName.startsWith("_m128") || typeName.startsWith("__m128"))
+                    {
+                        alignment2 = 16;
+                    }
+                    else
+                    {
+                        checkedTypes.insert(typeName);
+
+                        alignment2 = GetDefaultAlignment(typeName, element->dataChildren.at(i).data->isTypeNameOfEnum, checkedTypes);
+
+                        checkedTypes.remove(typeName);
+                    }
+
+                    if (alignment2 > alignment)
+                    {
+                        alignment = alignment2;
+                    }
+
+                    continue;
+                }
+            }
+
+            if (!element->dataChildren.at(i).data->isPointer)
+            {
+                if ((element->dataChildren.at(i).data->typeName != element->udt->name) &&
+                    element->dataChildren.at(i).data->baseType == 0)
+                {
+                    QString typeName = element->dataChildren.at(i).data->originalTypeName;
+
+                    if (checkedTypes.contains(typeName))
+                    {
+                        continue;
+                    }
+
+                    quint32 alignment2 = 0;
+                    QString lower = typeName.toLower();
+
+                    if (lower.startsWith("m128") || lower.startsWith("_m128") || lower.startsWith("__m128"))
+                    {
+                        alignment2 = 16;
+                    }
+                    else
+                    {
+                        checkedTypes.insert(typeName);
+
+                        alignment2 = GetDefaultAlignment(typeName, element->dataChildren.at(i).data->isTypeNameOfEnum, checkedTypes);
+
+                        checkedTypes.remove(typeName);
+                    }
+
+                    if (alignment2 > alignment)
+                    {
+                        alignment = alignment2;
+                    }
+
+                    continue;
+                }
+            }
+        }
+
+        if (size > alignment)
+        {
+            alignment = size;
+        }
+    }
+
+    return alignment;
+}
+
+quint32 PDB::GetDefaultAlignment(const QString& typeName, bool isEnum, QSet<QString>& checkedTypes)
+{
+    QHash<QString, DWORD>::const_iterator it = diaSymbols->find(typeName);
+
+    if (it == diaSymbols->end())
+    {
+        return 1;
+    }
+
+    DWORD id = it.value();
+    quint64 layoutKey = GetElementKey(id, true);
+    quint64 alignment = 0;
+
+    if (layoutCache.GetValue(layoutKey, LayoutField::naturalAlignment, alignment))
+    {
+        return static_cast<quint32>(alignment);
+    }
+
+    SymbolRecord symbolRecord;
+
+    symbolRecord.id = id;
+    symbolRecord.typeName = typeName;
+
+    //It's only important to detect if type is enum because enums shouldn't be imported
+    if (isEnum)
+    {
+        symbolRecord.type = SymbolType::enumType;
+    }
+
+    Element element = GetElement(&symbolRecord);
+
+    alignment = CalculateDefaultAlignment(&element, checkedTypes);
+
+    layoutCache.SetValue(layoutKey, LayoutField::naturalAlignment, alignment);
+
+    return static_cast<quint32>(alignment);
+}
+
+quint32 PDB::GetCorrectAlignment(quint32 defaultAlignment, quint32 typeSize)
+{
+    while ((typeSize & (defaultAlignment - 1)) > 0)
+    {
+        defaultAlignment >>= 1;
+    }
+
+    return defaultAlignment;
+}
+
+unsigned int PDB::GetGreatestPaddingInUDT(const Element* element)
+{
+    unsigned int greatestPadding = 0;
+    bool isCacheable = element->elementType == ElementType::udtType && element->udt->id != 0;
+    quint64 layoutKey = isCacheable ? GetElementKey(element->udt->id, true) : 0;
+    quint64 cachedPadding = 0;
+
+    if (isCacheable && layoutCache.GetValue(layoutKey, LayoutField::greatestPadding, cachedPadding))
+    {
+        return static_cast<unsigned int>(cachedPadding);
+    }
+
+    int dataChildrenCount = element->dataChildren.count();
+
+    for (int i = 0; i < dataChildrenCount; i++)
+    {
+        if (element->dataChildren.at(i).data->isPadding &&
+            element->dataChildren.at(i).size > greatestPadding)
+        {
+            greatestPadding = element->dataChildren.at(i).size;
+        }
+    }
+
+    if (isCacheable)
+    {
+        layoutCache.SetValue(layoutKey, LayoutField::greatestPadding, greatestPadding);
+    }
+
+    return greatestPadding;
+}
+
+unsigned int PDB::NextPowerOf2(unsigned int value)
+{
+	unsigned long index;
+
+	_BitScanReverse(&index, --value);
+
+    if (value == 0)
+    {
+        index = static_cast<unsigned long>(-1);
+    }
+
+    return 1U << (index + 1);
+}
+
+QString PDB::TrimStart(const QString& input)
+{
+    QString result = input;
+
+    while (result.count() > 0 && result.at(0).isSpace())
+    {
+        result = result.right(result.count() - 1);
+    }
+
+    return result;
+}
+
+QString PDB::TrimEnd(const QString& input)
+{
+    QString result = input;
+
+    while (result.count() > 0 && result.at(result.count() - 1).isSpace())
+    {
+        result = result.left(result.count() - 1);
+    }
+
+    return result;
+}
+
+QString PDB::FunctionTypeToString(const Element* element, const FunctionOptions* functionOptions)
+{
+    ResolutionContext* context = GetResolutionContext();
+    Function function = *element->function;
+    QString result;
+
+    //Don't add keywords to prototypes while comparing prototypes because they will be compared faster then
+    if (functionOptions->addKeywordsAndParameterNames)
+    {
+        if (function.hasInlSpec && options->addInlineKeywordToInlineFunctions)
+        {
+            result += "inline";
+        }
+        else if (function.isNaked && options->addDeclspecKeywords)
+        {
+            result += "__declspec(naked)";
+        }
+        else if (function.isNoInline && options->addDeclspecKeywords)
+        {
+            result += "__declspec(noinline)";
+        }
+        else if (function.isNoReturn && options->addDeclspecKeywords)
+        {
+            result += "__declspec(noreturn)";
+        }
+
+        //Don't add virtual and static keywords while generating C++ code
+        if (functionOptions->addStaticAndVirtualKeywords)
+        {
+            if (function.isVirtual && !function.isOverridden)
+            {
+                result += "virtual";
+            }
+            else if (function.isStatic)
+            {
+                if (!(element->dataChildren.count() > 0 &&
+                    element->dataChildren.at(0).data->dataKind == DataIsObjectPtr))
+                {
+                    result += "static";
+                }
+            }
+        }
+
+        if (function.isConstructor &&
+            function.parameters.count() == 1 &&
+            options->addExplicitKeyword)
+        {
+            result += "explicit";
+        }
+    }
+
+    if (result.length() > 0)
+    {
+        result += " ";
+    }
+
+    if (!options->includeConstKeyword)
+    {
+        if (function.returnType2.contains(", const"))
+        {
+            function.returnType2.replace(" const", " ");
+        }
+        else if (function.returnType2.contains(" const"))
+        {
+            function.returnType2.replace(" const", "");
+        }
+        else if (function.returnType2.contains("const "))
+        {
+            function.returnType2.replace("const ", "");
+        }
+    }
+
+    QString functionReturnType = function.returnType2;
+
+    if (!function.isConstructor &&
+        !function.isDefaultConstructor &&
+        !function.isCopyConstructor &&
+        !function.isDestructor &&
+        !function.returnsFunctionPointer &&
+        !function.isCastOperator)
+    {
+        if (functionOptions->addKeywordsAndParameterNames)
+        {
+            result += QString("%1 ").arg(functionReturnType);
+        }
+        else
+        {
+            result += QString("%1 ").arg(function.originalReturnType);
+        }
+    }
+
+    if (function.returnsFunctionPointer)
+    {
+        if (options->displayWithTrailingReturnType || options->displayWithAuto)
+        {
+            result += "auto ";
+        }
+        else if (options->displayWithTypedef || options->displayWithUsing)
+        {
+            QString functionName = function.name;
+
+            functionName[0] = functionName.at(0).toLower();
+
+            QString functionPointerName = QString("%1Ptr").arg(functionName);
+            QString declaration;
+            Element newElement = {};
+
+            result += QString("%1 ").arg(functionPointerName);
+
+            newElement.elementType = ElementType::typedefType;
+            newElement.typeDef.Edit()->oldTypeName = functionReturnType;
+            newElement.typeDef.Edit()->newTypeName = functionPointerName;
+
+            if (options->displayWithTypedef)
+            {
+                if (options->displayCallingConventionForFunctionPointers)
+                {
+                    functionPointerName.prepend(" ");
+                }
+
+                functionReturnType = functionReturnType.insert(functionReturnType.indexOf("*)(") + 1,
+                    functionPointerName);
+
+                declaration = QString("typedef %1").arg(functionReturnType);
+            }
+            else
+            {
+                declaration = QString("using %1 = %2").arg(functionPointerName).arg(functionReturnType);
+            }
+
+            newElement.typeDef.Edit()->declaration = declaration;
+
+            context->typedefChildren.append(newElement);
+        }
+    }
+
+    if (functionOptions->addKeywordsAndParameterNames && options->displayCallingConventions)
+    {
+        //If function is variadic calling convention is __cdecl so there is no need display __cdecl
+        if ((function.isStatic &&
+            (function.callingConvention != CV_CALL_NEAR_C &&
+                function.callingConvention != CV_CALL_FAR_C)) &&
+            !function.isVariadic && function.callingConvention != CV_CALL_THISCALL)
+        {
+            result += QString("%1 ").arg(convertCallingConventionToString(function.callingConvention));
+        }
+    }
+
+    if (options->modifyFunctionNames)
+    {
+        function.name = ModifyNamingCovention(function.name, false, true, false);
+    }
+
+    if (functionOptions->appendCurrentUDTName)
+    {
+        result += QString("%1::").arg(function.parentClassName);
+    }
+    else
+    {
+        if (context->RemoveScopeResolutionOperator() && function.name.contains("::"))
+        {
+            if (function.parentClassName.length() == 0)
+            {
+                RemoveScopeResolutionOperators(function.name, context->parentClassName);
+            }
+            else
+            {
+                RemoveScopeResolutionOperators(function.name, function.parentClassName);
+            }
+        }
+    }
+
+    result += function.name;
+    result += "(";
+
+    int parametersCount = element->function->parameters.count();
+
+    if (element->function->isVariadic)
+    {
+        parametersCount--;
+    }
+
+    if (!functionOptions->addKeywordsAndParameterNames)
+    {
+        for (int i = 0; i < parametersCount; i++)
+        {
+            //result += element->function->parameters.at(i);
+            result += element->function->originalParameters.at(i);
+
+            if (i != parametersCount - 1)
+            {
+                result += ", ";
+            }
+        }
+
+        if (element->function->isVariadic)
+        {
+            if (parametersCount > 0)
+            {
+                result += ", ";
+            }
+
+            result += "...";
+            //result += "va_list";
+        }
+    }
+    else
+    {
+        int n = 0;
+        int parameterNamesCount = element->dataChildren.count();
+
+        if (functionOptions->displayThisPointer &&
+            parameterNamesCount > 0 &&
+            element->dataChildren.at(0).data->dataKind == DataIsObjectPtr)
+		{
+            static const DataOptions dataOptions = {};
+
+            result += DataTypeToString(&*element->dataChildren.at(0).data, &dataOptions);
+
+            if (parametersCount > 0)
+            {
+                result += ", ";
+            }
+		}
+
+        for (int i = 0; i < parametersCount; i++)
+        {
+            QString parameterType = element->function->parameters.at(i);
+            QString parameterName;
+            bool isParameterFunctionPointer = false;
+
+            if (!options->includeConstKeyword)
+            {
+                if (parameterType.contains("<") && parameterType.contains(" const"))
+                {
+                    parameterType.replace(" const", "");
+                }
+
+                if (parameterType.startsWith("const "))
+                {
+                    parameterType.remove(0, 6);
+                }
+            }
+
+            if (parameterType.contains("(*)"))
+            {
+                isParameterFunctionPointer = true;
+            }
+            else
+            {
+                result += parameterType;
+            }
+
+            if (parameterNamesCount > 0)
+            {
+                if (i == 0 && element->dataChildren.at(0).data->dataKind == DataIsObjectPtr)
+                {
+                    n++;
+                }
+
+                if (n < parameterNamesCount)
+                {
+                    parameterName = element->dataChildren.at(n++).data->name;
+                }
+                else
+                {
+                    parameterName = GenerateCustomParameterName(parameterType, i);
+                }
+            }
+            else
+            {
+                parameterName = GenerateCustomParameterName(parameterType, i);
+            }
+
+            if (options->modifyVariableNames)
+            {
+                parameterName = ModifyNamingCovention(parameterName, false, false, true);
+            }
+
+            if (context->functionParameterNames.contains(parameterName))
+            {
+                parameterName += QString("%1").arg(i);
+            }
+
+            context->functionParameterNames.append(parameterName);
+
+            if (isParameterFunctionPointer)
+            {
+                parameterType.insert(parameterType.indexOf("(*)") + 2, parameterName);
+
+                result += parameterType;
+            }
+            else
+            {
+                result += QString(" %1").arg(parameterName);
+            }
+
+            if (i != parametersCount - 1)
+            {
+                result += ", ";
+            }
+        }
+
+        if (element->function->isVariadic)
+        {
+            if (parametersCount > 0)
+            {
+                result += ", ";
+            }
+
+            if (options->useVAList)
+            {
+                result += "...";
+
+                //result += "va_list argumentsList";
+            }
+            else if (options->useTemplateFunction)
+            {
+                result += "Args... args";
+            }
+        }
+
+        context->functionParameterNames.clear();
+    }
+
+    result += ")";
+
+    if (function.isConst && options->includeConstKeyword)
+    {
+        result += " const";
+    }
+
+    if (function.isVolatile && options->includeVolatileKeyword)
+    {
+        result += " volatile";
+    }
+
+    /*
+    * Before checking whether it's pure virtual function 
+    * check first whether it's virtual because static functions can be marked as pure also
+    */
+    if (functionOptions->addKeywordsAndParameterNames)
+    {
+        if (function.isVirtual && functionOptions->addStaticAndVirtualKeywords)
+        {
+            if (function.isPure)
+            {
+                result += " = 0";
+            }
+            else if (function.isOverridden)
+            {
+                result += " override";
+            }
+        }
+
+        if (function.isDestructor && options->addNoexceptKeyword)
+        {
+            result += " noexcept";
+        }
+
+        if (functionOptions->addStaticAndVirtualKeywords &&
+            !function.isPure &&
+            (function.isDefaultConstructor ||
+                function.isCopyConstructor ||
+                function.isCopyAssignmentOperator ||
+                function.isDestructor))
+        {
+            result += " = default";
+        }
+    }
+
+    if (function.returnsFunctionPointer && options->displayWithTrailingReturnType)
+    {
+        result += QString(" -> %1").arg(functionReturnType);
+    }
+
+    return result;
+}
+
+QString PDB::GenerateCustomParameterName(QString parameterType, int i)
+{
+    ResolutionContext* context = GetResolutionContext();
+    QString result = "";
+
+    if (parameterType.length() > 0)
+    {
+        if (parameterType.contains(", const"))
+        {
+            parameterType.replace(" const", " ");
+        }
+        else if (parameterType.contains(" const"))
+        {
+            parameterType.replace(" const", "");
+        }
+        else if (parameterType.contains("const "))
+        {
+            parameterType.replace("const ", "");
+        }
+
+        if (parameterType.contains("<"))
+        {
+            parameterType = parameterType.mid(0, parameterType.indexOf('<'));
+        }
+
+        if (parameterType.contains("::"))
+        {
+            parameterType = parameterType.mid(parameterType.lastIndexOf("::") + 2);
+        }
+    }
+
+    if (parameterType.length() > 0 && parameterType.at(0).isUpper())
+    {
+        //Example: ENTITY_REF -> entityRef
+        if (parameterType.contains("_"))
+        {
+            QStringList parts = parameterType.split('_', QString::SkipEmptyParts);
+
+            parts[0] = parts[0].toLower();
+
+            for (int i = 1; i < parts.size(); ++i)
+            {
+                QString part = parts.at(i);
+
+                parts[i] = part.at(0);
+                parts[i] += part.mid(1).toLower();
+            }
+
+            result = parts.join("");
+
+            if (result.contains("*"))
+            {
+                result = result.mid(0, result.indexOf('*'));
+            }
+            else if (parameterType.contains("&"))
+            {
+                result = result.mid(0, result.indexOf('&'));
+            }
+
+            if (context->functionParameterNames.contains(result))
+            {
+                result += QString("%1").arg(i + 1);
+            }
+        }
+        else
+        {
+            //Example: EntityRef -> entityRef
+            for (int j = 0; j < parameterType.length(); j++)
+            {
+                if (j > 0 && parameterType.at(j).isLower() && parameterType.at(j - 1).isUpper())
+                {
+                    result += parameterType.at(j - 1).toLower();
+
+                    if (parameterType.contains("*"))
+                    {
+                        result += parameterType.mid(j, parameterType.indexOf('*') - j);
+                    }
+                    else if (parameterType.contains("&"))
+                    {
+                        result += parameterType.mid(j, parameterType.indexOf('&') - j);
+                    }
+                    else
+                    {
+                        result += parameterType.mid(j);
+                    }
+
+                    if (context->functionParameterNames.contains(result))
+                    {
+                        result += QString("%1").arg(i + 1);
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        /*if (functionParameterNames.contains(result))
+        {
+            result += QString("%1").arg(i + 1);
+        }*/
+
+        /*if (result.length() == 0)
+        {
+            result += QString("param%1").arg(i + 1);
+        }*/
+
+        if (result.length() == 0)
+        {
+            for (int j = 0; j < parameterType.length(); j++)
+            {
+                if (parameterType.at(j).isLetter())
+                {
+                    result += parameterType.at(j).toLower();
+                }
+            }
+
+            if (context->functionParameterNames.contains(result))
+            {
+                result += QString("%1").arg(i + 1);
+            }
+        }
+    }
+    else
+    {
+        if (options->useGhidraNameStyle)
+        {
+            result += QString("param%1").arg(i + 1);
+        }
+        else
+        {
+            result += QString("p%1").arg(i + 1);
+        }
+    }
+
+    return result;
+}
+
+QString PDB::GenerateCPPCode(const Element* element, int level)
+{
+    TextBuilder cppCode;
+
+    GenerateCPPCode(element, cppCode, level);
+
+    return cppCode.ToString();
+}
+
+/*
+* Code of nested types is added directly to code, functions of type are generated in separate string
+* so parameter names can be inserted into function which is currently generated
+*/
+void PDB::GenerateCPPCode(const Element* element, TextBuilder& code, int level)
+{
+    ResolutionContext* context = GetResolutionContext();
+    QString cppCode = "";
+    int udtChildrenCount = element->udtChildren.count();
+    int functionChildrenCount = element->virtualFunctionChildren.count() + element->nonVirtualFunctionChildren.count();
+    QList<Element> children;
+
+    children.append(element->virtualFunctionChildren);
+    children.append(element->nonVirtualFunctionChildren);
+
+    for (int i = 0; i < udtChildrenCount; i++)
+    {
+        GenerateCPPCode(&element->udtChildren.at(i), code, level + 1);
+    }
+
+    for (int i = 0; i < functionChildrenCount; i++)
+    {
+        DWORD functionOffset = children.at(i).function->relativeVirtualAddress;
+        int functionBegin = cppCode.length();
+
+        if (functionOffset == 0 &&
+            !options->displayNonImplementedFunctions &&
+            /*!children.at(i).function->isGeneratedByApp &&*/ //default keyword is added in this case so compiler will implement it
+            !children.at(i).function->isDefaultConstructor &&
+            !children.at(i).function->isDestructor &&
+            !(children.at(i).function->isCopyConstructor &&
+                options->applyRuleOfThree) &&
+            !(children.at(i).function->isCopyAssignmentOperator &&
+                options->applyRuleOfThree))
+        {
+            continue;
+        }
+
+        if (children.at(i).function->isVariadic && options->useTemplateFunction)
+        {
+            continue;
+        }
+
+        QString udtName = children.at(i).function->parentClassName;
+
+        if (children.at(i).function->isVirtual &&
+            children.at(i).function->indexOfVTable > 0)
+        {
+            udtName = element->udt->vTableNames.value(children.at(i).function->indexOfVTable);
+        }
+
+        QList<QString> parameterTypes = children.at(i).function->parameters;
+        QString functionName = children.at(i).function->name;
+
+        int parameterTypesCount = parameterTypes.count();
+
+        if (children.at(i).function->isVariadic)
+        {
+            parameterTypesCount--;
+        }
+
+        int parameterNamesCount = children.at(i).dataChildren.count();
+
+        static const FunctionOptions functionOptions = { true, false, false, true };
+        QString functionPrototype = FunctionTypeToString(const_cast<Element*>(&children.at(i)), &functionOptions);
+
+		cppCode += QString("%1\r\n{\r\n\t").arg(functionPrototype);
+
+		if (children.at(i).function->isVariadic)
+		{
+            if (children.at(i).function->isVirtual)
+            {
+                int vTableIndex = children.at(i).function->virtualBaseOffset >> 2;
+
+                cppCode += QString("usigned int address = *reinterpret_cast<void***>(this))[%1]\r\n\t").arg(vTableIndex);
+            }
+
+            if (options->useVAList)
+            {
+                cppCode += "va_list argumentsList;\r\n\r\n\t";
+                cppCode += QString("va_start(argumentsList, %1);\r\n\r\n\t").arg(children.at(i).dataChildren.last().data->name);
+            }
+		}
+
+        if (children.at(i).function->isVirtual ||
+            (children.at(i).function->isVirtual &&
+                children.at(i).function->isPure &&
+                functionOffset > 0))
+        {
+            if (children.at(i).function->isDestructor)
+            {
+                if (element->udt->isNested)
+                {
+                    if (options->implementDefaultConstructorAndDestructor && !options->implementMethodsOfInnerUDT)
+                    {
+                        continue;
+                    }
+                }
+                else if (!options->implementDefaultConstructorAndDestructor)
+                {
+                    continue;
+                }
+            }
+
+            int vTableIndex = children.at(i).function->virtualBaseOffset >> 2;
+
+            /*
+            * Virtual destructor implementation shouldn't call original destructor.
+            * Instead of calling original destructor copy destructor's decompiled code from IDA or Ghidra
+            */
+            if (children.at(i).function->isDestructor)
+            {
+                context->hasVirtualDestructor = true;
+                cppCode += QString("\r\n}\r\n\r\n");
+
+                continue;
+            }
+
+            if (children.at(i).function->isGeneratedByApp)
+            {
+                cppCode += QString("\r\n}\r\n\r\n");
+
+                continue;
+            }
+
+            if (children.at(i).function->returnType1.baseType == 1 &&
+                !(children.at(i).function->returnType1.isPointer ||
+                    children.at(i).function->returnType1.isReference))
+            {
+                if (children.at(i).function->isVariadic)
+                {
+					if (children.at(i).function->isConst)
+					{
+						cppCode += QString("Function::Call<const %1*").arg(udtName);
+					}
+					else
+					{
+						cppCode += QString("Function::Call<%1*").arg(udtName);
+					}
+                }
+                else
+                {
+                    if (children.at(i).function->isConst)
+                    {
+                        cppCode += QString("Function::CallConstVirtualMethod<%1, const %2*").arg(vTableIndex).arg(udtName);
+                    }
+                    else
+                    {
+                        cppCode += QString("Function::CallVirtualMethod<%1, %2*").arg(vTableIndex).arg(udtName);
+                    }
+                }
+            }
+            else
+            {
+                QString returnType = children.at(i).function->returnType2;
+
+                if (!options->includeConstKeyword)
+                {
+                    if (returnType.contains("<") && returnType.contains(" const"))
+                    {
+                        returnType.replace(" const", "");
+                    }
+                }
+
+                if (children.at(i).function->isRVOApplied)
+                {
+                    if (children.at(i).function->isVariadic)
+                    {
+						if (children.at(i).function->isConst)
+						{
+                            cppCode += QString("return Function::CallRVOAndReturn<%1, const %2*").arg(returnType).arg(udtName);
+						}
+						else
+						{
+                            cppCode += QString("return Function::CallRVOAndReturn<%1, %2*").arg(returnType).arg(udtName);
+						}
+                    }
+                    else
+                    {
+                        if (children.at(i).function->isConst)
+                        {
+                            cppCode += QString("return Function::CallRVOConstVirtualMethodAndReturn<%1, %2, const %3*").arg(returnType)
+                                .arg(vTableIndex).arg(udtName);
+                        }
+                        else
+                        {
+                            cppCode += QString("return Function::CallRVOVirtualMethodAndReturn<%1, %2, %3*").arg(returnType)
+                                .arg(vTableIndex).arg(udtName);
+                        }
+                    }
+                }
+                else
+                {
+					if (children.at(i).function->isVariadic)
+					{
+						if (children.at(i).function->isConst)
+						{
+                            cppCode += QString("return Function::CallAndReturn<%1, const %2*").arg(returnType).arg(udtName);
+						}
+						else
+						{
+                            cppCode += QString("return Function::CallAndReturn<%1, %2*").arg(returnType).arg(udtName);
+						}
+					}
+                    else
+                    {
+                        if (children.at(i).function->isConst)
+                        {
+                            cppCode += QString("return Function::CallConstVirtualMethodAndReturn<%1, %2, const %3*").arg(returnType)
+                                .arg(vTableIndex).arg(udtName);
+                        }
+                        else
+                        {
+                            cppCode += QString("return Function::CallVirtualMethodAndReturn<%1, %2, %3*").arg(returnType)
+                                .arg(vTableIndex).arg(udtName);
+                        }
+                    }
+                }
+            }
+
+            if (parameterTypesCount > 0)
+            {
+                cppCode += ", ";
+            }
+        }
+        else
+        {
+            if (children.at(i).function->isDefaultConstructor || children.at(i).function->isDestructor)
+            {
+                if (element->udt->isNested)
+                {
+                    if (options->implementDefaultConstructorAndDestructor && !options->implementMethodsOfInnerUDT)
+                    {
+                        continue;
+                    }
+                }
+                else if (!options->implementDefaultConstructorAndDestructor)
+                {
+                    continue;
+                }
+            }
+
+            /*
+            * Constructor implementation shouldn't call original constructor if class/struct has virtual destructor.
+            * Instead of calling original constructor copy constructor's decompiled code from IDA or Ghidra
+            */
+            if (children.at(i).function->isDefaultConstructor && context->hasVirtualDestructor)
+            {
+                cppCode += QString("\r\n}\r\n\r\n");
+
+                continue;
+            }
+
+            /*if ((children.at(i).function->isDefaultConstructor ||
+                children.at(i).function->isConstructor) &&
+                context->hasVirtualDestructor)
+            {
+                cppCode += QString("\r\n}\r\n\r\n");
+
+                continue;
+            }*/
+
+            if (children.at(i).function->isGeneratedByApp)
+            {
+                cppCode += QString("\r\n}\r\n\r\n");
+
+                continue;
+            }
+
+            if (functionOffset == 0 &&
+                (children.at(i).function->isDefaultConstructor ||
+                    children.at(i).function->isConstructor ||
+                    children.at(i).function->isCopyConstructor ||
+                    children.at(i).function->isCopyAssignmentOperator ||
+                    children.at(i).function->isDestructor))
+            {
+                cppCode += QString("\r\n}\r\n\r\n");
+
+                continue;
+            }
+
+            if (children.at(i).function->returnType1.baseType == 1 &&
+                !(children.at(i).function->returnType1.isPointer ||
+                    children.at(i).function->returnType1.isReference))
+            {
+                switch (children.at(i).function->callingConvention)
+                {
+                case CV_CALL_THISCALL:
+                {
+                    if (children.at(i).function->isConst)
+                    {
+                        cppCode += QString("Function::CallMethod<const %1*").arg(udtName);
+                    }
+                    else
+                    {
+                        cppCode += QString("Function::CallMethod<%1*").arg(udtName);
+                    }
+
+                    if (parameterTypesCount > 0)
+                    {
+                        cppCode += ", ";
+                    }
+
+                    break;
+                }
+                case CV_CALL_NEAR_FAST:
+                case CV_CALL_FAR_FAST:
+                    cppCode += QString("Function::FastCall<");
+
+                    break;
+                case CV_CALL_NEAR_STD:
+                case CV_CALL_FAR_STD:
+                    cppCode += QString("Function::StdCall<");
+
+                    break;
+                case CV_CALL_NEAR_C:
+                case CV_CALL_FAR_C:
+                    cppCode += QString("Function::Call<");
+
+                    if (children.at(i).dataChildren.count() > 0 &&
+                        children.at(i).dataChildren.at(0).data->dataKind == DataIsObjectPtr)
+					{
+                        if (children.at(i).function->isConst)
+                        {
+                            cppCode += QString("const %1*").arg(children.at(i).dataChildren.at(0).data->typeName);
+                        }
+                        else
+                        {
+                            cppCode += QString("%1*").arg(children.at(i).dataChildren.at(0).data->typeName);
+                        }
+
+						if (parameterTypesCount > 0)
+						{
+							cppCode += ", ";
+						}
+					}
+
+                    break;
+                case CV_CALL_NEAR_VECTOR:
+                    cppCode += QString("Function::VectorCall<");
+
+                    break;
+                }
+            }
+            else
+            {
+                QString returnType = children.at(i).function->returnType2;
+
+                if (!options->includeConstKeyword)
+                {
+                    if (returnType.contains("<") && returnType.contains(" const"))
+                    {
+                        returnType.replace(" const", "");
+                    }
+                }
+
+                switch (children.at(i).function->callingConvention)
+                {
+                case CV_CALL_THISCALL:
+                {
+                    if (children.at(i).function->isRVOApplied)
+                    {
+						if (children.at(i).function->isConst)
+						{
+							cppCode += QString("return Function::CallRVOMethodAndReturn<%1, const %2*").arg(returnType).arg(udtName);
+						}
+						else
+						{
+							cppCode += QString("return Function::CallRVOMethodAndReturn<%1, %2*").arg(returnType).arg(udtName);
+						}
+                    }
+                    else
+                    {
+                        if (children.at(i).function->isConst)
+                        {
+                            cppCode += QString("return Function::CallMethodAndReturn<%1, const %2*").arg(returnType).arg(udtName);
+                        }
+                        else
+                        {
+                            cppCode += QString("return Function::CallMethodAndReturn<%1, %2*").arg(returnType).arg(udtName);
+                        }
+                    }
+
+                    break;
+                }
+                case CV_CALL_NEAR_FAST:
+                case CV_CALL_FAR_FAST:
+                    if (children.at(i).function->isRVOApplied)
+                    {
+                        cppCode += QString("return Function::FastCallRVOAndReturn<%1").arg(returnType);
+                    }
+                    else
+                    {
+                        cppCode += QString("return Function::FastCallAndReturn<%1").arg(returnType);
+                    }
+
+                    break;
+                case CV_CALL_NEAR_STD:
+                case CV_CALL_FAR_STD:
+                    if (children.at(i).function->isRVOApplied)
+                    {
+                        cppCode += QString("return Function::StdCallRVOAndReturn<%1").arg(returnType);
+                    }
+                    else
+                    {
+                        cppCode += QString("return Function::StdCallAndReturn<%1").arg(returnType);
+                    }
+
+                    break;
+                case CV_CALL_NEAR_C:
+                case CV_CALL_FAR_C:
+                    if (children.at(i).function->isRVOApplied)
+                    {
+                        cppCode += QString("return Function::CallRVOAndReturn<%1").arg(returnType);
+                    }
+                    else
+                    {
+                        cppCode += QString("return Function::CallAndReturn<%1").arg(returnType);
+                    }
+
+                    if (children.at(i).dataChildren.count() > 0 &&
+                        children.at(i).dataChildren.at(0).data->dataKind == DataIsObjectPtr)
+                    {
+                        if (children.at(i).function->isConst)
+                        {
+                            cppCode += QString(", const %1*").arg(children.at(i).dataChildren.at(0).data->typeName);
+                        }
+                        else
+                        {
+                            cppCode += QString(", %1*").arg(children.at(i).dataChildren.at(0).data->typeName);
+                        }
+                    }
 
-    if (element->function.isVariadic)
-    {
-        parametersCount--;
-    }
+                    break;
+                case CV_CALL_NEAR_VECTOR:
+                    if (children.at(i).function->isRVOApplied)
+                    {
+                        cppCode += QString("return Function::VectorCallRVOAndReturn<%1");
+                    }
+                    else
+                    {
+                        cppCode += QString("return Function::VectorCallAndReturn<%1");
+                    }
 
-    if (!functionOptions->addKeywordsAndParameterNames)
-    {
-        for (int i = 0; i < parametersCount; i++)
-        {
-            //result += element->function.parameters.at(i);
-            result += element->function.originalParameters.at(i);
+                    break;
+                }
 
-            if (i != parametersCount - 1)
-            {
-                result += ", ";
+                if (parameterTypesCount > 0)
+                {
+                    cppCode += ", ";
+                }
             }
-        }
 
-        if (element->function.isVariadic)
-        {
-            if (parametersCount > 0)
+            /*if (parameterTypesCount > 0)
             {
-                result += ", ";
-            }
-
-            result += "...";
-            //result += "va_list";
+                cppCode += ", ";
+            }*/
         }
-    }
-    else
-    {
-        int n = 0;
-        int parameterNamesCount = element->dataChildren.count();
-
-        if (functionOptions->displayThisPointer &&
-            parameterNamesCount > 0 &&
-            element->dataChildren.at(0).data.dataKind == DataIsObjectPtr)
-		{
-            static const DataOptions dataOptions = {};
-
-            result += DataTypeToString(&element->dataChildren.at(0).data, &dataOptions);
-
-            if (parametersCount > 0)
-            {
-                result += ", ";
-            }
-		}
 
-        for (int i = 0; i < parametersCount; i++)
+        for (int j = 0; j < parameterTypesCount; j++)
         {
-            QString parameterType = element->function.parameters.at(i);
-            QString parameterName;
-            bool isParameterFunctionPointer = false;
+            static const DataOptions dataOptions = { true, false };
+            QString parameterType = parameterTypes.at(j);
 
             if (!options->includeConstKeyword)
             {
@@ -9198,1771 +10874,1571 @@ QString PDB::FunctionTypeToString(const Element* element, const FunctionOptions*
                 }
             }
 
-            if (parameterType.contains("(*)"))
-            {
-                isParameterFunctionPointer = true;
-            }
-            else
-            {
-                result += parameterType;
-            }
-
-            if (parameterNamesCount > 0)
-            {
-                if (i == 0 && element->dataChildren.at(0).data.dataKind == DataIsObjectPtr)
-                {
-                    n++;
-                }
-
-                if (n < parameterNamesCount)
-                {
-                    parameterName = element->dataChildren.at(n++).data.name;
-                }
-                else
-                {
-                    parameterName = GenerateCustomParameterName(parameterType, i);
-                }
-            }
-            else
-            {
-                parameterName = GenerateCustomParameterName(parameterType, i);
-            }
-
-            if (options->modifyVariableNames)
-            {
-                parameterName = ModifyNamingCovention(parameterName, false, false, true);
-            }
-
-            if (functionParameterNames.contains(parameterName))
-            {
-                parameterName += QString("%1").arg(i);
-            }
-
-            functionParameterNames.append(parameterName);
-
-            if (isParameterFunctionPointer)
-            {
-                parameterType.insert(parameterType.indexOf("(*)") + 2, parameterName);
-
-                result += parameterType;
-            }
-            else
-            {
-                result += QString(" %1").arg(parameterName);
-            }
+            cppCode += parameterType;
 
-            if (i != parametersCount - 1)
+            if (j != parameterTypesCount - 1)
             {
-                result += ", ";
+                cppCode += ", ";
             }
         }
 
-        if (element->function.isVariadic)
+        if (children.at(i).function->isVariadic)
         {
-            if (parametersCount > 0)
+            if (parameterTypesCount > 0)
             {
-                result += ", ";
+                cppCode += ", ";
             }
 
             if (options->useVAList)
             {
-                result += "...";
-
-                //result += "va_list argumentsList";
+                cppCode += "va_list";
             }
-            else if (options->useTemplateFunction)
+            else
             {
-                result += "Args... args";
+                cppCode += "Args...";
             }
         }
 
-        functionParameterNames.clear();
-    }
-
-    result += ")";
-
-    if (function.isConst && options->includeConstKeyword)
-    {
-        result += " const";
-    }
-
-    if (function.isVolatile && options->includeVolatileKeyword)
-    {
-        result += " volatile";
-    }
+        cppCode += ">(";
 
-    /*
-    * Before checking whether it's pure virtual function 
-    * check first whether it's virtual because static functions can be marked as pure also
-    */
-    if (functionOptions->addKeywordsAndParameterNames)
-    {
-        if (function.isVirtual && functionOptions->addStaticAndVirtualKeywords)
+        if (children.at(i).function->isVirtual)
         {
-            if (function.isPure)
-            {
-                result += " = 0";
-            }
-            else if (function.isOverridden)
-            {
-                result += " override";
-            }
-        }
+			if (children.at(i).function->isVariadic)
+			{
+                cppCode += "address";
 
-        if (function.isDestructor && options->addNoexceptKeyword)
-        {
-            result += " noexcept";
+				if (parameterNamesCount > 0)
+				{
+					cppCode += ", ";
+				}
+			}
         }
-
-        if (functionOptions->addStaticAndVirtualKeywords &&
-            !function.isPure &&
-            (function.isDefaultConstructor ||
-                function.isCopyConstructor ||
-                function.isCopyAssignmentOperator ||
-                function.isDestructor))
+        else
         {
-            result += " = default";
-        }
-    }
-
-    if (function.returnsFunctionPointer && options->displayWithTrailingReturnType)
-    {
-        result += QString(" -> %1").arg(functionReturnType);
-    }
-
-    return result;
-}
+            QString baseAddressVariableName = GetBaseAddressVariableName();
 
-QString PDB::GenerateCustomParameterName(QString parameterType, int i)
-{
-    QString result = "";
+			DWORD functionOffset = children.at(i).function->relativeVirtualAddress;
+			QString offset = QString::number(functionOffset, 16).toUpper();
 
-    if (parameterType.length() > 0)
-    {
-        if (parameterType.contains(", const"))
-        {
-            parameterType.replace(" const", " ");
-        }
-        else if (parameterType.contains(" const"))
-        {
-            parameterType.replace(" const", "");
-        }
-        else if (parameterType.contains("const "))
-        {
-            parameterType.replace("const ", "");
-        }
+			cppCode += QString("BaseAddresses::%1 + 0x%2").arg(baseAddressVariableName).arg(offset);
 
-        if (parameterType.contains("<"))
-        {
-            parameterType = parameterType.mid(0, parameterType.indexOf('<'));
+			if (parameterNamesCount > 0)
+			{
+				cppCode += ", ";
+			}
         }
 
-        if (parameterType.contains("::"))
-        {
-            parameterType = parameterType.mid(parameterType.lastIndexOf("::") + 2);
-        }
-    }
+        QString parameterType = "";
 
-    if (parameterType.length() > 0 && parameterType.at(0).isUpper())
-    {
-        //Example: ENTITY_REF -> entityRef
-        if (parameterType.contains("_"))
+        if (parameterNamesCount > 0 && children.at(i).dataChildren.at(0).data->dataKind == DataIsObjectPtr)
         {
-            QStringList parts = parameterType.split('_', QString::SkipEmptyParts);
-
-            parts[0] = parts[0].toLower();
-
-            for (int i = 1; i < parts.size(); ++i)
+            if (children.at(i).function->isVirtual &&
+                children.at(i).function->indexOfVTable > 0)
             {
-                QString part = parts.at(i);
-
-                parts[i] = part.at(0);
-                parts[i] += part.mid(1).toLower();
+                if (children.at(i).function->isConst)
+                {
+                    cppCode += QString("static_cast<const %1*>(this)").arg(udtName);
+                }
+                else
+                {
+                    cppCode += QString("static_cast<%1*>(this)").arg(udtName);
+                }
+            }
+            else
+            {
+                cppCode += "this";
             }
 
-            result = parts.join("");
-
-            if (result.contains("*"))
+            if (parameterNamesCount > 1)
             {
-                result = result.mid(0, result.indexOf('*'));
+                cppCode += ", ";
             }
-            else if (parameterType.contains("&"))
+        }
+
+        for (int j = 0; j < parameterNamesCount; j++)
+        {
+            if (j == 0 && children.at(i).dataChildren.at(0).data->dataKind == DataIsObjectPtr)
             {
-                result = result.mid(0, result.indexOf('&'));
+                continue;
             }
 
-            if (functionParameterNames.contains(result))
+            QString parameterName = children.at(i).dataChildren.at(j).data->name;
+
+            //Only code of current function is searched so generating functions doesn't get slower as code grows
+            if (cppCode.indexOf("(*)", functionBegin) != -1)
             {
-                result += QString("%1").arg(i + 1);
+                QString functionCode = cppCode.mid(functionBegin).replace("(*)", QString("(*%1)").arg(parameterName));
+
+                cppCode.truncate(functionBegin);
+                cppCode += functionCode;
             }
-        }
-        else
-        {
-            //Example: EntityRef -> entityRef
-            for (int j = 0; j < parameterType.length(); j++)
+            else
             {
-                if (j > 0 && parameterType.at(j).isLower() && parameterType.at(j - 1).isUpper())
-                {
-                    result += parameterType.at(j - 1).toLower();
-
-                    if (parameterType.contains("*"))
-                    {
-                        result += parameterType.mid(j, parameterType.indexOf('*') - j);
-                    }
-                    else if (parameterType.contains("&"))
-                    {
-                        result += parameterType.mid(j, parameterType.indexOf('&') - j);
-                    }
-                    else
-                    {
-                        result += parameterType.mid(j);
-                    }
-
-                    if (functionParameterNames.contains(result))
-                    {
-                        result += QString("%1").arg(i + 1);
-                    }
+                cppCode += parameterName;
+            }
 
-                    break;
-                }
+            if (j != parameterNamesCount - 1)
+            {
+                cppCode += ", ";
             }
         }
 
-        /*if (functionParameterNames.contains(result))
-        {
-            result += QString("%1").arg(i + 1);
-        }*/
-
-        /*if (result.length() == 0)
+        if (children.at(i).function->isVariadic)
         {
-            result += QString("param%1").arg(i + 1);
-        }*/
+            //cppCode += "...";
 
-        if (result.length() == 0)
-        {
-            for (int j = 0; j < parameterType.length(); j++)
+            if (options->useVAList)
             {
-                if (parameterType.at(j).isLetter())
-                {
-                    result += parameterType.at(j).toLower();
-                }
+                cppCode += ", argumentsList";
             }
-
-            if (functionParameterNames.contains(result))
+            else
             {
-                result += QString("%1").arg(i + 1);
+                cppCode += "args...";
             }
         }
-    }
-    else
-    {
-        if (options->useGhidraNameStyle)
+
+        if (children.at(i).function->isVariadic && options->useVAList)
         {
-            result += QString("param%1").arg(i + 1);
+            cppCode += ");\r\n\r\n\t";
+            cppCode += "va_end(argumentsList);";
+            cppCode += "\r\n}\r\n\r\n";
         }
         else
         {
-            result += QString("p%1").arg(i + 1);
+            cppCode += ");\r\n}\r\n\r\n";
         }
+        
+        context->functionParameterNames.clear();
     }
 
-    return result;
+    ImplementFunctionsForStaticVariables(element, cppCode);
+
+    code += cppCode;
+
+    if (level == 0)
+    {
+        code.RemoveLast(2);
+    }
 }
 
-QString PDB::GenerateCPPCode(const Element* element, int level)
+QString PDB::ImplementVariadicTemplateFunction(const Element* element, int level)
 {
+    ResolutionContext* context = GetResolutionContext();
     QString cppCode = "";
-    int udtChildrenCount = element->udtChildren.count();
-    int functionChildrenCount = element->virtualFunctionChildren.count() + element->nonVirtualFunctionChildren.count();
-    QList<Element> children;
-
-    children.append(element->virtualFunctionChildren);
-    children.append(element->nonVirtualFunctionChildren);
+    QString udtName = element->function->parentClassName;
 
-    for (int i = 0; i < udtChildrenCount; i++)
+    if (element->function->isVirtual &&
+        element->function->indexOfVTable > 0)
     {
-        cppCode += GenerateCPPCode(&element->udtChildren.at(i), level + 1);
+        udtName = element->function->vTableName;
     }
 
-    for (int i = 0; i < functionChildrenCount; i++)
-    {
-        DWORD functionOffset = children.at(i).function.relativeVirtualAddress;
-
-        if (functionOffset == 0 &&
-            !options->displayNonImplementedFunctions &&
-            /*!children.at(i).function.isGeneratedByApp &&*/ //default keyword is added in this case so compiler will implement it
-            !children.at(i).function.isDefaultConstructor &&
-            !children.at(i).function.isDestructor &&
-            !(children.at(i).function.isCopyConstructor &&
-                options->applyRuleOfThree) &&
-            !(children.at(i).function.isCopyAssignmentOperator &&
-                options->applyRuleOfThree))
-        {
-            continue;
-        }
-
-        if (children.at(i).function.isVariadic && options->useTemplateFunction)
-        {
-            continue;
-        }
-
-        QString udtName = children.at(i).function.parentClassName;
-
-        if (children.at(i).function.isVirtual &&
-            children.at(i).function.indexOfVTable > 0)
-        {
-            udtName = element->udt.vTableNames.value(children.at(i).function.indexOfVTable);
-        }
+    QList<QString> parameterTypes = element->function->parameters;
+    QString functionName = element->function->name;
 
-        QList<QString> parameterTypes = children.at(i).function.parameters;
-        QString functionName = children.at(i).function.name;
+    int parameterTypesCount = parameterTypes.count();
+    int parameterNamesCount = element->dataChildren.count();
 
-        int parameterTypesCount = parameterTypes.count();
+    parameterTypesCount--;
 
-        if (children.at(i).function.isVariadic)
-        {
-            parameterTypesCount--;
-        }
+    static const FunctionOptions functionOptions = { true, false, false, true };
+    QString functionPrototype = FunctionTypeToString(element, &functionOptions);
 
-        int parameterNamesCount = children.at(i).dataChildren.count();
+    cppCode += QString("\r\n%1template <typename... Args>\r\n").arg(GetTab(level));
+    cppCode += QString("%1%2\r\n%3{\r\n\t").arg(GetTab(level)).arg(functionPrototype).arg(GetTab(level));
 
-        static const FunctionOptions functionOptions = { true, false, false, true };
-        QString functionPrototype = FunctionTypeToString(const_cast<Element*>(&children.at(i)), &functionOptions);
+	if (element->function->isVirtual)
+	{
+		int vTableIndex = element->function->virtualBaseOffset >> 2;
 
-		cppCode += QString("%1\r\n{\r\n\t").arg(functionPrototype);
+        cppCode += QString("%1usigned int address = *reinterpret_cast<void***>(this))[%2]\r\n\t").arg(GetTab(level))
+            .arg(vTableIndex);
+	}
 
-		if (children.at(i).function.isVariadic)
-		{
-            if (children.at(i).function.isVirtual)
-            {
-                int vTableIndex = children.at(i).function.virtualBaseOffset >> 2;
+    cppCode += GetTab(level);
 
-                cppCode += QString("usigned int address = *reinterpret_cast<void***>(this))[%1]\r\n\t").arg(vTableIndex);
-            }
+    DWORD functionOffset = element->function->relativeVirtualAddress;
 
-            if (options->useVAList)
-            {
-                cppCode += "va_list argumentsList;\r\n\r\n\t";
-                cppCode += QString("va_start(argumentsList, %1);\r\n\r\n\t").arg(children.at(i).dataChildren.last().data.name);
-            }
-		}
+    if (element->function->isVirtual ||
+        (element->function->isVirtual &&
+            element->function->isPure &&
+            functionOffset > 0))
+    {
+        int vTableIndex = element->function->virtualBaseOffset >> 2;
 
-        if (children.at(i).function.isVirtual ||
-            (children.at(i).function.isVirtual &&
-                children.at(i).function.isPure &&
-                functionOffset > 0))
+        if (element->function->returnType1.baseType == 1 &&
+            !(element->function->returnType1.isPointer ||
+                element->function->returnType1.isReference))
         {
-            if (children.at(i).function.isDestructor)
-            {
-                if (element->udt.isNested)
-                {
-                    if (options->implementDefaultConstructorAndDestructor && !options->implementMethodsOfInnerUDT)
-                    {
-                        continue;
-                    }
-                }
-                else if (!options->implementDefaultConstructorAndDestructor)
-                {
-                    continue;
-                }
-            }
-
-            int vTableIndex = children.at(i).function.virtualBaseOffset >> 2;
-
-            /*
-            * Virtual destructor implementation shouldn't call original destructor.
-            * Instead of calling original destructor copy destructor's decompiled code from IDA or Ghidra
-            */
-            if (children.at(i).function.isDestructor)
-            {
-                hasVirtualDestructor = true;
-                cppCode += QString("\r\n}\r\n\r\n");
-
-                continue;
-            }
-
-            if (children.at(i).function.isGeneratedByApp)
-            {
-                cppCode += QString("\r\n}\r\n\r\n");
-
-                continue;
-            }
+			if (element->function->isConst)
+			{
+				cppCode += QString("Function::Call<const %1*").arg(udtName);
+			}
+			else
+			{
+				cppCode += QString("Function::Call<%1*").arg(udtName);
+			}
+        }
+        else
+        {
+            QString returnType = element->function->returnType2;
 
-            if (children.at(i).function.returnType1.baseType == 1 &&
-                !(children.at(i).function.returnType1.isPointer ||
-                    children.at(i).function.returnType1.isReference))
+            if (!options->includeConstKeyword)
             {
-                if (children.at(i).function.isVariadic)
-                {
-					if (children.at(i).function.isConst)
-					{
-						cppCode += QString("Function::Call<const %1*").arg(udtName);
-					}
-					else
-					{
-						cppCode += QString("Function::Call<%1*").arg(udtName);
-					}
-                }
-                else
+                if (returnType.contains("<") && returnType.contains(" const"))
                 {
-                    if (children.at(i).function.isConst)
-                    {
-                        cppCode += QString("Function::CallConstVirtualMethod<%1, const %2*").arg(vTableIndex).arg(udtName);
-                    }
-                    else
-                    {
-                        cppCode += QString("Function::CallVirtualMethod<%1, %2*").arg(vTableIndex).arg(udtName);
-                    }
+                    returnType.replace(" const", "");
                 }
             }
-            else
-            {
-                QString returnType = children.at(i).function.returnType2;
-
-                if (!options->includeConstKeyword)
-                {
-                    if (returnType.contains("<") && returnType.contains(" const"))
-                    {
-                        returnType.replace(" const", "");
-                    }
-                }
 
-                if (children.at(i).function.isRVOApplied)
-                {
-                    if (children.at(i).function.isVariadic)
-                    {
-						if (children.at(i).function.isConst)
-						{
-                            cppCode += QString("return Function::CallRVOAndReturn<%1, const %2*").arg(returnType).arg(udtName);
-						}
-						else
-						{
-                            cppCode += QString("return Function::CallRVOAndReturn<%1, %2*").arg(returnType).arg(udtName);
-						}
-                    }
-                    else
-                    {
-                        if (children.at(i).function.isConst)
-                        {
-                            cppCode += QString("return Function::CallRVOConstVirtualMethodAndReturn<%1, %2, const %3*").arg(returnType)
-                                .arg(vTableIndex).arg(udtName);
-                        }
-                        else
-                        {
-                            cppCode += QString("return Function::CallRVOVirtualMethodAndReturn<%1, %2, %3*").arg(returnType)
-                                .arg(vTableIndex).arg(udtName);
-                        }
-                    }
-                }
-                else
-                {
-					if (children.at(i).function.isVariadic)
-					{
-						if (children.at(i).function.isConst)
-						{
-                            cppCode += QString("return Function::CallAndReturn<%1, const %2*").arg(returnType).arg(udtName);
-						}
-						else
-						{
-                            cppCode += QString("return Function::CallAndReturn<%1, %2*").arg(returnType).arg(udtName);
-						}
-					}
-                    else
-                    {
-                        if (children.at(i).function.isConst)
-                        {
-                            cppCode += QString("return Function::CallConstVirtualMethodAndReturn<%1, %2, const %3*").arg(returnType)
-                                .arg(vTableIndex).arg(udtName);
-                        }
-                        else
-                        {
-                            cppCode += QString("return Function::CallVirtualMethodAndReturn<%1, %2, %3*").arg(returnType)
-                                .arg(vTableIndex).arg(udtName);
-                        }
-                    }
-                }
+            if (element->function->isRVOApplied)
+            {
+				if (element->function->isConst)
+				{
+					cppCode += QString("return Function::CallRVOAndReturn<%1, const %2*").arg(returnType).arg(udtName);
+				}
+				else
+				{
+					cppCode += QString("return Function::CallRVOAndReturn<%1, %2*").arg(returnType).arg(udtName);
+				}
             }
-
-            if (parameterTypesCount > 0)
+            else
             {
-                cppCode += ", ";
+				if (element->function->isConst)
+				{
+					cppCode += QString("return Function::CallAndReturn<%1, const %2*").arg(returnType).arg(udtName);
+				}
+				else
+				{
+					cppCode += QString("return Function::CallAndReturn<%1, %2*").arg(returnType).arg(udtName);
+				}
             }
         }
-        else
+
+        if (parameterTypesCount > 0)
+        {
+            cppCode += ", ";
+        }
+    }
+    else
+    {
+        if (element->function->returnType1.baseType == 1 &&
+            !(element->function->returnType1.isPointer ||
+                element->function->returnType1.isReference))
         {
-            if (children.at(i).function.isDefaultConstructor || children.at(i).function.isDestructor)
+            switch (element->function->callingConvention)
             {
-                if (element->udt.isNested)
+            case CV_CALL_THISCALL:
+            {
+                if (element->function->isConst)
                 {
-                    if (options->implementDefaultConstructorAndDestructor && !options->implementMethodsOfInnerUDT)
-                    {
-                        continue;
-                    }
+                    cppCode += QString("Function::CallMethod<const %1*").arg(udtName);
                 }
-                else if (!options->implementDefaultConstructorAndDestructor)
+                else
                 {
-                    continue;
+                    cppCode += QString("Function::CallMethod<%1*").arg(udtName);
                 }
-            }
-
-            /*
-            * Constructor implementation shouldn't call original constructor if class/struct has virtual destructor.
-            * Instead of calling original constructor copy constructor's decompiled code from IDA or Ghidra
-            */
-            if (children.at(i).function.isDefaultConstructor && hasVirtualDestructor)
-            {
-                cppCode += QString("\r\n}\r\n\r\n");
-
-                continue;
-            }
-
-            /*if ((children.at(i).function.isDefaultConstructor ||
-                children.at(i).function.isConstructor) &&
-                hasVirtualDestructor)
-            {
-                cppCode += QString("\r\n}\r\n\r\n");
-
-                continue;
-            }*/
 
-            if (children.at(i).function.isGeneratedByApp)
-            {
-                cppCode += QString("\r\n}\r\n\r\n");
+                if (parameterTypesCount > 0)
+                {
+                    cppCode += ", ";
+                }
 
-                continue;
+                break;
             }
+            case CV_CALL_NEAR_FAST:
+            case CV_CALL_FAR_FAST:
+                cppCode += QString("Function::FastCall<");
 
-            if (functionOffset == 0 &&
-                (children.at(i).function.isDefaultConstructor ||
-                    children.at(i).function.isConstructor ||
-                    children.at(i).function.isCopyConstructor ||
-                    children.at(i).function.isCopyAssignmentOperator ||
-                    children.at(i).function.isDestructor))
-            {
-                cppCode += QString("\r\n}\r\n\r\n");
+                break;
+            case CV_CALL_NEAR_STD:
+            case CV_CALL_FAR_STD:
+                cppCode += QString("Function::StdCall<");
 
-                continue;
-            }
+                break;
+            case CV_CALL_NEAR_C:
+            case CV_CALL_FAR_C:
+                cppCode += QString("Function::Call<");
 
-            if (children.at(i).function.returnType1.baseType == 1 &&
-                !(children.at(i).function.returnType1.isPointer ||
-                    children.at(i).function.returnType1.isReference))
-            {
-                switch (children.at(i).function.callingConvention)
-                {
-                case CV_CALL_THISCALL:
+                if (element->dataChildren.count() > 0 &&
+                    element->dataChildren.at(0).data->dataKind == DataIsObjectPtr)
                 {
-                    if (children.at(i).function.isConst)
+                    if (element->function->isConst)
                     {
-                        cppCode += QString("Function::CallMethod<const %1*").arg(udtName);
+                        cppCode += QString("const %1*").arg(element->dataChildren.at(0).data->typeName);
                     }
                     else
                     {
-                        cppCode += QString("Function::CallMethod<%1*").arg(udtName);
+                        cppCode += QString("%1*").arg(element->dataChildren.at(0).data->typeName);
                     }
 
                     if (parameterTypesCount > 0)
                     {
                         cppCode += ", ";
                     }
-
-                    break;
                 }
-                case CV_CALL_NEAR_FAST:
-                case CV_CALL_FAR_FAST:
-                    cppCode += QString("Function::FastCall<");
-
-                    break;
-                case CV_CALL_NEAR_STD:
-                case CV_CALL_FAR_STD:
-                    cppCode += QString("Function::StdCall<");
-
-                    break;
-                case CV_CALL_NEAR_C:
-                case CV_CALL_FAR_C:
-                    cppCode += QString("Function::Call<");
-
-                    if (children.at(i).dataChildren.count() > 0 &&
-                        children.at(i).dataChildren.at(0).data.dataKind == DataIsObjectPtr)
-					{
-                        if (children.at(i).function.isConst)
-                        {
-                            cppCode += QString("const %1*").arg(children.at(i).dataChildren.at(0).data.typeName);
-                        }
-                        else
-                        {
-                            cppCode += QString("%1*").arg(children.at(i).dataChildren.at(0).data.typeName);
-                        }
-
-						if (parameterTypesCount > 0)
-						{
-							cppCode += ", ";
-						}
-					}
 
-                    break;
-                case CV_CALL_NEAR_VECTOR:
-                    cppCode += QString("Function::VectorCall<");
+                break;
+            case CV_CALL_NEAR_VECTOR:
+                cppCode += QString("Function::VectorCall<");
 
-                    break;
-                }
+                break;
             }
-            else
-            {
-                QString returnType = children.at(i).function.returnType2;
+        }
+        else
+        {
+            QString returnType = element->function->returnType2;
 
-                if (!options->includeConstKeyword)
+            if (!options->includeConstKeyword)
+            {
+                if (returnType.contains("<") && returnType.contains(" const"))
                 {
-                    if (returnType.contains("<") && returnType.contains(" const"))
-                    {
-                        returnType.replace(" const", "");
-                    }
+                    returnType.replace(" const", "");
                 }
+            }
 
-                switch (children.at(i).function.callingConvention)
-                {
-                case CV_CALL_THISCALL:
+            switch (element->function->callingConvention)
+            {
+            case CV_CALL_THISCALL:
+            {
+                if (element->function->isRVOApplied)
                 {
-                    if (children.at(i).function.isRVOApplied)
+                    if (element->function->isConst)
                     {
-						if (children.at(i).function.isConst)
-						{
-							cppCode += QString("return Function::CallRVOMethodAndReturn<%1, const %2*").arg(returnType).arg(udtName);
-						}
-						else
-						{
-							cppCode += QString("return Function::CallRVOMethodAndReturn<%1, %2*").arg(returnType).arg(udtName);
-						}
+                        cppCode += QString("return Function::CallRVOMethodAndReturn<%1, const %2*").arg(returnType).arg(udtName);
                     }
                     else
                     {
-                        if (children.at(i).function.isConst)
-                        {
-                            cppCode += QString("return Function::CallMethodAndReturn<%1, const %2*").arg(returnType).arg(udtName);
-                        }
-                        else
-                        {
-                            cppCode += QString("return Function::CallMethodAndReturn<%1, %2*").arg(returnType).arg(udtName);
-                        }
+                        cppCode += QString("return Function::CallRVOMethodAndReturn<%1, %2*").arg(returnType).arg(udtName);
                     }
-
-                    break;
                 }
-                case CV_CALL_NEAR_FAST:
-                case CV_CALL_FAR_FAST:
-                    if (children.at(i).function.isRVOApplied)
+                else
+                {
+                    if (element->function->isConst)
                     {
-                        cppCode += QString("return Function::FastCallRVOAndReturn<%1").arg(returnType);
+                        cppCode += QString("return Function::CallMethodAndReturn<%1, const %2*").arg(returnType).arg(udtName);
                     }
                     else
                     {
-                        cppCode += QString("return Function::FastCallAndReturn<%1").arg(returnType);
+                        cppCode += QString("return Function::CallMethodAndReturn<%1, %2*").arg(returnType).arg(udtName);
                     }
+                }
 
-                    break;
-                case CV_CALL_NEAR_STD:
-                case CV_CALL_FAR_STD:
-                    if (children.at(i).function.isRVOApplied)
-                    {
-                        cppCode += QString("return Function::StdCallRVOAndReturn<%1").arg(returnType);
-                    }
-                    else
-                    {
-                        cppCode += QString("return Function::StdCallAndReturn<%1").arg(returnType);
-                    }
+                break;
+            }
+            case CV_CALL_NEAR_FAST:
+            case CV_CALL_FAR_FAST:
+                if (element->function->isRVOApplied)
+                {
+                    cppCode += QString("return Function::FastCallRVOAndReturn<%1").arg(returnType);
+                }
+                else
+                {
+                    cppCode += QString("return Function::FastCallAndReturn<%1").arg(returnType);
+                }
 
-                    break;
-                case CV_CALL_NEAR_C:
-                case CV_CALL_FAR_C:
-                    if (children.at(i).function.isRVOApplied)
-                    {
-                        cppCode += QString("return Function::CallRVOAndReturn<%1").arg(returnType);
-                    }
-                    else
-                    {
-                        cppCode += QString("return Function::CallAndReturn<%1").arg(returnType);
-                    }
+                break;
+            case CV_CALL_NEAR_STD:
+            case CV_CALL_FAR_STD:
+                if (element->function->isRVOApplied)
+                {
+                    cppCode += QString("return Function::StdCallRVOAndReturn<%1").arg(returnType);
+                }
+                else
+                {
+                    cppCode += QString("return Function::StdCallAndReturn<%1").arg(returnType);
+                }
 
-                    if (children.at(i).dataChildren.count() > 0 &&
-                        children.at(i).dataChildren.at(0).data.dataKind == DataIsObjectPtr)
-                    {
-                        if (children.at(i).function.isConst)
-                        {
-                            cppCode += QString(", const %1*").arg(children.at(i).dataChildren.at(0).data.typeName);
-                        }
-                        else
-                        {
-                            cppCode += QString(", %1*").arg(children.at(i).dataChildren.at(0).data.typeName);
-                        }
-                    }
+                break;
+            case CV_CALL_NEAR_C:
+            case CV_CALL_FAR_C:
+                if (element->function->isRVOApplied)
+                {
+                    cppCode += QString("return Function::CallRVOAndReturn<%1").arg(returnType);
+                }
+                else
+                {
+                    cppCode += QString("return Function::CallAndReturn<%1").arg(returnType);
+                }
 
-                    break;
-                case CV_CALL_NEAR_VECTOR:
-                    if (children.at(i).function.isRVOApplied)
+                if (element->dataChildren.count() > 0 &&
+                    element->dataChildren.at(0).data->dataKind == DataIsObjectPtr)
+                {
+                    if (element->function->isConst)
                     {
-                        cppCode += QString("return Function::VectorCallRVOAndReturn<%1");
+                        cppCode += QString(", const %1*").arg(element->dataChildren.at(0).data->typeName);
                     }
                     else
                     {
-                        cppCode += QString("return Function::VectorCallAndReturn<%1");
+                        cppCode += QString(", %1*").arg(element->dataChildren.at(0).data->typeName);
                     }
-
-                    break;
-                }
-
-                if (parameterTypesCount > 0)
-                {
-                    cppCode += ", ";
                 }
-            }
 
-            /*if (parameterTypesCount > 0)
-            {
-                cppCode += ", ";
-            }*/
-        }
-
-        for (int j = 0; j < parameterTypesCount; j++)
-        {
-            static const DataOptions dataOptions = { true, false };
-            QString parameterType = parameterTypes.at(j);
-
-            if (!options->includeConstKeyword)
-            {
-                if (parameterType.contains("<") && parameterType.contains(" const"))
+                break;
+            case CV_CALL_NEAR_VECTOR:
+                if (element->function->isRVOApplied)
                 {
-                    parameterType.replace(" const", "");
+                    cppCode += QString("return Function::VectorCallRVOAndReturn<%1");
                 }
-
-                if (parameterType.startsWith("const "))
+                else
                 {
-                    parameterType.remove(0, 6);
+                    cppCode += QString("return Function::VectorCallAndReturn<%1");
                 }
-            }
 
-            cppCode += parameterType;
+                break;
+            }
 
-            if (j != parameterTypesCount - 1)
+            if (parameterTypesCount > 0)
             {
                 cppCode += ", ";
             }
         }
 
-        if (children.at(i).function.isVariadic)
+        /*if (parameterTypesCount > 0)
         {
-            if (parameterTypesCount > 0)
-            {
-                cppCode += ", ";
-            }
+            cppCode += ", ";
+        }*/
+    }
 
-            if (options->useVAList)
+    for (int j = 0; j < parameterTypesCount; j++)
+    {
+        static const DataOptions dataOptions = { true, false };
+        QString parameterType = parameterTypes.at(j);
+
+        if (!options->includeConstKeyword)
+        {
+            if (parameterType.contains("<") && parameterType.contains(" const"))
             {
-                cppCode += "va_list";
+                parameterType.replace(" const", "");
             }
-            else
+
+            if (parameterType.startsWith("const "))
             {
-                cppCode += "Args...";
+                parameterType.remove(0, 6);
             }
         }
 
-        cppCode += ">(";
+        cppCode += parameterType;
 
-        if (children.at(i).function.isVirtual)
+        if (j != parameterTypesCount - 1)
         {
-			if (children.at(i).function.isVariadic)
-			{
-                cppCode += "address";
-
-				if (parameterNamesCount > 0)
-				{
-					cppCode += ", ";
-				}
-			}
+            cppCode += ", ";
         }
-        else
-        {
-            QString baseAddressVariableName = GetBaseAddressVariableName();
+    }
 
-			DWORD functionOffset = children.at(i).function.relativeVirtualAddress;
-			QString offset = QString::number(functionOffset, 16).toUpper();
+	if (parameterTypesCount > 0)
+	{
+		cppCode += ", ";
+	}
 
-			cppCode += QString("BaseAddresses::%1 + 0x%2").arg(baseAddressVariableName).arg(offset);
+    cppCode += "Args...>(";
 
-			if (parameterNamesCount > 0)
-			{
-				cppCode += ", ";
-			}
+    if (element->function->isVirtual)
+    {
+		cppCode += "address";
+
+		if (parameterNamesCount > 0)
+		{
+			cppCode += ", ";
+		}
+    }
+    else
+    {
+        QString baseAddressVariableName = GetBaseAddressVariableName();
+
+        DWORD functionOffset = element->function->relativeVirtualAddress;
+        QString offset = QString::number(functionOffset, 16).toUpper();
+
+        cppCode += QString("BaseAddresses::%1 + 0x%2").arg(baseAddressVariableName).arg(offset);
+
+        if (parameterNamesCount > 0)
+        {
+            cppCode += ", ";
         }
+    }
 
-        QString parameterType = "";
+    QString parameterType = "";
 
-        if (parameterNamesCount > 0 && children.at(i).dataChildren.at(0).data.dataKind == DataIsObjectPtr)
+    if (parameterNamesCount > 0 && element->dataChildren.at(0).data->dataKind == DataIsObjectPtr)
+    {
+        if (element->function->isVirtual &&
+            element->function->indexOfVTable > 0)
         {
-            if (children.at(i).function.isVirtual &&
-                children.at(i).function.indexOfVTable > 0)
+            if (element->function->isConst)
             {
-                if (children.at(i).function.isConst)
-                {
-                    cppCode += QString("static_cast<const %1*>(this)").arg(udtName);
-                }
-                else
-                {
-                    cppCode += QString("static_cast<%1*>(this)").arg(udtName);
-                }
+                cppCode += QString("static_cast<const %1*>(this)").arg(udtName);
             }
             else
             {
-                cppCode += "this";
+                cppCode += QString("static_cast<%1*>(this)").arg(udtName);
             }
+        }
+        else
+        {
+            cppCode += "this";
+        }
 
-            if (parameterNamesCount > 1)
-            {
-                cppCode += ", ";
-            }
+        if (parameterNamesCount > 1)
+        {
+            cppCode += ", ";
         }
+    }
 
-        for (int j = 0; j < parameterNamesCount; j++)
+    for (int j = 0; j < parameterNamesCount; j++)
+    {
+        if (j == 0 && element->dataChildren.at(0).data->dataKind == DataIsObjectPtr)
         {
-            if (j == 0 && children.at(i).dataChildren.at(0).data.dataKind == DataIsObjectPtr)
-            {
-                continue;
-            }
+            continue;
+        }
+
+        QString parameterName = element->dataChildren.at(j).data->name;
+
+        if (cppCode.contains("(*)"))
+        {
+            cppCode = cppCode.replace("(*)", QString("(*%1)").arg(parameterName));
+        }
+        else
+        {
+            cppCode += parameterName;
+        }
+
+        if (j != parameterNamesCount - 1)
+        {
+            cppCode += ", ";
+        }
+    }
+
+    cppCode += QString("args...);\r\n%1}\r\n").arg(GetTab(level));
+
+    context->functionParameterNames.clear();
+
+    return cppCode;
+}
+
+QString PDB::GetBaseAddressVariableName()
+{
+    QString baseAddressVariableName = fileNameWithoutExtension;
+    QStringList parts = baseAddressVariableName.split('.', QString::SkipEmptyParts);
+    int count = parts.count();
+
+    for (int j = 1; j < count; j++)
+    {
+        parts[j].replace(0, 1, parts[j][0].toUpper());
+    }
+
+    return parts.join("");
+}
+
+void PDB::SetFileNameWithoutExtension(const QString& fileNameWithoutExtension)
+{
+    this->fileNameWithoutExtension = fileNameWithoutExtension;
+}
+
+void PDB::SetWindowTitle(const QString& windowTitle)
+{
+    this->windowTitle = windowTitle;
+}
+
+void PDB::SetFilePath(const QString& filePath)
+{
+    this->filePath = filePath;
+}
+
+void PDB::SetProcessType(ProcessType processType)
+{
+    this->processType = processType;
+}
+
+void PDB::ExportSymbol(SymbolRecord symbolRecord)
+{
+    WriteExportedSymbol(GenerateExportedSymbol(symbolRecord));
+}
+
+/*
+* Every symbol is resolved in its own context so generated code doesn't depend on symbols
+* which were exported before it and symbols can be generated on multiple threads
+*/
+ExportedSymbol PDB::GenerateExportedSymbol(SymbolRecord symbolRecord)
+{
+    ResolutionContext context(options);
+    ResolutionContextScope contextScope(&context);
+    ExportedSymbol exportedSymbol;
+    QString name = GetExportedSymbolName(symbolRecord.typeName);
+
+    if (processType == ProcessType::exportUDTsAndEnums && (options->generateOnlyHeader || options->generateBoth))
+    {
+        SendStatusMessage(QString("Generating: %1.h").arg(name));
+    }
+    else if ((processType == ProcessType::exportUDTsAndEnumsWithDependencies ||
+        processType == ProcessType::exportAllUDTsAndEnums) &&
+        (options->generateOnlyHeader || options->generateBoth))
+    {
+        SendStatusMessageToProcessDialog(QString("Generating: %1.h").arg(name));
+    }
+
+    Element element = GetElement(&symbolRecord);
+
+    exportedSymbol.name = name;
+    exportedSymbol.hasSourceCode = options->generateOnlySource || options->generateBoth;
+
+    GetElementInfo(&element, exportedSymbol.headerCode);
+
+    if (exportedSymbol.hasSourceCode)
+    {
+        if (processType == ProcessType::exportUDTsAndEnums && (options->generateOnlyHeader || options->generateBoth))
+        {
+            SendStatusMessage(QString("Generating: %1.cpp").arg(symbolRecord.typeName));
+        }
+        else if (processType == ProcessType::exportAllUDTsAndEnums && (options->generateOnlyHeader || options->generateBoth))
+        {
+            SendStatusMessageToProcessDialog(QString("Generating: %1.cpp").arg(symbolRecord.typeName));
+        }
+
+        exportedSymbol.cppCode += QString("#include \"%1.h\"\r\n").arg(name);
+        exportedSymbol.cppCode += "#include \"Function.h\"\r\n";
+        exportedSymbol.cppCode += "#include \"BaseAddresses.h\"\r\n\r\n";
+
+        GenerateCPPCode(&element, exportedSymbol.cppCode);
+    }
+
+    return exportedSymbol;
+}
+
+//Types which are nested or templates are exported to file of their parent or template
+QString PDB::GetExportedSymbolName(const QString& typeName)
+{
+    return TypeName::Parse(typeName)->GetOuterName();
+}
+
+int PDB::GetExportThreadCount()
+{
+    return options->exportThreadCount > 0 ? options->exportThreadCount : QThread::idealThreadCount();
+}
+
+void PDB::WriteExportedSymbol(const ExportedSymbol& exportedSymbol)
+{
+    QFileInfo fileInfo(filePath);
+    QString currentDirectory = fileInfo.absolutePath();
+
+    if (!QDir(QString("%1/include").arg(currentDirectory)).exists())
+    {
+        QDir().mkdir(QString("%1/include").arg(currentDirectory));
+    }
+
+    QFile headerFile(QString("%1/include/%2.h").arg(currentDirectory).arg(exportedSymbol.name));
+
+    if (headerFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        exportedSymbol.headerCode.WriteLatin1(&headerFile);
+        headerFile.close();
+    }
+
+    if (exportedSymbol.hasSourceCode)
+    {
+        if (!QDir(QString("%1/src").arg(currentDirectory)).exists())
+        {
+            QDir().mkdir(QString("%1/src").arg(currentDirectory));
+        }
+
+        QFile cppFile(QString("%1/src/%2.cpp").arg(currentDirectory).arg(exportedSymbol.name));
+
+        if (cppFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            exportedSymbol.cppCode.WriteLatin1(&cppFile);
+            cppFile.close();
+        }
+    }
+}
+
+quint32 PDB::GetTypeIndex(const SymbolRecord& symbolRecord)
+{
+    if (!tpiStream.IsLoaded())
+    {
+        return 0;
+    }
+
+    if (symbolRecord.id & typeIndexFlag)
+    {
+        return symbolRecord.id & ~typeIndexFlag;
+    }
+
+    //Type which is only forward referenced is hashed by its name
+    return tpiStream.FindTypeIndex(symbolRecord.typeName, true);
+}
+
+/*
+* Generated code contains RVAs of functions and static variables which aren't part of TPI records,
+* they are hashed from DIA children of type and its nested types
+*/
+quint64 PDB::GetAddressSignature(IDiaSymbol* symbol, quint64 signature)
+{
+    IDiaEnumSymbols* enumChildren;
 
-            QString parameterName = children.at(i).dataChildren.at(j).data.name;
+    if (symbol->findChildren(SymTagNull, nullptr, nsNone, &enumChildren) != S_OK)
+    {
+        return signature;
+    }
 
-            if (cppCode.contains("(*)"))
-            {
-                cppCode = cppCode.replace("(*)", QString("(*%1)").arg(parameterName));
-            }
-            else
-            {
-                cppCode += parameterName;
-            }
+    IDiaSymbol* child;
+    ULONG celt = 0;
 
-            if (j != parameterNamesCount - 1)
-            {
-                cppCode += ", ";
-            }
-        }
+    while (SUCCEEDED(enumChildren->Next(1, &child, &celt)) && celt == 1)
+    {
+        DWORD symTag, relativeVirtualAddress;
 
-        if (children.at(i).function.isVariadic)
+        if (child->get_symTag(&symTag) == S_OK)
         {
-            //cppCode += "...";
-
-            if (options->useVAList)
+            if (symTag == SymTagUDT)
             {
-                cppCode += ", argumentsList";
+                signature = GetAddressSignature(child, signature);
             }
-            else
+            else if ((symTag == SymTagFunction || symTag == SymTagData) &&
+                child->get_relativeVirtualAddress(&relativeVirtualAddress) == S_OK)
             {
-                cppCode += "args...";
+                signature = TypeSignature::Hash(signature, symTag);
+                signature = TypeSignature::Hash(signature, relativeVirtualAddress);
             }
         }
 
-        if (children.at(i).function.isVariadic && options->useVAList)
-        {
-            cppCode += ");\r\n\r\n\t";
-            cppCode += "va_end(argumentsList);";
-            cppCode += "\r\n}\r\n\r\n";
-        }
-        else
-        {
-            cppCode += ");\r\n}\r\n\r\n";
-        }
-        
-        functionParameterNames.clear();
+        child->Release();
     }
 
-    ImplementFunctionsForStaticVariables(element, cppCode);
-
-    if (level == 0)
-    {
-        cppCode.remove(cppCode.length() - 2, 2);
-    }
+    enumChildren->Release();
 
-    return cppCode;
+    return signature;
 }
 
-QString PDB::ImplementVariadicTemplateFunction(const Element* element, int level)
+//Returns 0 if type has to be exported again, offsets of members are part of signature of its TPI records
+quint64 PDB::GetTypeSignature(TypeSignature& typeSignature, const SymbolRecord& symbolRecord)
 {
-    QString cppCode = "";
-    QString udtName = element->function.parentClassName;
+    quint64 signature = typeSignature.Compute(GetTypeIndex(symbolRecord));
+    IDiaSymbol* symbol;
 
-    if (element->function.isVirtual &&
-        element->function.indexOfVTable > 0)
+    if (!signature)
     {
-        udtName = element->function.vTableName;
+        return 0;
     }
 
-    QList<QString> parameterTypes = element->function.parameters;
-    QString functionName = element->function.name;
+    QMutexLocker diaLocker(&diaMutex);
 
-    int parameterTypesCount = parameterTypes.count();
-    int parameterNamesCount = element->dataChildren.count();
+    if (!GetSymbolByID(symbolRecord.id, &symbol))
+    {
+        return 0;
+    }
 
-    parameterTypesCount--;
+    signature = GetAddressSignature(symbol, signature);
 
-    static const FunctionOptions functionOptions = { true, false, false, true };
-    QString functionPrototype = FunctionTypeToString(element, &functionOptions);
+    symbol->Release();
 
-    cppCode += QString("\r\n%1template <typename... Args>\r\n").arg(GetTab(level));
-    cppCode += QString("%1%2\r\n%3{\r\n\t").arg(GetTab(level)).arg(functionPrototype).arg(GetTab(level));
+    return signature ? signature : 1;
+}
 
-	if (element->function.isVirtual)
-	{
-		int vTableIndex = element->function.virtualBaseOffset >> 2;
+//Signature of options which change generated code, it's combined with signatures of types
+quint64 PDB::GetExportOptionsSignature()
+{
+    quint64 signature = TypeSignature::Hash(TypeSignature::initialHash, GetOptionsFingerprint());
+    const bool exportOptions[] =
+    {
+        options->generateOnlyHeader,
+        options->generateOnlySource,
+        options->generateBoth,
+        options->exportToSingleHeader
+    };
 
-        cppCode += QString("%1usigned int address = *reinterpret_cast<void***>(this))[%2]\r\n\t").arg(GetTab(level))
-            .arg(vTableIndex);
-	}
+    return TypeSignature::Hash(signature, exportOptions, sizeof(exportOptions));
+}
 
-    cppCode += GetTab(level);
+QString PDB::GetExportManifestPath()
+{
+    QFileInfo fileInfo(filePath);
 
-    DWORD functionOffset = element->function.relativeVirtualAddress;
+    return QString("%1/%2").arg(fileInfo.absolutePath()).arg(ExportManifest::fileName);
+}
 
-    if (element->function.isVirtual ||
-        (element->function.isVirtual &&
-            element->function.isPure &&
-            functionOffset > 0))
+/*
+* Only first symbol with some file name is exported and only if signature of its type or options changed
+* since last export or its files were deleted. Signatures are computed from TPI stream and RVAs of members
+* so types which weren't changed are skipped without resolving them. If TPI stream isn't loaded every symbol is exported.
+*/
+void PDB::ExportChangedSymbols(const SymbolRecord* records, int count)
+{
+    QFileInfo fileInfo(filePath);
+    QString currentDirectory = fileInfo.absolutePath();
+    QString manifestPath = GetExportManifestPath();
+    ExportManifest manifest;
+    TypeSignature typeSignature(&tpiStream);
+    quint64 optionsSignature = GetExportOptionsSignature();
+    bool hasSourceCode = options->generateOnlySource || options->generateBoth;
+    QVector<SymbolRecord> changedRecords;
+    QHash<QString, quint64> signatures;
+    QSet<QString> names;
+
+    SendStatusMessageToProcessDialog("Comparing types with previous export...");
+
+    manifest.Load(manifestPath);
+
+    for (int i = 0; i < count && processEnabled; i++)
     {
-        int vTableIndex = element->function.virtualBaseOffset >> 2;
+        QString name = GetExportedSymbolName(records[i].typeName);
 
-        if (element->function.returnType1.baseType == 1 &&
-            !(element->function.returnType1.isPointer ||
-                element->function.returnType1.isReference))
+        if (names.contains(name))
         {
-			if (element->function.isConst)
-			{
-				cppCode += QString("Function::Call<const %1*").arg(udtName);
-			}
-			else
-			{
-				cppCode += QString("Function::Call<%1*").arg(udtName);
-			}
+            continue;
         }
-        else
-        {
-            QString returnType = element->function.returnType2;
 
-            if (!options->includeConstKeyword)
-            {
-                if (returnType.contains("<") && returnType.contains(" const"))
-                {
-                    returnType.replace(" const", "");
-                }
-            }
+        names.insert(name);
 
-            if (element->function.isRVOApplied)
-            {
-				if (element->function.isConst)
-				{
-					cppCode += QString("return Function::CallRVOAndReturn<%1, const %2*").arg(returnType).arg(udtName);
-				}
-				else
-				{
-					cppCode += QString("return Function::CallRVOAndReturn<%1, %2*").arg(returnType).arg(udtName);
-				}
-            }
-            else
+        quint64 signature = GetTypeSignature(typeSignature, records[i]);
+
+        if (signature)
+        {
+            signature = TypeSignature::Hash(signature, optionsSignature);
+
+            if (manifest.GetSignature(name) == signature &&
+                QFile::exists(QString("%1/include/%2.h").arg(currentDirectory).arg(name)) &&
+                (!hasSourceCode || QFile::exists(QString("%1/src/%2.cpp").arg(currentDirectory).arg(name))))
             {
-				if (element->function.isConst)
-				{
-					cppCode += QString("return Function::CallAndReturn<%1, const %2*").arg(returnType).arg(udtName);
-				}
-				else
-				{
-					cppCode += QString("return Function::CallAndReturn<%1, %2*").arg(returnType).arg(udtName);
-				}
+                continue;
             }
         }
 
-        if (parameterTypesCount > 0)
-        {
-            cppCode += ", ";
-        }
+        changedRecords.append(records[i]);
+        signatures.insert(name, signature);
     }
-    else
+
+    ExportSymbols(changedRecords.constData(), changedRecords.count(), [&](const ExportedSymbol& exportedSymbol)
     {
-        if (element->function.returnType1.baseType == 1 &&
-            !(element->function.returnType1.isPointer ||
-                element->function.returnType1.isReference))
-        {
-            switch (element->function.callingConvention)
-            {
-            case CV_CALL_THISCALL:
-            {
-                if (element->function.isConst)
-                {
-                    cppCode += QString("Function::CallMethod<const %1*").arg(udtName);
-                }
-                else
-                {
-                    cppCode += QString("Function::CallMethod<%1*").arg(udtName);
-                }
+        WriteExportedSymbol(exportedSymbol);
 
-                if (parameterTypesCount > 0)
-                {
-                    cppCode += ", ";
-                }
+        quint64 signature = signatures.value(exportedSymbol.name);
 
-                break;
-            }
-            case CV_CALL_NEAR_FAST:
-            case CV_CALL_FAR_FAST:
-                cppCode += QString("Function::FastCall<");
+        if (signature)
+        {
+            manifest.SetSignature(exportedSymbol.name, signature);
+        }
+        else
+        {
+            manifest.RemoveSignature(exportedSymbol.name);
+        }
+    });
 
-                break;
-            case CV_CALL_NEAR_STD:
-            case CV_CALL_FAR_STD:
-                cppCode += QString("Function::StdCall<");
+    manifest.Save(manifestPath);
 
-                break;
-            case CV_CALL_NEAR_C:
-            case CV_CALL_FAR_C:
-                cppCode += QString("Function::Call<");
+    SendStatusMessageToProcessDialog(QString("Exported %1 changed types, %2 types weren't changed")
+        .arg(changedRecords.count()).arg(names.count() - changedRecords.count()));
+}
 
-                if (element->dataChildren.count() > 0 &&
-                    element->dataChildren.at(0).data.dataKind == DataIsObjectPtr)
-                {
-                    if (element->function.isConst)
-                    {
-                        cppCode += QString("const %1*").arg(element->dataChildren.at(0).data.typeName);
-                    }
-                    else
-                    {
-                        cppCode += QString("%1*").arg(element->dataChildren.at(0).data.typeName);
-                    }
+/*
+* Symbols are generated by worker threads and passed to writeExportedSymbol on calling thread in the same order
+* as in serial mode, so if multiple symbols have the same file name the first one is kept like before. Workers can get only
+* queueSize symbols ahead of writer so generated code which wasn't written yet doesn't take too much memory.
+* Workers read DIA symbols one at a time (see GetElement), derivation of elements and code generation run in parallel.
+*/
+void PDB::ExportSymbols(const SymbolRecord* records, int count, const std::function<void(const ExportedSymbol&)>& writeExportedSymbol)
+{
+    int threadCount = GetExportThreadCount();
 
-                    if (parameterTypesCount > 0)
-                    {
-                        cppCode += ", ";
-                    }
-                }
+    emit SetProgressMinimum(0);
+    emit SetProgressMaximum(count);
 
-                break;
-            case CV_CALL_NEAR_VECTOR:
-                cppCode += QString("Function::VectorCall<");
+    if (threadCount <= 1 || count <= 1)
+    {
+        int currentProcent = 0;
+        int procent = count / 1000;
 
-                break;
-            }
-        }
-        else
+        for (int i = 0; i < count && processEnabled; i++)
         {
-            QString returnType = element->function.returnType2;
+            writeExportedSymbol(GenerateExportedSymbol(records[i]));
 
-            if (!options->includeConstKeyword)
+            if (i > currentProcent * procent)
             {
-                if (returnType.contains("<") && returnType.contains(" const"))
-                {
-                    returnType.replace(" const", "");
-                }
+                currentProcent++;
+                emit SetProgressValue(i);
             }
+        }
 
-            switch (element->function.callingConvention)
-            {
-            case CV_CALL_THISCALL:
-            {
-                if (element->function.isRVOApplied)
-                {
-                    if (element->function.isConst)
-                    {
-                        cppCode += QString("return Function::CallRVOMethodAndReturn<%1, const %2*").arg(returnType).arg(udtName);
-                    }
-                    else
-                    {
-                        cppCode += QString("return Function::CallRVOMethodAndReturn<%1, %2*").arg(returnType).arg(udtName);
-                    }
-                }
-                else
-                {
-                    if (element->function.isConst)
-                    {
-                        cppCode += QString("return Function::CallMethodAndReturn<%1, const %2*").arg(returnType).arg(udtName);
-                    }
-                    else
-                    {
-                        cppCode += QString("return Function::CallMethodAndReturn<%1, %2*").arg(returnType).arg(udtName);
-                    }
-                }
-
-                break;
-            }
-            case CV_CALL_NEAR_FAST:
-            case CV_CALL_FAR_FAST:
-                if (element->function.isRVOApplied)
-                {
-                    cppCode += QString("return Function::FastCallRVOAndReturn<%1").arg(returnType);
-                }
-                else
-                {
-                    cppCode += QString("return Function::FastCallAndReturn<%1").arg(returnType);
-                }
+        return;
+    }
 
-                break;
-            case CV_CALL_NEAR_STD:
-            case CV_CALL_FAR_STD:
-                if (element->function.isRVOApplied)
-                {
-                    cppCode += QString("return Function::StdCallRVOAndReturn<%1").arg(returnType);
-                }
-                else
-                {
-                    cppCode += QString("return Function::StdCallAndReturn<%1").arg(returnType);
-                }
+    int queueSize = threadCount * 4;
+    QVector<ExportedSymbol> exportedSymbols(queueSize);
+    QVector<bool> isGenerated(queueSize, false);
+    int nextIndex = 0;
+    int writtenCount = 0;
+    QMutex mutex;
+    QWaitCondition symbolGenerated;
+    QWaitCondition symbolWritten;
+    QThreadPool threadPool;
 
-                break;
-            case CV_CALL_NEAR_C:
-            case CV_CALL_FAR_C:
-                if (element->function.isRVOApplied)
-                {
-                    cppCode += QString("return Function::CallRVOAndReturn<%1").arg(returnType);
-                }
-                else
-                {
-                    cppCode += QString("return Function::CallAndReturn<%1").arg(returnType);
-                }
+    threadPool.setMaxThreadCount(threadCount);
 
-                if (element->dataChildren.count() > 0 &&
-                    element->dataChildren.at(0).data.dataKind == DataIsObjectPtr)
-                {
-                    if (element->function.isConst)
-                    {
-                        cppCode += QString(", const %1*").arg(element->dataChildren.at(0).data.typeName);
-                    }
-                    else
-                    {
-                        cppCode += QString(", %1*").arg(element->dataChildren.at(0).data.typeName);
-                    }
-                }
+    for (int i = 0; i < threadCount; i++)
+    {
+        threadPool.start([&]()
+        {
+            //Worker uses DIA objects so it has to be in COM apartment, DIA calls are serialized through diaMutex
+            HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+            QMutexLocker locker(&mutex);
 
-                break;
-            case CV_CALL_NEAR_VECTOR:
-                if (element->function.isRVOApplied)
-                {
-                    cppCode += QString("return Function::VectorCallRVOAndReturn<%1");
-                }
-                else
+            while (processEnabled && nextIndex < count)
+            {
+                if (nextIndex >= writtenCount + queueSize)
                 {
-                    cppCode += QString("return Function::VectorCallAndReturn<%1");
+                    symbolWritten.wait(&mutex, 50);
+
+                    continue;
                 }
 
-                break;
+                int index = nextIndex++;
+
+                locker.unlock();
+
+                ExportedSymbol exportedSymbol = GenerateExportedSymbol(records[index]);
+
+                locker.relock();
+
+                exportedSymbols[index % queueSize] = exportedSymbol;
+                isGenerated[index % queueSize] = true;
+
+                symbolGenerated.wakeAll();
             }
 
-            if (parameterTypesCount > 0)
+            locker.unlock();
+
+            if (SUCCEEDED(hr))
             {
-                cppCode += ", ";
+                CoUninitialize();
             }
-        }
-
-        /*if (parameterTypesCount > 0)
-        {
-            cppCode += ", ";
-        }*/
+        });
     }
 
-    for (int j = 0; j < parameterTypesCount; j++)
+    QMutexLocker locker(&mutex);
+
+    while (writtenCount < count && processEnabled)
     {
-        static const DataOptions dataOptions = { true, false };
-        QString parameterType = parameterTypes.at(j);
+        int slot = writtenCount % queueSize;
 
-        if (!options->includeConstKeyword)
+        //Wait is limited so calling thread notices when process is stopped
+        if (!isGenerated.at(slot))
         {
-            if (parameterType.contains("<") && parameterType.contains(" const"))
-            {
-                parameterType.replace(" const", "");
-            }
+            symbolGenerated.wait(&mutex, 50);
 
-            if (parameterType.startsWith("const "))
-            {
-                parameterType.remove(0, 6);
-            }
+            continue;
         }
 
-        cppCode += parameterType;
+        ExportedSymbol exportedSymbol = exportedSymbols.at(slot);
 
-        if (j != parameterTypesCount - 1)
-        {
-            cppCode += ", ";
-        }
-    }
+        exportedSymbols[slot] = ExportedSymbol();
+        isGenerated[slot] = false;
 
-	if (parameterTypesCount > 0)
-	{
-		cppCode += ", ";
-	}
+        locker.unlock();
 
-    cppCode += "Args...>(";
+        writeExportedSymbol(exportedSymbol);
 
-    if (element->function.isVirtual)
-    {
-		cppCode += "address";
+        locker.relock();
 
-		if (parameterNamesCount > 0)
-		{
-			cppCode += ", ";
-		}
+        writtenCount++;
+
+        symbolWritten.wakeAll();
+
+        emit SetProgressValue(writtenCount);
     }
-    else
+
+    symbolWritten.wakeAll();
+    locker.unlock();
+
+    threadPool.waitForDone();
+}
+
+/*
+* Returns all types which symbol depends on directly or indirectly. References of every type are taken
+* from type graph and type is resolved only if it wasn't visited before
+*/
+QVector<SymbolRecord> PDB::GetDependencies(const SymbolRecord& symbolRecord)
+{
+    QVector<SymbolRecord> dependencies;
+    QSet<DWORD> visitedTypes;
+
+    typeGraph.SetOptionsFingerprint(GetOptionsFingerprint());
+
+    dependencies.append(symbolRecord);
+    visitedTypes.insert(symbolRecord.id);
+
+    for (int i = 0; i < dependencies.count() && processEnabled; i++)
     {
-        QString baseAddressVariableName = GetBaseAddressVariableName();
+        SymbolRecord symbolRecord2 = dependencies.at(i);
 
-        DWORD functionOffset = element->function.relativeVirtualAddress;
-        QString offset = QString::number(functionOffset, 16).toUpper();
+        AddTypeToTypeGraph(symbolRecord2);
 
-        cppCode += QString("BaseAddresses::%1 + 0x%2").arg(baseAddressVariableName).arg(offset);
+        QVector<SymbolRecord> references = typeGraph.GetReferences(symbolRecord2.id);
+        int count = references.count();
 
-        if (parameterNamesCount > 0)
+        for (int j = 0; j < count; j++)
         {
-            cppCode += ", ";
+            if (!visitedTypes.contains(references.at(j).id))
+            {
+                dependencies.append(references.at(j));
+                visitedTypes.insert(references.at(j).id);
+            }
         }
     }
 
-    QString parameterType = "";
+    dependencies.removeFirst();
+
+    return dependencies;
+}
+
+void PDB::AddTypeToTypeGraph(SymbolRecord symbolRecord)
+{
+    if (typeGraph.Contains(symbolRecord.id))
+    {
+        return;
+    }
+
+    ResolutionContext context(options);
+    ResolutionContextScope contextScope(&context);
+    QVector<SymbolRecord> references;
+    QSet<DWORD> referencedTypes;
+    Element element = GetElement(&symbolRecord);
+
+    GetTypeReferences(&element, &references, &referencedTypes);
+    typeGraph.AddType(symbolRecord.id, references);
+}
+
+//References of types are added to type graph on all cores, the same as when symbols are exported
+void PDB::BuildTypeGraph(const SymbolRecord* records, int count)
+{
+    QThreadPool threadPool;
+    QAtomicInt nextIndex = 0;
+    QAtomicInt completedCount = 0;
+    int threadCount = GetExportThreadCount();
+
+    typeGraph.SetOptionsFingerprint(GetOptionsFingerprint());
+    threadPool.setMaxThreadCount(threadCount);
 
-    if (parameterNamesCount > 0 && element->dataChildren.at(0).data.dataKind == DataIsObjectPtr)
+    for (int i = 0; i < threadCount; i++)
     {
-        if (element->function.isVirtual &&
-            element->function.indexOfVTable > 0)
+        threadPool.start([this, records, count, &nextIndex, &completedCount]()
         {
-            if (element->function.isConst)
+            //References are resolved through DIA so worker has to be in COM apartment, DIA calls are serialized through diaMutex
+            HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+            int index = nextIndex.fetchAndAddRelaxed(1);
+
+            while (index < count && processEnabled)
             {
-                cppCode += QString("static_cast<const %1*>(this)").arg(udtName);
+                AddTypeToTypeGraph(records[index]);
+                completedCount.fetchAndAddRelaxed(1);
+
+                index = nextIndex.fetchAndAddRelaxed(1);
             }
-            else
+
+            if (SUCCEEDED(hr))
             {
-                cppCode += QString("static_cast<%1*>(this)").arg(udtName);
+                CoUninitialize();
             }
-        }
-        else
-        {
-            cppCode += "this";
-        }
+        });
+    }
 
-        if (parameterNamesCount > 1)
-        {
-            cppCode += ", ";
-        }
+    while (!threadPool.waitForDone(50))
+    {
+        emit SetProgressValue(completedCount.loadRelaxed());
     }
+}
 
-    for (int j = 0; j < parameterNamesCount; j++)
+/*
+* Sorts symbols so every type is placed after types which it references. References are followed only to symbols
+* which are exported, if reference closes cycle then type which it references is forward declared instead.
+* Every type which is referenced before its definition ends up in forward declarations
+*/
+void PDB::SortSymbolRecordsByDependencies(const SymbolRecord* records, int count, QVector<SymbolRecord>* sortedRecords,
+    QVector<SymbolRecord>* forwardDeclarations)
+{
+    struct StackEntry
+    {
+        int index;
+        QVector<SymbolRecord> references;
+        int nextReference;
+    };
+
+    enum class VisitState : char
+    {
+        notVisited,
+        visiting,
+        visited
+    };
+
+    QHash<DWORD, int> indices;
+    QVector<VisitState> visitStates(count, VisitState::notVisited);
+    QSet<DWORD> forwardDeclaredTypes;
+    QVector<StackEntry> stack;
+
+    indices.reserve(count);
+    sortedRecords->reserve(count);
+
+    for (int i = count - 1; i >= 0; i--)
     {
-        if (j == 0 && element->dataChildren.at(0).data.dataKind == DataIsObjectPtr)
+        indices.insert(records[i].id, i);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (visitStates.at(i) != VisitState::notVisited || indices.value(records[i].id) != i)
         {
             continue;
         }
 
-        QString parameterName = element->dataChildren.at(j).data.name;
+        visitStates[i] = VisitState::visiting;
+        stack.append({ i, typeGraph.GetReferences(records[i].id), 0 });
 
-        if (cppCode.contains("(*)"))
+        while (!stack.isEmpty())
         {
-            cppCode = cppCode.replace("(*)", QString("(*%1)").arg(parameterName));
+            StackEntry& entry = stack.last();
+
+            if (entry.nextReference == entry.references.count())
+            {
+                visitStates[entry.index] = VisitState::visited;
+                sortedRecords->append(records[entry.index]);
+                stack.removeLast();
+
+                continue;
+            }
+
+            const SymbolRecord& reference = entry.references.at(entry.nextReference++);
+            auto it = indices.constFind(reference.id);
+
+            if (it == indices.constEnd())
+            {
+                continue;
+            }
+
+            int index = it.value();
+
+            if (visitStates.at(index) == VisitState::visiting)
+            {
+                if (!forwardDeclaredTypes.contains(reference.id))
+                {
+                    forwardDeclarations->append(records[index]);
+                    forwardDeclaredTypes.insert(reference.id);
+                }
+            }
+            else if (visitStates.at(index) == VisitState::notVisited)
+            {
+                visitStates[index] = VisitState::visiting;
+                stack.append({ index, typeGraph.GetReferences(records[index].id), 0 });
+            }
         }
-        else
+    }
+}
+
+/*
+* Writes all symbols to one header (and one source file) which is named after PDB. Types are sorted by dependencies
+* so header compiles without includes of other exported types, code is collected in buffer which is written
+* to file only when it's full
+*/
+void PDB::ExportSymbolsToSingleHeader(const SymbolRecord* records, int count)
+{
+    QVector<SymbolRecord> sortedRecords;
+    QVector<SymbolRecord> forwardDeclarations;
+    QString manifestPath = GetExportManifestPath();
+    ExportManifest manifest;
+    TypeSignature typeSignature(&tpiStream);
+    quint64 signature = GetExportOptionsSignature();
+
+    //Header is generated again if signature of any type changed
+    for (int i = 0; i < count && signature; i++)
+    {
+        quint64 signature2 = GetTypeSignature(typeSignature, records[i]);
+
+        signature = signature2 ? TypeSignature::Hash(signature, signature2) : 0;
+    }
+
+    QFileInfo fileInfo(filePath);
+    QString currentDirectory = fileInfo.absolutePath();
+    bool hasSourceCode = options->generateOnlySource || options->generateBoth;
+
+    manifest.Load(manifestPath);
+
+    if (signature && manifest.GetSignature(fileNameWithoutExtension) == signature &&
+        QFile::exists(QString("%1/include/%2.h").arg(currentDirectory).arg(fileNameWithoutExtension)) &&
+        (!hasSourceCode || QFile::exists(QString("%1/src/%2.cpp").arg(currentDirectory).arg(fileNameWithoutExtension))))
+    {
+        SendStatusMessageToProcessDialog(QString("%1.h wasn't changed").arg(fileNameWithoutExtension));
+
+        return;
+    }
+
+    SendStatusMessageToProcessDialog("Sorting types by dependencies...");
+
+    emit SetProgressMinimum(0);
+    emit SetProgressMaximum(count);
+
+    BuildTypeGraph(records, count);
+
+    if (!processEnabled)
+    {
+        return;
+    }
+
+    SortSymbolRecordsByDependencies(records, count, &sortedRecords, &forwardDeclarations);
+
+    QStringList forwardDeclarationCodes;
+    QStringList undeclaredTypeNames;
+    int forwardDeclarationsCount = forwardDeclarations.count();
+
+    for (int i = 0; i < forwardDeclarationsCount; i++)
+    {
+        QString forwardDeclaration;
+
+        if (GetForwardDeclaration(forwardDeclarations.at(i), &forwardDeclaration))
         {
-            cppCode += parameterName;
+            forwardDeclarationCodes.append(forwardDeclaration);
         }
-
-        if (j != parameterNamesCount - 1)
+        else
         {
-            cppCode += ", ";
+            undeclaredTypeNames.append(forwardDeclarations.at(i).typeName);
         }
     }
 
-    cppCode += QString("args...);\r\n%1}\r\n").arg(GetTab(level));
+    //Header in which type is used before it's declared wouldn't compile so it isn't written at all
+    if (undeclaredTypeNames.count() > 0)
+    {
+        QString statusMessage = QString("Failed to export %1.h, these types are referenced before their definition and can't be forward declared: %2")
+            .arg(fileNameWithoutExtension).arg(undeclaredTypeNames.join(", "));
 
-    functionParameterNames.clear();
+        SendStatusMessageToProcessDialog(statusMessage);
+        emit SendStatusMessage(statusMessage);
 
-    return cppCode;
-}
+        manifest.RemoveSignature(fileNameWithoutExtension);
+        manifest.Save(manifestPath);
 
-QString PDB::GetBaseAddressVariableName()
-{
-    QString baseAddressVariableName = fileNameWithoutExtension;
-    QStringList parts = baseAddressVariableName.split('.', QString::SkipEmptyParts);
-    int count = parts.count();
+        return;
+    }
 
-    for (int j = 1; j < count; j++)
+    if (!QDir(QString("%1/include").arg(currentDirectory)).exists())
     {
-        parts[j].replace(0, 1, parts[j][0].toUpper());
+        QDir().mkdir(QString("%1/include").arg(currentDirectory));
     }
 
-    return parts.join("");
-}
+    if (hasSourceCode && !QDir(QString("%1/src").arg(currentDirectory)).exists())
+    {
+        QDir().mkdir(QString("%1/src").arg(currentDirectory));
+    }
 
-void PDB::SetFileNameWithoutExtension(const QString& fileNameWithoutExtension)
-{
-    this->fileNameWithoutExtension = fileNameWithoutExtension;
-}
+    QFile headerFile(QString("%1/include/%2.h").arg(currentDirectory).arg(fileNameWithoutExtension));
+    QFile cppFile(QString("%1/src/%2.cpp").arg(currentDirectory).arg(fileNameWithoutExtension));
 
-void PDB::SetWindowTitle(const QString& windowTitle)
-{
-    this->windowTitle = windowTitle;
-}
+    if (!headerFile.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+        hasSourceCode && !cppFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        SendStatusMessageToProcessDialog(QString("Failed to create %1.h").arg(fileNameWithoutExtension));
 
-void PDB::SetFilePath(const QString& filePath)
-{
-    this->filePath = filePath;
-}
+        return;
+    }
 
-void PDB::SetProcessType(ProcessType processType)
-{
-    this->processType = processType;
-}
+    QByteArray headerBuffer;
+    QByteArray cppBuffer;
+    QSet<QString> exportedNames;
 
-void PDB::ExportSymbol(SymbolRecord symbolRecord)
-{
-    QString name = symbolRecord.typeName;
+    headerBuffer.reserve(exportBufferSize);
+    headerBuffer += "#pragma once\r\n\r\n";
 
-    if (name.contains("<"))
+    for (const QString& forwardDeclaration : forwardDeclarationCodes)
     {
-        name = name.mid(0, name.indexOf("<"));
+        headerBuffer += forwardDeclaration.toLatin1();
+        headerBuffer += "\r\n";
     }
 
-    if (name.contains("::"))
+    if (forwardDeclarationsCount > 0)
     {
-        name = name.mid(0, name.indexOf("::"));
+        headerBuffer += "\r\n";
     }
 
-    if (processType == ProcessType::exportUDTsAndEnums && (options->generateOnlyHeader || options->generateBoth))
+    if (hasSourceCode)
     {
-        SendStatusMessage(QString("Generating: %1.h").arg(name));
+        cppBuffer.reserve(exportBufferSize);
+        cppBuffer += QString("#include \"%1.h\"\r\n").arg(fileNameWithoutExtension).toLatin1();
+        cppBuffer += "#include \"Function.h\"\r\n";
+        cppBuffer += "#include \"BaseAddresses.h\"\r\n\r\n";
     }
-    else if ((processType == ProcessType::exportUDTsAndEnumsWithDependencies ||
-        processType == ProcessType::exportAllUDTsAndEnums) &&
-        (options->generateOnlyHeader || options->generateBoth))
+
+    ExportSymbols(sortedRecords.constData(), sortedRecords.count(), [&](const ExportedSymbol& exportedSymbol)
+    {
+        //The same as when every symbol has its own file, only first symbol with some name is exported
+        if (exportedNames.contains(exportedSymbol.name))
+        {
+            return;
+        }
+
+        exportedNames.insert(exportedSymbol.name);
+
+        headerBuffer += RemoveIncludeDirectives(exportedSymbol.headerCode.ToString()).toLatin1();
+        headerBuffer += "\r\n";
+
+        if (headerBuffer.size() >= exportBufferSize)
+        {
+            headerFile.write(headerBuffer);
+            headerBuffer.clear();
+        }
+
+        if (exportedSymbol.hasSourceCode)
+        {
+            cppBuffer += RemoveIncludeDirectives(exportedSymbol.cppCode.ToString()).toLatin1();
+            cppBuffer += "\r\n";
+
+            if (cppBuffer.size() >= exportBufferSize)
+            {
+                cppFile.write(cppBuffer);
+                cppBuffer.clear();
+            }
+        }
+    });
+
+    headerFile.write(headerBuffer);
+    headerFile.close();
+
+    if (hasSourceCode)
+    {
+        cppFile.write(cppBuffer);
+        cppFile.close();
+    }
+
+    //Header which wasn't completed is generated again next time
+    if (signature && processEnabled)
+    {
+        manifest.SetSignature(fileNameWithoutExtension, signature);
+    }
+    else
+    {
+        manifest.RemoveSignature(fileNameWithoutExtension);
+    }
+
+    manifest.Save(manifestPath);
+}
+
+/*
+* Types in namespace are declared inside of the same namespace as their definition. Nested types can't be declared
+* without definition of their parent, templates without their primary template and enums without underlying type
+* so false is returned for them
+*/
+bool PDB::GetForwardDeclaration(const SymbolRecord& symbolRecord, QString* forwardDeclaration)
+{
+    QString name = symbolRecord.typeName;
+    QString parentName;
+
+    if (name.contains("<") || symbolRecord.type == SymbolType::enumType)
     {
-        SendStatusMessageToProcessDialog(QString("Generating: %1.h").arg(name));
+        return false;
     }
 
-    Element element = GetElement(&symbolRecord);
-    QString elementInfo = GetElementInfo(&element);
+    if (name.contains("::"))
+    {
+        SymbolRecord symbolRecord2 = symbolRecord;
+        ResolutionContext context(options);
+        ResolutionContextScope contextScope(&context);
+        Element element = GetElement(&symbolRecord2);
 
-    QFileInfo fileInfo(filePath);
-    QString currentDirectory = fileInfo.absolutePath();
+        parentName = GetParentClassName(name);
 
-    if (!QDir(QString("%1/include").arg(currentDirectory)).exists())
-    {
-        QDir().mkdir(QString("%1/include").arg(currentDirectory));
+        if (parentName.isEmpty() || parentName.contains("<") || diaSymbols->contains(parentName) ||
+            element.elementType != ElementType::udtType || std::as_const(element).udt->isNested)
+        {
+            return false;
+        }
+
+        name = name.mid(parentName.length() + 2);
     }
 
-    QFile headerFile(QString("%1/include/%2.h").arg(currentDirectory).arg(name));
+    QString declaration;
 
-    if (!headerFile.exists() && headerFile.open(QIODevice::ReadWrite))
+    switch (symbolRecord.type)
     {
-        headerFile.write(elementInfo.toLatin1().data(), elementInfo.length());
-        headerFile.close();
+    case SymbolType::classType:
+    case SymbolType::interfaceType:
+        declaration = QString("class %1;").arg(name);
+
+        break;
+    case SymbolType::unionType:
+        declaration = QString("union %1;").arg(name);
+
+        break;
+    default:
+        declaration = QString("struct %1;").arg(name);
+
+        break;
     }
 
-    if (options->generateOnlySource || options->generateBoth)
+    if (parentName.length() > 0)
     {
-        if (processType == ProcessType::exportUDTsAndEnums && (options->generateOnlyHeader || options->generateBoth))
-        {
-            SendStatusMessage(QString("Generating: %1.cpp").arg(symbolRecord.typeName));
-        }
-        else if (processType == ProcessType::exportAllUDTsAndEnums && (options->generateOnlyHeader || options->generateBoth))
-        {
-            SendStatusMessageToProcessDialog(QString("Generating: %1.cpp").arg(symbolRecord.typeName));
-        }
+        *forwardDeclaration = QString("namespace %1\r\n{\r\n    %2\r\n}").arg(parentName).arg(declaration);
+    }
+    else
+    {
+        *forwardDeclaration = declaration;
+    }
 
-        QString cppCode = GenerateCPPCode(&element);
+    return true;
+}
 
-        cppCode.prepend("#include \"BaseAddresses.h\"\r\n\r\n");
-        cppCode.prepend("#include \"Function.h\"\r\n");
-        cppCode.prepend(QString("#include \"%1.h\"\r\n").arg(name));
+//Exported types are in the same header so includes of their headers and include guards are removed
+QString PDB::RemoveIncludeDirectives(const QString& code)
+{
+    QStringList lines = code.split("\r\n");
+    QStringList lines2;
+    int count = lines.count();
 
-        if (!QDir(QString("%1/src").arg(currentDirectory)).exists())
+    for (int i = 0; i < count; i++)
+    {
+        const QString& line = lines.at(i);
+
+        if (line.startsWith("#pragma once") || line.startsWith("#include \""))
         {
-            QDir().mkdir(QString("%1/src").arg(currentDirectory));
+            continue;
         }
 
-        QFile cppFile(QString("%1/src/%2.cpp").arg(currentDirectory).arg(name));
-
-        if (!cppFile.exists() && cppFile.open(QIODevice::WriteOnly))
+        if (line.isEmpty() && lines2.isEmpty())
         {
-            cppFile.write(cppCode.toLatin1().data(), cppCode.length());
-            cppFile.close();
+            continue;
         }
+
+        lines2.append(line);
     }
+
+    return lines2.join("\r\n");
 }
 
-void PDB::GetDependencies(const Element* element)
+void PDB::GetTypeReferences(const Element* element, QVector<SymbolRecord>* references, QSet<DWORD>* referencedTypes)
 {
     int count = element->children.count();
 
-    for (int i = 0; i < count && processEnabled; i++)
+    for (int i = 0; i < count; i++)
     {
-        if (element->children.at(i).elementType == ElementType::baseClassType)
+        const Element& childElement = element->children.at(i);
+
+        if (childElement.elementType == ElementType::baseClassType)
         {
             SymbolRecord symbolRecord;
-            QHash<QString, DWORD>::const_iterator it = diaSymbols->find(element->children.at(i).baseClass.name);
-
-            if (it == diaSymbols->end())
-            {
-                continue;
-            }
-
-            symbolRecord.id = it.value();
-            symbolRecord.typeName = element->children.at(i).baseClass.name;
 
             //It's only important to detect if type is enum because enums shouldn't be imported
-            if (element->dataChildren.at(i).data.isTypeNameOfEnum)
-            {
-                symbolRecord.type = SymbolType::enumType;
-            }
-
-            QHash<int, SymbolRecord>::const_iterator it2 = dependencies.find(symbolRecord.id);
-
-            if (it2 != dependencies.end())
+            if (GetSymbolRecordByTypeName(childElement.baseClass->name, &symbolRecord))
             {
-                continue;
+                AddTypeReference(symbolRecord, references, referencedTypes);
             }
-
-            dependencies.insert(symbolRecord.id, symbolRecord);
-            GetDependencies(&element->children.at(i));
         }
-        else if (element->children.at(i).elementType == ElementType::dataType)
+        else if (childElement.elementType == ElementType::dataType)
         {
-            if (element->dataChildren.at(i).data.hasChildren && !element->dataChildren.at(i).data.isTypeNameOfEnum)
+            if (childElement.data->hasChildren && !childElement.data->isTypeNameOfEnum)
             {
-                Element element2 = element->dataChildren.at(i);
-                element2.elementType = ElementType::udtType;
-
-                GetDependencies(&element2);
+                GetTypeReferences(&childElement, references, referencedTypes);
             }
-            else if (element->children.at(i).data.baseType == 0)
+            else if (childElement.data->baseType == 0)
             {
                 SymbolRecord symbolRecord;
-                QString typeName = element->children.at(i).data.typeName;
+                QString typeName = childElement.data->typeName;
 
-                if (!CheckIfNameOfMainOrInnerUDT(typeName, element->children.at(i).data.parentClassName))
+                if (!CheckIfNameOfMainOrInnerUDT(typeName, childElement.data->parentClassName) &&
+                    GetSymbolRecordByTypeName(childElement.data->originalTypeName, &symbolRecord))
                 {
-                    QHash<QString, DWORD>::const_iterator it = diaSymbols->find(element->children.at(i).data.originalTypeName);
-
-                    if (it == diaSymbols->end())
-                    {
-                        continue;
-                    }
-
-                    symbolRecord.id = it.value();
                     symbolRecord.typeName = typeName;
 
-                    if (element->dataChildren.at(i).data.isTypeNameOfEnum)
-                    {
-                        symbolRecord.type = SymbolType::enumType;
-                    }
-
-                    QHash<int, SymbolRecord>::const_iterator it2 = dependencies.find(symbolRecord.id);
-
-                    if (it2 != dependencies.end())
-                    {
-                        continue;
-                    }
-
-                    dependencies.insert(symbolRecord.id, symbolRecord);
-
-                    Element element2 = GetElement(&symbolRecord);
-
-                    GetDependencies(&element2);
+                    AddTypeReference(symbolRecord, references, referencedTypes);
                 }
             }
         }
-        else if (element->children.at(i).elementType == ElementType::functionType)
+        else if (childElement.elementType == ElementType::functionType)
         {
-            IDiaSymbol* symbol;
             SymbolRecord symbolRecord;
-            int parametersCount = element->children.at(i).function.parameters.count();
+            int parametersCount = childElement.function->parameters.count();
 
             for (int j = 0; j < parametersCount; j++)
             {
-                QString parameterType = element->children.at(i).function.parameters.at(j);
+                QString parameterType = childElement.function->parameters.at(j);
 
                 FormatString(parameterType);
 
-                if (!CheckIfNameOfMainOrInnerUDT(parameterType, element->children.at(i).function.parentClassName))
+                if (!CheckIfNameOfMainOrInnerUDT(parameterType, childElement.function->parentClassName) &&
+                    GetSymbolRecordByTypeName(parameterType, &symbolRecord))
                 {
-                    QHash<QString, DWORD>::const_iterator it = diaSymbols->find(parameterType);
-
-                    if (it == diaSymbols->end())
-                    {
-                        continue;
-                    }
-
-                    symbolRecord.id = it.value();
-                    symbolRecord.typeName = parameterType;
-
-                    if (element->dataChildren.at(i).data.isTypeNameOfEnum)
-                    {
-                        symbolRecord.type = SymbolType::enumType;
-                    }
-
-                    QHash<int, SymbolRecord>::const_iterator it2 = dependencies.find(symbolRecord.id);
-
-                    if (it2 != dependencies.end())
-                    {
-                        continue;
-                    }
-
-                    dependencies.insert(symbolRecord.id, symbolRecord);
-
-                    Element element2 = GetElement(&symbolRecord);
-
-                    GetDependencies(&element2);
+                    AddTypeReference(symbolRecord, references, referencedTypes);
                 }
             }
 
-            if (element->children.at(i).function.returnType1.baseType == 0)
+            if (childElement.function->returnType1.baseType == 0)
             {
-                QString returnType = element->children.at(i).function.returnType2;
+                QString returnType = childElement.function->returnType2;
 
                 FormatString(returnType);
 
-                if (!CheckIfNameOfMainOrInnerUDT(returnType, element->children.at(i).function.parentClassName))
+                if (!CheckIfNameOfMainOrInnerUDT(returnType, childElement.function->parentClassName) &&
+                    GetSymbolRecordByTypeName(returnType, &symbolRecord))
                 {
-                    QHash<QString, DWORD>::const_iterator it = diaSymbols->find(returnType);
-
-                    if (it == diaSymbols->end())
-                    {
-                        continue;
-                    }
-
-                    symbolRecord.id = it.value();
-                    symbolRecord.typeName = returnType;
-
-                    if (element->dataChildren.at(i).data.isTypeNameOfEnum)
-                    {
-                        symbolRecord.type = SymbolType::enumType;
-                    }
-
-                    QHash<int, SymbolRecord>::const_iterator it2 = dependencies.find(symbolRecord.id);
-
-                    if (it2 != dependencies.end())
-                    {
-                        continue;
-                    }
-
-                    dependencies.insert(symbolRecord.id, symbolRecord);
-
-                    Element element2 = GetElement(&symbolRecord);
-
-                    GetDependencies(&element2);
+                    AddTypeReference(symbolRecord, references, referencedTypes);
                 }
             }
         }
-        else if (element->children.at(i).elementType == ElementType::udtType)
+        else if (childElement.elementType == ElementType::udtType)
         {
-            GetDependencies(&element->children.at(i));
+            GetTypeReferences(&childElement, references, referencedTypes);
         }
     }
 }
 
-void PDB::ExportSymbolWithDependencies(SymbolRecord* symbolRecord)
+void PDB::AddTypeReference(const SymbolRecord& symbolRecord, QVector<SymbolRecord>* references, QSet<DWORD>* referencedTypes)
 {
-    processEnabled = true;
-
-    ExportSymbol(*symbolRecord);
-
-    Element element = GetElement(symbolRecord);
-
-    SendStatusMessageToProcessDialog("Getting dependencies...");
-
-    GetDependencies(&element);
-
-    int count = dependencies.count();
-
-    emit SetProgressMinimum(0);
-    emit SetProgressMaximum(count);
-
-    int currentIndex = 0;
-    int currentProcent = 0;
-    int procent = count / 1000;
-
-    int i = 0;
-    QList<SymbolRecord> dependencies = this->dependencies.values();
-
-    while (i < count && processEnabled)
+    if (!referencedTypes->contains(symbolRecord.id))
     {
-        ExportSymbol(dependencies.at(i));
-
-        if (currentIndex > currentProcent * procent)
-        {
-            currentProcent++;
-            emit SetProgressValue(currentIndex);
-        }
-
-        currentIndex++;
-        i++;
+        references->append(symbolRecord);
+        referencedTypes->insert(symbolRecord.id);
     }
-
-    emit Completed();
 }
 
-void PDB::ExportAllSymbols()
+void PDB::ExportSymbolWithDependencies(SymbolRecord* symbolRecord)
 {
     processEnabled = true;
 
-    int count = symbolRecords->size();
-
-    emit SetProgressMinimum(0);
-    emit SetProgressMaximum(count);
-
-    int currentIndex = 0;
-    int currentProcent = 0;
-    int procent = count / 1000;
-
-    int i = 0;
-
-    while (i < count && processEnabled)
-    {
-        ExportSymbol(symbolRecords->at(i));
-
-        if (currentIndex > currentProcent * procent)
-        {
-            currentProcent++;
-            emit SetProgressValue(currentIndex);
-        }
-
-        currentIndex++;
-        i++;
-    }
-
-    emit Completed();
-}
-
-void PDB::FormatString(QString& string)
-{
-    if (string.contains("<"))
-    {
-        string.replace("class ", "");
-        string.replace("struct ", "");
-        string.replace("union ", "");
-        string.replace("enum ", "");
-    }
+    SendStatusMessageToProcessDialog("Getting dependencies...");
 
-    string.replace(" >", ">");
-    string.replace(" ,", ", ");
+    QVector<SymbolRecord> dependencies = GetDependencies(*symbolRecord);
 
-    if (!string.contains(", ")) //There are cases when template already has white space after ','
+    if (options->exportToSingleHeader)
     {
-        string.replace(",", ", ");
-    }
-
-    string.replace(" *", "*");
-    string.replace(" &", "&");
-}
+        dependencies.append(*symbolRecord);
 
-void PDB::GetVariables()
-{
-    if (!global)
-    {
-        return;
+        ExportSymbolsToSingleHeader(dependencies.constData(), dependencies.count());
     }
-
-    processEnabled = true;
-
-    this->functions->clear();
-
-    IDiaEnumSymbols* dataSymbols;
-    LONG count;
-
-    if (global->findChildren(SymTagData, nullptr, nsNone, &dataSymbols) != S_OK)
+    else
     {
-        return;
-    }
+        dependencies.prepend(*symbolRecord);
 
-    if (dataSymbols->get_Count(&count) != S_OK || !count)
-    {
-        return;
+        ExportChangedSymbols(dependencies.constData(), dependencies.count());
     }
 
-    emit SetProgressMinimum(0);
-    emit SetProgressMaximum(count);
-
-    int currentIndex = 0;
-    int currentProcent = 0;
-    int procent = count / 100;
-
-    GetSymbolsFromTable(dataSymbols, &currentIndex, &currentProcent, &procent);
-
-    dataSymbols->Release();
-
     emit Completed();
 }
 
-void PDB::GetFunctions()
+void PDB::ExportAllSymbols()
 {
-    if (!global)
-    {
-        return;
-    }
-
     processEnabled = true;
 
-    this->functions->clear();
-
-    IDiaEnumSymbols* functionSymbols;
-    LONG count;
+    int count = static_cast<int>(symbolRecords->size());
 
-    if (global->findChildren(SymTagFunction, nullptr, nsNone, &functionSymbols) != S_OK)
+    if (options->exportToSingleHeader)
     {
-        return;
+        ExportSymbolsToSingleHeader(symbolRecords->data(), count);
     }
-
-    if (functionSymbols->get_Count(&count) != S_OK || !count)
+    else
     {
-        return;
+        ExportChangedSymbols(symbolRecords->data(), count);
     }
 
-    emit SetProgressMinimum(0);
-    emit SetProgressMaximum(count);
-
-    int currentIndex = 0;
-    int currentProcent = 0;
-    int procent = count / 100;
-
-    GetSymbolsFromTable(functionSymbols, &currentIndex, &currentProcent, &procent);
-
-    functionSymbols->Release();
-
     emit Completed();
 }
 
-void PDB::GetPublicSymbols()
+void PDB::FormatString(QString& string)
 {
-    if (!global)
-    {
-        return;
-    }
-
-    processEnabled = true;
-
-    this->publicSymbols->clear();
-
-    IDiaEnumSymbols* publicSymbols;
-    LONG count;
-
-    if (global->findChildren(SymTagPublicSymbol, nullptr, nsNone, &publicSymbols) != S_OK)
-    {
-        return;
-    }
-
-    if (publicSymbols->get_Count(&count) != S_OK || !count)
+    if (string.length() > 0)
     {
-        return;
+        string = TypeName::Parse(string)->GetFormattedName();
     }
-
-    emit SetProgressMinimum(0);
-    emit SetProgressMaximum(count);
-
-    int currentIndex = 0;
-    int currentProcent = 0;
-    int procent = count / 100;
-
-    GetSymbolsFromTable(publicSymbols, &currentIndex, &currentProcent, &procent);
-
-    publicSymbols->Release();
-
-    emit Completed();
 }
 
 QString PDB::ModifyNamingCovention(const QString& name, bool isEnum, bool isFunction, bool isVariable)
@@ -11378,31 +12854,169 @@ QString PDB::RemoveHungarianNotationFromVariable(const QString& name)
     return result;
 }
 
+/*
+* Context which is set for current thread is used by worker threads,
+* all other callers share context of PDB so state is kept between their calls as before
+*/
+ResolutionContext* PDB::GetResolutionContext()
+{
+    ResolutionContext* context = ResolutionContext::GetCurrent();
+
+    return context ? context : &mainContext;
+}
+
 void PDB::ClearVTables()
 {
-    vTables.clear();
+    ResolutionContext* context = GetResolutionContext();
+
+    context->vTables.clear();
 }
 
 void PDB::ClearVirtualFunctionPrototypes()
 {
-    virtualFunctionPrototypes.clear();
+    ResolutionContext* context = GetResolutionContext();
+
+    context->virtualFunctionPrototypes.clear();
 }
 
 void PDB::ClearVTableNames()
 {
-    vTableNames.clear();
+    ResolutionContext* context = GetResolutionContext();
+
+    context->vTableNames.clear();
 }
 
 void PDB::ClearElements()
 {
-    elements.clear();
+    elements.Clear();
+    typeGraph.Clear();
+    layoutCache.Clear();
+}
+
+void PDB::SetElementCacheMemoryBudget(qint64 memoryBudget)
+{
+    elements.SetMemoryBudget(memoryBudget);
+}
+
+ElementCacheStatistics PDB::GetElementCacheStatistics()
+{
+    return elements.GetStatistics();
+}
+
+/*
+* Options which are applied only to derived elements in GetElement(symbolRecord) are excluded from fingerprint
+* of raw elements, fingerprint of derived elements contains all options which affect elements and generated code.
+* Every option has its own bit and highest bit is set for derived elements so different options never
+* have same fingerprint.
+*/
+quint64 PDB::GetOptionsFingerprint(bool isDerived)
+{
+    const bool rawOptions[] =
+    {
+        options->displayIncludes,
+        options->displayComments,
+        options->displayNonImplementedFunctions,
+        options->displayVTablePointerIfExists,
+        options->displayTypedefs,
+        options->displayFriendFunctionsAndClasses,
+        options->displayEmptyUDTAndEnums,
+        options->displayCallingConventions,
+        options->displayCallingConventionForFunctionPointers,
+        options->applyRuleOfThree,
+        options->applyReturnValueOptimization,
+        options->applyEmptyBaseClassOptimization,
+        options->removeScopeResolutionOperator,
+        options->includeConstKeyword,
+        options->includeVolatileKeyword,
+        options->addInlineKeywordToInlineFunctions,
+        options->declareStaticVariablesWithInlineKeyword,
+        options->addDeclspecKeywords,
+        options->addNoVTableKeyword,
+        options->addExplicitKeyword,
+        options->addNoexceptKeyword,
+        options->specifyTypeAlignment,
+        options->displayPaddingBytes,
+        options->displayWithTrailingReturnType,
+        options->displayWithTypedef,
+        options->displayWithUsing,
+        options->displayWithAuto,
+        options->useTemplateFunction,
+        options->useVAList,
+        options->useTypedefKeyword,
+        options->useUsingKeyword,
+        options->implementDefaultConstructorAndDestructor,
+        options->implementMethodsOfInnerUDT,
+        options->useUndname,
+        options->useCustomDemangler,
+        options->useIDANameStyle,
+        options->useGhidraNameStyle,
+        options->removeHungaryNotationFromUDTAndEnums,
+        options->modifyFunctionNames,
+        options->functionCamelCase,
+        options->functionPascalCase,
+        options->functionSnakeCase,
+        options->modifyVariableNames,
+        options->variableCamelCase,
+        options->variablePascalCase,
+        options->variableSnakeCase,
+        options->removeHungaryNotationFromVariable
+    };
+
+    const bool derivedOptions[] =
+    {
+        options->addDefaultCtorAndDtorToUDT,
+        options->declareFunctionsForStaticVariables,
+        options->includeOnlyPublicAccessSpecifier
+    };
+
+    static_assert(sizeof(rawOptions) + sizeof(derivedOptions) < 64, "Options don't fit to fingerprint");
+
+    quint64 fingerprint = 0;
+    int bit = 0;
+
+    for (bool option : rawOptions)
+    {
+        fingerprint |= static_cast<quint64>(option) << bit++;
+    }
+
+    if (isDerived)
+    {
+        for (bool option : derivedOptions)
+        {
+            fingerprint |= static_cast<quint64>(option) << bit++;
+        }
+
+        fingerprint |= 1ULL << 63;
+    }
+
+    return fingerprint;
+}
+
+/*
+* Fingerprint of options doesn't fit to key together with id so every distinct fingerprint gets index
+* which doesn't change while application runs. Indices start at 1 so 0 is never valid key.
+*/
+quint64 PDB::GetElementKey(DWORD id, bool isDerived)
+{
+    quint64 optionsFingerprint = GetOptionsFingerprint(isDerived);
+    QMutexLocker locker(&optionSetsMutex);
+    auto it = optionSets.find(optionsFingerprint);
+
+    if (it == optionSets.end())
+    {
+        it = optionSets.insert(optionsFingerprint, static_cast<quint32>(optionSets.count()) + 1);
+    }
+
+    return static_cast<quint64>(it.value()) << 32 | id;
 }
 
 void PDB::GetVTablesLayout(Element* element, QString& layout, quint64* offset, int level)
 {
+    ResolutionContext* context = GetResolutionContext();
+
     if (element->elementType == ElementType::udtType)
     {
-        vTableOffsets.insert(vTableNames.value(0), 0);
+        context->vTableOffsets.insert(context->vTableNames.value(0), 0);
 
         layout += "1>  +---\n";
     }
@@ -11417,11 +13031,11 @@ void PDB::GetVTablesLayout(Element* element, QString& layout, quint64* offset, i
 
             if (i > 0)
             {
-                *offset += element->children.at(i).baseClass.length;
+                *offset += element->children.at(i).baseClass->length;
                 
-                if (vTables.contains(element->children.at(i).baseClass.name))
+                if (context->vTables.contains(element->children.at(i).baseClass->name))
                 {
-                    vTableOffsets.insert(element->children.at(i).baseClass.name, *offset);
+                    context->vTableOffsets.insert(element->children.at(i).baseClass->name, *offset);
                 }
             }
 
@@ -11432,11 +13046,11 @@ void PDB::GetVTablesLayout(Element* element, QString& layout, quint64* offset, i
                 layout += " | ";
             }
 
-            layout += QString("+--- (base class %1)\r\n").arg(element->children.at(i).baseClass.name);
+            layout += QString("+--- (base class %1)\r\n").arg(element->children.at(i).baseClass->name);
 
             GetVTablesLayout(&element->children[i], layout, offset, level + 1);
 
-            if (element->children.at(i).baseClass.hasVTablePointer)
+            if (element->children.at(i).baseClass->hasVTablePointer)
             {
                 layout += QString("1> %1\t| ").arg(*offset);
 
@@ -11458,7 +13072,7 @@ void PDB::GetVTablesLayout(Element* element, QString& layout, quint64* offset, i
             layout += "+---\r\n";
         }
         else if (element->children.at(i).elementType == ElementType::dataType &&
-            element->children.at(i).data.dataKind != DataIsStaticMember)
+            element->children.at(i).data->dataKind != DataIsStaticMember)
         {
             if (*offset != 0 && element->children.at(i).offset != 0)
             {
@@ -11475,19 +13089,20 @@ void PDB::GetVTablesLayout(Element* element, QString& layout, quint64* offset, i
 
 QString PDB::GetVirtualFunctionsInfo(const Element* element)
 {
+    ResolutionContext* context = GetResolutionContext();
     QString virtualFunctionsInfo;
     QMap<int, QString>::const_iterator it;
     QMap<QString, int> virtualFunctions;
     QMultiMap<int, QString> adjustors;
 
-    for (it = vTableNames.begin(); it != vTableNames.end(); it++)
+    for (it = context->vTableNames.begin(); it != context->vTableNames.end(); it++)
     {
-        virtualFunctionsInfo += QString("1>%1::$vftable@%2:\n").arg(element->udt.name).arg(it.value());
+        virtualFunctionsInfo += QString("1>%1::$vftable@%2:\n").arg(element->udt->name).arg(it.value());
 
         QHash<QString, int>::const_iterator it2;
         int vTableOffset = 0;
 
-        for (it2 = vTableOffsets.begin(); it2 != vTableOffsets.end(); it2++)
+        for (it2 = context->vTableOffsets.begin(); it2 != context->vTableOffsets.end(); it2++)
         {
             if (it.value() == it2.key())
             {
@@ -11497,7 +13112,7 @@ QString PDB::GetVirtualFunctionsInfo(const Element* element)
 
         if (vTableOffset == 0)
         {
-            virtualFunctionsInfo += QString("1>  | &%1_meta\n").arg(element->udt.name);
+            virtualFunctionsInfo += QString("1>  | &%1_meta\n").arg(element->udt->name);
             virtualFunctionsInfo += QString("1>  |  %1\n").arg(vTableOffset);
         }
         else
@@ -11507,13 +13122,13 @@ QString PDB::GetVirtualFunctionsInfo(const Element* element)
 
         QHash<QString, QHash<QString, QString>>::const_iterator it3;
 
-        for (it3 = virtualFunctionPrototypes2.begin(); it3 != virtualFunctionPrototypes2.end(); it3++)
+        for (it3 = context->virtualFunctionPrototypes2.begin(); it3 != context->virtualFunctionPrototypes2.end(); it3++)
         {
             if (it.value() == it3.key())
             {
                 QHash<QString, int>::const_iterator it4;
-                QHash<QString, int> vTable = GetVTable(element->udt.vTableNames.value(it.key()));
-                QHash<QString, QString> vTableFunctions = getFunctionPrototypes(element->udt.vTableNames.value(it.key()));
+                QHash<QString, int> vTable = GetVTable(element->udt->vTableNames.value(it.key()));
+                QHash<QString, QString> vTableFunctions = getFunctionPrototypes(element->udt->vTableNames.value(it.key()));
                 QMap<int, QString> virtualFunctions2;
 
                 for (it4 = vTable.begin(); it4 != vTable.end(); it4++)
@@ -11575,7 +13190,7 @@ QString PDB::GetVirtualFunctionsInfo(const Element* element)
 
                 for (it6 = virtualFunctions.begin(); it6 != virtualFunctions.end(); it6++)
                 {
-                    if (it6.key().startsWith(element->udt.name))
+                    if (it6.key().startsWith(element->udt->name))
                     {
                         QString result = QString("1>%1 this adjustor: %2\n").arg(it6.key()).arg(it6.value());
 
@@ -11598,13 +13213,15 @@ QString PDB::GetVirtualFunctionsInfo(const Element* element)
 
 void PDB::GetMSVCLayout(Element* element, QString& layout, quint64* offset, int level)
 {
+    ResolutionContext* context = GetResolutionContext();
+
     if (element->elementType == ElementType::udtType &&
-        !element->data.hasChildren)
+        !element->data->hasChildren)
     {
-        layout += QString("1>%1 %2\tsize(%3):\n").arg(element->udt.type).arg(element->udt.name).arg(element->size);
+        layout += QString("1>%1 %2\tsize(%3):\n").arg(element->udt->type).arg(element->udt->name).arg(element->size);
         layout += "1>  +---\n";
 
-        vTableOffsets.insert(vTableNames.value(0), 0);
+        context->vTableOffsets.insert(context->vTableNames.value(0), 0);
     }
 
     int count = element->children.count();
@@ -11622,7 +13239,7 @@ void PDB::GetMSVCLayout(Element* element, QString& layout, quint64* offset, int
                 layout += " | ";
             }
 
-            layout += QString("+--- (base class %1)\r\n").arg(element->children.at(i).baseClass.name);
+            layout += QString("+--- (base class %1)\r\n").arg(element->children.at(i).baseClass->name);
 
             GetMSVCLayout(&element->children[i], layout, offset, level + 1);
 
@@ -11637,16 +13254,16 @@ void PDB::GetMSVCLayout(Element* element, QString& layout, quint64* offset, int
 
             if (i > 0)
             {
-                if (vTables.contains(element->children.at(i).baseClass.name))
+                if (context->vTables.contains(element->children.at(i).baseClass->name))
                 {
-                    vTableOffsets.insert(element->children.at(i).baseClass.name, *offset);
+                    context->vTableOffsets.insert(element->children.at(i).baseClass->name, *offset);
                 }
             }
         }
         else if (element->children.at(i).elementType == ElementType::dataType &&
-            element->children.at(i).data.dataKind != DataIsStaticMember)
+            element->children.at(i).data->dataKind != DataIsStaticMember)
         {
-            if (element->children.at(i).data.isVTablePointer)
+            if (element->children.at(i).data->isVTablePointer)
             {
                 layout += QString("1> %1\t| ").arg(*offset);
 
@@ -11662,7 +13279,7 @@ void PDB::GetMSVCLayout(Element* element, QString& layout, quint64* offset, int
                 continue;
             }
 
-            if (element->children.at(i).data.hasChildren && !element->children.at(i).data.isTypeNameOfEnum)
+            if (element->children.at(i).data->hasChildren && !element->children.at(i).data->isTypeNameOfEnum)
             {
                 Element element2 = element->children.at(i);
                 element2.elementType = ElementType::udtType;
@@ -11682,8 +13299,8 @@ void PDB::GetMSVCLayout(Element* element, QString& layout, quint64* offset, int
 
                         if (bitStart + bits <= element->children.at(i).size * 8)
                         {
-                            if (element->children.at(i).data.hasChildren &&
-                                element->children.at(i).udt.isAnonymousUnion)
+                            if (element->children.at(i).data->hasChildren &&
+                                element->children.at(i).udt->isAnonymousUnion)
                             {
                                 layout += QString("1> %1\t| ").arg(element->offset);
                             }
@@ -11697,7 +13314,7 @@ void PDB::GetMSVCLayout(Element* element, QString& layout, quint64* offset, int
                                 layout += " | ";
                             }
 
-                            layout += QString("%1 (bitstart=%2,nbits=%3)\n").arg(element->children.at(i).data.name)
+                            layout += QString("%1 (bitstart=%2,nbits=%3)\n").arg(element->children.at(i).data->name)
                                 .arg(bitStart).arg(bits);
                         }
                         else
@@ -11712,7 +13329,7 @@ void PDB::GetMSVCLayout(Element* element, QString& layout, quint64* offset, int
                                 layout += " | ";
                             }
 
-                            layout += QString("%1 (bitstart=0,nbits=%2)\n").arg(element->children.at(i).data.name).arg(bits);
+                            layout += QString("%1 (bitstart=0,nbits=%2)\n").arg(element->children.at(i).data->name).arg(bits);
                         }
 
                         bitStart += bits;
@@ -11723,14 +13340,14 @@ void PDB::GetMSVCLayout(Element* element, QString& layout, quint64* offset, int
                 }
                 else
                 {
-                    if (element->children.at(i).data.isPadding)
+                    if (element->children.at(i).data->isPadding)
                     {
                         layout += QString("1> \t| ");
                     }
                     else
                     {
-                        if (element->children.at(i).data.hasChildren &&
-                            element->children.at(i).udt.isAnonymousUnion)
+                        if (element->children.at(i).data->hasChildren &&
+                            element->children.at(i).udt->isAnonymousUnion)
                         {
                             layout += QString("1> %1\t| ").arg(element->offset);
                         }
@@ -11745,19 +13362,19 @@ void PDB::GetMSVCLayout(Element* element, QString& layout, quint64* offset, int
                         layout += " | ";
                     }
 
-                    if (element->children.at(i).data.isPadding)
+                    if (element->children.at(i).data->isPadding)
                     {
                         layout += QString("<alignment member> (size=%1)\n").arg(element->children.at(i).size);
                     }
                     else
                     {
-                        if (element->children.at(i).data.baseType == 0)
+                        if (element->children.at(i).data->baseType == 0)
                         {
-                            layout += QString("%1 %2\n").arg(element->children.at(i).data.typeName).arg(element->children.at(i).data.name);
+                            layout += QString("%1 %2\n").arg(element->children.at(i).data->typeName).arg(element->children.at(i).data->name);
                         }
                         else
                         {
-                            layout += QString("%1\n").arg(element->children.at(i).data.name);
+                            layout += QString("%1\n").arg(element->children.at(i).data->name);
                         }
                     }
                 }
@@ -11768,7 +13385,7 @@ void PDB::GetMSVCLayout(Element* element, QString& layout, quint64* offset, int
     }
 
     if (element->elementType == ElementType::udtType &&
-        !element->data.hasChildren)
+        !element->data->hasChildren)
     {
         layout += "1>  +---\n";
         layout += GetVirtualFunctionsInfo(element);
@@ -13,17 +13,21 @@ PDBExplorer::PDBExplorer(QWidget* parent) : QMainWindow(parent)
 
     menu = new QMenu(this);
     action = new QAction("Export", this);
-    symbolsViewProxyModel = new QSortFilterProxyModel(ui.tvSymbols);
+    lblCacheStatistics = new QLabel(this);
+    symbolTableModel = new SymbolTableModel(ui.tvSymbols);
     peHeaderParser = new PEHeaderParser();
     pdb = new PDB(nullptr, &options, peHeaderParser, &diaSymbols, &symbolRecords, &variables, &functions, &publicSymbols);
 
-    ui.tvSymbols->setModel(symbolsViewProxyModel);
+    ui.tvSymbols->setModel(symbolTableModel);
     ui.tvSymbols->setContextMenuPolicy(Qt::CustomContextMenu);
 
     menu->addAction(action);
 
     OptionsDialog::LoadOptions(&options);
 
+    SetCacheMemoryBudget();
+    ui.statusBar->addPermanentWidget(lblCacheStatistics);
+
     connect(ui.txtSearchSymbol, &QLineEdit::returnPressed, this, &PDBExplorer::BtnSearchSymbolClicked);
     connect(ui.tvSymbols, &QTableView::customContextMenuRequested, this, &PDBExplorer::CustomMenuRequested);
     connect(action, &QAction::triggered, this, &PDBExplorer::ExportSymbol);
@@ -39,6 +43,7 @@ PDBExplorer::PDBExplorer(QWidget* parent) : QMainWindow(parent)
     connect(ui.txtSearchSymbol, &QLineEdit::textChanged, this, &PDBExplorer::TxtSearchSymbolTextChanged);
     connect(ui.btnSearchSymbol, &QPushButton::clicked, this, &PDBExplorer::BtnSearchSymbolClicked);
     connect(ui.tvSymbols, &QTableView::clicked, this, &PDBExplorer::TVSymbolsClicked);
+    connect(symbolTableModel, &QAbstractItemModel::modelReset, this, &PDBExplorer::SymbolTableModelReset);
     
     connect(ui.chkClasses, &QCheckBox::toggled, this, &PDBExplorer::ChkClassesToggled);
     connect(ui.chkStructs, &QCheckBox::toggled, this, &PDBExplorer::ChkStructsToggled);
@@ -91,8 +96,6 @@ PDBExplorer::PDBExplorer(QWidget* parent) : QMainWindow(parent)
     ui.cbDisplayOptions->setEnabled(false);
 
     isFileOpened = false;
-
-    msvcDemangler = MSVCDemangler();
 }
 
 void PDBExplorer::SetupCodeEdtor(ScintillaEdit* codeEditor)
@@ -536,10 +539,15 @@ void PDBExplorer::OptionsActionTriggered()
 
     optionsDialog.exec();
 
-    if (optionsChanged)
+    SetCacheMemoryBudget();
+
+    //Elements are cached under fingerprint of options so cache doesn't have to be cleared
+    if (optionsChanged && isFileOpened)
     {
-        pdb->ClearElements();
+        HandleTableViewEvent();
     }
+
+    DisplayCacheStatistics();
 }
 
 void PDBExplorer::ExportAllTypesActionTriggered()
@@ -553,23 +561,19 @@ void PDBExplorer::ExportAllTypesActionTriggered()
 void PDBExplorer::ClearCacheActionTriggered()
 {
     pdb->ClearElements();
+    headerCodeCache.clear();
+
+    DisplayCacheStatistics();
 }
 
 void PDBExplorer::TxtSearchSymbolTextChanged(const QString& text)
 {
-    if (symbolRecords.size() < 40000)
-    {
-        symbolsViewProxyModel->setFilterRegExp(text);
-        symbolsViewProxyModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
-        symbolsViewProxyModel->setFilterKeyColumn(1);
-    }
+    symbolTableModel->SetSearchText(text);
 }
 
 void PDBExplorer::BtnSearchSymbolClicked()
 {
-    symbolsViewProxyModel->setFilterRegExp(ui.txtSearchSymbol->text());
-    symbolsViewProxyModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
-    symbolsViewProxyModel->setFilterKeyColumn(1);
+    symbolTableModel->SetSearchText(ui.txtSearchSymbol->text());
 }
 
 void PDBExplorer::OpenFile(const QString& filePath)
@@ -606,16 +610,10 @@ void PDBExplorer::OpenFile(const QString& filePath)
         DisplayFileInfo(filePath);
     }
 
-    QAbstractItemModel* symbolsViewOldModel = symbolsViewProxyModel->sourceModel();
     QAbstractItemModel* oldModel = proxyModel->sourceModel();
     QAbstractItemModel* oldModel2 = proxyModel2->sourceModel();
 
-    if (symbolsViewOldModel)
-    {
-        symbolsViewProxyModel->setSourceModel(0);
-
-        delete symbolsViewOldModel;
-    }
+    symbolTableModel->Clear();
 
     if (oldModel)
     {
@@ -639,6 +637,8 @@ void PDBExplorer::OpenFile(const QString& filePath)
     txtDemangledName->clear();
     txtAddress->clear();
     pdb->ClearElements();
+    headerCodeCache.clear();
+    DisplayCacheStatistics();
 
     if (!ui.cbDisplayOptions->isEnabled())
     {
@@ -649,31 +649,33 @@ void PDBExplorer::OpenFile(const QString& filePath)
     {
         DisplayStatusMessage("PDB opened successfully.");
 
-        ProcessType processType = GetProcessType();
-        PDBProcessDialog pdbProcessDialog(this, pdb, processType);
-
-        pdbProcessDialog.exec();
+        //Symbols are imported only if they aren't stored in index file from previous session
+        if (!pdb->LoadSymbolIndex())
+        {
+            PDBProcessDialog pdbProcessDialog(this, pdb, ProcessType::importSymbols);
 
-        if (symbolRecords.size() > 40000)
+            pdbProcessDialog.exec();
+        }
+        else
         {
-            ui.btnSearchSymbol->setVisible(true);
+            DisplayStatusMessage("Symbols are loaded from index.");
         }
 
-        switch (processType)
+        switch (ui.cbSymbolTypes->currentIndex())
         {
-        case ProcessType::importUDTsAndEnums:
+        case 0:
             AddSymbolsToList();
 
             break;
-        case ProcessType::importVariables:
+        case 1:
             AddDataSymbolsToList(&variables);
 
             break;
-        case ProcessType::importFunctions:
+        case 2:
             AddFunctionSymbolsToList(&functions);
 
             break;
-        case ProcessType::importPublicSymbols:
+        case 3:
             AddPublicSymbolsToList();
 
             break;
@@ -687,33 +689,6 @@ void PDBExplorer::OpenFile(const QString& filePath)
     }
 }
 
-ProcessType PDBExplorer::GetProcessType()
-{
-    ProcessType processType;
-
-    switch (ui.cbSymbolTypes->currentIndex())
-    {
-    case 0:
-        processType = ProcessType::importUDTsAndEnums;
-
-        break;
-    case 1:
-        processType = ProcessType::importVariables;
-
-        break;
-    case 2:
-        processType = ProcessType::importFunctions;
-
-        break;
-    case 3:
-        processType = ProcessType::importPublicSymbols;
-
-        break;
-    }
-
-    return processType;
-}
-
 void PDBExplorer::DisplayFileInfo(const QString& filePath)
 {
     QFileInfo fileInfo(filePath);
@@ -795,6 +770,7 @@ void PDBExplorer::HandleTableViewEvent()
     }
 
     DisplayStatusMessage("Done.");
+    DisplayCacheStatistics();
 }
 
 SymbolRecord PDBExplorer::GetSelectedSymbolRecord()
@@ -864,13 +840,6 @@ void PDBExplorer::HandleDataType()
 
     if (isFileOpened)
     {
-        if (variables.count() == 0)
-        {
-            PDBProcessDialog pdbProcessDialog(this, pdb, ProcessType::importVariables);
-
-            pdbProcessDialog.exec();
-        }
-
         AddDataSymbolsToList(&variables);
     }
 }
@@ -895,13 +864,6 @@ void PDBExplorer::HandleFunctionType()
 
     if (isFileOpened)
     {
-        if (functions.count() == 0)
-        {
-            PDBProcessDialog pdbProcessDialog(this, pdb, ProcessType::importFunctions);
-
-            pdbProcessDialog.exec();
-        }
-
         AddFunctionSymbolsToList(&functions);
     }
 }
@@ -926,13 +888,6 @@ void PDBExplorer::HandlePublicSymbolType()
 
     if (isFileOpened)
     {
-        if (publicSymbols.count() == 0)
-        {
-            PDBProcessDialog pdbProcessDialog(this, pdb, ProcessType::importPublicSymbols);
-
-            pdbProcessDialog.exec();
-        }
-
         AddPublicSymbolsToList();
     }
 }
@@ -966,300 +921,37 @@ void PDBExplorer::DisableUDTAndEnumOptions()
 
 void PDBExplorer::ChkClassesToggled()
 {
-    if (ui.chkClasses->isChecked())
-    {
-        AddSymbolsToList(SymbolType::classType);
-    }
-    else
-    {
-        if (!ui.chkStructs->isChecked() &&
-            !ui.chkUnions->isChecked() &&
-            !ui.chkEnums->isChecked())
-        {
-            AddSymbolsToList();
-        }
-        else
-        {
-            RemoveSymbolsFromList(SymbolType::classType);
-        }
-    }
+    UpdateSymbolFilter();
 }
 
 void PDBExplorer::ChkStructsToggled()
 {
-    if (ui.chkStructs->isChecked())
-    {
-        AddSymbolsToList(SymbolType::structType);
-    }
-    else
-    {
-        if (!ui.chkClasses->isChecked() &&
-            !ui.chkUnions->isChecked() &&
-            !ui.chkEnums->isChecked())
-        {
-            AddSymbolsToList();
-        }
-        else
-        {
-            RemoveSymbolsFromList(SymbolType::structType);
-        }
-    }
+    UpdateSymbolFilter();
 }
 
 void PDBExplorer::ChkUnionsToggled()
 {
-    if (ui.chkUnions->isChecked())
-    {
-        AddSymbolsToList(SymbolType::unionType);
-    }
-    else
-    {
-        if (!ui.chkClasses->isChecked() &&
-            !ui.chkStructs->isChecked() &&
-            !ui.chkEnums->isChecked())
-        {
-            AddSymbolsToList();
-        }
-        else
-        {
-            RemoveSymbolsFromList(SymbolType::unionType);
-        }
-    }
+    UpdateSymbolFilter();
 }
 
 void PDBExplorer::ChkEnumsToggled()
 {
-    if (ui.chkEnums->isChecked())
-    {
-        AddSymbolsToList(SymbolType::enumType);
-    }
-    else
-    {
-        if (!ui.chkClasses->isChecked() &&
-            !ui.chkStructs->isChecked() &&
-            !ui.chkUnions->isChecked())
-        {
-            AddSymbolsToList();
-        }
-        else
-        {
-            RemoveSymbolsFromList(SymbolType::enumType);
-        }
-    }
+    UpdateSymbolFilter();
 }
 
 void PDBExplorer::ChkGlobalToggled()
 {
-    if (ui.chkGlobal->isChecked())
-    {
-        if (ui.cbSymbolTypes->currentIndex() == 1)
-        {
-            QHash<QString, DWORD> variables;
-
-            for (auto it = this->variables.begin(); it != this->variables.end(); it++)
-            {
-                IDiaSymbol* symbol;
-
-                if (pdb->GetSymbolByID(it.value(), &symbol))
-                {
-                    DWORD kind;
-                    DataKind dataKind;
-
-                    symbol->get_dataKind(&kind);
-                    dataKind = static_cast<DataKind>(kind);
-
-                    if (dataKind == DataIsGlobal || dataKind == DataIsConstant)
-                    {
-                        variables.insert(it.key(), it.value());
-                    }
-
-                    symbol->Release();
-                }
-            }
-
-            AddDataSymbolsToList(&variables, true);
-        }
-        else if (ui.cbSymbolTypes->currentIndex() == 2)
-        {
-            QHash<QString, DWORD> functions;
-
-            for (auto it = this->functions.begin(); it != this->functions.end(); it++)
-            {
-                IDiaSymbol* symbol;
-
-                if (pdb->GetSymbolByID(it.value(), &symbol))
-                {
-                    IDiaSymbol* parentClass;
-                    BSTR bString = nullptr;
-                    bool isMemberFunction = false;
-
-                    if (symbol->get_classParent(&parentClass) == S_OK)
-                    {
-                        parentClass->Release();
-
-                        isMemberFunction = true;
-                    }
-
-                    if (!isMemberFunction)
-                    {
-                        functions.insert(it.key(), it.value());
-                    }
-
-                    symbol->Release();
-                }
-            }
-
-            AddFunctionSymbolsToList(&functions, true, false, false);
-        }
-    }
-    else
-    {
-        if (!ui.chkMember->isChecked() &&
-            !ui.chkStatic->isChecked() &&
-            !ui.chkGlobal->isChecked())
-        {
-            if (ui.cbSymbolTypes->currentIndex() == 1)
-            {
-                AddDataSymbolsToList(&variables);
-            }
-            else if (ui.cbSymbolTypes->currentIndex() == 2)
-            {
-                AddFunctionSymbolsToList(&functions);
-            }
-        }
-        else
-        {
-            RemoveSymbolsFromList(0);
-        }
-    }
+    UpdateSymbolFilter();
 }
 
 void PDBExplorer::ChkStaticToggled()
 {
-    if (ui.chkStatic->isChecked())
-    {
-        if (ui.cbSymbolTypes->currentIndex() == 1)
-        {
-            QHash<QString, DWORD> variables;
-
-            for (auto it = this->variables.begin(); it != this->variables.end(); it++)
-            {
-                IDiaSymbol* symbol;
-
-                if (pdb->GetSymbolByID(it.value(), &symbol))
-                {
-                    DWORD kind;
-                    DataKind dataKind;
-
-                    symbol->get_dataKind(&kind);
-                    dataKind = static_cast<DataKind>(kind);
-
-                    if (dataKind == DataIsStaticMember || dataKind == DataIsFileStatic)
-                    {
-                        variables.insert(it.key(), it.value());
-                    }
-
-                    symbol->Release();
-                }
-            }
-
-            AddDataSymbolsToList(&variables, false);
-        }
-        else if (ui.cbSymbolTypes->currentIndex() == 2)
-        {
-            QHash<QString, DWORD> functions;
-
-            for (auto it = this->functions.begin(); it != this->functions.end(); it++)
-            {
-                IDiaSymbol* symbol;
-
-                if (pdb->GetSymbolByID(it.value(), &symbol))
-                {
-                    BOOL isStatic = 0;
-
-                    symbol->get_isStatic(&isStatic);
-
-                    if (symbol->get_isStatic(&isStatic) == S_OK && isStatic)
-                    {
-                        functions.insert(it.key(), it.value());
-                    }
-
-                    symbol->Release();
-                }
-            }
-
-            AddFunctionSymbolsToList(&functions, false, true, false);
-        }
-    }
-    else
-    {
-        if (!ui.chkMember->isChecked() &&
-            !ui.chkStatic->isChecked() &&
-            !ui.chkGlobal->isChecked())
-        {
-            if (ui.cbSymbolTypes->currentIndex() == 1)
-            {
-                AddDataSymbolsToList(&variables);
-            }
-            else if (ui.cbSymbolTypes->currentIndex() == 2)
-            {
-                AddFunctionSymbolsToList(&functions);
-            }
-        }
-        else
-        {
-            RemoveSymbolsFromList(1);
-        }
-    }
+    UpdateSymbolFilter();
 }
 
 void PDBExplorer::ChkMemberToggled()
 {
-    if (ui.chkMember->isChecked())
-    {
-        QHash<QString, DWORD> functions;
-
-        for (auto it = this->functions.begin(); it != this->functions.end(); it++)
-        {
-            IDiaSymbol* symbol;
-
-            if (pdb->GetSymbolByID(it.value(), &symbol))
-            {
-                IDiaSymbol* parentClass;
-                BSTR bString = nullptr;
-                bool isMemberFunction = false;
-
-                if (symbol->get_classParent(&parentClass) == S_OK)
-                {
-                    parentClass->Release();
-
-                    isMemberFunction = true;
-                }
-
-                if (isMemberFunction)
-                {
-                    functions.insert(it.key(), it.value());
-                }
-
-                symbol->Release();
-            }
-        }
-
-        AddFunctionSymbolsToList(&functions, false, false, true);
-    }
-    else
-    {
-        if (!ui.chkMember->isChecked() &&
-            !ui.chkStatic->isChecked() &&
-            !ui.chkGlobal->isChecked())
-        {
-            AddFunctionSymbolsToList(&functions);
-        }
-        else
-        {
-            RemoveSymbolsFromList(2);
-        }
-    }
+    UpdateSymbolFilter();
 }
 
 void PDBExplorer::CbSymbolTypesCurrentIndexChanged(int index)
@@ -1365,339 +1057,140 @@ void PDBExplorer::CbDisplayOptionsCurrentIndexChanged(int index)
 
 void PDBExplorer::AddSymbolsToList()
 {
-    int count = symbolRecords.size();
-    QStandardItemModel* model = new QStandardItemModel(count, 2, this);
-
-    model->setHeaderData(0, Qt::Horizontal, "ID");
-    model->setHeaderData(1, Qt::Horizontal, "Symbol Name");
+    symbolTableModel->SetSymbols(&symbolRecords);
 
-    for (int i = 0; i < count; i++)
-    {
-        QStandardItem* itemID = new QStandardItem();
-        QStandardItem* itemSymbol = new QStandardItem();
-
-        itemID->setData(static_cast<quint32>(symbolRecords[i].id), Qt::DisplayRole); //Reverse arguments (Qt::DisplayRole, symbolRecords[i].id))
-        itemID->setData(static_cast<quint32>(symbolRecords[i].type), Qt::UserRole);
-        model->setItem(i, 0, itemID);
-
-        itemSymbol->setText(symbolRecords[i].typeName);
-        itemSymbol->setData(symbolRecords[i].typeName, Qt::ToolTipRole);
-        model->setItem(i, 1, itemSymbol);
-    }
-
-    symbolsViewProxyModel->setSourceModel(model);
-    symbolsViewProxyModel->setFilterRegExp("");
-    symbolsViewProxyModel->setFilterKeyColumn(1);
-
-    ui.tvSymbols->setColumnHidden(0, true);
-    ui.tvSymbols->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+    UpdateSymbolFilter();
 }
 
-void PDBExplorer::AddSymbolsToList(SymbolType symbolType)
+void PDBExplorer::AddDataSymbolsToList(QHash<QString, DWORD>* variables)
 {
-    int row = 0;
-    int count = symbolRecords.size();
-    int rowCount = 0;
-
-    if (ui.chkClasses->isChecked())
-    {
-        rowCount += pdb->GetCountOfClasses();
-    }
-
-    if (ui.chkStructs->isChecked())
-    {
-        rowCount += pdb->GetCountOfStructs();
-    }
-
-    if (ui.chkUnions->isChecked())
-    {
-        rowCount += pdb->GetCountOfUnions();
-    }
-
-    if (ui.chkEnums->isChecked())
-    {
-        rowCount += pdb->GetCountOfEnums();
-    }
+    symbolTableModel->SetSymbols(variables);
 
-    QStandardItemModel* model = new QStandardItemModel(rowCount, 2, this);
-
-    model->setHeaderData(0, Qt::Horizontal, "ID");
-    model->setHeaderData(1, Qt::Horizontal, "Symbol Name");
-
-    for (int i = 0; i < count; i++)
-    {
-        if (symbolRecords[i].type == symbolType)
-        {
-            QStandardItem* itemID = new QStandardItem();
-            QStandardItem* itemSymbol = new QStandardItem();
-
-            itemID->setData(static_cast<quint32>(symbolRecords[i].id), Qt::DisplayRole);
-            itemID->setData(static_cast<quint32>(symbolRecords[i].type), Qt::UserRole);
-            model->setItem(row, 0, itemID);
-
-            itemSymbol->setText(symbolRecords[i].typeName);
-            itemSymbol->setData(symbolRecords[i].typeName, Qt::ToolTipRole);
-            model->setItem(row, 1, itemSymbol);
-
-            row++;
-        }
-    }
-
-    QStandardItemModel* standardItemModel = static_cast<QStandardItemModel*>(symbolsViewProxyModel->sourceModel());
-    int rowsCount2 = standardItemModel->rowCount();
-
-    if (count != rowsCount2)
-    {
-        for (int i = 0; i < rowsCount2; i++)
-        {
-            QStandardItem* itemID = standardItemModel->item(i);
-            QStandardItem* itemSymbol = standardItemModel->item(i, 1);
-
-            QStandardItem* itemID2 = new QStandardItem();
-            QStandardItem* itemSymbol2 = new QStandardItem();
-
-            quint32 id = itemID->data(Qt::DisplayRole).toUInt();
-            quint32 type = itemID->data(Qt::UserRole).toUInt();
-            QString typeName = itemSymbol->text();
-
-            itemID2->setData(id, Qt::DisplayRole);
-            itemID2->setData(type, Qt::UserRole);
-            model->setItem(row, 0, itemID2);
-
-            itemSymbol2->setText(typeName);
-            itemSymbol2->setData(typeName, Qt::ToolTipRole);
-            model->setItem(row, 1, itemSymbol2);
-
-            row++;
-        }
-    }
-
-    symbolsViewProxyModel->setSourceModel(model);
+    UpdateSymbolFilter();
 }
 
-void PDBExplorer::AddDataSymbolsToList(QHash<QString, DWORD>* variables)
+void PDBExplorer::AddFunctionSymbolsToList(QHash<QString, DWORD>* functions)
 {
-    int row = 0;
-    int count = variables->count();
-    QStandardItemModel* standardItemModel = new QStandardItemModel(count, 2, this);
-
-    standardItemModel->setHeaderData(0, Qt::Horizontal, "ID");
-    standardItemModel->setHeaderData(1, Qt::Horizontal, "Symbol Name");
-
-    for (auto it = variables->begin(); it != variables->end(); it++)
-    {
-        QStandardItem* itemID = new QStandardItem();
-        QStandardItem* itemSymbol = new QStandardItem();
-
-        itemID->setData(static_cast<quint32>(it.value()), Qt::DisplayRole);
-        standardItemModel->setItem(row, 0, itemID);
-
-        itemSymbol->setText(it.key());
-        itemSymbol->setData(it.key(), Qt::ToolTipRole);
-        standardItemModel->setItem(row, 1, itemSymbol);
+    symbolTableModel->SetSymbols(functions);
 
-        row++;
-    }
+    UpdateSymbolFilter();
+}
 
-    symbolsViewProxyModel->setSourceModel(standardItemModel);
-    symbolsViewProxyModel->setFilterRegExp("");
-    symbolsViewProxyModel->setFilterKeyColumn(1);
+void PDBExplorer::AddPublicSymbolsToList()
+{
+    symbolTableModel->SetSymbols(&publicSymbols);
 
-    ui.tvSymbols->setColumnHidden(0, true);
-    ui.tvSymbols->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+    UpdateSymbolFilter();
 }
 
-void PDBExplorer::AddDataSymbolsToList(QHash<QString, DWORD>* variables, bool isGlobal)
+/*
+* Filter contains categories of all checked options, if none of them is checked all symbols are displayed
+*/
+void PDBExplorer::UpdateSymbolFilter()
 {
-    int row = 0;
-    int count = variables->count();
-    QStandardItemModel* standardItemModel = new QStandardItemModel(count, 2, this);
-
-    standardItemModel->setHeaderData(0, Qt::Horizontal, "ID");
-    standardItemModel->setHeaderData(1, Qt::Horizontal, "Symbol Name");
+    quint32 categoryFilter = 0;
 
-    for (auto it = variables->begin(); it != variables->end(); it++)
+    switch (ui.cbSymbolTypes->currentIndex())
     {
-        QStandardItem* itemID = new QStandardItem();
-        QStandardItem* itemSymbol = new QStandardItem();
-
-        itemID->setData(static_cast<quint32>(it.value()), Qt::DisplayRole);
-
-        if (isGlobal)
+    case 0:
+        if (ui.chkClasses->isChecked())
         {
-            itemID->setData(0, Qt::UserRole);
+            categoryFilter |= SymbolTableModel::GetCategory(SymbolType::classType);
         }
-        else
+
+        if (ui.chkStructs->isChecked())
         {
-            itemID->setData(1, Qt::UserRole);
+            categoryFilter |= SymbolTableModel::GetCategory(SymbolType::structType);
         }
 
-        standardItemModel->setItem(row, 0, itemID);
-
-        itemSymbol->setText(it.key());
-        itemSymbol->setData(it.key(), Qt::ToolTipRole);
-        standardItemModel->setItem(row, 1, itemSymbol);
-
-        row++;
-    }
-
-    symbolsViewProxyModel->setSourceModel(standardItemModel);
-    symbolsViewProxyModel->setFilterRegExp("");
-    symbolsViewProxyModel->setFilterKeyColumn(1);
-
-    ui.tvSymbols->setColumnHidden(0, true);
-    ui.tvSymbols->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
-}
-
-void PDBExplorer::AddFunctionSymbolsToList(QHash<QString, DWORD>* functions)
-{
-    int row = 0;
-    int count = functions->count();
-    QStandardItemModel* standardItemModel = new QStandardItemModel(count, 2, this);
-
-    standardItemModel->setHeaderData(0, Qt::Horizontal, "ID");
-    standardItemModel->setHeaderData(1, Qt::Horizontal, "Symbol Name");
-
-    for (auto it = functions->begin(); it != functions->end(); it++)
-    {
-        QStandardItem* itemID = new QStandardItem();
-        QStandardItem* itemSymbol = new QStandardItem();
-
-        itemID->setData(static_cast<quint32>(it.value()), Qt::DisplayRole);
-        standardItemModel->setItem(row, 0, itemID);
-
-        itemSymbol->setText(it.key());
-        itemSymbol->setData(it.key(), Qt::ToolTipRole);
-        standardItemModel->setItem(row, 1, itemSymbol);
-
-        row++;
-    }
-
-    symbolsViewProxyModel->setSourceModel(standardItemModel);
-    symbolsViewProxyModel->setFilterRegExp("");
-    symbolsViewProxyModel->setFilterKeyColumn(1);
-
-    ui.tvSymbols->setColumnHidden(0, true);
-    ui.tvSymbols->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
-}
-
-void PDBExplorer::AddFunctionSymbolsToList(QHash<QString, DWORD>* functions, bool isGlobal, bool isStatic, bool isMember)
-{
-    int row = 0;
-    int count = functions->count();
-    QStandardItemModel* standardItemModel = new QStandardItemModel(count, 2, this);
-
-    standardItemModel->setHeaderData(0, Qt::Horizontal, "ID");
-    standardItemModel->setHeaderData(1, Qt::Horizontal, "Symbol Name");
-
-    for (auto it = functions->begin(); it != functions->end(); it++)
-    {
-        QStandardItem* itemID = new QStandardItem();
-        QStandardItem* itemSymbol = new QStandardItem();
-
-        itemID->setData(static_cast<quint32>(it.value()), Qt::DisplayRole);
+        if (ui.chkUnions->isChecked())
+        {
+            categoryFilter |= SymbolTableModel::GetCategory(SymbolType::unionType);
+        }
 
-        if (isGlobal)
+        if (ui.chkEnums->isChecked())
         {
-            itemID->setData(0, Qt::UserRole);
+            categoryFilter |= SymbolTableModel::GetCategory(SymbolType::enumType);
         }
-        else if (isStatic)
+
+        break;
+    case 1:
+    case 2:
+        if (ui.chkGlobal->isEnabled() && ui.chkGlobal->isChecked())
         {
-            itemID->setData(1, Qt::UserRole);
+            categoryFilter |= SymbolCategory::globalSymbol;
         }
-        else if (isMember)
+
+        if (ui.chkStatic->isEnabled() && ui.chkStatic->isChecked())
         {
-            itemID->setData(2, Qt::UserRole);
+            categoryFilter |= SymbolCategory::staticSymbol;
         }
 
-        standardItemModel->setItem(row, 0, itemID);
+        if (ui.chkMember->isEnabled() && ui.chkMember->isChecked())
+        {
+            categoryFilter |= SymbolCategory::memberSymbol;
+        }
 
-        itemSymbol->setText(it.key());
-        itemSymbol->setData(it.key(), Qt::ToolTipRole);
-        standardItemModel->setItem(row, 1, itemSymbol);
+        if (categoryFilter != 0 && !symbolTableModel->HasCategories())
+        {
+            ClassifySymbols();
+        }
 
-        row++;
+        break;
     }
 
-    symbolsViewProxyModel->setSourceModel(standardItemModel);
-    symbolsViewProxyModel->setFilterRegExp("");
-    symbolsViewProxyModel->setFilterKeyColumn(1);
-
-    ui.tvSymbols->setColumnHidden(0, true);
-    ui.tvSymbols->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+    symbolTableModel->SetCategoryFilter(categoryFilter);
 }
 
-void PDBExplorer::AddPublicSymbolsToList()
+//Categories are captured during import so DIA isn't queried when filter is changed
+void PDBExplorer::ClassifySymbols()
 {
-    int row = 0;
-    int count = publicSymbols.count();
-    QStandardItemModel* standardItemModel = new QStandardItemModel(count, 2, this);
+    int count = symbolTableModel->GetSymbolCount();
+    QVector<quint32> categories(count);
 
-    standardItemModel->setHeaderData(0, Qt::Horizontal, "ID");
-    standardItemModel->setHeaderData(1, Qt::Horizontal, "Symbol Name");
-
-    for (auto it = publicSymbols.begin(); it != publicSymbols.end(); it++)
+    for (int i = 0; i < count; i++)
     {
-        QStandardItem* itemID = new QStandardItem();
-        QStandardItem* itemSymbol = new QStandardItem();
-
-        itemID->setData(static_cast<quint32>(it.value()), Qt::DisplayRole);
-        standardItemModel->setItem(row, 0, itemID);
-
-        itemSymbol->setText(it.key());
-        itemSymbol->setData(it.key(), Qt::ToolTipRole);
-        standardItemModel->setItem(row, 1, itemSymbol);
-
-        row++;
+        categories[i] = GetSymbolCategories(pdb->GetSymbolAttributes(symbolTableModel->GetSymbolID(i)));
     }
 
-    symbolsViewProxyModel->setSourceModel(standardItemModel);
-    symbolsViewProxyModel->setFilterRegExp("");
-    symbolsViewProxyModel->setFilterKeyColumn(1);
+    symbolTableModel->SetCategories(categories);
+}
 
+void PDBExplorer::SymbolTableModelReset()
+{
     ui.tvSymbols->setColumnHidden(0, true);
     ui.tvSymbols->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
 }
 
-void PDBExplorer::RemoveSymbolsFromList(SymbolType symbolType)
+void PDBExplorer::DisplayStatusMessage(const QString& message)
 {
-    QStandardItemModel* standardItemModel = static_cast<QStandardItemModel*>(symbolsViewProxyModel->sourceModel());
-    int rowsCount = standardItemModel->rowCount();
-
-    for (int i = rowsCount - 1; i >= 0; i--)
-    {
-        QStandardItem* itemID = standardItemModel->item(i);
-        SymbolType type = static_cast<SymbolType>(itemID->data(Qt::UserRole).toUInt());
-
-        if (type == symbolType)
-        {
-            standardItemModel->removeRow(i);
-        }
-    }
-
-    //symbolsViewProxyModel->setSourceModel(standardItemModel);
+    ui.statusBar->showMessage(message, 3000);
 }
 
-void PDBExplorer::RemoveSymbolsFromList(const int type)
+//Generated code is usually much smaller than elements so it gets quarter of budget
+void PDBExplorer::SetCacheMemoryBudget()
 {
-    QStandardItemModel* standardItemModel = static_cast<QStandardItemModel*>(symbolsViewProxyModel->sourceModel());
-    int rowsCount = standardItemModel->rowCount();
-
-    for (int i = rowsCount - 1; i >= 0; i--)
-    {
-        QStandardItem* itemID = standardItemModel->item(i);
-        const int type2 = static_cast<quint32>(itemID->data(Qt::UserRole).toUInt());
+    qint64 memoryBudget = static_cast<qint64>(options.elementCacheSize) * 1024 * 1024;
 
-        if (type == type2)
-        {
-            standardItemModel->removeRow(i);
-        }
-    }
+    pdb->SetElementCacheMemoryBudget(memoryBudget);
+    headerCodeCache.setMaxCost(static_cast<int>(qMin<qint64>(memoryBudget / 4, INT_MAX)));
 }
 
-void PDBExplorer::DisplayStatusMessage(const QString& message)
+void PDBExplorer::DisplayCacheStatistics()
 {
-    ui.statusBar->showMessage(message, 3000);
+    ElementCacheStatistics statistics = pdb->GetElementCacheStatistics();
+
+    NameArenaStatistics nameArenaStatistics = NameArena::GetStatistics();
+
+    lblCacheStatistics->setText(QString("Cache: %1 elements, %2/%3 MB, hits: %4, misses: %5, evictions: %6, names: %7 (%8x dedup)")
+        .arg(statistics.count)
+        .arg(statistics.memoryUsage / (1024.0 * 1024.0), 0, 'f', 1)
+        .arg(statistics.memoryBudget / (1024 * 1024))
+        .arg(statistics.hits)
+        .arg(statistics.misses)
+        .arg(statistics.evictions)
+        .arg(nameArenaStatistics.count)
+        .arg(nameArenaStatistics.dedupRatio, 0, 'f', 1));
 }
 
 void PDBExplorer::dragEnterEvent(QDragEnterEvent* event)
@@ -1738,6 +1231,17 @@ void PDBExplorer::DisplayHeaderCode()
         return;
     }
 
+    //Generated code is cached under fingerprint of options which were used to generate it
+    quint64 key = pdb->GetElementKey(symbolRecord.id, true);
+    QString* headerCode = headerCodeCache.object(key);
+
+    if (headerCode)
+    {
+        codeEditor->setText(headerCode->toStdString().c_str());
+
+        return;
+    }
+
     QString message;
     Element element = pdb->GetElement(&symbolRecord);
     bool areSizesCorrect;
@@ -1756,6 +1260,7 @@ void PDBExplorer::DisplayHeaderCode()
         QString elementInfo = pdb->GetElementInfo(&element);
 
         codeEditor->setText(elementInfo.toStdString().c_str());
+        headerCodeCache.insert(key, new QString(elementInfo), elementInfo.length() * sizeof(QChar));
     }
     else
     {
@@ -1774,7 +1279,7 @@ void PDBExplorer::DisplayCPPCode()
 
     Element element = pdb->GetElement(&symbolRecord);
     QString cppCode = pdb->GenerateCPPCode(&element);
-    QString name = element.udt.name;
+    QString name = element.udt->name;
 
     if (name.contains("<"))
     {
@@ -1797,14 +1302,6 @@ void PDBExplorer::DisplayCPPCode()
 
 void PDBExplorer::DisplayVariableInfo()
 {
-    int count = variables.count();
-
-    if (count == 0)
-    {
-        PDBProcessDialog pdbProcessDialog(this, pdb, ProcessType::importVariables);
-        pdbProcessDialog.exec();
-    }
-
     SymbolRecord symbolRecord = GetSelectedSymbolRecord();
 
     if (symbolRecord.typeName.length() == 0)
@@ -1819,29 +1316,29 @@ void PDBExplorer::DisplayVariableInfo()
     if (pdb->GetSymbolByID(variables[symbolRecord.typeName], &symbol))
     {
         Element element = pdb->GetElement(symbol);
-        QString type = pdb->DataTypeToString(const_cast<Data*>(&element.data), &dataOptions);
+        QString type = pdb->DataTypeToString(&*element.data, &dataOptions);
 
-        DWORD relativeVirtualAddress = element.data.relativeVirtualAddress;
+        DWORD relativeVirtualAddress = element.data->relativeVirtualAddress;
         DWORD fileOffset = peHeaderParser->ConvertRVAToFileOffset(relativeVirtualAddress);
 
         QString relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
         QString fileOffset2 = QString::number(fileOffset, 16).toUpper();
         QString size = QString::number(element.size, 16).toUpper();
         QString bitOffset = QString::number(element.bitOffset, 16).toUpper();
-        QString dataKind = pdb->convertDataKindToString(element.data.dataKind);
-        QString locationType = pdb->convertLocationTypeToString(element.data.locationType);
+        QString dataKind = pdb->convertDataKindToString(element.data->dataKind);
+        QString locationType = pdb->convertLocationTypeToString(element.data->locationType);
 
         output += QString("Type:                  %1\r\n").arg(type);
-        output += QString("Name:                  %1\r\n").arg(element.data.name);
+        output += QString("Name:                  %1\r\n").arg(element.data->name);
         output += QString("Virtual Offset:        0x%1\r\n").arg(relativeVirtualAddress2);
         output += QString("File Offset:           0x%1\r\n").arg(fileOffset2);
         output += QString("Size:                  0x%1\r\n").arg(size);
         output += QString("Bit offset:            0x%1\r\n").arg(bitOffset);
         output += QString("Number of bits:        %1\r\n").arg(element.numberOfBits);
-        output += QString("Is compiler generated: %1\r\n").arg(ConvertBOOLToString(element.data.isCompilerGenerated));
+        output += QString("Is compiler generated: %1\r\n").arg(ConvertBOOLToString(element.data->isCompilerGenerated));
         output += QString("Data kind:             %1\r\n").arg(dataKind);
-        output += QString("Parent class name:     %1\r\n").arg(element.data.parentClassName);
-        output += QString("Parent type:           %1\r\n").arg(element.data.parentType);
+        output += QString("Parent class name:     %1\r\n").arg(element.data->parentClassName);
+        output += QString("Parent type:           %1\r\n").arg(element.data->parentType);
         output += QString("Location type:         %1\r\n").arg(locationType);
 
         plainTextEdit->setPlainText(output);
@@ -1854,14 +1351,6 @@ void PDBExplorer::DisplayVariableInfo()
 
 void PDBExplorer::DisplayFunctionInfo()
 {
-    int count = functions.count();
-
-    if (count == 0)
-    {
-        PDBProcessDialog pdbProcessDialog(this, pdb, ProcessType::importFunctions);
-        pdbProcessDialog.exec();
-    }
-
     SymbolRecord symbolRecord = GetSelectedSymbolRecord();
 
     if (symbolRecord.typeName.length() == 0)
@@ -1877,35 +1366,35 @@ void PDBExplorer::DisplayFunctionInfo()
         Element element = pdb->GetElement(symbol);
         Element element2 = {};
 
-        if (!element.function.returnType1.isPointer &&
-            !element.function.returnType1.isReference)
+        if (!element.function->returnType1.isPointer &&
+            !element.function->returnType1.isReference)
         {
             IDiaSymbol* symbol2;
-            DWORD id = diaSymbols.value(element.function.returnType1.originalTypeName);
+            DWORD id = diaSymbols.value(element.function->returnType1.originalTypeName);
 
             if (pdb->GetSymbolByID(id, &symbol2))
             {
-                element.function.isRVOApplied = pdb->CheckIfRVOIsAppliedToFunction(symbol2);
+                element.function.Edit()->isRVOApplied = pdb->CheckIfRVOIsAppliedToFunction(symbol2);
             }
         }
 
         static const FunctionOptions functionOptions = { true, false, true, false, true };
         QString functionPrototype = pdb->FunctionTypeToString(const_cast<Element*>(&element), &functionOptions);
 
-        DWORD relativeVirtualAddress = element.function.relativeVirtualAddress;
+        DWORD relativeVirtualAddress = element.function->relativeVirtualAddress;
         DWORD fileOffset = peHeaderParser->ConvertRVAToFileOffset(relativeVirtualAddress);
 
         QString relativeVirtualAddress2 = QString::number(relativeVirtualAddress, 16).toUpper();
         QString fileOffset2 = QString::number(fileOffset, 16).toUpper();
         QString size = QString::number(element.size, 16).toUpper();
-        QString accessSpecifier = pdb->convertAccessSpecifierToString(element.function.access);
-        QString callingConvention = pdb->convertCallingConventionToString(element.function.callingConvention);
-        bool isPure = element.function.isVirtual && element.function.isPure;
+        QString accessSpecifier = pdb->convertAccessSpecifierToString(element.function->access);
+        QString callingConvention = pdb->convertCallingConventionToString(element.function->callingConvention);
+        bool isPure = element.function->isVirtual && element.function->isPure;
 
-        output += QString("Name:                          %1\r\n").arg(element.function.name);
+        output += QString("Name:                          %1\r\n").arg(element.function->name);
         output += QString("Prototype:                     %1\r\n").arg(functionPrototype);
 
-        if (element.function.isRVOApplied)
+        if (element.function->isRVOApplied)
         {
             element2 = element;
             pdb->ApplyReturnValueOptimization(&element2);
@@ -1917,56 +1406,56 @@ void PDBExplorer::DisplayFunctionInfo()
 
         output += QString("Virtual offset:                0x%1\r\n").arg(relativeVirtualAddress2);
         output += QString("File offset:                   0x%1\r\n").arg(fileOffset2);
-        output += QString("Address section:               %1\r\n").arg(element.function.addressSection);
+        output += QString("Address section:               %1\r\n").arg(element.function->addressSection);
         output += QString("Size:                          0x%1\r\n").arg(size);
-        output += QString("Parent class name:             %1\r\n").arg(element.function.parentClassName);
-        output += QString("Parent type:                   %1\r\n").arg(element.function.parentType);
+        output += QString("Parent class name:             %1\r\n").arg(element.function->parentClassName);
+        output += QString("Parent type:                   %1\r\n").arg(element.function->parentType);
         output += QString("Source file path:              %1\r\n").arg(pdb->GetSourceFilePath(symbol));
         output += QString("Access:                        %1\r\n").arg(accessSpecifier);
         output += QString("Calling convention:            %1\r\n").arg(callingConvention);
-        output += QString("Is compiler generated:         %1\r\n").arg(ConvertBOOLToString(element.function.isCompilerGenerated));
-        output += QString("Is naked:                      %1\r\n").arg(ConvertBOOLToString(element.function.isNaked));
-        output += QString("Is static:                     %1\r\n").arg(ConvertBOOLToString(element.function.isStatic));
-        output += QString("Is no inline:                  %1\r\n").arg(ConvertBOOLToString(element.function.isNoInline));
-        output += QString("Is not reached:                %1\r\n").arg(ConvertBOOLToString(element.function.isNotReached));
-        output += QString("Is no return:                  %1\r\n").arg(ConvertBOOLToString(element.function.isNoReturn));
-        output += QString("Is const:                      %1\r\n").arg(ConvertBOOLToString(element.function.isConst));
-        output += QString("Is volatile:                   %1\r\n").arg(ConvertBOOLToString(element.function.isVolatile));
-        output += QString("Is virtual:                    %1\r\n").arg(ConvertBOOLToString(element.function.isVirtual));
+        output += QString("Is compiler generated:         %1\r\n").arg(ConvertBOOLToString(element.function->isCompilerGenerated));
+        output += QString("Is naked:                      %1\r\n").arg(ConvertBOOLToString(element.function->isNaked));
+        output += QString("Is static:                     %1\r\n").arg(ConvertBOOLToString(element.function->isStatic));
+        output += QString("Is no inline:                  %1\r\n").arg(ConvertBOOLToString(element.function->isNoInline));
+        output += QString("Is not reached:                %1\r\n").arg(ConvertBOOLToString(element.function->isNotReached));
+        output += QString("Is no return:                  %1\r\n").arg(ConvertBOOLToString(element.function->isNoReturn));
+        output += QString("Is const:                      %1\r\n").arg(ConvertBOOLToString(element.function->isConst));
+        output += QString("Is volatile:                   %1\r\n").arg(ConvertBOOLToString(element.function->isVolatile));
+        output += QString("Is virtual:                    %1\r\n").arg(ConvertBOOLToString(element.function->isVirtual));
         output += QString("Is pure:                       %1\r\n").arg(ConvertBOOLToString(isPure));
-        output += QString("Is overriden:                  %1\r\n").arg(ConvertBOOLToString(element.function.isOverridden));
-        output += QString("Is constructor:                %1\r\n").arg(ConvertBOOLToString(element.function.isConstructor));
-        output += QString("Is default constructor:        %1\r\n").arg(ConvertBOOLToString(element.function.isDefaultConstructor));
-        output += QString("Is destructor:                 %1\r\n").arg(ConvertBOOLToString(element.function.isDestructor));
-        output += QString("Is copy constructor:           %1\r\n").arg(ConvertBOOLToString(element.function.isCopyConstructor));
-        output += QString("Is copy assignment operator:   %1\r\n").arg(ConvertBOOLToString(element.function.isCopyAssignmentOperator));
-        output += QString("Is cast operator:              %1\r\n").arg(ConvertBOOLToString(element.function.isCastOperator));
-        output += QString("Is variadic:                   %1\r\n").arg(ConvertBOOLToString(element.function.isVariadic));
-        output += QString("Is non implemented:            %1\r\n").arg(ConvertBOOLToString(element.function.isNonImplemented));
-        output += QString("Is RVO applied:                %1\r\n").arg(ConvertBOOLToString(element.function.isRVOApplied));
-        output += QString("Is Intro Virtual:              %1\r\n").arg(ConvertBOOLToString(element.function.isIntroVirtual));
-        output += QString("Has alloca:                    %1\r\n").arg(ConvertBOOLToString(element.function.hasAlloca));
-        output += QString("Has EH:                        %1\r\n").arg(ConvertBOOLToString(element.function.hasEH));
-        output += QString("Has EHa:                       %1\r\n").arg(ConvertBOOLToString(element.function.hasEHa));
-        output += QString("Has inl asm:                   %1\r\n").arg(ConvertBOOLToString(element.function.hasInlAsm));
-        output += QString("Has long jump:                 %1\r\n").arg(ConvertBOOLToString(element.function.hasLongJump));
-        output += QString("Has security checks:           %1\r\n").arg(ConvertBOOLToString(element.function.hasSecurityChecks));
-        output += QString("Has SEH:                       %1\r\n").arg(ConvertBOOLToString(element.function.hasSEH));
-        output += QString("Has set jump:                  %1\r\n").arg(ConvertBOOLToString(element.function.hasSetJump));
-        output += QString("Has inl spec:                  %1\r\n").arg(ConvertBOOLToString(element.function.hasInlSpec));
-        output += QString("Has optimized code debug info: %1\r\n").arg(ConvertBOOLToString(element.function.hasOptimizedCodeDebugInfo));
-        output += QString("Far return:                    %1\r\n").arg(ConvertBOOLToString(element.function.farReturn));
-        output += QString("Interrupt return:              %1\r\n").arg(ConvertBOOLToString(element.function.interruptReturn));
-        output += QString("No stack ordering:             %1\r\n").arg(ConvertBOOLToString(element.function.noStackOrdering));
-
-        if (element.function.parentClassName.length() > 0 && element.function.isVirtual)
+        output += QString("Is overriden:                  %1\r\n").arg(ConvertBOOLToString(element.function->isOverridden));
+        output += QString("Is constructor:                %1\r\n").arg(ConvertBOOLToString(element.function->isConstructor));
+        output += QString("Is default constructor:        %1\r\n").arg(ConvertBOOLToString(element.function->isDefaultConstructor));
+        output += QString("Is destructor:                 %1\r\n").arg(ConvertBOOLToString(element.function->isDestructor));
+        output += QString("Is copy constructor:           %1\r\n").arg(ConvertBOOLToString(element.function->isCopyConstructor));
+        output += QString("Is copy assignment operator:   %1\r\n").arg(ConvertBOOLToString(element.function->isCopyAssignmentOperator));
+        output += QString("Is cast operator:              %1\r\n").arg(ConvertBOOLToString(element.function->isCastOperator));
+        output += QString("Is variadic:                   %1\r\n").arg(ConvertBOOLToString(element.function->isVariadic));
+        output += QString("Is non implemented:            %1\r\n").arg(ConvertBOOLToString(element.function->isNonImplemented));
+        output += QString("Is RVO applied:                %1\r\n").arg(ConvertBOOLToString(element.function->isRVOApplied));
+        output += QString("Is Intro Virtual:              %1\r\n").arg(ConvertBOOLToString(element.function->isIntroVirtual));
+        output += QString("Has alloca:                    %1\r\n").arg(ConvertBOOLToString(element.function->hasAlloca));
+        output += QString("Has EH:                        %1\r\n").arg(ConvertBOOLToString(element.function->hasEH));
+        output += QString("Has EHa:                       %1\r\n").arg(ConvertBOOLToString(element.function->hasEHa));
+        output += QString("Has inl asm:                   %1\r\n").arg(ConvertBOOLToString(element.function->hasInlAsm));
+        output += QString("Has long jump:                 %1\r\n").arg(ConvertBOOLToString(element.function->hasLongJump));
+        output += QString("Has security checks:           %1\r\n").arg(ConvertBOOLToString(element.function->hasSecurityChecks));
+        output += QString("Has SEH:                       %1\r\n").arg(ConvertBOOLToString(element.function->hasSEH));
+        output += QString("Has set jump:                  %1\r\n").arg(ConvertBOOLToString(element.function->hasSetJump));
+        output += QString("Has inl spec:                  %1\r\n").arg(ConvertBOOLToString(element.function->hasInlSpec));
+        output += QString("Has optimized code debug info: %1\r\n").arg(ConvertBOOLToString(element.function->hasOptimizedCodeDebugInfo));
+        output += QString("Far return:                    %1\r\n").arg(ConvertBOOLToString(element.function->farReturn));
+        output += QString("Interrupt return:              %1\r\n").arg(ConvertBOOLToString(element.function->interruptReturn));
+        output += QString("No stack ordering:             %1\r\n").arg(ConvertBOOLToString(element.function->noStackOrdering));
+
+        if (element.function->parentClassName.length() > 0 && element.function->isVirtual)
         {
             SymbolRecord symbolRecord;
 
-            symbolRecord.id = diaSymbols[element.function.originalParentClassName];
-            symbolRecord.typeName = element.function.parentClassName;
+            symbolRecord.id = diaSymbols[element.function->originalParentClassName];
+            symbolRecord.typeName = element.function->parentClassName;
 
-            if (element.function.parentType == "class")
+            if (element.function->parentType == "class")
             {
                 symbolRecord.type = SymbolType::classType;
             }
@@ -1980,12 +1469,12 @@ void PDBExplorer::DisplayFunctionInfo()
 
             for (int i = 0; i < virtualFunctionChildrenCount; i++)
             {
-                if (element2.virtualFunctionChildren.at(i).function.prototype == functionPrototype)
+                if (element2.virtualFunctionChildren.at(i).function->prototype == functionPrototype)
                 {
-                    int virtualBaseOffset = element2.virtualFunctionChildren.at(i).function.virtualBaseOffset;
-                    int vTableIndex = element2.virtualFunctionChildren.at(i).function.virtualBaseOffset >> 2;
-                    int indexOfVTable = element2.virtualFunctionChildren.at(i).function.indexOfVTable;
-                    QString vTableName = element2.udt.vTableNames[indexOfVTable];
+                    int virtualBaseOffset = element2.virtualFunctionChildren.at(i).function->virtualBaseOffset;
+                    int vTableIndex = element2.virtualFunctionChildren.at(i).function->virtualBaseOffset >> 2;
+                    int indexOfVTable = element2.virtualFunctionChildren.at(i).function->indexOfVTable;
+                    QString vTableName = element2.udt->vTableNames[indexOfVTable];
 
                     output += QString("Virtual base offset:           %1\r\n").arg(virtualBaseOffset);
                     output += QString("VTable index:                  %1\r\n").arg(vTableIndex);
@@ -1995,18 +1484,18 @@ void PDBExplorer::DisplayFunctionInfo()
         }
 
         static const DataOptions dataOptions = { true };
-        QList<QString> functionParameters = element.function.parameters;
+        QList<QString> functionParameters = element.function->parameters;
         QList<QString> functionParameterNames;
 
-        /*if (element.function.isRVOApplied)
+        /*if (element.function->isRVOApplied)
         {
-            functionParameters.prepend(element2.function.parameters.at(0));
+            functionParameters.prepend(element2.function->parameters.at(0));
         }*/
 
         if (element.dataChildren.count() > 0 &&
-            element.dataChildren.at(0).data.dataKind == DataIsObjectPtr)
+            element.dataChildren.at(0).data->dataKind == DataIsObjectPtr)
         {
-            functionParameters.prepend(pdb->DataTypeToString(&element.dataChildren.at(0).data, &dataOptions));
+            functionParameters.prepend(pdb->DataTypeToString(&*element.dataChildren.at(0).data, &dataOptions));
         }
 
         int n = 0;
@@ -2030,11 +1519,11 @@ void PDBExplorer::DisplayFunctionInfo()
                 {
                     if (n < parameterNamesCount)
                     {
-                        parameterName = element.dataChildren.at(n).data.name;
-                        isCompilerGenerated = element.dataChildren.at(n).data.isCompilerGenerated;
-                        offset = QString::number(element.dataChildren.at(n).data.offset, 16).toUpper();
-                        dataKind = pdb->convertDataKindToString(element.dataChildren.at(n).data.dataKind);
-                        location = element.dataChildren.at(n).data.location;
+                        parameterName = element.dataChildren.at(n).data->name;
+                        isCompilerGenerated = element.dataChildren.at(n).data->isCompilerGenerated;
+                        offset = QString::number(element.dataChildren.at(n).data->offset, 16).toUpper();
+                        dataKind = pdb->convertDataKindToString(element.dataChildren.at(n).data->dataKind);
+                        location = element.dataChildren.at(n).data->location;
 
                         n++;
                     }
@@ -2077,12 +1566,12 @@ void PDBExplorer::DisplayFunctionInfo()
 
             for (int i = 0; i < localVariablesCount; i++)
             {
-                QString variableType = pdb->DataTypeToString(&element.localVariables.at(i).data, &dataOptions);
-                QString variableName = element.localVariables.at(i).data.name;
-                BOOL isCompilerGenerated = element.localVariables.at(i).data.isCompilerGenerated;
-                QString offset = QString::number(element.localVariables.at(i).data.offset, 16).toUpper();
-                QString dataKind = pdb->convertDataKindToString(element.localVariables.at(i).data.dataKind);
-                QString location = element.localVariables.at(i).data.location;
+                QString variableType = pdb->DataTypeToString(&*element.localVariables.at(i).data, &dataOptions);
+                QString variableName = element.localVariables.at(i).data->name;
+                BOOL isCompilerGenerated = element.localVariables.at(i).data->isCompilerGenerated;
+                QString offset = QString::number(element.localVariables.at(i).data->offset, 16).toUpper();
+                QString dataKind = pdb->convertDataKindToString(element.localVariables.at(i).data->dataKind);
+                QString location = element.localVariables.at(i).data->location;
 
                 output += QString("\tType:                     %1\r\n").arg(variableType);
                 output += QString("\tName:                     %1\r\n").arg(variableName);
@@ -2108,14 +1597,6 @@ void PDBExplorer::DisplayFunctionInfo()
 
 void PDBExplorer::DisplayPublicSymbolInfo()
 {
-    int count = publicSymbols.count();
-
-    if (count == 0)
-    {
-        PDBProcessDialog pdbProcessDialog(this, pdb, ProcessType::importPublicSymbols);
-        pdbProcessDialog.exec();
-    }
-
     SymbolRecord symbolRecord = GetSelectedSymbolRecord();
 
     if (symbolRecord.typeName.length() == 0)
@@ -2198,39 +1679,39 @@ void PDBExplorer::DisplayStructureView()
     {
         if (element.children.at(i).elementType == ElementType::baseClassType)
         {
-            type = element.children.at(i).baseClass.name;
+            type = element.children.at(i).baseClass->name;
             name = QString("baseClass_%1").arg(i);
 
-            AddItemToModel(name, type, baseClassOffset, element.children.at(i).baseClass.length, model, row++);
+            AddItemToModel(name, type, baseClassOffset, element.children.at(i).baseClass->length, model, row++);
 
-            baseClassOffset += element.children.at(i).baseClass.length;
+            baseClassOffset += element.children.at(i).baseClass->length;
         }
         else if (element.children.at(i).elementType == ElementType::dataType &&
-            element.children.at(i).data.dataKind != DataIsStaticMember)
+            element.children.at(i).data->dataKind != DataIsStaticMember)
         {
-            if (element.children.at(i).data.isFunctionPointer)
+            if (element.children.at(i).data->isFunctionPointer)
             {
-                type = element.children.at(i).data.functionReturnType;
+                type = element.children.at(i).data->functionReturnType;
             }
             else
             {
-                type = element.children.at(i).data.typeName;
+                type = element.children.at(i).data->typeName;
             }
 
-            if (element.children.at(i).data.isPointer)
+            if (element.children.at(i).data->isPointer)
             {
-                for (int j = 0; j < element.children.at(i).data.pointerLevel; j++)
+                for (int j = 0; j < element.children.at(i).data->pointerLevel; j++)
                 {
                     type += "*";
                 }
             }
 
-            if (element.children.at(i).data.isReference)
+            if (element.children.at(i).data->isReference)
             {
                 type += "&";
             }
 
-            name = element.children.at(i).data.name;
+            name = element.children.at(i).data->name;
 
             DWORD size = element.children.at(i).size;
 
@@ -2270,15 +1751,15 @@ void PDBExplorer::DisplayStructureView()
             }
         }
         else if (element.children.at(i).elementType == ElementType::dataType &&
-            element.children.at(i).data.isPadding)
+            element.children.at(i).data->isPadding)
         {
             if (element.children.at(i).offset == 0)
             {
                 continue;
             }
 
-            type = element.children.at(i).data.typeName;
-            name = element.children.at(i).data.name;
+            type = element.children.at(i).data->typeName;
+            name = element.children.at(i).data->name;
 
             AddItemToModel(name, type, element.children.at(i).offset, element.children.at(i).size, model, row++);
         }
@@ -2327,7 +1808,7 @@ void PDBExplorer::DisplayFunctionOffsets()
 
     int row = 0;
 
-    AddFunctionsToModel(&element, model, &row, element.udt.name);
+    AddFunctionsToModel(&element, model, &row, element.udt->name);
 
     model->removeRows(row, count - row);
     proxyModel->setSourceModel(model);
@@ -2350,7 +1831,7 @@ void PDBExplorer::AddFunctionsToModel(const Element* element, QStandardItemModel
 
     for (int i = 0; i < udtChildrenCount; i++)
     {
-        AddFunctionsToModel(&element->udtChildren.at(i), model, row, QString("::%1").arg(element->udtChildren.at(i).udt.name));
+        AddFunctionsToModel(&element->udtChildren.at(i), model, row, QString("::%1").arg(element->udtChildren.at(i).udt->name));
     }
 
     for (int i = 0; i < functionChildrenCount; i++)
@@ -2359,7 +1840,7 @@ void PDBExplorer::AddFunctionsToModel(const Element* element, QStandardItemModel
         static const FunctionOptions functionOptions = { true, false, false, false };
         QString name = pdb->FunctionTypeToString(const_cast<Element*>(&element2), &functionOptions);
 
-        DWORD relativeVirtualAddress = children.at(i).function.relativeVirtualAddress;
+        DWORD relativeVirtualAddress = children.at(i).function->relativeVirtualAddress;
 
         if (relativeVirtualAddress == 0)
         {
@@ -2379,9 +1860,9 @@ void PDBExplorer::GetVTables(const Element* element, QStringList* vTables)
     QMap<int, QString>::const_iterator it;
     int i = 0;
 
-    for (it = element->udt.vTableNames.begin(); it != element->udt.vTableNames.end(); it++)
+    for (it = element->udt->vTableNames.begin(); it != element->udt->vTableNames.end(); it++)
     {
-        QHash<QString, int> vTable = pdb->GetVTable(element->udt.vTableNames.value(it.key()));
+        QHash<QString, int> vTable = pdb->GetVTable(element->udt->vTableNames.value(it.key()));
         QString vTable2 = QString("VTable %1 (%2 - %3)").arg(i++).arg(it.value()).arg(vTable.count());
 
         vTables->append(vTable2);
@@ -2400,11 +1881,11 @@ void PDBExplorer::DisplayVTables()
 
     element = pdb->GetElement(&symbolRecord, true);
 
-    if (element.udt.numOfVTables > 0)
+    if (element.udt->numOfVTables > 0)
     {
-        if (!element.udt.hasBaseClass)
+        if (!element.udt->hasBaseClass)
         {
-            QString vTable = QString("VTable 1 (%1)").arg(element.udt.countOfVirtualFunctions);
+            QString vTable = QString("VTable 1 (%1)").arg(element.udt->countOfVirtualFunctions);
 
             vTables.append(vTable);
         }
@@ -2433,11 +1914,11 @@ void PDBExplorer::DisplayVTable(int vTableNum)
     int row = 0;
     QMap<int, QString> virtualFunctions;
 
-    if (element.udt.hasBaseClass)
+    if (element.udt->hasBaseClass)
     {
         QHash<QString, int>::const_iterator it;
-        QHash<QString, int> vTable = pdb->GetVTable(element.udt.vTableNames.value(vTableNum));
-        QHash<QString, QString> vTableFunctions = pdb->getFunctionPrototypes(element.udt.vTableNames.value(vTableNum));
+        QHash<QString, int> vTable = pdb->GetVTable(element.udt->vTableNames.value(vTableNum));
+        QHash<QString, QString> vTableFunctions = pdb->getFunctionPrototypes(element.udt->vTableNames.value(vTableNum));
 
         for (it = vTable.begin(); it != vTable.end(); it++)
         {
@@ -2461,9 +1942,9 @@ void PDBExplorer::DisplayVTable(int vTableNum)
         for (int i = 0; i < count; i++)
         {
             if (element.virtualFunctionChildren.at(i).elementType == ElementType::functionType &&
-                element.virtualFunctionChildren.at(i).function.isVirtual)
+                element.virtualFunctionChildren.at(i).function->isVirtual)
             {
-                int offset = element.virtualFunctionChildren.at(i).function.virtualBaseOffset;
+                int offset = element.virtualFunctionChildren.at(i).function->virtualBaseOffset;
                 static const FunctionOptions functionOptions = { true, false, true, false };
                 QString functionPrototype = pdb->FunctionTypeToString(const_cast<Element*>(&element.virtualFunctionChildren.at(i)),
                     &functionOptions);
@@ -2540,31 +2021,31 @@ void PDBExplorer::DisplayUDTLayout()
     for (int i = 0; i < count; i++)
     {
         if (newElement.children.at(i).elementType == ElementType::dataType &&
-            newElement.children.at(i).data.dataKind != DataIsStaticMember)
+            newElement.children.at(i).data->dataKind != DataIsStaticMember)
         {
-            if (newElement.children.at(i).data.isFunctionPointer)
+            if (newElement.children.at(i).data->isFunctionPointer)
             {
-                type = newElement.children.at(i).data.functionReturnType;
+                type = newElement.children.at(i).data->functionReturnType;
             }
             else
             {
-                type = newElement.children.at(i).data.typeName;
+                type = newElement.children.at(i).data->typeName;
             }
 
-            if (newElement.children.at(i).data.isPointer)
+            if (newElement.children.at(i).data->isPointer)
             {
-                for (int j = 0; j < newElement.children.at(i).data.pointerLevel; j++)
+                for (int j = 0; j < newElement.children.at(i).data->pointerLevel; j++)
                 {
                     type += "*";
                 }
             }
 
-            if (newElement.children.at(i).data.isReference)
+            if (newElement.children.at(i).data->isReference)
             {
                 type += "&";
             }
 
-            name = newElement.children.at(i).data.name;
+            name = newElement.children.at(i).data->name;
 
             DWORD size = newElement.children.at(i).size;
             AddItemToModel(name, type, newElement.children.at(i).offset, size, model, row++);
@@ -2741,13 +2222,11 @@ void PDBExplorer::TxtMangledNameTextChanged(const QString& text)
 
     if (options.useUndname)
     {
-        demangledName = QString::fromStdString(peHeaderParser->UndecorateName(mangledName.c_str()));
+        demangledName = QString::fromStdString(peHeaderParser->UndecorateName(mangledName.c_str(), false));
     }
     else
     {
-        std::string rest;
-
-        demangledName = QString::fromStdString(msvcDemangler.DemangleSymbol(mangledName, rest));
+        demangledName = QString::fromStdString(SymbolDemangler::Demangle(mangledName, false));
     }
 
     txtDemangledName->setText(demangledName);
@@ -2760,13 +2239,11 @@ void PDBExplorer::TxtMangledName2TextChanged(const QString& text)
 
     if (options.useUndname)
     {
-        demangledName = QString::fromStdString(peHeaderParser->UndecorateName(mangledName.c_str()));
+        demangledName = QString::fromStdString(peHeaderParser->UndecorateName(mangledName.c_str(), false));
     }
     else
     {
-        std::string rest;
-
-        demangledName = QString::fromStdString(msvcDemangler.DemangleSymbol(mangledName, rest));
+        demangledName = QString::fromStdString(SymbolDemangler::Demangle(mangledName, false));
     }
 
     txtDemangledName2->setText(demangledName);
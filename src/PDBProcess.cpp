@@ -24,17 +24,8 @@ void PDBProcess::Process()
 {
 	switch (processType)
 	{
-	case ProcessType::importUDTsAndEnums:
-		pdb->LoadPDBData();
-		break;
-	case ProcessType::importVariables:
-		pdb->GetVariables();
-		break;
-	case ProcessType::importFunctions:
-		pdb->GetFunctions();
-		break;
-	case ProcessType::importPublicSymbols:
-		pdb->GetPublicSymbols();
+	case ProcessType::importSymbols:
+		pdb->ImportSymbols();
 		break;
 	case ProcessType::exportUDTsAndEnumsWithDependencies:
 		pdb->ExportSymbolWithDependencies(symbolRecord);
@@ -4,7 +4,7 @@ PDBProcessDialog::PDBProcessDialog(QWidget* parent, PDB* pdb, ProcessType proces
 {
 	ui.setupUi(this);
 
-	if (processType == ProcessType::exportUDTsAndEnums)
+	if (processType == ProcessType::importSymbols)
 	{
 		setWindowTitle("Import");
 	}
@@ -339,18 +339,37 @@ bool PEHeaderParser::ReadExportTable(QHash<QString, QString>& exports)
 	return true;
 }
 
-std::string PEHeaderParser::UndecorateName(const char* decoratedName)
+std::string PEHeaderParser::UndecorateName(const char* decoratedName, bool useCache)
 {
-	char* undecoratedName = new char[1024];
+	std::string name = decoratedName;
+	std::string result;
 
-	__unDName(undecoratedName, decoratedName, 1024, malloc, free, UNDNAME_NAME_ONLY);
+	//Cached names are returned without waiting for threads which are in __unDName
+	if (useCache && SymbolDemangler::FindUndecoratedName(name, result))
+	{
+		return result;
+	}
+
+	//__unDName isn't thread safe and symbols are demangled by export threads
+	static QMutex mutex;
+	QMutexLocker locker(&mutex);
+	char undecoratedName[1024];
+
+	__unDName(undecoratedName, decoratedName, sizeof(undecoratedName), malloc, free, UNDNAME_NAME_ONLY);
+
+	if (strcmp(decoratedName, undecoratedName) != 0)
+	{
+		result = undecoratedName;
+	}
+
+	locker.unlock();
 
-	if (strcmp(decoratedName, undecoratedName) == 0)
+	if (useCache)
 	{
-		return "";
+		SymbolDemangler::AddUndecoratedName(name, result);
 	}
 
-	return undecoratedName;
+	return result;
 }
 
 CV_CPU_TYPE_e PEHeaderParser::GetMachineType()
@@ -0,0 +1,52 @@
+#include "ResolutionContext.h"
+
+static thread_local ResolutionContext* currentContext = nullptr;
+
+ResolutionContext::ResolutionContext(const Options* options)
+{
+	this->options = options;
+
+	isMainUDT = false;
+	belongsToMainUDT = false;
+	vTableIndex = 0;
+	destructorAdded = false;
+	hasVirtualDestructor = false;
+	includesHidden = false;
+	includesWereHidden = false;
+	keepScopeResolutionOperator = false;
+	resolutionDepth = 0;
+}
+
+bool ResolutionContext::DisplayIncludes() const
+{
+	return options->displayIncludes && !includesHidden;
+}
+
+bool ResolutionContext::RemoveScopeResolutionOperator() const
+{
+	return options->removeScopeResolutionOperator && !keepScopeResolutionOperator;
+}
+
+ResolutionContext* ResolutionContext::GetCurrent()
+{
+	return currentContext;
+}
+
+ResolutionContext* ResolutionContext::SetCurrent(ResolutionContext* context)
+{
+	ResolutionContext* previousContext = currentContext;
+
+	currentContext = context;
+
+	return previousContext;
+}
+
+ResolutionContextScope::ResolutionContextScope(ResolutionContext* context)
+{
+	previousContext = ResolutionContext::SetCurrent(context);
+}
+
+ResolutionContextScope::~ResolutionContextScope()
+{
+	ResolutionContext::SetCurrent(previousContext);
+}
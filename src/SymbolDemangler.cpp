@@ -0,0 +1,192 @@
+#include <exception>
+#include <QThreadPool>
+#include "SymbolDemangler.h"
+#include "NameArena.h"
+
+//Names which are typed in UI are demangled once so they aren't added to cache
+std::string SymbolDemangler::Demangle(const std::string& mangledName, bool useCache)
+{
+	MSVCDemangler msvcDemangler;
+
+	if (!useCache)
+	{
+		return DemangleName(msvcDemangler, mangledName);
+	}
+
+	return Demangle(msvcDemangler, mangledName);
+}
+
+/*
+* Demangles names on all cores and returns IDs of demangled names in NameArena, result has same order as input.
+* Every task uses its own demangler. Names aren't added to cache because every public symbol is demangled
+* only once during import and its name is already kept by NameArena.
+*/
+std::vector<quint32> SymbolDemangler::DemangleToNameIDs(std::span<const std::string> mangledNames)
+{
+	std::size_t count = mangledNames.size();
+	std::vector<quint32> result(count);
+
+	auto demangleNames = [mangledNames, &result](std::size_t begin, std::size_t end)
+	{
+		MSVCDemangler msvcDemangler;
+
+		for (std::size_t i = begin; i < end; i++)
+		{
+			result[i] = NameArena::Intern(QString::fromStdString(DemangleName(msvcDemangler, mangledNames[i])));
+		}
+	};
+
+	if (count < static_cast<std::size_t>(batchChunkSize))
+	{
+		demangleNames(0, count);
+
+		return result;
+	}
+
+	QThreadPool threadPool;
+
+	for (std::size_t begin = 0; begin < count; begin += batchChunkSize)
+	{
+		std::size_t end = qMin(begin + batchChunkSize, count);
+
+		threadPool.start([&demangleNames, begin, end]()
+		{
+			demangleNames(begin, end);
+		});
+	}
+
+	threadPool.waitForDone();
+
+	return result;
+}
+
+/*
+* Returns only qualified name like __unDName with UNDNAME_NAME_ONLY does, it's used for names of types and members
+* which DIA SDK didn't undecorate. Names are taken from scopes of demangled symbol so demangled name isn't parsed.
+*/
+std::string SymbolDemangler::DemangleQualifiedName(const std::string& mangledName)
+{
+	MSVCDemangler msvcDemangler;
+	DemangledSymbol demangledSymbol;
+	std::string rest;
+
+	try
+	{
+		msvcDemangler.DemangleSymbol(mangledName, rest, demangledSymbol);
+	}
+	catch (const std::exception&)
+	{
+		return mangledName;
+	}
+
+	if (demangledSymbol.GetScopeCount() == 0)
+	{
+		return std::string(demangledSymbol.GetUndecoratedName());
+	}
+
+	return demangledSymbol.GetQualifiedName();
+}
+
+bool SymbolDemangler::FindUndecoratedName(const std::string& decoratedName, std::string& undecoratedName)
+{
+	SymbolDemangler& symbolDemangler = GetInstance();
+
+	return FindName(GetShard(symbolDemangler.undecoratedNames, decoratedName), decoratedName, undecoratedName);
+}
+
+void SymbolDemangler::AddUndecoratedName(const std::string& decoratedName, const std::string& undecoratedName)
+{
+	SymbolDemangler& symbolDemangler = GetInstance();
+
+	AddName(GetShard(symbolDemangler.undecoratedNames, decoratedName), decoratedName, undecoratedName);
+}
+
+void SymbolDemangler::Clear()
+{
+	SymbolDemangler& symbolDemangler = GetInstance();
+
+	for (int i = 0; i < shardCount; i++)
+	{
+		Shard* shards[] = { &symbolDemangler.demangledNames[i], &symbolDemangler.undecoratedNames[i] };
+
+		for (Shard* shard : shards)
+		{
+			QWriteLocker locker(&shard->lock);
+
+			shard->names.clear();
+		}
+	}
+}
+
+SymbolDemangler& SymbolDemangler::GetInstance()
+{
+	static SymbolDemangler symbolDemangler;
+
+	return symbolDemangler;
+}
+
+SymbolDemangler::Shard& SymbolDemangler::GetShard(Shard* shards, const std::string& mangledName)
+{
+	std::size_t hash = std::hash<std::string>()(mangledName);
+
+	//Low bits are used by buckets of map in shard so shard is selected with high bits
+	return shards[hash >> (sizeof(std::size_t) * 8 - shardBits)];
+}
+
+bool SymbolDemangler::FindName(Shard& shard, const std::string& mangledName, std::string& name)
+{
+	QReadLocker locker(&shard.lock);
+	auto it = shard.names.find(mangledName);
+
+	if (it == shard.names.end())
+	{
+		return false;
+	}
+
+	name = it->second;
+
+	return true;
+}
+
+void SymbolDemangler::AddName(Shard& shard, const std::string& mangledName, const std::string& name)
+{
+	QWriteLocker locker(&shard.lock);
+
+	shard.names.emplace(mangledName, name);
+}
+
+//Name is demangled outside of lock so other threads can use same shard in the meantime
+std::string SymbolDemangler::Demangle(MSVCDemangler& msvcDemangler, const std::string& mangledName)
+{
+	Shard& shard = GetShard(GetInstance().demangledNames, mangledName);
+	std::string demangledName;
+
+	if (FindName(shard, mangledName, demangledName))
+	{
+		return demangledName;
+	}
+
+	demangledName = DemangleName(msvcDemangler, mangledName);
+
+	AddName(shard, mangledName, demangledName);
+
+	return demangledName;
+}
+
+/*
+* Exception which escapes from task of QThreadPool terminates application so name is returned as it is
+* if demangler fails for reason which it doesn't handle itself, for example if it runs out of memory
+*/
+std::string SymbolDemangler::DemangleName(MSVCDemangler& msvcDemangler, const std::string& mangledName)
+{
+	try
+	{
+		std::string rest;
+
+		return msvcDemangler.DemangleSymbol(mangledName, rest);
+	}
+	catch (const std::exception&)
+	{
+		return mangledName;
+	}
+}
@@ -0,0 +1,320 @@
+#include "SymbolIndex.h"
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFileInfo>
+
+static const char symbolIndexMagic[8] = { 'P', 'D', 'B', 'E', 'X', 'I', 'D', 'X' };
+
+SymbolIndex::SymbolIndex()
+{
+	fileData = nullptr;
+	fileSize = 0;
+	header = nullptr;
+
+	for (int i = 0; i < static_cast<int>(SymbolIndexTable::count); i++)
+	{
+		tableEntries[i] = nullptr;
+	}
+}
+
+SymbolIndex::~SymbolIndex()
+{
+	Close();
+}
+
+/*
+* Index is used only if it was created by the same version of PDBExplorer, for PDB file
+* with the same GUID and age and with the same options which affect import of symbols
+*/
+bool SymbolIndex::Open(const QString& filePath, const PDBInfoHeader& pdbInfoHeader, quint32 importOptions)
+{
+	Close();
+
+	file.setFileName(filePath);
+
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		errorMessage = QString("Can't open file: %1").arg(file.errorString());
+
+		return false;
+	}
+
+	fileSize = file.size();
+
+	if (fileSize < static_cast<qint64>(sizeof(SymbolIndexHeader)))
+	{
+		Close();
+
+		errorMessage = "Index file is too small.";
+
+		return false;
+	}
+
+	fileData = file.map(0, fileSize);
+
+	if (!fileData)
+	{
+		QString errorString = file.errorString();
+
+		Close();
+
+		errorMessage = QString("Can't map file into memory: %1").arg(errorString);
+
+		return false;
+	}
+
+	header = reinterpret_cast<const SymbolIndexHeader*>(fileData);
+
+	QByteArray guid = pdbInfoHeader.guid.toRfc4122();
+
+	if (memcmp(header->magic, symbolIndexMagic, sizeof(symbolIndexMagic)) != 0 ||
+		header->version != version ||
+		header->headerSize != sizeof(SymbolIndexHeader))
+	{
+		Close();
+
+		errorMessage = "Index file was created by different version.";
+
+		return false;
+	}
+
+	if (memcmp(header->guid, guid.constData(), sizeof(header->guid)) != 0 ||
+		header->age != pdbInfoHeader.age ||
+		header->importOptions != importOptions)
+	{
+		Close();
+
+		errorMessage = "Index file doesn't match PDB file.";
+
+		return false;
+	}
+
+	if (!ReadTableDirectory())
+	{
+		Close();
+
+		errorMessage = "Index file is corrupted.";
+
+		return false;
+	}
+
+	return true;
+}
+
+void SymbolIndex::Close()
+{
+	if (fileData)
+	{
+		file.unmap(const_cast<uchar*>(fileData));
+	}
+
+	if (file.isOpen())
+	{
+		file.close();
+	}
+
+	fileData = nullptr;
+	fileSize = 0;
+	header = nullptr;
+
+	for (int i = 0; i < static_cast<int>(SymbolIndexTable::count); i++)
+	{
+		tableEntries[i] = nullptr;
+	}
+
+	errorMessage.clear();
+}
+
+bool SymbolIndex::IsOpen() const
+{
+	return fileData != nullptr;
+}
+
+const QString& SymbolIndex::GetErrorMessage() const
+{
+	return errorMessage;
+}
+
+bool SymbolIndex::HasTable(SymbolIndexTable table) const
+{
+	return tableEntries[static_cast<int>(table)] != nullptr;
+}
+
+int SymbolIndex::GetRecordCount(SymbolIndexTable table) const
+{
+	const SymbolIndexTableEntry* tableEntry = tableEntries[static_cast<int>(table)];
+
+	return tableEntry ? static_cast<int>(tableEntry->recordCount) : 0;
+}
+
+const SymbolIndexRecord* SymbolIndex::GetRecords(SymbolIndexTable table) const
+{
+	const SymbolIndexTableEntry* tableEntry = tableEntries[static_cast<int>(table)];
+
+	if (!tableEntry)
+	{
+		return nullptr;
+	}
+
+	return reinterpret_cast<const SymbolIndexRecord*>(fileData + tableEntry->offset);
+}
+
+QString SymbolIndex::GetName(const SymbolIndexRecord& record) const
+{
+	quint64 poolLength = header->stringPoolSize / sizeof(QChar);
+
+	if (record.nameOffset > poolLength || record.nameLength > poolLength - record.nameOffset)
+	{
+		return QString();
+	}
+
+	const QChar* stringPool = reinterpret_cast<const QChar*>(fileData + header->stringPoolOffset);
+
+	return QString(stringPool + record.nameOffset, record.nameLength);
+}
+
+/*
+* Records are written first and names are written after them in the same order,
+* so whole index doesn't have to be built in memory
+*/
+bool SymbolIndex::Write(const QString& filePath, const PDBInfoHeader& pdbInfoHeader, quint32 importOptions,
+	const QVector<SymbolIndexEntry>* tables, const bool* hasTables)
+{
+	const int tableCount = static_cast<int>(SymbolIndexTable::count);
+	QVector<SymbolIndexTableEntry> tableEntries;
+	quint64 offset = sizeof(SymbolIndexHeader);
+	quint64 stringPoolLength = 0;
+
+	for (int i = 0; i < tableCount; i++)
+	{
+		if (hasTables[i])
+		{
+			offset += sizeof(SymbolIndexTableEntry);
+		}
+	}
+
+	for (int i = 0; i < tableCount; i++)
+	{
+		if (!hasTables[i])
+		{
+			continue;
+		}
+
+		SymbolIndexTableEntry tableEntry = {};
+
+		tableEntry.table = i;
+		tableEntry.recordCount = tables[i].count();
+		tableEntry.offset = offset;
+
+		tableEntries.append(tableEntry);
+
+		offset += static_cast<quint64>(tables[i].count()) * sizeof(SymbolIndexRecord);
+	}
+
+	SymbolIndexHeader header = {};
+	QByteArray guid = pdbInfoHeader.guid.toRfc4122();
+
+	memcpy(header.magic, symbolIndexMagic, sizeof(symbolIndexMagic));
+	memcpy(header.guid, guid.constData(), qMin(static_cast<int>(sizeof(header.guid)), guid.size()));
+
+	header.version = version;
+	header.headerSize = sizeof(SymbolIndexHeader);
+	header.age = pdbInfoHeader.age;
+	header.signature = pdbInfoHeader.signature;
+	header.importOptions = importOptions;
+	header.tableCount = tableEntries.count();
+	header.stringPoolOffset = offset;
+
+	QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+	QSaveFile file(filePath);
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(SymbolIndexHeader));
+	file.write(reinterpret_cast<const char*>(tableEntries.constData()), tableEntries.count() * sizeof(SymbolIndexTableEntry));
+
+	for (int i = 0; i < tableCount; i++)
+	{
+		int count = tables[i].count();
+		QVector<SymbolIndexRecord> records(count);
+
+		for (int j = 0; j < count; j++)
+		{
+			const SymbolIndexEntry& entry = tables[i].at(j);
+
+			records[j].value1 = entry.value1;
+			records[j].value2 = entry.value2;
+			records[j].nameOffset = stringPoolLength;
+			records[j].nameLength = entry.name.length();
+			records[j].value3 = entry.value3;
+
+			stringPoolLength += entry.name.length();
+		}
+
+		file.write(reinterpret_cast<const char*>(records.constData()), count * sizeof(SymbolIndexRecord));
+	}
+
+	for (int i = 0; i < tableCount; i++)
+	{
+		int count = tables[i].count();
+
+		for (int j = 0; j < count; j++)
+		{
+			const QString& name = tables[i].at(j).name;
+
+			file.write(reinterpret_cast<const char*>(name.constData()), name.length() * sizeof(QChar));
+		}
+	}
+
+	//Size of string pool is known only after all names are written
+	header.stringPoolSize = stringPoolLength * sizeof(QChar);
+
+	file.seek(0);
+	file.write(reinterpret_cast<const char*>(&header), sizeof(SymbolIndexHeader));
+
+	return file.commit();
+}
+
+QString SymbolIndex::GetFilePath(const PDBInfoHeader& pdbInfoHeader)
+{
+	QString directoryPath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+
+	return QString("%1/SymbolIndex/%2-%3.idx").arg(directoryPath)
+		.arg(pdbInfoHeader.guid.toString(QUuid::WithoutBraces)).arg(pdbInfoHeader.age);
+}
+
+bool SymbolIndex::ReadTableDirectory()
+{
+	quint64 directoryEnd = header->headerSize + static_cast<quint64>(header->tableCount) * sizeof(SymbolIndexTableEntry);
+
+	if (directoryEnd > static_cast<quint64>(fileSize) ||
+		header->stringPoolOffset > static_cast<quint64>(fileSize) ||
+		header->stringPoolSize > static_cast<quint64>(fileSize) - header->stringPoolOffset)
+	{
+		return false;
+	}
+
+	const SymbolIndexTableEntry* entries = reinterpret_cast<const SymbolIndexTableEntry*>(fileData + header->headerSize);
+
+	for (quint32 i = 0; i < header->tableCount; i++)
+	{
+		const SymbolIndexTableEntry* tableEntry = &entries[i];
+		quint64 tableSize = static_cast<quint64>(tableEntry->recordCount) * sizeof(SymbolIndexRecord);
+
+		if (tableEntry->table >= static_cast<quint32>(SymbolIndexTable::count) ||
+			tableEntry->offset < directoryEnd ||
+			tableEntry->offset + tableSize > header->stringPoolOffset)
+		{
+			return false;
+		}
+
+		tableEntries[tableEntry->table] = tableEntry;
+	}
+
+	return true;
+}
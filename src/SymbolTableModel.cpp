@@ -0,0 +1,332 @@
+#include "SymbolTableModel.h"
+#include <algorithm>
+
+SymbolTableModel::SymbolTableModel(QObject* parent) : QAbstractTableModel(parent)
+{
+	categoryFilter = 0;
+	sortColumn = -1;
+	sortOrder = Qt::AscendingOrder;
+}
+
+int SymbolTableModel::rowCount(const QModelIndex& parent) const
+{
+	return parent.isValid() ? 0 : visibleRows.count();
+}
+
+int SymbolTableModel::columnCount(const QModelIndex& parent) const
+{
+	return parent.isValid() ? 0 : 2;
+}
+
+QVariant SymbolTableModel::data(const QModelIndex& index, int role) const
+{
+	if (!index.isValid() || index.row() >= visibleRows.count())
+	{
+		return QVariant();
+	}
+
+	int symbolIndex = visibleRows.at(index.row());
+
+	if (index.column() == 0)
+	{
+		if (role == Qt::DisplayRole)
+		{
+			return ids.at(symbolIndex);
+		}
+		else if (role == Qt::UserRole)
+		{
+			return types.at(symbolIndex);
+		}
+	}
+	else if (index.column() == 1)
+	{
+		if (role == Qt::DisplayRole || role == Qt::ToolTipRole)
+		{
+			return names.at(symbolIndex);
+		}
+	}
+
+	return QVariant();
+}
+
+QVariant SymbolTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+	{
+		return QAbstractTableModel::headerData(section, orientation, role);
+	}
+
+	if (section == 0)
+	{
+		return "ID";
+	}
+	else if (section == 1)
+	{
+		return "Symbol Name";
+	}
+
+	return QVariant();
+}
+
+/*
+* Only order of symbol indices is changed so rows which are selected are moved to their new positions
+*/
+void SymbolTableModel::sort(int column, Qt::SortOrder order)
+{
+	sortColumn = column;
+	sortOrder = order;
+
+	emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+
+	QModelIndexList oldIndices = persistentIndexList();
+	QVector<int> oldSymbols(oldIndices.count());
+
+	for (int i = 0; i < oldIndices.count(); i++)
+	{
+		oldSymbols[i] = visibleRows.at(oldIndices.at(i).row());
+	}
+
+	SortSymbols();
+
+	int count = visibleRows.count();
+
+	visibleRows.clear();
+
+	for (int i = 0; i < symbolOrder.count(); i++)
+	{
+		if (IsSymbolVisible(symbolOrder.at(i)))
+		{
+			visibleRows.append(symbolOrder.at(i));
+		}
+	}
+
+	Q_ASSERT(count == visibleRows.count());
+
+	QVector<int> rows(ids.count(), -1);
+	QModelIndexList newIndices;
+
+	for (int i = 0; i < visibleRows.count(); i++)
+	{
+		rows[visibleRows.at(i)] = i;
+	}
+
+	for (int i = 0; i < oldIndices.count(); i++)
+	{
+		newIndices.append(index(rows.at(oldSymbols.at(i)), oldIndices.at(i).column()));
+	}
+
+	changePersistentIndexList(oldIndices, newIndices);
+
+	emit layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+}
+
+void SymbolTableModel::SetSymbols(const std::vector<SymbolRecord>* symbolRecords)
+{
+	int count = static_cast<int>(symbolRecords->size());
+
+	ids.resize(count);
+	types.resize(count);
+	names.resize(count);
+	categories.resize(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		const SymbolRecord& symbolRecord = symbolRecords->at(i);
+
+		ids[i] = symbolRecord.id;
+		types[i] = static_cast<quint32>(symbolRecord.type);
+		names[i] = symbolRecord.typeName;
+		categories[i] = GetCategory(symbolRecord.type);
+	}
+
+	LoadSymbols();
+}
+
+/*
+* Categories of variables and functions aren't known until they are set by SetCategories
+*/
+void SymbolTableModel::SetSymbols(const QHash<QString, DWORD>* symbols)
+{
+	int count = symbols->count();
+	int i = 0;
+
+	ids.resize(count);
+	types.fill(0, count);
+	names.resize(count);
+	categories.clear();
+
+	for (auto it = symbols->constBegin(); it != symbols->constEnd(); it++)
+	{
+		ids[i] = it.value();
+		names[i] = it.key();
+
+		i++;
+	}
+
+	LoadSymbols();
+}
+
+void SymbolTableModel::Clear()
+{
+	beginResetModel();
+
+	ids.clear();
+	types.clear();
+	names.clear();
+	categories.clear();
+	symbolOrder.clear();
+	visibleRows.clear();
+	matchingSymbols.clear();
+	trigramIndex.Clear();
+	categoryFilter = 0;
+
+	endResetModel();
+}
+
+int SymbolTableModel::GetSymbolCount() const
+{
+	return ids.count();
+}
+
+DWORD SymbolTableModel::GetSymbolID(int symbolIndex) const
+{
+	return ids.at(symbolIndex);
+}
+
+bool SymbolTableModel::HasCategories() const
+{
+	return categories.count() == ids.count();
+}
+
+void SymbolTableModel::SetCategories(const QVector<quint32>& categories)
+{
+	Q_ASSERT(categories.count() == ids.count());
+
+	this->categories = categories;
+
+	UpdateVisibleRows();
+}
+
+/*
+* Symbol is visible if it belongs to any of categories in filter, if filter is 0 all symbols are visible
+*/
+void SymbolTableModel::SetCategoryFilter(quint32 categoryFilter)
+{
+	if (this->categoryFilter == categoryFilter)
+	{
+		return;
+	}
+
+	this->categoryFilter = categoryFilter;
+
+	UpdateVisibleRows();
+}
+
+void SymbolTableModel::SetSearchText(const QString& text)
+{
+	searchText = text;
+
+	UpdateMatchingSymbols();
+	UpdateVisibleRows();
+}
+
+const QString& SymbolTableModel::GetSearchText() const
+{
+	return searchText;
+}
+
+quint32 SymbolTableModel::GetCategory(SymbolType symbolType)
+{
+	return 1 << static_cast<quint32>(symbolType);
+}
+
+//Search text and filter are kept so they are applied to new symbols too
+void SymbolTableModel::LoadSymbols()
+{
+	int count = ids.count();
+
+	symbolOrder.resize(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		symbolOrder[i] = i;
+	}
+
+	trigramIndex.Build(names);
+
+	SortSymbols();
+	UpdateMatchingSymbols();
+	UpdateVisibleRows();
+}
+
+void SymbolTableModel::SortSymbols()
+{
+	bool isDescending = sortOrder == Qt::DescendingOrder;
+
+	if (sortColumn == 0)
+	{
+		std::stable_sort(symbolOrder.begin(), symbolOrder.end(), [this, isDescending](int symbolIndex1, int symbolIndex2)
+		{
+			return isDescending ? ids.at(symbolIndex2) < ids.at(symbolIndex1) : ids.at(symbolIndex1) < ids.at(symbolIndex2);
+		});
+	}
+	else if (sortColumn == 1)
+	{
+		std::stable_sort(symbolOrder.begin(), symbolOrder.end(), [this, isDescending](int symbolIndex1, int symbolIndex2)
+		{
+			return isDescending ? names.at(symbolIndex2) < names.at(symbolIndex1) : names.at(symbolIndex1) < names.at(symbolIndex2);
+		});
+	}
+}
+
+void SymbolTableModel::UpdateMatchingSymbols()
+{
+	matchingSymbols.clear();
+
+	if (searchText.length() == 0)
+	{
+		return;
+	}
+
+	QVector<int> symbolIndices = trigramIndex.Find(searchText);
+
+	matchingSymbols.resize(ids.count());
+
+	for (int i = 0; i < symbolIndices.count(); i++)
+	{
+		matchingSymbols.setBit(symbolIndices.at(i));
+	}
+}
+
+void SymbolTableModel::UpdateVisibleRows()
+{
+	beginResetModel();
+
+	visibleRows.clear();
+	visibleRows.reserve(symbolOrder.count());
+
+	for (int i = 0; i < symbolOrder.count(); i++)
+	{
+		if (IsSymbolVisible(symbolOrder.at(i)))
+		{
+			visibleRows.append(symbolOrder.at(i));
+		}
+	}
+
+	endResetModel();
+}
+
+bool SymbolTableModel::IsSymbolVisible(int symbolIndex) const
+{
+	if (categoryFilter != 0 && (!HasCategories() || !(categories.at(symbolIndex) & categoryFilter)))
+	{
+		return false;
+	}
+
+	if (searchText.length() > 0 && !matchingSymbols.testBit(symbolIndex))
+	{
+		return false;
+	}
+
+	return true;
+}
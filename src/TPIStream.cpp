@@ -0,0 +1,676 @@
+#include <algorithm>
+#include "TPIStream.h"
+
+static const quint32 invalidIndex = 0xFFFFFFFF;
+static const quint32 tpiHeaderSize = 56;
+//Linker adds index offset after every 8 KB of records
+static const quint32 indexOffsetInterval = 0x2000;
+
+TPIStream::TPIStream()
+{
+	header = {};
+	hashValues = nullptr;
+	isLoaded = false;
+}
+
+bool TPIStream::Load(const MSFFile* msfFile, MSFStreamIndex streamIndex)
+{
+	Clear();
+
+	if (!msfFile || !msfFile->IsOpen())
+	{
+		errorMessage = "MSF file isn't opened.";
+
+		return false;
+	}
+
+	MSFStream stream = msfFile->GetStream(streamIndex);
+
+	if (!stream.IsValid() || !ReadHeader(stream))
+	{
+		if (errorMessage.isEmpty())
+		{
+			errorMessage = "Type stream doesn't exist.";
+		}
+
+		return false;
+	}
+
+	//Stream data points to mapped file if stream blocks are contiguous, otherwise blocks are copied once
+	streamData = stream.GetData();
+
+	if (static_cast<quint32>(streamData.size()) < header.headerSize + header.typeRecordBytes)
+	{
+		Clear();
+		errorMessage = "Type stream is truncated.";
+
+		return false;
+	}
+
+	recordData = QByteArray::fromRawData(streamData.constData() + header.headerSize, header.typeRecordBytes);
+
+	//Index offsets have to be computed only if PDB doesn't have them
+	if (!ReadHashStream(msfFile) || indexOffsets.isEmpty())
+	{
+		BuildIndexOffsets();
+	}
+
+	isLoaded = true;
+
+	return true;
+}
+
+void TPIStream::Clear()
+{
+	header = {};
+	recordData.clear();
+	streamData.clear();
+	hashValueBuffer.clear();
+	hashValues = nullptr;
+	indexOffsets.clear();
+	bucketHeads.clear();
+	bucketNext.clear();
+	hasHashBuckets.storeRelease(0);
+	errorMessage.clear();
+	isLoaded = false;
+}
+
+bool TPIStream::IsLoaded() const
+{
+	return isLoaded;
+}
+
+const QString& TPIStream::GetErrorMessage() const
+{
+	return errorMessage;
+}
+
+const TPIStreamHeader& TPIStream::GetHeader() const
+{
+	return header;
+}
+
+quint32 TPIStream::GetTypeIndexBegin() const
+{
+	return header.typeIndexBegin;
+}
+
+quint32 TPIStream::GetTypeIndexEnd() const
+{
+	return header.typeIndexEnd;
+}
+
+int TPIStream::GetRecordCount() const
+{
+	return header.typeIndexEnd - header.typeIndexBegin;
+}
+
+//Nearest index offset before type index is found by binary search and records after it are skipped
+bool TPIStream::GetRecord(quint32 typeIndex, TPIRecord* record) const
+{
+	if (typeIndex < header.typeIndexBegin || typeIndex >= header.typeIndexEnd || indexOffsets.isEmpty())
+	{
+		return false;
+	}
+
+	auto it = std::upper_bound(indexOffsets.constBegin(), indexOffsets.constEnd(), typeIndex,
+		[](quint32 typeIndex, const TPIIndexOffset& indexOffset)
+	{
+		return typeIndex < indexOffset.typeIndex;
+	});
+
+	if (it == indexOffsets.constBegin() || !ReadRecord((it - 1)->typeIndex, (it - 1)->offset, record))
+	{
+		return false;
+	}
+
+	while (record->typeIndex < typeIndex)
+	{
+		if (!GetNextRecord(*record, record))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//Records are stored one after another so records can be enumerated without looking up their offsets
+bool TPIStream::GetNextRecord(const TPIRecord& record, TPIRecord* nextRecord) const
+{
+	quint32 offset = static_cast<quint32>(record.data + record.length - reinterpret_cast<const uchar*>(recordData.constData()));
+
+	if (record.typeIndex + 1 >= header.typeIndexEnd)
+	{
+		return false;
+	}
+
+	return ReadRecord(record.typeIndex + 1, offset, nextRecord);
+}
+
+bool TPIStream::GetUDTRecord(quint32 typeIndex, TPIUDTRecord* udtRecord) const
+{
+	TPIRecord record;
+
+	if (!GetRecord(typeIndex, &record))
+	{
+		return false;
+	}
+
+	return DecodeUDTRecord(record, udtRecord);
+}
+
+quint32 TPIStream::FindTypeIndex(const QString& typeName, bool findForwardReference) const
+{
+	return FindTypeIndex(typeName.toUtf8(), findForwardReference);
+}
+
+/*
+* Returns type index of first definition with given name or 0 if type isn't defined.
+* Forward references are skipped since they don't contain field list and size,
+* if findForwardReference is true first forward reference is returned for type which isn't defined.
+*/
+quint32 TPIStream::FindTypeIndex(const QByteArray& typeName, bool findForwardReference) const
+{
+	if (!isLoaded || typeName.isEmpty())
+	{
+		return 0;
+	}
+
+	if (!hasHashBuckets.loadAcquire())
+	{
+		BuildHashBuckets();
+	}
+
+	quint32 hash = HashStringV1(typeName.constData(), typeName.size()) % bucketHeads.count();
+	quint32 index = bucketHeads.at(hash);
+	quint32 forwardReferenceIndex = 0;
+
+	while (index != invalidIndex)
+	{
+		TPIRecord record;
+		const char* name;
+		int length;
+		quint16 property;
+
+		if (GetRecord(header.typeIndexBegin + index, &record) &&
+			GetUDTRecordName(record, &name, &length, &property) &&
+			length == typeName.size() &&
+			memcmp(name, typeName.constData(), length) == 0)
+		{
+			if (!(property & propertyForwardReference))
+			{
+				return record.typeIndex;
+			}
+
+			if (!forwardReferenceIndex)
+			{
+				forwardReferenceIndex = record.typeIndex;
+			}
+		}
+
+		index = bucketNext.at(index);
+	}
+
+	return findForwardReference ? forwardReferenceIndex : 0;
+}
+
+bool TPIStream::IsUDTLeaf(quint16 kind)
+{
+	return kind == LF_CLASS || kind == LF_STRUCTURE || kind == LF_UNION || kind == LF_ENUM || kind == LF_INTERFACE;
+}
+
+bool TPIStream::DecodeUDTRecord(const TPIRecord& record, TPIUDTRecord* udtRecord, bool readNames)
+{
+	if (!IsUDTLeaf(record.kind))
+	{
+		return false;
+	}
+
+	const uchar* data = record.data;
+	const uchar* end = record.data + record.length;
+
+	*udtRecord = {};
+	udtRecord->typeIndex = record.typeIndex;
+	udtRecord->kind = record.kind;
+
+	if (end - data < 4)
+	{
+		return false;
+	}
+
+	udtRecord->memberCount = qFromLittleEndian<quint16>(data);
+	udtRecord->property = qFromLittleEndian<quint16>(data + 2);
+	data += 4;
+
+	switch (record.kind)
+	{
+	case LF_CLASS:
+	case LF_STRUCTURE:
+	case LF_INTERFACE:
+		if (end - data < 12)
+		{
+			return false;
+		}
+
+		udtRecord->fieldList = qFromLittleEndian<quint32>(data);
+		udtRecord->derivedFrom = qFromLittleEndian<quint32>(data + 4);
+		udtRecord->vTableShape = qFromLittleEndian<quint32>(data + 8);
+		data += 12;
+
+		if (!ReadNumericLeaf(data, end, &udtRecord->size))
+		{
+			return false;
+		}
+
+		break;
+	case LF_UNION:
+		if (end - data < 4)
+		{
+			return false;
+		}
+
+		udtRecord->fieldList = qFromLittleEndian<quint32>(data);
+		data += 4;
+
+		if (!ReadNumericLeaf(data, end, &udtRecord->size))
+		{
+			return false;
+		}
+
+		break;
+	case LF_ENUM:
+		if (end - data < 8)
+		{
+			return false;
+		}
+
+		udtRecord->underlyingType = qFromLittleEndian<quint32>(data);
+		udtRecord->fieldList = qFromLittleEndian<quint32>(data + 4);
+		data += 8;
+
+		break;
+	}
+
+	if (!readNames)
+	{
+		return true;
+	}
+
+	int length = static_cast<int>(qstrnlen(reinterpret_cast<const char*>(data), end - data));
+
+	udtRecord->name = QString::fromUtf8(reinterpret_cast<const char*>(data), length);
+	data += length + 1;
+
+	if ((udtRecord->property & propertyHasUniqueName) && data < end)
+	{
+		length = static_cast<int>(qstrnlen(reinterpret_cast<const char*>(data), end - data));
+		udtRecord->uniqueName = QString::fromUtf8(reinterpret_cast<const char*>(data), length);
+	}
+
+	return true;
+}
+
+/*
+* Returns pointer to name of UDT record without decoding whole record,
+* it's used by hash lookup so it doesn't allocate memory
+*/
+bool TPIStream::GetUDTRecordName(const TPIRecord& record, const char** name, int* length, quint16* property)
+{
+	const uchar* data = record.data;
+	const uchar* end = record.data + record.length;
+	quint64 size;
+
+	if (end - data < 4)
+	{
+		return false;
+	}
+
+	if (property)
+	{
+		*property = qFromLittleEndian<quint16>(data + 2);
+	}
+
+	data += 4;
+
+	switch (record.kind)
+	{
+	case LF_CLASS:
+	case LF_STRUCTURE:
+	case LF_INTERFACE:
+		data += 12;
+
+		if (!ReadNumericLeaf(data, end, &size))
+		{
+			return false;
+		}
+
+		break;
+	case LF_UNION:
+		data += 4;
+
+		if (!ReadNumericLeaf(data, end, &size))
+		{
+			return false;
+		}
+
+		break;
+	case LF_ENUM:
+		data += 8;
+
+		break;
+	default:
+		return false;
+	}
+
+	if (data >= end)
+	{
+		return false;
+	}
+
+	*name = reinterpret_cast<const char*>(data);
+	*length = static_cast<int>(qstrnlen(*name, end - data));
+
+	return true;
+}
+
+bool TPIStream::ReadNumericLeaf(const uchar*& data, const uchar* end, quint64* value)
+{
+	if (end - data < 2)
+	{
+		return false;
+	}
+
+	quint16 leaf = qFromLittleEndian<quint16>(data);
+
+	data += 2;
+
+	if (leaf < LF_NUMERIC)
+	{
+		*value = leaf;
+
+		return true;
+	}
+
+	int size = 0;
+
+	switch (leaf)
+	{
+	case LF_CHAR:
+		size = 1;
+		break;
+	case LF_SHORT:
+	case LF_USHORT:
+		size = 2;
+		break;
+	case LF_LONG:
+	case LF_ULONG:
+		size = 4;
+		break;
+	case LF_QUADWORD:
+	case LF_UQUADWORD:
+		size = 8;
+		break;
+	default:
+		return false;
+	}
+
+	if (end - data < size)
+	{
+		return false;
+	}
+
+	switch (leaf)
+	{
+	case LF_CHAR:
+		*value = static_cast<quint64>(static_cast<qint8>(*data));
+		break;
+	case LF_SHORT:
+		*value = static_cast<quint64>(qFromLittleEndian<qint16>(data));
+		break;
+	case LF_USHORT:
+		*value = qFromLittleEndian<quint16>(data);
+		break;
+	case LF_LONG:
+		*value = static_cast<quint64>(qFromLittleEndian<qint32>(data));
+		break;
+	case LF_ULONG:
+		*value = qFromLittleEndian<quint32>(data);
+		break;
+	default:
+		*value = qFromLittleEndian<quint64>(data);
+		break;
+	}
+
+	data += size;
+
+	return true;
+}
+
+/*
+* Hash function which is used by MSVC linker for type names (hashStringV1 in LLVM)
+*/
+quint32 TPIStream::HashStringV1(const char* string, int length)
+{
+	const uchar* data = reinterpret_cast<const uchar*>(string);
+	quint32 result = 0;
+	int count = length / 4;
+
+	for (int i = 0; i < count; i++)
+	{
+		result ^= qFromLittleEndian<quint32>(data);
+		data += 4;
+	}
+
+	if (length & 2)
+	{
+		result ^= qFromLittleEndian<quint16>(data);
+		data += 2;
+	}
+
+	if (length & 1)
+	{
+		result ^= *data;
+	}
+
+	result |= 0x20202020;
+	result ^= (result >> 11);
+
+	return result ^ (result >> 16);
+}
+
+bool TPIStream::ReadHeader(const MSFStream& stream)
+{
+	if (stream.GetSize() < tpiHeaderSize)
+	{
+		errorMessage = "Type stream is too small.";
+
+		return false;
+	}
+
+	stream.ReadValue(0, &header.version);
+	stream.ReadValue(4, &header.headerSize);
+	stream.ReadValue(8, &header.typeIndexBegin);
+	stream.ReadValue(12, &header.typeIndexEnd);
+	stream.ReadValue(16, &header.typeRecordBytes);
+	stream.ReadValue(20, &header.hashStreamIndex);
+	stream.ReadValue(22, &header.hashAuxStreamIndex);
+	stream.ReadValue(24, &header.hashKeySize);
+	stream.ReadValue(28, &header.numHashBuckets);
+	stream.ReadValue(32, &header.hashValueBufferOffset);
+	stream.ReadValue(36, &header.hashValueBufferLength);
+	stream.ReadValue(40, &header.indexOffsetBufferOffset);
+	stream.ReadValue(44, &header.indexOffsetBufferLength);
+	stream.ReadValue(48, &header.hashAdjBufferOffset);
+	stream.ReadValue(52, &header.hashAdjBufferLength);
+
+	if (header.headerSize < tpiHeaderSize || header.typeIndexEnd < header.typeIndexBegin)
+	{
+		errorMessage = "Type stream header is invalid.";
+
+		return false;
+	}
+
+	return true;
+}
+
+bool TPIStream::ReadHashStream(const MSFFile* msfFile)
+{
+	if (header.hashStreamIndex == 0xFFFF || header.hashStreamIndex >= msfFile->GetNumberOfStreams())
+	{
+		return false;
+	}
+
+	MSFStream stream = msfFile->GetStream(header.hashStreamIndex);
+
+	if (!stream.IsValid())
+	{
+		return false;
+	}
+
+	//Hash value buffer has one bucket index for every record
+	quint32 recordCount = header.typeIndexEnd - header.typeIndexBegin;
+
+	if (header.hashKeySize == sizeof(quint32) && header.numHashBuckets > 0 && header.hashValueBufferOffset >= 0 &&
+		header.hashValueBufferLength == static_cast<quint64>(recordCount) * sizeof(quint32))
+	{
+		hashValues = reinterpret_cast<const uchar*>(stream.GetData(header.hashValueBufferOffset, header.hashValueBufferLength, hashValueBuffer));
+	}
+
+	if (header.indexOffsetBufferLength == 0 || header.indexOffsetBufferOffset < 0)
+	{
+		return true;
+	}
+
+	int count = header.indexOffsetBufferLength / sizeof(TPIIndexOffset);
+
+	indexOffsets.resize(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		quint32 offset = header.indexOffsetBufferOffset + i * sizeof(TPIIndexOffset);
+		TPIIndexOffset& indexOffset = indexOffsets[i];
+
+		//Offsets have to be sorted and they have to point inside of records, first one points to first record
+		if (!stream.ReadValue(offset, &indexOffset.typeIndex) || !stream.ReadValue(offset + 4, &indexOffset.offset) ||
+			indexOffset.typeIndex >= header.typeIndexEnd || indexOffset.offset >= header.typeRecordBytes ||
+			(i == 0 && (indexOffset.typeIndex != header.typeIndexBegin || indexOffset.offset != 0)) ||
+			(i > 0 && (indexOffset.typeIndex <= indexOffsets.at(i - 1).typeIndex || indexOffset.offset <= indexOffsets.at(i - 1).offset)))
+		{
+			indexOffsets.clear();
+
+			break;
+		}
+	}
+
+	return true;
+}
+
+bool TPIStream::ReadRecord(quint32 typeIndex, quint32 offset, TPIRecord* record) const
+{
+	if (offset + 4 > header.typeRecordBytes)
+	{
+		return false;
+	}
+
+	const uchar* data = reinterpret_cast<const uchar*>(recordData.constData()) + offset;
+	quint16 length = qFromLittleEndian<quint16>(data);
+
+	if (length < 2 || offset + 2 + length > header.typeRecordBytes)
+	{
+		return false;
+	}
+
+	record->typeIndex = typeIndex;
+	record->kind = qFromLittleEndian<quint16>(data + 2);
+	record->data = data + 4;
+	record->length = length - 2;
+
+	return true;
+}
+
+//PDBs which don't have index offset buffer are indexed the same way as linker does it
+void TPIStream::BuildIndexOffsets()
+{
+	quint32 recordCount = header.typeIndexEnd - header.typeIndexBegin;
+	quint32 offset = 0;
+	quint32 lastOffset = 0;
+
+	indexOffsets.clear();
+
+	for (quint32 i = 0; i < recordCount; i++)
+	{
+		TPIRecord record;
+
+		if (!ReadRecord(header.typeIndexBegin + i, offset, &record))
+		{
+			break;
+		}
+
+		if (i == 0 || offset - lastOffset >= indexOffsetInterval)
+		{
+			indexOffsets.append({ record.typeIndex, offset });
+			lastOffset = offset;
+		}
+
+		offset += record.length + 4;
+	}
+}
+
+/*
+* Chains are built from bucket indices in hash value buffer when name is looked up first time so opening PDB doesn't
+* depend on number of records. Scoped types and forward references aren't always hashed by their names (see LLVM
+* hashTypeRecord) so only they are moved to bucket of their name, all types are hashed by name if PDB doesn't have
+* hash value buffer. Records are inserted in reverse order so that chains start with lowest type index.
+*/
+void TPIStream::BuildHashBuckets() const
+{
+	QMutexLocker locker(&hashBucketsMutex);
+
+	if (hasHashBuckets.loadAcquire())
+	{
+		return;
+	}
+
+	int recordCount = GetRecordCount();
+	quint32 bucketCount = hashValues ? header.numHashBuckets : 0x3FFFF;
+	QVector<quint32> buckets(recordCount, invalidIndex);
+	TPIRecord record;
+	bool hasRecord = GetRecord(header.typeIndexBegin, &record);
+
+	for (int i = 0; i < recordCount && hasRecord; i++)
+	{
+		const char* name;
+		int length;
+		quint16 property;
+
+		if (hashValues)
+		{
+			buckets[i] = qFromLittleEndian<quint32>(hashValues + i * sizeof(quint32));
+		}
+
+		if (IsUDTLeaf(record.kind) && GetUDTRecordName(record, &name, &length, &property) &&
+			(!hashValues || (property & (propertyForwardReference | propertyScoped))))
+		{
+			buckets[i] = HashStringV1(name, length) % bucketCount;
+		}
+
+		hasRecord = GetNextRecord(record, &record);
+	}
+
+	bucketHeads.fill(invalidIndex, bucketCount);
+	bucketNext.fill(invalidIndex, recordCount);
+
+	for (int i = recordCount - 1; i >= 0; i--)
+	{
+		quint32 bucket = buckets.at(i);
+
+		if (bucket < bucketCount)
+		{
+			bucketNext[i] = bucketHeads.at(bucket);
+			bucketHeads[bucket] = i;
+		}
+	}
+
+	hasHashBuckets.storeRelease(1);
+}
@@ -0,0 +1,165 @@
+#include "TextBuilder.h"
+
+TextBuilder::TextBuilder()
+{
+	length = 0;
+}
+
+TextBuilder& TextBuilder::operator+=(const QString& text)
+{
+	if (text.isEmpty())
+	{
+		return *this;
+	}
+
+	//Large text is shared instead of copied
+	if (text.length() >= chunkSize)
+	{
+		chunks.append(text);
+	}
+	else
+	{
+		GetChunk(text.length()).append(text);
+	}
+
+	length += text.length();
+
+	return *this;
+}
+
+TextBuilder& TextBuilder::operator+=(const char* text)
+{
+	QLatin1String text2(text);
+
+	if (text2.size() == 0)
+	{
+		return *this;
+	}
+
+	GetChunk(text2.size()).append(text2);
+	length += text2.size();
+
+	return *this;
+}
+
+TextBuilder& TextBuilder::operator+=(const TextBuilder& text)
+{
+	int count = text.chunks.count();
+
+	for (int i = 0; i < count; i++)
+	{
+		chunks.append(text.chunks.at(i));
+	}
+
+	length += text.length;
+
+	return *this;
+}
+
+void TextBuilder::AppendIndentation(int level)
+{
+	*this += GetIndentation(level);
+}
+
+void TextBuilder::RemoveLast(int count)
+{
+	count = qMin(count, length);
+	length -= count;
+
+	while (count > 0)
+	{
+		QString& chunk = chunks.last();
+		int count2 = qMin(count, chunk.length());
+
+		chunk.chop(count2);
+		count -= count2;
+
+		if (chunk.isEmpty())
+		{
+			chunks.removeLast();
+		}
+	}
+}
+
+int TextBuilder::Length() const
+{
+	return length;
+}
+
+bool TextBuilder::IsEmpty() const
+{
+	return length == 0;
+}
+
+QString TextBuilder::ToString() const
+{
+	if (chunks.count() == 1)
+	{
+		return chunks.first();
+	}
+
+	QString text;
+	int count = chunks.count();
+
+	text.reserve(length);
+
+	for (int i = 0; i < count; i++)
+	{
+		text += chunks.at(i);
+	}
+
+	return text;
+}
+
+bool TextBuilder::WriteLatin1(QIODevice* device) const
+{
+	int count = chunks.count();
+
+	for (int i = 0; i < count; i++)
+	{
+		QByteArray text = chunks.at(i).toLatin1();
+
+		if (device->write(text) != text.size())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//Indentations are created once and shared by all generated code
+QString TextBuilder::GetIndentation(int level)
+{
+	static const int count = 32;
+	static const QVector<QString> indentations = []()
+	{
+		QVector<QString> indentations(count);
+
+		for (int i = 1; i < count; i++)
+		{
+			indentations[i] = indentations.at(i - 1) + "\t";
+		}
+
+		return indentations;
+	}();
+
+	if (level < count)
+	{
+		return indentations.at(qMax(level, 0));
+	}
+
+	return QString(level, '\t');
+}
+
+//Returns chunk in which there is enough space for text so chunk doesn't need to be reallocated
+QString& TextBuilder::GetChunk(int size)
+{
+	if (chunks.isEmpty() || chunks.last().length() + size > chunkSize)
+	{
+		chunks.append(QString());
+		chunks.last().reserve(chunkSize);
+	}
+
+	return chunks.last();
+}
@@ -0,0 +1,161 @@
+#include "TrigramIndex.h"
+#include <algorithm>
+#include <iterator>
+
+TrigramIndex::TrigramIndex()
+{
+
+}
+
+/*
+* Posting lists are stored in one array, first pass counts names per bucket
+* and second pass fills lists in order of names so every list is already sorted
+*/
+void TrigramIndex::Build(const QVector<QString>& names)
+{
+	const int bucketCount = 1 << bucketBits;
+	int count = names.count();
+	QVector<quint32> buckets;
+
+	Clear();
+
+	this->names = names;
+	bucketOffsets.fill(0, bucketCount + 1);
+
+	for (int i = 0; i < count; i++)
+	{
+		GetBuckets(names.at(i).toCaseFolded(), buckets);
+
+		for (int j = 0; j < buckets.count(); j++)
+		{
+			bucketOffsets[buckets.at(j) + 1]++;
+		}
+	}
+
+	for (int i = 0; i < bucketCount; i++)
+	{
+		bucketOffsets[i + 1] += bucketOffsets.at(i);
+	}
+
+	QVector<quint32> positions(bucketOffsets.constBegin(), bucketOffsets.constEnd() - 1);
+
+	postings.resize(bucketOffsets.at(bucketCount));
+
+	for (int i = 0; i < count; i++)
+	{
+		GetBuckets(names.at(i).toCaseFolded(), buckets);
+
+		for (int j = 0; j < buckets.count(); j++)
+		{
+			postings[positions[buckets.at(j)]++] = i;
+		}
+	}
+}
+
+void TrigramIndex::Clear()
+{
+	names.clear();
+	bucketOffsets.clear();
+	postings.clear();
+}
+
+bool TrigramIndex::IsEmpty() const
+{
+	return names.isEmpty();
+}
+
+int TrigramIndex::GetNameCount() const
+{
+	return names.count();
+}
+
+/*
+* Returns indices of all names which contain text in ascending order
+*/
+QVector<int> TrigramIndex::Find(const QString& text) const
+{
+	QVector<int> result;
+	int count = names.count();
+
+	if (text.length() < 3 || bucketOffsets.isEmpty())
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (names.at(i).contains(text, Qt::CaseInsensitive))
+			{
+				result.append(i);
+			}
+		}
+
+		return result;
+	}
+
+	QVector<quint32> buckets;
+
+	GetBuckets(text.toCaseFolded(), buckets);
+
+	//Intersection starts with the shortest list so number of candidates is as small as possible
+	std::sort(buckets.begin(), buckets.end(), [this](quint32 bucket1, quint32 bucket2)
+	{
+		return bucketOffsets.at(bucket1 + 1) - bucketOffsets.at(bucket1) < bucketOffsets.at(bucket2 + 1) - bucketOffsets.at(bucket2);
+	});
+
+	const quint32* begin = postings.constData() + bucketOffsets.at(buckets.at(0));
+	const quint32* end = postings.constData() + bucketOffsets.at(buckets.at(0) + 1);
+	QVector<quint32> candidates(begin, end);
+	QVector<quint32> intersection;
+
+	//Output of set_intersection can't overlap its input so every intersection is written to second list
+	for (int i = 1; i < buckets.count() && !candidates.isEmpty(); i++)
+	{
+		begin = postings.constData() + bucketOffsets.at(buckets.at(i));
+		end = postings.constData() + bucketOffsets.at(buckets.at(i) + 1);
+
+		intersection.clear();
+		std::set_intersection(candidates.constBegin(), candidates.constEnd(), begin, end, std::back_inserter(intersection));
+		candidates.swap(intersection);
+	}
+
+	result.reserve(candidates.count());
+
+	for (int i = 0; i < candidates.count(); i++)
+	{
+		if (names.at(candidates.at(i)).contains(text, Qt::CaseInsensitive))
+		{
+			result.append(candidates.at(i));
+		}
+	}
+
+	return result;
+}
+
+quint32 TrigramIndex::GetBucket(const QChar* text)
+{
+	quint64 trigram = static_cast<quint64>(text[0].unicode()) |
+		static_cast<quint64>(text[1].unicode()) << 16 |
+		static_cast<quint64>(text[2].unicode()) << 32;
+
+	return static_cast<quint32>((trigram * 0x9E3779B97F4A7C15ull) >> (64 - bucketBits));
+}
+
+void TrigramIndex::GetBuckets(const QString& foldedText, QVector<quint32>& buckets)
+{
+	int count = foldedText.length() - 2;
+
+	buckets.clear();
+
+	if (count <= 0)
+	{
+		return;
+	}
+
+	const QChar* data = foldedText.constData();
+
+	for (int i = 0; i < count; i++)
+	{
+		buckets.append(GetBucket(data + i));
+	}
+
+	std::sort(buckets.begin(), buckets.end());
+	buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+}
@@ -0,0 +1,89 @@
+#include "TypeGraph.h"
+
+TypeGraph::TypeGraph()
+{
+	optionsFingerprint = 0;
+}
+
+bool TypeGraph::Contains(DWORD id)
+{
+	QMutexLocker locker(&mutex);
+
+	return nodes.contains(id);
+}
+
+void TypeGraph::AddType(DWORD id, const QVector<SymbolRecord>& references)
+{
+	QMutexLocker locker(&mutex);
+
+	if (nodes.contains(id))
+	{
+		return;
+	}
+
+	Node node;
+	int count = references.count();
+
+	node.begin = this->references.count();
+	node.count = count;
+
+	for (int i = 0; i < count; i++)
+	{
+		const SymbolRecord& symbolRecord = references.at(i);
+
+		this->references.append(symbolRecord.id);
+
+		if (!symbolRecords.contains(symbolRecord.id))
+		{
+			symbolRecords.insert(symbolRecord.id, symbolRecord);
+		}
+	}
+
+	nodes.insert(id, node);
+}
+
+QVector<SymbolRecord> TypeGraph::GetReferences(DWORD id)
+{
+	QMutexLocker locker(&mutex);
+	QVector<SymbolRecord> references;
+	auto it = nodes.constFind(id);
+
+	if (it == nodes.constEnd())
+	{
+		return references;
+	}
+
+	references.reserve(it->count);
+
+	for (int i = it->begin; i < it->begin + it->count; i++)
+	{
+		references.append(symbolRecords.value(this->references.at(i)));
+	}
+
+	return references;
+}
+
+void TypeGraph::SetOptionsFingerprint(quint64 optionsFingerprint)
+{
+	QMutexLocker locker(&mutex);
+
+	if (this->optionsFingerprint == optionsFingerprint)
+	{
+		return;
+	}
+
+	nodes.clear();
+	references.clear();
+	symbolRecords.clear();
+
+	this->optionsFingerprint = optionsFingerprint;
+}
+
+void TypeGraph::Clear()
+{
+	QMutexLocker locker(&mutex);
+
+	nodes.clear();
+	references.clear();
+	symbolRecords.clear();
+}
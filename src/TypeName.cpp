@@ -0,0 +1,575 @@
+#include "TypeName.h"
+#include "NameArena.h"
+
+TypeName::TypeName(const QString& name)
+{
+	this->name = name;
+
+	isConst = false;
+	isVolatile = false;
+	pointerLevel = 0;
+	isReference = false;
+	hasTemplateArguments = false;
+
+	ParseName();
+
+	formattedName = NameArena::InternString(Format(name));
+}
+
+/*
+* Names are cached by their ID in name arena so same name is parsed only once,
+* name is parsed outside of lock because template arguments are parsed recursively
+*/
+QSharedPointer<const TypeName> TypeName::Parse(const QString& name)
+{
+	quint32 id = NameArena::Intern(name);
+	Cache& cache = GetCache();
+
+	{
+		QReadLocker locker(&cache.lock);
+		auto it = cache.typeNames.constFind(id);
+
+		if (it != cache.typeNames.constEnd())
+		{
+			return it.value();
+		}
+	}
+
+	QSharedPointer<const TypeName> typeName(new TypeName(NameArena::GetName(id)));
+	QWriteLocker locker(&cache.lock);
+	auto it = cache.typeNames.constFind(id);
+
+	if (it != cache.typeNames.constEnd())
+	{
+		return it.value();
+	}
+
+	cache.typeNames.insert(id, typeName);
+
+	return typeName;
+}
+
+const QString& TypeName::GetName() const
+{
+	return name;
+}
+
+/*
+* Name without space before >, ',', * and & and with space after ',',
+* keywords class, struct, union and enum are removed from names of templates
+*/
+const QString& TypeName::GetFormattedName() const
+{
+	return formattedName;
+}
+
+const QString& TypeName::GetKeyword() const
+{
+	return keyword;
+}
+
+const QVector<TypeNameScope>& TypeName::GetScopes() const
+{
+	return scopes;
+}
+
+//Returns position of :: which follows scope
+int TypeName::GetScopeSeparatorIndex(int scopeIndex) const
+{
+	return scopes.at(scopeIndex + 1).index - 2;
+}
+
+//Returns position of :: before last scope or 0 if name has only one scope
+int TypeName::GetLastScopeSeparatorIndex() const
+{
+	if (scopes.count() < 2)
+	{
+		return 0;
+	}
+
+	return scopes.last().index - 2;
+}
+
+QString TypeName::GetParentName() const
+{
+	if (scopes.count() < 2)
+	{
+		return "";
+	}
+
+	return name.mid(0, GetLastScopeSeparatorIndex());
+}
+
+//Returns name of first scope without template arguments, for example std for std::vector<int>
+QString TypeName::GetOuterName() const
+{
+	if (scopes.isEmpty())
+	{
+		return name;
+	}
+
+	return scopes.first().name;
+}
+
+bool TypeName::HasTemplateArguments() const
+{
+	return hasTemplateArguments;
+}
+
+bool TypeName::IsConst() const
+{
+	return isConst;
+}
+
+bool TypeName::IsVolatile() const
+{
+	return isVolatile;
+}
+
+int TypeName::GetPointerLevel() const
+{
+	return pointerLevel;
+}
+
+bool TypeName::IsReference() const
+{
+	return isReference;
+}
+
+bool TypeName::IsFunction() const
+{
+	return scopes.isEmpty() && (returnType || parameters.count() > 0);
+}
+
+/*
+* Adds names of types which are used by this type, that is first scope of type and types which are used
+* by its template arguments or by return type and parameters of function type
+*/
+void TypeName::GetReferencedTypeNames(QStringList& typeNames) const
+{
+	if (returnType)
+	{
+		returnType->GetReferencedTypeNames(typeNames);
+	}
+
+	int parameterCount = parameters.count();
+
+	for (int i = 0; i < parameterCount; i++)
+	{
+		parameters.at(i)->GetReferencedTypeNames(typeNames);
+	}
+
+	int scopeCount = scopes.count();
+
+	if (scopeCount == 0)
+	{
+		return;
+	}
+
+	const QString& outerName = scopes.first().name;
+
+	if (outerName.length() > 0 && (outerName.at(0).isLetter() || outerName.at(0) == '_'))
+	{
+		typeNames.append(outerName);
+	}
+
+	for (int i = 0; i < scopeCount; i++)
+	{
+		const QVector<QSharedPointer<const TypeName>>& templateArguments = scopes.at(i).templateArguments;
+		int templateArgumentCount = templateArguments.count();
+
+		for (int j = 0; j < templateArgumentCount; j++)
+		{
+			templateArguments.at(j)->GetReferencedTypeNames(typeNames);
+		}
+	}
+}
+
+void TypeName::ParseName()
+{
+	static const QString keywords[] = { "class", "struct", "union", "enum" };
+	static const QString callingConventions[] = { "__cdecl", "__stdcall", "__thiscall", "__fastcall", "__vectorcall", "__clrcall" };
+	int begin = 0;
+	int end = name.length();
+
+	while (begin < end)
+	{
+		if (name.at(begin) == ' ')
+		{
+			begin++;
+		}
+		else if (StartsWithWord(begin, end, "const"))
+		{
+			isConst = true;
+			begin += 5;
+		}
+		else if (StartsWithWord(begin, end, "volatile"))
+		{
+			isVolatile = true;
+			begin += 8;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	for (const QString& keyword : keywords)
+	{
+		if (StartsWithWord(begin, end, keyword))
+		{
+			this->keyword = keyword;
+			begin += keyword.length();
+
+			while (begin < end && name.at(begin) == ' ')
+			{
+				begin++;
+			}
+
+			break;
+		}
+	}
+
+	while (end > begin)
+	{
+		QChar character = name.at(end - 1);
+
+		if (character == ' ')
+		{
+			end--;
+		}
+		else if (character == '*')
+		{
+			pointerLevel++;
+			end--;
+		}
+		else if (character == '&')
+		{
+			isReference = true;
+			end--;
+		}
+		else if (EndsWithWord(begin, end, "const"))
+		{
+			isConst = true;
+			end -= 5;
+		}
+		else if (EndsWithWord(begin, end, "volatile"))
+		{
+			isVolatile = true;
+			end -= 8;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	if (begin == end)
+	{
+		return;
+	}
+
+	//Type is function type if it has parameters which are not part of template arguments
+	int depth = 0;
+	int parameterListBegin = -1;
+
+	for (int i = begin; i < end; i++)
+	{
+		QChar character = name.at(i);
+
+		if (character == '<')
+		{
+			depth++;
+		}
+		else if (character == '>')
+		{
+			depth--;
+		}
+		else if (character == '(' && depth == 0)
+		{
+			parameterListBegin = i;
+
+			break;
+		}
+	}
+
+	if (parameterListBegin == -1 || name.at(end - 1) != ')')
+	{
+		ParseScopes(begin, end);
+
+		return;
+	}
+
+	//Parameters are in last parentheses, first parentheses can contain calling convention and pointer
+	int lastParameterListBegin = end - 1;
+
+	depth = 0;
+
+	for (int i = end - 1; i >= parameterListBegin; i--)
+	{
+		QChar character = name.at(i);
+
+		if (character == ')')
+		{
+			depth++;
+		}
+		else if (character == '(')
+		{
+			depth--;
+
+			if (depth == 0)
+			{
+				lastParameterListBegin = i;
+
+				break;
+			}
+		}
+	}
+
+	int returnTypeEnd = parameterListBegin;
+
+	while (returnTypeEnd > begin && name.at(returnTypeEnd - 1) == ' ')
+	{
+		returnTypeEnd--;
+	}
+
+	for (const QString& callingConvention : callingConventions)
+	{
+		if (EndsWithWord(begin, returnTypeEnd, callingConvention))
+		{
+			returnTypeEnd -= callingConvention.length();
+
+			break;
+		}
+	}
+
+	QString returnTypeName = name.mid(begin, returnTypeEnd - begin).trimmed();
+
+	if (returnTypeName.length() > 0)
+	{
+		returnType = Parse(returnTypeName);
+	}
+
+	parameters = ParseList(name, lastParameterListBegin + 1, end - 1);
+}
+
+/*
+* Splits name at :: which are not inside of template arguments or parentheses,
+* name with unbalanced angle brackets (operator<, operator>...) is kept as one scope
+*/
+void TypeName::ParseScopes(int begin, int end)
+{
+	int depth = 0;
+
+	for (int i = begin; i < end; i++)
+	{
+		if (name.at(i) == '<')
+		{
+			depth++;
+		}
+		else if (name.at(i) == '>')
+		{
+			depth--;
+		}
+	}
+
+	if (depth != 0)
+	{
+		TypeNameScope scope;
+
+		scope.name = name.mid(begin, end - begin);
+		scope.index = begin;
+		scopes.append(scope);
+
+		return;
+	}
+
+	int scopeBegin = begin;
+	int parenthesesDepth = 0;
+
+	for (int i = begin; i < end - 1; i++)
+	{
+		QChar character = name.at(i);
+
+		if (character == '<')
+		{
+			depth++;
+		}
+		else if (character == '>')
+		{
+			depth--;
+		}
+		else if (character == '(')
+		{
+			parenthesesDepth++;
+		}
+		else if (character == ')')
+		{
+			parenthesesDepth--;
+		}
+		else if (character == ':' && name.at(i + 1) == ':' && depth == 0 && parenthesesDepth == 0 && i > scopeBegin)
+		{
+			AddScope(scopeBegin, i);
+
+			scopeBegin = i + 2;
+			i++;
+		}
+	}
+
+	AddScope(scopeBegin, end);
+}
+
+void TypeName::AddScope(int begin, int end)
+{
+	TypeNameScope scope;
+	int templateArgumentsBegin = name.indexOf('<', begin);
+
+	scope.index = begin;
+
+	//Names of lambdas and other unnamed types start with < so they don't have template arguments
+	if (templateArgumentsBegin > begin && templateArgumentsBegin < end && name.at(end - 1) == '>')
+	{
+		scope.name = name.mid(begin, templateArgumentsBegin - begin).trimmed();
+		scope.templateArguments = ParseList(name, templateArgumentsBegin + 1, end - 1);
+
+		hasTemplateArguments = true;
+	}
+	else
+	{
+		scope.name = name.mid(begin, end - begin).trimmed();
+	}
+
+	scopes.append(scope);
+}
+
+//Parses list of template arguments or parameters which are separated with ',' at top level
+QVector<QSharedPointer<const TypeName>> TypeName::ParseList(const QString& name, int begin, int end)
+{
+	QVector<QSharedPointer<const TypeName>> typeNames;
+	int depth = 0;
+	int itemBegin = begin;
+
+	for (int i = begin; i <= end; i++)
+	{
+		QChar character = i < end ? name.at(i) : QChar(',');
+
+		if (character == '<' || character == '(' || character == '[')
+		{
+			depth++;
+		}
+		else if (character == '>' || character == ')' || character == ']')
+		{
+			depth--;
+		}
+		else if (character == ',' && depth == 0)
+		{
+			QString item = name.mid(itemBegin, i - itemBegin).trimmed();
+
+			if (item.length() > 0)
+			{
+				typeNames.append(Parse(item));
+			}
+
+			itemBegin = i + 1;
+		}
+	}
+
+	return typeNames;
+}
+
+bool TypeName::StartsWithWord(int index, int end, const QString& word) const
+{
+	int length = word.length();
+
+	if (index + length > end || name.midRef(index, length) != word)
+	{
+		return false;
+	}
+
+	return index + length == end || !IsIdentifierCharacter(name.at(index + length));
+}
+
+bool TypeName::EndsWithWord(int begin, int end, const QString& word) const
+{
+	int length = word.length();
+	int index = end - length;
+
+	if (index < begin || name.midRef(index, length) != word)
+	{
+		return false;
+	}
+
+	return index == begin || !IsIdentifierCharacter(name.at(index - 1));
+}
+
+bool TypeName::IsIdentifierCharacter(QChar character)
+{
+	return character.isLetterOrNumber() || character == '_';
+}
+
+QString TypeName::Format(const QString& name)
+{
+	static const QString keywords[] = { "class ", "struct ", "union ", "enum " };
+	bool removeKeywords = name.contains('<');
+	int length = name.length();
+	QString result;
+
+	result.reserve(length + 8);
+
+	for (int i = 0; i < length; i++)
+	{
+		QChar character = name.at(i);
+
+		if (removeKeywords && character.isLetter() && (i == 0 || !IsIdentifierCharacter(name.at(i - 1))))
+		{
+			bool isKeyword = false;
+
+			for (const QString& keyword : keywords)
+			{
+				if (name.midRef(i, keyword.length()) == keyword)
+				{
+					i += keyword.length() - 1;
+					isKeyword = true;
+
+					break;
+				}
+			}
+
+			if (isKeyword)
+			{
+				continue;
+			}
+		}
+
+		if (character == ' ' && i + 1 < length)
+		{
+			QChar nextCharacter = name.at(i + 1);
+
+			if (nextCharacter == '>' || nextCharacter == ',' || nextCharacter == '*' || nextCharacter == '&')
+			{
+				continue;
+			}
+		}
+
+		result += character;
+
+		if (character == ',')
+		{
+			result += ' ';
+
+			if (i + 1 < length && name.at(i + 1) == ' ')
+			{
+				i++;
+			}
+		}
+	}
+
+	return result;
+}
+
+TypeName::Cache& TypeName::GetCache()
+{
+	static Cache cache;
+
+	return cache;
+}
@@ -0,0 +1,482 @@
+#include <QtEndian>
+#include "TypeSignature.h"
+
+static const quint64 fnvPrime = 1099511628211ULL;
+
+TypeSignature::TypeSignature(const TPIStream* tpiStream)
+{
+	this->tpiStream = tpiStream;
+}
+
+//Returns 0 if type can't be hashed, in that case type should be treated as changed
+quint64 TypeSignature::Compute(quint32 typeIndex)
+{
+	TPIRecord record;
+
+	if (!tpiStream->IsLoaded() || !tpiStream->GetRecord(typeIndex, &record) || !TPIStream::IsUDTLeaf(record.kind))
+	{
+		return 0;
+	}
+
+	quint64 signature = HashTypeIndex(typeIndex, true);
+
+	return signature ? signature : 1;
+}
+
+quint64 TypeSignature::Hash(quint64 hash, const void* data, int size)
+{
+	const uchar* bytes = static_cast<const uchar*>(data);
+
+	for (int i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= fnvPrime;
+	}
+
+	return hash;
+}
+
+quint64 TypeSignature::Hash(quint64 hash, quint64 value)
+{
+	return Hash(hash, &value, sizeof(value));
+}
+
+quint64 TypeSignature::HashTypeIndex(quint32 typeIndex, bool hashMembers)
+{
+	//Indices of simple types are the same in every PDB
+	if (typeIndex < tpiStream->GetTypeIndexBegin())
+	{
+		return Hash(initialHash, typeIndex);
+	}
+
+	TPIRecord record;
+
+	if (!tpiStream->GetRecord(typeIndex, &record))
+	{
+		return Hash(initialHash, typeIndex);
+	}
+
+	if (TPIStream::IsUDTLeaf(record.kind))
+	{
+		const char* name;
+		int length;
+		quint16 property;
+
+		if (!TPIStream::GetUDTRecordName(record, &name, &length, &property))
+		{
+			return HashRecord(record);
+		}
+
+		if (!hashMembers && !IsUnnamedType(name, length))
+		{
+			return HashUDTName(record);
+		}
+
+		//Members of type are in its definition
+		if (property & propertyForwardReference)
+		{
+			quint32 typeIndex2 = tpiStream->FindTypeIndex(QByteArray::fromRawData(name, length));
+
+			if (!typeIndex2 || !tpiStream->GetRecord(typeIndex2, &record))
+			{
+				return HashUDTName(record);
+			}
+		}
+
+		//Type which references itself through nested or unnamed types is hashed by name second time
+		if (visitingTypes.contains(record.typeIndex))
+		{
+			return HashUDTName(record);
+		}
+	}
+
+	auto it = signatures.constFind(record.typeIndex);
+
+	if (it != signatures.constEnd())
+	{
+		return it.value();
+	}
+
+	quint64 signature;
+
+	if (TPIStream::IsUDTLeaf(record.kind))
+	{
+		visitingTypes.insert(record.typeIndex);
+		signature = HashUDT(record);
+		visitingTypes.remove(record.typeIndex);
+	}
+	else
+	{
+		signature = HashRecord(record);
+	}
+
+	signatures.insert(record.typeIndex, signature);
+
+	return signature;
+}
+
+quint64 TypeSignature::HashUDTName(const TPIRecord& record)
+{
+	const char* name;
+	int length;
+	quint64 hash = Hash(initialHash, record.kind);
+
+	if (TPIStream::GetUDTRecordName(record, &name, &length))
+	{
+		hash = Hash(hash, name, length);
+	}
+
+	return hash;
+}
+
+quint64 TypeSignature::HashUDT(const TPIRecord& record)
+{
+	TPIUDTRecord udtRecord;
+
+	if (!TPIStream::DecodeUDTRecord(record, &udtRecord, false))
+	{
+		return Hash(Hash(initialHash, record.kind), record.data, record.length);
+	}
+
+	quint64 hash = HashUDTName(record);
+
+	hash = Hash(hash, udtRecord.memberCount);
+	hash = Hash(hash, udtRecord.property);
+	hash = Hash(hash, udtRecord.size);
+
+	if (udtRecord.fieldList)
+	{
+		hash = Hash(hash, HashTypeIndex(udtRecord.fieldList));
+	}
+
+	if (udtRecord.derivedFrom)
+	{
+		hash = Hash(hash, HashTypeIndex(udtRecord.derivedFrom));
+	}
+
+	if (udtRecord.vTableShape)
+	{
+		hash = Hash(hash, HashTypeIndex(udtRecord.vTableShape));
+	}
+
+	if (udtRecord.underlyingType)
+	{
+		hash = Hash(hash, HashTypeIndex(udtRecord.underlyingType));
+	}
+
+	return hash;
+}
+
+/*
+* Type indices in record are replaced by signatures of types which they reference,
+* records which aren't known are hashed by their bytes
+*/
+quint64 TypeSignature::HashRecord(const TPIRecord& record)
+{
+	const uchar* data = record.data;
+	const uchar* end = record.data + record.length;
+	quint64 hash = Hash(initialHash, record.kind);
+	quint32 typeIndex;
+
+	switch (record.kind)
+	{
+	case LF_FIELDLIST:
+		return HashFieldList(record);
+	case LF_METHODLIST:
+		return HashMethodList(record);
+	case LF_MODIFIER:
+	case LF_BITFIELD:
+		if (!ReadTypeIndex(data, end, &typeIndex))
+		{
+			break;
+		}
+
+		hash = Hash(hash, HashTypeIndex(typeIndex));
+
+		break;
+	case LF_POINTER:
+	{
+		if (!ReadTypeIndex(data, end, &typeIndex) || end - data < 4)
+		{
+			break;
+		}
+
+		quint32 attributes = qFromLittleEndian<quint32>(data);
+		quint32 mode = (attributes >> 5) & 0x7;
+
+		hash = Hash(hash, HashTypeIndex(typeIndex));
+		hash = Hash(hash, attributes);
+		data += 4;
+
+		//Pointers to members contain class type
+		if ((mode == 2 || mode == 3) && ReadTypeIndex(data, end, &typeIndex))
+		{
+			hash = Hash(hash, HashTypeIndex(typeIndex));
+		}
+
+		break;
+	}
+	case LF_ARRAY:
+	case LF_PROCEDURE:
+	case LF_MFUNCTION:
+	{
+		//Element and index types of arrays, return, class and this types of functions
+		int typeIndexCount = record.kind == LF_ARRAY ? 2 : record.kind == LF_PROCEDURE ? 1 : 3;
+
+		for (int i = 0; i < typeIndexCount && ReadTypeIndex(data, end, &typeIndex); i++)
+		{
+			hash = Hash(hash, HashTypeIndex(typeIndex));
+		}
+
+		if (record.kind != LF_ARRAY && end - data >= 8)
+		{
+			//Calling convention, attributes and number of parameters
+			hash = Hash(hash, data, 4);
+			data += 4;
+
+			ReadTypeIndex(data, end, &typeIndex);
+
+			hash = Hash(hash, HashTypeIndex(typeIndex));
+		}
+
+		break;
+	}
+	case LF_ARGLIST:
+	{
+		quint32 count;
+
+		if (!ReadTypeIndex(data, end, &count))
+		{
+			break;
+		}
+
+		hash = Hash(hash, count);
+
+		for (quint32 i = 0; i < count && ReadTypeIndex(data, end, &typeIndex); i++)
+		{
+			hash = Hash(hash, HashTypeIndex(typeIndex));
+		}
+
+		break;
+	}
+	}
+
+	return Hash(hash, data, static_cast<int>(end - data));
+}
+
+quint64 TypeSignature::HashFieldList(const TPIRecord& record)
+{
+	const uchar* data = record.data;
+	const uchar* end = record.data + record.length;
+	quint64 hash = Hash(initialHash, record.kind);
+
+	while (end - data >= 2)
+	{
+		//LF_PAD bytes contain number of bytes to skip
+		if (*data >= 0xF0)
+		{
+			data += qMax(*data & 0x0F, 1);
+
+			continue;
+		}
+
+		quint16 kind = qFromLittleEndian<quint16>(data);
+		quint16 attributes = 0;
+		quint32 typeIndex = 0;
+		quint64 value = 0;
+		bool isValid = true;
+
+		data += 2;
+		hash = Hash(hash, kind);
+
+		switch (kind)
+		{
+		case LF_BCLASS:
+		case LF_VBCLASS:
+		case LF_IVBCLASS:
+		case LF_MEMBER:
+		case LF_STMEMBER:
+		case LF_ONEMETHOD:
+		case LF_ENUMERATE:
+			if (end - data < 2)
+			{
+				isValid = false;
+
+				break;
+			}
+
+			attributes = qFromLittleEndian<quint16>(data);
+			data += 2;
+			hash = Hash(hash, attributes);
+
+			if (kind == LF_ENUMERATE)
+			{
+				isValid = TPIStream::ReadNumericLeaf(data, end, &value) && ReadName(data, end, &hash);
+				hash = Hash(hash, value);
+
+				break;
+			}
+
+			if (!ReadTypeIndex(data, end, &typeIndex))
+			{
+				isValid = false;
+
+				break;
+			}
+
+			//Members of base classes are used when virtual functions are generated
+			hash = Hash(hash, HashTypeIndex(typeIndex, kind == LF_BCLASS || kind == LF_VBCLASS || kind == LF_IVBCLASS));
+
+			if (kind == LF_BCLASS || kind == LF_MEMBER)
+			{
+				isValid = TPIStream::ReadNumericLeaf(data, end, &value);
+				hash = Hash(hash, value);
+			}
+			else if (kind == LF_VBCLASS || kind == LF_IVBCLASS)
+			{
+				//Type of virtual base pointer, offset of pointer and offset in virtual base table
+				isValid = ReadTypeIndex(data, end, &typeIndex) &&
+					TPIStream::ReadNumericLeaf(data, end, &value);
+				hash = Hash(hash, HashTypeIndex(typeIndex));
+				hash = Hash(hash, value);
+				isValid = isValid && TPIStream::ReadNumericLeaf(data, end, &value);
+				hash = Hash(hash, value);
+			}
+			else if (kind == LF_ONEMETHOD)
+			{
+				quint32 methodProperty = (attributes >> 2) & 0x7;
+
+				//Introducing virtual functions contain offset in virtual function table
+				if (methodProperty == 4 || methodProperty == 6)
+				{
+					isValid = ReadTypeIndex(data, end, &typeIndex);
+					hash = Hash(hash, typeIndex);
+				}
+			}
+
+			if (isValid && kind != LF_BCLASS && kind != LF_VBCLASS && kind != LF_IVBCLASS)
+			{
+				isValid = ReadName(data, end, &hash);
+			}
+
+			break;
+		case LF_METHOD:
+			if (end - data < 2)
+			{
+				isValid = false;
+
+				break;
+			}
+
+			hash = Hash(hash, qFromLittleEndian<quint16>(data));
+			data += 2;
+
+			isValid = ReadTypeIndex(data, end, &typeIndex);
+			hash = Hash(hash, HashTypeIndex(typeIndex));
+			isValid = isValid && ReadName(data, end, &hash);
+
+			break;
+		case LF_NESTTYPE:
+		case LF_VFUNCTAB:
+		case LF_INDEX:
+			data += 2;
+
+			if (!ReadTypeIndex(data, end, &typeIndex))
+			{
+				isValid = false;
+
+				break;
+			}
+
+			//Nested types are generated inside of type and LF_INDEX continues field list
+			hash = Hash(hash, HashTypeIndex(typeIndex, kind == LF_NESTTYPE));
+
+			if (kind == LF_NESTTYPE)
+			{
+				isValid = ReadName(data, end, &hash);
+			}
+
+			break;
+		default:
+			isValid = false;
+
+			break;
+		}
+
+		//Rest of field list can't be parsed if member isn't known
+		if (!isValid)
+		{
+			break;
+		}
+	}
+
+	if (data < end)
+	{
+		hash = Hash(hash, data, static_cast<int>(end - data));
+	}
+
+	return hash;
+}
+
+quint64 TypeSignature::HashMethodList(const TPIRecord& record)
+{
+	const uchar* data = record.data;
+	const uchar* end = record.data + record.length;
+	quint64 hash = Hash(initialHash, record.kind);
+
+	while (end - data >= 8)
+	{
+		quint16 attributes = qFromLittleEndian<quint16>(data);
+		quint32 methodProperty = (attributes >> 2) & 0x7;
+		quint32 typeIndex;
+
+		hash = Hash(hash, attributes);
+		data += 4;
+
+		ReadTypeIndex(data, end, &typeIndex);
+
+		hash = Hash(hash, HashTypeIndex(typeIndex));
+
+		if ((methodProperty == 4 || methodProperty == 6) && ReadTypeIndex(data, end, &typeIndex))
+		{
+			hash = Hash(hash, typeIndex);
+		}
+	}
+
+	return hash;
+}
+
+bool TypeSignature::IsUnnamedType(const char* name, int length)
+{
+	QByteArray name2 = QByteArray::fromRawData(name, length);
+
+	return name2.contains("<unnamed-") || name2.contains("<anonymous-") || name2.contains("__unnamed");
+}
+
+bool TypeSignature::ReadTypeIndex(const uchar*& data, const uchar* end, quint32* typeIndex)
+{
+	if (end - data < 4)
+	{
+		return false;
+	}
+
+	*typeIndex = qFromLittleEndian<quint32>(data);
+	data += 4;
+
+	return true;
+}
+
+bool TypeSignature::ReadName(const uchar*& data, const uchar* end, quint64* hash)
+{
+	if (data >= end)
+	{
+		return false;
+	}
+
+	int length = static_cast<int>(qstrnlen(reinterpret_cast<const char*>(data), end - data));
+
+	*hash = Hash(*hash, data, length);
+	data += length + 1;
+
+	return true;
+}
@@ -0,0 +1,277 @@
+/*
+* Throughput benchmark and differential test of MSVCDemangler which doesn't need DIA, Qt or Windows.
+* Names from corpus are demangled and compared with golden file which contains one demangled name per line.
+*
+* DemangleBenchmark project is part of PDBExplorer.sln. To build it without Visual Studio run this from root
+* of repository (GCC 13 or newer, Clang 17 or newer), it has to build without warnings:
+*	g++ -std=c++23 -O2 -Wall -Wextra -Iinclude tools/DemangleBenchmark/DemangleBenchmark.cpp src/MSVCDemangler.cpp
+*		src/DemangleData.cpp src/DemangledSymbol.cpp -o DemangleBenchmark
+*
+* Usage:
+*	DemangleBenchmark <corpus> [golden] [--repeat count] [--update] [--symbols]
+*
+* --update writes current output to golden file instead of comparing it.
+* --symbols fills DemangledSymbol for every name and outputs its parameter count, IDA style and Ghidra style
+* separated with tabs instead of demangled name, its golden file is GoldenSymbols.txt.
+* Exit code is 1 if output differs from golden file.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+#include "MSVCDemangler.h"
+
+//Number of allocations is counted by replacing global operator new
+static std::atomic<unsigned long long> allocationCount = 0;
+
+void* operator new(std::size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+	void* pointer = std::malloc(size > 0 ? size : 1);
+
+	if (!pointer)
+	{
+		throw std::bad_alloc();
+	}
+
+	return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+static bool ReadLines(const char* filePath, std::vector<std::string>& lines)
+{
+	std::ifstream file(filePath);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	std::string line;
+
+	while (std::getline(file, line))
+	{
+		if (line.length() && line.back() == '\r')
+		{
+			line.pop_back();
+		}
+
+		lines.push_back(line);
+	}
+
+	return true;
+}
+
+static bool WriteLines(const char* filePath, const std::vector<std::string>& lines)
+{
+	std::ofstream file(filePath, std::ios::binary);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	for (const std::string& line : lines)
+	{
+		file << line << '\n';
+	}
+
+	return static_cast<bool>(file);
+}
+
+static std::string DescribeSymbol(const DemangledSymbol& demangledSymbol)
+{
+	return std::to_string(demangledSymbol.GetParameterCount()) + '\t' + demangledSymbol.Render(DemangleStyle::ida) + '\t' +
+		demangledSymbol.Render(DemangleStyle::ghidra);
+}
+
+//Returns number of names which are demangled differently than in golden file
+static int CompareWithGolden(const std::vector<std::string>& mangledNames, const std::vector<std::string>& demangledNames,
+	const std::vector<std::string>& goldenNames)
+{
+	int differenceCount = 0;
+
+	if (goldenNames.size() != demangledNames.size())
+	{
+		std::printf("Golden file has %zu names, corpus has %zu names\n", goldenNames.size(), demangledNames.size());
+
+		differenceCount++;
+	}
+
+	std::size_t count = std::min(goldenNames.size(), demangledNames.size());
+
+	for (std::size_t i = 0; i < count; i++)
+	{
+		if (demangledNames[i] == goldenNames[i])
+		{
+			continue;
+		}
+
+		std::printf("Line %zu: %s\n", i + 1, mangledNames[i].c_str());
+		std::printf("\texpected: %s\n", goldenNames[i].c_str());
+		std::printf("\tactual:   %s\n", demangledNames[i].c_str());
+
+		differenceCount++;
+	}
+
+	return differenceCount;
+}
+
+int main(int argc, char** argv)
+{
+	const char* corpusFilePath = nullptr;
+	const char* goldenFilePath = nullptr;
+	int repeatCount = 100;
+	bool update = false;
+	bool symbols = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+
+		if (argument == "--repeat" && i + 1 < argc)
+		{
+			repeatCount = std::max(1, std::atoi(argv[++i]));
+		}
+		else if (argument == "--update")
+		{
+			update = true;
+		}
+		else if (argument == "--symbols")
+		{
+			symbols = true;
+		}
+		else if (!corpusFilePath)
+		{
+			corpusFilePath = argv[i];
+		}
+		else
+		{
+			goldenFilePath = argv[i];
+		}
+	}
+
+	if (!corpusFilePath || (update && !goldenFilePath))
+	{
+		std::printf("Usage: DemangleBenchmark <corpus> [golden] [--repeat count] [--update] [--symbols]\n");
+
+		return 2;
+	}
+
+	std::vector<std::string> mangledNames;
+
+	if (!ReadLines(corpusFilePath, mangledNames) || mangledNames.empty())
+	{
+		std::printf("Can't read corpus %s\n", corpusFilePath);
+
+		return 2;
+	}
+
+	MSVCDemangler msvcDemangler;
+	DemangledSymbol demangledSymbol;
+	std::vector<std::string> demangledNames(mangledNames.size());
+	std::vector<double> latencies;
+	std::string rest;
+
+	latencies.reserve(mangledNames.size() * repeatCount);
+
+	unsigned long long allocationCountBefore = allocationCount.load();
+	auto begin = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < repeatCount; i++)
+	{
+		for (std::size_t j = 0; j < mangledNames.size(); j++)
+		{
+			auto nameBegin = std::chrono::steady_clock::now();
+
+			if (symbols)
+			{
+				msvcDemangler.DemangleSymbol(mangledNames[j], rest, demangledSymbol);
+			}
+			else
+			{
+				demangledNames[j] = msvcDemangler.DemangleSymbol(mangledNames[j], rest);
+			}
+
+			auto nameEnd = std::chrono::steady_clock::now();
+
+			latencies.push_back(std::chrono::duration<double, std::nano>(nameEnd - nameBegin).count());
+
+			//Rendering isn't measured
+			if (symbols)
+			{
+				demangledNames[j] = DescribeSymbol(demangledSymbol);
+			}
+		}
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	unsigned long long allocations = allocationCount.load() - allocationCountBefore;
+	double seconds = std::chrono::duration<double>(end - begin).count();
+	double nameCount = static_cast<double>(latencies.size());
+
+	std::sort(latencies.begin(), latencies.end());
+
+	std::printf("Names:                %zu x %d\n", mangledNames.size(), repeatCount);
+	std::printf("Names per second:     %.0f\n", nameCount / seconds);
+	std::printf("Allocations per name: %.1f\n", allocations / nameCount);
+	std::printf("p50 latency:          %.0f ns\n", latencies[latencies.size() / 2]);
+	std::printf("p99 latency:          %.0f ns\n", latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)]);
+
+	if (!goldenFilePath)
+	{
+		return 0;
+	}
+
+	if (update)
+	{
+		if (!WriteLines(goldenFilePath, demangledNames))
+		{
+			std::printf("Can't write golden file %s\n", goldenFilePath);
+
+			return 2;
+		}
+
+		std::printf("Golden file %s is updated\n", goldenFilePath);
+
+		return 0;
+	}
+
+	std::vector<std::string> goldenNames;
+
+	if (!ReadLines(goldenFilePath, goldenNames))
+	{
+		std::printf("Can't read golden file %s\n", goldenFilePath);
+
+		return 2;
+	}
+
+	int differenceCount = CompareWithGolden(mangledNames, demangledNames, goldenNames);
+
+	if (differenceCount > 0)
+	{
+		std::printf("%d differences from golden file\n", differenceCount);
+
+		return 1;
+	}
+
+	std::printf("Output matches golden file\n");
+
+	return 0;
+}